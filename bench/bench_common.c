@@ -0,0 +1,276 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "bench_common.h"
+
+#ifndef ESP_NN_GIT_REV
+#define ESP_NN_GIT_REV "unknown"
+#endif
+
+static uint32_t rand_state = 0x12345678;
+
+void *bench_alloc(size_t size)
+{
+    size_t aligned_size = (size + 15) & ~(size_t) 15;
+    void *buf = aligned_alloc(16, aligned_size ? aligned_size : 16);
+    if (buf == NULL) {
+        fprintf(stderr, "bench: allocation of %zu bytes failed\n", size);
+        exit(2);
+    }
+    memset(buf, 0, aligned_size);
+    return buf;
+}
+
+void bench_seed(uint32_t seed)
+{
+    rand_state = seed ? seed : 0x12345678;
+}
+
+uint32_t bench_rand(void)
+{
+    /* xorshift32, reproducible across libc implementations */
+    uint32_t x = rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rand_state = x;
+    return x;
+}
+
+int32_t bench_rand_range(int32_t lo, int32_t hi)
+{
+    return lo + (int32_t) (bench_rand() % (uint32_t) (hi - lo + 1));
+}
+
+void bench_fill_s8(int8_t *buf, int32_t len)
+{
+    for (int32_t i = 0; i < len; i++) {
+        buf[i] = (int8_t) bench_rand_range(-128, 127);
+    }
+}
+
+void bench_fill_quant(int32_t *mult, int32_t *shift, int32_t len)
+{
+    for (int32_t i = 0; i < len; i++) {
+        mult[i] = 0x40000000 + bench_rand_range(0, 0x3fffffff);
+        shift[i] = bench_rand_range(-10, -6);
+    }
+}
+
+static const char *matrix_names[] = {"quick", "default", "large"};
+
+bool bench_matrix_parse(const char *str, bench_matrix_t *matrix)
+{
+    for (int i = 0; i <= BENCH_MATRIX_LARGE; i++) {
+        if (strcmp(str, matrix_names[i]) == 0) {
+            *matrix = (bench_matrix_t) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *bench_matrix_name(bench_matrix_t matrix)
+{
+    return matrix_names[matrix];
+}
+
+bool bench_kernel_enabled(const bench_config_t *cfg, const char *kernel)
+{
+    if (cfg->filter == NULL) {
+        return true;
+    }
+    /* comma separated names, a trailing '*' matches as prefix */
+    const char *tok = cfg->filter;
+    while (*tok) {
+        size_t len = strcspn(tok, ",");
+        if (len > 0 && tok[len - 1] == '*') {
+            if (strncmp(kernel, tok, len - 1) == 0) {
+                return true;
+            }
+        } else if (len == strlen(kernel) && strncmp(kernel, tok, len) == 0) {
+            return true;
+        }
+        tok += tok[len] ? len + 1 : len;
+    }
+    return false;
+}
+
+static inline int64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+void bench_measure(const bench_config_t *cfg, bench_fn_t fn, void *arg,
+                   bench_result_t *res)
+{
+    for (int i = 0; i < cfg->warmup; i++) {
+        fn(arg);
+    }
+
+    /* batch calls so that timer resolution does not dominate tiny kernels */
+    int calls = 1;
+    while (1) {
+        int64_t start = time_ns();
+        for (int i = 0; i < calls; i++) {
+            fn(arg);
+        }
+        int64_t elapsed = time_ns() - start;
+        if (elapsed >= cfg->min_sample_ns || calls >= (1 << 20)) {
+            break;
+        }
+        calls = elapsed > 0 && cfg->min_sample_ns / elapsed < 8 ?
+                (int) (calls * cfg->min_sample_ns / elapsed) + 1 : calls * 8;
+    }
+
+    int repeats = cfg->repeats > 0 ? cfg->repeats : 1;
+    double *samples = malloc(repeats * sizeof(double));
+    if (samples == NULL) {
+        fprintf(stderr, "bench: allocation failed\n");
+        exit(2);
+    }
+    for (int r = 0; r < repeats; r++) {
+        int64_t start = time_ns();
+        for (int i = 0; i < calls; i++) {
+            fn(arg);
+        }
+        samples[r] = (double) (time_ns() - start) / calls;
+    }
+    qsort(samples, repeats, sizeof(double), cmp_double);
+
+    res->ns_min = samples[0];
+    res->ns_per_op = (repeats & 1) ? samples[repeats / 2] :
+                     (samples[repeats / 2 - 1] + samples[repeats / 2]) / 2;
+    res->calls_per_sample = calls;
+    free(samples);
+}
+
+static void fill_result(bench_result_t *res, const char *kernel, const char *impl,
+                        const char *shape, int64_t macs, int64_t bytes)
+{
+    snprintf(res->kernel, sizeof(res->kernel), "%s", kernel);
+    snprintf(res->impl, sizeof(res->impl), "%s", impl);
+    snprintf(res->shape, sizeof(res->shape), "%s", shape);
+    res->macs = macs;
+    res->bytes = bytes;
+}
+
+void bench_run_pair(const bench_config_t *cfg, bench_report_t *rep,
+                    const char *kernel, const char *shape,
+                    int64_t macs, int64_t bytes,
+                    bench_fn_t ansi_fn, bench_fn_t opt_fn, void *arg,
+                    const int8_t *out_ansi, const int8_t *out_opt, int32_t out_len)
+{
+    ansi_fn(arg);
+    opt_fn(arg);
+    int match = memcmp(out_ansi, out_opt, out_len) == 0;
+    if (!match) {
+        rep->mismatches++;
+        fprintf(stderr, "bench: %s [%s] opt output differs from ansi\n", kernel, shape);
+    }
+
+    bench_result_t *res = bench_report_add(rep);
+    fill_result(res, kernel, "ansi", shape, macs, bytes);
+    res->match = -1;
+    bench_measure(cfg, ansi_fn, arg, res);
+
+    res = bench_report_add(rep);
+    fill_result(res, kernel, "opt", shape, macs, bytes);
+    res->match = match;
+    bench_measure(cfg, opt_fn, arg, res);
+
+    fprintf(stderr, "%-28s %-56s ansi %12.1f ns  opt %12.1f ns%s\n", kernel, shape,
+            res[-1].ns_per_op, res->ns_per_op, match ? "" : "  MISMATCH");
+}
+
+bench_result_t *bench_report_add(bench_report_t *rep)
+{
+    if (rep->count == rep->capacity) {
+        int capacity = rep->capacity ? rep->capacity * 2 : 64;
+        bench_result_t *results = realloc(rep->results, capacity * sizeof(bench_result_t));
+        if (results == NULL) {
+            fprintf(stderr, "bench: allocation failed\n");
+            exit(2);
+        }
+        rep->results = results;
+        rep->capacity = capacity;
+    }
+    bench_result_t *res = &rep->results[rep->count++];
+    memset(res, 0, sizeof(*res));
+    return res;
+}
+
+void bench_report_free(bench_report_t *rep)
+{
+    free(rep->results);
+    memset(rep, 0, sizeof(*rep));
+}
+
+static double per_second(int64_t count, double ns)
+{
+    return ns > 0 ? (double) count * 1e9 / ns : 0;
+}
+
+void bench_report_write(const bench_report_t *rep, const bench_config_t *cfg,
+                        bench_format_t format, const char *bench_name, FILE *fp)
+{
+    if (format == BENCH_FORMAT_CSV) {
+        fprintf(fp, "kernel,impl,shape,macs,bytes,ns_per_op,ns_min,macs_per_s,bytes_per_s,match,"
+                "model,layer,paths,cumulative_ns\n");
+        for (int i = 0; i < rep->count; i++) {
+            const bench_result_t *r = &rep->results[i];
+            fprintf(fp, "%s,%s,%s,%"PRId64",%"PRId64",%.1f,%.1f,%.4g,%.4g,%s,%s,%s,%s,%.1f\n",
+                    r->kernel, r->impl, r->shape, r->macs, r->bytes,
+                    r->ns_per_op, r->ns_min,
+                    per_second(r->macs, r->ns_per_op), per_second(r->bytes, r->ns_per_op),
+                    r->match < 0 ? "ref" : (r->match ? "yes" : "no"),
+                    r->model, r->layer, r->paths, r->cumulative_ns);
+        }
+        return;
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"bench\": \"%s\",\n", bench_name);
+    fprintf(fp, "  \"git_rev\": \"%s\",\n", ESP_NN_GIT_REV);
+    fprintf(fp, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(fp, "  \"matrix\": \"%s\",\n", bench_matrix_name(cfg->matrix));
+    fprintf(fp, "  \"warmup\": %d,\n", cfg->warmup);
+    fprintf(fp, "  \"repeats\": %d,\n", cfg->repeats);
+    fprintf(fp, "  \"mismatches\": %d,\n", rep->mismatches);
+    fprintf(fp, "  \"results\": [");
+    for (int i = 0; i < rep->count; i++) {
+        const bench_result_t *r = &rep->results[i];
+        fprintf(fp, "%s\n    {", i ? "," : "");
+        if (r->model[0]) {
+            fprintf(fp, "\"model\": \"%s\", \"layer\": \"%s\", \"paths\": \"%s\", "
+                    "\"cumulative_ns\": %.1f, ", r->model, r->layer, r->paths, r->cumulative_ns);
+        }
+        fprintf(fp, "\"kernel\": \"%s\", \"impl\": \"%s\", \"shape\": \"%s\", "
+                "\"macs\": %"PRId64", \"bytes\": %"PRId64", "
+                "\"ns_per_op\": %.1f, \"ns_min\": %.1f, \"calls_per_sample\": %d, "
+                "\"macs_per_s\": %.4g, \"bytes_per_s\": %.4g, \"match\": %s}",
+                r->kernel, r->impl, r->shape, r->macs, r->bytes,
+                r->ns_per_op, r->ns_min, r->calls_per_sample,
+                per_second(r->macs, r->ns_per_op), per_second(r->bytes, r->ns_per_op),
+                r->match < 0 ? "null" : (r->match ? "true" : "false"));
+    }
+    fprintf(fp, "\n  ]\n}\n");
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#define BENCH_NAME_LEN      32
+#define BENCH_SHAPE_LEN     112
+
+/* shape matrix levels: a level includes all shapes of the lower ones */
+typedef enum {
+    BENCH_MATRIX_QUICK = 0,
+    BENCH_MATRIX_DEFAULT,
+    BENCH_MATRIX_LARGE,
+} bench_matrix_t;
+
+typedef enum {
+    BENCH_FORMAT_JSON = 0,
+    BENCH_FORMAT_CSV,
+} bench_format_t;
+
+typedef struct {
+    int warmup;                 /* untimed runs before sampling */
+    int repeats;                /* timed samples, median is reported */
+    int64_t min_sample_ns;      /* calls are batched until a sample is at least this long */
+    bench_matrix_t matrix;
+    const char *filter;         /* comma separated kernel names (`name*` for prefix), NULL for all */
+    uint32_t seed;
+} bench_config_t;
+
+typedef struct {
+    char kernel[BENCH_NAME_LEN];
+    char impl[BENCH_NAME_LEN];
+    char shape[BENCH_SHAPE_LEN];
+    /* model replay only */
+    char model[BENCH_NAME_LEN];
+    char layer[BENCH_NAME_LEN];
+    char paths[BENCH_SHAPE_LEN];    /* dispatcher path per target, `target=path;..` */
+    double cumulative_ns;           /* sum of ns_per_op of this and preceding layers */
+    int64_t macs;               /* MACs per call; element ops for non-MAC kernels */
+    int64_t bytes;              /* input + weights + output bytes touched per call */
+    double ns_per_op;           /* median over samples */
+    double ns_min;
+    int calls_per_sample;
+    int match;                  /* 1: output equals ANSI, 0: mismatch, -1: reference */
+} bench_result_t;
+
+typedef struct {
+    bench_result_t *results;
+    int count;
+    int capacity;
+    int mismatches;
+} bench_report_t;
+
+typedef void (*bench_fn_t)(void *arg);
+
+/* 16 byte aligned, zero initialised allocation. Release with free() */
+void *bench_alloc(size_t size);
+
+void bench_seed(uint32_t seed);
+uint32_t bench_rand(void);
+/* uniform in [lo, hi] */
+int32_t bench_rand_range(int32_t lo, int32_t hi);
+void bench_fill_s8(int8_t *buf, int32_t len);
+/* per channel requant params in the range the converters emit */
+void bench_fill_quant(int32_t *mult, int32_t *shift, int32_t len);
+
+bool bench_matrix_parse(const char *str, bench_matrix_t *matrix);
+const char *bench_matrix_name(bench_matrix_t matrix);
+bool bench_kernel_enabled(const bench_config_t *cfg, const char *kernel);
+
+/**
+ * @brief   Time `fn(arg)` as per `cfg` and fill timing fields of `res`
+ */
+void bench_measure(const bench_config_t *cfg, bench_fn_t fn, void *arg,
+                   bench_result_t *res);
+
+/**
+ * @brief   Measure ANSI and optimised variants of one kernel/shape and compare outputs
+ *
+ * @note    Both functions run once before timing, then `out_ansi` and `out_opt`
+ *          (`out_len` bytes) are compared. Outputs must only depend on the inputs.
+ */
+void bench_run_pair(const bench_config_t *cfg, bench_report_t *rep,
+                    const char *kernel, const char *shape,
+                    int64_t macs, int64_t bytes,
+                    bench_fn_t ansi_fn, bench_fn_t opt_fn, void *arg,
+                    const int8_t *out_ansi, const int8_t *out_opt, int32_t out_len);
+
+bench_result_t *bench_report_add(bench_report_t *rep);
+void bench_report_free(bench_report_t *rep);
+void bench_report_write(const bench_report_t *rep, const bench_config_t *cfg,
+                        bench_format_t format, const char *bench_name, FILE *fp);
@@ -0,0 +1,1757 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_nn.h>
+
+#include "bench_kernels.h"
+
+#define ARRAY_SIZE(a)   ((int) (sizeof(a) / sizeof((a)[0])))
+
+/* Quantisation params typical for TFLite int8 models (zero point -128) */
+#define BENCH_IN_OFFSET     128
+#define BENCH_OUT_OFFSET    -128
+#define BENCH_ACT_MIN       -128
+#define BENCH_ACT_MAX       127
+
+/* `_workers` kernels: split across this many pthread workers */
+#define BENCH_NUM_WORKERS   2
+
+/****************************** elementwise ******************************/
+
+typedef struct {
+    int level;
+    int32_t size;
+} size_shape_t;
+
+static const size_shape_t elementwise_shapes[] = {
+    {BENCH_MATRIX_QUICK, 1615},
+    {BENCH_MATRIX_DEFAULT, 16},
+    {BENCH_MATRIX_DEFAULT, 4096},
+    {BENCH_MATRIX_DEFAULT, 12544},
+    {BENCH_MATRIX_LARGE, 150528},
+};
+
+typedef struct {
+    int32_t size;
+    int8_t *in1, *in2, *out_ansi, *out_opt;
+} eltwise_arg_t;
+
+static void eltwise_alloc(eltwise_arg_t *a, int32_t size)
+{
+    a->size = size;
+    a->in1 = bench_alloc(size);
+    a->in2 = bench_alloc(size);
+    a->out_ansi = bench_alloc(size);
+    a->out_opt = bench_alloc(size);
+    bench_fill_s8(a->in1, size);
+    bench_fill_s8(a->in2, size);
+}
+
+static void eltwise_free(eltwise_arg_t *a)
+{
+    free(a->in1);
+    free(a->in2);
+    free(a->out_ansi);
+    free(a->out_opt);
+}
+
+#define ADD_ARGS(a, out) (a)->in1, (a)->in2, BENCH_IN_OFFSET, BENCH_IN_OFFSET,   \
+        1 << 30, 1 << 30, 0, 0, 20, out, BENCH_OUT_OFFSET, 1 << 30, -19,        \
+        BENCH_ACT_MIN, BENCH_ACT_MAX, (a)->size
+
+static void add_ansi(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    esp_nn_add_elementwise_s8_ansi(ADD_ARGS(a, a->out_ansi));
+}
+
+static void add_opt(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    esp_nn_add_elementwise_s8(ADD_ARGS(a, a->out_opt));
+}
+
+#define MUL_ARGS(a, out) (a)->in1, (a)->in2, BENCH_IN_OFFSET, BENCH_IN_OFFSET,   \
+        out, BENCH_OUT_OFFSET, 1 << 30, -7, BENCH_ACT_MIN, BENCH_ACT_MAX, (a)->size
+
+static void mul_ansi(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    esp_nn_mul_elementwise_s8_ansi(MUL_ARGS(a, a->out_ansi));
+}
+
+static void mul_opt(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    esp_nn_mul_elementwise_s8(MUL_ARGS(a, a->out_opt));
+}
+
+static void relu6_ansi(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    memcpy(a->out_ansi, a->in1, a->size);
+    esp_nn_relu6_s8_ansi(a->out_ansi, a->size);
+}
+
+static void relu6_opt(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    memcpy(a->out_opt, a->in1, a->size);
+    esp_nn_relu6_s8(a->out_opt, a->size);
+}
+
+/* MobileNetV3 hard_swish params, see tests/src/hard_swish_test.c */
+#define HARD_SWISH_ARGS(a, out) (a)->in1, out, (a)->size, -128, 19661, 22938, 2, -1, -128
+
+static void hard_swish_ansi(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    esp_nn_hard_swish_s8_ansi(HARD_SWISH_ARGS(a, a->out_ansi));
+}
+
+static void hard_swish_opt(void *arg)
+{
+    eltwise_arg_t *a = arg;
+    esp_nn_hard_swish_s8(HARD_SWISH_ARGS(a, a->out_opt));
+}
+
+typedef struct {
+    eltwise_arg_t e;
+    int8_t *lut;
+} logistic_arg_t;
+
+static void logistic_ansi(void *arg)
+{
+    logistic_arg_t *a = arg;
+    esp_nn_logistic_s8_ansi(a->e.in1, a->e.out_ansi, a->e.size, a->lut);
+}
+
+static void logistic_opt(void *arg)
+{
+    logistic_arg_t *a = arg;
+    esp_nn_logistic_s8(a->e.in1, a->e.out_opt, a->e.size, a->lut);
+}
+
+static void bench_elementwise(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    for (int i = 0; i < ARRAY_SIZE(elementwise_shapes); i++) {
+        if (elementwise_shapes[i].level > (int) cfg->matrix) {
+            continue;
+        }
+        const int32_t size = elementwise_shapes[i].size;
+        eltwise_arg_t a;
+        eltwise_alloc(&a, size);
+        snprintf(shape, sizeof(shape), "size=%d", (int) size);
+
+        if (bench_kernel_enabled(cfg, "add_elementwise_s8")) {
+            bench_run_pair(cfg, rep, "add_elementwise_s8", shape, size, 3 * size,
+                           add_ansi, add_opt, &a, a.out_ansi, a.out_opt, size);
+        }
+        if (bench_kernel_enabled(cfg, "mul_elementwise_s8")) {
+            bench_run_pair(cfg, rep, "mul_elementwise_s8", shape, size, 3 * size,
+                           mul_ansi, mul_opt, &a, a.out_ansi, a.out_opt, size);
+        }
+        if (size <= UINT16_MAX && bench_kernel_enabled(cfg, "relu6_s8")) {
+            bench_run_pair(cfg, rep, "relu6_s8", shape, size, 2 * size,
+                           relu6_ansi, relu6_opt, &a, a.out_ansi, a.out_opt, size);
+        }
+        if (bench_kernel_enabled(cfg, "hard_swish_s8")) {
+            int32_t scratch_size = esp_nn_get_hard_swish_scratch_size();
+            void *scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+            esp_nn_set_hard_swish_scratch_buf(scratch);
+            bench_run_pair(cfg, rep, "hard_swish_s8", shape, size, 2 * size,
+                           hard_swish_ansi, hard_swish_opt, &a, a.out_ansi, a.out_opt, size);
+            esp_nn_set_hard_swish_scratch_buf(NULL);
+            free(scratch);
+        }
+        if (bench_kernel_enabled(cfg, "logistic_s8")) {
+            logistic_arg_t l = {.e = a};
+            l.lut = bench_alloc(esp_nn_get_logistic_s8_scratch_size());
+            esp_nn_logistic_s8_prepare(l.lut, -128, 1.0f / 16);
+            bench_run_pair(cfg, rep, "logistic_s8", shape, size, 2 * size,
+                           logistic_ansi, logistic_opt, &l, a.out_ansi, a.out_opt, size);
+            free(l.lut);
+        }
+        eltwise_free(&a);
+    }
+}
+
+/************************** mul broadcast channel **************************/
+
+typedef struct {
+    int level;
+    int32_t spatial, channels;
+} bcast_shape_t;
+
+static const bcast_shape_t bcast_shapes[] = {
+    {BENCH_MATRIX_QUICK, 49, 64},
+    {BENCH_MATRIX_DEFAULT, 784, 16},
+    {BENCH_MATRIX_DEFAULT, 196, 96},
+    {BENCH_MATRIX_DEFAULT, 49, 576},
+    {BENCH_MATRIX_LARGE, 3136, 72},
+};
+
+typedef struct {
+    int32_t spatial, channels;
+    int8_t *in1, *in2, *out_ansi, *out_opt;
+} bcast_arg_t;
+
+#define BCAST_ARGS(a, out) (a)->in1, (a)->in2, BENCH_IN_OFFSET, BENCH_IN_OFFSET, out,  \
+        BENCH_OUT_OFFSET, 1 << 30, -7, BENCH_ACT_MIN, BENCH_ACT_MAX, (a)->spatial, (a)->channels
+
+static void bcast_ansi(void *arg)
+{
+    bcast_arg_t *a = arg;
+    esp_nn_mul_broadcast_channel_s8_ansi(BCAST_ARGS(a, a->out_ansi));
+}
+
+static void bcast_opt(void *arg)
+{
+    bcast_arg_t *a = arg;
+    esp_nn_mul_broadcast_channel_s8(BCAST_ARGS(a, a->out_opt));
+}
+
+static void bench_mul_broadcast(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    if (!bench_kernel_enabled(cfg, "mul_broadcast_channel_s8")) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(bcast_shapes); i++) {
+        if (bcast_shapes[i].level > (int) cfg->matrix) {
+            continue;
+        }
+        bcast_arg_t a = {.spatial = bcast_shapes[i].spatial, .channels = bcast_shapes[i].channels};
+        const int32_t size = a.spatial * a.channels;
+        a.in1 = bench_alloc(size);
+        a.in2 = bench_alloc(a.channels);
+        a.out_ansi = bench_alloc(size);
+        a.out_opt = bench_alloc(size);
+        bench_fill_s8(a.in1, size);
+        bench_fill_s8(a.in2, a.channels);
+        snprintf(shape, sizeof(shape), "spatial=%d ch=%d", (int) a.spatial, (int) a.channels);
+        bench_run_pair(cfg, rep, "mul_broadcast_channel_s8", shape, size, 2 * size + a.channels,
+                       bcast_ansi, bcast_opt, &a, a.out_ansi, a.out_opt, size);
+        free(a.in1);
+        free(a.in2);
+        free(a.out_ansi);
+        free(a.out_opt);
+    }
+}
+
+/****************************** convolution ******************************/
+
+typedef struct {
+    int level;
+    uint16_t in_wd, in_ht, in_ch, out_ch;
+    uint16_t filter_wd, filter_ht, stride, pad;
+    uint16_t dilation;              /* 0 for none */
+} conv_shape_t;
+
+static const conv_shape_t conv_shapes[] = {
+    {BENCH_MATRIX_QUICK, 10, 10, 16, 16, 1, 1, 1, 0},
+    {BENCH_MATRIX_QUICK, 10, 10, 8, 16, 3, 3, 1, 1},
+    {BENCH_MATRIX_QUICK, 1, 1, 64, 96, 1, 1, 1, 0},
+    {BENCH_MATRIX_DEFAULT, 48, 48, 3, 8, 3, 3, 2, 1},
+    {BENCH_MATRIX_DEFAULT, 24, 24, 16, 32, 1, 1, 1, 0},
+    {BENCH_MATRIX_DEFAULT, 12, 12, 64, 64, 1, 1, 1, 0},
+    {BENCH_MATRIX_DEFAULT, 12, 12, 32, 32, 3, 3, 1, 1},
+    {BENCH_MATRIX_DEFAULT, 6, 6, 128, 128, 1, 1, 1, 0},
+    {BENCH_MATRIX_DEFAULT, 20, 20, 9, 16, 5, 5, 1, 2},
+    {BENCH_MATRIX_LARGE, 96, 96, 1, 8, 3, 3, 2, 1},
+    {BENCH_MATRIX_LARGE, 56, 56, 32, 64, 1, 1, 1, 0},
+    {BENCH_MATRIX_LARGE, 28, 28, 64, 64, 3, 3, 1, 1},
+};
+
+typedef struct {
+    int level;
+    uint16_t in_wd, in_ht, channels, ch_mult;
+    uint16_t filter_wd, filter_ht, stride, pad;
+    uint16_t dilation;              /* 0 for none */
+} dw_shape_t;
+
+static const dw_shape_t dw_shapes[] = {
+    {BENCH_MATRIX_QUICK, 10, 10, 16, 1, 3, 3, 1, 1},
+    {BENCH_MATRIX_QUICK, 9, 9, 8, 2, 3, 3, 2, 0},
+    {BENCH_MATRIX_DEFAULT, 48, 48, 8, 1, 3, 3, 1, 1},
+    {BENCH_MATRIX_DEFAULT, 24, 24, 32, 1, 3, 3, 2, 1},
+    {BENCH_MATRIX_DEFAULT, 12, 12, 64, 1, 3, 3, 1, 1},
+    {BENCH_MATRIX_DEFAULT, 14, 14, 96, 1, 5, 5, 1, 2},
+    {BENCH_MATRIX_DEFAULT, 6, 6, 128, 1, 3, 3, 1, 1},
+    {BENCH_MATRIX_DEFAULT, 20, 20, 4, 4, 3, 3, 1, 1},
+    {BENCH_MATRIX_LARGE, 112, 112, 16, 1, 3, 3, 2, 1},
+    {BENCH_MATRIX_LARGE, 56, 56, 72, 1, 3, 3, 1, 1},
+};
+
+/* s8 only: the 16x8 and int4 kernels take no dilation */
+static const conv_shape_t dilated_conv_shapes[] = {
+    {BENCH_MATRIX_DEFAULT, 24, 24, 16, 16, 3, 3, 1, 2, 2},
+    {BENCH_MATRIX_LARGE, 40, 40, 3, 8, 3, 3, 1, 4, 4},
+};
+
+static const dw_shape_t dilated_dw_shapes[] = {
+    {BENCH_MATRIX_DEFAULT, 24, 24, 32, 1, 3, 3, 1, 2, 2},
+    {BENCH_MATRIX_LARGE, 28, 28, 16, 2, 3, 3, 1, 4, 4},
+};
+
+typedef struct {
+    data_dims_t input_dims, filter_dims, output_dims;
+    conv_params_t conv_params;
+    dw_conv_params_t dw_params;
+    quant_data_t quant;
+    int8_t *input, *filter, *out_ansi, *out_opt;
+    int32_t *bias;
+    esp_nn_workers_t workers;
+    esp_nn_conv_stream_t *stream;
+    esp_nn_ctx_t stream_ctx;
+} conv_arg_t;
+
+static void conv_ansi(void *arg)
+{
+    conv_arg_t *a = arg;
+    esp_nn_conv_s8_ansi(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                        &a->output_dims, a->out_ansi, &a->conv_params, &a->quant);
+}
+
+static void conv_opt(void *arg)
+{
+    conv_arg_t *a = arg;
+    esp_nn_conv_s8(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                   &a->output_dims, a->out_opt, &a->conv_params, &a->quant);
+}
+
+static void conv_workers(void *arg)
+{
+    conv_arg_t *a = arg;
+    esp_nn_conv_s8_workers(&a->workers, &a->input_dims, a->input, &a->filter_dims, a->filter,
+                           a->bias, &a->output_dims, a->out_opt, &a->conv_params, &a->quant);
+}
+
+/* the whole image a row at a time, output rows land where the layer puts them */
+static void conv_stream(void *arg)
+{
+    conv_arg_t *a = arg;
+    const int32_t in_row_size = a->input_dims.width * a->input_dims.channels;
+    const int32_t out_row_size = a->output_dims.width * a->output_dims.channels;
+    for (int32_t y = 0; y < a->input_dims.height; y++) {
+        esp_nn_conv_stream_push(&a->stream_ctx, a->stream, a->input + y * in_row_size,
+                                a->out_opt + a->stream->rows_out * out_row_size);
+    }
+}
+
+static void dw_ansi(void *arg)
+{
+    conv_arg_t *a = arg;
+    esp_nn_depthwise_conv_s8_ansi(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                                  &a->output_dims, a->out_ansi, &a->dw_params, &a->quant);
+}
+
+static void dw_opt(void *arg)
+{
+    conv_arg_t *a = arg;
+    esp_nn_depthwise_conv_s8(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                             &a->output_dims, a->out_opt, &a->dw_params, &a->quant);
+}
+
+static void dw_workers(void *arg)
+{
+    conv_arg_t *a = arg;
+    esp_nn_depthwise_conv_s8_workers(&a->workers, &a->input_dims, a->input, &a->filter_dims,
+                                     a->filter, a->bias, &a->output_dims, a->out_opt,
+                                     &a->dw_params, &a->quant);
+}
+
+/* one context with its own scratch per worker, released by workers_free */
+static bool workers_setup(conv_arg_t *a, esp_nn_worker_backend_t *backend,
+                          esp_nn_ctx_t *ctx, int32_t scratch_size)
+{
+    if (esp_nn_worker_backend_pthread_init(backend, BENCH_NUM_WORKERS) != 0) {
+        return false;
+    }
+    for (int w = 0; w < BENCH_NUM_WORKERS; w++) {
+        ctx[w] = (esp_nn_ctx_t) {.scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL};
+    }
+    a->workers = (esp_nn_workers_t) {BENCH_NUM_WORKERS, ctx, backend};
+    return true;
+}
+
+static void workers_free(esp_nn_worker_backend_t *backend, esp_nn_ctx_t *ctx)
+{
+    for (int w = 0; w < BENCH_NUM_WORKERS; w++) {
+        free(ctx[w].scratch);
+    }
+    esp_nn_worker_backend_pthread_deinit(backend);
+}
+
+static void conv_arg_alloc(conv_arg_t *a, int32_t filter_size, int32_t out_ch)
+{
+    const int32_t in_size = a->input_dims.width * a->input_dims.height * a->input_dims.channels;
+    const int32_t out_size = a->output_dims.width * a->output_dims.height * a->output_dims.channels;
+
+    a->input = bench_alloc(in_size);
+    a->filter = bench_alloc(filter_size);
+    a->out_ansi = bench_alloc(out_size);
+    a->out_opt = bench_alloc(out_size);
+    a->bias = bench_alloc(out_ch * sizeof(int32_t));
+    a->quant.mult = bench_alloc(out_ch * sizeof(int32_t));
+    a->quant.shift = bench_alloc(out_ch * sizeof(int32_t));
+    bench_fill_s8(a->input, in_size);
+    bench_fill_s8(a->filter, filter_size);
+    for (int i = 0; i < out_ch; i++) {
+        a->bias[i] = bench_rand_range(-20000, 20000);
+    }
+    bench_fill_quant(a->quant.mult, a->quant.shift, out_ch);
+}
+
+static void conv_arg_free(conv_arg_t *a)
+{
+    free(a->input);
+    free(a->filter);
+    free(a->out_ansi);
+    free(a->out_opt);
+    free(a->bias);
+    free(a->quant.mult);
+    free(a->quant.shift);
+}
+
+static void bench_conv(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    const bool run_single = bench_kernel_enabled(cfg, "conv_s8");
+    const bool run_workers = bench_kernel_enabled(cfg, "conv_s8_workers");
+    const bool run_stream = bench_kernel_enabled(cfg, "conv_s8_stream");
+
+    if (!run_single && !run_workers && !run_stream) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(conv_shapes) + ARRAY_SIZE(dilated_conv_shapes); i++) {
+        const conv_shape_t *s = i < ARRAY_SIZE(conv_shapes) ? &conv_shapes[i] :
+                                &dilated_conv_shapes[i - ARRAY_SIZE(conv_shapes)];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        const uint16_t dilation = s->dilation > 1 ? s->dilation : 1;
+        conv_arg_t a = {0};
+        a.input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->in_ch, 1};
+        a.filter_dims = (data_dims_t) {s->filter_wd, s->filter_ht, s->in_ch, 1};
+        a.output_dims = (data_dims_t) {
+            (s->in_wd + 2 * s->pad - dilation * (s->filter_wd - 1) - 1) / s->stride + 1,
+            (s->in_ht + 2 * s->pad - dilation * (s->filter_ht - 1) - 1) / s->stride + 1,
+            s->out_ch, 1};
+        a.conv_params = (conv_params_t) {
+            .in_offset = BENCH_IN_OFFSET, .out_offset = BENCH_OUT_OFFSET,
+            .stride = {s->stride, s->stride}, .padding = {s->pad, s->pad},
+            .dilation = {dilation, dilation}, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+        };
+        const int32_t filter_size = s->filter_wd * s->filter_ht * s->in_ch * s->out_ch;
+        conv_arg_alloc(&a, filter_size, s->out_ch);
+
+        int scratch_size = esp_nn_get_conv_scratch_size(&a.input_dims, &a.filter_dims,
+                                                        &a.output_dims, &a.conv_params);
+        void *scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+        esp_nn_set_conv_scratch_buf(scratch);
+
+        const int32_t out_size = a.output_dims.width * a.output_dims.height * s->out_ch;
+        const int64_t macs = (int64_t) out_size * s->filter_wd * s->filter_ht * s->in_ch;
+        const int64_t bytes = (int64_t) s->in_wd * s->in_ht * s->in_ch + filter_size +
+                              s->out_ch * 3 * sizeof(int32_t) + out_size;
+        const int len = snprintf(shape, sizeof(shape), "in=%dx%dx%d f=%dx%d out=%dx%dx%d s=%d p=%d",
+                                 s->in_wd, s->in_ht, s->in_ch, s->filter_wd, s->filter_ht,
+                                 a.output_dims.width, a.output_dims.height, s->out_ch,
+                                 s->stride, s->pad);
+        if (dilation > 1) {
+            snprintf(shape + len, sizeof(shape) - len, " d=%d", dilation);
+        }
+        if (run_single) {
+            bench_run_pair(cfg, rep, "conv_s8", shape, macs, bytes,
+                           conv_ansi, conv_opt, &a, a.out_ansi, a.out_opt, out_size);
+        }
+
+        esp_nn_set_conv_scratch_buf(NULL);
+        free(scratch);
+
+        esp_nn_worker_backend_t backend;
+        esp_nn_ctx_t ctx[BENCH_NUM_WORKERS];
+        scratch_size = esp_nn_get_conv_workers_scratch_size(BENCH_NUM_WORKERS, &a.input_dims,
+                                                            &a.filter_dims, &a.output_dims,
+                                                            &a.conv_params);
+        if (run_workers && workers_setup(&a, &backend, ctx, scratch_size)) {
+            bench_run_pair(cfg, rep, "conv_s8_workers", shape, macs, bytes,
+                           conv_ansi, conv_workers, &a, a.out_ansi, a.out_opt, out_size);
+            workers_free(&backend, ctx);
+        }
+
+        if (run_stream) {
+            void *blob = bench_alloc(esp_nn_get_conv_stream_size(&a.input_dims, &a.filter_dims,
+                                                                 &a.conv_params));
+            scratch_size = esp_nn_get_conv_stream_scratch_size(&a.input_dims, &a.filter_dims,
+                                                               &a.output_dims, &a.conv_params);
+            a.stream_ctx.scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+            a.stream = esp_nn_conv_stream_init(blob, &a.input_dims, &a.filter_dims, a.filter,
+                                               a.bias, &a.output_dims, &a.conv_params, &a.quant);
+            bench_run_pair(cfg, rep, "conv_s8_stream", shape, macs, bytes,
+                           conv_ansi, conv_stream, &a, a.out_ansi, a.out_opt, out_size);
+            free(a.stream_ctx.scratch);
+            free(blob);
+        }
+        conv_arg_free(&a);
+    }
+}
+
+static void bench_depthwise_conv(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    const bool run_single = bench_kernel_enabled(cfg, "depthwise_conv_s8");
+    const bool run_workers = bench_kernel_enabled(cfg, "depthwise_conv_s8_workers");
+
+    if (!run_single && !run_workers) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(dw_shapes) + ARRAY_SIZE(dilated_dw_shapes); i++) {
+        const dw_shape_t *s = i < ARRAY_SIZE(dw_shapes) ? &dw_shapes[i] :
+                              &dilated_dw_shapes[i - ARRAY_SIZE(dw_shapes)];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        const uint16_t dilation = s->dilation > 1 ? s->dilation : 1;
+        const uint16_t out_ch = s->channels * s->ch_mult;
+        conv_arg_t a = {0};
+        a.input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->channels, 1};
+        a.filter_dims = (data_dims_t) {s->filter_wd, s->filter_ht, out_ch, 1};
+        a.output_dims = (data_dims_t) {
+            (s->in_wd + 2 * s->pad - dilation * (s->filter_wd - 1) - 1) / s->stride + 1,
+            (s->in_ht + 2 * s->pad - dilation * (s->filter_ht - 1) - 1) / s->stride + 1,
+            out_ch, 1};
+        a.dw_params = (dw_conv_params_t) {
+            .in_offset = BENCH_IN_OFFSET, .out_offset = BENCH_OUT_OFFSET, .ch_mult = s->ch_mult,
+            .stride = {s->stride, s->stride}, .padding = {s->pad, s->pad},
+            .dilation = {dilation, dilation}, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+        };
+        const int32_t filter_size = s->filter_wd * s->filter_ht * out_ch;
+        conv_arg_alloc(&a, filter_size, out_ch);
+
+        int scratch_size = esp_nn_get_depthwise_conv_scratch_size(&a.input_dims, &a.filter_dims,
+                                                                  &a.output_dims, &a.dw_params);
+        void *scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+        esp_nn_set_depthwise_conv_scratch_buf(scratch);
+
+        const int32_t out_size = a.output_dims.width * a.output_dims.height * out_ch;
+        const int64_t macs = (int64_t) out_size * s->filter_wd * s->filter_ht;
+        const int64_t bytes = (int64_t) s->in_wd * s->in_ht * s->channels + filter_size +
+                              out_ch * 3 * sizeof(int32_t) + out_size;
+        const int len = snprintf(shape, sizeof(shape),
+                                 "in=%dx%dx%d f=%dx%d mult=%d out=%dx%dx%d s=%d p=%d",
+                                 s->in_wd, s->in_ht, s->channels, s->filter_wd, s->filter_ht,
+                                 s->ch_mult, a.output_dims.width, a.output_dims.height, out_ch,
+                                 s->stride, s->pad);
+        if (dilation > 1) {
+            snprintf(shape + len, sizeof(shape) - len, " d=%d", dilation);
+        }
+        if (run_single) {
+            bench_run_pair(cfg, rep, "depthwise_conv_s8", shape, macs, bytes,
+                           dw_ansi, dw_opt, &a, a.out_ansi, a.out_opt, out_size);
+        }
+
+        esp_nn_set_depthwise_conv_scratch_buf(NULL);
+        free(scratch);
+
+        esp_nn_worker_backend_t backend;
+        esp_nn_ctx_t ctx[BENCH_NUM_WORKERS];
+        scratch_size = esp_nn_get_depthwise_conv_workers_scratch_size(BENCH_NUM_WORKERS,
+                                                                      &a.input_dims,
+                                                                      &a.filter_dims,
+                                                                      &a.output_dims,
+                                                                      &a.dw_params);
+        if (run_workers && workers_setup(&a, &backend, ctx, scratch_size)) {
+            bench_run_pair(cfg, rep, "depthwise_conv_s8_workers", shape, macs, bytes,
+                           dw_ansi, dw_workers, &a, a.out_ansi, a.out_opt, out_size);
+            workers_free(&backend, ctx);
+        }
+        conv_arg_free(&a);
+    }
+}
+
+/****************************** fused blocks ******************************/
+
+typedef struct {
+    int level;
+    uint16_t in_wd, in_ht, in_ch;
+    uint16_t exp_ch;                // 0: no expansion
+    uint16_t stride, out_ch, tile_rows;
+} dw_pw_shape_t;
+
+/* 3x3 depthwise, padded by 1 */
+static const dw_pw_shape_t dw_pw_shapes[] = {
+    {BENCH_MATRIX_QUICK, 12, 12, 8, 0, 1, 16, 2},
+    {BENCH_MATRIX_QUICK, 12, 12, 8, 24, 2, 8, 3},
+    {BENCH_MATRIX_DEFAULT, 24, 24, 16, 96, 1, 24, 4},
+    {BENCH_MATRIX_DEFAULT, 24, 24, 32, 0, 2, 64, 2},
+    {BENCH_MATRIX_LARGE, 56, 56, 24, 144, 1, 24, 4},
+};
+
+typedef struct {
+    data_dims_t input_dims;
+    int8_t *input, *exp_out, *mid_out, *out_ansi, *out_opt;
+    esp_nn_fused_pw_t expand, project;
+    esp_nn_fused_dw_t dw;
+    bool has_expand;
+    int32_t tile_rows;
+    esp_nn_ctx_t ctx;
+} dw_pw_arg_t;
+
+static void dw_pw_ansi(void *arg)
+{
+    dw_pw_arg_t *a = arg;
+    const int8_t *dw_in = a->input;
+    const data_dims_t *dw_in_dims = &a->input_dims;
+    if (a->has_expand) {
+        esp_nn_conv_s8_ansi(&a->input_dims, a->input, &a->expand.filter_dims, a->expand.filter,
+                            a->expand.bias, &a->expand.output_dims, a->exp_out,
+                            &a->expand.params, &a->expand.quant_data);
+        dw_in = a->exp_out;
+        dw_in_dims = &a->expand.output_dims;
+    }
+    esp_nn_depthwise_conv_s8_ansi(dw_in_dims, dw_in, &a->dw.filter_dims, a->dw.filter,
+                                  a->dw.bias, &a->dw.output_dims, a->mid_out, &a->dw.params,
+                                  &a->dw.quant_data);
+    esp_nn_conv_s8_ansi(&a->dw.output_dims, a->mid_out, &a->project.filter_dims,
+                        a->project.filter, a->project.bias, &a->project.output_dims,
+                        a->out_ansi, &a->project.params, &a->project.quant_data);
+}
+
+static void dw_pw_fused(void *arg)
+{
+    dw_pw_arg_t *a = arg;
+    esp_nn_dw_pw_conv_s8(&a->ctx, &a->input_dims, a->input,
+                         a->has_expand ? &a->expand : NULL, &a->dw, &a->project,
+                         a->tile_rows, a->out_opt);
+}
+
+static void fused_pw_alloc(esp_nn_fused_pw_t *pw, const data_dims_t *input_dims,
+                           const int32_t out_ch)
+{
+    int8_t *filter = bench_alloc(input_dims->channels * out_ch);
+    int32_t *bias = bench_alloc(out_ch * sizeof(int32_t));
+    pw->quant_data.mult = bench_alloc(out_ch * sizeof(int32_t));
+    pw->quant_data.shift = bench_alloc(out_ch * sizeof(int32_t));
+    bench_fill_s8(filter, input_dims->channels * out_ch);
+    for (int i = 0; i < out_ch; i++) {
+        bias[i] = bench_rand_range(-20000, 20000);
+    }
+    bench_fill_quant(pw->quant_data.mult, pw->quant_data.shift, out_ch);
+    pw->filter = filter;
+    pw->bias = bias;
+    pw->filter_dims = (data_dims_t) {1, 1, input_dims->channels, 1};
+    pw->output_dims = (data_dims_t) {input_dims->width, input_dims->height, out_ch, 1};
+    pw->params = (conv_params_t) {
+        .in_offset = BENCH_IN_OFFSET, .out_offset = BENCH_OUT_OFFSET,
+        .stride = {1, 1}, .padding = {0, 0},
+        .dilation = {1, 1}, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+    };
+}
+
+static void fused_pw_free(esp_nn_fused_pw_t *pw)
+{
+    free((void *) pw->filter);
+    free((void *) pw->bias);
+    free(pw->quant_data.mult);
+    free(pw->quant_data.shift);
+}
+
+static void bench_dw_pw_conv(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    if (!bench_kernel_enabled(cfg, "dw_pw_conv_s8")) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(dw_pw_shapes); i++) {
+        const dw_pw_shape_t *s = &dw_pw_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        dw_pw_arg_t a = {0};
+        a.input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->in_ch, 1};
+        a.has_expand = s->exp_ch > 0;
+        a.tile_rows = s->tile_rows;
+        const int32_t in_size = s->in_wd * s->in_ht * s->in_ch;
+        a.input = bench_alloc(in_size);
+        bench_fill_s8(a.input, in_size);
+
+        data_dims_t dw_in_dims = a.input_dims;
+        if (a.has_expand) {
+            fused_pw_alloc(&a.expand, &a.input_dims, s->exp_ch);
+            dw_in_dims = a.expand.output_dims;
+            a.exp_out = bench_alloc(s->in_wd * s->in_ht * s->exp_ch);
+        }
+        const int32_t ch = dw_in_dims.channels;
+        const int32_t mid_wd = (s->in_wd + 2 - 3) / s->stride + 1;
+        const int32_t mid_ht = (s->in_ht + 2 - 3) / s->stride + 1;
+        int8_t *dw_filter = bench_alloc(9 * ch);
+        int32_t *dw_bias = bench_alloc(ch * sizeof(int32_t));
+        a.dw.quant_data.mult = bench_alloc(ch * sizeof(int32_t));
+        a.dw.quant_data.shift = bench_alloc(ch * sizeof(int32_t));
+        bench_fill_s8(dw_filter, 9 * ch);
+        for (int c = 0; c < ch; c++) {
+            dw_bias[c] = bench_rand_range(-20000, 20000);
+        }
+        bench_fill_quant(a.dw.quant_data.mult, a.dw.quant_data.shift, ch);
+        a.dw.filter = dw_filter;
+        a.dw.bias = dw_bias;
+        a.dw.filter_dims = (data_dims_t) {3, 3, ch, 1};
+        a.dw.output_dims = (data_dims_t) {mid_wd, mid_ht, ch, 1};
+        a.dw.params = (dw_conv_params_t) {
+            .in_offset = BENCH_IN_OFFSET, .out_offset = BENCH_OUT_OFFSET, .ch_mult = 1,
+            .stride = {s->stride, s->stride}, .padding = {1, 1},
+            .dilation = {1, 1}, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+        };
+        a.mid_out = bench_alloc(mid_wd * mid_ht * ch);
+        fused_pw_alloc(&a.project, &a.dw.output_dims, s->out_ch);
+
+        const int32_t out_size = mid_wd * mid_ht * s->out_ch;
+        a.out_ansi = bench_alloc(out_size);
+        a.out_opt = bench_alloc(out_size);
+        a.ctx.scratch = bench_alloc(esp_nn_get_dw_pw_conv_scratch_size(&a.input_dims,
+                                    a.has_expand ? &a.expand : NULL, &a.dw, &a.project,
+                                    a.tile_rows));
+
+        const int64_t macs = (int64_t) s->in_wd * s->in_ht * s->in_ch * s->exp_ch +
+                             (int64_t) mid_wd * mid_ht * ch * (9 + s->out_ch);
+        const int64_t bytes = in_size + out_size;
+        snprintf(shape, sizeof(shape), "in=%dx%dx%d exp=%d s=%d out=%dx%dx%d tile=%d",
+                 s->in_wd, s->in_ht, s->in_ch, s->exp_ch, s->stride,
+                 mid_wd, mid_ht, s->out_ch, s->tile_rows);
+        bench_run_pair(cfg, rep, "dw_pw_conv_s8", shape, macs, bytes,
+                       dw_pw_ansi, dw_pw_fused, &a, a.out_ansi, a.out_opt, out_size);
+
+        if (a.has_expand) {
+            fused_pw_free(&a.expand);
+            free(a.exp_out);
+        }
+        fused_pw_free(&a.project);
+        free(dw_filter);
+        free(dw_bias);
+        free(a.dw.quant_data.mult);
+        free(a.dw.quant_data.shift);
+        free(a.input);
+        free(a.mid_out);
+        free(a.out_ansi);
+        free(a.out_opt);
+        free(a.ctx.scratch);
+    }
+}
+
+/****************************** pooling / mean ******************************/
+
+typedef struct {
+    int level;
+    uint16_t in_wd, in_ht, channels;
+    uint16_t filter_wd, filter_ht, stride, pad;
+} pool_shape_t;
+
+static const pool_shape_t pool_shapes[] = {
+    {BENCH_MATRIX_QUICK, 16, 16, 16, 3, 3, 2, 0},
+    {BENCH_MATRIX_DEFAULT, 6, 6, 256, 6, 6, 1, 0},
+    {BENCH_MATRIX_DEFAULT, 24, 24, 32, 2, 2, 2, 0},
+    {BENCH_MATRIX_DEFAULT, 14, 14, 30, 3, 3, 1, 1},
+    {BENCH_MATRIX_LARGE, 56, 56, 64, 3, 3, 2, 1},
+};
+
+typedef struct {
+    const pool_shape_t *s;
+    uint16_t out_wd, out_ht;
+    int8_t *input, *out_ansi, *out_opt;
+} pool_arg_t;
+
+#define POOL_ARGS(a, out) (a)->input, (a)->s->in_wd, (a)->s->in_ht, out, (a)->out_wd, (a)->out_ht, \
+        (a)->s->stride, (a)->s->stride, (a)->s->filter_wd, (a)->s->filter_ht,                    \
+        (a)->s->pad, (a)->s->pad, BENCH_ACT_MIN, BENCH_ACT_MAX, (a)->s->channels
+
+static void avg_pool_ansi(void *arg)
+{
+    pool_arg_t *a = arg;
+    esp_nn_avg_pool_s8_ansi(POOL_ARGS(a, a->out_ansi));
+}
+
+static void avg_pool_opt(void *arg)
+{
+    pool_arg_t *a = arg;
+    esp_nn_avg_pool_s8(POOL_ARGS(a, a->out_opt));
+}
+
+static void max_pool_ansi(void *arg)
+{
+    pool_arg_t *a = arg;
+    esp_nn_max_pool_s8_ansi(POOL_ARGS(a, a->out_ansi));
+}
+
+static void max_pool_opt(void *arg)
+{
+    pool_arg_t *a = arg;
+    esp_nn_max_pool_s8(POOL_ARGS(a, a->out_opt));
+}
+
+#define MEAN_ARGS(a, out) (a)->input, out, (a)->s->in_ht, (a)->s->in_wd, (a)->s->channels, \
+        -128, -128, 1073741824, -1
+
+static void mean_ansi(void *arg)
+{
+    pool_arg_t *a = arg;
+    esp_nn_mean_nhwc_s8_ansi(MEAN_ARGS(a, a->out_ansi));
+}
+
+static void mean_opt(void *arg)
+{
+    pool_arg_t *a = arg;
+    esp_nn_mean_nhwc_s8(MEAN_ARGS(a, a->out_opt));
+}
+
+static void bench_pooling(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    for (int i = 0; i < ARRAY_SIZE(pool_shapes); i++) {
+        const pool_shape_t *s = &pool_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        pool_arg_t a = {.s = s};
+        a.out_wd = (s->in_wd + 2 * s->pad - s->filter_wd) / s->stride + 1;
+        a.out_ht = (s->in_ht + 2 * s->pad - s->filter_ht) / s->stride + 1;
+        const int32_t in_size = s->in_wd * s->in_ht * s->channels;
+        const int32_t out_size = a.out_wd * a.out_ht * s->channels;
+        a.input = bench_alloc(in_size);
+        a.out_ansi = bench_alloc(in_size);
+        a.out_opt = bench_alloc(in_size);
+        bench_fill_s8(a.input, in_size);
+
+        const int64_t ops = (int64_t) out_size * s->filter_wd * s->filter_ht;
+        snprintf(shape, sizeof(shape), "in=%dx%dx%d f=%dx%d out=%dx%d s=%d p=%d",
+                 s->in_wd, s->in_ht, s->channels, s->filter_wd, s->filter_ht,
+                 a.out_wd, a.out_ht, s->stride, s->pad);
+        if (bench_kernel_enabled(cfg, "avg_pool_s8")) {
+            bench_run_pair(cfg, rep, "avg_pool_s8", shape, ops, in_size + out_size,
+                           avg_pool_ansi, avg_pool_opt, &a, a.out_ansi, a.out_opt, out_size);
+        }
+        if (bench_kernel_enabled(cfg, "max_pool_s8")) {
+            bench_run_pair(cfg, rep, "max_pool_s8", shape, ops, in_size + out_size,
+                           max_pool_ansi, max_pool_opt, &a, a.out_ansi, a.out_opt, out_size);
+        }
+        if (bench_kernel_enabled(cfg, "mean_nhwc_s8")) {
+            snprintf(shape, sizeof(shape), "in=%dx%dx%d", s->in_wd, s->in_ht, s->channels);
+            bench_run_pair(cfg, rep, "mean_nhwc_s8", shape, in_size, in_size + s->channels,
+                           mean_ansi, mean_opt, &a, a.out_ansi, a.out_opt, s->channels);
+        }
+        free(a.input);
+        free(a.out_ansi);
+        free(a.out_opt);
+    }
+}
+
+/****************************** fully connected ******************************/
+
+typedef struct {
+    int level;
+    uint16_t row_len, out_ch;
+} fc_shape_t;
+
+static const fc_shape_t fc_shapes[] = {
+    {BENCH_MATRIX_QUICK, 271, 3},
+    {BENCH_MATRIX_QUICK, 64, 16},
+    {BENCH_MATRIX_DEFAULT, 256, 2},
+    {BENCH_MATRIX_DEFAULT, 576, 1024},
+    {BENCH_MATRIX_DEFAULT, 1024, 10},
+    {BENCH_MATRIX_DEFAULT, 7, 8},
+    {BENCH_MATRIX_LARGE, 1024, 1000},
+};
+
+typedef struct {
+    uint16_t row_len, out_ch;
+    int8_t *input, *filter, *out_ansi, *out_opt;
+    int32_t *bias, *mult, *shift;
+    esp_nn_fc_prepared_t *prepared;
+    int8_t *pruned;                 // filter with 3 in 4 of its 1x16 blocks zeroed
+    esp_nn_fc_sparse_t *sparse;
+} fc_arg_t;
+
+#define FC_ARGS(a, out) (a)->input, BENCH_IN_OFFSET, (a)->row_len, (a)->filter, 0, (a)->bias, \
+        out, (a)->out_ch, BENCH_OUT_OFFSET
+
+static void fc_ansi(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_s8_ansi(FC_ARGS(a, a->out_ansi), a->shift[0], a->mult[0],
+                                   BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+static void fc_opt(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_s8(FC_ARGS(a, a->out_opt), a->shift[0], a->mult[0],
+                              BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+static void fc_per_ch_ansi(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_per_ch_s8_ansi(FC_ARGS(a, a->out_ansi), a->shift, a->mult,
+                                          BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+static void fc_per_ch_opt(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_per_ch_s8(FC_ARGS(a, a->out_opt), a->shift, a->mult,
+                                     BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+/* per channel layer prepared once with interleaved weights, run per call */
+static void fc_prepared_opt(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_s8_run(a->prepared, a->input, a->out_opt);
+}
+
+/* dense reference on the pruned weights */
+static void fc_pruned_ansi(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_per_ch_s8_ansi(a->input, BENCH_IN_OFFSET, a->row_len, a->pruned, 0, a->bias,
+                                          a->out_ansi, a->out_ch, BENCH_OUT_OFFSET, a->shift, a->mult,
+                                          BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+static void fc_sparse_opt(void *arg)
+{
+    fc_arg_t *a = arg;
+    esp_nn_fully_connected_s8_sparse_run(a->sparse, a->input, a->out_opt);
+}
+
+static void bench_fully_connected(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    for (int i = 0; i < ARRAY_SIZE(fc_shapes); i++) {
+        const fc_shape_t *s = &fc_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        fc_arg_t a = {.row_len = s->row_len, .out_ch = s->out_ch};
+        const int32_t filter_size = s->row_len * s->out_ch;
+        a.input = bench_alloc(s->row_len);
+        a.filter = bench_alloc(filter_size);
+        a.out_ansi = bench_alloc(s->out_ch);
+        a.out_opt = bench_alloc(s->out_ch);
+        a.bias = bench_alloc(s->out_ch * sizeof(int32_t));
+        a.mult = bench_alloc(s->out_ch * sizeof(int32_t));
+        a.shift = bench_alloc(s->out_ch * sizeof(int32_t));
+        bench_fill_s8(a.input, s->row_len);
+        bench_fill_s8(a.filter, filter_size);
+        for (int ch = 0; ch < s->out_ch; ch++) {
+            a.bias[ch] = bench_rand_range(-20000, 20000);
+        }
+        bench_fill_quant(a.mult, a.shift, s->out_ch);
+
+        const int64_t bytes = (int64_t) s->row_len + filter_size + s->out_ch * sizeof(int32_t) + s->out_ch;
+        snprintf(shape, sizeof(shape), "row_len=%d out_ch=%d", s->row_len, s->out_ch);
+        if (bench_kernel_enabled(cfg, "fully_connected_s8")) {
+            bench_run_pair(cfg, rep, "fully_connected_s8", shape, filter_size, bytes,
+                           fc_ansi, fc_opt, &a, a.out_ansi, a.out_opt, s->out_ch);
+        }
+        if (bench_kernel_enabled(cfg, "fully_connected_per_ch_s8")) {
+            bench_run_pair(cfg, rep, "fully_connected_per_ch_s8", shape, filter_size,
+                           bytes + s->out_ch * 2 * sizeof(int32_t),
+                           fc_per_ch_ansi, fc_per_ch_opt, &a, a.out_ansi, a.out_opt, s->out_ch);
+        }
+        if (bench_kernel_enabled(cfg, "fully_connected_s8_prepared")) {
+            void *blob = bench_alloc(esp_nn_get_fully_connected_prepared_size(s->row_len, s->out_ch,
+                                                                              ESP_NN_FC_LAYOUT_INTERLEAVED));
+            a.prepared = esp_nn_fully_connected_per_ch_s8_prepare(blob, ESP_NN_FC_LAYOUT_INTERLEAVED,
+                                                                  BENCH_IN_OFFSET, s->row_len, a.filter, 0,
+                                                                  a.bias, s->out_ch, BENCH_OUT_OFFSET,
+                                                                  a.shift, a.mult,
+                                                                  BENCH_ACT_MIN, BENCH_ACT_MAX);
+            bench_run_pair(cfg, rep, "fully_connected_s8_prepared", shape, filter_size,
+                           bytes + s->out_ch * 2 * sizeof(int32_t),
+                           fc_per_ch_ansi, fc_prepared_opt, &a, a.out_ansi, a.out_opt, s->out_ch);
+            free(blob);
+        }
+        if (bench_kernel_enabled(cfg, "fully_connected_s8_sparse")) {
+            a.pruned = bench_alloc(filter_size);
+            memcpy(a.pruned, a.filter, filter_size);
+            for (int ch = 0; ch < s->out_ch; ch++) {
+                for (int idx = 0; idx < s->row_len; idx += ESP_NN_FC_SPARSE_BLOCK) {
+                    const int len = s->row_len - idx < ESP_NN_FC_SPARSE_BLOCK ?
+                                    s->row_len - idx : ESP_NN_FC_SPARSE_BLOCK;
+                    if (bench_rand_range(0, 3) != 0) {
+                        memset(a.pruned + ch * s->row_len + idx, 0, len);
+                    }
+                }
+            }
+            const int32_t sparse_size = esp_nn_get_fully_connected_sparse_size(a.pruned, s->row_len,
+                                                                              s->out_ch);
+            void *blob = bench_alloc(sparse_size);
+            a.sparse = esp_nn_fully_connected_per_ch_s8_sparse_pack(blob, BENCH_IN_OFFSET, s->row_len,
+                                                                    a.pruned, a.bias, s->out_ch,
+                                                                    BENCH_OUT_OFFSET, a.shift, a.mult,
+                                                                    BENCH_ACT_MIN, BENCH_ACT_MAX);
+            bench_run_pair(cfg, rep, "fully_connected_s8_sparse", shape,
+                           a.sparse->blocks * ESP_NN_FC_SPARSE_BLOCK, s->row_len + sparse_size + s->out_ch,
+                           fc_pruned_ansi, fc_sparse_opt, &a, a.out_ansi, a.out_opt, s->out_ch);
+            free(blob);
+            free(a.pruned);
+        }
+        free(a.input);
+        free(a.filter);
+        free(a.out_ansi);
+        free(a.out_opt);
+        free(a.bias);
+        free(a.mult);
+        free(a.shift);
+    }
+}
+
+/****************************** 16x8 ******************************/
+
+/*
+ * int16 activations on the conv, depthwise and fully connected shapes.
+ * Sums are a few hundred times larger than with int8 inputs: shifts are
+ * lowered to keep the outputs off the rails.
+ */
+#define BENCH_S16_SHIFT     -8
+
+typedef struct {
+    data_dims_t input_dims, filter_dims, output_dims;
+    conv_params_t conv_params;
+    dw_conv_params_t dw_params;
+    quant_data_t quant;
+    uint16_t row_len, out_ch;
+    int16_t *input, *out_ansi, *out_opt;
+    int8_t *filter;
+    int64_t *bias;
+} s16_arg_t;
+
+static void conv_s16_ansi(void *arg)
+{
+    s16_arg_t *a = arg;
+    esp_nn_conv_s16_ansi(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                         &a->output_dims, a->out_ansi, &a->conv_params, &a->quant);
+}
+
+static void conv_s16_opt(void *arg)
+{
+    s16_arg_t *a = arg;
+    esp_nn_conv_s16(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                    &a->output_dims, a->out_opt, &a->conv_params, &a->quant);
+}
+
+static void dw_s16_ansi(void *arg)
+{
+    s16_arg_t *a = arg;
+    esp_nn_depthwise_conv_s16_ansi(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                                   &a->output_dims, a->out_ansi, &a->dw_params, &a->quant);
+}
+
+static void dw_s16_opt(void *arg)
+{
+    s16_arg_t *a = arg;
+    esp_nn_depthwise_conv_s16(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                              &a->output_dims, a->out_opt, &a->dw_params, &a->quant);
+}
+
+static void fc_s16_ansi(void *arg)
+{
+    s16_arg_t *a = arg;
+    esp_nn_fully_connected_s16_ansi(a->input, a->row_len, a->filter, a->bias, a->out_ansi,
+                                    a->out_ch, 0, a->quant.shift[0], a->quant.mult[0],
+                                    INT16_MIN, INT16_MAX);
+}
+
+static void fc_s16_opt(void *arg)
+{
+    s16_arg_t *a = arg;
+    esp_nn_fully_connected_s16(a->input, a->row_len, a->filter, a->bias, a->out_opt,
+                               a->out_ch, 0, a->quant.shift[0], a->quant.mult[0],
+                               INT16_MIN, INT16_MAX);
+}
+
+static void s16_arg_alloc(s16_arg_t *a, int32_t in_size, int32_t filter_size,
+                          int32_t out_size, int32_t out_ch)
+{
+    a->input = bench_alloc(in_size * sizeof(int16_t));
+    a->filter = bench_alloc(filter_size);
+    a->out_ansi = bench_alloc(out_size * sizeof(int16_t));
+    a->out_opt = bench_alloc(out_size * sizeof(int16_t));
+    a->bias = bench_alloc(out_ch * sizeof(int64_t));
+    a->quant.mult = bench_alloc(out_ch * sizeof(int32_t));
+    a->quant.shift = bench_alloc(out_ch * sizeof(int32_t));
+    for (int i = 0; i < in_size; i++) {
+        a->input[i] = (int16_t) bench_rand_range(INT16_MIN, INT16_MAX);
+    }
+    bench_fill_s8(a->filter, filter_size);
+    for (int i = 0; i < out_ch; i++) {
+        a->bias[i] = bench_rand_range(-5000000, 5000000);
+    }
+    bench_fill_quant(a->quant.mult, a->quant.shift, out_ch);
+    for (int i = 0; i < out_ch; i++) {
+        a->quant.shift[i] += BENCH_S16_SHIFT;
+    }
+}
+
+static void s16_arg_free(s16_arg_t *a)
+{
+    free(a->input);
+    free(a->filter);
+    free(a->out_ansi);
+    free(a->out_opt);
+    free(a->bias);
+    free(a->quant.mult);
+    free(a->quant.shift);
+}
+
+static void bench_s16(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    for (int i = 0; i < ARRAY_SIZE(conv_shapes) && bench_kernel_enabled(cfg, "conv_s16"); i++) {
+        const conv_shape_t *s = &conv_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        s16_arg_t a = {0};
+        a.input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->in_ch, 1};
+        a.filter_dims = (data_dims_t) {s->filter_wd, s->filter_ht, s->in_ch, 1};
+        a.output_dims = (data_dims_t) {(s->in_wd + 2 * s->pad - s->filter_wd) / s->stride + 1,
+                                       (s->in_ht + 2 * s->pad - s->filter_ht) / s->stride + 1,
+                                       s->out_ch, 1};
+        a.conv_params = (conv_params_t) {
+            .stride = {s->stride, s->stride}, .padding = {s->pad, s->pad},
+            .dilation = {1, 1}, .activation = {INT16_MIN, INT16_MAX},
+        };
+        const int32_t in_size = s->in_wd * s->in_ht * s->in_ch;
+        const int32_t filter_size = s->filter_wd * s->filter_ht * s->in_ch * s->out_ch;
+        const int32_t out_size = a.output_dims.width * a.output_dims.height * s->out_ch;
+        s16_arg_alloc(&a, in_size, filter_size, out_size, s->out_ch);
+
+        const int64_t macs = (int64_t) out_size * s->filter_wd * s->filter_ht * s->in_ch;
+        const int64_t bytes = (int64_t) in_size * 2 + filter_size +
+                              s->out_ch * (sizeof(int64_t) + 2 * sizeof(int32_t)) + out_size * 2;
+        snprintf(shape, sizeof(shape), "in=%dx%dx%d f=%dx%d out=%dx%dx%d s=%d p=%d",
+                 s->in_wd, s->in_ht, s->in_ch, s->filter_wd, s->filter_ht,
+                 a.output_dims.width, a.output_dims.height, s->out_ch, s->stride, s->pad);
+        bench_run_pair(cfg, rep, "conv_s16", shape, macs, bytes, conv_s16_ansi, conv_s16_opt, &a,
+                       (int8_t *) a.out_ansi, (int8_t *) a.out_opt, out_size * 2);
+        s16_arg_free(&a);
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(dw_shapes) && bench_kernel_enabled(cfg, "depthwise_conv_s16"); i++) {
+        const dw_shape_t *s = &dw_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        const uint16_t out_ch = s->channels * s->ch_mult;
+        s16_arg_t a = {0};
+        a.input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->channels, 1};
+        a.filter_dims = (data_dims_t) {s->filter_wd, s->filter_ht, out_ch, 1};
+        a.output_dims = (data_dims_t) {(s->in_wd + 2 * s->pad - s->filter_wd) / s->stride + 1,
+                                       (s->in_ht + 2 * s->pad - s->filter_ht) / s->stride + 1,
+                                       out_ch, 1};
+        a.dw_params = (dw_conv_params_t) {
+            .ch_mult = s->ch_mult, .stride = {s->stride, s->stride}, .padding = {s->pad, s->pad},
+            .dilation = {1, 1}, .activation = {INT16_MIN, INT16_MAX},
+        };
+        const int32_t in_size = s->in_wd * s->in_ht * s->channels;
+        const int32_t filter_size = s->filter_wd * s->filter_ht * out_ch;
+        const int32_t out_size = a.output_dims.width * a.output_dims.height * out_ch;
+        s16_arg_alloc(&a, in_size, filter_size, out_size, out_ch);
+
+        const int64_t macs = (int64_t) out_size * s->filter_wd * s->filter_ht;
+        const int64_t bytes = (int64_t) in_size * 2 + filter_size +
+                              out_ch * (sizeof(int64_t) + 2 * sizeof(int32_t)) + out_size * 2;
+        snprintf(shape, sizeof(shape), "in=%dx%dx%d f=%dx%d mult=%d out=%dx%dx%d s=%d p=%d",
+                 s->in_wd, s->in_ht, s->channels, s->filter_wd, s->filter_ht, s->ch_mult,
+                 a.output_dims.width, a.output_dims.height, out_ch, s->stride, s->pad);
+        bench_run_pair(cfg, rep, "depthwise_conv_s16", shape, macs, bytes, dw_s16_ansi, dw_s16_opt, &a,
+                       (int8_t *) a.out_ansi, (int8_t *) a.out_opt, out_size * 2);
+        s16_arg_free(&a);
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(fc_shapes) && bench_kernel_enabled(cfg, "fully_connected_s16"); i++) {
+        const fc_shape_t *s = &fc_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        s16_arg_t a = {.row_len = s->row_len, .out_ch = s->out_ch};
+        const int32_t filter_size = s->row_len * s->out_ch;
+        s16_arg_alloc(&a, s->row_len, filter_size, s->out_ch, s->out_ch);
+
+        const int64_t bytes = (int64_t) s->row_len * 2 + filter_size +
+                              s->out_ch * sizeof(int64_t) + s->out_ch * 2;
+        snprintf(shape, sizeof(shape), "row_len=%d out_ch=%d", s->row_len, s->out_ch);
+        bench_run_pair(cfg, rep, "fully_connected_s16", shape, filter_size, bytes,
+                       fc_s16_ansi, fc_s16_opt, &a,
+                       (int8_t *) a.out_ansi, (int8_t *) a.out_opt, s->out_ch * 2);
+        s16_arg_free(&a);
+    }
+}
+
+/****************************** int4 weights ******************************/
+
+/*
+ * Packed int4 weights on the conv and fully connected shapes. Weights are
+ * 16 times smaller than int8 ones: shifts are raised to keep the outputs
+ * spread.
+ */
+#define BENCH_S4_SHIFT      4
+
+typedef struct {
+    data_dims_t input_dims, filter_dims, output_dims;
+    conv_params_t conv_params;
+    quant_data_t quant;
+    uint16_t row_len, out_ch;
+    int8_t *input, *filter, *out_ansi, *out_opt;
+    int32_t *bias;
+} s4_arg_t;
+
+static void conv_s4_ansi(void *arg)
+{
+    s4_arg_t *a = arg;
+    esp_nn_conv_s4_ansi(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                        &a->output_dims, a->out_ansi, &a->conv_params, &a->quant);
+}
+
+static void conv_s4_opt(void *arg)
+{
+    s4_arg_t *a = arg;
+    esp_nn_conv_s4(&a->input_dims, a->input, &a->filter_dims, a->filter, a->bias,
+                   &a->output_dims, a->out_opt, &a->conv_params, &a->quant);
+}
+
+static void fc_s4_ansi(void *arg)
+{
+    s4_arg_t *a = arg;
+    esp_nn_fully_connected_per_ch_s4_ansi(a->input, BENCH_IN_OFFSET, a->row_len, a->filter, a->bias,
+                                          a->out_ansi, a->out_ch, BENCH_OUT_OFFSET,
+                                          a->quant.shift, a->quant.mult, BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+static void fc_s4_opt(void *arg)
+{
+    s4_arg_t *a = arg;
+    esp_nn_fully_connected_per_ch_s4(a->input, BENCH_IN_OFFSET, a->row_len, a->filter, a->bias,
+                                     a->out_opt, a->out_ch, BENCH_OUT_OFFSET,
+                                     a->quant.shift, a->quant.mult, BENCH_ACT_MIN, BENCH_ACT_MAX);
+}
+
+/* `rows` filters of `row_len` int4 weights, packed */
+static void s4_arg_alloc(s4_arg_t *a, int32_t in_size, int32_t rows, int32_t row_len, int32_t out_size)
+{
+    int8_t *weights = bench_alloc(rows * row_len);
+    for (int i = 0; i < rows * row_len; i++) {
+        weights[i] = (int8_t) bench_rand_range(-8, 7);
+    }
+    a->filter = bench_alloc(esp_nn_get_s4_packed_size(rows, row_len));
+    esp_nn_s4_pack(a->filter, weights, rows, row_len);
+    free(weights);
+
+    a->input = bench_alloc(in_size);
+    a->out_ansi = bench_alloc(out_size);
+    a->out_opt = bench_alloc(out_size);
+    a->bias = bench_alloc(rows * sizeof(int32_t));
+    a->quant.mult = bench_alloc(rows * sizeof(int32_t));
+    a->quant.shift = bench_alloc(rows * sizeof(int32_t));
+    bench_fill_s8(a->input, in_size);
+    for (int i = 0; i < rows; i++) {
+        a->bias[i] = bench_rand_range(-2000, 2000);
+    }
+    bench_fill_quant(a->quant.mult, a->quant.shift, rows);
+    for (int i = 0; i < rows; i++) {
+        a->quant.shift[i] += BENCH_S4_SHIFT;
+    }
+}
+
+static void s4_arg_free(s4_arg_t *a)
+{
+    free(a->input);
+    free(a->filter);
+    free(a->out_ansi);
+    free(a->out_opt);
+    free(a->bias);
+    free(a->quant.mult);
+    free(a->quant.shift);
+}
+
+static void bench_s4(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    for (int i = 0; i < ARRAY_SIZE(conv_shapes) && bench_kernel_enabled(cfg, "conv_s4"); i++) {
+        const conv_shape_t *s = &conv_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        s4_arg_t a = {0};
+        a.input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->in_ch, 1};
+        a.filter_dims = (data_dims_t) {s->filter_wd, s->filter_ht, s->in_ch, 1};
+        a.output_dims = (data_dims_t) {(s->in_wd + 2 * s->pad - s->filter_wd) / s->stride + 1,
+                                       (s->in_ht + 2 * s->pad - s->filter_ht) / s->stride + 1,
+                                       s->out_ch, 1};
+        a.conv_params = (conv_params_t) {
+            .in_offset = BENCH_IN_OFFSET, .out_offset = BENCH_OUT_OFFSET,
+            .stride = {s->stride, s->stride}, .padding = {s->pad, s->pad},
+            .dilation = {1, 1}, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+        };
+        const int32_t in_size = s->in_wd * s->in_ht * s->in_ch;
+        const int32_t row_len = s->filter_wd * s->filter_ht * s->in_ch;
+        const int32_t out_size = a.output_dims.width * a.output_dims.height * s->out_ch;
+        s4_arg_alloc(&a, in_size, s->out_ch, row_len, out_size);
+
+        const int64_t macs = (int64_t) out_size * row_len;
+        const int64_t bytes = (int64_t) in_size + esp_nn_get_s4_packed_size(s->out_ch, row_len) +
+                              s->out_ch * 3 * sizeof(int32_t) + out_size;
+        snprintf(shape, sizeof(shape), "in=%dx%dx%d f=%dx%d out=%dx%dx%d s=%d p=%d",
+                 s->in_wd, s->in_ht, s->in_ch, s->filter_wd, s->filter_ht,
+                 a.output_dims.width, a.output_dims.height, s->out_ch, s->stride, s->pad);
+        bench_run_pair(cfg, rep, "conv_s4", shape, macs, bytes, conv_s4_ansi, conv_s4_opt, &a,
+                       a.out_ansi, a.out_opt, out_size);
+        s4_arg_free(&a);
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(fc_shapes) && bench_kernel_enabled(cfg, "fully_connected_per_ch_s4"); i++) {
+        const fc_shape_t *s = &fc_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        s4_arg_t a = {.row_len = s->row_len, .out_ch = s->out_ch};
+        s4_arg_alloc(&a, s->row_len, s->out_ch, s->row_len, s->out_ch);
+
+        const int64_t bytes = (int64_t) s->row_len + esp_nn_get_s4_packed_size(s->out_ch, s->row_len) +
+                              s->out_ch * 3 * sizeof(int32_t) + s->out_ch;
+        snprintf(shape, sizeof(shape), "row_len=%d out_ch=%d", s->row_len, s->out_ch);
+        bench_run_pair(cfg, rep, "fully_connected_per_ch_s4", shape, s->row_len * s->out_ch, bytes,
+                       fc_s4_ansi, fc_s4_opt, &a, a.out_ansi, a.out_opt, s->out_ch);
+        s4_arg_free(&a);
+    }
+}
+
+/****************************** transpose convolution ******************************/
+
+/* conv_shape_t read backwards: the input is upsampled `stride` times */
+static const conv_shape_t transpose_conv_shapes[] = {
+    {BENCH_MATRIX_QUICK, 4, 4, 16, 8, 3, 3, 2, 1},
+    {BENCH_MATRIX_QUICK, 5, 5, 8, 8, 4, 4, 2, 1},
+    {BENCH_MATRIX_DEFAULT, 8, 8, 32, 16, 3, 3, 2, 1},
+    {BENCH_MATRIX_DEFAULT, 12, 12, 16, 16, 2, 2, 2, 0},
+    {BENCH_MATRIX_DEFAULT, 10, 10, 12, 8, 3, 3, 1, 1},
+    {BENCH_MATRIX_LARGE, 16, 16, 64, 32, 4, 4, 2, 1},
+};
+
+typedef struct {
+    conv_arg_t conv;
+    esp_nn_ctx_t ctx;
+} transpose_conv_arg_t;
+
+static void transpose_conv_ansi(void *arg)
+{
+    transpose_conv_arg_t *t = arg;
+    conv_arg_t *a = &t->conv;
+    esp_nn_transpose_conv_s8_ansi(&t->ctx, &a->input_dims, a->input, &a->filter_dims, a->filter,
+                                  a->bias, &a->output_dims, a->out_ansi, &a->conv_params, &a->quant);
+}
+
+static void transpose_conv_opt(void *arg)
+{
+    transpose_conv_arg_t *t = arg;
+    conv_arg_t *a = &t->conv;
+    esp_nn_transpose_conv_s8(&t->ctx, &a->input_dims, a->input, &a->filter_dims, a->filter,
+                             a->bias, &a->output_dims, a->out_opt, &a->conv_params, &a->quant);
+}
+
+static void bench_transpose_conv(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    if (!bench_kernel_enabled(cfg, "transpose_conv_s8")) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(transpose_conv_shapes); i++) {
+        const conv_shape_t *s = &transpose_conv_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        transpose_conv_arg_t t = {0};
+        conv_arg_t *a = &t.conv;
+        a->input_dims = (data_dims_t) {s->in_wd, s->in_ht, s->in_ch, 1};
+        a->filter_dims = (data_dims_t) {s->filter_wd, s->filter_ht, s->in_ch, 1};
+        a->output_dims = (data_dims_t) {(s->in_wd - 1) * s->stride + s->filter_wd - 2 * s->pad,
+                                        (s->in_ht - 1) * s->stride + s->filter_ht - 2 * s->pad,
+                                        s->out_ch, 1};
+        a->conv_params = (conv_params_t) {
+            .in_offset = BENCH_IN_OFFSET, .out_offset = BENCH_OUT_OFFSET,
+            .stride = {s->stride, s->stride}, .padding = {s->pad, s->pad},
+            .dilation = {1, 1}, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+        };
+        const int32_t filter_size = s->filter_wd * s->filter_ht * s->in_ch * s->out_ch;
+        conv_arg_alloc(a, filter_size, s->out_ch);
+
+        const int32_t scratch_size = esp_nn_get_transpose_conv_scratch_size(&a->input_dims, &a->filter_dims,
+                                                                            &a->output_dims, &a->conv_params);
+        t.ctx.scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+
+        /* every input pixel meets every filter tap, less the ones the padding crops */
+        const int32_t out_size = a->output_dims.width * a->output_dims.height * s->out_ch;
+        const int64_t macs = (int64_t) s->in_wd * s->in_ht * filter_size;
+        const int64_t bytes = (int64_t) s->in_wd * s->in_ht * s->in_ch + filter_size +
+                              s->out_ch * 3 * sizeof(int32_t) + out_size;
+        snprintf(shape, sizeof(shape), "in=%dx%dx%d f=%dx%d out=%dx%dx%d s=%d p=%d",
+                 s->in_wd, s->in_ht, s->in_ch, s->filter_wd, s->filter_ht,
+                 a->output_dims.width, a->output_dims.height, s->out_ch, s->stride, s->pad);
+        bench_run_pair(cfg, rep, "transpose_conv_s8", shape, macs, bytes,
+                       transpose_conv_ansi, transpose_conv_opt, &t, a->out_ansi, a->out_opt, out_size);
+        free(t.ctx.scratch);
+        conv_arg_free(a);
+    }
+}
+
+/****************************** batch matmul ******************************/
+
+typedef struct {
+    int level;
+    uint16_t batches, rows, depth, cols;
+    uint8_t rhs_transposed;
+    uint8_t rhs_shared;             /* one rhs for every batch, as a weight */
+} matmul_shape_t;
+
+/* attention: q k^T with a transposed rhs, then scores x v, then a shared projection */
+static const matmul_shape_t matmul_shapes[] = {
+    {BENCH_MATRIX_QUICK, 2, 8, 16, 8, 1, 0},
+    {BENCH_MATRIX_QUICK, 1, 5, 20, 7, 0, 0},
+    {BENCH_MATRIX_DEFAULT, 4, 32, 32, 32, 1, 0},
+    {BENCH_MATRIX_DEFAULT, 4, 32, 32, 32, 0, 0},
+    {BENCH_MATRIX_DEFAULT, 4, 16, 64, 48, 0, 1},
+    {BENCH_MATRIX_LARGE, 8, 49, 64, 49, 1, 0},
+};
+
+typedef struct {
+    data_dims_t lhs_dims, rhs_dims, output_dims;
+    matmul_params_t params;
+    int8_t *lhs, *rhs, *out_ansi, *out_opt;
+    esp_nn_ctx_t ctx;
+} matmul_arg_t;
+
+static void matmul_ansi(void *arg)
+{
+    matmul_arg_t *a = arg;
+    esp_nn_batch_matmul_s8_ansi(&a->ctx, &a->lhs_dims, a->lhs, &a->rhs_dims, a->rhs,
+                                &a->output_dims, a->out_ansi, &a->params);
+}
+
+static void matmul_opt(void *arg)
+{
+    matmul_arg_t *a = arg;
+    esp_nn_batch_matmul_s8(&a->ctx, &a->lhs_dims, a->lhs, &a->rhs_dims, a->rhs,
+                           &a->output_dims, a->out_opt, &a->params);
+}
+
+static void bench_batch_matmul(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    if (!bench_kernel_enabled(cfg, "batch_matmul_s8")) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(matmul_shapes); i++) {
+        const matmul_shape_t *s = &matmul_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        const int32_t rhs_batches = s->rhs_shared ? 1 : s->batches;
+        matmul_arg_t a = {0};
+        a.lhs_dims = (data_dims_t) {s->depth, s->rows, 1, s->batches};
+        a.rhs_dims = s->rhs_transposed ? (data_dims_t) {s->depth, s->cols, 1, rhs_batches} :
+                                         (data_dims_t) {s->cols, s->depth, 1, rhs_batches};
+        a.output_dims = (data_dims_t) {s->cols, s->rows, 1, s->batches};
+        a.params = (matmul_params_t) {
+            .lhs_offset = BENCH_IN_OFFSET, .rhs_offset = -3, .out_offset = BENCH_OUT_OFFSET,
+            .rhs_transposed = s->rhs_transposed, .activation = {BENCH_ACT_MIN, BENCH_ACT_MAX},
+        };
+        bench_fill_quant(&a.params.out_mult, &a.params.out_shift, 1);
+
+        const int32_t lhs_size = s->batches * s->rows * s->depth;
+        const int32_t rhs_size = rhs_batches * s->depth * s->cols;
+        const int32_t out_size = s->batches * s->rows * s->cols;
+        a.lhs = bench_alloc(lhs_size);
+        a.rhs = bench_alloc(rhs_size);
+        a.out_ansi = bench_alloc(out_size);
+        a.out_opt = bench_alloc(out_size);
+        bench_fill_s8(a.lhs, lhs_size);
+        bench_fill_s8(a.rhs, rhs_size);
+        const int32_t scratch_size = esp_nn_get_batch_matmul_scratch_size(&a.lhs_dims, &a.rhs_dims,
+                                                                          &a.output_dims, &a.params);
+        a.ctx.scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+
+        const int64_t macs = (int64_t) out_size * s->depth;
+        const int64_t bytes = (int64_t) lhs_size + rhs_size + out_size;
+        snprintf(shape, sizeof(shape), "b=%d %dx%d x %dx%d%s%s", s->batches, s->rows, s->depth,
+                 s->depth, s->cols, s->rhs_transposed ? " rhs^T" : "",
+                 s->rhs_shared ? " shared" : "");
+        bench_run_pair(cfg, rep, "batch_matmul_s8", shape, macs, bytes,
+                       matmul_ansi, matmul_opt, &a, a.out_ansi, a.out_opt, out_size);
+        free(a.ctx.scratch);
+        free(a.lhs);
+        free(a.rhs);
+        free(a.out_ansi);
+        free(a.out_opt);
+    }
+}
+
+/****************************** LSTM ******************************/
+
+typedef struct {
+    int level;
+    uint16_t batches, steps, input_size, units;
+} lstm_shape_t;
+
+/* anomaly detection sized: a few features per step over a window, then a wider cell */
+static const lstm_shape_t lstm_shapes[] = {
+    {BENCH_MATRIX_QUICK, 1, 4, 8, 8},
+    {BENCH_MATRIX_QUICK, 2, 5, 7, 13},
+    {BENCH_MATRIX_DEFAULT, 1, 32, 16, 32},
+    {BENCH_MATRIX_DEFAULT, 1, 50, 3, 64},
+    {BENCH_MATRIX_DEFAULT, 4, 20, 32, 32},
+    {BENCH_MATRIX_LARGE, 1, 128, 64, 64},
+};
+
+typedef struct {
+    data_dims_t input_dims, output_dims;
+    lstm_params_t params;
+    int8_t *input, *weights, *out_ansi, *out_opt;
+    int8_t *h_init, *h_state;
+    int16_t *c_init, *c_state;
+    int32_t *bias;
+    int32_t units, batches;
+    esp_nn_ctx_t ctx;
+} lstm_arg_t;
+
+/* every run starts from the same state */
+static void lstm_reset(lstm_arg_t *a)
+{
+    memcpy(a->h_state, a->h_init, a->batches * a->units);
+    memcpy(a->c_state, a->c_init, a->batches * a->units * sizeof(int16_t));
+}
+
+static void lstm_ansi(void *arg)
+{
+    lstm_arg_t *a = arg;
+    lstm_reset(a);
+    esp_nn_lstm_s8_ansi(&a->ctx, &a->input_dims, a->input, &a->output_dims, a->out_ansi,
+                        a->h_state, a->c_state, &a->params);
+}
+
+static void lstm_opt(void *arg)
+{
+    lstm_arg_t *a = arg;
+    lstm_reset(a);
+    esp_nn_lstm_s8(&a->ctx, &a->input_dims, a->input, &a->output_dims, a->out_opt,
+                   a->h_state, a->c_state, &a->params);
+}
+
+static void bench_lstm(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    if (!bench_kernel_enabled(cfg, "lstm_s8")) {
+        return;
+    }
+    int16_t *sigmoid_lut = bench_alloc(esp_nn_get_logistic_s16_scratch_size());
+    int16_t *tanh_lut = bench_alloc(esp_nn_get_tanh_s16_scratch_size());
+    esp_nn_logistic_s16_prepare(sigmoid_lut);
+    esp_nn_tanh_s16_prepare(tanh_lut);
+
+    for (int i = 0; i < ARRAY_SIZE(lstm_shapes); i++) {
+        const lstm_shape_t *s = &lstm_shapes[i];
+        if (s->level > (int) cfg->matrix) {
+            continue;
+        }
+        const int32_t gate_size = s->units * (s->input_size + s->units);
+        lstm_arg_t a = {0};
+        a.units = s->units;
+        a.batches = s->batches;
+        a.input_dims = (data_dims_t) {s->input_size, s->steps, 1, s->batches};
+        a.output_dims = (data_dims_t) {s->units, s->steps, 1, s->batches};
+        a.weights = bench_alloc(ESP_NN_LSTM_GATES * gate_size);
+        a.bias = bench_alloc(ESP_NN_LSTM_GATES * s->units * sizeof(int32_t));
+        bench_fill_s8(a.weights, ESP_NN_LSTM_GATES * gate_size);
+        for (int32_t j = 0; j < ESP_NN_LSTM_GATES * s->units; j++) {
+            a.bias[j] = bench_rand_range(-4096, 4096);
+        }
+        for (int32_t g = 0; g < ESP_NN_LSTM_GATES; g++) {
+            lstm_gate_t *gate = &a.params.gates[g];
+            gate->input_weights = a.weights + g * gate_size;
+            gate->recurrent_weights = gate->input_weights + s->units * s->input_size;
+            gate->bias = a.bias + g * s->units;
+            /* a quarter to a half: the gates span the Q3.12 range without saturating */
+            bench_fill_quant(&gate->input_mult, &gate->input_shift, 1);
+            bench_fill_quant(&gate->recurrent_mult, &gate->recurrent_shift, 1);
+            gate->input_shift = -1;
+            gate->recurrent_shift = -1;
+        }
+        a.params.input_offset = BENCH_IN_OFFSET;
+        a.params.hidden_offset = -BENCH_OUT_OFFSET;
+        bench_fill_quant(&a.params.hidden_mult, &a.params.hidden_shift, 1);
+        a.params.hidden_shift = -22;
+        a.params.cell_shift = -11;
+        a.params.sigmoid_lut = sigmoid_lut;
+        a.params.tanh_lut = tanh_lut;
+        a.params.activation = (act_params_t) {BENCH_ACT_MIN, BENCH_ACT_MAX};
+
+        const int32_t in_size = s->batches * s->steps * s->input_size;
+        const int32_t out_size = s->batches * s->steps * s->units;
+        a.input = bench_alloc(in_size);
+        a.out_ansi = bench_alloc(out_size);
+        a.out_opt = bench_alloc(out_size);
+        a.h_init = bench_alloc(s->batches * s->units);
+        a.h_state = bench_alloc(s->batches * s->units);
+        a.c_init = bench_alloc(s->batches * s->units * sizeof(int16_t));
+        a.c_state = bench_alloc(s->batches * s->units * sizeof(int16_t));
+        bench_fill_s8(a.input, in_size);
+        bench_fill_s8(a.h_init, s->batches * s->units);
+        for (int32_t j = 0; j < s->batches * s->units; j++) {
+            a.c_init[j] = (int16_t) bench_rand_range(-4096, 4096);
+        }
+        const int32_t scratch_size = esp_nn_get_lstm_scratch_size(&a.input_dims, &a.output_dims,
+                                                                  &a.params);
+        a.ctx.scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+
+        const int64_t macs = (int64_t) s->batches * s->steps * ESP_NN_LSTM_GATES * gate_size;
+        const int64_t bytes = (int64_t) in_size + ESP_NN_LSTM_GATES * gate_size + out_size;
+        snprintf(shape, sizeof(shape), "b=%d steps=%d in=%d units=%d", s->batches, s->steps,
+                 s->input_size, s->units);
+        bench_run_pair(cfg, rep, "lstm_s8", shape, macs, bytes,
+                       lstm_ansi, lstm_opt, &a, a.out_ansi, a.out_opt, out_size);
+        free(a.ctx.scratch);
+        free(a.input);
+        free(a.weights);
+        free(a.bias);
+        free(a.out_ansi);
+        free(a.out_opt);
+        free(a.h_init);
+        free(a.h_state);
+        free(a.c_init);
+        free(a.c_state);
+    }
+    free(sigmoid_lut);
+    free(tanh_lut);
+}
+
+/****************************** softmax ******************************/
+
+typedef struct {
+    int level;
+    int32_t height, width;
+} softmax_shape_t;
+
+static const softmax_shape_t softmax_shapes[] = {
+    {BENCH_MATRIX_QUICK, 8, 32},
+    {BENCH_MATRIX_DEFAULT, 1, 2},
+    {BENCH_MATRIX_DEFAULT, 1, 10},
+    {BENCH_MATRIX_DEFAULT, 1, 1000},
+    {BENCH_MATRIX_LARGE, 64, 1000},
+};
+
+typedef struct {
+    int32_t height, width;
+    int8_t *input, *out_ansi, *out_opt;
+} softmax_arg_t;
+
+static void softmax_ansi(void *arg)
+{
+    softmax_arg_t *a = arg;
+    esp_nn_softmax_s8_ansi(a->input, a->height, a->width, INT32_MAX / 2, 7, -128, a->out_ansi);
+}
+
+static void softmax_opt(void *arg)
+{
+    softmax_arg_t *a = arg;
+    esp_nn_softmax_s8(a->input, a->height, a->width, INT32_MAX / 2, 7, -128, a->out_opt);
+}
+
+static void bench_softmax(const bench_config_t *cfg, bench_report_t *rep)
+{
+    char shape[BENCH_SHAPE_LEN];
+
+    if (!bench_kernel_enabled(cfg, "softmax_s8")) {
+        return;
+    }
+    for (int i = 0; i < ARRAY_SIZE(softmax_shapes); i++) {
+        if (softmax_shapes[i].level > (int) cfg->matrix) {
+            continue;
+        }
+        softmax_arg_t a = {.height = softmax_shapes[i].height, .width = softmax_shapes[i].width};
+        const int32_t size = a.height * a.width;
+        a.input = bench_alloc(size);
+        a.out_ansi = bench_alloc(size);
+        a.out_opt = bench_alloc(size);
+        bench_fill_s8(a.input, size);
+
+        int32_t scratch_size = esp_nn_get_softmax_scratch_size(a.width, a.height);
+        void *scratch = scratch_size > 0 ? bench_alloc(scratch_size) : NULL;
+        esp_nn_set_softmax_scratch_buf(scratch);
+
+        snprintf(shape, sizeof(shape), "h=%d w=%d", (int) a.height, (int) a.width);
+        bench_run_pair(cfg, rep, "softmax_s8", shape, size, 2 * size,
+                       softmax_ansi, softmax_opt, &a, a.out_ansi, a.out_opt, size);
+
+        esp_nn_set_softmax_scratch_buf(NULL);
+        free(scratch);
+        free(a.input);
+        free(a.out_ansi);
+        free(a.out_opt);
+    }
+}
+
+/****************************** registry ******************************/
+
+static const char *kernel_names[] = {
+    "add_elementwise_s8", "mul_elementwise_s8", "mul_broadcast_channel_s8",
+    "depthwise_conv_s8", "conv_s8", "depthwise_conv_s8_workers", "conv_s8_workers", "conv_s8_stream", "dw_pw_conv_s8", "relu6_s8", "hard_swish_s8", "mean_nhwc_s8",
+    "max_pool_s8", "avg_pool_s8", "fully_connected_s8", "fully_connected_per_ch_s8",
+    "fully_connected_s8_prepared", "fully_connected_s8_sparse", "conv_s16", "depthwise_conv_s16", "fully_connected_s16",
+    "conv_s4", "fully_connected_per_ch_s4", "transpose_conv_s8", "batch_matmul_s8", "lstm_s8",
+    "softmax_s8", "logistic_s8",
+};
+
+void bench_kernels_list(FILE *fp)
+{
+    for (int i = 0; i < ARRAY_SIZE(kernel_names); i++) {
+        fprintf(fp, "%s\n", kernel_names[i]);
+    }
+}
+
+void bench_kernels_run(const bench_config_t *cfg, bench_report_t *rep)
+{
+    bench_elementwise(cfg, rep);
+    bench_mul_broadcast(cfg, rep);
+    bench_conv(cfg, rep);
+    bench_depthwise_conv(cfg, rep);
+    bench_dw_pw_conv(cfg, rep);
+    bench_pooling(cfg, rep);
+    bench_fully_connected(cfg, rep);
+    bench_s16(cfg, rep);
+    bench_s4(cfg, rep);
+    bench_transpose_conv(cfg, rep);
+    bench_batch_matmul(cfg, rep);
+    bench_lstm(cfg, rep);
+    bench_softmax(cfg, rep);
+}
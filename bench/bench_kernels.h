@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "bench_common.h"
+
+/**
+ * @brief   Run every kernel of esp_nn_ansi_headers.h over the configured shape matrix
+ */
+void bench_kernels_run(const bench_config_t *cfg, bench_report_t *rep);
+
+/**
+ * @brief   Print names of the benchmarked kernels, one per line
+ */
+void bench_kernels_list(FILE *fp);
@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "model_layers.h"
+#include "bench_models.h"
+
+static const model_desc_t *models[] = {
+    &model_mobilenet_v3_small,
+    &model_person_detection,
+};
+
+#define NUM_MODELS  ((int) (sizeof(models) / sizeof(models[0])))
+
+static void layer_ansi(void *arg)
+{
+    model_layer_run_ansi(arg);
+}
+
+static void layer_opt(void *arg)
+{
+    model_layer_run_opt(arg);
+}
+
+/* activations in and out plus filter bytes; bias and quant arrays are ignored */
+static int64_t layer_bytes(const model_layer_t *layer, const model_layer_inst_t *inst)
+{
+    int64_t bytes = (int64_t) layer->in_wd * layer->in_ht * layer->in_ch + inst->out_size;
+    if (inst->filter) {
+        bytes += model_layer_macs(layer) / (layer->out_wd * layer->out_ht);
+    }
+    return bytes;
+}
+
+static esp_nn_op_t plan_op_kind(const model_op_t op)
+{
+    switch (op) {
+    case MODEL_OP_CONV:             return ESP_NN_OP_CONV;
+    case MODEL_OP_DEPTHWISE:        return ESP_NN_OP_DEPTHWISE_CONV;
+    case MODEL_OP_FC:               return ESP_NN_OP_FULLY_CONNECTED;
+    case MODEL_OP_HARD_SWISH:       return ESP_NN_OP_HARD_SWISH;
+    case MODEL_OP_MEAN:             return ESP_NN_OP_MEAN;
+    case MODEL_OP_MUL_BROADCAST:    return ESP_NN_OP_MUL_BROADCAST;
+    case MODEL_OP_ADD:              return ESP_NN_OP_ADD;
+    case MODEL_OP_AVG_POOL:         return ESP_NN_OP_AVG_POOL;
+    default:                        return ESP_NN_OP_SOFTMAX;
+    }
+}
+
+/* latest tensor before `before` with dims wd x ht x ch, -1 if none */
+static int16_t find_tensor(const data_dims_t *tensors, int before,
+                           int32_t wd, int32_t ht, int32_t ch)
+{
+    for (int t = before - 1; t >= 0; t--) {
+        if (tensors[t].width == wd && tensors[t].height == ht && tensors[t].channels == ch) {
+            return t;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Plan the model's activations in one arena. The layer tables have no edges:
+ * tensor 0 is the model input, layer i writes tensor i + 1 and reads the latest
+ * tensor of its input dims. The second input of an add is the tensor of those
+ * dims before that (the block input), that of a mul the latest 1 x 1 x channels.
+ */
+static void plan_model(const model_desc_t *model)
+{
+    const int n = model->num_layers;
+    esp_nn_plan_op_t *ops = calloc(n, sizeof(esp_nn_plan_op_t));
+    conv_params_t *conv = calloc(n, sizeof(conv_params_t));
+    dw_conv_params_t *dw = calloc(n, sizeof(dw_conv_params_t));
+    data_dims_t *tensors = calloc(n + 1, sizeof(data_dims_t));
+    int32_t *offsets = calloc(n + 1, sizeof(int32_t));
+    if (!ops || !conv || !dw || !tensors || !offsets) {
+        exit(2);
+    }
+
+    const model_layer_t *first = &model->layers[0];
+    tensors[0] = (data_dims_t) {first->in_wd, first->in_ht, first->in_ch, 1};
+    for (int i = 0; i < n; i++) {
+        const model_layer_t *layer = &model->layers[i];
+        model_layer_inst_t inst;
+        if (model_layer_init(&inst, layer) != 0) {
+            exit(2);
+        }
+        esp_nn_plan_op_t *op = &ops[i];
+        op->op = plan_op_kind(layer->op);
+        op->input_dims = inst.input_dims;
+        op->filter_dims = inst.filter_dims;
+        op->output_dims = inst.output_dims;
+        if (layer->op == MODEL_OP_SOFTMAX) {
+            /* rows of in_ch logits */
+            op->input_dims = (data_dims_t) {layer->in_ch, layer->in_wd * layer->in_ht, 1, 1};
+            op->output_dims = op->input_dims;
+        }
+        conv[i] = inst.conv_params;
+        dw[i] = inst.dw_params;
+        op->params = layer->op == MODEL_OP_DEPTHWISE ? (const void *) &dw[i] : (const void *) &conv[i];
+        model_layer_deinit(&inst);
+
+        op->inputs[0] = find_tensor(tensors, i + 1, layer->in_wd, layer->in_ht, layer->in_ch);
+        op->inputs[1] = -1;
+        if (op->inputs[0] < 0) {
+            op->inputs[0] = i;
+        }
+        if (layer->op == MODEL_OP_ADD) {
+            op->inputs[1] = find_tensor(tensors, op->inputs[0], layer->in_wd, layer->in_ht,
+                                        layer->in_ch);
+        } else if (layer->op == MODEL_OP_MUL_BROADCAST) {
+            op->inputs[1] = find_tensor(tensors, i + 1, 1, 1, layer->in_ch);
+        }
+        op->output = i + 1;
+        tensors[i + 1] = (data_dims_t) {layer->out_wd, layer->out_ht, layer->out_ch, 1};
+    }
+
+    esp_nn_plan_t plan;
+    if (esp_nn_plan_arena(ops, n, n + 1, &plan, offsets) == 0) {
+        fprintf(stderr, "%s arena: %d bytes planned (%d scratch), %d bytes as separate tensors\n",
+                model->name, (int) plan.arena_size, (int) plan.scratch_size,
+                (int) (plan.tensors_size + plan.scratch_size));
+    }
+    free(ops);
+    free(conv);
+    free(dw);
+    free(tensors);
+    free(offsets);
+}
+
+static void replay_model(const bench_config_t *cfg, bench_report_t *rep, const model_desc_t *model)
+{
+    char shape[BENCH_SHAPE_LEN];
+    double total_ansi = 0, total_opt = 0;
+
+    fprintf(stderr, "######## %s (%d layers) ########\n", model->name, model->num_layers);
+    for (int i = 0; i < model->num_layers; i++) {
+        const model_layer_t *layer = &model->layers[i];
+        const char *kernel = model_op_name(layer->op);
+        if (!bench_kernel_enabled(cfg, kernel)) {
+            continue;
+        }
+
+        model_layer_inst_t inst;
+        if (model_layer_init(&inst, layer) != 0) {
+            exit(2);
+        }
+        model_layer_shape_str(layer, shape, sizeof(shape));
+        bench_run_pair(cfg, rep, kernel, shape, model_layer_macs(layer), layer_bytes(layer, &inst),
+                       layer_ansi, layer_opt, &inst, inst.out_ansi, inst.out_opt, inst.out_size);
+        model_layer_deinit(&inst);
+
+        bench_result_t *res = &rep->results[rep->count - 2];
+        total_ansi += res[0].ns_per_op;
+        total_opt += res[1].ns_per_op;
+        res[0].cumulative_ns = total_ansi;
+        res[1].cumulative_ns = total_opt;
+        for (int r = 0; r < 2; r++) {
+            snprintf(res[r].model, sizeof(res[r].model), "%s", model->name);
+            snprintf(res[r].layer, sizeof(res[r].layer), "%s", layer->name);
+            snprintf(res[r].paths, sizeof(res[r].paths), "generic=%s;esp32s3=%s;esp32p4=%s",
+                     model_layer_path(layer, MODEL_TARGET_GENERIC),
+                     model_layer_path(layer, MODEL_TARGET_ESP32S3),
+                     model_layer_path(layer, MODEL_TARGET_ESP32P4));
+        }
+    }
+    fprintf(stderr, "%s total: ansi %.3f ms, opt %.3f ms\n", model->name,
+            total_ansi / 1e6, total_opt / 1e6);
+    plan_model(model);
+}
+
+int bench_models_run(const bench_config_t *cfg, bench_report_t *rep, const char *name)
+{
+    int found = 0;
+    for (int i = 0; i < NUM_MODELS; i++) {
+        if (strcmp(name, "all") == 0 || strcmp(name, models[i]->name) == 0) {
+            replay_model(cfg, rep, models[i]);
+            found = 1;
+        }
+    }
+    return found ? 0 : -1;
+}
+
+void bench_models_list(FILE *fp)
+{
+    for (int i = 0; i < NUM_MODELS; i++) {
+        fprintf(fp, "%s\n", models[i]->name);
+    }
+}
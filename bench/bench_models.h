@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "bench_common.h"
+
+/**
+ * @brief   Replay the layers of a reference model, or all of them for "all"
+ *
+ * @return  0 on success, -1 if `name` is not a known model
+ */
+int bench_models_run(const bench_config_t *cfg, bench_report_t *rep, const char *name);
+
+/**
+ * @brief   Print names of the replayable models, one per line
+ */
+void bench_models_list(FILE *fp);
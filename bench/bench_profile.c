@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include <esp_nn_profile.h>
+
+#include "bench_profile.h"
+
+/* a batched kernel case makes thousands of calls: stop recording past this */
+#define PROFILE_MAX_EVENTS      (1 << 20)
+#define PROFILE_MAX_THREADS     8
+
+typedef struct {
+    esp_nn_profile_event_t event;
+    uint8_t end;
+    uint8_t tid;
+} profile_record_t;
+
+static struct {
+    pthread_mutex_t lock;
+    profile_record_t *records;
+    int count;
+    int capacity;
+    int dropped;
+    pthread_t threads[PROFILE_MAX_THREADS];
+    int thread_count;
+} prof = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static int thread_index(void)
+{
+    pthread_t self = pthread_self();
+    for (int i = 0; i < prof.thread_count; i++) {
+        if (pthread_equal(prof.threads[i], self)) {
+            return i;
+        }
+    }
+    if (prof.thread_count == PROFILE_MAX_THREADS) {
+        return PROFILE_MAX_THREADS - 1;
+    }
+    prof.threads[prof.thread_count] = self;
+    return prof.thread_count++;
+}
+
+static void record(const esp_nn_profile_event_t *event, uint8_t end)
+{
+    pthread_mutex_lock(&prof.lock);
+    if (prof.count == prof.capacity) {
+        int capacity = prof.capacity ? prof.capacity * 2 : 4096;
+        profile_record_t *records = NULL;
+        if (capacity <= PROFILE_MAX_EVENTS) {
+            records = realloc(prof.records, capacity * sizeof(profile_record_t));
+        }
+        if (records == NULL) {
+            prof.dropped++;
+            pthread_mutex_unlock(&prof.lock);
+            return;
+        }
+        prof.records = records;
+        prof.capacity = capacity;
+    }
+    profile_record_t *rec = &prof.records[prof.count++];
+    rec->event = *event;
+    rec->end = end;
+    rec->tid = thread_index();
+    pthread_mutex_unlock(&prof.lock);
+}
+
+static void on_begin(const esp_nn_profile_event_t *event, void *user_data)
+{
+    record(event, 0);
+}
+
+static void on_end(const esp_nn_profile_event_t *event, void *user_data)
+{
+    record(event, 1);
+}
+
+int bench_profile_start(void)
+{
+    return esp_nn_profile_register(on_begin, on_end, NULL);
+}
+
+static void write_dims(FILE *fp, const char *name, const data_dims_t *dims)
+{
+    fprintf(fp, "\"%s\":[%" PRId32 ",%" PRId32 ",%" PRId32 "]", name,
+            dims->width, dims->height, dims->channels);
+}
+
+void bench_profile_write(FILE *fp)
+{
+    esp_nn_profile_register(NULL, NULL, NULL);
+
+    /* timestamps are 32 bit ns: unwrap them, records are close to time order */
+    uint64_t now = prof.count ? prof.records[0].event.timestamp : 0;
+    const uint64_t start = now;
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (int i = 0; i < prof.count; i++) {
+        const profile_record_t *rec = &prof.records[i];
+        const esp_nn_profile_event_t *ev = &rec->event;
+
+        now += (int32_t) (ev->timestamp - (uint32_t) now);
+        fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%d",
+                i ? "," : "", esp_nn_op_name(ev->op), rec->end ? "E" : "B",
+                (now - start) / 1000.0, rec->tid);
+        if (!rec->end) {
+            fprintf(fp, ",\"args\":{");
+            write_dims(fp, "input", &ev->input_dims);
+            fprintf(fp, ",");
+            write_dims(fp, "filter", &ev->filter_dims);
+            fprintf(fp, ",");
+            write_dims(fp, "output", &ev->output_dims);
+            fprintf(fp, ",\"macs\":%" PRId64 "}", ev->macs);
+        }
+        fprintf(fp, "}");
+    }
+    fprintf(fp, "\n]}\n");
+
+    if (prof.dropped) {
+        fprintf(stderr, "bench: profile dropped %d events past %d\n",
+                prof.dropped, PROFILE_MAX_EVENTS);
+    }
+    free(prof.records);
+    prof.records = NULL;
+    prof.count = prof.capacity = prof.dropped = 0;
+}
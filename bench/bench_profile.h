@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+/**
+ * @brief   Register profiling hooks recording every kernel call
+ *
+ * @return  0 on success, -1 if the library is built without profiling
+ */
+int bench_profile_start(void);
+
+/**
+ * @brief   Unregister the hooks and write the recorded calls as a Chrome
+ *          trace (chrome://tracing, Perfetto) to `fp`
+ */
+void bench_profile_write(FILE *fp);
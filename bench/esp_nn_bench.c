@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <esp_nn_telemetry.h>
+#include <esp_nn_profile.h>
+#include <esp_nn_autotune.h>
+
+#include "bench_common.h"
+#include "bench_kernels.h"
+#include "bench_models.h"
+#include "bench_profile.h"
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --matrix quick|default|large  shape matrix to run (default: default)\n"
+            "  --kernel NAME[,NAME..]        only run these kernels, `prefix*` allowed\n"
+            "  --warmup N                    untimed runs per case (default: 3)\n"
+            "  --repeats N                   timed samples per case, median reported (default: 11)\n"
+            "  --min-sample-us N             batch calls until a sample takes N us (default: 200)\n"
+            "  --seed N                      input data seed\n"
+            "  --format json|csv             output format (default: json)\n"
+            "  --out FILE                    write results to FILE instead of stdout\n"
+            "  --model NAME|all              replay the layers of a reference model instead\n"
+            "                                of the kernel shape matrix\n"
+            "  --telemetry                   print the dispatch paths taken to stderr\n"
+            "                                (needs a build with -DESP_NN_TELEMETRY=ON)\n"
+            "  --autotune                    tune conv paths per shape, print the table to stdout\n"
+            "                                (needs a build with -DESP_NN_AUTOTUNE=ON)\n"
+            "  --profile FILE                write every kernel call as a Chrome trace to FILE\n"
+            "                                (needs a build with -DESP_NN_PROFILING=ON)\n"
+            "  --list                        list kernels and models and exit\n"
+            "Exit status is 1 if any optimised output differs from ANSI C.\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t cfg = {
+        .warmup = 3,
+        .repeats = 11,
+        .min_sample_ns = 200 * 1000,
+        .matrix = BENCH_MATRIX_DEFAULT,
+        .filter = NULL,
+        .seed = 1,
+    };
+    bench_format_t format = BENCH_FORMAT_JSON;
+    const char *out_path = NULL;
+    const char *model = NULL;
+    bool telemetry = false;
+    bool autotune = false;
+    const char *profile_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(opt, "--list") == 0) {
+            bench_kernels_list(stdout);
+            bench_models_list(stdout);
+            return 0;
+        }
+        if (strcmp(opt, "--help") == 0 || strcmp(opt, "-h") == 0) {
+            usage(argv[0]);
+            return 0;
+        }
+        if (strcmp(opt, "--telemetry") == 0) {
+            if (!ESP_NN_TELEMETRY_ENABLED) {
+                fprintf(stderr, "bench: built without ESP_NN_TELEMETRY\n");
+                return 2;
+            }
+            telemetry = true;
+            continue;
+        }
+        if (strcmp(opt, "--autotune") == 0) {
+            if (esp_nn_autotune_enable(true) != 0) {
+                fprintf(stderr, "bench: built without ESP_NN_AUTOTUNE\n");
+                return 2;
+            }
+            autotune = true;
+            continue;
+        }
+        if (val == NULL) {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+        if (strcmp(opt, "--matrix") == 0) {
+            if (!bench_matrix_parse(val, &cfg.matrix)) {
+                usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(opt, "--kernel") == 0) {
+            cfg.filter = val;
+        } else if (strcmp(opt, "--warmup") == 0) {
+            cfg.warmup = atoi(val);
+        } else if (strcmp(opt, "--repeats") == 0) {
+            cfg.repeats = atoi(val);
+        } else if (strcmp(opt, "--min-sample-us") == 0) {
+            cfg.min_sample_ns = (int64_t) atoi(val) * 1000;
+        } else if (strcmp(opt, "--seed") == 0) {
+            cfg.seed = (uint32_t) strtoul(val, NULL, 0);
+        } else if (strcmp(opt, "--format") == 0) {
+            if (strcmp(val, "json") == 0) {
+                format = BENCH_FORMAT_JSON;
+            } else if (strcmp(val, "csv") == 0) {
+                format = BENCH_FORMAT_CSV;
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(opt, "--out") == 0) {
+            out_path = val;
+        } else if (strcmp(opt, "--model") == 0) {
+            model = val;
+        } else if (strcmp(opt, "--profile") == 0) {
+            if (!ESP_NN_PROFILING_ENABLED) {
+                fprintf(stderr, "bench: built without ESP_NN_PROFILING\n");
+                return 2;
+            }
+            profile_path = val;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    bench_seed(cfg.seed);
+    esp_nn_telemetry_reset();
+    if (profile_path) {
+        bench_profile_start();
+    }
+    bench_report_t rep = {0};
+    if (model == NULL) {
+        bench_kernels_run(&cfg, &rep);
+    } else if (bench_models_run(&cfg, &rep, model) != 0) {
+        fprintf(stderr, "bench: unknown model %s\n", model);
+        return 2;
+    }
+
+    if (profile_path) {
+        FILE *pf = fopen(profile_path, "w");
+        if (pf == NULL) {
+            fprintf(stderr, "bench: cannot open %s\n", profile_path);
+            bench_report_free(&rep);
+            return 2;
+        }
+        bench_profile_write(pf);
+        fclose(pf);
+    }
+
+    if (telemetry) {
+        /* counts include warmup and batched calls of all cases */
+        for (int path = 0; path < ESP_NN_PATH_MAX; path++) {
+            esp_nn_path_stats_t stats;
+            if (esp_nn_telemetry_get((esp_nn_path_t) path, &stats) == 0 && stats.calls) {
+                fprintf(stderr, "telemetry: %-28s calls %10u avg_ns %10.0f\n",
+                        esp_nn_path_name((esp_nn_path_t) path), (unsigned) stats.calls,
+                        (double) stats.cycles / stats.calls);
+            }
+        }
+    }
+
+    if (autotune) {
+        esp_nn_autotune_print();
+    }
+
+    FILE *fp = out_path ? fopen(out_path, "w") : stdout;
+    if (fp == NULL) {
+        fprintf(stderr, "bench: cannot open %s\n", out_path);
+        bench_report_free(&rep);
+        return 2;
+    }
+    bench_report_write(&rep, &cfg, format, model ? "esp_nn_models" : "esp_nn_kernels", fp);
+    if (out_path) {
+        fclose(fp);
+    }
+
+    int ret = rep.mismatches ? 1 : 0;
+    if (rep.count == 0) {
+        fprintf(stderr, "bench: no kernel matched\n");
+        ret = 2;
+    }
+    bench_report_free(&rep);
+    return ret;
+}
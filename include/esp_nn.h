@@ -46,6 +46,28 @@ extern "C" {
 #include "esp_nn_ansi_c.h"
 #endif
 
+/* per layer requantisation plans, set in quant_data_t */
+#include "esp_nn_requant.h"
+/* packing of int4 weights for the _s4 kernels */
+#include "esp_nn_s4.h"
+/* staging of input tiles for the tiled kernels, e.g. by DMA */
+#include "esp_nn_mover.h"
+/* split of conv layers across cores, on top of the kernels selected above */
+#include "esp_nn_workers.h"
+/* row streaming conv, for input arriving a row at a time */
+#include "esp_nn_stream.h"
+/* depthwise + pointwise blocks run a few rows at a time */
+#include "esp_nn_fused.h"
+/* one arena for the activations and scratch of a sequence of ops */
+#include "esp_nn_planner.h"
+#include "esp_nn_telemetry.h"
+#include "esp_nn_autotune.h"
+/* with NN_PROFILING, routes the kernels above through the profiling hooks */
+#include "esp_nn_profile.h"
+#include "esp_nn_profile_ops.h"
+/* batched pooling, on top of the (profiled) kernels above */
+#include "esp_nn_batch.h"
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,17 +19,25 @@
 #define esp_nn_mul_broadcast_channel_s8 esp_nn_mul_broadcast_channel_s8_ansi
 
 #define esp_nn_depthwise_conv_s8 esp_nn_depthwise_conv_s8_ansi
+#define esp_nn_depthwise_conv_s8_ctx esp_nn_depthwise_conv_s8_ctx_ansi
+#define esp_nn_depthwise_conv_s8_plan esp_nn_depthwise_conv_s8_plan_ansi
 
 #define esp_nn_conv_s8 esp_nn_conv_s8_ansi
+#define esp_nn_conv_s8_ctx esp_nn_conv_s8_ctx_ansi
+#define esp_nn_conv_s8_plan esp_nn_conv_s8_plan_ansi
 
 #define esp_nn_get_conv_scratch_size esp_nn_get_conv_scratch_size_ansi
 #define esp_nn_set_conv_scratch_buf esp_nn_set_conv_scratch_buf_ansi
+#define esp_nn_get_conv_prepared_size esp_nn_get_conv_prepared_size_ansi
+#define esp_nn_conv_s8_prepare esp_nn_conv_s8_prepare_ansi
+#define esp_nn_conv_s8_run esp_nn_conv_s8_run_ansi
 
 #define esp_nn_get_depthwise_conv_scratch_size esp_nn_get_depthwise_conv_scratch_size_ansi
 #define esp_nn_set_depthwise_conv_scratch_buf esp_nn_set_depthwise_conv_scratch_buf_ansi
 
 #define esp_nn_relu6_s8 esp_nn_relu6_s8_ansi
 #define esp_nn_hard_swish_s8 esp_nn_hard_swish_s8_ansi
+#define esp_nn_hard_swish_s8_ctx esp_nn_hard_swish_s8_ctx_ansi
 #define esp_nn_get_hard_swish_scratch_size() 0
 #define esp_nn_set_hard_swish_scratch_buf(buf)
 #define esp_nn_mean_nhwc_s8 esp_nn_mean_nhwc_s8_ansi
@@ -39,11 +47,47 @@
 
 #define esp_nn_fully_connected_s8 esp_nn_fully_connected_s8_ansi
 #define esp_nn_fully_connected_per_ch_s8 esp_nn_fully_connected_per_ch_s8_ansi
+#define esp_nn_get_fully_connected_prepared_size esp_nn_get_fully_connected_prepared_size_ansi
+#define esp_nn_fully_connected_s8_prepare esp_nn_fully_connected_s8_prepare_ansi
+#define esp_nn_fully_connected_per_ch_s8_prepare esp_nn_fully_connected_per_ch_s8_prepare_ansi
+#define esp_nn_fully_connected_s8_run esp_nn_fully_connected_s8_run_ansi
+#define esp_nn_fully_connected_s8_run_batch esp_nn_fully_connected_s8_run_batch_ansi
+#define esp_nn_get_fully_connected_sparse_size esp_nn_get_fully_connected_sparse_size_ansi
+#define esp_nn_fully_connected_s8_sparse_pack esp_nn_fully_connected_s8_sparse_pack_ansi
+#define esp_nn_fully_connected_per_ch_s8_sparse_pack esp_nn_fully_connected_per_ch_s8_sparse_pack_ansi
+#define esp_nn_fully_connected_s8_sparse_run esp_nn_fully_connected_s8_sparse_run_ansi
+
+#define esp_nn_conv_s16 esp_nn_conv_s16_ansi
+#define esp_nn_depthwise_conv_s16 esp_nn_depthwise_conv_s16_ansi
+#define esp_nn_fully_connected_s16 esp_nn_fully_connected_s16_ansi
+
+#define esp_nn_conv_s4 esp_nn_conv_s4_ansi
+#define esp_nn_fully_connected_per_ch_s4 esp_nn_fully_connected_per_ch_s4_ansi
+
+#define esp_nn_get_transpose_conv_scratch_size esp_nn_get_transpose_conv_scratch_size_ansi
+#define esp_nn_transpose_conv_s8 esp_nn_transpose_conv_s8_ansi
+#define esp_nn_get_transpose_conv_prepared_size esp_nn_get_transpose_conv_prepared_size_ansi
+#define esp_nn_transpose_conv_s8_prepare esp_nn_transpose_conv_s8_prepare_ansi
+#define esp_nn_transpose_conv_s8_run esp_nn_transpose_conv_s8_run_ansi
+
+#define esp_nn_get_batch_matmul_scratch_size esp_nn_get_batch_matmul_scratch_size_ansi
+#define esp_nn_batch_matmul_s8 esp_nn_batch_matmul_s8_ansi
+
+#define esp_nn_get_lstm_scratch_size esp_nn_get_lstm_scratch_size_ansi
+#define esp_nn_lstm_s8 esp_nn_lstm_s8_ansi
 
 #define esp_nn_get_softmax_scratch_size esp_nn_get_softmax_scratch_size_ansi
 #define esp_nn_set_softmax_scratch_buf esp_nn_set_softmax_scratch_buf_ansi
 #define esp_nn_softmax_s8 esp_nn_softmax_s8_ansi
+#define esp_nn_softmax_s8_ctx esp_nn_softmax_s8_ctx_ansi
 
 #define esp_nn_get_logistic_s8_scratch_size esp_nn_get_logistic_s8_scratch_size_ansi
 #define esp_nn_logistic_s8_prepare esp_nn_logistic_s8_prepare_ansi
 #define esp_nn_logistic_s8 esp_nn_logistic_s8_ansi
+
+#define esp_nn_get_logistic_s16_scratch_size esp_nn_get_logistic_s16_scratch_size_ansi
+#define esp_nn_logistic_s16_prepare esp_nn_logistic_s16_prepare_ansi
+#define esp_nn_logistic_s16 esp_nn_logistic_s16_ansi
+#define esp_nn_get_tanh_s16_scratch_size esp_nn_get_tanh_s16_scratch_size_ansi
+#define esp_nn_tanh_s16_prepare esp_nn_tanh_s16_prepare_ansi
+#define esp_nn_tanh_s16 esp_nn_tanh_s16_ansi
@@ -259,6 +259,122 @@ void esp_nn_fully_connected_per_ch_s8_ansi(const int8_t *input_data,
                                     const int32_t activation_min,
                                     const int32_t activation_max);
 
+
+/**
+ * @brief       size of the blob esp_nn_fully_connected_s8_prepare needs for a layer
+ */
+int32_t esp_nn_get_fully_connected_prepared_size_ansi(const uint16_t row_len,
+                                                      const uint16_t out_channels,
+                                                      const esp_nn_fc_layout_t layout);
+
+/**
+ * @brief       fold `filter_sum * input_offset + bias` and pack the weights once
+ *
+ * @note        `blob` must be 16 byte aligned. Arguments are as for
+ *              esp_nn_fully_connected_s8 / esp_nn_fully_connected_per_ch_s8,
+ *              `layout` selects how the weights are stored for the run.
+ *              A non zero filter_offset can't be folded: run then does the
+ *              unprepared call.
+ *
+ * @return      the blob as prepared layer, NULL if `blob` is misaligned
+ */
+esp_nn_fc_prepared_t *esp_nn_fully_connected_s8_prepare_ansi(void *blob,
+                                                             const esp_nn_fc_layout_t layout,
+                                                             const int32_t input_offset,
+                                                             const uint16_t row_len,
+                                                             const int8_t *filter_data,
+                                                             const int32_t filter_offset,
+                                                             const int32_t *bias,
+                                                             const uint16_t out_channels,
+                                                             const int32_t out_offset,
+                                                             const int32_t out_shift,
+                                                             const int32_t out_mult,
+                                                             const int32_t activation_min,
+                                                             const int32_t activation_max);
+
+esp_nn_fc_prepared_t *esp_nn_fully_connected_per_ch_s8_prepare_ansi(void *blob,
+                                                                    const esp_nn_fc_layout_t layout,
+                                                                    const int32_t input_offset,
+                                                                    const uint16_t row_len,
+                                                                    const int8_t *filter_data,
+                                                                    const int32_t filter_offset,
+                                                                    const int32_t *bias,
+                                                                    const uint16_t out_channels,
+                                                                    const int32_t out_offset,
+                                                                    const int32_t *out_shift,
+                                                                    const int32_t *out_mult,
+                                                                    const int32_t activation_min,
+                                                                    const int32_t activation_max);
+
+/**
+ * @brief       run a prepared fully connected layer, single pass over the packed weights
+ */
+void esp_nn_fully_connected_s8_run_ansi(const esp_nn_fc_prepared_t *prep,
+                                        const int8_t *input_data,
+                                        int8_t *out_data);
+
+/**
+ * @brief       run a prepared fully connected layer on `batches` inputs
+ *
+ * @note        inputs are `row_len` apart, outputs `out_channels` apart.
+ *              Each packed row is read once for the whole batch.
+ */
+void esp_nn_fully_connected_s8_run_batch_ansi(const esp_nn_fc_prepared_t *prep,
+                                              const int32_t batches,
+                                              const int8_t *input_data,
+                                              int8_t *out_data);
+
+/**
+ * @brief       size of the blob esp_nn_fully_connected_s8_sparse_pack needs for a layer
+ *
+ * @note        depends on the weights: counts the 1x16 blocks with a non zero weight
+ */
+int32_t esp_nn_get_fully_connected_sparse_size_ansi(const int8_t *filter_data,
+                                                    const uint16_t row_len,
+                                                    const uint16_t out_channels);
+
+/**
+ * @brief       pack the non zero 1x16 blocks of the weights and fold
+ *              `filter_sum * input_offset + bias` per channel
+ *
+ * @note        `blob` must be 16 byte aligned. Arguments are as for
+ *              esp_nn_fully_connected_s8 / esp_nn_fully_connected_per_ch_s8,
+ *              with a zero filter offset. The blob copies everything it
+ *              needs and holds no pointers: it can be packed offline.
+ *
+ * @return      the blob as sparse layer, NULL if `blob` is misaligned
+ */
+esp_nn_fc_sparse_t *esp_nn_fully_connected_s8_sparse_pack_ansi(void *blob,
+                                                               const int32_t input_offset,
+                                                               const uint16_t row_len,
+                                                               const int8_t *filter_data,
+                                                               const int32_t *bias,
+                                                               const uint16_t out_channels,
+                                                               const int32_t out_offset,
+                                                               const int32_t out_shift,
+                                                               const int32_t out_mult,
+                                                               const int32_t activation_min,
+                                                               const int32_t activation_max);
+
+esp_nn_fc_sparse_t *esp_nn_fully_connected_per_ch_s8_sparse_pack_ansi(void *blob,
+                                                                      const int32_t input_offset,
+                                                                      const uint16_t row_len,
+                                                                      const int8_t *filter_data,
+                                                                      const int32_t *bias,
+                                                                      const uint16_t out_channels,
+                                                                      const int32_t out_offset,
+                                                                      const int32_t *out_shift,
+                                                                      const int32_t *out_mult,
+                                                                      const int32_t activation_min,
+                                                                      const int32_t activation_max);
+
+/**
+ * @brief       run a block sparse fully connected layer, skipped blocks are never read
+ */
+void esp_nn_fully_connected_s8_sparse_run_ansi(const esp_nn_fc_sparse_t *sparse,
+                                               const int8_t *input_data,
+                                               int8_t *out_data);
+
 /**
  * @brief   Get scratch buffer size needed by softmax function
  *
@@ -294,6 +410,313 @@ void esp_nn_softmax_s8_ansi(const int8_t *input_data,
                             const int32_t diff_min,
                             int8_t *output_data);
 
+/************************** Context variants ********************************/
+
+/**
+ * @brief       reentrant variants of the functions taking a scratch buffer
+ *
+ * @note        same as the respective function but scratch is taken from `ctx`.
+ *              The reference versions do not need scratch and ignore it.
+ */
+void esp_nn_conv_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                             const data_dims_t *input_dims,
+                             const int8_t *input_data,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_data_t *quant_data);
+
+void esp_nn_depthwise_conv_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                                       const data_dims_t *input_dims,
+                                       const int8_t *input_data,
+                                       const data_dims_t *filter_dims,
+                                       const int8_t *filter_data,
+                                       const int32_t *bias,
+                                       const data_dims_t *output_dims,
+                                       int8_t *out_data,
+                                       const dw_conv_params_t *conv_params,
+                                       const quant_data_t *quant_data);
+
+/**
+ * @brief       conv and depthwise conv with a requantisation plan
+ *
+ * @note        same as the `_ctx` variants, `quant_data->plan` (may be NULL) holds
+ *              the plan of the layer from esp_nn_requant_plan_init
+ */
+void esp_nn_conv_s8_plan_ansi(const esp_nn_ctx_t *ctx,
+                              const data_dims_t *input_dims,
+                              const int8_t *input_data,
+                              const data_dims_t *filter_dims,
+                              const int8_t *filter_data,
+                              const int32_t *bias,
+                              const data_dims_t *output_dims,
+                              int8_t *out_data,
+                              const conv_params_t *conv_params,
+                              const quant_plan_data_t *quant_data);
+
+void esp_nn_depthwise_conv_s8_plan_ansi(const esp_nn_ctx_t *ctx,
+                                        const data_dims_t *input_dims,
+                                        const int8_t *input_data,
+                                        const data_dims_t *filter_dims,
+                                        const int8_t *filter_data,
+                                        const int32_t *bias,
+                                        const data_dims_t *output_dims,
+                                        int8_t *out_data,
+                                        const dw_conv_params_t *conv_params,
+                                        const quant_plan_data_t *quant_data);
+
+void esp_nn_hard_swish_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                                   const int8_t *input,
+                                   int8_t *output,
+                                   const int32_t size,
+                                   const int16_t input_zero_point,
+                                   const int16_t output_mult_fxp,
+                                   const int16_t reluish_mult_fxp,
+                                   const int32_t reluish_mult_exp,
+                                   const int32_t output_mult_exp,
+                                   const int16_t output_zero_point);
+
+void esp_nn_softmax_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                                const int8_t *input_data,
+                                const int32_t height,
+                                const int32_t width,
+                                const int32_t mult,
+                                const int32_t shift,
+                                const int32_t diff_min,
+                                int8_t *output_data);
+
+/************************** Prepared variants *******************************/
+
+/**
+ * @brief       split of esp_nn_conv_s8 into a one time prepare and a per inference run
+ *
+ * @note        prepare copies the layer's shapes and params into `blob` (16 byte aligned,
+ *              esp_nn_get_conv_prepared_size bytes) along with any filter packing and
+ *              per channel terms the target would otherwise redo on every call.
+ *              run then takes only the input and output, with scratch from `ctx`
+ *              as for esp_nn_conv_s8_ctx.
+ *
+ * @return      prepare returns the blob as prepared layer, NULL if `blob` is misaligned
+ */
+int32_t esp_nn_get_conv_prepared_size_ansi(const data_dims_t *input_dims,
+                                           const data_dims_t *filter_dims,
+                                           const data_dims_t *output_dims,
+                                           const conv_params_t *conv_params);
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_ansi(void *blob,
+                                                    const data_dims_t *input_dims,
+                                                    const data_dims_t *filter_dims,
+                                                    const int8_t *filter_data,
+                                                    const int32_t *bias,
+                                                    const data_dims_t *output_dims,
+                                                    const conv_params_t *conv_params,
+                                                    const quant_data_t *quant_data);
+
+void esp_nn_conv_s8_run_ansi(const esp_nn_ctx_t *ctx,
+                             const esp_nn_conv_prepared_t *prep,
+                             const int8_t *input_data,
+                             int8_t *out_data);
+
+
+/************************** 16x8 functions **********************************/
+
+/**
+ * @brief       conv, depthwise conv and fully connected on int16 activations
+ *              with int8 weights
+ *
+ * @note        inputs type: int16_t, output: int16_t, bias: int64_t (may be NULL)
+ *              int16 tensors are symmetric: in_offset is ignored, out_offset
+ *              is normally 0. Accumulation is in int64 and the requantisation
+ *              uses the 16 bit reduced multiplier, as TFLite does.
+ *              activation: min / max within [-32768, 32767]
+ */
+void esp_nn_conv_s16_ansi(const data_dims_t *input_dims,
+                          const int16_t *input_data,
+                          const data_dims_t *filter_dims,
+                          const int8_t *filter_data,
+                          const int64_t *bias,
+                          const data_dims_t *output_dims,
+                          int16_t *out_data,
+                          const conv_params_t *conv_params,
+                          const quant_data_t *quant_data);
+
+void esp_nn_depthwise_conv_s16_ansi(const data_dims_t *input_dims,
+                                    const int16_t *input_data,
+                                    const data_dims_t *filter_dims,
+                                    const int8_t *filter_data,
+                                    const int64_t *bias,
+                                    const data_dims_t *output_dims,
+                                    int16_t *out_data,
+                                    const dw_conv_params_t *conv_params,
+                                    const quant_data_t *quant_data);
+
+void esp_nn_fully_connected_s16_ansi(const int16_t *input_data,
+                                     const uint16_t row_len,
+                                     const int8_t *filter_data,
+                                     const int64_t *bias,
+                                     int16_t *out_data,
+                                     const uint16_t out_channels,
+                                     const int32_t out_offset,
+                                     const int32_t out_shift,
+                                     const int32_t out_mult,
+                                     const int32_t activation_min,
+                                     const int32_t activation_max);
+
+
+/************************** int4 weight functions ****************************/
+
+/**
+ * @brief       conv and per channel fully connected with packed int4 weights
+ *
+ * @note        inputs type: int8_t, output: int8_t
+ *              filter_data: int4 weights packed with esp_nn_s4_pack, one row per
+ *              output channel (esp_nn_s4.h). Weights are symmetric: there is
+ *              no filter offset. Everything else is as for the int8 kernels.
+ */
+void esp_nn_conv_s4_ansi(const data_dims_t *input_dims,
+                         const int8_t *input_data,
+                         const data_dims_t *filter_dims,
+                         const int8_t *filter_data,
+                         const int32_t *bias,
+                         const data_dims_t *output_dims,
+                         int8_t *out_data,
+                         const conv_params_t *conv_params,
+                         const quant_data_t *quant_data);
+
+void esp_nn_fully_connected_per_ch_s4_ansi(const int8_t *input_data,
+                                           const int32_t input_offset,
+                                           const uint16_t row_len,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           int8_t *out_data,
+                                           const uint16_t out_channels,
+                                           const int32_t out_offset,
+                                           const int32_t *out_shift,
+                                           const int32_t *out_mult,
+                                           const int32_t activation_min,
+                                           const int32_t activation_max);
+
+
+/************************** Transpose convolution ***************************/
+
+/**
+ * @brief       transpose convolution (deconvolution), as TFLite TRANSPOSE_CONV
+ *
+ * @note        inputs type: int8_t, output: int8_t
+ *              filter_data: [out_channels][filter_ht][filter_wd][in_channels]
+ *              output_dims: (in - 1) * stride + filter - 2 * padding, or what the
+ *              model gives. Per channel quantization, bias may be NULL.
+ *              ctx->scratch: esp_nn_get_transpose_conv_scratch_size bytes
+ */
+void esp_nn_transpose_conv_s8_ansi(const esp_nn_ctx_t *ctx,
+                                   const data_dims_t *input_dims,
+                                   const int8_t *input_data,
+                                   const data_dims_t *filter_dims,
+                                   const int8_t *filter_data,
+                                   const int32_t *bias,
+                                   const data_dims_t *output_dims,
+                                   int8_t *out_data,
+                                   const conv_params_t *conv_params,
+                                   const quant_data_t *quant_data);
+
+int32_t esp_nn_get_transpose_conv_scratch_size_ansi(const data_dims_t *input_dims,
+                                                    const data_dims_t *filter_dims,
+                                                    const data_dims_t *output_dims,
+                                                    const conv_params_t *conv_params);
+
+/**
+ * @brief       transpose conv split into a one time prepare and a per inference run
+ *
+ * @note        as esp_nn_conv_s8_prepare_ansi, into a blob of
+ *              esp_nn_get_transpose_conv_prepared_size bytes. The optimised versions
+ *              fold the per tap filter sums into the blob, run then needs no scratch.
+ *
+ * @return      prepare returns the blob as prepared layer, NULL if `blob` is misaligned
+ */
+int32_t esp_nn_get_transpose_conv_prepared_size_ansi(const data_dims_t *input_dims,
+                                                     const data_dims_t *filter_dims,
+                                                     const data_dims_t *output_dims,
+                                                     const conv_params_t *conv_params);
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_s8_prepare_ansi(void *blob,
+                                                              const data_dims_t *input_dims,
+                                                              const data_dims_t *filter_dims,
+                                                              const int8_t *filter_data,
+                                                              const int32_t *bias,
+                                                              const data_dims_t *output_dims,
+                                                              const conv_params_t *conv_params,
+                                                              const quant_data_t *quant_data);
+
+void esp_nn_transpose_conv_s8_run_ansi(const esp_nn_ctx_t *ctx,
+                                       const esp_nn_conv_prepared_t *prep,
+                                       const int8_t *input_data,
+                                       int8_t *out_data);
+
+
+/************************** Batch matrix multiply ***************************/
+
+/**
+ * @brief       batched int8 matrix multiplication, as TFLite BATCH_MATMUL
+ *
+ * @note        lhs_data: [batches][rows][depth], lhs_dims height rows, width depth
+ *              rhs_data: [batches][depth][cols], rhs_dims height depth, width cols,
+ *              or [batches][cols][depth] with params->rhs_transposed, height cols,
+ *              width depth
+ *              out_data: [batches][rows][cols], output_dims height rows, width cols
+ *              `extra` of the dims is the batch count. An operand with a single
+ *              batch is used for every batch of the output. Per tensor quantization.
+ *              ctx->scratch: esp_nn_get_batch_matmul_scratch_size bytes
+ */
+void esp_nn_batch_matmul_s8_ansi(const esp_nn_ctx_t *ctx,
+                                 const data_dims_t *lhs_dims,
+                                 const int8_t *lhs_data,
+                                 const data_dims_t *rhs_dims,
+                                 const int8_t *rhs_data,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const matmul_params_t *params);
+
+int32_t esp_nn_get_batch_matmul_scratch_size_ansi(const data_dims_t *lhs_dims,
+                                                  const data_dims_t *rhs_dims,
+                                                  const data_dims_t *output_dims,
+                                                  const matmul_params_t *params);
+
+
+/********************************** LSTM ************************************/
+
+/**
+ * @brief       int8 LSTM over whole sequences, as TFLite integer (8x8_16)
+ *              UNIDIRECTIONAL_SEQUENCE_LSTM without peephole, projection or
+ *              layer norm
+ *
+ * @note        input_data: [batches][steps][input_size], input_dims height steps,
+ *              width input_size, `extra` batches (batch major)
+ *              out_data: [batches][steps][units], the hidden state of every step,
+ *              output_dims height steps, width units
+ *              hidden_state: [batches][units] int8, the state before the sequence,
+ *              left at the last one
+ *              cell_state: [batches][units] int16 at scale 2^params->cell_shift,
+ *              updated in place
+ *              params->sigmoid_lut, tanh_lut: from esp_nn_logistic_s16_prepare and
+ *              esp_nn_tanh_s16_prepare
+ *              ctx->scratch: esp_nn_get_lstm_scratch_size bytes
+ */
+void esp_nn_lstm_s8_ansi(const esp_nn_ctx_t *ctx,
+                         const data_dims_t *input_dims,
+                         const int8_t *input_data,
+                         const data_dims_t *output_dims,
+                         int8_t *out_data,
+                         int8_t *hidden_state,
+                         int16_t *cell_state,
+                         const lstm_params_t *params);
+
+int32_t esp_nn_get_lstm_scratch_size_ansi(const data_dims_t *input_dims,
+                                          const data_dims_t *output_dims,
+                                          const lstm_params_t *params);
+
 
 //////////////////////////// Generic optimisations /////////////////////////////
 
@@ -368,6 +791,260 @@ void esp_nn_softmax_s8_opt(const int8_t *input_data,
                            const int32_t diff_min,
                            int8_t *output_data);
 
+/**
+ * @brief       reentrant variants of the optimised functions, scratch is taken from `ctx`
+ */
+void esp_nn_conv_s8_ctx_opt(const esp_nn_ctx_t *ctx,
+                            const data_dims_t *input_dims,
+                            const int8_t *input_data,
+                            const data_dims_t *filter_dims,
+                            const int8_t *filter_data,
+                            const int32_t *bias,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            const conv_params_t *conv_params,
+                            const quant_data_t *quant_data);
+
+void esp_nn_depthwise_conv_s8_ctx_opt(const esp_nn_ctx_t *ctx,
+                                      const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const dw_conv_params_t *conv_params,
+                                      const quant_data_t *quant_data);
+
+void esp_nn_conv_s8_plan_opt(const esp_nn_ctx_t *ctx,
+                             const data_dims_t *input_dims,
+                             const int8_t *input_data,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_plan_data_t *quant_data);
+
+void esp_nn_depthwise_conv_s8_plan_opt(const esp_nn_ctx_t *ctx,
+                                       const data_dims_t *input_dims,
+                                       const int8_t *input_data,
+                                       const data_dims_t *filter_dims,
+                                       const int8_t *filter_data,
+                                       const int32_t *bias,
+                                       const data_dims_t *output_dims,
+                                       int8_t *out_data,
+                                       const dw_conv_params_t *conv_params,
+                                       const quant_plan_data_t *quant_data);
+
+/**
+ * @brief       depthwise conv with dilated taps
+ *
+ * @note        taps are `dilation` apart, so the input pixels under the filter are
+ *              not adjacent and a window can not be loaded as rows. Each tap instead
+ *              adds its input pixel, contiguous over the channels, into the sums of a
+ *              block of 16 output channels, which stay in registers or on the
+ *              stack over the whole window.
+ */
+void esp_nn_depthwise_conv_s8_dilated_opt(const data_dims_t *input_dims,
+                                          const int8_t *input_data,
+                                          const data_dims_t *filter_dims,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          const data_dims_t *output_dims,
+                                          int8_t *out_data,
+                                          const dw_conv_params_t *conv_params,
+                                          const quant_plan_data_t *quant_data);
+
+void esp_nn_softmax_s8_ctx_opt(const esp_nn_ctx_t *ctx,
+                               const int8_t *input_data,
+                               const int32_t height,
+                               const int32_t width,
+                               const int32_t mult,
+                               const int32_t shift,
+                               const int32_t diff_min,
+                               int8_t *output_data);
+
+/**
+ * @brief       prepared variants of the optimised conv, see esp_nn_conv_s8_prepare_ansi
+ */
+int32_t esp_nn_get_conv_prepared_size_opt(const data_dims_t *input_dims,
+                                          const data_dims_t *filter_dims,
+                                          const data_dims_t *output_dims,
+                                          const conv_params_t *conv_params);
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_opt(void *blob,
+                                                   const data_dims_t *input_dims,
+                                                   const data_dims_t *filter_dims,
+                                                   const int8_t *filter_data,
+                                                   const int32_t *bias,
+                                                   const data_dims_t *output_dims,
+                                                   const conv_params_t *conv_params,
+                                                   const quant_data_t *quant_data);
+
+void esp_nn_conv_s8_run_opt(const esp_nn_ctx_t *ctx,
+                            const esp_nn_conv_prepared_t *prep,
+                            const int8_t *input_data,
+                            int8_t *out_data);
+
+/**
+ * @brief       16x8 conv, depthwise conv and fully connected, optimised versions
+ *
+ * @note        see esp_nn_conv_s16_ansi. Grouped conv and depthwise with a channel
+ *              multiplier other than 1 use the ansi versions.
+ */
+void esp_nn_conv_s16_opt(const data_dims_t *input_dims,
+                         const int16_t *input_data,
+                         const data_dims_t *filter_dims,
+                         const int8_t *filter_data,
+                         const int64_t *bias,
+                         const data_dims_t *output_dims,
+                         int16_t *out_data,
+                         const conv_params_t *conv_params,
+                         const quant_data_t *quant_data);
+
+void esp_nn_depthwise_conv_s16_opt(const data_dims_t *input_dims,
+                                   const int16_t *input_data,
+                                   const data_dims_t *filter_dims,
+                                   const int8_t *filter_data,
+                                   const int64_t *bias,
+                                   const data_dims_t *output_dims,
+                                   int16_t *out_data,
+                                   const dw_conv_params_t *conv_params,
+                                   const quant_data_t *quant_data);
+
+void esp_nn_fully_connected_s16_opt(const int16_t *input_data,
+                                    const uint16_t row_len,
+                                    const int8_t *filter_data,
+                                    const int64_t *bias,
+                                    int16_t *out_data,
+                                    const uint16_t out_channels,
+                                    const int32_t out_offset,
+                                    const int32_t out_shift,
+                                    const int32_t out_mult,
+                                    const int32_t activation_min,
+                                    const int32_t activation_max);
+
+/**
+ * @brief       int4 weight conv and fully connected, optimised versions
+ *
+ * @note        see esp_nn_conv_s4_ansi. The conv is optimised for 1x1 filters
+ *              without padding or groups, other filters use the ansi version.
+ */
+void esp_nn_conv_s4_opt(const data_dims_t *input_dims,
+                        const int8_t *input_data,
+                        const data_dims_t *filter_dims,
+                        const int8_t *filter_data,
+                        const int32_t *bias,
+                        const data_dims_t *output_dims,
+                        int8_t *out_data,
+                        const conv_params_t *conv_params,
+                        const quant_data_t *quant_data);
+
+void esp_nn_fully_connected_per_ch_s4_opt(const int8_t *input_data,
+                                          const int32_t input_offset,
+                                          const uint16_t row_len,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          int8_t *out_data,
+                                          const uint16_t out_channels,
+                                          const int32_t out_offset,
+                                          const int32_t *out_shift,
+                                          const int32_t *out_mult,
+                                          const int32_t activation_min,
+                                          const int32_t activation_max);
+
+/**
+ * @brief       block sparse fully connected run, optimised version
+ */
+void esp_nn_fully_connected_s8_sparse_run_opt(const esp_nn_fc_sparse_t *sparse,
+                                              const int8_t *input_data,
+                                              int8_t *out_data);
+
+/**
+ * @brief       transpose convolution, optimised version
+ *
+ * @note        see esp_nn_transpose_conv_s8_ansi. Output stationary: no zero
+ *              insertion and no scatter, the scratch holds per tap filter sums.
+ */
+void esp_nn_transpose_conv_s8_opt(const esp_nn_ctx_t *ctx,
+                                  const data_dims_t *input_dims,
+                                  const int8_t *input_data,
+                                  const data_dims_t *filter_dims,
+                                  const int8_t *filter_data,
+                                  const int32_t *bias,
+                                  const data_dims_t *output_dims,
+                                  int8_t *out_data,
+                                  const conv_params_t *conv_params,
+                                  const quant_data_t *quant_data);
+
+int32_t esp_nn_get_transpose_conv_scratch_size_opt(const data_dims_t *input_dims,
+                                                   const data_dims_t *filter_dims,
+                                                   const data_dims_t *output_dims,
+                                                   const conv_params_t *conv_params);
+
+int32_t esp_nn_get_transpose_conv_prepared_size_opt(const data_dims_t *input_dims,
+                                                    const data_dims_t *filter_dims,
+                                                    const data_dims_t *output_dims,
+                                                    const conv_params_t *conv_params);
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_s8_prepare_opt(void *blob,
+                                                             const data_dims_t *input_dims,
+                                                             const data_dims_t *filter_dims,
+                                                             const int8_t *filter_data,
+                                                             const int32_t *bias,
+                                                             const data_dims_t *output_dims,
+                                                             const conv_params_t *conv_params,
+                                                             const quant_data_t *quant_data);
+
+void esp_nn_transpose_conv_s8_run_opt(const esp_nn_ctx_t *ctx,
+                                      const esp_nn_conv_prepared_t *prep,
+                                      const int8_t *input_data,
+                                      int8_t *out_data);
+
+/**
+ * @brief       batch matmul, optimised version
+ *
+ * @note        see esp_nn_batch_matmul_s8_ansi. Cache blocked: a block of rhs
+ *              columns is packed into scratch and every lhs row runs against it,
+ *              each lhs value shared by a tile of columns.
+ */
+void esp_nn_batch_matmul_s8_opt(const esp_nn_ctx_t *ctx,
+                                const data_dims_t *lhs_dims,
+                                const int8_t *lhs_data,
+                                const data_dims_t *rhs_dims,
+                                const int8_t *rhs_data,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const matmul_params_t *params);
+
+int32_t esp_nn_get_batch_matmul_scratch_size_opt(const data_dims_t *lhs_dims,
+                                                 const data_dims_t *rhs_dims,
+                                                 const data_dims_t *output_dims,
+                                                 const matmul_params_t *params);
+
+/**
+ * @brief       LSTM, optimised version
+ *
+ * @note        see esp_nn_lstm_s8_ansi. The four gates of a unit are fused: the
+ *              input products of a block of steps are run up front, each weight
+ *              row against every step, and the recurrence shares each hidden
+ *              state value between the four gate rows of a unit.
+ */
+void esp_nn_lstm_s8_opt(const esp_nn_ctx_t *ctx,
+                        const data_dims_t *input_dims,
+                        const int8_t *input_data,
+                        const data_dims_t *output_dims,
+                        int8_t *out_data,
+                        int8_t *hidden_state,
+                        int16_t *cell_state,
+                        const lstm_params_t *params);
+
+int32_t esp_nn_get_lstm_scratch_size_opt(const data_dims_t *input_dims,
+                                         const data_dims_t *output_dims,
+                                         const lstm_params_t *params);
+
 /**
  * @brief       Get scratch buffer size for int8 logistic (sigmoid).
  * @return      256 (size of LUT in bytes)
@@ -398,3 +1075,45 @@ void esp_nn_logistic_s8_prepare_ansi(int8_t *scratch_buf,
  */
 void esp_nn_logistic_s8_ansi(const int8_t *input, int8_t *output,
                               int32_t size, const int8_t *scratch_buf);
+
+/**
+ * @brief       Get the size of the int16 logistic (sigmoid) table.
+ * @return      1026 (513 int16 entries)
+ */
+int32_t esp_nn_get_logistic_s16_scratch_size_ansi(void);
+
+/**
+ * @brief       Prepare the table of int16 logistic (sigmoid).
+ *
+ * @note        Input is Q3.12 (scale 2^-12), output Q0.15 (scale 2^-15).
+ */
+void esp_nn_logistic_s16_prepare_ansi(int16_t *lut);
+
+/**
+ * @brief       Apply int16 logistic (sigmoid), interpolating the table.
+ *
+ * @note        Within 1 LSB of the exact sigmoid, not bit exact with TFLite.
+ */
+void esp_nn_logistic_s16_ansi(const int16_t *input, int16_t *output,
+                              int32_t size, const int16_t *lut);
+
+/**
+ * @brief       Get the size of the int16 tanh table.
+ * @return      1026 (513 int16 entries)
+ */
+int32_t esp_nn_get_tanh_s16_scratch_size_ansi(void);
+
+/**
+ * @brief       Prepare the table of int16 tanh.
+ *
+ * @note        Input is Q3.12 (scale 2^-12), output Q0.15 (scale 2^-15).
+ */
+void esp_nn_tanh_s16_prepare_ansi(int16_t *lut);
+
+/**
+ * @brief       Apply int16 tanh, interpolating the table.
+ *
+ * @note        Within 4 LSB of the exact tanh, not bit exact with TFLite.
+ */
+void esp_nn_tanh_s16_ansi(const int16_t *input, int16_t *output,
+                          int32_t size, const int16_t *lut);
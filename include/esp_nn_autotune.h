@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Shape keyed autotuning of the conv dispatch path.
+ *
+ * The conv dispatchers pick a kernel path from fixed heuristics. With
+ * `NN_AUTOTUNE` enabled in menuconfig (ESP_NN_AUTOTUNE defined), they first
+ * look the layer shape up in a small table. After esp_nn_autotune_enable(true),
+ * a shape missing from the table has every path eligible for it timed once,
+ * on synthetic data, and the fastest one is added to the table.
+ *
+ * The first query of a shape tunes it, whichever it is: scratch size, prepare
+ * or call. Scratch and prepared sizes then always match the path used.
+ *
+ * Tune on a development build, export the table, and preload it at boot of
+ * the production build, which then runs with tuning disabled.
+ * Paths are target specific: preload tables exported by the same target.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(ESP_NN_AUTOTUNE) || defined(CONFIG_NN_AUTOTUNE)
+#define ESP_NN_AUTOTUNE_ENABLED     1
+#else
+#define ESP_NN_AUTOTUNE_ENABLED     0
+#endif
+
+/* dispatchers with tunable paths */
+typedef enum {
+    ESP_NN_AUTOTUNE_CONV_S8_OPT = 0,
+    ESP_NN_AUTOTUNE_CONV_S8_ESP32S3,
+    ESP_NN_AUTOTUNE_CONV_S8_ESP32P4,
+} esp_nn_autotune_kernel_t;
+
+typedef struct esp_nn_autotune_key {
+    uint16_t kernel;            // esp_nn_autotune_kernel_t
+    uint16_t input_wd;
+    uint16_t input_ht;
+    uint16_t input_ch;
+    uint16_t filter_wd;
+    uint16_t filter_ht;
+    uint16_t filter_ch;
+    uint16_t out_wd;
+    uint16_t out_ht;
+    uint16_t out_ch;
+    uint16_t stride_wd;
+    uint16_t stride_ht;
+    uint16_t pad_wd;
+    uint16_t pad_ht;
+} esp_nn_autotune_key_t;
+
+typedef struct esp_nn_autotune_entry {
+    esp_nn_autotune_key_t key;
+    int32_t path;               // target specific path of the dispatcher
+} esp_nn_autotune_entry_t;
+
+/**
+ * @brief   enable or disable tuning of shapes missing from the table
+ *
+ * @note    Tuning allocates the layer's input, filter, output and scratch on
+ *          the heap. Shapes it can't allocate for keep the default path.
+ *          Tune from one task: the table isn't locked.
+ *
+ * @return  0 on success, -1 if autotuning is compiled out
+ */
+int esp_nn_autotune_enable(bool enable);
+
+/**
+ * @brief   add `entries` to the table, replacing the paths of known shapes
+ *
+ * @return  number of entries added or replaced, -1 if autotuning is compiled out
+ */
+int esp_nn_autotune_preload(const esp_nn_autotune_entry_t *entries, int count);
+
+/**
+ * @brief   copy up to `max_entries` entries of the table to `entries`
+ *
+ * @return  number of entries copied, -1 if autotuning is compiled out
+ */
+int esp_nn_autotune_export(esp_nn_autotune_entry_t *entries, int max_entries);
+
+/**
+ * @brief   clear the table
+ */
+void esp_nn_autotune_reset(void);
+
+/**
+ * @brief   print the table as a C initializer of esp_nn_autotune_entry_t
+ */
+void esp_nn_autotune_print(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Batched pooling.
+ *
+ * Conv and depthwise conv take the batch from `extra` of their input dims,
+ * fully connected has esp_nn_fully_connected_s8_run_batch. The pooling
+ * APIs take no dims: these run the selected kernel on each image in turn.
+ * Images follow each other in the input and the output, there are no
+ * weights to share between them.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void esp_nn_avg_pool_s8_batch(const int32_t batches,
+                                            const int8_t *input,
+                                            const uint16_t input_wd,
+                                            const uint16_t input_ht,
+                                            int8_t *output,
+                                            const uint16_t output_wd,
+                                            const uint16_t output_ht,
+                                            const uint16_t stride_wd,
+                                            const uint16_t stride_ht,
+                                            const uint16_t filter_wd,
+                                            const uint16_t filter_ht,
+                                            const uint16_t pad_wd,
+                                            const uint16_t pad_ht,
+                                            const int32_t activation_min,
+                                            const int32_t activation_max,
+                                            const uint16_t channels)
+{
+    for (int32_t batch = 0; batch < batches; batch++) {
+        esp_nn_avg_pool_s8(input + batch * input_wd * input_ht * channels, input_wd, input_ht,
+                           output + batch * output_wd * output_ht * channels, output_wd, output_ht,
+                           stride_wd, stride_ht, filter_wd, filter_ht, pad_wd, pad_ht,
+                           activation_min, activation_max, channels);
+    }
+}
+
+static inline void esp_nn_max_pool_s8_batch(const int32_t batches,
+                                            const int8_t *input,
+                                            const uint16_t input_wd,
+                                            const uint16_t input_ht,
+                                            int8_t *output,
+                                            const uint16_t output_wd,
+                                            const uint16_t output_ht,
+                                            const uint16_t stride_wd,
+                                            const uint16_t stride_ht,
+                                            const uint16_t filter_wd,
+                                            const uint16_t filter_ht,
+                                            const uint16_t pad_wd,
+                                            const uint16_t pad_ht,
+                                            const int32_t activation_min,
+                                            const int32_t activation_max,
+                                            const uint16_t channels)
+{
+    for (int32_t batch = 0; batch < batches; batch++) {
+        esp_nn_max_pool_s8(input + batch * input_wd * input_ht * channels, input_wd, input_ht,
+                           output + batch * output_wd * output_ht * channels, output_wd, output_ht,
+                           stride_wd, stride_ht, filter_wd, filter_ht, pad_wd, pad_ht,
+                           activation_min, activation_max, channels);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
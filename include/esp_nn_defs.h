@@ -25,7 +25,9 @@ typedef struct data_dims {
     int32_t height;
     int32_t channels;
 
-    int32_t extra; // can be used as batch or any other param
+    /* batch count of input and output dims: 0 or 1 is a single image. Kernels read
+     * it as the number of images, so it must not carry anything else */
+    int32_t extra;
 } data_dims_t;
 
 /**
@@ -45,6 +47,18 @@ typedef struct act_params {
     int32_t max;
 } act_params_t;
 
+/**
+ * @brief requantisation of one output channel, split once from its mult / shift
+ *
+ * @note see esp_nn_requant_plan_init
+ */
+typedef struct esp_nn_requant {
+    int32_t mult;
+    int32_t left_shift;     // max(shift, 0)
+    int32_t right_shift;    // max(-shift, 0)
+    int32_t round_mask;     // (1 << right_shift) - 1, 0 when the channel doesn't shift right
+} esp_nn_requant_t;
+
 /**
  * @brief per channel quant data
  *
@@ -55,6 +69,21 @@ typedef struct quant_data {
     int32_t *mult;
 } quant_data_t;
 
+/**
+ * @brief per channel quant data with its requantisation plan, for the `_plan`
+ *        variants of conv and depthwise conv
+ *
+ * @note shift and mult are as in quant_data_t and are still read by the
+ *       ESP32-S3 assembly kernels. `plan` has one entry per output channel
+ *       and is used instead of them by the kernels that take it, NULL
+ *       requantizes from shift and mult.
+ */
+typedef struct quant_plan_data {
+    int32_t *shift;
+    int32_t *mult;
+    const esp_nn_requant_t *plan;   // NULL, or from esp_nn_requant_plan_init
+} quant_plan_data_t;
+
 /**
  * @brief params specific to convolution 2d
  *
@@ -81,3 +110,166 @@ typedef struct dw_conv_params {
     data_2d_t dilation;
     act_params_t activation;
 } dw_conv_params_t;
+
+/**
+ * @brief params of batched matrix multiplication, per tensor quantisation
+ *
+ * @note operation: out = requant(sum (lhs + lhs_offset) * (rhs + rhs_offset))
+ */
+typedef struct matmul_params {
+    int32_t lhs_offset;
+    int32_t rhs_offset;
+    int32_t out_offset;
+    int32_t out_mult;
+    int32_t out_shift;
+    int32_t rhs_transposed;     // rhs is [cols][depth] instead of [depth][cols]
+    act_params_t activation;
+} matmul_params_t;
+
+/* gates of an LSTM cell, indices into lstm_params_t.gates */
+enum {
+    ESP_NN_LSTM_INPUT_GATE = 0,
+    ESP_NN_LSTM_FORGET_GATE,
+    ESP_NN_LSTM_CELL_GATE,
+    ESP_NN_LSTM_OUTPUT_GATE,
+    ESP_NN_LSTM_GATES,
+};
+
+/**
+ * @brief one gate of an int8 LSTM cell, symmetric int8 weights
+ *
+ * @note operation, saturated to int16 Q3.12 after each term:
+ *       gate = requant(W_x (x + input_offset) + bias) + requant(W_h (h + hidden_offset))
+ */
+typedef struct lstm_gate {
+    const int8_t *input_weights;        // [units][input_size]
+    const int8_t *recurrent_weights;    // [units][units]
+    const int32_t *bias;                // [units], scale of the input product, may be NULL
+    int32_t input_mult;                 // input product to Q3.12
+    int32_t input_shift;
+    int32_t recurrent_mult;             // recurrent product to Q3.12
+    int32_t recurrent_shift;
+} lstm_gate_t;
+
+/**
+ * @brief params of an int8 input / int16 cell state LSTM, as the TFLite
+ *        integer UNIDIRECTIONAL_SEQUENCE_LSTM
+ *
+ * @note i, f, o = sigmoid(gate), g = tanh(gate), both Q0.15 through the tables,
+ *       within 1 (sigmoid) and 4 (tanh) LSB of the exact functions, not bit
+ *       exact with TFLite
+ *       c = f * c + i * g, at the cell scale 2^cell_shift
+ *       h = requant(o * tanh(c)) - hidden_offset, o * tanh(c) in Q0.30
+ *       Both offsets are -zero points, as in_offset: the hidden state is an
+ *       input of the recurrent products before it is the output.
+ */
+typedef struct lstm_params {
+    lstm_gate_t gates[ESP_NN_LSTM_GATES];
+    int32_t input_offset;       // -zero point of the input
+    int32_t hidden_offset;      // -zero point of the hidden state, which is the output
+    int32_t hidden_mult;
+    int32_t hidden_shift;
+    int32_t cell_shift;         // power of two scale of the cell state, -30 .. 0, e.g. -11
+    int32_t cell_clip;          // the cell state is kept in [-cell_clip, cell_clip], 0 for no clip
+    const int16_t *sigmoid_lut; // from esp_nn_logistic_s16_prepare
+    const int16_t *tanh_lut;    // from esp_nn_tanh_s16_prepare
+    act_params_t activation;    // of the hidden state
+} lstm_params_t;
+
+/**
+ * @brief per caller context for the `_ctx` variants of the functions
+ *
+ * @note The `_ctx` variants use `scratch` instead of the buffer set with
+ *       esp_nn_set_*_scratch_buf, hence calls with different contexts can run
+ *       concurrently, e.g. one model per core. Size `scratch` to the largest
+ *       esp_nn_get_*_scratch_size of the layers run with the context.
+ *       Zero initialise contexts: a NULL `mover` stages tiles with plain
+ *       memcpy. Contexts used concurrently need their own mover, see
+ *       esp_nn_mover.h.
+ */
+typedef struct esp_nn_ctx {
+    void *scratch;
+    const struct esp_nn_tile_mover *mover;  // stages the tiles of tiled kernels, NULL: memcpy
+} esp_nn_ctx_t;
+
+/**
+ * @brief prepacked convolution layer, see esp_nn_conv_s8_prepare
+ *
+ * @note Sits at the start of the prepared blob, packed data follows it.
+ *       Shapes and params are copied. The quant arrays, and the filter/bias
+ *       when not packed into the blob, are referenced: keep them alive while
+ *       the blob is used.
+ *       The layout is target specific, prepare and run with the same build.
+ */
+typedef struct esp_nn_conv_prepared {
+    data_dims_t input_dims;
+    data_dims_t filter_dims;
+    data_dims_t output_dims;
+    conv_params_t conv_params;
+    quant_plan_data_t quant_data; // plan built in the blob
+    const int8_t *filter;       // filter to run with: packed copy in the blob or the original
+    const int32_t *bias;        // bias, or per channel corrections with the input offset folded in
+    const int32_t *offset_acc;  // per channel filter_sum * input_offset if precomputed, else NULL,
+                                // per channel and tap for a prepared transpose conv
+    int32_t path;               // kernel path selected at prepare time, target specific
+} esp_nn_conv_prepared_t;
+
+/**
+ * @brief weight layouts of a prepared fully connected layer
+ */
+typedef enum {
+    ESP_NN_FC_LAYOUT_ROWS = 0,      // one filter row per channel, 16 byte aligned rows
+    ESP_NN_FC_LAYOUT_INTERLEAVED,   // groups of 4 channels, 16 byte blocks of each row interleaved
+} esp_nn_fc_layout_t;
+
+/**
+ * @brief prepared fully connected layer, see esp_nn_fully_connected_s8_prepare
+ *
+ * @note Sits at the start of the prepared blob, folded corrections, the
+ *       requantisation plan and packed weights follow it. The original filter, bias and per channel quant
+ *       arrays are referenced: keep them alive while the blob is used.
+ */
+typedef struct esp_nn_fc_prepared {
+    uint16_t row_len;
+    uint16_t out_channels;
+    int32_t input_offset;
+    int32_t filter_offset;
+    int32_t out_offset;
+    int32_t out_shift;              // per tensor quantisation, used when out_shifts is NULL
+    int32_t out_mult;
+    const int32_t *out_shifts;      // per channel quantisation or NULL
+    const int32_t *out_mults;
+    act_params_t activation;
+    const int8_t *filter;           // original filter
+    const int32_t *bias;            // original bias
+    const int8_t *packed_filter;    // weights in `layout`, NULL if not packed
+    const int32_t *corrections;     // per channel filter_sum * input_offset + bias, NULL if not folded
+    const esp_nn_requant_t *requant;    // requantisation plan, one entry per channel
+    int32_t row_stride;             // row_len rounded up to 16, packed rows are zero padded to it
+    int32_t layout;                 // esp_nn_fc_layout_t
+} esp_nn_fc_prepared_t;
+
+/* weights per block of a block sparse fully connected layer */
+#define ESP_NN_FC_SPARSE_BLOCK  16
+
+/**
+ * @brief block sparse fully connected layer, see esp_nn_fully_connected_s8_sparse_pack
+ *
+ * @note Each weight row is cut in blocks of 16 and only the blocks with a
+ *       non zero weight are kept, in CSR form. Sits at the start of the blob,
+ *       the arrays follow it at the byte offsets below. The blob holds no
+ *       pointers: it can be packed offline and used from flash.
+ */
+typedef struct esp_nn_fc_sparse {
+    uint16_t row_len;
+    uint16_t out_channels;
+    int32_t out_offset;
+    act_params_t activation;
+    int32_t blocks;                 // blocks kept
+    int32_t size;                   // bytes of the blob
+    int32_t row_blocks_offset;      // int32_t[out_channels + 1], first block of each channel
+    int32_t block_cols_offset;      // uint16_t[blocks], input index / 16 of each block
+    int32_t values_offset;          // int8_t[blocks * 16], zero padded past row_len
+    int32_t corrections_offset;     // int32_t[out_channels], filter_sum * input_offset + bias
+    int32_t requant_offset;         // esp_nn_requant_t[out_channels]
+} esp_nn_fc_sparse_t;
@@ -38,6 +38,115 @@ int esp_nn_get_conv_scratch_size_esp32p4(const data_dims_t *input_dims,
                                          const conv_params_t *conv_params);
 void esp_nn_set_conv_scratch_buf_esp32p4(const void *buf);
 
+/* reentrant variant, scratch is taken from `ctx` instead of the set scratch buffer */
+void esp_nn_conv_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                const data_dims_t *input_dims,
+                                const int8_t *input_data,
+                                const data_dims_t *filter_dims,
+                                const int8_t *filter_data,
+                                const int32_t *bias,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const conv_params_t *conv_params,
+                                const quant_data_t *quant_data);
+
+/* with a requantisation plan, see esp_nn_conv_s8_plan_ansi */
+void esp_nn_conv_s8_plan_esp32p4(const esp_nn_ctx_t *ctx,
+                                 const data_dims_t *input_dims,
+                                 const int8_t *input_data,
+                                 const data_dims_t *filter_dims,
+                                 const int8_t *filter_data,
+                                 const int32_t *bias,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const conv_params_t *conv_params,
+                                 const quant_plan_data_t *quant_data);
+
+/* prepared variants, see esp_nn_conv_s8_prepare_ansi */
+int32_t esp_nn_get_conv_prepared_size_esp32p4(const data_dims_t *input_dims,
+                                              const data_dims_t *filter_dims,
+                                              const data_dims_t *output_dims,
+                                              const conv_params_t *conv_params);
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_esp32p4(void *blob,
+                                                       const data_dims_t *input_dims,
+                                                       const data_dims_t *filter_dims,
+                                                       const int8_t *filter_data,
+                                                       const int32_t *bias,
+                                                       const data_dims_t *output_dims,
+                                                       const conv_params_t *conv_params,
+                                                       const quant_data_t *quant_data);
+
+void esp_nn_conv_s8_run_esp32p4(const esp_nn_ctx_t *ctx,
+                                const esp_nn_conv_prepared_t *prep,
+                                const int8_t *input_data,
+                                int8_t *out_data);
+
+/* transpose conv, see esp_nn_transpose_conv_s8_ansi */
+int32_t esp_nn_get_transpose_conv_scratch_size_esp32p4(const data_dims_t *input_dims,
+                                                       const data_dims_t *filter_dims,
+                                                       const data_dims_t *output_dims,
+                                                       const conv_params_t *conv_params);
+
+void esp_nn_transpose_conv_s8_esp32p4(const esp_nn_ctx_t *ctx,
+                                      const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const conv_params_t *conv_params,
+                                      const quant_data_t *quant_data);
+
+int32_t esp_nn_get_transpose_conv_prepared_size_esp32p4(const data_dims_t *input_dims,
+                                                        const data_dims_t *filter_dims,
+                                                        const data_dims_t *output_dims,
+                                                        const conv_params_t *conv_params);
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_s8_prepare_esp32p4(void *blob,
+                                                                 const data_dims_t *input_dims,
+                                                                 const data_dims_t *filter_dims,
+                                                                 const int8_t *filter_data,
+                                                                 const int32_t *bias,
+                                                                 const data_dims_t *output_dims,
+                                                                 const conv_params_t *conv_params,
+                                                                 const quant_data_t *quant_data);
+
+void esp_nn_transpose_conv_s8_run_esp32p4(const esp_nn_ctx_t *ctx,
+                                          const esp_nn_conv_prepared_t *prep,
+                                          const int8_t *input_data,
+                                          int8_t *out_data);
+
+/* batch matmul, see esp_nn_batch_matmul_s8_ansi */
+int32_t esp_nn_get_batch_matmul_scratch_size_esp32p4(const data_dims_t *lhs_dims,
+                                                     const data_dims_t *rhs_dims,
+                                                     const data_dims_t *output_dims,
+                                                     const matmul_params_t *params);
+
+void esp_nn_batch_matmul_s8_esp32p4(const esp_nn_ctx_t *ctx,
+                                    const data_dims_t *lhs_dims,
+                                    const int8_t *lhs_data,
+                                    const data_dims_t *rhs_dims,
+                                    const int8_t *rhs_data,
+                                    const data_dims_t *output_dims,
+                                    int8_t *out_data,
+                                    const matmul_params_t *params);
+
+/* LSTM, see esp_nn_lstm_s8_ansi */
+int32_t esp_nn_get_lstm_scratch_size_esp32p4(const data_dims_t *input_dims,
+                                             const data_dims_t *output_dims,
+                                             const lstm_params_t *params);
+
+void esp_nn_lstm_s8_esp32p4(const esp_nn_ctx_t *ctx,
+                            const data_dims_t *input_dims,
+                            const int8_t *input_data,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            int8_t *hidden_state,
+                            int16_t *cell_state,
+                            const lstm_params_t *params);
+
 /********************** function defines ***************************/
 
 
@@ -89,12 +198,39 @@ int esp_nn_get_depthwise_conv_scratch_size_esp32p4(const data_dims_t *input_dims
                                                     const data_dims_t *output_dims,
                                                     const dw_conv_params_t *conv_params);
 void esp_nn_set_depthwise_conv_scratch_buf_esp32p4(const void *buf);
+void esp_nn_depthwise_conv_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                          const data_dims_t *input_dims,
+                                          const int8_t *input_data,
+                                          const data_dims_t *filter_dims,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          const data_dims_t *output_dims,
+                                          int8_t *out_data,
+                                          const dw_conv_params_t *conv_params,
+                                          const quant_data_t *quant_data);
+void esp_nn_depthwise_conv_s8_plan_esp32p4(const esp_nn_ctx_t *ctx,
+                                           const data_dims_t *input_dims,
+                                           const int8_t *input_data,
+                                           const data_dims_t *filter_dims,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           const data_dims_t *output_dims,
+                                           int8_t *out_data,
+                                           const dw_conv_params_t *conv_params,
+                                           const quant_plan_data_t *quant_data);
 #define esp_nn_depthwise_conv_s8 esp_nn_depthwise_conv_s8_esp32p4
+#define esp_nn_depthwise_conv_s8_ctx esp_nn_depthwise_conv_s8_ctx_esp32p4
+#define esp_nn_depthwise_conv_s8_plan esp_nn_depthwise_conv_s8_plan_esp32p4
 
 #define esp_nn_conv_s8 esp_nn_conv_s8_esp32p4
+#define esp_nn_conv_s8_ctx esp_nn_conv_s8_ctx_esp32p4
+#define esp_nn_conv_s8_plan esp_nn_conv_s8_plan_esp32p4
 
 #define esp_nn_get_conv_scratch_size esp_nn_get_conv_scratch_size_esp32p4
 #define esp_nn_set_conv_scratch_buf esp_nn_set_conv_scratch_buf_esp32p4
+#define esp_nn_get_conv_prepared_size esp_nn_get_conv_prepared_size_esp32p4
+#define esp_nn_conv_s8_prepare esp_nn_conv_s8_prepare_esp32p4
+#define esp_nn_conv_s8_run esp_nn_conv_s8_run_esp32p4
 
 #define esp_nn_get_depthwise_conv_scratch_size esp_nn_get_depthwise_conv_scratch_size_esp32p4
 #define esp_nn_set_depthwise_conv_scratch_buf esp_nn_set_depthwise_conv_scratch_buf_esp32p4
@@ -108,7 +244,18 @@ void esp_nn_hard_swish_s8_esp32p4(const int8_t *input, int8_t *output,
                                    const int32_t reluish_mult_exp,
                                    const int32_t output_mult_exp,
                                    const int16_t output_zero_point);
+void esp_nn_hard_swish_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                      const int8_t *input,
+                                      int8_t *output,
+                                      const int32_t size,
+                                      const int16_t input_zero_point,
+                                      const int16_t output_mult_fxp,
+                                      const int16_t reluish_mult_fxp,
+                                      const int32_t reluish_mult_exp,
+                                      const int32_t output_mult_exp,
+                                      const int16_t output_zero_point);
 #define esp_nn_hard_swish_s8 esp_nn_hard_swish_s8_esp32p4
+#define esp_nn_hard_swish_s8_ctx esp_nn_hard_swish_s8_ctx_esp32p4
 #define esp_nn_get_hard_swish_scratch_size() 0
 #define esp_nn_set_hard_swish_scratch_buf(buf)
 
@@ -183,8 +330,55 @@ void esp_nn_fully_connected_per_ch_s8_esp32p4(const int8_t *input_data,
                                         const int32_t *out_mult,
                                         const int32_t activation_min,
                                         const int32_t activation_max);
+
+/**
+ * @brief       run a fully connected layer prepared with esp_nn_fully_connected_s8_prepare
+ *
+ * @note        the prepare step is the generic one, see esp_nn_fully_connected_s8_prepare_ansi
+ */
+void esp_nn_fully_connected_s8_run_esp32p4(const esp_nn_fc_prepared_t *prep,
+                                           const int8_t *input_data,
+                                           int8_t *out_data);
+
+/**
+ * @brief       batched esp_nn_fully_connected_s8_run, see esp_nn_fully_connected_s8_run_batch_ansi
+ */
+void esp_nn_fully_connected_s8_run_batch_esp32p4(const esp_nn_fc_prepared_t *prep,
+                                                 const int32_t batches,
+                                                 const int8_t *input_data,
+                                                 int8_t *out_data);
 #define esp_nn_fully_connected_s8 esp_nn_fully_connected_s8_esp32p4
 #define esp_nn_fully_connected_per_ch_s8 esp_nn_fully_connected_per_ch_s8_esp32p4
+#define esp_nn_get_fully_connected_prepared_size esp_nn_get_fully_connected_prepared_size_ansi
+#define esp_nn_fully_connected_s8_prepare esp_nn_fully_connected_s8_prepare_ansi
+#define esp_nn_fully_connected_per_ch_s8_prepare esp_nn_fully_connected_per_ch_s8_prepare_ansi
+#define esp_nn_fully_connected_s8_run esp_nn_fully_connected_s8_run_esp32p4
+#define esp_nn_fully_connected_s8_run_batch esp_nn_fully_connected_s8_run_batch_esp32p4
+#define esp_nn_get_fully_connected_sparse_size esp_nn_get_fully_connected_sparse_size_ansi
+#define esp_nn_fully_connected_s8_sparse_pack esp_nn_fully_connected_s8_sparse_pack_ansi
+#define esp_nn_fully_connected_per_ch_s8_sparse_pack esp_nn_fully_connected_per_ch_s8_sparse_pack_ansi
+#define esp_nn_fully_connected_s8_sparse_run esp_nn_fully_connected_s8_sparse_run_opt
+
+/* 16x8: the generic optimised versions, no target kernels yet (see README) */
+#define esp_nn_conv_s16 esp_nn_conv_s16_opt
+#define esp_nn_depthwise_conv_s16 esp_nn_depthwise_conv_s16_opt
+#define esp_nn_fully_connected_s16 esp_nn_fully_connected_s16_opt
+
+/* int4 weights: the generic optimised versions, no target kernels yet (see README) */
+#define esp_nn_conv_s4 esp_nn_conv_s4_opt
+#define esp_nn_fully_connected_per_ch_s4 esp_nn_fully_connected_per_ch_s4_opt
+
+#define esp_nn_get_transpose_conv_scratch_size esp_nn_get_transpose_conv_scratch_size_esp32p4
+#define esp_nn_transpose_conv_s8 esp_nn_transpose_conv_s8_esp32p4
+#define esp_nn_get_transpose_conv_prepared_size esp_nn_get_transpose_conv_prepared_size_esp32p4
+#define esp_nn_transpose_conv_s8_prepare esp_nn_transpose_conv_s8_prepare_esp32p4
+#define esp_nn_transpose_conv_s8_run esp_nn_transpose_conv_s8_run_esp32p4
+
+#define esp_nn_get_batch_matmul_scratch_size esp_nn_get_batch_matmul_scratch_size_esp32p4
+#define esp_nn_batch_matmul_s8 esp_nn_batch_matmul_s8_esp32p4
+
+#define esp_nn_get_lstm_scratch_size esp_nn_get_lstm_scratch_size_esp32p4
+#define esp_nn_lstm_s8 esp_nn_lstm_s8_esp32p4
 
 int32_t esp_nn_get_softmax_scratch_size_esp32p4(const int32_t width, const int32_t height);
 void esp_nn_set_softmax_scratch_buf_esp32p4(void *buffer);
@@ -195,10 +389,26 @@ void esp_nn_softmax_s8_esp32p4(const int8_t *input_data,
                                 const int32_t shift,
                                 const int32_t diff_min,
                                 int8_t *output_data);
+void esp_nn_softmax_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                   const int8_t *input_data,
+                                   const int32_t height,
+                                   const int32_t width,
+                                   const int32_t mult,
+                                   const int32_t shift,
+                                   const int32_t diff_min,
+                                   int8_t *output_data);
 #define esp_nn_get_softmax_scratch_size esp_nn_get_softmax_scratch_size_esp32p4
 #define esp_nn_set_softmax_scratch_buf esp_nn_set_softmax_scratch_buf_esp32p4
 #define esp_nn_softmax_s8 esp_nn_softmax_s8_esp32p4
+#define esp_nn_softmax_s8_ctx esp_nn_softmax_s8_ctx_esp32p4
 
 #define esp_nn_get_logistic_s8_scratch_size esp_nn_get_logistic_s8_scratch_size_ansi
 #define esp_nn_logistic_s8_prepare esp_nn_logistic_s8_prepare_ansi
 #define esp_nn_logistic_s8 esp_nn_logistic_s8_ansi
+
+#define esp_nn_get_logistic_s16_scratch_size esp_nn_get_logistic_s16_scratch_size_ansi
+#define esp_nn_logistic_s16_prepare esp_nn_logistic_s16_prepare_ansi
+#define esp_nn_logistic_s16 esp_nn_logistic_s16_ansi
+#define esp_nn_get_tanh_s16_scratch_size esp_nn_get_tanh_s16_scratch_size_ansi
+#define esp_nn_tanh_s16_prepare esp_nn_tanh_s16_prepare_ansi
+#define esp_nn_tanh_s16 esp_nn_tanh_s16_ansi
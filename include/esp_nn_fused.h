@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fused depthwise -> pointwise blocks, optionally with a pointwise expansion
+ * ahead (the MobileNet v2 inverted residual).
+ *
+ * The block runs a few depthwise output rows at a time into a tile in
+ * scratch and projects them with the 1x1 conv right away: the intermediate
+ * tensors are never stored whole. Every stage is the regular (dispatched)
+ * kernel, so the output is bit exact with running the layers one by one.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   a 1x1, stride 1, unpadded conv stage of a fused block
+ */
+typedef struct esp_nn_fused_pw {
+    data_dims_t filter_dims;
+    const int8_t *filter;
+    const int32_t *bias;
+    data_dims_t output_dims;
+    conv_params_t params;
+    quant_data_t quant_data;
+} esp_nn_fused_pw_t;
+
+/**
+ * @brief   the depthwise stage of a fused block
+ */
+typedef struct esp_nn_fused_dw {
+    data_dims_t filter_dims;
+    const int8_t *filter;
+    const int32_t *bias;
+    data_dims_t output_dims;
+    dw_conv_params_t params;
+    quant_data_t quant_data;
+} esp_nn_fused_dw_t;
+
+/**
+ * @brief   scratch of esp_nn_dw_pw_conv_s8: the tiles and the largest scratch of the stages
+ */
+int32_t esp_nn_get_dw_pw_conv_scratch_size(const data_dims_t *input_dims,
+                                           const esp_nn_fused_pw_t *expand,
+                                           const esp_nn_fused_dw_t *dw,
+                                           const esp_nn_fused_pw_t *project,
+                                           const int32_t tile_rows);
+
+/**
+ * @brief   depthwise conv then 1x1 projection, `tile_rows` depthwise output rows at a time
+ *
+ * @param   expand      1x1 conv run on the input first, NULL for none
+ *
+ * @note    Input rows the depthwise windows of two tiles share are
+ *          expanded for both. A residual add stays a separate
+ *          esp_nn_add_elementwise_s8 call.
+ *
+ * @return  0 on success, -1 if a pointwise stage is not 1x1 stride 1 unpadded
+ */
+int esp_nn_dw_pw_conv_s8(const esp_nn_ctx_t *ctx,
+                         const data_dims_t *input_dims,
+                         const int8_t *input_data,
+                         const esp_nn_fused_pw_t *expand,
+                         const esp_nn_fused_dw_t *dw,
+                         const esp_nn_fused_pw_t *project,
+                         const int32_t tile_rows,
+                         int8_t *out_data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Tile mover: copies of input tiles into scratch, started ahead of use.
+ *
+ * Tiled kernels (the ESP32-S3 general conv strips and 3x3 depthwise rows,
+ * the ESP32-P4 tiled conv) keep two tile buffers: they start staging the
+ * input rows of the next tile through the mover of their context, compute
+ * on the current one, and wait for the copies only when they move on. With
+ * a DMA backend, reads of tensors in PSRAM overlap with the MACs. Without a
+ * mover, tiles are copied with memcpy when they are started.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+
+/**
+ * @brief   backend copying the tiles
+ *
+ * @note    `start_copy` returns a ticket, increasing with every copy.
+ *          `wait` returns once the copy of `ticket` and all the ones started
+ *          before it are done. Kernels never wait for a negative ticket.
+ */
+typedef struct esp_nn_tile_mover {
+    int32_t (*start_copy)(void *impl, void *dst, const void *src, int32_t size);
+    void (*wait)(void *impl, int32_t ticket);
+    void *impl;
+} esp_nn_tile_mover_t;
+
+/************************** Backends ********************************/
+
+/**
+ * @brief   memcpy backend: copies are queued and run by the wait covering them
+ *
+ * @note    Nothing overlaps, but a kernel reading a tile it has not waited
+ *          for gets stale data, as it would with DMA: use it to test tiled
+ *          kernels on a host.
+ *
+ * @return  0 on success, -1 if the queue can't be allocated
+ */
+int esp_nn_tile_mover_memcpy_init(esp_nn_tile_mover_t *mover);
+void esp_nn_tile_mover_memcpy_deinit(esp_nn_tile_mover_t *mover);
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Activation arena planner for a sequence of esp-nn ops.
+ *
+ * The ops of a model are described once, in run order, with the tensors
+ * they read and write. The planner lays all of those tensors out in one
+ * arena: a tensor only occupies its bytes from the op writing it to the
+ * last op reading it, after which later tensors reuse them. The scratch of
+ * all ops is one shared region, as large as the largest
+ * esp_nn_get_*_scratch_size of the ops. Every offset is 16 byte aligned,
+ * as the ESP32-S3 and ESP32-P4 kernels need.
+ *
+ * Tensors read but never written are the model inputs, live from the first
+ * op. Tensors written but never read are its outputs, live to the last.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+#include "esp_nn_profile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_NN_PLAN_MAX_INPUTS  2
+
+/**
+ * @brief   one op of the sequence
+ *
+ * @note    Dims follow esp_nn_profile_event_t: ops without spatial dims
+ *          use width for the element count, fully connected takes
+ *          (row_len, 1, 1) in and (1, 1, out_ch) out. Tensor bytes are
+ *          width x height x channels of the dims they appear with.
+ *          The second input of ESP_NN_OP_MUL_BROADCAST is `channels` bytes,
+ *          that of ESP_NN_OP_ADD / ESP_NN_OP_MUL the size of the first.
+ */
+typedef struct esp_nn_plan_op {
+    esp_nn_op_t op;
+    data_dims_t input_dims;
+    data_dims_t filter_dims;
+    data_dims_t output_dims;
+    const void *params;         // conv_params_t for ESP_NN_OP_CONV,
+                                // dw_conv_params_t for ESP_NN_OP_DEPTHWISE_CONV, else unused
+    int16_t inputs[ESP_NN_PLAN_MAX_INPUTS];     // tensors read, -1 if unused
+    int16_t output;             // tensor written
+} esp_nn_plan_op_t;
+
+typedef struct esp_nn_plan {
+    int32_t arena_size;         // bytes of the arena, 16 byte aligned itself
+    int32_t scratch_offset;     // shared scratch region, pass arena + scratch_offset
+    int32_t scratch_size;       //  as the scratch of every op's context
+    int32_t tensors_size;       // bytes tensors would take in separate buffers
+} esp_nn_plan_t;
+
+/**
+ * @brief   lay out the tensors `0 .. num_tensors - 1` of `ops` in one arena
+ *
+ * @param   tensor_offsets  `num_tensors` offsets into the arena, filled in.
+ *                          -1 for tensors no op uses
+ *
+ * @return  0 on success, -1 if a tensor id is out of range, a tensor is
+ *          written twice or no memory is left for planning
+ */
+int esp_nn_plan_arena(const esp_nn_plan_op_t *ops, const int32_t num_ops,
+                      const int32_t num_tensors, esp_nn_plan_t *plan,
+                      int32_t *tensor_offsets);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per call profiling hooks.
+ *
+ * With `NN_PROFILING` enabled in menuconfig (ESP_NN_PROFILING defined), the
+ * `esp_nn_*` kernels called through esp_nn.h invoke the registered begin and
+ * end hooks around every call. The hooks get the op, its dims, MAC count and
+ * a timestamp: enough to build per layer flame graphs of a deployed model or
+ * to compare achieved MACs/cycle with the SIMD peak. Without it, the calls
+ * go straight to the kernels.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(ESP_NN_PROFILING) || defined(CONFIG_NN_PROFILING)
+#define ESP_NN_PROFILING_ENABLED    1
+#else
+#define ESP_NN_PROFILING_ENABLED    0
+#endif
+
+typedef enum {
+    ESP_NN_OP_ADD = 0,
+    ESP_NN_OP_MUL,
+    ESP_NN_OP_MUL_BROADCAST,
+    ESP_NN_OP_CONV,
+    ESP_NN_OP_DEPTHWISE_CONV,
+    ESP_NN_OP_FULLY_CONNECTED,
+    ESP_NN_OP_AVG_POOL,
+    ESP_NN_OP_MAX_POOL,
+    ESP_NN_OP_RELU6,
+    ESP_NN_OP_HARD_SWISH,
+    ESP_NN_OP_MEAN,
+    ESP_NN_OP_SOFTMAX,
+    ESP_NN_OP_LOGISTIC,
+
+    ESP_NN_OP_MAX,
+} esp_nn_op_t;
+
+/**
+ * @brief   one kernel call, as passed to the hooks
+ *
+ * @note    Ops without spatial dims use width for the element count, e.g.
+ *          `size` of elementwise ops. Fully connected: input width is the
+ *          row length, filter width x height is row length x out channels.
+ *          Dims an op doesn't have are zero.
+ */
+typedef struct esp_nn_profile_event {
+    esp_nn_op_t op;
+    data_dims_t input_dims;
+    data_dims_t filter_dims;
+    data_dims_t output_dims;
+    int64_t macs;               // multiply-accumulates; elements or window reads for the others
+    uint32_t timestamp;         // esp_nn_profile_timestamp() at begin, resp. end of the call
+} esp_nn_profile_event_t;
+
+typedef void (*esp_nn_profile_hook_t)(const esp_nn_profile_event_t *event, void *user_data);
+
+/**
+ * @brief   register hooks called before and after every kernel call
+ *
+ * @note    Either hook may be NULL, NULL for both unregisters. Hooks run on
+ *          the calling task, concurrently if kernels run on several cores.
+ *
+ * @return  0 on success, -1 if profiling is compiled out
+ */
+int esp_nn_profile_register(esp_nn_profile_hook_t begin, esp_nn_profile_hook_t end,
+                            void *user_data);
+
+/**
+ * @brief   op name, e.g. "conv_s8"
+ */
+const char *esp_nn_op_name(const esp_nn_op_t op);
+
+/**
+ * @brief   CPU cycle count on chip, nanoseconds on a host build (wraps at 2^32)
+ */
+uint32_t esp_nn_profile_timestamp(void);
+
+/* called by the wrappers of esp_nn_profile_ops.h */
+void esp_nn_profile_begin(esp_nn_profile_event_t *event);
+void esp_nn_profile_end(esp_nn_profile_event_t *event);
+
+#ifdef __cplusplus
+}
+#endif
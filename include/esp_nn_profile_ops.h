@@ -0,0 +1,518 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Profiled `esp_nn_*` entry points, see esp_nn_profile.h.
+ *
+ * Included by esp_nn.h after the target mapping: each wrapper is expanded
+ * while `esp_nn_x` still names the selected kernel, then `esp_nn_x` is
+ * remapped to the wrapper. Nothing here is compiled without profiling.
+ */
+
+#pragma once
+
+#include "esp_nn_profile.h"
+
+#if ESP_NN_PROFILING_ENABLED
+
+#define ESP_NN_PROFILED_CALL(op, in, filter, out, macs, call) do {      \
+    esp_nn_profile_event_t _event = {(op), (in), (filter), (out), (macs), 0}; \
+    esp_nn_profile_begin(&_event);                                      \
+    call;                                                               \
+    esp_nn_profile_end(&_event);                                        \
+} while (0)
+
+static inline data_dims_t esp_nn_profile_dims(const int32_t width, const int32_t height,
+                                              const int32_t channels)
+{
+    data_dims_t dims = {width, height, channels, 1};
+    return dims;
+}
+
+static inline int64_t esp_nn_profile_conv_macs(const data_dims_t *filter_dims,
+                                               const data_dims_t *output_dims,
+                                               const int32_t filter_ch)
+{
+    return (int64_t) output_dims->width * output_dims->height * output_dims->channels *
+           filter_dims->width * filter_dims->height * filter_ch;
+}
+
+static inline int64_t esp_nn_profile_pool_macs(const uint16_t output_wd, const uint16_t output_ht,
+                                               const uint16_t filter_wd, const uint16_t filter_ht,
+                                               const uint16_t channels)
+{
+    return (int64_t) output_wd * output_ht * filter_wd * filter_ht * channels;
+}
+
+/****************************** basic math ******************************/
+
+static inline void esp_nn_add_elementwise_s8_profiled(const int8_t *input1_data,
+                                                      const int8_t *input2_data,
+                                                      const int32_t input1_offset,
+                                                      const int32_t input2_offset,
+                                                      const int32_t input1_mult,
+                                                      const int32_t input2_mult,
+                                                      const int32_t input1_shift,
+                                                      const int32_t input2_shift,
+                                                      const int32_t left_shift,
+                                                      int8_t *output,
+                                                      const int32_t out_offset,
+                                                      const int32_t out_mult,
+                                                      const int32_t out_shift,
+                                                      const int32_t activation_min,
+                                                      const int32_t activation_max,
+                                                      const int32_t size)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_ADD, esp_nn_profile_dims(size, 1, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(size, 1, 1), size,
+                         esp_nn_add_elementwise_s8(input1_data, input2_data, input1_offset,
+                                                   input2_offset, input1_mult, input2_mult,
+                                                   input1_shift, input2_shift, left_shift,
+                                                   output, out_offset, out_mult, out_shift,
+                                                   activation_min, activation_max, size));
+}
+#undef esp_nn_add_elementwise_s8
+#define esp_nn_add_elementwise_s8 esp_nn_add_elementwise_s8_profiled
+
+static inline void esp_nn_mul_elementwise_s8_profiled(const int8_t *input1_data,
+                                                      const int8_t *input2_data,
+                                                      const int32_t input1_offset,
+                                                      const int32_t input2_offset,
+                                                      int8_t *output,
+                                                      const int32_t out_offset,
+                                                      const int32_t out_mult,
+                                                      const int32_t out_shift,
+                                                      const int32_t activation_min,
+                                                      const int32_t activation_max,
+                                                      const int32_t size)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_MUL, esp_nn_profile_dims(size, 1, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(size, 1, 1), size,
+                         esp_nn_mul_elementwise_s8(input1_data, input2_data, input1_offset,
+                                                   input2_offset, output, out_offset, out_mult,
+                                                   out_shift, activation_min, activation_max,
+                                                   size));
+}
+#undef esp_nn_mul_elementwise_s8
+#define esp_nn_mul_elementwise_s8 esp_nn_mul_elementwise_s8_profiled
+
+static inline void esp_nn_mul_broadcast_channel_s8_profiled(const int8_t *input1,
+                                                            const int8_t *input2_per_ch,
+                                                            const int32_t input1_offset,
+                                                            const int32_t input2_offset,
+                                                            int8_t *output,
+                                                            const int32_t output_offset,
+                                                            const int32_t output_mult,
+                                                            const int32_t output_shift,
+                                                            const int32_t activation_min,
+                                                            const int32_t activation_max,
+                                                            const int32_t total_spatial,
+                                                            const int32_t channels)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_MUL_BROADCAST, esp_nn_profile_dims(total_spatial, 1, channels),
+                         esp_nn_profile_dims(0, 0, 0),
+                         esp_nn_profile_dims(total_spatial, 1, channels),
+                         (int64_t) total_spatial * channels,
+                         esp_nn_mul_broadcast_channel_s8(input1, input2_per_ch, input1_offset,
+                                                         input2_offset, output, output_offset,
+                                                         output_mult, output_shift,
+                                                         activation_min, activation_max,
+                                                         total_spatial, channels));
+}
+#undef esp_nn_mul_broadcast_channel_s8
+#define esp_nn_mul_broadcast_channel_s8 esp_nn_mul_broadcast_channel_s8_profiled
+
+/****************************** convolution ******************************/
+
+static inline void esp_nn_conv_s8_profiled(const data_dims_t *input_dims,
+                                           const int8_t *input_data,
+                                           const data_dims_t *filter_dims,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           const data_dims_t *output_dims,
+                                           int8_t *out_data,
+                                           const conv_params_t *conv_params,
+                                           const quant_data_t *quant_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_CONV, *input_dims, *filter_dims, *output_dims,
+                         esp_nn_profile_conv_macs(filter_dims, output_dims, filter_dims->channels),
+                         esp_nn_conv_s8(input_dims, input_data, filter_dims, filter_data, bias,
+                                        output_dims, out_data, conv_params, quant_data));
+}
+#undef esp_nn_conv_s8
+#define esp_nn_conv_s8 esp_nn_conv_s8_profiled
+
+static inline void esp_nn_conv_s8_ctx_profiled(const esp_nn_ctx_t *ctx,
+                                               const data_dims_t *input_dims,
+                                               const int8_t *input_data,
+                                               const data_dims_t *filter_dims,
+                                               const int8_t *filter_data,
+                                               const int32_t *bias,
+                                               const data_dims_t *output_dims,
+                                               int8_t *out_data,
+                                               const conv_params_t *conv_params,
+                                               const quant_data_t *quant_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_CONV, *input_dims, *filter_dims, *output_dims,
+                         esp_nn_profile_conv_macs(filter_dims, output_dims, filter_dims->channels),
+                         esp_nn_conv_s8_ctx(ctx, input_dims, input_data, filter_dims, filter_data,
+                                            bias, output_dims, out_data, conv_params,
+                                            quant_data));
+}
+#undef esp_nn_conv_s8_ctx
+#define esp_nn_conv_s8_ctx esp_nn_conv_s8_ctx_profiled
+
+static inline void esp_nn_conv_s8_plan_profiled(const esp_nn_ctx_t *ctx,
+                                                const data_dims_t *input_dims,
+                                                const int8_t *input_data,
+                                                const data_dims_t *filter_dims,
+                                                const int8_t *filter_data,
+                                                const int32_t *bias,
+                                                const data_dims_t *output_dims,
+                                                int8_t *out_data,
+                                                const conv_params_t *conv_params,
+                                                const quant_plan_data_t *quant_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_CONV, *input_dims, *filter_dims, *output_dims,
+                         esp_nn_profile_conv_macs(filter_dims, output_dims, filter_dims->channels),
+                         esp_nn_conv_s8_plan(ctx, input_dims, input_data, filter_dims, filter_data,
+                                             bias, output_dims, out_data, conv_params,
+                                             quant_data));
+}
+#undef esp_nn_conv_s8_plan
+#define esp_nn_conv_s8_plan esp_nn_conv_s8_plan_profiled
+
+static inline void esp_nn_conv_s8_run_profiled(const esp_nn_ctx_t *ctx,
+                                               const esp_nn_conv_prepared_t *prep,
+                                               const int8_t *input_data,
+                                               int8_t *out_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_CONV, prep->input_dims, prep->filter_dims, prep->output_dims,
+                         esp_nn_profile_conv_macs(&prep->filter_dims, &prep->output_dims,
+                                                  prep->filter_dims.channels),
+                         esp_nn_conv_s8_run(ctx, prep, input_data, out_data));
+}
+#undef esp_nn_conv_s8_run
+#define esp_nn_conv_s8_run esp_nn_conv_s8_run_profiled
+
+static inline void esp_nn_depthwise_conv_s8_profiled(const data_dims_t *input_dims,
+                                                     const int8_t *input_data,
+                                                     const data_dims_t *filter_dims,
+                                                     const int8_t *filter_data,
+                                                     const int32_t *bias,
+                                                     const data_dims_t *output_dims,
+                                                     int8_t *out_data,
+                                                     const dw_conv_params_t *conv_params,
+                                                     const quant_data_t *quant_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_DEPTHWISE_CONV, *input_dims, *filter_dims, *output_dims,
+                         esp_nn_profile_conv_macs(filter_dims, output_dims, 1),
+                         esp_nn_depthwise_conv_s8(input_dims, input_data, filter_dims,
+                                                  filter_data, bias, output_dims, out_data,
+                                                  conv_params, quant_data));
+}
+#undef esp_nn_depthwise_conv_s8
+#define esp_nn_depthwise_conv_s8 esp_nn_depthwise_conv_s8_profiled
+
+static inline void esp_nn_depthwise_conv_s8_ctx_profiled(const esp_nn_ctx_t *ctx,
+                                                         const data_dims_t *input_dims,
+                                                         const int8_t *input_data,
+                                                         const data_dims_t *filter_dims,
+                                                         const int8_t *filter_data,
+                                                         const int32_t *bias,
+                                                         const data_dims_t *output_dims,
+                                                         int8_t *out_data,
+                                                         const dw_conv_params_t *conv_params,
+                                                         const quant_data_t *quant_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_DEPTHWISE_CONV, *input_dims, *filter_dims, *output_dims,
+                         esp_nn_profile_conv_macs(filter_dims, output_dims, 1),
+                         esp_nn_depthwise_conv_s8_ctx(ctx, input_dims, input_data, filter_dims,
+                                                      filter_data, bias, output_dims, out_data,
+                                                      conv_params, quant_data));
+}
+#undef esp_nn_depthwise_conv_s8_ctx
+#define esp_nn_depthwise_conv_s8_ctx esp_nn_depthwise_conv_s8_ctx_profiled
+
+static inline void esp_nn_depthwise_conv_s8_plan_profiled(const esp_nn_ctx_t *ctx,
+                                                          const data_dims_t *input_dims,
+                                                          const int8_t *input_data,
+                                                          const data_dims_t *filter_dims,
+                                                          const int8_t *filter_data,
+                                                          const int32_t *bias,
+                                                          const data_dims_t *output_dims,
+                                                          int8_t *out_data,
+                                                          const dw_conv_params_t *conv_params,
+                                                          const quant_plan_data_t *quant_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_DEPTHWISE_CONV, *input_dims, *filter_dims, *output_dims,
+                         esp_nn_profile_conv_macs(filter_dims, output_dims, 1),
+                         esp_nn_depthwise_conv_s8_plan(ctx, input_dims, input_data, filter_dims,
+                                                       filter_data, bias, output_dims, out_data,
+                                                       conv_params, quant_data));
+}
+#undef esp_nn_depthwise_conv_s8_plan
+#define esp_nn_depthwise_conv_s8_plan esp_nn_depthwise_conv_s8_plan_profiled
+
+/************************** fully connected ******************************/
+
+static inline void esp_nn_fully_connected_s8_profiled(const int8_t *input_data,
+                                                      const int32_t input_offset,
+                                                      const uint16_t row_len,
+                                                      const int8_t *filter_data,
+                                                      const int32_t filter_offset,
+                                                      const int32_t *bias,
+                                                      int8_t *out_data,
+                                                      const uint16_t out_channels,
+                                                      const int32_t out_offset,
+                                                      const int32_t out_shift,
+                                                      const int32_t out_mult,
+                                                      const int32_t activation_min,
+                                                      const int32_t activation_max)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_FULLY_CONNECTED, esp_nn_profile_dims(row_len, 1, 1),
+                         esp_nn_profile_dims(row_len, out_channels, 1),
+                         esp_nn_profile_dims(1, 1, out_channels),
+                         (int64_t) row_len * out_channels,
+                         esp_nn_fully_connected_s8(input_data, input_offset, row_len, filter_data,
+                                                   filter_offset, bias, out_data, out_channels,
+                                                   out_offset, out_shift, out_mult,
+                                                   activation_min, activation_max));
+}
+#undef esp_nn_fully_connected_s8
+#define esp_nn_fully_connected_s8 esp_nn_fully_connected_s8_profiled
+
+static inline void esp_nn_fully_connected_per_ch_s8_profiled(const int8_t *input_data,
+                                                             const int32_t input_offset,
+                                                             const uint16_t row_len,
+                                                             const int8_t *filter_data,
+                                                             const int32_t filter_offset,
+                                                             const int32_t *bias,
+                                                             int8_t *out_data,
+                                                             const uint16_t out_channels,
+                                                             const int32_t out_offset,
+                                                             const int32_t *out_shift,
+                                                             const int32_t *out_mult,
+                                                             const int32_t activation_min,
+                                                             const int32_t activation_max)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_FULLY_CONNECTED, esp_nn_profile_dims(row_len, 1, 1),
+                         esp_nn_profile_dims(row_len, out_channels, 1),
+                         esp_nn_profile_dims(1, 1, out_channels),
+                         (int64_t) row_len * out_channels,
+                         esp_nn_fully_connected_per_ch_s8(input_data, input_offset, row_len,
+                                                          filter_data, filter_offset, bias,
+                                                          out_data, out_channels, out_offset,
+                                                          out_shift, out_mult,
+                                                          activation_min, activation_max));
+}
+#undef esp_nn_fully_connected_per_ch_s8
+#define esp_nn_fully_connected_per_ch_s8 esp_nn_fully_connected_per_ch_s8_profiled
+
+static inline void esp_nn_fully_connected_s8_run_profiled(const esp_nn_fc_prepared_t *prep,
+                                                          const int8_t *input_data,
+                                                          int8_t *out_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_FULLY_CONNECTED, esp_nn_profile_dims(prep->row_len, 1, 1),
+                         esp_nn_profile_dims(prep->row_len, prep->out_channels, 1),
+                         esp_nn_profile_dims(1, 1, prep->out_channels),
+                         (int64_t) prep->row_len * prep->out_channels,
+                         esp_nn_fully_connected_s8_run(prep, input_data, out_data));
+}
+#undef esp_nn_fully_connected_s8_run
+#define esp_nn_fully_connected_s8_run esp_nn_fully_connected_s8_run_profiled
+
+static inline void esp_nn_fully_connected_s8_run_batch_profiled(const esp_nn_fc_prepared_t *prep,
+                                                                const int32_t batches,
+                                                                const int8_t *input_data,
+                                                                int8_t *out_data)
+{
+    data_dims_t input_dims = esp_nn_profile_dims(prep->row_len, 1, 1);
+    data_dims_t output_dims = esp_nn_profile_dims(1, 1, prep->out_channels);
+    input_dims.extra = batches;
+    output_dims.extra = batches;
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_FULLY_CONNECTED, input_dims,
+                         esp_nn_profile_dims(prep->row_len, prep->out_channels, 1), output_dims,
+                         (int64_t) prep->row_len * prep->out_channels * batches,
+                         esp_nn_fully_connected_s8_run_batch(prep, batches, input_data, out_data));
+}
+#undef esp_nn_fully_connected_s8_run_batch
+#define esp_nn_fully_connected_s8_run_batch esp_nn_fully_connected_s8_run_batch_profiled
+
+/****************************** pooling ******************************/
+
+static inline void esp_nn_avg_pool_s8_profiled(const int8_t *input,
+                                               const uint16_t input_wd,
+                                               const uint16_t input_ht,
+                                               int8_t *output,
+                                               const uint16_t output_wd,
+                                               const uint16_t output_ht,
+                                               const uint16_t stride_wd,
+                                               const uint16_t stride_ht,
+                                               const uint16_t filter_wd,
+                                               const uint16_t filter_ht,
+                                               const uint16_t pad_wd,
+                                               const uint16_t pad_ht,
+                                               const int32_t activation_min,
+                                               const int32_t activation_max,
+                                               const uint16_t channels)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_AVG_POOL, esp_nn_profile_dims(input_wd, input_ht, channels),
+                         esp_nn_profile_dims(filter_wd, filter_ht, 1),
+                         esp_nn_profile_dims(output_wd, output_ht, channels),
+                         esp_nn_profile_pool_macs(output_wd, output_ht, filter_wd, filter_ht,
+                                                  channels),
+                         esp_nn_avg_pool_s8(input, input_wd, input_ht, output, output_wd,
+                                            output_ht, stride_wd, stride_ht, filter_wd,
+                                            filter_ht, pad_wd, pad_ht, activation_min,
+                                            activation_max, channels));
+}
+#undef esp_nn_avg_pool_s8
+#define esp_nn_avg_pool_s8 esp_nn_avg_pool_s8_profiled
+
+static inline void esp_nn_max_pool_s8_profiled(const int8_t *input,
+                                               const uint16_t input_wd,
+                                               const uint16_t input_ht,
+                                               int8_t *output,
+                                               const uint16_t output_wd,
+                                               const uint16_t output_ht,
+                                               const uint16_t stride_wd,
+                                               const uint16_t stride_ht,
+                                               const uint16_t filter_wd,
+                                               const uint16_t filter_ht,
+                                               const uint16_t pad_wd,
+                                               const uint16_t pad_ht,
+                                               const int32_t activation_min,
+                                               const int32_t activation_max,
+                                               const uint16_t channels)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_MAX_POOL, esp_nn_profile_dims(input_wd, input_ht, channels),
+                         esp_nn_profile_dims(filter_wd, filter_ht, 1),
+                         esp_nn_profile_dims(output_wd, output_ht, channels),
+                         esp_nn_profile_pool_macs(output_wd, output_ht, filter_wd, filter_ht,
+                                                  channels),
+                         esp_nn_max_pool_s8(input, input_wd, input_ht, output, output_wd,
+                                            output_ht, stride_wd, stride_ht, filter_wd,
+                                            filter_ht, pad_wd, pad_ht, activation_min,
+                                            activation_max, channels));
+}
+#undef esp_nn_max_pool_s8
+#define esp_nn_max_pool_s8 esp_nn_max_pool_s8_profiled
+
+/****************************** activations / others ******************************/
+
+static inline void esp_nn_relu6_s8_profiled(int8_t *data, uint16_t size)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_RELU6, esp_nn_profile_dims(size, 1, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(size, 1, 1), size,
+                         esp_nn_relu6_s8(data, size));
+}
+#undef esp_nn_relu6_s8
+#define esp_nn_relu6_s8 esp_nn_relu6_s8_profiled
+
+static inline void esp_nn_hard_swish_s8_profiled(const int8_t *input, int8_t *output,
+                                                 const int32_t size,
+                                                 const int16_t input_zero_point,
+                                                 const int16_t output_mult_fxp,
+                                                 const int16_t reluish_mult_fxp,
+                                                 const int32_t reluish_mult_exp,
+                                                 const int32_t output_mult_exp,
+                                                 const int16_t output_zero_point)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_HARD_SWISH, esp_nn_profile_dims(size, 1, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(size, 1, 1), size,
+                         esp_nn_hard_swish_s8(input, output, size, input_zero_point,
+                                              output_mult_fxp, reluish_mult_fxp,
+                                              reluish_mult_exp, output_mult_exp,
+                                              output_zero_point));
+}
+#undef esp_nn_hard_swish_s8
+#define esp_nn_hard_swish_s8 esp_nn_hard_swish_s8_profiled
+
+static inline void esp_nn_hard_swish_s8_ctx_profiled(const esp_nn_ctx_t *ctx,
+                                                     const int8_t *input, int8_t *output,
+                                                     const int32_t size,
+                                                     const int16_t input_zero_point,
+                                                     const int16_t output_mult_fxp,
+                                                     const int16_t reluish_mult_fxp,
+                                                     const int32_t reluish_mult_exp,
+                                                     const int32_t output_mult_exp,
+                                                     const int16_t output_zero_point)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_HARD_SWISH, esp_nn_profile_dims(size, 1, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(size, 1, 1), size,
+                         esp_nn_hard_swish_s8_ctx(ctx, input, output, size, input_zero_point,
+                                                  output_mult_fxp, reluish_mult_fxp,
+                                                  reluish_mult_exp, output_mult_exp,
+                                                  output_zero_point));
+}
+#undef esp_nn_hard_swish_s8_ctx
+#define esp_nn_hard_swish_s8_ctx esp_nn_hard_swish_s8_ctx_profiled
+
+static inline void esp_nn_mean_nhwc_s8_profiled(const int8_t *input, int8_t *output,
+                                                const int32_t height, const int32_t width,
+                                                const int32_t channels,
+                                                const int32_t input_zero_point,
+                                                const int32_t output_zero_point,
+                                                const int32_t multiplier,
+                                                const int32_t shift)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_MEAN, esp_nn_profile_dims(width, height, channels),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(1, 1, channels),
+                         (int64_t) width * height * channels,
+                         esp_nn_mean_nhwc_s8(input, output, height, width, channels,
+                                             input_zero_point, output_zero_point,
+                                             multiplier, shift));
+}
+#undef esp_nn_mean_nhwc_s8
+#define esp_nn_mean_nhwc_s8 esp_nn_mean_nhwc_s8_profiled
+
+static inline void esp_nn_softmax_s8_profiled(const int8_t *input_data,
+                                              const int32_t height,
+                                              const int32_t width,
+                                              const int32_t mult,
+                                              const int32_t shift,
+                                              const int32_t diff_min,
+                                              int8_t *output_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_SOFTMAX, esp_nn_profile_dims(width, height, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(width, height, 1),
+                         (int64_t) width * height,
+                         esp_nn_softmax_s8(input_data, height, width, mult, shift, diff_min,
+                                           output_data));
+}
+#undef esp_nn_softmax_s8
+#define esp_nn_softmax_s8 esp_nn_softmax_s8_profiled
+
+static inline void esp_nn_softmax_s8_ctx_profiled(const esp_nn_ctx_t *ctx,
+                                                  const int8_t *input_data,
+                                                  const int32_t height,
+                                                  const int32_t width,
+                                                  const int32_t mult,
+                                                  const int32_t shift,
+                                                  const int32_t diff_min,
+                                                  int8_t *output_data)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_SOFTMAX, esp_nn_profile_dims(width, height, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(width, height, 1),
+                         (int64_t) width * height,
+                         esp_nn_softmax_s8_ctx(ctx, input_data, height, width, mult, shift,
+                                               diff_min, output_data));
+}
+#undef esp_nn_softmax_s8_ctx
+#define esp_nn_softmax_s8_ctx esp_nn_softmax_s8_ctx_profiled
+
+static inline void esp_nn_logistic_s8_profiled(const int8_t *input, int8_t *output,
+                                               int32_t size, const int8_t *scratch_buf)
+{
+    ESP_NN_PROFILED_CALL(ESP_NN_OP_LOGISTIC, esp_nn_profile_dims(size, 1, 1),
+                         esp_nn_profile_dims(0, 0, 0), esp_nn_profile_dims(size, 1, 1), size,
+                         esp_nn_logistic_s8(input, output, size, scratch_buf));
+}
+#undef esp_nn_logistic_s8
+#define esp_nn_logistic_s8 esp_nn_logistic_s8_profiled
+
+#endif // ESP_NN_PROFILING_ENABLED
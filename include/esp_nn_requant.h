@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Requantisation plans.
+ *
+ * Every output value is requantised with the mult / shift of its channel:
+ * split into a left and a right shift, multiplied, rounded. A plan does the
+ * split once per layer, along with the rounding mask of the right shift, so
+ * the per value work is table driven and branch free. Set it as `plan` of
+ * the layer's quant_plan_data_t and run the `_plan` variants of conv and
+ * depthwise conv. Prepared conv and fully connected layers build their own.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   bytes of the plan of a layer with `channels` output channels
+ */
+static inline int32_t esp_nn_get_requant_plan_size(const int32_t channels)
+{
+    return channels * (int32_t) sizeof(esp_nn_requant_t);
+}
+
+/**
+ * @brief   plan entry of one channel
+ *
+ * @note    `mult` must not be INT32_MIN, which no quantized multiplier is
+ *          (they are below 1 << 31)
+ */
+static inline esp_nn_requant_t esp_nn_requant_entry(const int32_t mult, const int32_t shift)
+{
+    const int32_t left_shift = shift > 0 ? shift : 0;
+    const int32_t right_shift = shift > 0 ? 0 : -shift;
+    const esp_nn_requant_t entry = {
+        .mult = mult,
+        .left_shift = left_shift,
+        .right_shift = right_shift,
+        .round_mask = (int32_t) ((1u << right_shift) - 1),
+    };
+    return entry;
+}
+
+/**
+ * @brief   split the mult / shift of `channels` output channels into `plan`
+ *
+ * @param   plan    esp_nn_get_requant_plan_size bytes
+ *
+ * @return  `plan`, to be set as `plan` of a quant_plan_data_t
+ */
+static inline const esp_nn_requant_t *esp_nn_requant_plan_init(esp_nn_requant_t *plan,
+                                                               const quant_data_t *quant_data,
+                                                               const int32_t channels)
+{
+    for (int32_t ch = 0; ch < channels; ch++) {
+        plan[ch] = esp_nn_requant_entry(quant_data->mult[ch], quant_data->shift[ch]);
+    }
+    return plan;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Packed int4 weights.
+ *
+ * A row of weights (one output channel) is stored in blocks of 32 weights
+ * in 16 bytes: byte j holds weight j in its low nibble and weight j + 16 in
+ * its high nibble. A 16 byte load then unpacks into two runs of 16 adjacent
+ * weights with a mask and a shift, matching 16 adjacent inputs each. The
+ * last block of a row is padded with zeros: every row starts 16 byte
+ * aligned from the start of the packed filter.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_NN_S4_BLOCK     32
+
+/**
+ * @brief   bytes of one packed row of `row_len` weights
+ */
+static inline int32_t esp_nn_get_s4_row_size(const int32_t row_len)
+{
+    return (row_len + ESP_NN_S4_BLOCK - 1) / ESP_NN_S4_BLOCK * (ESP_NN_S4_BLOCK / 2);
+}
+
+/**
+ * @brief   bytes of `rows` packed rows of `row_len` weights
+ */
+static inline int32_t esp_nn_get_s4_packed_size(const int32_t rows, const int32_t row_len)
+{
+    return rows * esp_nn_get_s4_row_size(row_len);
+}
+
+/**
+ * @brief   pack int8 weights in [-8, 7] into `dst`, esp_nn_get_s4_packed_size bytes
+ *
+ * @note    `src` holds `rows` rows of `row_len` weights, as the int8 kernels
+ *          take them: for a conv filter, a row is the filter of one output channel
+ */
+static inline void esp_nn_s4_pack(int8_t *dst, const int8_t *src,
+                                  const int32_t rows, const int32_t row_len)
+{
+    const int32_t half = ESP_NN_S4_BLOCK / 2;
+
+    for (int32_t row = 0; row < rows; row++, src += row_len) {
+        for (int32_t base = 0; base < row_len; base += ESP_NN_S4_BLOCK, dst += half) {
+            for (int32_t j = 0; j < half; j++) {
+                const int32_t lo = base + j < row_len ? src[base + j] : 0;
+                const int32_t hi = base + j + half < row_len ? src[base + j + half] : 0;
+                dst[j] = (int8_t) ((lo & 0x0f) | ((hi & 0x0f) << 4));
+            }
+        }
+    }
+}
+
+/**
+ * @brief   weight `idx` of a packed row
+ */
+static inline int32_t esp_nn_s4_weight(const int8_t *row, const int32_t idx)
+{
+    const int32_t j = idx % ESP_NN_S4_BLOCK;
+    const int8_t byte = row[idx / ESP_NN_S4_BLOCK * (ESP_NN_S4_BLOCK / 2) + j % (ESP_NN_S4_BLOCK / 2)];
+    return j < ESP_NN_S4_BLOCK / 2 ? (int8_t) ((uint8_t) byte << 4) >> 4 : byte >> 4;
+}
+
+#ifdef __cplusplus
+}
+#endif
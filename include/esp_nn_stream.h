@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Row streaming convolution, for input that arrives a row at a time (e.g.
+ * camera frames in a small DMA buffer).
+ *
+ * The stream keeps the last rows a filter window spans in a ring, and runs
+ * the regular (dispatched) conv kernel on them as soon as an output row has
+ * all its input: the full input image never has to be resident. Output is
+ * bit exact with esp_nn_conv_s8 on the whole image.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   streaming state, at the start of the stream blob
+ *
+ * @note    Shapes and params are copied, the filter, bias and quant arrays
+ *          are referenced: keep them alive while the stream is used.
+ */
+typedef struct esp_nn_conv_stream {
+    data_dims_t input_dims;
+    data_dims_t filter_dims;
+    data_dims_t output_dims;
+    conv_params_t conv_params;
+    quant_data_t quant_data;
+    const int8_t *filter;
+    const int32_t *bias;
+    int8_t *ring;               // every row is stored twice, `ring_rows` apart
+    int32_t ring_rows;          // input rows a filter window spans
+    int32_t row_size;           // bytes of an input row
+    int32_t rows_in;            // rows of the current frame pushed so far
+    int32_t rows_out;           // output rows of the current frame emitted so far
+    int32_t max_out_rows;       // most output rows one push emits
+} esp_nn_conv_stream_t;
+
+/**
+ * @brief   bytes of the stream blob: the state and a ring of 2 x filter height input rows
+ */
+int32_t esp_nn_get_conv_stream_size(const data_dims_t *input_dims,
+                                    const data_dims_t *filter_dims,
+                                    const conv_params_t *conv_params);
+
+/**
+ * @brief   scratch the conv calls of esp_nn_conv_stream_push need in `ctx`
+ */
+int32_t esp_nn_get_conv_stream_scratch_size(const data_dims_t *input_dims,
+                                            const data_dims_t *filter_dims,
+                                            const data_dims_t *output_dims,
+                                            const conv_params_t *conv_params);
+
+/**
+ * @brief   set up a stream for a conv layer, arguments are as for esp_nn_conv_s8
+ *
+ * @note    `blob` must be 16 byte aligned, esp_nn_get_conv_stream_size bytes.
+ *          `input_dims` is one image.
+ *
+ * @return  the blob as stream, NULL if `blob` is misaligned
+ */
+esp_nn_conv_stream_t *esp_nn_conv_stream_init(void *blob,
+                                              const data_dims_t *input_dims,
+                                              const data_dims_t *filter_dims,
+                                              const int8_t *filter_data,
+                                              const int32_t *bias,
+                                              const data_dims_t *output_dims,
+                                              const conv_params_t *conv_params,
+                                              const quant_data_t *quant_data);
+
+/**
+ * @brief   push the next input row (`width x channels` bytes)
+ *
+ * @param   out_data    room for `max_out_rows` output rows. Rows emitted by
+ *                      the push are written there, one after the other
+ *
+ * @return  number of output rows written, from row `rows_out` before the push
+ *
+ * @note    A frame ends with its last input row, which resets the stream for
+ *          the next one. esp_nn_conv_stream_reset drops a partly pushed frame.
+ */
+int32_t esp_nn_conv_stream_push(const esp_nn_ctx_t *ctx,
+                                esp_nn_conv_stream_t *stream,
+                                const int8_t *row,
+                                int8_t *out_data);
+
+void esp_nn_conv_stream_reset(esp_nn_conv_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
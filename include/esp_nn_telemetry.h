@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Dispatch path telemetry of the optimised kernels.
+ *
+ * With `NN_TELEMETRY` enabled in menuconfig (ESP_NN_TELEMETRY defined), the
+ * dispatchers of conv, fully connected and avg pool count every call per
+ * path taken, with the cycles spent in it. Layers silently hitting a slow
+ * fallback then show up in the counters. Without it the recording compiles
+ * out, and the query functions report nothing.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(ESP_NN_TELEMETRY) || defined(CONFIG_NN_TELEMETRY)
+#define ESP_NN_TELEMETRY_ENABLED    1
+#else
+#define ESP_NN_TELEMETRY_ENABLED    0
+#endif
+
+typedef enum {
+    /* esp_nn_conv_s8 */
+    ESP_NN_PATH_CONV_ANSI = 0,      // grouped conv, handed to the ANSI C kernel
+    ESP_NN_PATH_CONV_1X1_ASM,       // ESP32-S3 1x1, channels multiple of 8
+    ESP_NN_PATH_CONV_1X1,
+    ESP_NN_PATH_CONV_IM2COL,
+    ESP_NN_PATH_CONV_PADDED,        // ESP32-P4 unpadded conv with wide rows
+    ESP_NN_PATH_CONV_TILED,         // ESP32-P4 padded conv with tiny windows
+    ESP_NN_PATH_CONV_GENERAL,
+    /* esp_nn_fully_connected_s8 / _per_ch_s8 */
+    ESP_NN_PATH_FC_S8,
+    ESP_NN_PATH_FC_S16,             // ESP32-S3 fallback: filter offset, short rows or unaligned input
+    ESP_NN_PATH_FC_C,               // ESP32-P4 fallback: non zero input or filter offset
+    /* esp_nn_fully_connected_s8_run */
+    ESP_NN_PATH_FC_PREPARED_S8,
+    ESP_NN_PATH_FC_PREPARED_C,
+    /* esp_nn_avg_pool_s8 */
+    ESP_NN_PATH_AVG_POOL_ASM,
+    ESP_NN_PATH_AVG_POOL_C,         // ESP32-S3 channels not multiple of 4
+
+    ESP_NN_PATH_MAX,
+} esp_nn_path_t;
+
+typedef struct esp_nn_path_stats {
+    uint32_t calls;
+    uint64_t cycles;                // CPU cycles on chip, nanoseconds on a host build
+} esp_nn_path_stats_t;
+
+/**
+ * @brief   `kernel/path` name of a path, e.g. "conv_s8/im2col"
+ */
+const char *esp_nn_path_name(const esp_nn_path_t path);
+
+/**
+ * @brief   counters of `path` since start or the last reset
+ *
+ * @return  0 on success, -1 for an invalid path or telemetry compiled out
+ */
+int esp_nn_telemetry_get(const esp_nn_path_t path, esp_nn_path_stats_t *stats);
+
+/**
+ * @brief   clear all counters
+ */
+void esp_nn_telemetry_reset(void);
+
+/**
+ * @brief   print the paths taken so far, one line each
+ */
+void esp_nn_telemetry_print(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Worker pool to split one conv / depthwise conv call over several cores.
+ *
+ * The output is split by rows, or by channels when it has a single pixel,
+ * and every worker runs the regular (dispatched) kernel on its part with
+ * its own scratch. How workers are run is left to a backend: FreeRTOS
+ * tasks on chip, pthreads on a host, or none at all to run the parts one
+ * after the other on the caller.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_nn_defs.h"
+
+#define ESP_NN_MAX_WORKERS  4
+
+/**
+ * @brief   work item of a worker: `worker` is in [0, num_workers)
+ */
+typedef void (*esp_nn_worker_fn_t)(void *arg, int32_t worker);
+
+/**
+ * @brief   backend running the workers
+ *
+ * @note    `run` calls fn(arg, worker) once for every worker, concurrently,
+ *          and returns when all of them have returned. Worker 0 may run on
+ *          the calling task.
+ */
+typedef struct esp_nn_worker_backend {
+    void (*run)(void *impl, esp_nn_worker_fn_t fn, void *arg, int32_t num_workers);
+    void *impl;
+} esp_nn_worker_backend_t;
+
+typedef struct esp_nn_workers {
+    int32_t num_workers;                        // 1 .. ESP_NN_MAX_WORKERS
+    const esp_nn_ctx_t *ctx;                    // one context per worker, scratch is not shared
+    const esp_nn_worker_backend_t *backend;     // NULL: workers run in turn on the caller
+} esp_nn_workers_t;
+
+/**
+ * @brief   scratch each worker needs for esp_nn_conv_s8_workers
+ *
+ * @note    largest scratch size of the parts the layer is split into
+ */
+int32_t esp_nn_get_conv_workers_scratch_size(const int32_t num_workers,
+                                             const data_dims_t *input_dims,
+                                             const data_dims_t *filter_dims,
+                                             const data_dims_t *output_dims,
+                                             const conv_params_t *conv_params);
+
+/**
+ * @brief   esp_nn_conv_s8 split across `workers`
+ *
+ * @note    output is bit exact with esp_nn_conv_s8. Layers too small to
+ *          split run on worker 0 only.
+ */
+void esp_nn_conv_s8_workers(const esp_nn_workers_t *workers,
+                            const data_dims_t *input_dims,
+                            const int8_t *input_data,
+                            const data_dims_t *filter_dims,
+                            const int8_t *filter_data,
+                            const int32_t *bias,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            const conv_params_t *conv_params,
+                            const quant_data_t *quant_data);
+
+/**
+ * @brief   esp_nn_conv_s8_workers with a requantisation plan, see esp_nn_conv_s8_plan
+ */
+void esp_nn_conv_s8_workers_plan(const esp_nn_workers_t *workers,
+                                 const data_dims_t *input_dims,
+                                 const int8_t *input_data,
+                                 const data_dims_t *filter_dims,
+                                 const int8_t *filter_data,
+                                 const int32_t *bias,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const conv_params_t *conv_params,
+                                 const quant_plan_data_t *quant_data);
+
+/**
+ * @brief   scratch each worker needs for esp_nn_depthwise_conv_s8_workers
+ */
+int32_t esp_nn_get_depthwise_conv_workers_scratch_size(const int32_t num_workers,
+                                                       const data_dims_t *input_dims,
+                                                       const data_dims_t *filter_dims,
+                                                       const data_dims_t *output_dims,
+                                                       const dw_conv_params_t *conv_params);
+
+/**
+ * @brief   esp_nn_depthwise_conv_s8 split by output rows across `workers`
+ */
+void esp_nn_depthwise_conv_s8_workers(const esp_nn_workers_t *workers,
+                                      const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const dw_conv_params_t *conv_params,
+                                      const quant_data_t *quant_data);
+
+/**
+ * @brief   esp_nn_depthwise_conv_s8_workers with a requantisation plan
+ */
+void esp_nn_depthwise_conv_s8_workers_plan(const esp_nn_workers_t *workers,
+                                           const data_dims_t *input_dims,
+                                           const int8_t *input_data,
+                                           const data_dims_t *filter_dims,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           const data_dims_t *output_dims,
+                                           int8_t *out_data,
+                                           const dw_conv_params_t *conv_params,
+                                           const quant_plan_data_t *quant_data);
+
+/************************** Backends ********************************/
+
+/**
+ * @brief   FreeRTOS backend: `num_workers - 1` tasks, worker 0 runs on the caller
+ *
+ * @param   core_id     core of the first worker task, the following ones go to
+ *                      the next cores in turn. -1 for no affinity
+ *
+ * @return  0 on success, -1 if a task or semaphore can't be created
+ */
+int esp_nn_worker_backend_freertos_init(esp_nn_worker_backend_t *backend,
+                                        const int32_t num_workers,
+                                        const uint32_t priority,
+                                        const uint32_t stack_size,
+                                        const int32_t core_id);
+void esp_nn_worker_backend_freertos_deinit(esp_nn_worker_backend_t *backend);
+
+/**
+ * @brief   pthread backend: `num_workers - 1` threads, worker 0 runs on the caller
+ *
+ * @return  0 on success, -1 if a thread can't be created
+ */
+int esp_nn_worker_backend_pthread_init(esp_nn_worker_backend_t *backend,
+                                       const int32_t num_workers);
+void esp_nn_worker_backend_pthread_deinit(esp_nn_worker_backend_t *backend);
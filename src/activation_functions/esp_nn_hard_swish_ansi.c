@@ -10,6 +10,7 @@
  */
 
 #include <stdint.h>
+#include <esp_nn_defs.h>
 #include <common_functions.h>
 
 /*
@@ -97,3 +98,21 @@ void esp_nn_hard_swish_s8_ansi(const int8_t *input,
         output[i] = (int8_t)out_val;
     }
 }
+
+/* No scratch needed, the context is ignored */
+void esp_nn_hard_swish_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                                   const int8_t *input,
+                                   int8_t *output,
+                                   const int32_t size,
+                                   const int16_t input_zero_point,
+                                   const int16_t output_mult_fxp,
+                                   const int16_t reluish_mult_fxp,
+                                   const int32_t reluish_mult_exp,
+                                   const int32_t output_mult_exp,
+                                   const int16_t output_zero_point)
+{
+    (void) ctx;
+    esp_nn_hard_swish_s8_ansi(input, output, size, input_zero_point, output_mult_fxp,
+                              reluish_mult_fxp, reluish_mult_exp, output_mult_exp,
+                              output_zero_point);
+}
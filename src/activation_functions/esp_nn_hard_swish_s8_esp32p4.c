@@ -12,6 +12,7 @@
  */
 
 #include <stdint.h>
+#include <esp_nn_defs.h>
 
 static inline __attribute__((always_inline))
 int16_t sat_rnd_dbl_hi_mul(int16_t a, int16_t b) {
@@ -150,3 +151,21 @@ void esp_nn_hard_swish_s8_esp32p4(const int8_t *input,
         output[i] = hard_swish_output(rv, on_out, neg_out_exp, output_zero_point);
     }
 }
+
+/* No scratch needed, the context is ignored */
+void esp_nn_hard_swish_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                      const int8_t *input,
+                                      int8_t *output,
+                                      const int32_t size,
+                                      const int16_t input_zero_point,
+                                      const int16_t output_mult_fxp,
+                                      const int16_t reluish_mult_fxp,
+                                      const int32_t reluish_mult_exp,
+                                      const int32_t output_mult_exp,
+                                      const int16_t output_zero_point)
+{
+    (void) ctx;
+    esp_nn_hard_swish_s8_esp32p4(input, output, size, input_zero_point, output_mult_fxp,
+                                 reluish_mult_fxp, reluish_mult_exp, output_mult_exp,
+                                 output_zero_point);
+}
@@ -17,6 +17,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <esp_nn_defs.h>
 
 /* Use ANSI C reference to build LUT — guarantees bit-exact match */
 extern void esp_nn_hard_swish_s8_ansi(const int8_t *input,
@@ -29,7 +30,8 @@ extern void esp_nn_hard_swish_s8_ansi(const int8_t *input,
                                        const int32_t output_mult_exp,
                                        const int16_t output_zero_point);
 
-static int8_t *hard_swish_scratch = NULL;
+/* scratch of the legacy (non `_ctx`) API, set with esp_nn_set_hard_swish_scratch_buf */
+static esp_nn_ctx_t legacy_ctx;
 
 int32_t esp_nn_get_hard_swish_scratch_size_esp32s3(void)
 {
@@ -38,19 +40,21 @@ int32_t esp_nn_get_hard_swish_scratch_size_esp32s3(void)
 
 void esp_nn_set_hard_swish_scratch_buf_esp32s3(void *buf)
 {
-    hard_swish_scratch = (int8_t *)buf;
+    legacy_ctx.scratch = buf;
 }
 
-void esp_nn_hard_swish_s8_esp32s3(const int8_t *input,
-                                   int8_t *output,
-                                   const int32_t size,
-                                   const int16_t input_zero_point,
-                                   const int16_t output_mult_fxp,
-                                   const int16_t reluish_mult_fxp,
-                                   const int32_t reluish_mult_exp,
-                                   const int32_t output_mult_exp,
-                                   const int16_t output_zero_point)
+void esp_nn_hard_swish_s8_ctx_esp32s3(const esp_nn_ctx_t *ctx,
+                                      const int8_t *input,
+                                      int8_t *output,
+                                      const int32_t size,
+                                      const int16_t input_zero_point,
+                                      const int16_t output_mult_fxp,
+                                      const int16_t reluish_mult_fxp,
+                                      const int32_t reluish_mult_exp,
+                                      const int32_t output_mult_exp,
+                                      const int16_t output_zero_point)
 {
+    int8_t *hard_swish_scratch = (int8_t *) ctx->scratch;
     if (!hard_swish_scratch) {
         /* No scratch — fall through to ANSI */
         esp_nn_hard_swish_s8_ansi(input, output, size,
@@ -79,3 +83,18 @@ void esp_nn_hard_swish_s8_esp32s3(const int8_t *input,
         output[i] = lut[(uint8_t)input[i]];
     }
 }
+
+void esp_nn_hard_swish_s8_esp32s3(const int8_t *input,
+                                   int8_t *output,
+                                   const int32_t size,
+                                   const int16_t input_zero_point,
+                                   const int16_t output_mult_fxp,
+                                   const int16_t reluish_mult_fxp,
+                                   const int32_t reluish_mult_exp,
+                                   const int32_t output_mult_exp,
+                                   const int16_t output_zero_point)
+{
+    esp_nn_hard_swish_s8_ctx_esp32s3(&legacy_ctx, input, output, size, input_zero_point,
+                                     output_mult_fxp, reluish_mult_fxp, reluish_mult_exp,
+                                     output_mult_exp, output_zero_point);
+}
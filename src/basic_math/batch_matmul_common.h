@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_nn_defs.h>
+#include <common_functions.h>
+
+/**
+ * @brief       whether the dims of a batch matmul agree, printing why not
+ *
+ * @note        lhs: height rows of width depth. rhs: height depth of width cols,
+ *              or height cols of width depth when transposed. output: height rows
+ *              of width cols. `extra` is the batch count: an operand with one
+ *              batch is broadcast over the others.
+ */
+static inline bool esp_nn_batch_matmul_check(const data_dims_t *lhs_dims,
+                                             const data_dims_t *rhs_dims,
+                                             const data_dims_t *output_dims,
+                                             const matmul_params_t *params)
+{
+    const int32_t rhs_depth = params->rhs_transposed ? rhs_dims->width : rhs_dims->height;
+    const int32_t rhs_cols = params->rhs_transposed ? rhs_dims->height : rhs_dims->width;
+    const int32_t batches = esp_nn_batches(output_dims);
+    const int32_t lhs_batches = esp_nn_batches(lhs_dims);
+    const int32_t rhs_batches = esp_nn_batches(rhs_dims);
+
+    if (rhs_depth != lhs_dims->width || output_dims->height != lhs_dims->height ||
+            output_dims->width != rhs_cols ||
+            (lhs_batches != 1 && lhs_batches != batches) ||
+            (rhs_batches != 1 && rhs_batches != batches)) {
+        printf("esp_nn_batch_matmul error! dims don't match\n");
+        return false;
+    }
+    return true;
+}
+
+/* rhs columns a register tile of the optimised batch matmul keeps in flight */
+#define ESP_NN_MATMUL_TILE          4
+/* bytes of packed rhs columns kept in cache while the lhs rows go past them */
+#define ESP_NN_MATMUL_BLOCK_BYTES   8192
+
+/* rhs columns per cache block, a multiple of the tile */
+static inline int32_t esp_nn_matmul_block_cols(const int32_t depth, const int32_t cols)
+{
+    const int32_t depth_aligned = (depth + 15) & ~15;
+    const int32_t block = max(ESP_NN_MATMUL_BLOCK_BYTES / depth_aligned / ESP_NN_MATMUL_TILE *
+                              ESP_NN_MATMUL_TILE, ESP_NN_MATMUL_TILE);
+    return min(block, (cols + ESP_NN_MATMUL_TILE - 1) / ESP_NN_MATMUL_TILE * ESP_NN_MATMUL_TILE);
+}
+
+/**
+ * @brief       scratch of esp_nn_batch_matmul_s8_blocked: a block of packed rhs
+ *              columns, their offset terms and an aligned lhs row, 16 byte aligned
+ */
+int32_t esp_nn_batch_matmul_scratch_size(const data_dims_t *lhs_dims,
+                                         const data_dims_t *rhs_dims,
+                                         const matmul_params_t *params);
+
+/**
+ * @brief       cache blocked batch matmul
+ *
+ * @note        a block of rhs columns is packed into scratch, each column
+ *              contiguous and zero padded to 16 bytes, with its column sum folded
+ *              into lhs_offset * (sum + depth * rhs_offset). Every lhs row then
+ *              runs against the whole block while it is in cache. Without `dot`,
+ *              a tile of ESP_NN_MATMUL_TILE columns shares each lhs value loaded.
+ *              `dot` (may be NULL) takes a 16 byte aligned lhs row and column, the
+ *              length rounded up to 16.
+ *              An rhs shared by all batches is packed once: the lhs batches are
+ *              then just rows of one matrix.
+ */
+void esp_nn_batch_matmul_s8_blocked(const data_dims_t *lhs_dims,
+                                    const int8_t *lhs_data,
+                                    const data_dims_t *rhs_dims,
+                                    const int8_t *rhs_data,
+                                    const data_dims_t *output_dims,
+                                    int8_t *out_data,
+                                    const matmul_params_t *params,
+                                    void *scratch,
+                                    esp_nn_dot_s8_fn_t dot);
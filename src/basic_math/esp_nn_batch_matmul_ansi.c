@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include "batch_matmul_common.h"
+
+int32_t esp_nn_get_batch_matmul_scratch_size_ansi(const data_dims_t *lhs_dims,
+                                                  const data_dims_t *rhs_dims,
+                                                  const data_dims_t *output_dims,
+                                                  const matmul_params_t *params)
+{
+    return 0;
+}
+
+void esp_nn_batch_matmul_s8_ansi(const esp_nn_ctx_t *ctx,
+                                 const data_dims_t *lhs_dims,
+                                 const int8_t *lhs_data,
+                                 const data_dims_t *rhs_dims,
+                                 const int8_t *rhs_data,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const matmul_params_t *params)
+{
+    (void) ctx;
+    if (!esp_nn_batch_matmul_check(lhs_dims, rhs_dims, output_dims, params)) {
+        return;
+    }
+    const int32_t rows = lhs_dims->height;
+    const int32_t depth = lhs_dims->width;
+    const int32_t cols = output_dims->width;
+    const int32_t batches = esp_nn_batches(output_dims);
+    const int32_t lhs_batches = esp_nn_batches(lhs_dims);
+    const int32_t rhs_batches = esp_nn_batches(rhs_dims);
+    /* stride between the depth values of one rhs column */
+    const int32_t rhs_step = params->rhs_transposed ? 1 : cols;
+    const int32_t rhs_col_step = params->rhs_transposed ? depth : 1;
+    const esp_nn_requant_t requant = esp_nn_requant_entry(params->out_mult, params->out_shift);
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        const int8_t *lhs = lhs_data + (lhs_batches == 1 ? 0 : batch) * rows * depth;
+        const int8_t *rhs = rhs_data + (rhs_batches == 1 ? 0 : batch) * depth * cols;
+
+        for (int32_t row = 0; row < rows; row++) {
+            for (int32_t col = 0; col < cols; col++) {
+                int32_t result = 0;
+                for (int32_t k = 0; k < depth; k++) {
+                    const int32_t lhs_val = lhs[row * depth + k];
+                    const int32_t rhs_val = rhs[col * rhs_col_step + k * rhs_step];
+                    result += (lhs_val + params->lhs_offset) * (rhs_val + params->rhs_offset);
+                }
+                result = esp_nn_requant_apply(result, &requant);
+                result += params->out_offset;
+                result = max(result, params->activation.min);
+                result = min(result, params->activation.max);
+                *out_data++ = (int8_t) result;
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "batch_matmul_common.h"
+
+int32_t esp_nn_batch_matmul_scratch_size(const data_dims_t *lhs_dims,
+                                         const data_dims_t *rhs_dims,
+                                         const matmul_params_t *params)
+{
+    const int32_t depth = lhs_dims->width;
+    const int32_t depth_aligned = (depth + 15) & ~15;
+    const int32_t cols = params->rhs_transposed ? rhs_dims->height : rhs_dims->width;
+    const int32_t block = esp_nn_matmul_block_cols(depth, cols);
+
+    return 15 + block * depth_aligned + block * (int32_t) sizeof(int32_t) + depth_aligned;
+}
+
+void esp_nn_batch_matmul_s8_blocked(const data_dims_t *lhs_dims,
+                                    const int8_t *lhs_data,
+                                    const data_dims_t *rhs_dims,
+                                    const int8_t *rhs_data,
+                                    const data_dims_t *output_dims,
+                                    int8_t *out_data,
+                                    const matmul_params_t *params,
+                                    void *scratch,
+                                    esp_nn_dot_s8_fn_t dot)
+{
+    if (!esp_nn_batch_matmul_check(lhs_dims, rhs_dims, output_dims, params)) {
+        return;
+    }
+    if (scratch == NULL) {
+        printf("esp_nn_batch_matmul error! scratch_buffer not set!\n");
+        return;
+    }
+    const int32_t rows = lhs_dims->height;
+    const int32_t depth = lhs_dims->width;
+    const int32_t cols = output_dims->width;
+    const int32_t depth_aligned = (depth + 15) & ~15;
+    const int32_t block = esp_nn_matmul_block_cols(depth, cols);
+    const int32_t lhs_offset = params->lhs_offset;
+    const int32_t rhs_offset = params->rhs_offset;
+    const int32_t out_offset = params->out_offset;
+    const int32_t activation_min = params->activation.min;
+    const int32_t activation_max = params->activation.max;
+    const esp_nn_requant_t requant = esp_nn_requant_entry(params->out_mult, params->out_shift);
+
+    int8_t *packed = (int8_t *) (((uintptr_t) scratch + 15) & ~(uintptr_t) 15);
+    int32_t *col_terms = (int32_t *) (packed + block * depth_aligned);
+    int8_t *lhs_row_buf = (int8_t *) (col_terms + block);
+
+    const int32_t batches = esp_nn_batches(output_dims);
+    const int32_t lhs_batches = esp_nn_batches(lhs_dims);
+    const int32_t rhs_batches = esp_nn_batches(rhs_dims);
+    const bool merge = rhs_batches == 1 && lhs_batches == batches;
+    const int32_t passes = merge ? 1 : batches;
+    const int32_t pass_rows = merge ? rows * batches : rows;
+
+    for (int32_t pass = 0; pass < passes; pass++) {
+        const int8_t *lhs = lhs_data + (lhs_batches == 1 ? 0 : pass) * rows * depth;
+        const int8_t *rhs = rhs_data + (rhs_batches == 1 ? 0 : pass) * depth * cols;
+        int8_t *out = out_data + pass * rows * cols;
+
+        for (int32_t col0 = 0; col0 < cols; col0 += block) {
+            const int32_t n = min(block, cols - col0);
+
+            if (params->rhs_transposed) {
+                for (int32_t j = 0; j < n; j++) {
+                    memcpy(packed + j * depth_aligned, rhs + (col0 + j) * depth, depth);
+                }
+            } else {
+                for (int32_t k = 0; k < depth; k++) {
+                    const int8_t *rhs_row = rhs + k * cols + col0;
+                    for (int32_t j = 0; j < n; j++) {
+                        packed[j * depth_aligned + k] = rhs_row[j];
+                    }
+                }
+            }
+            for (int32_t j = 0; j < n; j++) {
+                int8_t *col = packed + j * depth_aligned;
+                int32_t sum = 0;
+                memset(col + depth, 0, depth_aligned - depth);
+                for (int32_t k = 0; k < depth; k++) {
+                    sum += col[k];
+                }
+                col_terms[j] = lhs_offset * (sum + depth * rhs_offset);
+            }
+
+            for (int32_t row = 0; row < pass_rows; row++) {
+                const int8_t *lhs_row = lhs + row * depth;
+                int8_t *out_row = out + row * cols + col0;
+                int32_t row_term = 0;
+                if (rhs_offset != 0) {
+                    for (int32_t k = 0; k < depth; k++) {
+                        row_term += lhs_row[k];
+                    }
+                    row_term *= rhs_offset;
+                }
+                int32_t acc[ESP_NN_MATMUL_TILE];
+                int32_t j = 0;
+
+                if (dot) {
+                    if (depth != depth_aligned || ((uintptr_t) lhs_row & 15)) {
+                        memcpy(lhs_row_buf, lhs_row, depth);
+                        memset(lhs_row_buf + depth, 0, depth_aligned - depth);
+                        lhs_row = lhs_row_buf;
+                    }
+                }
+                while (j < n) {
+                    const int32_t tile = min(ESP_NN_MATMUL_TILE, n - j);
+                    const int8_t *col = packed + j * depth_aligned;
+
+                    if (dot) {
+                        for (int32_t t = 0; t < tile; t++) {
+                            acc[t] = dot(lhs_row, col + t * depth_aligned, depth_aligned);
+                        }
+                    } else if (tile == ESP_NN_MATMUL_TILE) {
+                        const int8_t *col1 = col + depth_aligned;
+                        const int8_t *col2 = col1 + depth_aligned;
+                        const int8_t *col3 = col2 + depth_aligned;
+                        int32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+                        for (int32_t k = 0; k < depth; k++) {
+                            const int32_t lhs_val = lhs_row[k];
+                            acc0 += lhs_val * col[k];
+                            acc1 += lhs_val * col1[k];
+                            acc2 += lhs_val * col2[k];
+                            acc3 += lhs_val * col3[k];
+                        }
+                        acc[0] = acc0;
+                        acc[1] = acc1;
+                        acc[2] = acc2;
+                        acc[3] = acc3;
+                    } else {
+                        for (int32_t t = 0; t < tile; t++) {
+                            const int8_t *col_t = col + t * depth_aligned;
+                            int32_t sum = 0;
+                            for (int32_t k = 0; k < depth; k++) {
+                                sum += lhs_row[k] * col_t[k];
+                            }
+                            acc[t] = sum;
+                        }
+                    }
+                    for (int32_t t = 0; t < tile; t++, j++) {
+                        int32_t result = acc[t] + col_terms[j] + row_term;
+                        result = esp_nn_requantize_plan(result, &requant);
+                        result += out_offset;
+                        result = max(result, activation_min);
+                        result = min(result, activation_max);
+                        out_row[j] = (int8_t) result;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int32_t esp_nn_get_batch_matmul_scratch_size_opt(const data_dims_t *lhs_dims,
+                                                 const data_dims_t *rhs_dims,
+                                                 const data_dims_t *output_dims,
+                                                 const matmul_params_t *params)
+{
+    return esp_nn_batch_matmul_scratch_size(lhs_dims, rhs_dims, params);
+}
+
+void esp_nn_batch_matmul_s8_opt(const esp_nn_ctx_t *ctx,
+                                const data_dims_t *lhs_dims,
+                                const int8_t *lhs_data,
+                                const data_dims_t *rhs_dims,
+                                const int8_t *rhs_data,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const matmul_params_t *params)
+{
+    esp_nn_batch_matmul_s8_blocked(lhs_dims, lhs_data, rhs_dims, rhs_data, output_dims,
+                                   out_data, params, ctx->scratch, NULL);
+}
@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include "batch_matmul_common.h"
+
+int32_t esp_nn_get_batch_matmul_scratch_size_esp32p4(const data_dims_t *lhs_dims,
+                                                     const data_dims_t *rhs_dims,
+                                                     const data_dims_t *output_dims,
+                                                     const matmul_params_t *params)
+{
+    return esp_nn_batch_matmul_scratch_size(lhs_dims, rhs_dims, params);
+}
+
+/* cache blocked, each lhs row against the packed rhs block on the PIE dot product */
+void esp_nn_batch_matmul_s8_esp32p4(const esp_nn_ctx_t *ctx,
+                                    const data_dims_t *lhs_dims,
+                                    const int8_t *lhs_data,
+                                    const data_dims_t *rhs_dims,
+                                    const int8_t *rhs_data,
+                                    const data_dims_t *output_dims,
+                                    int8_t *out_data,
+                                    const matmul_params_t *params)
+{
+    ESP_NN_PIE_ENABLE();
+    esp_nn_batch_matmul_s8_blocked(lhs_dims, lhs_data, rhs_dims, rhs_data, output_dims,
+                                   out_data, params, ctx->scratch, esp_nn_dot_s8_esp32p4);
+}
@@ -6,9 +6,17 @@
 
 #pragma once
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <esp_nn_defs.h>
+#include <esp_nn_mover.h>
+#include <esp_nn_requant.h>
+#include <esp_nn_s4.h>
+#include <esp_nn_telemetry.h>
+#include <esp_nn_profile.h>
+#include <esp_nn_autotune.h>
 
 /**
  * c99 standard still doesn't strictly inline functions
@@ -81,6 +89,19 @@ __NN_FORCE_INLINE__ int32_t esp_nn_saturate8(int32_t in)
 #endif
 }
 
+/**
+ * Signed saturate a 32 bit value to 16 bits keeping output in 32 bit variable.
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_saturate16(int32_t in)
+{
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    __asm__ volatile("clamps %0, %0, 15" : "+a"(in));
+    return in;
+#else
+    return max(INT16_MIN, min(in, INT16_MAX));
+#endif
+}
+
 __NN_FORCE_INLINE__ int32_t esp_nn_pick_sat_high32_of64(int64_t val64)
 {
     int32_t sign = (int32_t) (val64 >> 63);
@@ -206,6 +227,30 @@ __NN_FORCE_INLINE__ int32_t esp_nn_multiply_by_quantized_mult(int32_t x, int32_t
     if (_rs0) { (r0) = ((r0) + (1 << (_rs0 - 1)) - ((r0) < 0)) >> _rs0; } \
     if (_rs1) { (r1) = ((r1) + (1 << (_rs1 - 1)) - ((r1) < 0)) >> _rs1; } \
 } while(0)
+
+/* ESP_NN_REQUANT_2X on two plan entries: shifts split, rounding without branches */
+#define ESP_NN_REQUANT_PLAN_2X(x0, x1, rq0, rq1, r0, r1) do { \
+    int32_t _v0 = (x0) << (rq0)->left_shift; \
+    int32_t _v1 = (x1) << (rq1)->left_shift; \
+    int32_t _hi0, _lo0, _hi1, _lo1; \
+    asm volatile ( \
+        "mulh  %[h0], %[v0], %[mm0]  \n\t" \
+        "mulh  %[h1], %[v1], %[mm1]  \n\t" \
+        "mul   %[l0], %[v0], %[mm0]  \n\t" \
+        "mul   %[l1], %[v1], %[mm1]  \n\t" \
+        : [h0] "=&r"(_hi0), [h1] "=&r"(_hi1), \
+          [l0] "=&r"(_lo0), [l1] "=&r"(_lo1) \
+        : [v0] "r"(_v0), [v1] "r"(_v1), \
+          [mm0] "r"((rq0)->mult), [mm1] "r"((rq1)->mult) \
+    ); \
+    uint32_t _n = 0x40000000u; \
+    uint32_t _a0 = (uint32_t)_lo0 + _n; \
+    _hi0 += (_a0 < (uint32_t)_lo0); \
+    uint32_t _a1 = (uint32_t)_lo1 + _n; \
+    _hi1 += (_a1 < (uint32_t)_lo1); \
+    (r0) = esp_nn_requant_round((_hi0 << 1) | (_a0 >> 31), (rq0)); \
+    (r1) = esp_nn_requant_round((_hi1 << 1) | (_a1 >> 31), (rq1)); \
+} while(0)
 #endif
 
 __NN_FORCE_INLINE__ int32_t esp_nn_multiply_by_quantized_mult_fast(int32_t x, int32_t mult, int32_t shift)
@@ -236,13 +281,162 @@ __NN_FORCE_INLINE__ int32_t esp_nn_multiply_by_quantized_mult_fast(int32_t x, in
 #define esp_nn_requantize(x, m, s) esp_nn_multiply_by_quantized_mult((x), (m), (s))
 #endif
 
-static void esp_nn_aligned_s8_pad_with_value(const int8_t *src, int8_t *dst,
-                                             const uint16_t input_wd,
-                                             const uint16_t input_ht,
-                                             const uint16_t channels,
-                                             const int32_t pad_val,
-                                             const uint16_t pad_wd,
-                                             const uint16_t pad_ht)
+/**
+ * Rounding right shift of a plan entry: esp_nn_div_by_power_of_two with the
+ * mask precomputed, 0 for channels that don't shift right.
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_requant_round(int32_t val, const esp_nn_requant_t *rq)
+{
+    const int32_t threshold = (rq->round_mask >> 1) + (val < 0);
+    return (val >> rq->right_shift) + ((val & rq->round_mask) > threshold);
+}
+
+/**
+ * esp_nn_multiply_by_quantized_mult through a plan entry, bit exact: the
+ * nudge is picked from the product sign without a branch
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_requant_apply(int32_t x, const esp_nn_requant_t *rq)
+{
+    const int32_t val = x * (1 << rq->left_shift);
+    const int64_t nudge = (1 << 30) - (((val ^ rq->mult) >> 31) & INT32_MAX);
+    const int32_t high = esp_nn_pick_sat_high32_of64((int64_t) val * rq->mult + nudge);
+    return esp_nn_requant_round(high, rq);
+}
+
+/* esp_nn_multiply_by_quantized_mult_fast through a plan entry */
+__NN_FORCE_INLINE__ int32_t esp_nn_requant_apply_fast(int32_t x, const esp_nn_requant_t *rq)
+{
+    const int64_t val = (int64_t) (x << rq->left_shift);
+    const int32_t high = (int32_t) ((val * rq->mult + (1 << 30)) >> 31);
+    return esp_nn_requant_round(high, rq);
+}
+
+/* plan counterpart of esp_nn_requantize */
+#if defined(SKIP_NUDGE) || defined(CONFIG_NN_SKIP_NUDGE)
+#define esp_nn_requantize_plan(x, rq) esp_nn_requant_apply_fast((x), (rq))
+#else
+#define esp_nn_requantize_plan(x, rq) esp_nn_requant_apply((x), (rq))
+#endif
+
+/* `quant_data` for the `_plan` kernels, without a plan */
+__NN_FORCE_INLINE__ quant_plan_data_t esp_nn_quant_no_plan(const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = {
+        .shift = quant_data->shift,
+        .mult = quant_data->mult,
+        .plan = NULL,
+    };
+    return no_plan;
+}
+
+/* plan entry of output channel `ch`, split here when `quant_data` has no plan */
+__NN_FORCE_INLINE__ esp_nn_requant_t esp_nn_requant_ch_entry(const quant_plan_data_t *quant_data,
+                                                             const int32_t ch)
+{
+    if (quant_data->plan) {
+        return quant_data->plan[ch];
+    }
+    return esp_nn_requant_entry(quant_data->mult[ch], quant_data->shift[ch]);
+}
+
+/**
+ * Requantize `x` of output channel `ch`: through the plan of `quant_data`
+ * when it has one, else from its mult / shift. The plan test is the same
+ * for the whole layer. `_exact` is for the ANSI C kernels, which never skip
+ * the nudge.
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_requantize_ch_exact(int32_t x, const quant_plan_data_t *quant_data,
+                                                       const int32_t ch)
+{
+    if (quant_data->plan) {
+        return esp_nn_requant_apply(x, &quant_data->plan[ch]);
+    }
+    return esp_nn_multiply_by_quantized_mult(x, quant_data->mult[ch], quant_data->shift[ch]);
+}
+
+__NN_FORCE_INLINE__ int32_t esp_nn_requantize_ch(int32_t x, const quant_plan_data_t *quant_data,
+                                                 const int32_t ch)
+{
+    if (quant_data->plan) {
+        return esp_nn_requantize_plan(x, &quant_data->plan[ch]);
+    }
+    return esp_nn_requantize(x, quant_data->mult[ch], quant_data->shift[ch]);
+}
+
+/**
+ * Requantize an int64 accumulator of the 16x8 kernels, as TFLite does: the
+ * multiplier is rounded to 16 bits so that the product fits in 64 bits.
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_multiply_by_quantized_mult_s64(int64_t x, int32_t mult, int32_t shift)
+{
+    const int32_t reduced_mult = mult < 0x7fff0000 ? (mult + (1 << 15)) >> 16 : 0x7fff;
+    const int32_t total_shift = 15 - shift;
+    const int64_t round = (int64_t) 1 << (total_shift - 1);
+    return (int32_t) ((x * reduced_mult + round) >> total_shift);
+}
+
+/*
+ * int16 * int8 products are below 1 << 22 in magnitude: 256 of them sum
+ * without overflowing an int32. The 16x8 dot products accumulate chunks
+ * in two int32 sums and flush them into int64.
+ */
+#define ESP_NN_S16_DOT_CHUNK    512
+
+__NN_FORCE_INLINE__ int64_t esp_nn_dot_s16_s8(const int16_t *input, const int8_t *filter, int32_t len)
+{
+    int64_t acc = 0;
+    while (len > 0) {
+        const int32_t n = min(len, ESP_NN_S16_DOT_CHUNK);
+        int32_t sum0 = 0, sum1 = 0;
+        int32_t i = 0;
+        for (; i < n - 1; i += 2) {
+            sum0 += input[i] * filter[i];
+            sum1 += input[i + 1] * filter[i + 1];
+        }
+        if (i < n) {
+            sum0 += input[i] * filter[i];
+        }
+        acc += (int64_t) sum0 + sum1;
+        input += n;
+        filter += n;
+        len -= n;
+    }
+    return acc;
+}
+
+/*
+ * (input + offset) . weights of a packed int4 row, esp_nn_s4.h layout. A
+ * block is 16 bytes: the low nibbles weigh inputs 0..15, the high ones
+ * 16..31, so both halves unpack as runs of adjacent values.
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_dot_s8_s4(const int8_t *input, const int32_t input_offset,
+                                             const int8_t *row, const int32_t len)
+{
+    const int32_t half = ESP_NN_S4_BLOCK / 2;
+    int32_t sum0 = 0, sum1 = 0;
+    int32_t base = 0;
+
+    for (; base <= len - ESP_NN_S4_BLOCK; base += ESP_NN_S4_BLOCK, row += half) {
+        for (int32_t j = 0; j < half; j++) {
+            const int32_t lo = (int8_t) ((uint8_t) row[j] << 4) >> 4;
+            const int32_t hi = row[j] >> 4;
+            sum0 += (input[base + j] + input_offset) * lo;
+            sum1 += (input[base + j + half] + input_offset) * hi;
+        }
+    }
+    for (int32_t idx = base; idx < len; idx++) {
+        sum0 += (input[idx] + input_offset) * esp_nn_s4_weight(row, idx - base);
+    }
+    return sum0 + sum1;
+}
+
+static inline void esp_nn_aligned_s8_pad_with_value(const int8_t *src, int8_t *dst,
+                                                    const uint16_t input_wd,
+                                                    const uint16_t input_ht,
+                                                    const uint16_t channels,
+                                                    const int32_t pad_val,
+                                                    const uint16_t pad_wd,
+                                                    const uint16_t pad_ht)
 {
     /* memset with pad_val */
     memset(dst, pad_val, ((input_wd + 2 * pad_wd) * (input_ht + 2 * pad_ht)) * channels);
@@ -257,13 +451,13 @@ static void esp_nn_aligned_s8_pad_with_value(const int8_t *src, int8_t *dst,
     }
 }
 
-static void esp_nn_aligned_s8_pad_end_with_value(const int8_t *src, int8_t *dst,
-                                                 const uint16_t input_wd,
-                                                 const uint16_t input_ht,
-                                                 const uint16_t channels,
-                                                 const int32_t pad_val,
-                                                 const uint16_t pad_wd,
-                                                 const uint16_t pad_ht)
+static inline void esp_nn_aligned_s8_pad_end_with_value(const int8_t *src, int8_t *dst,
+                                                        const uint16_t input_wd,
+                                                        const uint16_t input_ht,
+                                                        const uint16_t channels,
+                                                        const int32_t pad_val,
+                                                        const uint16_t pad_wd,
+                                                        const uint16_t pad_ht)
 {
     for (int i = 0; i < input_ht; i++) {
         for (int j = 0; j < input_wd * channels; j++) {
@@ -280,6 +474,245 @@ static void esp_nn_aligned_s8_pad_end_with_value(const int8_t *src, int8_t *dst,
     }
 }
 
+/**
+ * @brief       per output channel `sum(filter) * input_offset + bias`
+ *
+ * @note        this is the input offset part of a convolution folded out of the MACs:
+ *              sum((in + offset) * f) + bias = sum(in * f) + correction
+ *              Valid as long as every filter tap reads input or a `-input_offset` pad.
+ *              `bias` may be NULL.
+ */
+static inline void esp_nn_conv_fold_offset(const int8_t *filter, const int32_t filter_len,
+                                           const int32_t out_channels, const int32_t input_offset,
+                                           const int32_t *bias, int32_t *corrections)
+{
+    for (int32_t ch = 0; ch < out_channels; ch++) {
+        int32_t sum = 0;
+        for (int32_t i = 0; i < filter_len; i++) {
+            sum += filter[i];
+        }
+        corrections[ch] = sum * input_offset + (bias ? bias[ch] : 0);
+        filter += filter_len;
+    }
+}
+
+/**
+ * @brief       images in a batch: `extra` of the input dims
+ *
+ * @note        callers from before batching left `extra` at 0 or 1, both run one image.
+ *              Images follow each other in the input and the output.
+ */
+static inline int32_t esp_nn_batches(const data_dims_t *input_dims)
+{
+    return input_dims->extra > 1 ? input_dims->extra : 1;
+}
+
+/**
+ * @brief       dilation along one axis, 0 (unset) taken as 1
+ */
+static inline int32_t esp_nn_dilation(const int32_t dilation)
+{
+    return dilation > 1 ? dilation : 1;
+}
+
+/**
+ * @brief       whether the taps of a filter are apart along an axis it spans
+ */
+static inline bool esp_nn_is_dilated(const data_dims_t *filter_dims, const data_2d_t *dilation)
+{
+    return (filter_dims->width > 1 && dilation->width > 1) ||
+           (filter_dims->height > 1 && dilation->height > 1);
+}
+
+/**
+ * @brief       taps [*start, *end) of a filter, `dilation` apart, that land inside
+ *              an input of `input_len` when the first one is at `base`
+ */
+static inline void esp_nn_filter_taps(const int32_t base, const int32_t filter_len,
+                                      const int32_t dilation, const int32_t input_len,
+                                      int32_t *start, int32_t *end)
+{
+    *start = base < 0 ? (dilation - 1 - base) / dilation : 0;
+    *end = base < input_len ? min(filter_len, (input_len - base + dilation - 1) / dilation) : 0;
+}
+
+/**
+ * @brief       start copying `size` bytes of a tile through `mover`, see esp_nn_mover.h
+ *
+ * @return      ticket to wait for. Without a mover, the copy is done and -1 is returned
+ */
+static inline int32_t esp_nn_tile_copy(const esp_nn_tile_mover_t *mover,
+                                       void *dst, const void *src, const int32_t size)
+{
+    if (mover == NULL) {
+        memcpy(dst, src, size);
+        return -1;
+    }
+    return mover->start_copy(mover->impl, dst, src, size);
+}
+
+static inline void esp_nn_tile_wait(const esp_nn_tile_mover_t *mover, const int32_t ticket)
+{
+    if (mover != NULL && ticket >= 0) {
+        mover->wait(mover->impl, ticket);
+    }
+}
+
+/*
+ * Dispatch path telemetry, see esp_nn_telemetry.h. Compiles to the bare call
+ * or to nothing without ESP_NN_TELEMETRY.
+ *
+ *  ESP_NN_PATH_CALL(path, call)        record `call` (a statement) under `path`
+ *  ESP_NN_PATH_TIMER_START(t)          start timer `t` for an inline path...
+ *  ESP_NN_PATH_TIMER_STOP(path, t)     ...and record it
+ */
+#if ESP_NN_TELEMETRY_ENABLED
+void esp_nn_telemetry_record(const esp_nn_path_t path, const uint32_t cycles);
+
+#define ESP_NN_PATH_CALL(path, call) do {                                   \
+    const uint32_t _path_t0 = esp_nn_profile_timestamp();                   \
+    call;                                                                   \
+    esp_nn_telemetry_record((path), esp_nn_profile_timestamp() - _path_t0); \
+} while (0)
+#define ESP_NN_PATH_TIMER_START(t)      const uint32_t t = esp_nn_profile_timestamp()
+#define ESP_NN_PATH_TIMER_STOP(path, t) esp_nn_telemetry_record((path), esp_nn_profile_timestamp() - (t))
+#else
+#define ESP_NN_PATH_CALL(path, call)    do { call; } while (0)
+#define ESP_NN_PATH_TIMER_START(t)
+#define ESP_NN_PATH_TIMER_STOP(path, t)
+#endif
+
+/*
+ * Scratch guard: with ESP_NN_SCRATCH_GUARD, scratch sizes report
+ * ESP_NN_SCRATCH_GUARD_SIZE more bytes, filled with a canary before the kernel
+ * and checked after it. Compiles to the bare call without.
+ *
+ *  ESP_NN_SCRATCH_GUARDED(op, scratch, size, call)
+ *      run `call` (a statement) using at most `size` bytes of `scratch`
+ */
+#if defined(ESP_NN_SCRATCH_GUARD) || defined(CONFIG_NN_SCRATCH_GUARD)
+#define ESP_NN_SCRATCH_GUARD_SIZE   32
+#define ESP_NN_SCRATCH_GUARD_FILL   0xa5
+
+static inline void esp_nn_scratch_guard_set(void *scratch, const int32_t size)
+{
+    if (scratch) {
+        memset((int8_t *) scratch + size, ESP_NN_SCRATCH_GUARD_FILL, ESP_NN_SCRATCH_GUARD_SIZE);
+    }
+}
+
+static inline void esp_nn_scratch_guard_check(const void *scratch, const int32_t size,
+                                              const char *op)
+{
+    if (scratch == NULL) {
+        return;
+    }
+    const uint8_t *guard = (const uint8_t *) scratch + size;
+    for (int i = 0; i < ESP_NN_SCRATCH_GUARD_SIZE; i++) {
+        if (guard[i] != ESP_NN_SCRATCH_GUARD_FILL) {
+            printf("esp_nn %s: scratch overrun, byte %d past the %d reported\n",
+                   op, i, (int) size);
+            return;
+        }
+    }
+}
+
+#define ESP_NN_SCRATCH_GUARDED(op, scratch, size, call) do {   \
+    const int32_t _guard_size = (size);                         \
+    esp_nn_scratch_guard_set((scratch), _guard_size);           \
+    call;                                                       \
+    esp_nn_scratch_guard_check((scratch), _guard_size, (op));   \
+} while (0)
+#else
+#define ESP_NN_SCRATCH_GUARD_SIZE   0
+#define ESP_NN_SCRATCH_GUARDED(op, scratch, size, call)     do { call; } while (0)
+#endif
+
+/*
+ * Conv path autotuning, see esp_nn_autotune.h. A dispatcher resolves its path
+ * with esp_nn_autotune_conv_path(): the path cached for the layer shape, else
+ * `heuristic`, or the fastest of `tuner->candidates` when tuning is enabled.
+ */
+#define ESP_NN_AUTOTUNE_MAX_PATHS   8
+
+typedef struct esp_nn_conv_tuner {
+    esp_nn_autotune_kernel_t kernel;
+    /* paths eligible for the layer and their scratch sizes, returns their count */
+    int (*candidates)(const data_dims_t *input_dims, const data_dims_t *filter_dims,
+                      const data_dims_t *output_dims, const conv_params_t *conv_params,
+                      int32_t *paths, int32_t *scratch_sizes);
+    void (*run)(int32_t path, const data_dims_t *input_dims, const int8_t *input,
+                const data_dims_t *filter_dims, const int8_t *filter_data,
+                const int32_t *bias, const data_dims_t *output_dims, int8_t *out_data,
+                const conv_params_t *conv_params, const quant_plan_data_t *quant_data,
+                void *scratch);
+} esp_nn_conv_tuner_t;
+
+#if ESP_NN_AUTOTUNE_ENABLED
+int32_t esp_nn_autotune_conv_path(const esp_nn_conv_tuner_t *tuner,
+                                  const data_dims_t *input_dims,
+                                  const data_dims_t *filter_dims,
+                                  const data_dims_t *output_dims,
+                                  const conv_params_t *conv_params,
+                                  const int32_t heuristic);
+#else
+static inline int32_t esp_nn_autotune_conv_path(const esp_nn_conv_tuner_t *tuner,
+                                                const data_dims_t *input_dims,
+                                                const data_dims_t *filter_dims,
+                                                const data_dims_t *output_dims,
+                                                const conv_params_t *conv_params,
+                                                const int32_t heuristic)
+{
+    (void) tuner;
+    return heuristic;
+}
+#endif
+
+/* size of a prepared blob header, packed data follows it 16 byte aligned */
+#define ESP_NN_PREPARED_HDR_SIZE(type)  ((int32_t) ((sizeof(type) + 15) & ~15))
+
+/* header and requantisation plan of a prepared conv blob, packed data follows them */
+#define ESP_NN_CONV_PREPARED_HDR_SIZE(out_channels) \
+    (ESP_NN_PREPARED_HDR_SIZE(esp_nn_conv_prepared_t) + \
+     ((esp_nn_get_requant_plan_size(out_channels) + 15) & ~15))
+
+/**
+ * @brief       fill the header of a prepared conv blob, filter and bias refer to the originals
+ *
+ * @note        the requantisation plan of the layer is built after the header,
+ *              the blob takes ESP_NN_CONV_PREPARED_HDR_SIZE bytes up to here
+ *
+ * @return      the header, NULL if `blob` is not 16 byte aligned
+ */
+static inline esp_nn_conv_prepared_t *esp_nn_conv_prepared_init(void *blob,
+                                                                const data_dims_t *input_dims,
+                                                                const data_dims_t *filter_dims,
+                                                                const int8_t *filter_data,
+                                                                const int32_t *bias,
+                                                                const data_dims_t *output_dims,
+                                                                const conv_params_t *conv_params,
+                                                                const quant_data_t *quant_data)
+{
+    esp_nn_conv_prepared_t *prep = (esp_nn_conv_prepared_t *) blob;
+    if (prep == NULL || ((uintptr_t) blob & 15)) {
+        return NULL;
+    }
+    prep->input_dims = *input_dims;
+    prep->filter_dims = *filter_dims;
+    prep->output_dims = *output_dims;
+    prep->conv_params = *conv_params;
+    prep->quant_data.shift = quant_data->shift;
+    prep->quant_data.mult = quant_data->mult;
+    prep->quant_data.plan = esp_nn_requant_plan_init(
+        (esp_nn_requant_t *) ((int8_t *) blob + ESP_NN_PREPARED_HDR_SIZE(esp_nn_conv_prepared_t)),
+        quant_data, output_dims->channels);
+    prep->filter = filter_data;
+    prep->bias = bias;
+    prep->offset_acc = NULL;
+    prep->path = 0;
+    return prep;
+}
+
 /**
  * @brief       convert 8 bit input data to 16 bit
  *
@@ -343,3 +776,59 @@ extern int32_t esp_nn_dot_s8_aligned_esp32s3(const int8_t *a, const int8_t *b, i
  */
 extern int32_t esp_nn_dot_s8_unaligned_esp32s3(const int8_t *a, const int8_t *b, int32_t len_div16);
 #endif
+
+#if CONFIG_IDF_TARGET_ESP32P4
+/**
+ * @brief       s8 dot product on PIE, 32 then 16 values per step, scalar tail.
+ *              Both pointers 16-byte aligned, PIE enabled by the caller.
+ */
+extern int32_t esp_nn_dot_s8_esp32p4(const int8_t *a, const int8_t *b, int32_t len);
+#endif
+
+/**
+ * @brief       int8 dot product of `len` values, the signature of the target primitives
+ */
+typedef int32_t (*esp_nn_dot_s8_fn_t)(const int8_t *a, const int8_t *b, int32_t len);
+
+/* scratch of an optimised transpose conv: an input offset term per output channel and tap */
+#define ESP_NN_TRANSPOSE_CONV_SCRATCH_SIZE(filter_dims, out_channels) \
+    ((int32_t) ((out_channels) * (filter_dims)->width * (filter_dims)->height * sizeof(int32_t)))
+
+/* prepared transpose conv blob: the conv header and plan, then the tap terms */
+#define ESP_NN_TRANSPOSE_CONV_PREPARED_SIZE(filter_dims, out_channels) \
+    (ESP_NN_CONV_PREPARED_HDR_SIZE(out_channels) + \
+     ESP_NN_TRANSPOSE_CONV_SCRATCH_SIZE(filter_dims, out_channels))
+
+/**
+ * @brief       per output channel and tap `sum(filter) * input_offset`, the input
+ *              offset part of every tap a transpose conv output may take
+ *
+ * @return      `tap_offsets`, NULL when no scratch was given
+ */
+static inline const int32_t *esp_nn_transpose_conv_fold_taps(const data_dims_t *input_dims,
+                                                             const data_dims_t *filter_dims,
+                                                             const int8_t *filter_data,
+                                                             const data_dims_t *output_dims,
+                                                             const int32_t input_offset,
+                                                             int32_t *tap_offsets)
+{
+    if (tap_offsets) {
+        esp_nn_conv_fold_offset(filter_data, input_dims->channels,
+                                output_dims->channels * filter_dims->width * filter_dims->height,
+                                input_offset, NULL, tap_offsets);
+    }
+    return tap_offsets;
+}
+
+/**
+ * @brief       int16 activation table lookup: 512 segments over the Q3.12 input
+ *              range, linear in between, as the tables of esp_nn_logistic_s16_prepare
+ *              and esp_nn_tanh_s16_prepare are laid out
+ */
+__NN_FORCE_INLINE__ int32_t esp_nn_lut_s16(const int16_t *lut, const int32_t x)
+{
+    const int32_t idx = (x + 32768) >> 7;
+    const int32_t base = lut[idx];
+    const int32_t slope = lut[idx + 1] - base;
+    return base + ((slope * (x & 0x7f) + 64) >> 7);
+}
@@ -0,0 +1,264 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <common_functions.h>
+#include <esp_nn_autotune.h>
+
+#if ESP_NN_AUTOTUNE_ENABLED
+
+#ifndef CONFIG_NN_AUTOTUNE_ENTRIES
+#define CONFIG_NN_AUTOTUNE_ENTRIES  32
+#endif
+
+/* timed runs per path after one warmup run, the fastest counts */
+#define AUTOTUNE_RUNS   3
+
+static esp_nn_autotune_entry_t table[CONFIG_NN_AUTOTUNE_ENTRIES];
+static int table_count;
+static bool tuning;
+
+static esp_nn_autotune_entry_t *table_find(const esp_nn_autotune_key_t *key)
+{
+    for (int i = 0; i < table_count; i++) {
+        if (memcmp(&table[i].key, key, sizeof(esp_nn_autotune_key_t)) == 0) {
+            return &table[i];
+        }
+    }
+    return NULL;
+}
+
+/* entries are filled before they are counted: lookups from other tasks never see a partial one */
+static int table_set(const esp_nn_autotune_key_t *key, const int32_t path)
+{
+    esp_nn_autotune_entry_t *entry = table_find(key);
+    if (entry) {
+        entry->path = path;
+        return 0;
+    }
+    if (table_count == CONFIG_NN_AUTOTUNE_ENTRIES) {
+        return -1;
+    }
+    table[table_count].key = *key;
+    table[table_count].path = path;
+    __atomic_store_n(&table_count, table_count + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int esp_nn_autotune_enable(bool enable)
+{
+    tuning = enable;
+    return 0;
+}
+
+int esp_nn_autotune_preload(const esp_nn_autotune_entry_t *entries, int count)
+{
+    int loaded = 0;
+    for (int i = 0; i < count; i++) {
+        if (table_set(&entries[i].key, entries[i].path) != 0) {
+            printf("esp_nn autotune: table full, %d entries not loaded\n", count - i);
+            break;
+        }
+        loaded++;
+    }
+    return loaded;
+}
+
+int esp_nn_autotune_export(esp_nn_autotune_entry_t *entries, int max_entries)
+{
+    int count = min(table_count, max_entries);
+    memcpy(entries, table, count * sizeof(esp_nn_autotune_entry_t));
+    return count;
+}
+
+void esp_nn_autotune_reset(void)
+{
+    __atomic_store_n(&table_count, 0, __ATOMIC_RELEASE);
+}
+
+void esp_nn_autotune_print(void)
+{
+    printf("static const esp_nn_autotune_entry_t esp_nn_autotune_table[] = {\n");
+    for (int i = 0; i < table_count; i++) {
+        const esp_nn_autotune_key_t *k = &table[i].key;
+        printf("    {{%u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u}, %d},\n",
+               k->kernel, k->input_wd, k->input_ht, k->input_ch,
+               k->filter_wd, k->filter_ht, k->filter_ch, k->out_wd, k->out_ht, k->out_ch,
+               k->stride_wd, k->stride_ht, k->pad_wd, k->pad_ht, (int) table[i].path);
+    }
+    printf("};\n");
+}
+
+static void conv_key(esp_nn_autotune_key_t *key, const esp_nn_autotune_kernel_t kernel,
+                     const data_dims_t *input_dims, const data_dims_t *filter_dims,
+                     const data_dims_t *output_dims, const conv_params_t *conv_params)
+{
+    key->kernel = kernel;
+    key->input_wd = input_dims->width;
+    key->input_ht = input_dims->height;
+    key->input_ch = input_dims->channels;
+    key->filter_wd = filter_dims->width;
+    key->filter_ht = filter_dims->height;
+    key->filter_ch = filter_dims->channels;
+    key->out_wd = output_dims->width;
+    key->out_ht = output_dims->height;
+    key->out_ch = output_dims->channels;
+    key->stride_wd = conv_params->stride.width;
+    key->stride_ht = conv_params->stride.height;
+    key->pad_wd = conv_params->padding.width;
+    key->pad_ht = conv_params->padding.height;
+}
+
+static int32_t align16(const int32_t size)
+{
+    return (size + 15) & ~15;
+}
+
+/* time `paths` on synthetic data, returns the fastest or -1 without memory for the layer */
+static int32_t conv_tune(const esp_nn_conv_tuner_t *tuner,
+                         const int32_t *paths, const int32_t *scratch_sizes, const int num_paths,
+                         const data_dims_t *input_dims, const data_dims_t *filter_dims,
+                         const data_dims_t *output_dims, const conv_params_t *conv_params)
+{
+    const int32_t out_ch = output_dims->channels;
+    const int32_t input_size = input_dims->width * input_dims->height * input_dims->channels;
+    const int32_t filter_size = filter_dims->width * filter_dims->height *
+                                filter_dims->channels * out_ch;
+    const int32_t output_size = output_dims->width * output_dims->height * out_ch;
+    int32_t scratch_size = 0;
+    for (int i = 0; i < num_paths; i++) {
+        scratch_size = max(scratch_size, scratch_sizes[i]);
+    }
+
+    const int32_t total = align16(input_size) + align16(filter_size) + align16(output_size) +
+                          3 * align16(out_ch * sizeof(int32_t)) + align16(scratch_size);
+    void *mem = malloc(total + 15);
+    if (mem == NULL) {
+        return -1;
+    }
+    int8_t *input = (int8_t *) (((uintptr_t) mem + 15) & ~15);
+    int8_t *filter = input + align16(input_size);
+    int8_t *output = filter + align16(filter_size);
+    int32_t *bias = (int32_t *) (output + align16(output_size));
+    int32_t *mult = (int32_t *) ((int8_t *) bias + align16(out_ch * sizeof(int32_t)));
+    int32_t *shift = (int32_t *) ((int8_t *) mult + align16(out_ch * sizeof(int32_t)));
+    void *scratch = (int8_t *) shift + align16(out_ch * sizeof(int32_t));
+
+    /* kernel timings don't depend on the values, they only need to be valid */
+    uint32_t seed = 1;
+    for (int32_t i = 0; i < input_size; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        input[i] = (int8_t) (seed >> 24);
+    }
+    for (int32_t i = 0; i < filter_size; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        filter[i] = (int8_t) (seed >> 24);
+    }
+    for (int32_t i = 0; i < out_ch; i++) {
+        bias[i] = 0;
+        mult[i] = 0x40000000;
+        shift[i] = -8;
+    }
+    const quant_plan_data_t quant_data = {.shift = shift, .mult = mult, .plan = NULL};
+
+    int32_t best_path = -1;
+    uint32_t best_time = UINT32_MAX;
+    for (int i = 0; i < num_paths; i++) {
+        uint32_t path_time = UINT32_MAX;
+        for (int run = 0; run <= AUTOTUNE_RUNS; run++) {
+            const uint32_t t0 = esp_nn_profile_timestamp();
+            tuner->run(paths[i], input_dims, input, filter_dims, filter, bias, output_dims,
+                       output, conv_params, &quant_data, scratch);
+            const uint32_t t = esp_nn_profile_timestamp() - t0;
+            if (run > 0) {
+                path_time = min(path_time, t);
+            }
+        }
+        if (path_time < best_time) {
+            best_time = path_time;
+            best_path = paths[i];
+        }
+    }
+    free(mem);
+    return best_path;
+}
+
+int32_t esp_nn_autotune_conv_path(const esp_nn_conv_tuner_t *tuner,
+                                  const data_dims_t *input_dims,
+                                  const data_dims_t *filter_dims,
+                                  const data_dims_t *output_dims,
+                                  const conv_params_t *conv_params,
+                                  const int32_t heuristic)
+{
+    const int count = __atomic_load_n(&table_count, __ATOMIC_ACQUIRE);
+    if (count == 0 && !tuning) {
+        return heuristic;
+    }
+
+    esp_nn_autotune_key_t key;
+    conv_key(&key, tuner->kernel, input_dims, filter_dims, output_dims, conv_params);
+    const esp_nn_autotune_entry_t *entry = table_find(&key);
+    if (entry) {
+        return entry->path;
+    }
+    if (!tuning || count == CONFIG_NN_AUTOTUNE_ENTRIES) {
+        return heuristic;
+    }
+
+    /* paths are timed on one image, batches only repeat it */
+    data_dims_t image_dims = *input_dims;
+    image_dims.extra = 1;
+
+    int32_t paths[ESP_NN_AUTOTUNE_MAX_PATHS];
+    int32_t scratch_sizes[ESP_NN_AUTOTUNE_MAX_PATHS];
+    const int num_paths = tuner->candidates(&image_dims, filter_dims, output_dims, conv_params,
+                                            paths, scratch_sizes);
+    if (num_paths < 2) {
+        return heuristic;
+    }
+    int32_t path = conv_tune(tuner, paths, scratch_sizes, num_paths,
+                             &image_dims, filter_dims, output_dims, conv_params);
+    if (path < 0) {
+        /* cached too, not to retry on every call */
+        printf("esp_nn autotune: no memory to time %ux%ux%u conv, default path kept\n",
+               key.input_wd, key.input_ht, key.input_ch);
+        path = heuristic;
+    }
+    if (table_set(&key, path) == 0 && table_count == CONFIG_NN_AUTOTUNE_ENTRIES) {
+        printf("esp_nn autotune: table full, raise NN_AUTOTUNE_ENTRIES to tune more shapes\n");
+    }
+    return path;
+}
+
+#else
+
+int esp_nn_autotune_enable(bool enable)
+{
+    return -1;
+}
+
+int esp_nn_autotune_preload(const esp_nn_autotune_entry_t *entries, int count)
+{
+    return -1;
+}
+
+int esp_nn_autotune_export(esp_nn_autotune_entry_t *entries, int max_entries)
+{
+    return -1;
+}
+
+void esp_nn_autotune_reset(void)
+{
+}
+
+void esp_nn_autotune_print(void)
+{
+    printf("esp_nn autotune is disabled, enable NN_AUTOTUNE in menuconfig\n");
+}
+
+#endif
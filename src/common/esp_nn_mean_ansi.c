@@ -24,6 +24,7 @@ void esp_nn_mean_nhwc_s8_ansi(const int8_t *input,
                                const int32_t shift)
 {
     const int32_t num_elements = height * width;
+    const esp_nn_requant_t requant = esp_nn_requant_entry(multiplier, shift);
 
     for (int c = 0; c < channels; c++) {
         /* Sum over spatial dimensions */
@@ -37,8 +38,8 @@ void esp_nn_mean_nhwc_s8_ansi(const int8_t *input,
         /* Apply zero point correction */
         sum -= num_elements * input_zero_point;
 
-        /* Requantize: multiply_by_quantized_mult(sum, multiplier, shift) */
-        int32_t result = esp_nn_multiply_by_quantized_mult(sum, multiplier, shift);
+        /* Requantize */
+        int32_t result = esp_nn_requant_apply(sum, &requant);
         result += output_zero_point;
         result = max(result, -128);
         result = min(result, 127);
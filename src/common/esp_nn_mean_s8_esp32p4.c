@@ -24,6 +24,7 @@ void esp_nn_mean_nhwc_s8_esp32p4(const int8_t *input,
 {
     const int32_t num_elements = height * width;
     const int32_t ch_16 = channels >> 4;
+    const esp_nn_requant_t requant = esp_nn_requant_entry(multiplier, shift);
 
     const int8_t one_val = 1;
     if (ch_16 > 0) {
@@ -75,7 +76,7 @@ void esp_nn_mean_nhwc_s8_esp32p4(const int8_t *input,
         int32_t zp_correction = num_elements * input_zero_point;
         for (int k = 0; k < 16; k++) {
             int32_t result = sums[k] - zp_correction;
-            result = esp_nn_multiply_by_quantized_mult(result, multiplier, shift);
+            result = esp_nn_requant_apply(result, &requant);
             result += output_zero_point;
             result = max(result, -128);
             result = min(result, 127);
@@ -90,7 +91,7 @@ void esp_nn_mean_nhwc_s8_esp32p4(const int8_t *input,
             sum += input[hw * channels + ch];
         }
         sum -= num_elements * input_zero_point;
-        int32_t result = esp_nn_multiply_by_quantized_mult(sum, multiplier, shift);
+        int32_t result = esp_nn_requant_apply(sum, &requant);
         result += output_zero_point;
         result = max(result, -128);
         result = min(result, 127);
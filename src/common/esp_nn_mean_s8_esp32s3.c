@@ -26,6 +26,7 @@ void esp_nn_mean_nhwc_s8_esp32s3(const int8_t *input,
 {
     const int32_t num_elements = height * width;
     const int32_t zp_correction = num_elements * input_zero_point;
+    const esp_nn_requant_t requant = esp_nn_requant_entry(multiplier, shift);
 
     if (num_elements <= 256 && channels <= 512) {
         /* int16 accumulation (safe: 256 * 127 = 32,512 < 32,767) */
@@ -45,7 +46,7 @@ void esp_nn_mean_nhwc_s8_esp32s3(const int8_t *input,
         /* Requantize per channel */
         for (int c = 0; c < channels; c++) {
             int32_t sum = (int32_t)acc16[c] - zp_correction;
-            int32_t result = esp_nn_multiply_by_quantized_mult(sum, multiplier, shift);
+            int32_t result = esp_nn_requant_apply(sum, &requant);
             result += output_zero_point;
             result = max(result, -128);
             result = min(result, 127);
@@ -66,7 +67,7 @@ void esp_nn_mean_nhwc_s8_esp32s3(const int8_t *input,
 
         for (int c = 0; c < channels; c++) {
             int32_t sum = acc[c] - zp_correction;
-            int32_t result = esp_nn_multiply_by_quantized_mult(sum, multiplier, shift);
+            int32_t result = esp_nn_requant_apply(sum, &requant);
             result += output_zero_point;
             result = max(result, -128);
             result = min(result, 127);
@@ -80,7 +81,7 @@ void esp_nn_mean_nhwc_s8_esp32s3(const int8_t *input,
                 sum += input[i * channels + c];
             }
             sum -= zp_correction;
-            int32_t result = esp_nn_multiply_by_quantized_mult(sum, multiplier, shift);
+            int32_t result = esp_nn_requant_apply(sum, &requant);
             result += output_zero_point;
             result = max(result, -128);
             result = min(result, 127);
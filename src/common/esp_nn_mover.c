@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * memcpy tile mover: a ring of pending copies, run in order by the wait
+ * covering them, or when the ring is full by the start that needs a slot.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_nn_mover.h>
+
+#define MOVER_QUEUE_LEN     64
+
+typedef struct {
+    void *dst;
+    const void *src;
+    int32_t size;
+} mover_copy_t;
+
+typedef struct {
+    mover_copy_t queue[MOVER_QUEUE_LEN];
+    int32_t started;            // tickets handed out
+    int32_t done;               // copies run, the oldest pending one has this ticket
+} mover_memcpy_t;
+
+static void mover_run_oldest(mover_memcpy_t *mover)
+{
+    const mover_copy_t *copy = &mover->queue[mover->done % MOVER_QUEUE_LEN];
+    memcpy(copy->dst, copy->src, copy->size);
+    mover->done++;
+}
+
+static int32_t mover_memcpy_start(void *impl, void *dst, const void *src, int32_t size)
+{
+    mover_memcpy_t *mover = impl;
+
+    if (mover->started - mover->done == MOVER_QUEUE_LEN) {
+        mover_run_oldest(mover);
+    }
+    mover_copy_t *copy = &mover->queue[mover->started % MOVER_QUEUE_LEN];
+    copy->dst = dst;
+    copy->src = src;
+    copy->size = size;
+    return mover->started++;
+}
+
+static void mover_memcpy_wait(void *impl, int32_t ticket)
+{
+    mover_memcpy_t *mover = impl;
+
+    while (mover->done <= ticket && mover->done < mover->started) {
+        mover_run_oldest(mover);
+    }
+}
+
+int esp_nn_tile_mover_memcpy_init(esp_nn_tile_mover_t *mover)
+{
+    mover_memcpy_t *impl = calloc(1, sizeof(mover_memcpy_t));
+    if (impl == NULL) {
+        return -1;
+    }
+    mover->start_copy = mover_memcpy_start;
+    mover->wait = mover_memcpy_wait;
+    mover->impl = impl;
+    return 0;
+}
+
+void esp_nn_tile_mover_memcpy_deinit(esp_nn_tile_mover_t *mover)
+{
+    free(mover->impl);
+    mover->impl = NULL;
+}
@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Greedy arena planning: tensors are placed largest first, each at the
+ * lowest offset that doesn't overlap a tensor placed before it and live at
+ * the same time. Models have tens of tensors, the quadratic search is fine.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <esp_nn.h>
+#include <esp_nn_planner.h>
+#include <common_functions.h>
+
+#define PLAN_ALIGN(size)    (((size) + 15) & ~15)
+
+typedef struct {
+    int32_t size;
+    int32_t first;              // first op using the tensor
+    int32_t last;               // last op using the tensor
+    int32_t writer;             // op writing it, -1 for model inputs
+} plan_tensor_t;
+
+static int32_t dims_bytes(const data_dims_t *dims)
+{
+    return dims->width * dims->height * dims->channels * esp_nn_batches(dims);
+}
+
+static int32_t op_scratch_size(const esp_nn_plan_op_t *op)
+{
+    switch (op->op) {
+    case ESP_NN_OP_CONV:
+        return esp_nn_get_conv_scratch_size(&op->input_dims, &op->filter_dims, &op->output_dims,
+                                            (const conv_params_t *) op->params);
+    case ESP_NN_OP_DEPTHWISE_CONV:
+        return esp_nn_get_depthwise_conv_scratch_size(&op->input_dims, &op->filter_dims,
+                                                      &op->output_dims,
+                                                      (const dw_conv_params_t *) op->params);
+    case ESP_NN_OP_HARD_SWISH:
+        return esp_nn_get_hard_swish_scratch_size();
+    case ESP_NN_OP_SOFTMAX:
+        return esp_nn_get_softmax_scratch_size(op->input_dims.width, op->input_dims.height);
+    case ESP_NN_OP_LOGISTIC:
+        return esp_nn_get_logistic_s8_scratch_size();
+    default:
+        return 0;
+    }
+}
+
+static int32_t op_input_bytes(const esp_nn_plan_op_t *op, const int input)
+{
+    if (input == 1 && op->op == ESP_NN_OP_MUL_BROADCAST) {
+        return op->input_dims.channels;
+    }
+    return dims_bytes(&op->input_dims);
+}
+
+static int use_tensor(plan_tensor_t *tensors, const int32_t num_tensors, const int32_t id,
+                      const int32_t op_idx, const int32_t size)
+{
+    if (id < 0 || id >= num_tensors) {
+        printf("esp_nn_plan_arena: op %d uses tensor %d, out of range\n", (int) op_idx, (int) id);
+        return -1;
+    }
+    plan_tensor_t *t = &tensors[id];
+    if (t->first < 0) {
+        t->first = op_idx;
+    }
+    t->last = op_idx;
+    t->size = max(t->size, size);
+    return 0;
+}
+
+int esp_nn_plan_arena(const esp_nn_plan_op_t *ops, const int32_t num_ops,
+                      const int32_t num_tensors, esp_nn_plan_t *plan,
+                      int32_t *tensor_offsets)
+{
+    plan_tensor_t *tensors = malloc(num_tensors * (sizeof(plan_tensor_t) + sizeof(int32_t)));
+    if (tensors == NULL) {
+        printf("esp_nn_plan_arena: no memory for %d tensors\n", (int) num_tensors);
+        return -1;
+    }
+    /* placement order, largest first */
+    int32_t *order = (int32_t *) (tensors + num_tensors);
+
+    for (int32_t i = 0; i < num_tensors; i++) {
+        tensors[i] = (plan_tensor_t) {.size = 0, .first = -1, .last = -1, .writer = -1};
+        tensor_offsets[i] = -1;
+    }
+
+    int32_t scratch_size = 0;
+    for (int32_t i = 0; i < num_ops; i++) {
+        const esp_nn_plan_op_t *op = &ops[i];
+        for (int in = 0; in < ESP_NN_PLAN_MAX_INPUTS; in++) {
+            if (op->inputs[in] >= 0 &&
+                    use_tensor(tensors, num_tensors, op->inputs[in], i, op_input_bytes(op, in)) != 0) {
+                goto fail;
+            }
+        }
+        if (use_tensor(tensors, num_tensors, op->output, i, dims_bytes(&op->output_dims)) != 0) {
+            goto fail;
+        }
+        plan_tensor_t *out = &tensors[op->output];
+        if (out->writer >= 0) {
+            printf("esp_nn_plan_arena: tensor %d written by ops %d and %d\n",
+                   (int) op->output, (int) out->writer, (int) i);
+            goto fail;
+        }
+        out->writer = i;
+        scratch_size = max(scratch_size, op_scratch_size(op));
+    }
+
+    int32_t num_used = 0;
+    int32_t tensors_size = 0;
+    for (int32_t i = 0; i < num_tensors; i++) {
+        plan_tensor_t *t = &tensors[i];
+        if (t->first < 0) {
+            continue;
+        }
+        if (t->writer < 0) {
+            t->first = 0;                   // model input
+        } else if (t->last == t->writer) {
+            t->last = num_ops - 1;          // model output
+        }
+        t->size = PLAN_ALIGN(t->size);
+        tensors_size += t->size;
+
+        /* insertion sort by size, ties in tensor order */
+        int32_t j = num_used++;
+        while (j > 0 && tensors[order[j - 1]].size < t->size) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    /* the scratch region comes first, tensors are placed above it */
+    const int32_t scratch_region = PLAN_ALIGN(scratch_size);
+    int32_t arena_size = scratch_region;
+    for (int32_t k = 0; k < num_used; k++) {
+        const plan_tensor_t *t = &tensors[order[k]];
+        int32_t offset = scratch_region;
+        bool moved = true;
+        /* bump past every overlapping live tensor until a gap fits */
+        while (moved) {
+            moved = false;
+            for (int32_t p = 0; p < k; p++) {
+                const int32_t id = order[p];
+                const plan_tensor_t *placed = &tensors[id];
+                if (placed->last < t->first || placed->first > t->last) {
+                    continue;
+                }
+                const int32_t placed_end = tensor_offsets[id] + placed->size;
+                if (offset < placed_end && tensor_offsets[id] < offset + t->size) {
+                    offset = placed_end;
+                    moved = true;
+                }
+            }
+        }
+        tensor_offsets[order[k]] = offset;
+        arena_size = max(arena_size, offset + t->size);
+    }
+
+    plan->arena_size = arena_size;
+    plan->scratch_offset = 0;
+    plan->scratch_size = scratch_size;
+    plan->tensors_size = tensors_size;
+    free(tensors);
+    return 0;
+
+fail:
+    free(tensors);
+    return -1;
+}
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <esp_nn_profile.h>
+
+#if defined(ESP_PLATFORM)
+#include <esp_cpu.h>
+#else
+#include <time.h>
+#endif
+
+static const char *const op_names[ESP_NN_OP_MAX] = {
+    [ESP_NN_OP_ADD] = "add_elementwise_s8",
+    [ESP_NN_OP_MUL] = "mul_elementwise_s8",
+    [ESP_NN_OP_MUL_BROADCAST] = "mul_broadcast_channel_s8",
+    [ESP_NN_OP_CONV] = "conv_s8",
+    [ESP_NN_OP_DEPTHWISE_CONV] = "depthwise_conv_s8",
+    [ESP_NN_OP_FULLY_CONNECTED] = "fully_connected_s8",
+    [ESP_NN_OP_AVG_POOL] = "avg_pool_s8",
+    [ESP_NN_OP_MAX_POOL] = "max_pool_s8",
+    [ESP_NN_OP_RELU6] = "relu6_s8",
+    [ESP_NN_OP_HARD_SWISH] = "hard_swish_s8",
+    [ESP_NN_OP_MEAN] = "mean_nhwc_s8",
+    [ESP_NN_OP_SOFTMAX] = "softmax_s8",
+    [ESP_NN_OP_LOGISTIC] = "logistic_s8",
+};
+
+const char *esp_nn_op_name(const esp_nn_op_t op)
+{
+    if ((unsigned) op >= ESP_NN_OP_MAX) {
+        return "unknown";
+    }
+    return op_names[op];
+}
+
+uint32_t esp_nn_profile_timestamp(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_cpu_get_cycle_count();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) ((uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec);
+#endif
+}
+
+#if ESP_NN_PROFILING_ENABLED
+
+static struct {
+    esp_nn_profile_hook_t begin;
+    esp_nn_profile_hook_t end;
+    void *user_data;
+} hooks;
+
+int esp_nn_profile_register(esp_nn_profile_hook_t begin, esp_nn_profile_hook_t end,
+                            void *user_data)
+{
+    /* hooks are cleared first: a call running meanwhile never pairs them with another user_data */
+    hooks.begin = NULL;
+    hooks.end = NULL;
+    hooks.user_data = user_data;
+    hooks.end = end;
+    hooks.begin = begin;
+    return 0;
+}
+
+void esp_nn_profile_begin(esp_nn_profile_event_t *event)
+{
+    esp_nn_profile_hook_t begin = hooks.begin;
+
+    if (begin) {
+        event->timestamp = esp_nn_profile_timestamp();
+        begin(event, hooks.user_data);
+    }
+}
+
+void esp_nn_profile_end(esp_nn_profile_event_t *event)
+{
+    esp_nn_profile_hook_t end = hooks.end;
+
+    if (end) {
+        event->timestamp = esp_nn_profile_timestamp();
+        end(event, hooks.user_data);
+    }
+}
+
+#else
+
+int esp_nn_profile_register(esp_nn_profile_hook_t begin, esp_nn_profile_hook_t end,
+                            void *user_data)
+{
+    return -1;
+}
+
+void esp_nn_profile_begin(esp_nn_profile_event_t *event)
+{
+}
+
+void esp_nn_profile_end(esp_nn_profile_event_t *event)
+{
+}
+
+#endif
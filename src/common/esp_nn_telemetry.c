@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <common_functions.h>
+#include <esp_nn_telemetry.h>
+
+static const char *const path_names[ESP_NN_PATH_MAX] = {
+    [ESP_NN_PATH_CONV_ANSI] = "conv_s8/ansi",
+    [ESP_NN_PATH_CONV_1X1_ASM] = "conv_s8/1x1_asm",
+    [ESP_NN_PATH_CONV_1X1] = "conv_s8/1x1",
+    [ESP_NN_PATH_CONV_IM2COL] = "conv_s8/im2col",
+    [ESP_NN_PATH_CONV_PADDED] = "conv_s8/padded",
+    [ESP_NN_PATH_CONV_TILED] = "conv_s8/tiled",
+    [ESP_NN_PATH_CONV_GENERAL] = "conv_s8/general",
+    [ESP_NN_PATH_FC_S8] = "fully_connected_s8/s8",
+    [ESP_NN_PATH_FC_S16] = "fully_connected_s8/s16",
+    [ESP_NN_PATH_FC_C] = "fully_connected_s8/c",
+    [ESP_NN_PATH_FC_PREPARED_S8] = "fully_connected_s8_run/s8",
+    [ESP_NN_PATH_FC_PREPARED_C] = "fully_connected_s8_run/c",
+    [ESP_NN_PATH_AVG_POOL_ASM] = "avg_pool_s8/asm",
+    [ESP_NN_PATH_AVG_POOL_C] = "avg_pool_s8/c",
+};
+
+const char *esp_nn_path_name(const esp_nn_path_t path)
+{
+    if ((unsigned) path >= ESP_NN_PATH_MAX) {
+        return "unknown";
+    }
+    return path_names[path];
+}
+
+#if ESP_NN_TELEMETRY_ENABLED
+
+static esp_nn_path_stats_t path_stats[ESP_NN_PATH_MAX];
+
+/* Kernels run from several tasks/cores: counters are updated atomically */
+void esp_nn_telemetry_record(const esp_nn_path_t path, const uint32_t cycles)
+{
+    __atomic_fetch_add(&path_stats[path].calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&path_stats[path].cycles, (uint64_t) cycles, __ATOMIC_RELAXED);
+}
+
+int esp_nn_telemetry_get(const esp_nn_path_t path, esp_nn_path_stats_t *stats)
+{
+    if ((unsigned) path >= ESP_NN_PATH_MAX) {
+        return -1;
+    }
+    stats->calls = __atomic_load_n(&path_stats[path].calls, __ATOMIC_RELAXED);
+    stats->cycles = __atomic_load_n(&path_stats[path].cycles, __ATOMIC_RELAXED);
+    return 0;
+}
+
+void esp_nn_telemetry_reset(void)
+{
+    for (int i = 0; i < ESP_NN_PATH_MAX; i++) {
+        __atomic_store_n(&path_stats[i].calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&path_stats[i].cycles, 0, __ATOMIC_RELAXED);
+    }
+}
+
+void esp_nn_telemetry_print(void)
+{
+    for (int i = 0; i < ESP_NN_PATH_MAX; i++) {
+        esp_nn_path_stats_t stats;
+        esp_nn_telemetry_get((esp_nn_path_t) i, &stats);
+        if (stats.calls == 0) {
+            continue;
+        }
+        printf("%-28s calls %10u cycles %14llu avg %10llu\n", path_names[i],
+               (unsigned) stats.calls, (unsigned long long) stats.cycles,
+               (unsigned long long) (stats.cycles / stats.calls));
+    }
+}
+
+#else
+
+int esp_nn_telemetry_get(const esp_nn_path_t path, esp_nn_path_stats_t *stats)
+{
+    memset(stats, 0, sizeof(esp_nn_path_stats_t));
+    return -1;
+}
+
+void esp_nn_telemetry_reset(void)
+{
+}
+
+void esp_nn_telemetry_print(void)
+{
+    printf("esp_nn telemetry is disabled, enable NN_TELEMETRY in menuconfig\n");
+}
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Split of conv / depthwise conv layers across workers.
+ *
+ * A part covers output rows [y0, y1) of the layer. It gets the input rows
+ * those outputs read, with the top padding only where the part starts above
+ * the input: the regular kernel then computes exactly the same outputs as
+ * for the whole layer. Single pixel outputs (e.g. the 1x1 convs of a
+ * squeeze-and-excite block) are split by groups of 16 output channels.
+ * Parts are one image high: each worker runs its part of every image of a
+ * batch in turn.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <esp_nn.h>
+#include <esp_nn_workers.h>
+#include <common_functions.h>
+
+#define WORKERS_CH_BLOCK    16
+
+typedef struct {
+    data_dims_t input_dims;
+    data_dims_t output_dims;
+    int32_t pad_top;
+    int32_t in_row;             // first input row of the part
+    int32_t out_row;            // first output row of the part
+} rows_part_t;
+
+typedef struct {
+    const esp_nn_workers_t *workers;
+    int32_t num_parts;
+    bool by_channels;
+    const data_dims_t *input_dims;
+    const int8_t *input_data;
+    const data_dims_t *filter_dims;
+    const int8_t *filter_data;
+    const int32_t *bias;
+    const data_dims_t *output_dims;
+    int8_t *out_data;
+    const conv_params_t *conv_params;
+    const dw_conv_params_t *dw_params;
+    const quant_plan_data_t *quant_data;
+} layer_job_t;
+
+static inline int32_t min_i32(int32_t a, int32_t b)
+{
+    return a < b ? a : b;
+}
+
+static inline int32_t max_i32(int32_t a, int32_t b)
+{
+    return a > b ? a : b;
+}
+
+static int32_t num_row_parts(const int32_t num_workers, const data_dims_t *output_dims)
+{
+    return max_i32(1, min_i32(num_workers, output_dims->height));
+}
+
+static int32_t num_ch_parts(const int32_t num_workers, const data_dims_t *output_dims)
+{
+    const int32_t blocks = output_dims->channels / WORKERS_CH_BLOCK;
+    return max_i32(1, min_i32(num_workers, blocks));
+}
+
+static bool conv_split_by_channels(const int32_t num_workers,
+                                   const data_dims_t *input_dims,
+                                   const data_dims_t *filter_dims,
+                                   const data_dims_t *output_dims)
+{
+    return output_dims->height == 1 && output_dims->width == 1 &&
+           filter_dims->channels == input_dims->channels &&
+           num_ch_parts(num_workers, output_dims) > 1;
+}
+
+static void rows_part(const data_dims_t *input_dims, const data_dims_t *output_dims,
+                      const int32_t filter_ht, const int32_t stride_ht,
+                      const int32_t dilation_ht, const int32_t pad_ht,
+                      const int32_t part, const int32_t num_parts, rows_part_t *p)
+{
+    const int32_t rows_per_part = (output_dims->height + num_parts - 1) / num_parts;
+    const int32_t y0 = min_i32(part * rows_per_part, output_dims->height);
+    const int32_t y1 = min_i32(y0 + rows_per_part, output_dims->height);
+    const int32_t dilation = max_i32(1, dilation_ht);
+    const int32_t in_first = y0 * stride_ht - pad_ht;
+    const int32_t in_end = (y1 - 1) * stride_ht - pad_ht + dilation * (filter_ht - 1) + 1;
+
+    p->in_row = max_i32(0, in_first);
+    p->pad_top = p->in_row - in_first;
+    p->out_row = y0;
+    p->input_dims = *input_dims;
+    p->input_dims.height = max_i32(0, min_i32(input_dims->height, in_end) - p->in_row);
+    p->input_dims.extra = 1;
+    p->output_dims = *output_dims;
+    p->output_dims.height = y1 - y0;
+}
+
+static void ch_part(const data_dims_t *output_dims, const int32_t part, const int32_t num_parts,
+                    int32_t *ch0, int32_t *ch1)
+{
+    const int32_t blocks = output_dims->channels / WORKERS_CH_BLOCK;
+    const int32_t blocks_per_part = (blocks + num_parts - 1) / num_parts;
+
+    *ch0 = min_i32(part * blocks_per_part * WORKERS_CH_BLOCK, output_dims->channels);
+    *ch1 = part == num_parts - 1 ? output_dims->channels :
+           min_i32(*ch0 + blocks_per_part * WORKERS_CH_BLOCK, output_dims->channels);
+}
+
+static data_dims_t image_dims(const data_dims_t *dims)
+{
+    data_dims_t image = *dims;
+    image.extra = 1;
+    return image;
+}
+
+static int32_t image_size(const data_dims_t *dims)
+{
+    return dims->width * dims->height * dims->channels;
+}
+
+static void run_parts(const esp_nn_workers_t *workers, esp_nn_worker_fn_t fn,
+                      layer_job_t *job)
+{
+    if (job->num_parts == 1) {
+        fn(job, 0);
+    } else if (workers->backend == NULL) {
+        for (int32_t w = 0; w < job->num_parts; w++) {
+            fn(job, w);
+        }
+    } else {
+        workers->backend->run(workers->backend->impl, fn, job, job->num_parts);
+    }
+}
+
+/****************************** convolution ******************************/
+
+static void conv_worker(void *arg, int32_t worker)
+{
+    const layer_job_t *job = arg;
+    const esp_nn_ctx_t *ctx = &job->workers->ctx[worker];
+
+    if (worker >= job->num_parts) {
+        return;
+    }
+    if (job->by_channels) {
+        const int32_t filter_size = job->filter_dims->width * job->filter_dims->height *
+                                    job->filter_dims->channels;
+        int32_t ch0, ch1;
+        ch_part(job->output_dims, worker, job->num_parts, &ch0, &ch1);
+        if (ch0 == ch1) {
+            return;
+        }
+        const data_dims_t input_dims = image_dims(job->input_dims);
+        data_dims_t output_dims = *job->output_dims;
+        output_dims.channels = ch1 - ch0;
+        const quant_plan_data_t quant_data = {
+            .shift = job->quant_data->shift + ch0,
+            .mult = job->quant_data->mult + ch0,
+            .plan = job->quant_data->plan ? job->quant_data->plan + ch0 : NULL,
+        };
+        /* NHWC with a single pixel: the part's channels are contiguous in each image's output */
+        for (int32_t batch = 0; batch < esp_nn_batches(job->input_dims); batch++) {
+            esp_nn_conv_s8_plan(ctx, &input_dims,
+                                job->input_data + batch * image_size(job->input_dims),
+                                job->filter_dims, job->filter_data + ch0 * filter_size,
+                                job->bias ? job->bias + ch0 : NULL, &output_dims,
+                                job->out_data + batch * image_size(job->output_dims) + ch0,
+                                job->conv_params, &quant_data);
+        }
+        return;
+    }
+
+    const conv_params_t *params = job->conv_params;
+    rows_part_t p;
+    rows_part(job->input_dims, job->output_dims, job->filter_dims->height,
+              params->stride.height, params->dilation.height, params->padding.height,
+              worker, job->num_parts, &p);
+    if (p.output_dims.height == 0) {
+        return;
+    }
+    conv_params_t part_params = *params;
+    part_params.padding.height = p.pad_top;
+    const int32_t in_row_size = job->input_dims->width * job->input_dims->channels;
+    const int32_t out_row_size = job->output_dims->width * job->output_dims->channels;
+
+    for (int32_t batch = 0; batch < esp_nn_batches(job->input_dims); batch++) {
+        const int8_t *input_data = job->input_data + batch * image_size(job->input_dims);
+        int8_t *out_data = job->out_data + batch * image_size(job->output_dims);
+        esp_nn_conv_s8_plan(ctx, &p.input_dims, input_data + p.in_row * in_row_size,
+                            job->filter_dims, job->filter_data, job->bias,
+                            &p.output_dims, out_data + p.out_row * out_row_size,
+                            &part_params, job->quant_data);
+    }
+}
+
+int32_t esp_nn_get_conv_workers_scratch_size(const int32_t num_workers,
+                                             const data_dims_t *input_dims,
+                                             const data_dims_t *filter_dims,
+                                             const data_dims_t *output_dims,
+                                             const conv_params_t *conv_params)
+{
+    int32_t size = 0;
+
+    if (conv_split_by_channels(num_workers, input_dims, filter_dims, output_dims)) {
+        const data_dims_t image = image_dims(input_dims);
+        const int32_t num_parts = num_ch_parts(num_workers, output_dims);
+        for (int32_t part = 0; part < num_parts; part++) {
+            int32_t ch0, ch1;
+            ch_part(output_dims, part, num_parts, &ch0, &ch1);
+            data_dims_t part_out = *output_dims;
+            part_out.channels = ch1 - ch0;
+            size = max_i32(size, esp_nn_get_conv_scratch_size(&image, filter_dims,
+                                                              &part_out, conv_params));
+        }
+        return size;
+    }
+
+    const int32_t num_parts = num_row_parts(num_workers, output_dims);
+    for (int32_t part = 0; part < num_parts; part++) {
+        rows_part_t p;
+        rows_part(input_dims, output_dims, filter_dims->height, conv_params->stride.height,
+                  conv_params->dilation.height, conv_params->padding.height,
+                  part, num_parts, &p);
+        conv_params_t part_params = *conv_params;
+        part_params.padding.height = p.pad_top;
+        size = max_i32(size, esp_nn_get_conv_scratch_size(&p.input_dims, filter_dims,
+                                                          &p.output_dims, &part_params));
+    }
+    return size;
+}
+
+void esp_nn_conv_s8_workers_plan(const esp_nn_workers_t *workers,
+                                 const data_dims_t *input_dims,
+                                 const int8_t *input_data,
+                                 const data_dims_t *filter_dims,
+                                 const int8_t *filter_data,
+                                 const int32_t *bias,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const conv_params_t *conv_params,
+                                 const quant_plan_data_t *quant_data)
+{
+    const bool by_channels = conv_split_by_channels(workers->num_workers, input_dims,
+                                                    filter_dims, output_dims);
+    layer_job_t job = {
+        .workers = workers,
+        .num_parts = by_channels ? num_ch_parts(workers->num_workers, output_dims) :
+                                   num_row_parts(workers->num_workers, output_dims),
+        .by_channels = by_channels,
+        .input_dims = input_dims,
+        .input_data = input_data,
+        .filter_dims = filter_dims,
+        .filter_data = filter_data,
+        .bias = bias,
+        .output_dims = output_dims,
+        .out_data = out_data,
+        .conv_params = conv_params,
+        .quant_data = quant_data,
+    };
+    run_parts(workers, conv_worker, &job);
+}
+
+void esp_nn_conv_s8_workers(const esp_nn_workers_t *workers,
+                            const data_dims_t *input_dims,
+                            const int8_t *input_data,
+                            const data_dims_t *filter_dims,
+                            const int8_t *filter_data,
+                            const int32_t *bias,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            const conv_params_t *conv_params,
+                            const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_workers_plan(workers, input_dims, input_data, filter_dims, filter_data,
+                                bias, output_dims, out_data, conv_params, &no_plan);
+}
+
+/************************** depthwise convolution ****************************/
+
+static void dw_worker(void *arg, int32_t worker)
+{
+    const layer_job_t *job = arg;
+    const dw_conv_params_t *params = job->dw_params;
+    rows_part_t p;
+
+    if (worker >= job->num_parts) {
+        return;
+    }
+    rows_part(job->input_dims, job->output_dims, job->filter_dims->height,
+              params->stride.height, params->dilation.height, params->padding.height,
+              worker, job->num_parts, &p);
+    if (p.output_dims.height == 0) {
+        return;
+    }
+    dw_conv_params_t part_params = *params;
+    part_params.padding.height = p.pad_top;
+    const int32_t in_row_size = job->input_dims->width * job->input_dims->channels;
+    const int32_t out_row_size = job->output_dims->width * job->output_dims->channels;
+
+    for (int32_t batch = 0; batch < esp_nn_batches(job->input_dims); batch++) {
+        const int8_t *input_data = job->input_data + batch * image_size(job->input_dims);
+        int8_t *out_data = job->out_data + batch * image_size(job->output_dims);
+        esp_nn_depthwise_conv_s8_plan(&job->workers->ctx[worker], &p.input_dims,
+                                      input_data + p.in_row * in_row_size,
+                                      job->filter_dims, job->filter_data, job->bias,
+                                      &p.output_dims, out_data + p.out_row * out_row_size,
+                                      &part_params, job->quant_data);
+    }
+}
+
+int32_t esp_nn_get_depthwise_conv_workers_scratch_size(const int32_t num_workers,
+                                                       const data_dims_t *input_dims,
+                                                       const data_dims_t *filter_dims,
+                                                       const data_dims_t *output_dims,
+                                                       const dw_conv_params_t *conv_params)
+{
+    const int32_t num_parts = num_row_parts(num_workers, output_dims);
+    int32_t size = 0;
+
+    for (int32_t part = 0; part < num_parts; part++) {
+        rows_part_t p;
+        rows_part(input_dims, output_dims, filter_dims->height, conv_params->stride.height,
+                  conv_params->dilation.height, conv_params->padding.height,
+                  part, num_parts, &p);
+        dw_conv_params_t part_params = *conv_params;
+        part_params.padding.height = p.pad_top;
+        size = max_i32(size, esp_nn_get_depthwise_conv_scratch_size(&p.input_dims, filter_dims,
+                                                                    &p.output_dims,
+                                                                    &part_params));
+    }
+    return size;
+}
+
+void esp_nn_depthwise_conv_s8_workers_plan(const esp_nn_workers_t *workers,
+                                           const data_dims_t *input_dims,
+                                           const int8_t *input_data,
+                                           const data_dims_t *filter_dims,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           const data_dims_t *output_dims,
+                                           int8_t *out_data,
+                                           const dw_conv_params_t *conv_params,
+                                           const quant_plan_data_t *quant_data)
+{
+    layer_job_t job = {
+        .workers = workers,
+        .num_parts = num_row_parts(workers->num_workers, output_dims),
+        .input_dims = input_dims,
+        .input_data = input_data,
+        .filter_dims = filter_dims,
+        .filter_data = filter_data,
+        .bias = bias,
+        .output_dims = output_dims,
+        .out_data = out_data,
+        .dw_params = conv_params,
+        .quant_data = quant_data,
+    };
+    run_parts(workers, dw_worker, &job);
+}
+
+void esp_nn_depthwise_conv_s8_workers(const esp_nn_workers_t *workers,
+                                      const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const dw_conv_params_t *conv_params,
+                                      const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_depthwise_conv_s8_workers_plan(workers, input_dims, input_data, filter_dims,
+                                          filter_data, bias, output_dims, out_data,
+                                          conv_params, &no_plan);
+}
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * FreeRTOS worker backend: `num_workers - 1` tasks, each woken through its
+ * own semaphore, signalling a shared counting semaphore when done. Worker 0
+ * runs on the calling task.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#include <esp_nn_workers.h>
+
+typedef struct freertos_pool freertos_pool_t;
+
+typedef struct {
+    freertos_pool_t *pool;
+    int32_t worker;
+    TaskHandle_t task;
+    SemaphoreHandle_t start;
+} freertos_worker_t;
+
+struct freertos_pool {
+    freertos_worker_t workers[ESP_NN_MAX_WORKERS - 1];
+    int32_t num_tasks;
+    SemaphoreHandle_t done;
+    volatile bool quit;
+    esp_nn_worker_fn_t fn;
+    void *arg;
+    int32_t num_workers;        // of the current job
+};
+
+static void freertos_worker_main(void *arg)
+{
+    freertos_worker_t *w = arg;
+    freertos_pool_t *pool = w->pool;
+
+    for (;;) {
+        xSemaphoreTake(w->start, portMAX_DELAY);
+        if (pool->quit) {
+            break;
+        }
+        if (w->worker < pool->num_workers) {
+            pool->fn(pool->arg, w->worker);
+        }
+        xSemaphoreGive(pool->done);
+    }
+    xSemaphoreGive(pool->done);
+    vTaskDelete(NULL);
+}
+
+static void freertos_pool_run(void *impl, esp_nn_worker_fn_t fn, void *arg, int32_t num_workers)
+{
+    freertos_pool_t *pool = impl;
+
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->num_workers = num_workers;
+    /* only wake the tasks that have a part */
+    const int32_t num_tasks = num_workers - 1 < pool->num_tasks ? num_workers - 1 : pool->num_tasks;
+    for (int32_t i = 0; i < num_tasks; i++) {
+        xSemaphoreGive(pool->workers[i].start);
+    }
+
+    fn(arg, 0);
+
+    for (int32_t i = 0; i < num_tasks; i++) {
+        xSemaphoreTake(pool->done, portMAX_DELAY);
+    }
+}
+
+int esp_nn_worker_backend_freertos_init(esp_nn_worker_backend_t *backend,
+                                        const int32_t num_workers,
+                                        const uint32_t priority,
+                                        const uint32_t stack_size,
+                                        const int32_t core_id)
+{
+    if (num_workers < 1 || num_workers > ESP_NN_MAX_WORKERS) {
+        printf("esp_nn_worker_backend_freertos_init: num_workers %d out of range\n",
+               (int) num_workers);
+        return -1;
+    }
+    freertos_pool_t *pool = calloc(1, sizeof(freertos_pool_t));
+    if (pool == NULL) {
+        return -1;
+    }
+    backend->run = freertos_pool_run;
+    backend->impl = pool;
+    pool->done = xSemaphoreCreateCounting(ESP_NN_MAX_WORKERS, 0);
+    if (pool->done == NULL) {
+        esp_nn_worker_backend_freertos_deinit(backend);
+        return -1;
+    }
+
+    for (int32_t i = 0; i < num_workers - 1; i++) {
+        freertos_worker_t *w = &pool->workers[i];
+        const BaseType_t core = core_id < 0 ? tskNO_AFFINITY :
+                                (BaseType_t) ((core_id + i) % portNUM_PROCESSORS);
+        w->pool = pool;
+        w->worker = i + 1;
+        w->start = xSemaphoreCreateBinary();
+        if (w->start == NULL) {
+            esp_nn_worker_backend_freertos_deinit(backend);
+            return -1;
+        }
+        if (xTaskCreatePinnedToCore(freertos_worker_main, "esp_nn_worker", stack_size, w,
+                                    priority, &w->task, core) != pdPASS) {
+            vSemaphoreDelete(w->start);
+            w->start = NULL;
+            esp_nn_worker_backend_freertos_deinit(backend);
+            return -1;
+        }
+        pool->num_tasks++;
+    }
+    return 0;
+}
+
+void esp_nn_worker_backend_freertos_deinit(esp_nn_worker_backend_t *backend)
+{
+    freertos_pool_t *pool = backend->impl;
+
+    if (pool == NULL) {
+        return;
+    }
+    pool->quit = true;
+    for (int32_t i = 0; i < pool->num_tasks; i++) {
+        xSemaphoreGive(pool->workers[i].start);
+    }
+    for (int32_t i = 0; i < pool->num_tasks; i++) {
+        xSemaphoreTake(pool->done, portMAX_DELAY);
+    }
+    for (int32_t i = 0; i < ESP_NN_MAX_WORKERS - 1; i++) {
+        if (pool->workers[i].start) {
+            vSemaphoreDelete(pool->workers[i].start);
+        }
+    }
+    if (pool->done) {
+        vSemaphoreDelete(pool->done);
+    }
+    free(pool);
+    backend->run = NULL;
+    backend->impl = NULL;
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * pthread worker backend: a persistent pool of `num_workers - 1` threads
+ * waiting on a job generation counter, worker 0 runs on the caller.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include <esp_nn_workers.h>
+
+typedef struct {
+    pthread_t threads[ESP_NN_MAX_WORKERS - 1];
+    int32_t num_threads;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint32_t generation;
+    int32_t pending;
+    bool quit;
+    esp_nn_worker_fn_t fn;
+    void *arg;
+    int32_t num_workers;        // of the current job
+} pthread_pool_t;
+
+typedef struct {
+    pthread_pool_t *pool;
+    int32_t worker;
+} pthread_worker_t;
+
+static void *pthread_worker_main(void *arg)
+{
+    pthread_pool_t *pool = ((pthread_worker_t *) arg)->pool;
+    const int32_t worker = ((pthread_worker_t *) arg)->worker;
+    uint32_t seen = 0;
+
+    free(arg);
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->generation == seen && !pool->quit) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->quit) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        esp_nn_worker_fn_t fn = pool->fn;
+        void *job = pool->arg;
+        const int32_t num_workers = pool->num_workers;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (worker < num_workers) {
+            fn(job, worker);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+static void pthread_pool_run(void *impl, esp_nn_worker_fn_t fn, void *arg, int32_t num_workers)
+{
+    pthread_pool_t *pool = impl;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->num_workers = num_workers;
+    pool->pending = pool->num_threads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    fn(arg, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending != 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int esp_nn_worker_backend_pthread_init(esp_nn_worker_backend_t *backend,
+                                       const int32_t num_workers)
+{
+    if (num_workers < 1 || num_workers > ESP_NN_MAX_WORKERS) {
+        printf("esp_nn_worker_backend_pthread_init: num_workers %d out of range\n",
+               (int) num_workers);
+        return -1;
+    }
+    pthread_pool_t *pool = calloc(1, sizeof(pthread_pool_t));
+    if (pool == NULL) {
+        return -1;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    backend->run = pthread_pool_run;
+    backend->impl = pool;
+
+    for (int32_t i = 0; i < num_workers - 1; i++) {
+        pthread_worker_t *arg = malloc(sizeof(pthread_worker_t));
+        if (arg == NULL) {
+            esp_nn_worker_backend_pthread_deinit(backend);
+            return -1;
+        }
+        arg->pool = pool;
+        arg->worker = i + 1;
+        if (pthread_create(&pool->threads[i], NULL, pthread_worker_main, arg) != 0) {
+            free(arg);
+            esp_nn_worker_backend_pthread_deinit(backend);
+            return -1;
+        }
+        pool->num_threads++;
+    }
+    return 0;
+}
+
+void esp_nn_worker_backend_pthread_deinit(esp_nn_worker_backend_t *backend)
+{
+    pthread_pool_t *pool = backend->impl;
+
+    if (pool == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (int32_t i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+    backend->run = NULL;
+    backend->impl = NULL;
+}
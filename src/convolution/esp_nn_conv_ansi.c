@@ -104,8 +104,94 @@ void esp_nn_conv_u8_ansi(const uint8_t *input_data,
 /**
  * Assumption 1: i/p channels == o/p channels
  * Assumption 2: Pointers are valid
- * Assumption 3: dialation width = 1
+ * No scratch needed, the context is ignored
  */
+void esp_nn_conv_s8_plan_ansi(const esp_nn_ctx_t *ctx,
+                              const data_dims_t *input_dims,
+                              const int8_t *input_data,
+                              const data_dims_t *filter_dims,
+                              const int8_t *filter_data,
+                              const int32_t *bias,
+                              const data_dims_t *output_dims,
+                              int8_t *out_data,
+                              const conv_params_t *conv_params,
+                              const quant_plan_data_t *quant_data)
+{
+    (void) ctx;
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t input_ht = input_dims->height;
+    const uint16_t in_channels = input_dims->channels;
+    const int32_t input_offset = conv_params->in_offset;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t pad_wd = conv_params->padding.width;
+    const uint16_t pad_ht = conv_params->padding.height;
+    const uint16_t stride_wd = conv_params->stride.width;
+    const uint16_t stride_ht = conv_params->stride.height;
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const uint16_t out_channels = output_dims->channels;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+    const int32_t dilation_wd = esp_nn_dilation(conv_params->dilation.width);
+    const int32_t dilation_ht = esp_nn_dilation(conv_params->dilation.height);
+
+    /* Fall back to in_channels when filter_dims->channels is unset (legacy callers). */
+    const uint16_t filter_ch = filter_dims->channels ? filter_dims->channels : in_channels;
+    const int32_t groups = in_channels / filter_ch;
+    const int32_t filters_per_group = out_channels / groups;
+
+    int32_t out_ch_idx, out_y, out_x, in_ch_idx, filter_y_idx, filter_x_idx;
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (out_y = 0; out_y < out_ht; out_y++) {
+            for (out_x = 0; out_x < out_wd; out_x++) {
+                for (out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
+                    int32_t conv_out = 0;
+                    const int32_t group = out_ch_idx / filters_per_group;
+                    const int32_t in_ch_start = group * filter_ch;
+
+                    const int32_t base_y = stride_ht * out_y - pad_ht;
+                    const int32_t base_x = stride_wd * out_x - pad_wd;
+
+                    int32_t filter_y_start, filter_y_end, filter_x_start, filter_x_end;
+                    esp_nn_filter_taps(base_y, filter_ht, dilation_ht, input_ht,
+                                       &filter_y_start, &filter_y_end);
+                    esp_nn_filter_taps(base_x, filter_wd, dilation_wd, input_wd,
+                                       &filter_x_start, &filter_x_end);
+
+                    for (filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
+                        for (filter_x_idx = filter_x_start; filter_x_idx < filter_x_end; filter_x_idx++) {
+                            const int32_t in_row = base_y + filter_y_idx * dilation_ht;
+                            const int32_t in_col = base_x + filter_x_idx * dilation_wd;
+                            int32_t input_base_offset = (in_row * input_wd + in_col) * in_channels + in_ch_start;
+                            int32_t filter_base_offset = out_ch_idx * filter_ch * filter_ht * filter_wd +
+                                                           (filter_y_idx * filter_wd + filter_x_idx) * filter_ch;
+                            for (in_ch_idx = 0; in_ch_idx < filter_ch; in_ch_idx++) {
+                                conv_out +=
+                                    (input_data[input_base_offset + in_ch_idx] + input_offset) *
+                                    filter_data[filter_base_offset + in_ch_idx];
+                            }
+                        }
+                    }
+                    if (bias) {
+                        conv_out += bias[out_ch_idx];
+                    }
+                    conv_out = esp_nn_requantize_ch_exact(conv_out, quant_data, out_ch_idx);
+                    conv_out += out_offset;
+                    conv_out = max(conv_out, activation_min);
+                    conv_out = min(conv_out, activation_max);
+                    *out_data++ = (int8_t) conv_out;
+                }
+            }
+        }
+    }
+}
+
 void esp_nn_conv_s8_ansi(const data_dims_t *input_dims,
                          const int8_t *input_data,
                          const data_dims_t *filter_dims,
@@ -115,6 +201,148 @@ void esp_nn_conv_s8_ansi(const data_dims_t *input_dims,
                          int8_t *out_data,
                          const conv_params_t *conv_params,
                          const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_plan_ansi(NULL, input_dims, input_data, filter_dims, filter_data, bias,
+                             output_dims, out_data, conv_params, &no_plan);
+}
+
+void esp_nn_conv_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                             const data_dims_t *input_dims,
+                             const int8_t *input_data,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_plan_ansi(ctx, input_dims, input_data, filter_dims, filter_data, bias,
+                             output_dims, out_data, conv_params, &no_plan);
+}
+
+/* Only the requantisation is prepared: the blob holds the header and the plan */
+int32_t esp_nn_get_conv_prepared_size_ansi(const data_dims_t *input_dims,
+                                           const data_dims_t *filter_dims,
+                                           const data_dims_t *output_dims,
+                                           const conv_params_t *conv_params)
+{
+    return ESP_NN_CONV_PREPARED_HDR_SIZE(output_dims->channels);
+}
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_ansi(void *blob,
+                                                    const data_dims_t *input_dims,
+                                                    const data_dims_t *filter_dims,
+                                                    const int8_t *filter_data,
+                                                    const int32_t *bias,
+                                                    const data_dims_t *output_dims,
+                                                    const conv_params_t *conv_params,
+                                                    const quant_data_t *quant_data)
+{
+    return esp_nn_conv_prepared_init(blob, input_dims, filter_dims, filter_data, bias,
+                                     output_dims, conv_params, quant_data);
+}
+
+void esp_nn_conv_s8_run_ansi(const esp_nn_ctx_t *ctx,
+                             const esp_nn_conv_prepared_t *prep,
+                             const int8_t *input_data,
+                             int8_t *out_data)
+{
+    esp_nn_conv_s8_plan_ansi(ctx, &prep->input_dims, input_data, &prep->filter_dims, prep->filter,
+                             prep->bias, &prep->output_dims, out_data, &prep->conv_params,
+                             &prep->quant_data);
+}
+
+/* 16x8: int16 activations, int8 weights, int64 accumulators and bias */
+void esp_nn_conv_s16_ansi(const data_dims_t *input_dims,
+                          const int16_t *input_data,
+                          const data_dims_t *filter_dims,
+                          const int8_t *filter_data,
+                          const int64_t *bias,
+                          const data_dims_t *output_dims,
+                          int16_t *out_data,
+                          const conv_params_t *conv_params,
+                          const quant_data_t *quant_data)
+{
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t input_ht = input_dims->height;
+    const uint16_t in_channels = input_dims->channels;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t pad_wd = conv_params->padding.width;
+    const uint16_t pad_ht = conv_params->padding.height;
+    const uint16_t stride_wd = conv_params->stride.width;
+    const uint16_t stride_ht = conv_params->stride.height;
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const uint16_t out_channels = output_dims->channels;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    const uint16_t filter_ch = filter_dims->channels ? filter_dims->channels : in_channels;
+    const int32_t groups = in_channels / filter_ch;
+    const int32_t filters_per_group = out_channels / groups;
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
+                    int64_t conv_out = 0;
+                    const int32_t in_ch_start = (out_ch_idx / filters_per_group) * filter_ch;
+
+                    const int32_t base_y = stride_ht * out_y - pad_ht;
+                    const int32_t base_x = stride_wd * out_x - pad_wd;
+
+                    const int32_t filter_y_start = max(0, -base_y);
+                    const int32_t filter_x_start = max(0, -base_x);
+
+                    const int32_t filter_y_end = min(filter_ht, input_ht - base_y);
+                    const int32_t filter_x_end = min(filter_wd, input_wd - base_x);
+
+                    for (int32_t filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
+                        for (int32_t filter_x_idx = filter_x_start; filter_x_idx < filter_x_end; filter_x_idx++) {
+                            const int32_t in_row = base_y + filter_y_idx;
+                            const int32_t in_col = base_x + filter_x_idx;
+                            int32_t input_base_offset = (in_row * input_wd + in_col) * in_channels + in_ch_start;
+                            int32_t filter_base_offset = out_ch_idx * filter_ch * filter_ht * filter_wd +
+                                                         (filter_y_idx * filter_wd + filter_x_idx) * filter_ch;
+                            for (int32_t in_ch_idx = 0; in_ch_idx < filter_ch; in_ch_idx++) {
+                                conv_out += (int64_t) input_data[input_base_offset + in_ch_idx] *
+                                            filter_data[filter_base_offset + in_ch_idx];
+                            }
+                        }
+                    }
+                    if (bias) {
+                        conv_out += bias[out_ch_idx];
+                    }
+                    int32_t result = esp_nn_multiply_by_quantized_mult_s64(conv_out, quant_data->mult[out_ch_idx],
+                                                                            quant_data->shift[out_ch_idx]);
+                    result += out_offset;
+                    result = max(result, activation_min);
+                    result = min(result, activation_max);
+                    *out_data++ = (int16_t) result;
+                }
+            }
+        }
+    }
+}
+
+/* int4 weights, packed as in esp_nn_s4.h: one packed row per output channel filter */
+void esp_nn_conv_s4_ansi(const data_dims_t *input_dims,
+                         const int8_t *input_data,
+                         const data_dims_t *filter_dims,
+                         const int8_t *filter_data,
+                         const int32_t *bias,
+                         const data_dims_t *output_dims,
+                         int8_t *out_data,
+                         const conv_params_t *conv_params,
+                         const quant_data_t *quant_data)
 {
     const uint16_t input_wd = input_dims->width;
     const uint16_t input_ht = input_dims->height;
@@ -130,56 +358,56 @@ void esp_nn_conv_s8_ansi(const data_dims_t *input_dims,
     const uint16_t out_wd = output_dims->width;
     const uint16_t out_ht = output_dims->height;
     const uint16_t out_channels = output_dims->channels;
-    const int32_t *out_shift = quant_data->shift;
-    const int32_t *out_mult = quant_data->mult;
     const int32_t activation_min = conv_params->activation.min;
     const int32_t activation_max = conv_params->activation.max;
 
-    /* Fall back to in_channels when filter_dims->channels is unset (legacy callers). */
     const uint16_t filter_ch = filter_dims->channels ? filter_dims->channels : in_channels;
     const int32_t groups = in_channels / filter_ch;
     const int32_t filters_per_group = out_channels / groups;
+    const int32_t row_size = esp_nn_get_s4_row_size(filter_wd * filter_ht * filter_ch);
 
-    int32_t out_ch_idx, out_y, out_x, in_ch_idx, filter_y_idx, filter_x_idx;
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
+                    const int8_t *row = filter_data + out_ch_idx * row_size;
+                    const int32_t in_ch_start = (out_ch_idx / filters_per_group) * filter_ch;
+                    int32_t conv_out = 0;
 
-    for (out_y = 0; out_y < out_ht; out_y++) {
-        for (out_x = 0; out_x < out_wd; out_x++) {
-            for (out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
-                int32_t conv_out = 0;
-                const int32_t group = out_ch_idx / filters_per_group;
-                const int32_t in_ch_start = group * filter_ch;
-
-                const int32_t base_y = stride_ht * out_y - pad_ht;
-                const int32_t base_x = stride_wd * out_x - pad_wd;
-
-                const int32_t filter_y_start = max(0, -base_y);
-                const int32_t filter_x_start = max(0, -base_x);
-
-                const int32_t filter_y_end = min(filter_ht, input_ht - base_y);
-                const int32_t filter_x_end = min(filter_wd, input_wd - base_x);
-
-                for (filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
-                    for (filter_x_idx = filter_x_start; filter_x_idx < filter_x_end; filter_x_idx++) {
-                        const int32_t in_row = base_y + filter_y_idx;
-                        const int32_t in_col = base_x + filter_x_idx;
-                        int32_t input_base_offset = (in_row * input_wd + in_col) * in_channels + in_ch_start;
-                        int32_t filter_base_offset = out_ch_idx * filter_ch * filter_ht * filter_wd +
-                                                       (filter_y_idx * filter_wd + filter_x_idx) * filter_ch;
-                        for (in_ch_idx = 0; in_ch_idx < filter_ch; in_ch_idx++) {
-                            conv_out +=
-                                (input_data[input_base_offset + in_ch_idx] + input_offset) *
-                                filter_data[filter_base_offset + in_ch_idx];
+                    const int32_t base_y = stride_ht * out_y - pad_ht;
+                    const int32_t base_x = stride_wd * out_x - pad_wd;
+
+                    const int32_t filter_y_start = max(0, -base_y);
+                    const int32_t filter_x_start = max(0, -base_x);
+
+                    const int32_t filter_y_end = min(filter_ht, input_ht - base_y);
+                    const int32_t filter_x_end = min(filter_wd, input_wd - base_x);
+
+                    for (int32_t filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
+                        for (int32_t filter_x_idx = filter_x_start; filter_x_idx < filter_x_end; filter_x_idx++) {
+                            const int32_t in_row = base_y + filter_y_idx;
+                            const int32_t in_col = base_x + filter_x_idx;
+                            int32_t input_base_offset = (in_row * input_wd + in_col) * in_channels + in_ch_start;
+                            int32_t filter_base_offset = (filter_y_idx * filter_wd + filter_x_idx) * filter_ch;
+                            for (int32_t in_ch_idx = 0; in_ch_idx < filter_ch; in_ch_idx++) {
+                                conv_out += (input_data[input_base_offset + in_ch_idx] + input_offset) *
+                                            esp_nn_s4_weight(row, filter_base_offset + in_ch_idx);
+                            }
                         }
                     }
+                    if (bias) {
+                        conv_out += bias[out_ch_idx];
+                    }
+                    conv_out = esp_nn_multiply_by_quantized_mult(conv_out, quant_data->mult[out_ch_idx],
+                                                                 quant_data->shift[out_ch_idx]);
+                    conv_out += out_offset;
+                    conv_out = max(conv_out, activation_min);
+                    conv_out = min(conv_out, activation_max);
+                    *out_data++ = (int8_t) conv_out;
                 }
-                if (bias) {
-                    conv_out += bias[out_ch_idx];
-                }
-                conv_out = esp_nn_multiply_by_quantized_mult(conv_out, out_mult[out_ch_idx], out_shift[out_ch_idx]);
-                conv_out += out_offset;
-                conv_out = max(conv_out, activation_min);
-                conv_out = min(conv_out, activation_max);
-                *out_data++ = (int8_t) conv_out;
             }
         }
     }
@@ -53,7 +53,21 @@
 
 #include <common_functions.h>
 
-static int16_t *scratch_buffer = NULL;
+/* scratch of the legacy (non `_ctx`) API, set with esp_nn_set_conv_scratch_buf */
+static esp_nn_ctx_t legacy_ctx;
+
+/* PIE state is per core: enabled on every `_ctx` call as those may run on either core */
+static inline void conv_pie_enable(void)
+{
+    asm volatile (
+        "csrsi 0x7f2, 0b01      \n\t" // enable `esp` vector extension
+        "li x29, 0b10           \n\t"
+        "esp.movx.w.cfg x29     \n\t"
+        :
+        :
+        : "x29"
+    );
+}
 
 /**
  * Reusable PIE-accelerated dot product (same as FC version).
@@ -148,7 +162,7 @@ static void conv_1x1_batch16(const int8_t *pixel_ptrs[16],
                       int8_t *out_ptrs[16],
                       int32_t in_ch, int32_t out_ch,
                       int32_t out_offset,
-                      const int32_t *out_mult, const int32_t *out_shift,
+                      const quant_plan_data_t *quant_data,
                       int32_t act_min, int32_t act_max)
 {
     /* Ensure PIE is enabled (might be lost across noinline function call) */
@@ -198,12 +212,11 @@ static void conv_1x1_batch16(const int8_t *pixel_ptrs[16],
         int32_t fs = filter_sum[oc];
         int32_t b = bias ? bias[oc] : 0;
         int32_t combined = fs + b;
-        int32_t m = out_mult[oc];
-        int32_t s = out_shift[oc];
+        const esp_nn_requant_t rq = esp_nn_requant_ch_entry(quant_data, oc);
 
         for (int p = 0; p < 16; p++) {
             int32_t r = results[p] + combined;
-            r = esp_nn_multiply_by_quantized_mult(r, m, s);
+            r = esp_nn_requant_apply(r, &rq);
             r += out_offset;
             r = max(r, act_min);
             r = min(r, act_max);
@@ -222,7 +235,8 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
                                const data_dims_t *output_dims,
                                int8_t *out_data,
                                const conv_params_t *conv_params,
-                               const quant_data_t *quant_data,
+                               const quant_plan_data_t *quant_data,
+                               const int32_t *offset_acc,
                                void *scratch)
 {
     const uint16_t input_wd = input_dims->width;
@@ -230,29 +244,19 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
     const int32_t input_offset = conv_params->in_offset;
     const int32_t out_offset = conv_params->out_offset;
     const uint16_t out_wd = output_dims->width;
-    const uint16_t out_ht = output_dims->height;
+    const int32_t out_ht = output_dims->height; /* a batch of images as rows, may pass 16 bits */
     const uint16_t out_channels = output_dims->channels;
     const int32_t activation_min = conv_params->activation.min;
     const int32_t activation_max = conv_params->activation.max;
 
-    int32_t *filter_sum = (int32_t *) scratch; // alignment of 4 bytes assumed
-
-    /* pre-calculate filter_sum * input_offset */
-    const int8_t *filter_ptr = filter_data;
-    for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
-        int32_t sum = 0;
-        int32_t in_ch_idx = 0;
-        for (; in_ch_idx < in_channels - 3; in_ch_idx += 4) {
-            sum += *filter_ptr++;
-            sum += *filter_ptr++;
-            sum += *filter_ptr++;
-            sum += *filter_ptr++;
-        }
-        for (; in_ch_idx < in_channels; in_ch_idx ++) {
-            sum += *filter_ptr++;
-        }
-        filter_sum[out_ch_idx] = sum * input_offset;
+    /* filter_sum * input_offset: prepared or calculated here */
+    const int32_t *filter_sum = offset_acc;
+    if (filter_sum == NULL) {
+        int32_t *sums = (int32_t *) scratch; // alignment of 4 bytes assumed
+        esp_nn_conv_fold_offset(filter_data, in_channels, out_channels, input_offset, NULL, sums);
+        filter_sum = sums;
     }
+    const int8_t *filter_ptr;
 
     /* When in_ch < 16: use QACC batch path (16 pixels at once) or channel padding.
      * QACC batch: transpose pixels, broadcast filter, per-lane MAC.
@@ -280,8 +284,7 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
                 op[p] = out_data + (pix + p) * out_channels;
             }
             conv_1x1_batch16(pp, filter_data, filter_sum, bias, op,
-                             in_channels, out_channels, out_offset,
-                             quant_data->mult, quant_data->shift,
+                             in_channels, out_channels, out_offset, quant_data,
                              activation_min, activation_max);
         }
 
@@ -296,8 +299,7 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
                 }
                 conv_out += filter_sum[oc];
                 if (bias) conv_out += bias[oc];
-                conv_out = esp_nn_multiply_by_quantized_mult(conv_out,
-                    quant_data->mult[oc], quant_data->shift[oc]);
+                conv_out = esp_nn_requantize_ch_exact(conv_out, quant_data, oc);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -310,8 +312,6 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
 
     for (int32_t in_row = 0; in_row < out_ht; in_row++) {
         for (int32_t in_col = 0; in_col < out_wd; in_col++) {
-            const int32_t *out_mult = quant_data->mult;
-            const int32_t *out_shift = quant_data->shift;
             filter_ptr = filter_data;
             const int8_t *input_base_ptr = input_data + (in_row * input_wd + in_col) * in_channels;
             for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
@@ -371,7 +371,7 @@ skip_asm:
                 if (bias) {
                     conv_out += bias[out_ch_idx];
                 }
-                conv_out = esp_nn_requantize(conv_out, *out_mult++, *out_shift++);
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, out_ch_idx);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -391,7 +391,8 @@ static void esp_nn_conv_s8_padded(
         const data_dims_t *output_dims,
         int8_t *out_data,
         const conv_params_t *conv_params,
-        const quant_data_t *quant_data,
+        const quant_plan_data_t *quant_data,
+        const int32_t *offset_acc,
         void *scratch)
 {
     const uint16_t input_wd = input_dims->width;
@@ -406,36 +407,23 @@ static void esp_nn_conv_s8_padded(
     const uint16_t out_wd = output_dims->width;
     const uint16_t out_ht = output_dims->height;
     const uint16_t out_channels = output_dims->channels;
-    const int32_t *out_shift = quant_data->shift;
-    const int32_t *out_mult = quant_data->mult;
     const int32_t activation_min = conv_params->activation.min;
     const int32_t activation_max = conv_params->activation.max;
 
     /* Grouped conv (filter_ch < input_ch): fall back to ansi which handles it */
     if (in_channels != filter_dims->channels) {
-        esp_nn_conv_s8_ansi(input_dims, input_data, filter_dims, filter_data,
-                            bias, output_dims, out_data, conv_params, quant_data);
+        esp_nn_conv_s8_plan_ansi(NULL, input_dims, input_data, filter_dims, filter_data,
+                                 bias, output_dims, out_data, conv_params, quant_data);
         return;
     }
 
-    int32_t *filter_sum = (int32_t *) scratch; // alignment of 4 bytes assumed
-
-    /* pre-calculate filter_sum * input_offset */
-    const int8_t *filter_ptr = filter_data;
-    for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
-        int32_t sum = 0;
-        int32_t filter_len = filter_wd * filter_ht * in_channels;
-        int32_t filter_idx = 0;
-        for (; filter_idx < filter_len - 3; filter_idx += 4) {
-            sum += *filter_ptr++;
-            sum += *filter_ptr++;
-            sum += *filter_ptr++;
-            sum += *filter_ptr++;
-        }
-        for (; filter_idx < filter_len; filter_idx++) {
-            sum += *filter_ptr++;
-        }
-        filter_sum[out_ch_idx] = sum * input_offset;
+    /* filter_sum * input_offset: prepared or calculated here */
+    const int32_t *filter_sum = offset_acc;
+    if (filter_sum == NULL) {
+        int32_t *sums = (int32_t *) scratch; // alignment of 4 bytes assumed
+        esp_nn_conv_fold_offset(filter_data, filter_wd * filter_ht * in_channels, out_channels,
+                                input_offset, NULL, sums);
+        filter_sum = sums;
     }
 
     const int32_t row_size = filter_wd * in_channels;
@@ -447,8 +435,6 @@ static void esp_nn_conv_s8_padded(
         for (int32_t out_x = 0; out_x < out_wd - right_pad; out_x++) {
             const int32_t base_y = stride_ht * out_y;
             const int32_t base_x = stride_wd * out_x;
-            const int32_t *out_mult_ptr = out_mult;
-            const int32_t *out_shift_ptr = out_shift;
             const int32_t *bias_ptr = bias;
             const int8_t *filter_data_ptr = filter_data;
             for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
@@ -523,7 +509,7 @@ skip_asm_pad0:
                 if (bias) {
                     conv_out += *bias_ptr++;
                 }
-                conv_out = esp_nn_requantize(conv_out, *out_mult_ptr++, *out_shift_ptr++);
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, out_ch_idx);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -534,8 +520,6 @@ skip_asm_pad0:
         for (int32_t out_x = out_wd - right_pad; out_x < out_wd; out_x++) {
             const int32_t base_y = stride_ht * out_y;
             const int32_t base_x = stride_wd * out_x;
-            const int32_t *out_mult_ptr = out_mult;
-            const int32_t *out_shift_ptr = out_shift;
             const int32_t *bias_ptr = bias;
             for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
                 int32_t conv_out = 0, filter_y_idx;
@@ -565,7 +549,7 @@ skip_asm_pad0:
                 if (bias) {
                     conv_out += *bias_ptr++;
                 }
-                conv_out = esp_nn_requantize(conv_out, *out_mult_ptr++, *out_shift_ptr++);
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, out_ch_idx);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -577,11 +561,11 @@ skip_asm_pad0:
     // Calculate the last row if needed
     if (bottom_pad) {
         int in_row = input_dims->height - filter_dims->height + 1;
-        esp_nn_conv_s8_opt(&(data_dims_t){input_dims->width, 2, input_dims->channels, 0},
-                            input_data + in_row * input_dims->width * input_dims->channels,
-                            filter_dims, filter_data, bias,
-                            &(data_dims_t){output_dims->width, 1, output_dims->channels, 0},
-                            out_data, conv_params, quant_data);
+        esp_nn_conv_s8_plan_opt(NULL, &(data_dims_t){input_dims->width, 2, input_dims->channels, 0},
+                                input_data + in_row * input_dims->width * input_dims->channels,
+                                filter_dims, filter_data, bias,
+                                &(data_dims_t){output_dims->width, 1, output_dims->channels, 0},
+                                out_data, conv_params, quant_data);
     }
 }
 
@@ -597,6 +581,8 @@ skip_asm_pad0:
  *
  * For each output pixel: copy the input window into a contiguous scratch
  * buffer, then use PIE dot product on the full window. No wasted MACs.
+ * Dilated taps are gathered the same way, which is why dilated layers of
+ * any channel count run here.
  *
  * Scratch layout: [filter_sum | im2col_buf]
  *   im2col_buf = filter_wd * filter_ht * in_ch bytes
@@ -611,7 +597,8 @@ static void esp_nn_conv_s8_im2col(
         const data_dims_t *output_dims,
         int8_t *out_data,
         const conv_params_t *conv_params,
-        const quant_data_t *quant_data,
+        const quant_plan_data_t *quant_data,
+        const int32_t *offset_acc,
         void *scratch)
 {
     const uint16_t input_wd = input_dims->width;
@@ -626,6 +613,8 @@ static void esp_nn_conv_s8_im2col(
     const uint16_t pad_ht = conv_params->padding.height;
     const uint16_t stride_wd = conv_params->stride.width;
     const uint16_t stride_ht = conv_params->stride.height;
+    const int32_t dilation_wd = esp_nn_dilation(conv_params->dilation.width);
+    const int32_t dilation_ht = esp_nn_dilation(conv_params->dilation.height);
     const int32_t input_offset = conv_params->in_offset;
     const int32_t out_offset = conv_params->out_offset;
     const int32_t activation_min = conv_params->activation.min;
@@ -635,17 +624,13 @@ static void esp_nn_conv_s8_im2col(
     const int8_t pad_val = (int8_t)(-input_offset);
 
     /* Scratch: filter_sum[out_ch] + im2col_buf[window_len] */
-    int32_t *filter_sum = (int32_t *)scratch;
+    const int32_t *filter_sum = offset_acc;
     int8_t *im2col_buf = (int8_t *)scratch + out_ch * sizeof(int32_t);
 
-    /* Pre-compute filter_sum * input_offset */
-    const int8_t *fptr = filter_data;
-    for (int32_t oc = 0; oc < out_ch; oc++) {
-        int32_t sum = 0;
-        for (int32_t fi = 0; fi < window_len; fi++) {
-            sum += *fptr++;
-        }
-        filter_sum[oc] = sum * input_offset;
+    /* Pre-compute filter_sum * input_offset, unless prepared */
+    if (filter_sum == NULL) {
+        esp_nn_conv_fold_offset(filter_data, window_len, out_ch, input_offset, NULL, (int32_t *)scratch);
+        filter_sum = (const int32_t *)scratch;
     }
 
     /* Process each output pixel */
@@ -658,9 +643,9 @@ static void esp_nn_conv_s8_im2col(
             /* Copy input window into contiguous im2col buffer */
             int8_t *buf = im2col_buf;
             for (int32_t fy = 0; fy < filter_ht; fy++) {
-                int32_t in_y = base_y + fy;
+                int32_t in_y = base_y + fy * dilation_ht;
                 for (int32_t fx = 0; fx < filter_wd; fx++) {
-                    int32_t in_x = base_x + fx;
+                    int32_t in_x = base_x + fx * dilation_wd;
                     if (in_y >= 0 && in_y < input_ht && in_x >= 0 && in_x < input_wd) {
                         const int8_t *src = input_data + (in_y * input_wd + in_x) * in_ch;
                         for (int c = 0; c < in_ch; c++) {
@@ -676,15 +661,13 @@ static void esp_nn_conv_s8_im2col(
             }
 
             /* Dot product against each output channel's filter */
-            const int32_t *out_mult = quant_data->mult;
-            const int32_t *out_shift = quant_data->shift;
             const int8_t *filter_ptr = filter_data;
 
             for (int32_t oc = 0; oc < out_ch; oc++) {
                 int32_t conv_out = pie_dot_s8(im2col_buf, filter_ptr, window_len);
                 conv_out += filter_sum[oc];
                 if (bias) conv_out += bias[oc];
-                conv_out = esp_nn_requantize(conv_out, *out_mult++, *out_shift++);
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, oc);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -695,6 +678,123 @@ static void esp_nn_conv_s8_im2col(
     }
 }
 
+/* Tiles of esp_nn_conv_s8_tiled, shared with its scratch size */
+typedef struct {
+    int32_t eff_ch;         /* channels of the tile rows, padded for PIE when a filter row is < 16 */
+    int32_t filter_size;    /* channel padded filter copy, 0 without channel padding */
+    int32_t row_bytes;      /* one padded input row */
+    int32_t tile_ht;        /* output rows per tile */
+    int32_t buffers;        /* tile buffers: 2 to stage the next tile while one runs */
+} conv_tiles_p4_t;
+
+static void conv_tiles_p4(const data_dims_t *input_dims,
+                          const data_dims_t *filter_dims,
+                          const data_dims_t *output_dims,
+                          const conv_params_t *conv_params,
+                          conv_tiles_p4_t *tiles)
+{
+    const int32_t input_wd = input_dims->width;
+    const int32_t input_ht = input_dims->height;
+    const int32_t in_ch = input_dims->channels;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    const int32_t out_ht = output_dims->height;
+    const int32_t out_ch = output_dims->channels;
+    const int32_t pad_wd = conv_params->padding.width;
+    const int32_t pad_ht = conv_params->padding.height;
+    const int32_t stride_ht = conv_params->stride.height;
+
+    /* Check if we need channel padding for PIE (row_size must be >= 16) */
+    tiles->eff_ch = in_ch;
+    tiles->filter_size = 0;
+    if (filter_wd * in_ch < 16) {
+        tiles->eff_ch = (16 + filter_wd - 1) / filter_wd;   /* minimum channels for PIE */
+        tiles->eff_ch = (tiles->eff_ch + 15) & ~15;         /* align to 16 */
+        tiles->filter_size = filter_wd * filter_ht * tiles->eff_ch * out_ch;
+    }
+    tiles->row_bytes = (input_wd + 2 * pad_wd) * tiles->eff_ch;
+
+    /* Tile height T (output rows per tile): all rows if the padded input fits
+     * L1D next to filter_sum and the filter, else as many as fit two tile
+     * buffers in, at least 1 */
+    const int32_t used_scratch = out_ch * (int32_t) sizeof(int32_t) + tiles->filter_size;
+    const int32_t total_input_bytes = tiles->row_bytes * (input_ht + 2 * pad_ht);
+    tiles->tile_ht = out_ht;
+    tiles->buffers = 1;
+    if (total_input_bytes + used_scratch > L1D_BUDGET) {
+        const int32_t budget_for_input = (L1D_BUDGET - used_scratch) / 2;
+        tiles->tile_ht = 1;
+        if (filter_ht * tiles->row_bytes <= budget_for_input) {
+            tiles->tile_ht = (budget_for_input - filter_ht * tiles->row_bytes)
+                             / (stride_ht * tiles->row_bytes) + 1;
+            tiles->tile_ht = min(tiles->tile_ht, out_ht);
+        }
+        tiles->buffers = tiles->tile_ht < out_ht ? 2 : 1;
+    }
+}
+
+/* Input rows a tile of `tile_ht` output rows reads */
+static inline int32_t conv_tile_rows_p4(const int32_t tile_ht, const int32_t stride_ht,
+                                        const int32_t filter_ht)
+{
+    return (tile_ht - 1) * stride_ht + filter_ht;
+}
+
+/**
+ * Input rows [in_row_start, in_row_end] of a tile into `dst`, padded, with the
+ * channels padded to `eff_ch`. Input bytes are started on `mover`, returns the
+ * ticket of the last copy, -1 if none.
+ */
+static int32_t conv_stage_tile_p4(const int8_t *image_in,
+                                  const int32_t input_wd,
+                                  const int32_t input_ht,
+                                  const int32_t in_ch,
+                                  const int32_t eff_ch,
+                                  const int32_t pad_wd,
+                                  const int8_t pad_val,
+                                  const int32_t in_row_start,
+                                  const int32_t in_row_end,
+                                  int8_t *dst,
+                                  const esp_nn_tile_mover_t *mover)
+{
+    const int32_t padded_input_wd = input_wd + 2 * pad_wd;
+    int32_t ticket = -1;
+
+    for (int32_t row = in_row_start; row <= in_row_end; row++) {
+        if (row < 0 || row >= input_ht) {
+            memset(dst, pad_val, padded_input_wd * eff_ch);
+        } else {
+            /* For each pixel in padded row */
+            int8_t *row_dst = dst;
+            /* Left padding */
+            for (int px = 0; px < pad_wd; px++) {
+                memset(row_dst, pad_val, eff_ch);
+                row_dst += eff_ch;
+            }
+            /* Valid pixels - with optional channel padding */
+            const int8_t *row_src = image_in + row * input_wd * in_ch;
+            if (eff_ch > in_ch) {
+                for (int px = 0; px < input_wd; px++) {
+                    ticket = esp_nn_tile_copy(mover, row_dst, row_src, in_ch);
+                    memset(row_dst + in_ch, pad_val, eff_ch - in_ch);
+                    row_src += in_ch;
+                    row_dst += eff_ch;
+                }
+            } else {
+                ticket = esp_nn_tile_copy(mover, row_dst, row_src, input_wd * in_ch);
+                row_dst += input_wd * in_ch;
+            }
+            /* Right padding */
+            for (int px = 0; px < pad_wd; px++) {
+                memset(row_dst, pad_val, eff_ch);
+                row_dst += eff_ch;
+            }
+        }
+        dst += padded_input_wd * eff_ch;
+    }
+    return ticket;
+}
+
 /**
  * Tiled convolution: process T output rows at a time.
  * Converts padded conv into a series of no-pad sub-problems by
@@ -702,6 +802,8 @@ static void esp_nn_conv_s8_im2col(
  *
  * This keeps the working set in L1D for large input tensors.
  * Reuses the existing esp_nn_conv_s8_padded PIE inner loop per tile.
+ * With two tile buffers, the next tile is staged through `mover` while
+ * the PIE loop runs on the current one.
  */
 __attribute__ ((noinline))
 static void esp_nn_conv_s8_tiled(
@@ -713,8 +815,10 @@ static void esp_nn_conv_s8_tiled(
         const data_dims_t *output_dims,
         int8_t *out_data,
         const conv_params_t *conv_params,
-        const quant_data_t *quant_data,
-        void *scratch)
+        const quant_plan_data_t *quant_data,
+        const int32_t *offset_acc,
+        void *scratch,
+        const esp_nn_tile_mover_t *mover)
 {
     const uint16_t input_wd = input_dims->width;
     const uint16_t input_ht = input_dims->height;
@@ -729,41 +833,32 @@ static void esp_nn_conv_s8_tiled(
     const uint16_t stride_ht = conv_params->stride.height;
     const int32_t input_offset = conv_params->in_offset;
 
-    /* Check if we need channel padding for PIE (row_size must be >= 16) */
-    int new_ch = in_ch;
-    int need_ch_pad = 0;
-    if (filter_wd * in_ch < 16) {
-        new_ch = (16 + filter_wd - 1) / filter_wd;  /* minimum channels for PIE */
-        new_ch = (new_ch + 15) & ~15;                /* align to 16 */
-        need_ch_pad = 1;
-    }
+    conv_tiles_p4_t tiles;
+    conv_tiles_p4(input_dims, filter_dims, output_dims, conv_params, &tiles);
+    const int need_ch_pad = tiles.filter_size != 0;
+    const int eff_ch = tiles.eff_ch;
     int padded_input_wd = input_wd + 2 * pad_wd;
 
     /* Scratch layout:
      * [0] filter_sum: out_ch * 4 bytes
-     * [after filter_sum] aligned_filter (if ch padding): filter_wd * filter_ht * new_ch * out_ch
-     * [after filter] tile_input_buf: variable per tile
+     * [after filter_sum] aligned_filter (if ch padding): filter_wd * filter_ht * eff_ch * out_ch
+     * [after filter] tile_input_buf: rows of the tallest tile, `buffers` times
      */
-    int32_t *filter_sum = (int32_t *) scratch;
+    const int32_t *filter_sum = offset_acc;
     int filter_sum_size = out_ch * sizeof(int32_t);
 
-    /* Pre-compute filter_sum * input_offset (once for entire layer) */
-    const int8_t *fptr = filter_data;
-    for (int32_t oc = 0; oc < out_ch; oc++) {
-        int32_t sum = 0;
-        int32_t flen = filter_wd * filter_ht * in_ch;
-        for (int32_t fi = 0; fi < flen; fi++) {
-            sum += *fptr++;
-        }
-        filter_sum[oc] = sum * input_offset;
+    /* Pre-compute filter_sum * input_offset (once for entire layer), unless prepared */
+    if (filter_sum == NULL) {
+        esp_nn_conv_fold_offset(filter_data, filter_wd * filter_ht * in_ch, out_ch,
+                                input_offset, NULL, (int32_t *) scratch);
+        filter_sum = (const int32_t *) scratch;
     }
 
     /* Channel-pad filter if needed (pad with 0s - doesn't affect filter_sum) */
     int8_t *aligned_filter = NULL;
-    int aligned_filter_size = 0;
+    const int aligned_filter_size = tiles.filter_size;
     if (need_ch_pad) {
         aligned_filter = (int8_t *)scratch + filter_sum_size;
-        aligned_filter_size = filter_wd * filter_ht * new_ch * out_ch;
         memset(aligned_filter, 0, aligned_filter_size);
         const int8_t *src_f = filter_data;
         int8_t *dst_f = aligned_filter;
@@ -772,214 +867,428 @@ static void esp_nn_conv_s8_tiled(
                 for (int fw = 0; fw < filter_wd; fw++) {
                     memcpy(dst_f, src_f, in_ch);
                     src_f += in_ch;
-                    dst_f += new_ch;  /* zero-padded channels */
+                    dst_f += eff_ch;  /* zero-padded channels */
                 }
             }
         }
     }
 
-    /* Tile input buffer starts after filter_sum + aligned_filter */
+    /* Tile input buffers start after filter_sum + aligned_filter */
     int8_t *tile_buf = (int8_t *)scratch + filter_sum_size + aligned_filter_size;
 
-    /* Use effective channel count for tile buffer sizing */
-    int eff_ch = need_ch_pad ? new_ch : in_ch;
-    int tile_input_row_bytes = padded_input_wd * eff_ch;
-
-    /* Compute tile height T (output rows per tile) */
-    int tile_T = out_ht;
-    int total_input_bytes = padded_input_wd * (input_ht + 2 * pad_ht) * eff_ch;
-    int used_scratch = filter_sum_size + aligned_filter_size;
-    if (total_input_bytes + used_scratch > L1D_BUDGET) {
-        int budget_for_input = L1D_BUDGET - used_scratch;
-        int min_input_rows = filter_ht;
-        if (min_input_rows * tile_input_row_bytes <= budget_for_input) {
-            tile_T = (budget_for_input - filter_ht * tile_input_row_bytes)
-                     / (stride_ht * tile_input_row_bytes) + 1;
-            if (tile_T < 1) tile_T = 1;
-            if (tile_T > out_ht) tile_T = out_ht;
-        }
-    }
+    const int tile_T = tiles.tile_ht;
+    const int32_t tile_size = tiles.row_bytes * conv_tile_rows_p4(tile_T, stride_ht, filter_ht);
 
     /* Process tiles */
     const int8_t *use_filter = need_ch_pad ? aligned_filter : filter_data;
     data_dims_t eff_filter_dims = {filter_wd, filter_ht, eff_ch, 0};
+    const int8_t pad_val = (int8_t)(-input_offset);
 
-    for (int32_t tile_y = 0; tile_y < out_ht; tile_y += tile_T) {
-        int32_t actual_T = min(tile_T, out_ht - tile_y);
-
-        int32_t in_row_start = tile_y * stride_ht - pad_ht;
-        int32_t in_row_end = (tile_y + actual_T - 1) * stride_ht + filter_ht - 1;
-        int32_t tile_input_ht = in_row_end - in_row_start + 1;
-
-        /* Copy/pad input rows into tile buffer, with channel padding if needed */
-        int8_t pad_val = (int8_t)(-input_offset);
-        int8_t *dst = tile_buf;
-
-        for (int32_t row = in_row_start; row <= in_row_end; row++) {
-            if (row < 0 || row >= input_ht) {
-                memset(dst, pad_val, padded_input_wd * eff_ch);
-            } else {
-                /* For each pixel in padded row */
-                int8_t *row_dst = dst;
-                /* Left padding */
-                for (int px = 0; px < pad_wd; px++) {
-                    memset(row_dst, pad_val, eff_ch);
-                    row_dst += eff_ch;
-                }
-                /* Valid pixels - with optional channel padding */
-                const int8_t *row_src = input_data + row * input_wd * in_ch;
-                if (need_ch_pad) {
-                    for (int px = 0; px < input_wd; px++) {
-                        memcpy(row_dst, row_src, in_ch);
-                        if (eff_ch > in_ch) {
-                            memset(row_dst + in_ch, pad_val, eff_ch - in_ch);
-                        }
-                        row_src += in_ch;
-                        row_dst += eff_ch;
-                    }
-                } else {
-                    memcpy(row_dst, row_src, input_wd * in_ch);
-                    row_dst += input_wd * in_ch;
-                }
-                /* Right padding */
-                for (int px = 0; px < pad_wd; px++) {
-                    memset(row_dst, pad_val, eff_ch);
-                    row_dst += eff_ch;
-                }
-            }
-            dst += padded_input_wd * eff_ch;
+    /* filter sums and the padded filter above serve every image of the batch:
+     * the tiles of all of them in turn, tile t staged while tile t - 1 runs */
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_ch;
+    const int32_t output_size = out_wd * out_ht * out_ch;
+    const int32_t tiles_per_image = (out_ht + tile_T - 1) / tile_T;
+    const int32_t num_tiles = batches * tiles_per_image;
+    int32_t ticket = -1;
+
+    for (int32_t t = 0; t <= num_tiles; t++) {
+        const int32_t staged = ticket;
+        if (t < num_tiles) {
+            const int32_t tile_y = (t % tiles_per_image) * tile_T;
+            const int32_t actual_T = min(tile_T, out_ht - tile_y);
+            const int32_t in_row_start = tile_y * stride_ht - pad_ht;
+            const int32_t in_row_end = in_row_start +
+                                       conv_tile_rows_p4(actual_T, stride_ht, filter_ht) - 1;
+            ticket = conv_stage_tile_p4(input_data + (t / tiles_per_image) * input_size,
+                                        input_wd, input_ht, in_ch, eff_ch, pad_wd, pad_val,
+                                        in_row_start, in_row_end,
+                                        tile_buf + (t % tiles.buffers) * tile_size, mover);
+        }
+        if (t == 0) {
+            continue;
         }
+        const int32_t tile_y = ((t - 1) % tiles_per_image) * tile_T;
+        const int32_t actual_T = min(tile_T, out_ht - tile_y);
+        int8_t *image_out = out_data + ((t - 1) / tiles_per_image) * output_size;
 
         /* Sub-problem with pad=0, effective channels */
-        data_dims_t tile_input_dims = {padded_input_wd, tile_input_ht, eff_ch, 0};
+        data_dims_t tile_input_dims = {padded_input_wd,
+                                       conv_tile_rows_p4(actual_T, stride_ht, filter_ht),
+                                       eff_ch, 0};
         data_dims_t tile_output_dims = {out_wd, actual_T, out_ch, 0};
         conv_params_t tile_conv_params = *conv_params;
         tile_conv_params.padding.width = 0;
         tile_conv_params.padding.height = 0;
 
-        esp_nn_conv_s8_padded(&tile_input_dims, tile_buf,
+        esp_nn_tile_wait(mover, staged);
+        esp_nn_conv_s8_padded(&tile_input_dims, tile_buf + ((t - 1) % tiles.buffers) * tile_size,
                               &eff_filter_dims, use_filter, bias,
                               &tile_output_dims,
-                              out_data + tile_y * out_wd * out_ch,
+                              image_out + tile_y * out_wd * out_ch,
                               &tile_conv_params, quant_data,
-                              filter_sum);
+                              filter_sum, NULL);
     }
 }
 
-int esp_nn_get_conv_scratch_size_esp32p4(const data_dims_t *input_dims,
-                                         const data_dims_t *filter_dims,
-                                         const data_dims_t *output_dims,
-                                         const conv_params_t *conv_params)
+/* Kernel paths of the dispatcher, also recorded in prepared blobs */
+typedef enum {
+    CONV_PATH_1X1 = 0,
+    CONV_PATH_PADDED,
+    CONV_PATH_IM2COL,
+    CONV_PATH_TILED,
+    CONV_PATH_OPT,
+} conv_path_p4_t;
+
+/* Path from the shape alone, used unless autotuning picked another one */
+static conv_path_p4_t conv_default_path_p4(const data_dims_t *input_dims,
+                                           const data_dims_t *filter_dims,
+                                           const conv_params_t *conv_params)
 {
-    const uint16_t input_wd = input_dims->width;
-    const uint16_t input_ht = input_dims->height;
-    const uint16_t in_ch = input_dims->channels;
     const uint16_t filter_wd = filter_dims->width;
     const uint16_t filter_ht = filter_dims->height;
-    const uint16_t out_ch = output_dims->channels;
     const uint16_t pad_wd = conv_params->padding.width;
     const uint16_t pad_ht = conv_params->padding.height;
     const uint16_t stride_wd = conv_params->stride.width;
     const uint16_t stride_ht = conv_params->stride.height;
 
-    int new_channels = (in_ch + 7) & ~7;
+    if (filter_dims->channels && filter_dims->channels != input_dims->channels) {
+        /* Grouped: generic opt hands it to ansi, the PIE kernels take one group */
+        return CONV_PATH_OPT;
+    }
+    if (esp_nn_is_dilated(filter_dims, &conv_params->dilation)) {
+        /* Only the im2col gather and generic opt take dilated taps */
+        return filter_wd * filter_ht * input_dims->channels >= 16 ? CONV_PATH_IM2COL :
+                                                                    CONV_PATH_OPT;
+    }
+    if (filter_wd == 1 && filter_ht == 1 && pad_wd == 0 && pad_ht == 0 &&
+            stride_wd == 1 && stride_ht == 1) {
+        return CONV_PATH_1X1;
+    } else if (pad_wd == 0 && pad_ht == 0 &&
+               filter_wd * input_dims->channels >= 16) {
+        /* No-pad, channels large enough for PIE: use direct padded path */
+        return CONV_PATH_PADDED;
+    } else if (filter_wd * filter_ht * input_dims->channels >= 16) {
+        /* Small in_ch but window_len >= 16: use im2col for zero-waste PIE.
+         * Also handles padded cases naturally. */
+        return CONV_PATH_IM2COL;
+    } else if (pad_wd != 0 || pad_ht != 0) {
+        /* Padded case with very small window: use tiled path */
+        return CONV_PATH_TILED;
+    }
+    /* Tiny output: fall back to generic opt */
+    return CONV_PATH_OPT;
+}
 
-    int input_scratch = input_wd * input_ht * in_ch;
-    int filter_scratch = filter_wd * filter_ht * in_ch * out_ch;
+static conv_path_p4_t conv_select_path_p4(const data_dims_t *input_dims,
+                                          const data_dims_t *filter_dims,
+                                          const data_dims_t *output_dims,
+                                          const conv_params_t *conv_params);
+
+/* Bytes of scratch `path` touches on an unprepared call, prepared runs need less */
+static int conv_scratch_size_p4(const conv_path_p4_t path,
+                                const data_dims_t *input_dims,
+                                const data_dims_t *filter_dims,
+                                const data_dims_t *output_dims,
+                                const conv_params_t *conv_params)
+{
+    const int32_t filter_sum_size = output_dims->channels * sizeof(int32_t);
+
+    switch (path) {
+    case CONV_PATH_1X1:
+    case CONV_PATH_PADDED:
+        /* filter_sum only: both run on the input and filter as they are */
+        return filter_sum_size;
+    case CONV_PATH_IM2COL:
+        /* filter_sum, then one window */
+        return filter_sum_size + filter_dims->width * filter_dims->height * input_dims->channels;
+    case CONV_PATH_TILED: {
+        conv_tiles_p4_t tiles;
+        conv_tiles_p4(input_dims, filter_dims, output_dims, conv_params, &tiles);
+        return filter_sum_size + tiles.filter_size + tiles.buffers * tiles.row_bytes *
+               conv_tile_rows_p4(tiles.tile_ht, conv_params->stride.height, filter_dims->height);
+    }
+    default:
+        /* generic opt takes no scratch */
+        return 0;
+    }
+}
 
-    int align_buf_size = 32; /* extra buffer for alignment */
-    if ((filter_wd == 1 && filter_ht == 1 && pad_wd == 0 && pad_ht == 0) &&
-            (stride_wd == 1 && stride_ht == 1)) {
-        if (in_ch < 16) {
-            /* Channel-padding path: filter_sum + padded_filter + padded_input */
-            int filter_sum_sz = out_ch * 4;
-            int padded_filter_sz = 16 * out_ch;
-            int padded_input_sz = 32; /* 16 bytes + alignment */
-            return filter_sum_sz + padded_filter_sz + padded_input_sz + align_buf_size;
-        }
-        int transpose_buf_size = 2 * (8 * new_channels);
-        if (input_wd * input_ht < 8) {
-            transpose_buf_size = 0;
-        }
-        if (in_ch % 8) {
-            input_scratch = input_wd * input_ht * new_channels;
-        } else {
-            input_scratch = 0;
+int esp_nn_get_conv_scratch_size_esp32p4(const data_dims_t *input_dims,
+                                         const data_dims_t *filter_dims,
+                                         const data_dims_t *output_dims,
+                                         const conv_params_t *conv_params)
+{
+    return conv_scratch_size_p4(conv_select_path_p4(input_dims, filter_dims, output_dims, conv_params),
+                                input_dims, filter_dims, output_dims, conv_params) +
+           ESP_NN_SCRATCH_GUARD_SIZE;
+}
+
+void esp_nn_set_conv_scratch_buf_esp32p4(void *buf)
+{
+    // We are going to use the vector extensions
+    conv_pie_enable();
+
+    legacy_ctx.scratch = buf;
+}
+
+static void conv_run_path_p4(conv_path_p4_t path,
+                             const data_dims_t *input_dims,
+                             const int8_t *input,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_plan_data_t *quant_data,
+                             const int32_t *offset_acc,
+                             void *scratch,
+                             const esp_nn_tile_mover_t *mover)
+{
+    const int32_t batches = esp_nn_batches(input_dims);
+
+    if (batches > 1 && path == CONV_PATH_1X1) {
+        /* stride 1, no padding: the images are just more rows */
+        data_dims_t rows_in = *input_dims;
+        data_dims_t rows_out = *output_dims;
+        rows_in.height *= batches;
+        rows_in.extra = 1;
+        rows_out.height *= batches;
+        input_dims = &rows_in;
+        output_dims = &rows_out;
+    } else if (batches > 1 && (path == CONV_PATH_PADDED || path == CONV_PATH_IM2COL)) {
+        /* filter sums once, at the start of scratch the kernels leave alone when given them */
+        if (offset_acc == NULL) {
+            esp_nn_conv_fold_offset(filter_data,
+                                    filter_dims->width * filter_dims->height * input_dims->channels,
+                                    output_dims->channels, conv_params->in_offset, NULL,
+                                    (int32_t *) scratch);
+            offset_acc = (const int32_t *) scratch;
         }
-        filter_scratch = new_channels * out_ch;
-        return input_scratch + filter_scratch + transpose_buf_size + align_buf_size;
-    } else {
-        new_channels = (in_ch + 15) & ~15;
-        int offset_acc_scratch = out_ch * 4;
-
-        if (pad_wd == 0 && pad_ht == 0 && filter_wd * in_ch >= 16) {
-            /* Direct no-pad path: no input scratch needed */
-            input_scratch = 0;
-            filter_scratch = filter_wd * filter_ht * new_channels * out_ch;
-            return input_scratch + filter_scratch + align_buf_size + offset_acc_scratch;
+        data_dims_t image_dims = *input_dims;
+        image_dims.extra = 1;
+        const int32_t input_size = input_dims->width * input_dims->height * input_dims->channels;
+        const int32_t output_size = output_dims->width * output_dims->height * output_dims->channels;
+        for (int32_t batch = 0; batch < batches; batch++) {
+            conv_run_path_p4(path, &image_dims, input + batch * input_size, filter_dims,
+                             filter_data, bias, output_dims, out_data + batch * output_size,
+                             conv_params, quant_data, offset_acc, scratch, mover);
         }
+        return;
+    }
 
-        /* Im2col path: scratch = filter_sum + im2col_buf */
-        if (filter_wd * filter_ht * in_ch >= 16) {
-            int window_len = filter_wd * filter_ht * in_ch;
-            int im2col_scratch = window_len;  /* one window buffer */
-            return offset_acc_scratch + im2col_scratch + align_buf_size;
-        }
+    switch (path) {
+    case CONV_PATH_1X1:
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_1X1,
+                         esp_nn_conv_s8_1x1(input_dims, input, filter_data, bias,
+                                            output_dims, out_data, conv_params, quant_data,
+                                            offset_acc, scratch));
+        break;
+    case CONV_PATH_PADDED:
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_PADDED,
+                         esp_nn_conv_s8_padded(input_dims, input, filter_dims, filter_data, bias,
+                                               output_dims, out_data, conv_params, quant_data,
+                                               offset_acc, scratch));
+        break;
+    case CONV_PATH_IM2COL:
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_IM2COL,
+                         esp_nn_conv_s8_im2col(input_dims, input, filter_dims, filter_data, bias,
+                                               output_dims, out_data, conv_params, quant_data,
+                                               offset_acc, scratch));
+        break;
+    case CONV_PATH_TILED:
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_TILED,
+                         esp_nn_conv_s8_tiled(input_dims, input, filter_dims, filter_data, bias,
+                                              output_dims, out_data, conv_params, quant_data,
+                                              offset_acc, scratch, mover));
+        break;
+    default:
+        /* records its own path */
+        esp_nn_conv_s8_plan_opt(NULL, input_dims, input, filter_dims, filter_data, bias,
+                                output_dims, out_data, conv_params, quant_data);
+        break;
+    }
+}
 
-        if (pad_wd == 0 && pad_ht == 0) {
-            /* Very small window (< 16 elements total): tiled path */
-            int eff_ch = ((16 + filter_wd - 1) / filter_wd + 15) & ~15;
-            int filt_aligned = filter_wd * filter_ht * eff_ch * out_ch;
-            int tile_input = input_wd * input_ht * eff_ch;
-            return offset_acc_scratch + filt_aligned + tile_input + align_buf_size;
-        }
+/* Paths able to run the layer, for autotuning: dilated taps only on im2col and opt,
+ * grouped layers only on opt */
+static int conv_tune_candidates_p4(const data_dims_t *input_dims,
+                                   const data_dims_t *filter_dims,
+                                   const data_dims_t *output_dims,
+                                   const conv_params_t *conv_params,
+                                   int32_t *paths,
+                                   int32_t *scratch_sizes)
+{
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t pad_wd = conv_params->padding.width;
+    const uint16_t pad_ht = conv_params->padding.height;
+    const bool dilated = esp_nn_is_dilated(filter_dims, &conv_params->dilation);
+    int count = 0;
 
-        /* Padded case: check if tiling is beneficial */
-        int padded_input_wd = input_wd + 2 * pad_wd;
-        int full_input_size = padded_input_wd * (input_ht + 2 * pad_ht) * in_ch;
-
-        if (full_input_size + offset_acc_scratch > L1D_BUDGET) {
-            /* Tiled path: compute tile input size */
-            int eff_ch = in_ch;
-            int filt_aligned = 0;
-            if (filter_wd * in_ch < 16) {
-                eff_ch = ((16 + filter_wd - 1) / filter_wd + 15) & ~15;
-                filt_aligned = filter_wd * filter_ht * eff_ch * out_ch;
-            }
-            int tile_row_bytes = padded_input_wd * eff_ch;
-            int budget_for_input = L1D_BUDGET - offset_acc_scratch - filt_aligned;
-            int tile_T = 1;
-            if (budget_for_input > 0 && filter_ht * tile_row_bytes <= budget_for_input) {
-                tile_T = (budget_for_input - filter_ht * tile_row_bytes)
-                         / (stride_ht * tile_row_bytes) + 1;
-                if (tile_T > (int)(output_dims->height)) tile_T = output_dims->height;
-            }
-            int tile_input_rows = (tile_T - 1) * stride_ht + filter_ht + 2 * pad_ht;
-            input_scratch = tile_input_rows * tile_row_bytes;
-            filter_scratch = filt_aligned;
-        } else {
-            /* Monolithic padded path */
-            input_scratch = full_input_size;
-            filter_scratch = filter_wd * filter_ht * new_channels * out_ch;
-        }
-        return input_scratch + filter_scratch + align_buf_size + offset_acc_scratch;
+    if (filter_dims->channels && filter_dims->channels != input_dims->channels) {
+        return 0;
+    }
+    if (filter_wd == 1 && filter_ht == 1 && pad_wd == 0 && pad_ht == 0 &&
+            conv_params->stride.width == 1 && conv_params->stride.height == 1) {
+        paths[count++] = CONV_PATH_1X1;
+    }
+    if (!dilated && pad_wd == 0 && pad_ht == 0 && filter_wd * input_dims->channels >= 16) {
+        paths[count++] = CONV_PATH_PADDED;
+    }
+    if (filter_wd * filter_ht * input_dims->channels >= 16) {
+        paths[count++] = CONV_PATH_IM2COL;
+    }
+    if (!dilated && (pad_wd != 0 || pad_ht != 0)) {
+        paths[count++] = CONV_PATH_TILED;
     }
-    return align_buf_size;
+    paths[count++] = CONV_PATH_OPT;
+    for (int i = 0; i < count; i++) {
+        scratch_sizes[i] = conv_scratch_size_p4((conv_path_p4_t) paths[i], input_dims,
+                                                filter_dims, output_dims, conv_params);
+    }
+    return count;
 }
 
-void esp_nn_set_conv_scratch_buf_esp32p4(void *buf)
+static void conv_tune_run_p4(const int32_t path,
+                             const data_dims_t *input_dims,
+                             const int8_t *input,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_plan_data_t *quant_data,
+                             void *scratch)
 {
-    // We are going to use the vector extensions
-    asm volatile (
-        "csrsi 0x7f2, 0b01      \n\t" // enable `esp` vector extension
-        "li x29, 0b10           \n\t"
-        "esp.movx.w.cfg x29     \n\t"
-        :
-        :
-        : "x29"
-    );
+    /* tuning may run from the size queries, before any call enabled PIE */
+    conv_pie_enable();
+    conv_run_path_p4((conv_path_p4_t) path, input_dims, input, filter_dims, filter_data, bias,
+                     output_dims, out_data, conv_params, quant_data, NULL, scratch, NULL);
+}
 
-    scratch_buffer = (int16_t *) buf;
+static const esp_nn_conv_tuner_t conv_tuner_p4 = {
+    .kernel = ESP_NN_AUTOTUNE_CONV_S8_ESP32P4,
+    .candidates = conv_tune_candidates_p4,
+    .run = conv_tune_run_p4,
+};
+
+static conv_path_p4_t conv_select_path_p4(const data_dims_t *input_dims,
+                                          const data_dims_t *filter_dims,
+                                          const data_dims_t *output_dims,
+                                          const conv_params_t *conv_params)
+{
+    return (conv_path_p4_t) esp_nn_autotune_conv_path(&conv_tuner_p4, input_dims, filter_dims,
+                                                      output_dims, conv_params,
+                                                      conv_default_path_p4(input_dims, filter_dims,
+                                                                           conv_params));
+}
+
+void esp_nn_conv_s8_plan_esp32p4(const esp_nn_ctx_t *ctx,
+                                 const data_dims_t *input_dims,
+                                 const int8_t *input,
+                                 const data_dims_t *filter_dims,
+                                 const int8_t *filter_data,
+                                 const int32_t *bias,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const conv_params_t *conv_params,
+                                 const quant_plan_data_t *quant_data)
+{
+    const conv_path_p4_t path = conv_select_path_p4(input_dims, filter_dims, output_dims,
+                                                    conv_params);
+    if (ctx->scratch == NULL && path != CONV_PATH_OPT) {
+        printf("esp_nn_conv error! scratch_buffer not set!\n");
+        return;
+    }
+    conv_pie_enable();
+
+    ESP_NN_SCRATCH_GUARDED("conv_s8", ctx->scratch,
+                           conv_scratch_size_p4(path, input_dims, filter_dims, output_dims,
+                                                conv_params),
+                           conv_run_path_p4(path, input_dims, input, filter_dims, filter_data,
+                                            bias, output_dims, out_data, conv_params,
+                                            quant_data, NULL, ctx->scratch, ctx->mover));
+}
+
+void esp_nn_conv_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                const data_dims_t *input_dims,
+                                const int8_t *input,
+                                const data_dims_t *filter_dims,
+                                const int8_t *filter_data,
+                                const int32_t *bias,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const conv_params_t *conv_params,
+                                const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_plan_esp32p4(ctx, input_dims, input, filter_dims, filter_data, bias,
+                                output_dims, out_data, conv_params, &no_plan);
+}
+
+int32_t esp_nn_get_conv_prepared_size_esp32p4(const data_dims_t *input_dims,
+                                              const data_dims_t *filter_dims,
+                                              const data_dims_t *output_dims,
+                                              const conv_params_t *conv_params)
+{
+    int32_t size = ESP_NN_CONV_PREPARED_HDR_SIZE(output_dims->channels);
+    if (conv_select_path_p4(input_dims, filter_dims, output_dims, conv_params) != CONV_PATH_OPT) {
+        size += output_dims->channels * sizeof(int32_t);
+    }
+    return size;
+}
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_esp32p4(void *blob,
+                                                      const data_dims_t *input_dims,
+                                                      const data_dims_t *filter_dims,
+                                                      const int8_t *filter_data,
+                                                      const int32_t *bias,
+                                                      const data_dims_t *output_dims,
+                                                      const conv_params_t *conv_params,
+                                                      const quant_data_t *quant_data)
+{
+    esp_nn_conv_prepared_t *prep = esp_nn_conv_prepared_init(blob, input_dims, filter_dims,
+                                                             filter_data, bias, output_dims,
+                                                             conv_params, quant_data);
+    if (prep == NULL) {
+        return NULL;
+    }
+    prep->path = conv_select_path_p4(input_dims, filter_dims, output_dims, conv_params);
+    if (prep->path != CONV_PATH_OPT) {
+        /* The PIE kernels take the filter as is and add bias themselves:
+         * only the offset accumulators are worth keeping */
+        int32_t *offset_acc = (int32_t *) ((int8_t *) blob + ESP_NN_CONV_PREPARED_HDR_SIZE(output_dims->channels));
+        esp_nn_conv_fold_offset(filter_data, filter_dims->width * filter_dims->height * input_dims->channels,
+                                output_dims->channels, conv_params->in_offset, NULL, offset_acc);
+        prep->offset_acc = offset_acc;
+    }
+    return prep;
+}
+
+void esp_nn_conv_s8_run_esp32p4(const esp_nn_ctx_t *ctx,
+                                const esp_nn_conv_prepared_t *prep,
+                                const int8_t *input_data,
+                                int8_t *out_data)
+{
+    const conv_path_p4_t path = (conv_path_p4_t) prep->path;
+    if (ctx->scratch == NULL && path != CONV_PATH_OPT) {
+        printf("esp_nn_conv error! scratch_buffer not set!\n");
+        return;
+    }
+    conv_pie_enable();
+
+    ESP_NN_SCRATCH_GUARDED("conv_s8", ctx->scratch,
+                           conv_scratch_size_p4(path, &prep->input_dims, &prep->filter_dims,
+                                                &prep->output_dims, &prep->conv_params),
+                           conv_run_path_p4(path, &prep->input_dims, input_data,
+                                            &prep->filter_dims, prep->filter, prep->bias,
+                                            &prep->output_dims, out_data, &prep->conv_params,
+                                            &prep->quant_data, prep->offset_acc,
+                                            ctx->scratch, ctx->mover));
 }
 
 void esp_nn_conv_s8_esp32p4(const data_dims_t *input_dims,
@@ -992,43 +1301,6 @@ void esp_nn_conv_s8_esp32p4(const data_dims_t *input_dims,
                             const conv_params_t *conv_params,
                             const quant_data_t *quant_data)
 {
-    if (scratch_buffer == NULL) {
-        printf("esp_nn_conv error! scratch_buffer not set!\n");
-        return;
-    }
-
-    const uint16_t filter_wd = filter_dims->width;
-    const uint16_t filter_ht = filter_dims->height;
-    const uint16_t pad_wd = conv_params->padding.width;
-    const uint16_t pad_ht = conv_params->padding.height;
-    const uint16_t stride_wd = conv_params->stride.width;
-    const uint16_t stride_ht = conv_params->stride.height;
-
-    if (filter_wd == 1 && filter_ht == 1 && pad_wd == 0 && pad_ht == 0 &&
-            stride_wd == 1 && stride_ht == 1) {
-        esp_nn_conv_s8_1x1(input_dims, input, filter_data, bias,
-                           output_dims, out_data, conv_params, quant_data,
-                           scratch_buffer);
-    } else if (pad_wd == 0 && pad_ht == 0 &&
-               filter_wd * input_dims->channels >= 16) {
-        /* No-pad, channels large enough for PIE: use direct padded path */
-        esp_nn_conv_s8_padded(input_dims, input, filter_dims, filter_data, bias,
-                              output_dims, out_data, conv_params, quant_data,
-                              scratch_buffer);
-    } else if (filter_wd * filter_ht * input_dims->channels >= 16) {
-        /* Small in_ch but window_len >= 16: use im2col for zero-waste PIE.
-         * Also handles padded cases naturally. */
-        esp_nn_conv_s8_im2col(input_dims, input, filter_dims, filter_data, bias,
-                              output_dims, out_data, conv_params, quant_data,
-                              scratch_buffer);
-    } else if (pad_wd != 0 || pad_ht != 0) {
-        /* Padded case with very small window: use tiled path */
-        esp_nn_conv_s8_tiled(input_dims, input, filter_dims, filter_data, bias,
-                             output_dims, out_data, conv_params, quant_data,
-                             scratch_buffer);
-    } else {
-        /* Tiny output: fall back to generic opt */
-        esp_nn_conv_s8_opt(input_dims, input, filter_dims, filter_data, bias,
-                           output_dims, out_data, conv_params, quant_data);
-    }
+    esp_nn_conv_s8_ctx_esp32p4(&legacy_ctx, input_dims, input, filter_dims, filter_data,
+                               bias, output_dims, out_data, conv_params, quant_data);
 }
@@ -52,6 +52,13 @@
  *          window_len = filter_wd * filter_ht * in_ch (e.g., 3*3*3 = 27)
  *      - For each output pixel: copy the input window into a scratch buffer,
  *        then use ACCX dot product on the full window. No wasted MACs.
+ *      - Dilated layers run here whatever their channels: the copy picks the
+ *        taps apart, the dot product does not change.
+ *
+ * 4. Grouped version: (Refer conv_run_grouped_s3)
+ *      - Each group is a plain conv over a slice of the channels. Its input
+ *        channels are gathered into scratch, it runs on whichever of the above
+ *        its own shape selects, and its output channels are put back in place.
  */
 
 #include <stdio.h>
@@ -75,18 +82,19 @@ extern void esp_nn_conv_s8_3x3_opt(const int8_t *input,
     void *scratch);
 
 /* ANSI C reference conv for comparison */
-extern void esp_nn_conv_s8_ansi(const data_dims_t *input_dims,
-                                const int8_t *input_data,
-                                const data_dims_t *filter_dims,
-                                const int8_t *filter_data,
-                                const int32_t *bias,
-                                const data_dims_t *output_dims,
-                                int8_t *out_data,
-                                const conv_params_t *conv_params,
-                                const quant_data_t *quant_data);
+extern void esp_nn_conv_s8_plan_ansi(const esp_nn_ctx_t *ctx,
+                                     const data_dims_t *input_dims,
+                                     const int8_t *input_data,
+                                     const data_dims_t *filter_dims,
+                                     const int8_t *filter_data,
+                                     const int32_t *bias,
+                                     const data_dims_t *output_dims,
+                                     int8_t *out_data,
+                                     const conv_params_t *conv_params,
+                                     const quant_plan_data_t *quant_data);
 
 /* 1x1 conv — correct SIMD implementation */
-extern int esp_nn_conv_s8_1x1_scratch_size(int out_channels);
+extern int esp_nn_conv_s8_1x1_scratch_size(int size, int in_channels);
 extern void esp_nn_conv_s8_1x1(const int8_t *input,
                                 const uint16_t input_wd,
                                 const uint16_t input_ht,
@@ -103,19 +111,8 @@ extern void esp_nn_conv_s8_1x1(const int8_t *input,
                                 const int32_t activation_max,
                                 void *scratch);
 
-/* Debug heap checks — enable to find buffer overruns */
-#if CONFIG_IDF_CMAKE
-#include "esp_heap_caps.h"
-#define CONV_HEAP_CHECK(tag) do { \
-    if (!heap_caps_check_integrity_all(false)) { \
-        printf("CONV HEAP CORRUPT: %s\n", tag); \
-    } \
-} while(0)
-#else
-#define CONV_HEAP_CHECK(tag)
-#endif
-
-static int16_t *scratch_buffer = NULL;
+/* scratch of the legacy (non `_ctx`) API, set with esp_nn_set_conv_scratch_buf */
+static esp_nn_ctx_t legacy_ctx;
 
 extern void esp_nn_conv_s8_mult8_1x1_esp32s3(
                 const int8_t *input_data,
@@ -161,6 +158,114 @@ extern void esp_nn_conv_s8_filter_aligned_input_padded_esp32s3(
 
 /* Use shared dot product from common — see esp_nn_dot_s8_esp32s3.S */
 
+/* Kernel paths of the dispatcher, also recorded in prepared blobs */
+typedef enum {
+    CONV_PATH_ANSI = 0,     /* grouped conv the groups don't split evenly */
+    CONV_PATH_1X1_MULT8,
+    CONV_PATH_1X1,
+    CONV_PATH_IM2COL,
+    CONV_PATH_GENERAL,
+    CONV_PATH_GENERAL_FOLDED,   /* general, with the input offset folded into the bias first */
+    CONV_PATH_GROUPED,          /* grouped conv, each group on the path of its own shape */
+} conv_path_s3_t;
+
+/* Groups of a grouped conv that splits into plain ones, 0 otherwise */
+static int32_t conv_groups_s3(const data_dims_t *input_dims,
+                              const data_dims_t *filter_dims,
+                              const data_dims_t *output_dims)
+{
+    const int32_t filter_ch = filter_dims->channels;
+
+    if (filter_ch == 0 || input_dims->channels % filter_ch) {
+        return 0;
+    }
+    const int32_t groups = input_dims->channels / filter_ch;
+    return output_dims->channels % groups ? 0 : groups;
+}
+
+/* One group of a grouped conv as a plain conv over one image */
+static void conv_group_dims_s3(const data_dims_t *input_dims,
+                               const data_dims_t *filter_dims,
+                               const data_dims_t *output_dims,
+                               data_dims_t *group_in_dims,
+                               data_dims_t *group_out_dims)
+{
+    const int32_t groups = input_dims->channels / filter_dims->channels;
+
+    *group_in_dims = *input_dims;
+    group_in_dims->channels = filter_dims->channels;
+    group_in_dims->extra = 1;
+    *group_out_dims = *output_dims;
+    group_out_dims->channels = output_dims->channels / groups;
+    group_out_dims->extra = 1;
+}
+
+/* Path from the shape alone, used unless autotuning picked another one */
+static conv_path_s3_t conv_default_path_s3(const data_dims_t *input_dims,
+                                           const data_dims_t *filter_dims,
+                                           const data_dims_t *output_dims,
+                                           const conv_params_t *conv_params)
+{
+    const int32_t channels = input_dims->channels;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+
+    if (channels != filter_dims->channels) {
+        return conv_groups_s3(input_dims, filter_dims, output_dims) ? CONV_PATH_GROUPED :
+                                                                      CONV_PATH_ANSI;
+    }
+    /* Only the im2col gather takes dilated taps */
+    if (esp_nn_is_dilated(filter_dims, &conv_params->dilation)) {
+        return CONV_PATH_IM2COL;
+    }
+    if (filter_wd == 1 && filter_ht == 1 &&
+            conv_params->padding.width == 0 && conv_params->padding.height == 0 &&
+            conv_params->stride.width == 1 && conv_params->stride.height == 1) {
+        return (channels % 8 == 0) ? CONV_PATH_1X1_MULT8 : CONV_PATH_1X1;
+    }
+    /* Im2col path: small in_ch where per-row SIMD is wasteful,
+     * but entire window is large enough for SIMD dot product.
+     * E.g., 3x3 conv with in_ch=3: row=9 (<16), window=27 (>=16). */
+    if (filter_wd * channels < 16 && filter_wd * filter_ht * channels >= 16) {
+        return CONV_PATH_IM2COL;
+    }
+    /* Folding the offset costs a pass over the filter per call, worth it for large ones */
+    if (filter_wd * filter_ht * channels * output_dims->channels > 16384) {
+        return CONV_PATH_GENERAL_FOLDED;
+    }
+    return CONV_PATH_GENERAL;
+}
+
+static conv_path_s3_t conv_select_path_s3(const data_dims_t *input_dims,
+                                          const data_dims_t *filter_dims,
+                                          const data_dims_t *output_dims,
+                                          const conv_params_t *conv_params);
+
+/**
+ * Im2col filter packing: per channel corrections (filter_sum * input_offset + bias)
+ * and a copy of the filter with each window zero padded to 16 bytes.
+ */
+static void esp_nn_conv_s8_im2col_pack_s3(const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          const int32_t window_len,
+                                          const int32_t out_ch,
+                                          const int32_t input_offset,
+                                          int32_t *corrections,
+                                          int8_t *aligned_filter)
+{
+    /* Align to 16 for SIMD: zero-padded tail doesn't affect dot product */
+    const int32_t window_len_aligned = (window_len + 15) & ~15;
+
+    esp_nn_conv_fold_offset(filter_data, window_len, out_ch, input_offset, bias, corrections);
+    for (int32_t oc = 0; oc < out_ch; oc++) {
+        /* Copy filter + zero-pad tail for safe SIMD reads */
+        memcpy(aligned_filter, filter_data, window_len);
+        memset(aligned_filter + window_len, 0, window_len_aligned - window_len);
+        filter_data += window_len;
+        aligned_filter += window_len_aligned;
+    }
+}
+
 /**
  * Im2col convolution for small in_ch (filter_wd * in_ch < 16).
  *
@@ -171,20 +276,21 @@ extern void esp_nn_conv_s8_filter_aligned_input_padded_esp32s3(
  * For each output pixel: copy the input window into a contiguous scratch
  * buffer, then use ACCX dot product. No wasted MACs.
  *
- * Scratch layout: [filter_sum[out_ch] | im2col_buf[window_len_aligned]]
+ * `aligned_filter` and `corrections` come from esp_nn_conv_s8_im2col_pack_s3,
+ * `im2col_buf` is window_len_aligned bytes, 16 byte aligned.
  */
 __attribute__ ((noinline))
 static void esp_nn_conv_s8_im2col_s3(
         const data_dims_t *input_dims,
         const int8_t *input_data,
         const data_dims_t *filter_dims,
-        const int8_t *filter_data,
-        const int32_t *bias,
+        const int8_t *aligned_filter,
+        const int32_t *corrections,
         const data_dims_t *output_dims,
         int8_t *out_data,
         const conv_params_t *conv_params,
-        const quant_data_t *quant_data,
-        void *scratch)
+        const quant_plan_data_t *quant_data,
+        int8_t *im2col_buf)
 {
     const uint16_t input_wd = input_dims->width;
     const uint16_t input_ht = input_dims->height;
@@ -198,6 +304,8 @@ static void esp_nn_conv_s8_im2col_s3(
     const uint16_t pad_ht = conv_params->padding.height;
     const uint16_t stride_wd = conv_params->stride.width;
     const uint16_t stride_ht = conv_params->stride.height;
+    const int32_t dilation_wd = esp_nn_dilation(conv_params->dilation.width);
+    const int32_t dilation_ht = esp_nn_dilation(conv_params->dilation.height);
     const int32_t input_offset = conv_params->in_offset;
     const int32_t out_offset = conv_params->out_offset;
     const int32_t activation_min = conv_params->activation.min;
@@ -208,41 +316,19 @@ static void esp_nn_conv_s8_im2col_s3(
     const int32_t window_len_aligned = (window_len + 15) & ~15;
     const int8_t pad_val = (int8_t)(-input_offset);
 
-    /* Scratch layout (16-byte aligned):
-     * [filter_sum: out_ch * 4]
-     * [aligned_filter: out_ch * window_len_aligned]  -- zero-padded copy
-     * [im2col_buf: window_len_aligned]
-     */
-    int32_t *filter_sum = (int32_t *)scratch;
-    int8_t *aligned_filter = (int8_t *)((uintptr_t)((int8_t *)scratch + out_ch * sizeof(int32_t) + 15) & ~15);
-    int8_t *im2col_buf = (int8_t *)((uintptr_t)(aligned_filter + out_ch * window_len_aligned + 15) & ~15);
-
-    /* Pre-compute filter_sum * input_offset AND copy filter with zero-padded tail */
-    const int8_t *fptr = filter_data;
-    int8_t *af_ptr = aligned_filter;
-    for (int32_t oc = 0; oc < out_ch; oc++) {
-        int32_t sum = 0;
-        for (int32_t fi = 0; fi < window_len; fi++) {
-            sum += fptr[fi];
-        }
-        filter_sum[oc] = sum * input_offset;
-        /* Copy filter + zero-pad tail for safe SIMD reads */
-        memcpy(af_ptr, fptr, window_len);
-        memset(af_ptr + window_len, 0, window_len_aligned - window_len);
-        fptr += window_len;
-        af_ptr += window_len_aligned;
-    }
-
     /* Zero the tail of im2col buffer once (for aligned SIMD reads) */
     memset(im2col_buf + window_len, 0, window_len_aligned - window_len);
 
     /* Compute safe interior region where no bounds checking needed.
-     * Interior: all filter taps fall within valid input. */
+     * Interior: all filter taps fall within valid input. Dilated taps
+     * span dilation * (filter - 1) + 1 input pixels. */
     const int32_t row_bytes = filter_wd * in_ch;
+    const int32_t extent_wd = dilation_wd * (filter_wd - 1) + 1;
+    const int32_t extent_ht = dilation_ht * (filter_ht - 1) + 1;
     int32_t safe_y_start = (pad_ht + stride_ht - 1) / stride_ht;
-    int32_t safe_y_end = (input_ht - filter_ht + pad_ht) / stride_ht + 1;
+    int32_t safe_y_end = (input_ht - extent_ht + pad_ht) / stride_ht + 1;
     int32_t safe_x_start = (pad_wd + stride_wd - 1) / stride_wd;
-    int32_t safe_x_end = (input_wd - filter_wd + pad_wd) / stride_wd + 1;
+    int32_t safe_x_end = (input_wd - extent_wd + pad_wd) / stride_wd + 1;
     if (safe_y_start > out_ht) safe_y_start = out_ht;
     if (safe_y_end > out_ht) safe_y_end = out_ht;
     if (safe_y_end < safe_y_start) safe_y_end = safe_y_start;
@@ -264,19 +350,29 @@ static void esp_nn_conv_s8_im2col_s3(
 
             if (is_safe_y && out_x >= safe_x_start && out_x < safe_x_end) {
                 /* FAST PATH: interior pixel — no bounds checking needed.
-                 * All filter taps guaranteed to be within valid input. */
+                 * All filter taps guaranteed to be within valid input.
+                 * Undilated rows are contiguous, dilated ones go tap by tap. */
                 for (int32_t fy = 0; fy < filter_ht; fy++) {
-                    const int8_t *src = input_data + ((base_y + fy) * input_wd + base_x) * in_ch;
-                    memcpy(buf, src, row_bytes);
-                    buf += row_bytes;
+                    const int8_t *src = input_data +
+                                        ((base_y + fy * dilation_ht) * input_wd + base_x) * in_ch;
+                    if (dilation_wd == 1) {
+                        memcpy(buf, src, row_bytes);
+                        buf += row_bytes;
+                    } else {
+                        for (int32_t fx = 0; fx < filter_wd; fx++) {
+                            memcpy(buf, src, in_ch);
+                            buf += in_ch;
+                            src += dilation_wd * in_ch;
+                        }
+                    }
                 }
             } else {
                 /* SLOW PATH: edge pixel — per-element bounds checking */
                 for (int32_t fy = 0; fy < filter_ht; fy++) {
-                    int32_t in_y = base_y + fy;
+                    int32_t in_y = base_y + fy * dilation_ht;
                     if (in_y >= 0 && in_y < input_ht) {
                         for (int32_t fx = 0; fx < filter_wd; fx++) {
-                            int32_t in_x = base_x + fx;
+                            int32_t in_x = base_x + fx * dilation_wd;
                             if (in_x >= 0 && in_x < input_wd) {
                                 const int8_t *src = input_data + (in_y * input_wd + in_x) * in_ch;
                                 memcpy(buf, src, in_ch);
@@ -293,15 +389,12 @@ static void esp_nn_conv_s8_im2col_s3(
             }
 
             /* Dot product against each output channel's filter (aligned copy) */
-            const int32_t *out_mult_ptr = quant_data->mult;
-            const int32_t *out_shift_ptr = quant_data->shift;
             const int8_t *filter_ptr = aligned_filter;
 
             for (int32_t oc = 0; oc < out_ch; oc++) {
                 int32_t conv_out = esp_nn_dot_s8_aligned_esp32s3(im2col_buf, filter_ptr, window_len_aligned);
-                conv_out += filter_sum[oc];
-                if (bias) conv_out += bias[oc];
-                conv_out = esp_nn_requantize(conv_out, *out_mult_ptr++, *out_shift_ptr++);
+                conv_out += corrections[oc];
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, oc);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -312,93 +405,289 @@ static void esp_nn_conv_s8_im2col_s3(
     }
 }
 
-int esp_nn_get_conv_scratch_size_esp32s3(const data_dims_t *input_dims,
+/* Every image of a batch through the im2col kernel, the filter packed once for all */
+static void esp_nn_conv_s8_im2col_batch_s3(const data_dims_t *input_dims,
+                                           const int8_t *input_data,
+                                           const data_dims_t *filter_dims,
+                                           const int8_t *aligned_filter,
+                                           const int32_t *corrections,
+                                           const data_dims_t *output_dims,
+                                           int8_t *out_data,
+                                           const conv_params_t *conv_params,
+                                           const quant_plan_data_t *quant_data,
+                                           int8_t *im2col_buf)
+{
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_dims->width * input_dims->height * input_dims->channels;
+    const int32_t output_size = output_dims->width * output_dims->height * output_dims->channels;
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        esp_nn_conv_s8_im2col_s3(input_dims, input_data + batch * input_size, filter_dims,
+                                 aligned_filter, corrections, output_dims,
+                                 out_data + batch * output_size, conv_params, quant_data,
+                                 im2col_buf);
+    }
+}
+
+/* The SIMD kernels load up to this many bytes past the end of their scratch data, never storing there */
+#define CONV_S3_READ_MARGIN     32
+
+static inline int32_t conv_align16_s3(const int32_t size)
+{
+    return (size + 15) & ~15;
+}
+
+/* Scratch is aligned in place: sizes below reserve 15 bytes for it where the kernel needs it */
+static inline int8_t *conv_scratch_align_s3(void *scratch)
+{
+    return (int8_t *) (((uintptr_t) scratch + 15) & ~15);
+}
+
+#ifndef CONFIG_NN_CONV_TILE_BUDGET
+#define CONFIG_NN_CONV_TILE_BUDGET  32768
+#endif
+
+/* Size of the input the general path pads, false if it runs on the input as is */
+static bool conv_padded_dims_s3(const data_dims_t *input_dims,
+                                const data_dims_t *filter_dims,
+                                const data_dims_t *output_dims,
+                                const conv_params_t *conv_params,
+                                int32_t *padded_wd, int32_t *padded_ht)
+{
+    const int32_t input_wd = input_dims->width;
+    const int32_t input_ht = input_dims->height;
+    const int32_t pad_wd = conv_params->padding.width;
+    const int32_t pad_ht = conv_params->padding.height;
+
+    if (pad_wd != 0 || pad_ht != 0) {
+        /* padding.height alone isn't the bottom padding: a layer split into rows keeps only the top */
+        const int32_t extra_right = max(0, (output_dims->width - 1) * conv_params->stride.width +
+                                        filter_dims->width - (input_wd + 2 * pad_wd));
+        const int32_t extra_bottom = max(0, (output_dims->height - 1) * conv_params->stride.height +
+                                         filter_dims->height - (input_ht + 2 * pad_ht));
+        *padded_wd = input_wd + 2 * pad_wd + extra_right;
+        *padded_ht = input_ht + 2 * pad_ht + extra_bottom;
+        return true;
+    }
+    const int32_t pad_right = max(0, (output_dims->width * conv_params->stride.width +
+                                      filter_dims->width - 1) - input_wd);
+    const int32_t pad_bottom = max(0, (output_dims->height * conv_params->stride.height +
+                                       filter_dims->height - 1) - input_ht);
+    *padded_wd = input_wd + pad_right;
+    *padded_ht = input_ht + pad_bottom;
+    return pad_right > 0 || pad_bottom > 0;
+}
+
+/* Fewest output rows a strip runs: below that the filter is reread for too little input */
+#define CONV_STRIP_MIN_ROWS_S3  4
+
+/**
+ * Output rows the general path pads and runs at a time: all of them, unless
+ * the padded input outgrows CONFIG_NN_CONV_TILE_BUDGET. Then strips of rows
+ * are padded in turn, their input staying in the data cache while every
+ * output channel reads it. Two strip buffers share the budget: the next strip
+ * is staged while the asm runs on the current one. The filter is not charged
+ * against the budget, it streams through once per strip whatever its size.
+ * Rows too wide for CONV_STRIP_MIN_ROWS_S3 output rows a strip run that many
+ * anyway, over the budget.
+ */
+static int32_t conv_strip_rows_s3(const data_dims_t *input_dims,
+                                  const data_dims_t *filter_dims,
+                                  const data_dims_t *output_dims,
+                                  const conv_params_t *conv_params)
+{
+    const int32_t out_ht = output_dims->height;
+    int32_t padded_wd, padded_ht;
+
+    if (!conv_padded_dims_s3(input_dims, filter_dims, output_dims, conv_params,
+                             &padded_wd, &padded_ht)) {
+        return out_ht;
+    }
+    const int32_t row_size = padded_wd * input_dims->channels;
+    if (row_size * padded_ht <= CONFIG_NN_CONV_TILE_BUDGET) {
+        return out_ht;
+    }
+    const int32_t strip_in_rows = CONFIG_NN_CONV_TILE_BUDGET / (2 * row_size);
+    const int32_t rows = (strip_in_rows - filter_dims->height) / conv_params->stride.height + 1;
+    return min(out_ht, max(CONV_STRIP_MIN_ROWS_S3, rows));
+}
+
+/* Input the general path pads into scratch, 0 if it runs on the input as is */
+static int32_t conv_padded_image_size_s3(const data_dims_t *input_dims,
                                          const data_dims_t *filter_dims,
                                          const data_dims_t *output_dims,
                                          const conv_params_t *conv_params)
 {
-    const uint16_t input_wd = input_dims->width;
-    const uint16_t input_ht = input_dims->height;
-    const uint16_t in_ch = input_dims->channels;
-    const uint16_t filter_wd = filter_dims->width;
-    const uint16_t filter_ht = filter_dims->height;
-    const uint16_t out_ch = output_dims->channels;
-    const uint16_t pad_wd = conv_params->padding.width;
-    const uint16_t pad_ht = conv_params->padding.height;
-    const uint16_t stride_wd = conv_params->stride.width;
-    const uint16_t stride_ht = conv_params->stride.height;
+    int32_t padded_wd, padded_ht;
 
-    int new_channels = (in_ch + 7) & ~7;
+    if (!conv_padded_dims_s3(input_dims, filter_dims, output_dims, conv_params,
+                             &padded_wd, &padded_ht)) {
+        return 0;
+    }
+    const int32_t strip_rows = conv_strip_rows_s3(input_dims, filter_dims, output_dims,
+                                                  conv_params);
+    if (strip_rows < output_dims->height) {
+        /* one strip buffer */
+        padded_ht = (strip_rows - 1) * conv_params->stride.height + filter_dims->height;
+    }
+    return padded_wd * padded_ht * input_dims->channels;
+}
 
-    int input_scratch = input_wd * input_ht * in_ch;
-    int filter_scratch = filter_wd * filter_ht * in_ch * out_ch;
+/* Scratch of the padded input: the image, or two strip buffers, 16 byte aligned */
+static int32_t conv_padded_input_size_s3(const data_dims_t *input_dims,
+                                         const data_dims_t *filter_dims,
+                                         const data_dims_t *output_dims,
+                                         const conv_params_t *conv_params)
+{
+    const int32_t buffers = conv_strip_rows_s3(input_dims, filter_dims, output_dims,
+                                               conv_params) < output_dims->height ? 2 : 1;
+    return buffers * conv_align16_s3(conv_padded_image_size_s3(input_dims, filter_dims,
+                                                               output_dims, conv_params));
+}
 
-    int align_buf_size = 64; /* alignment (16) + assembly pre/post access margin (48) */
-    if ((filter_wd == 1 && filter_ht == 1 && pad_wd == 0 && pad_ht == 0) &&
-            (stride_wd == 1 && stride_ht == 1)) {
-        int transpose_buf_size = 2 * (8 * new_channels);
-        if (input_wd * input_ht < 8) {
-            transpose_buf_size = 0;
-        }
-        if (in_ch % 8) {
-            input_scratch = input_wd * input_ht * new_channels;
-        } else {
-            input_scratch = 0;
-        }
-        filter_scratch = new_channels * out_ch;
-        return input_scratch + filter_scratch + transpose_buf_size + align_buf_size;
-    } else {
-        int32_t filter_row_size = filter_wd * in_ch;
-        int32_t window_len = filter_wd * filter_ht * in_ch;
-
-        /* Im2col path: filter_wd * in_ch < 16 but window_len >= 16 */
-        if (filter_row_size < 16 && window_len >= 16) {
-            int32_t window_len_aligned = (window_len + 15) & ~15;
-            /* filter_sum + aligned_filter_copy + im2col_buf + alignment padding */
-            int im2col_scratch = out_ch * 4 + 16 + out_ch * window_len_aligned + 16 + window_len_aligned;
-            return im2col_scratch + align_buf_size;
-        }
+/**
+ * Rows [first_row, first_row + rows) of the padded input, `pad_left` / `pad_top`
+ * before the input. Input rows are started on `mover`, returns the ticket of the
+ * last one, -1 if none.
+ */
+static int32_t conv_pad_rows_s3(const int8_t *input, const int32_t input_wd, const int32_t input_ht,
+                                const int32_t channels, const int8_t pad_val,
+                                const int32_t pad_left, const int32_t pad_top,
+                                const int32_t padded_wd, const int32_t first_row,
+                                const int32_t rows, int8_t *dst,
+                                const esp_nn_tile_mover_t *mover)
+{
+    const int32_t row_size = input_wd * channels;
+    const int32_t left = pad_left * channels;
+    const int32_t right = (padded_wd - pad_left - input_wd) * channels;
+    int32_t ticket = -1;
 
-        new_channels = (in_ch + 15) & ~15;
-        if (pad_wd == 0 && pad_ht == 0) {
-            input_scratch = 0;
+    for (int32_t r = first_row; r < first_row + rows; r++) {
+        const int32_t in_row = r - pad_top;
+        if (in_row < 0 || in_row >= input_ht) {
+            memset(dst, pad_val, left + row_size + right);
         } else {
-            input_scratch = (input_wd + 2 * pad_wd) * (input_ht + 2 * pad_ht) * in_ch;
-        }
-        filter_scratch = filter_wd * filter_ht * new_channels * out_ch;
-
-        // Account for filter alignment padding (worst case)
-        int32_t aligned_filter_row_size = ((filter_row_size + 15) / 16) * 16;
-        int filter_alignment_scratch = aligned_filter_row_size * filter_ht * out_ch;
-
-        // Account for right/bottom padding even when pad_wd=0, pad_ht=0
-        int pad_right = max(0, (output_dims->width * stride_wd + filter_wd - 1) - input_wd);
-        int pad_bottom = max(0, (output_dims->height * stride_ht + filter_ht - 1) - input_ht);
-        int boundary_padding_scratch = 0;
-        if (pad_right > 0 || pad_bottom > 0) {
-            boundary_padding_scratch = (input_wd + pad_right) * (input_ht + pad_bottom) * in_ch;
+            memset(dst, pad_val, left);
+            ticket = esp_nn_tile_copy(mover, dst + left, input + in_row * row_size, row_size);
+            memset(dst + left + row_size, pad_val, right);
         }
+        dst += left + row_size + right;
+    }
+    return ticket;
+}
+
+/* Bytes of scratch `path` touches on an unprepared call, prepared runs need less */
+static int conv_scratch_size_s3(const conv_path_s3_t path,
+                                const data_dims_t *input_dims,
+                                const data_dims_t *filter_dims,
+                                const data_dims_t *output_dims,
+                                const conv_params_t *conv_params)
+{
+    const int32_t in_ch = input_dims->channels;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    const int32_t out_ch = output_dims->channels;
+    /* pixels of the 1x1 kernels, which run a batch as one tall image */
+    const int32_t size = input_dims->width * input_dims->height * esp_nn_batches(input_dims);
 
-        int offset_acc_scratch = out_ch * 4;
-        return input_scratch + filter_scratch + filter_alignment_scratch + boundary_padding_scratch + align_buf_size + offset_acc_scratch;
+    switch (path) {
+    case CONV_PATH_1X1_MULT8:
+        /* input offset added, 8 positions transposed to int16: 16 bytes per channel */
+        if (size < 8) {
+            return 0;
+        }
+        return 15 + in_ch * 16 + CONV_S3_READ_MARGIN;
+    case CONV_PATH_1X1:
+        return esp_nn_conv_s8_1x1_scratch_size(size, in_ch);
+    case CONV_PATH_IM2COL: {
+        /* corrections, then the window padded filter and the window, all 16 byte aligned */
+        const int32_t window_len_aligned = conv_align16_s3(filter_wd * filter_ht * in_ch);
+        return 15 + conv_align16_s3(out_ch * 4) + out_ch * window_len_aligned + window_len_aligned;
+    }
+    case CONV_PATH_GENERAL:
+    case CONV_PATH_GENERAL_FOLDED: {
+        /* filter with 16 byte rows: rows already aligned are still copied when the
+         * filter address isn't, which is unknown here */
+        const int32_t filter_copy = conv_align16_s3(filter_wd * in_ch) * filter_ht * out_ch;
+        const int32_t padded_input = conv_padded_input_size_s3(input_dims, filter_dims,
+                                                               output_dims, conv_params);
+        /* then the per channel accumulators, shared with the folded corrections */
+        return 15 + filter_copy + padded_input + out_ch * 4 + CONV_S3_READ_MARGIN;
+    }
+    case CONV_PATH_GROUPED: {
+        /* the input channels of a group, its output channels, then its kernel's scratch */
+        data_dims_t group_in_dims, group_out_dims;
+        conv_group_dims_s3(input_dims, filter_dims, output_dims, &group_in_dims, &group_out_dims);
+        const conv_path_s3_t group_path = conv_select_path_s3(&group_in_dims, filter_dims,
+                                                              &group_out_dims, conv_params);
+        return 15 + conv_align16_s3(input_dims->width * input_dims->height * filter_dims->channels) +
+               conv_align16_s3(output_dims->width * output_dims->height * group_out_dims.channels) +
+               conv_scratch_size_s3(group_path, &group_in_dims, filter_dims, &group_out_dims,
+                                    conv_params);
+    }
+    default:
+        /* ANSI C takes no scratch */
+        return 0;
     }
-    return align_buf_size;
+}
+
+int esp_nn_get_conv_scratch_size_esp32s3(const data_dims_t *input_dims,
+                                         const data_dims_t *filter_dims,
+                                         const data_dims_t *output_dims,
+                                         const conv_params_t *conv_params)
+{
+    return conv_scratch_size_s3(conv_select_path_s3(input_dims, filter_dims, output_dims, conv_params),
+                                input_dims, filter_dims, output_dims, conv_params) +
+           ESP_NN_SCRATCH_GUARD_SIZE;
 }
 
 void esp_nn_set_conv_scratch_buf_esp32s3(void *buf)
 {
-    scratch_buffer = (int16_t *) buf;
+    legacy_ctx.scratch = buf;
 }
 
-void esp_nn_conv_s8_esp32s3(const data_dims_t *input_dims,
-                            const int8_t *input,
-                            const data_dims_t *filter_dims,
-                            const int8_t *filter_data,
-                            const int32_t *bias,
-                            const data_dims_t *output_dims,
-                            int8_t *out_data,
-                            const conv_params_t *conv_params,
-                            const quant_data_t *quant_data)
+/* Copy the filter with each `filter_wd * in_ch` row zero padded to 16 bytes */
+static void esp_nn_conv_s8_align_rows_s3(const int8_t *filter_data, int8_t *filter_data_aligned,
+                                         const int32_t filter_row_size, const int32_t filter_ht,
+                                         const int32_t out_channels)
+{
+    const int32_t new_row_size = (filter_row_size + 15) & ~15;
+    int8_t *row_ptr = filter_data_aligned;
+    for (int32_t ch_idx = 0; ch_idx < out_channels; ch_idx++) {
+        for (int32_t row_idx = 0; row_idx < filter_ht; row_idx++) {
+            memcpy(row_ptr, filter_data, filter_row_size);
+            memset(row_ptr + filter_row_size, 0, new_row_size - filter_row_size);
+            filter_data += filter_row_size;
+            row_ptr += new_row_size;
+        }
+    }
+}
+
+/**
+ * General path: pad the input with -input_offset into scratch where needed,
+ * then run the filter aligned asm, image by image for a batch. Large inputs
+ * are padded and run in strips of output rows, see conv_strip_rows_s3.
+ *
+ * `corrections` (filter_sum * input_offset + bias) fold the input offset out of
+ * the MACs, the asm then runs with offset 0 and takes them as its bias.
+ * When NULL, `fold` has them computed here into scratch first.
+ * `scratch_data` is 16 byte aligned, sized by conv_scratch_size_s3. Strips
+ * are staged through `mover`, NULL to copy them on the spot.
+ */
+static void esp_nn_conv_s8_general_s3(const data_dims_t *input_dims,
+                                      const int8_t *input,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int8_t *filter_data_aligned,
+                                      const int32_t *bias,
+                                      const int32_t *corrections,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const conv_params_t *conv_params,
+                                      const quant_plan_data_t *quant_data,
+                                      int8_t *scratch_data,
+                                      const bool fold,
+                                      const esp_nn_tile_mover_t *mover)
 {
     const uint16_t input_wd = input_dims->width;
     const uint16_t input_ht = input_dims->height;
@@ -419,32 +708,189 @@ void esp_nn_conv_s8_esp32s3(const data_dims_t *input_dims,
     const int32_t activation_min = conv_params->activation.min;
     const int32_t activation_max = conv_params->activation.max;
 
-    /* Grouped conv (filter_ch < input_ch): fall back to ansi which handles it */
-    if (channels != filter_dims->channels) {
-        esp_nn_conv_s8_ansi(input_dims, input, filter_dims, filter_data,
-                            bias, output_dims, out_data, conv_params, quant_data);
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * channels;
+    const int32_t output_size = out_wd * out_ht * out_channels;
+    int8_t *input_padded = NULL;
+    int32_t new_input_wd = input_wd, new_input_ht = input_ht;
+
+    /*
+     * Padded on all sides when pad_wd/pad_ht are set, with more rows / columns at
+     * the end where the windows reach past them, else only at the end where the
+     * filter extends beyond the input (like depthwise conv).
+     */
+    const bool pad_all = pad_wd != 0 || pad_ht != 0;
+    conv_padded_dims_s3(input_dims, filter_dims, output_dims, conv_params,
+                        &new_input_wd, &new_input_ht);
+    const int32_t strip_rows = conv_strip_rows_s3(input_dims, filter_dims, output_dims,
+                                                  conv_params);
+    if (new_input_wd != input_wd || new_input_ht != input_ht) {
+        /* one image at a time, or two strip buffers, is padded here */
+        input_padded = scratch_data;
+        scratch_data += conv_padded_input_size_s3(input_dims, filter_dims, output_dims,
+                                                  conv_params);
+    }
+
+    /* batches and strips fold the offset once instead of having the asm sum the filter per call */
+    if (corrections == NULL && input_offset != 0 &&
+            (fold || batches > 1 || strip_rows < out_ht)) {
+        // use ORIGINAL (not aligned) filter for sum
+        esp_nn_conv_fold_offset(filter_data, filter_wd * filter_ht * channels, out_channels,
+                                input_offset, bias, (int32_t *) scratch_data);
+        // Pass scratch_data as "bias" pointer — the assembly's bias-copy loop
+        // will read from scratch and write to scratch (identity, no-op).
+        corrections = (const int32_t *) scratch_data;
+    }
+
+    // Pass input_offset=0 to assembly so it skips its pre-computation.
+    const int32_t asm_offset = corrections ? 0 : input_offset;
+    const int32_t *asm_bias = corrections ? corrections : bias;
+
+    if (strip_rows < out_ht) {
+        /* the strips of every image in turn: strip s is staged while s - 1 runs */
+        const int32_t pad_left = pad_all ? pad_wd : 0;
+        const int32_t pad_top = pad_all ? pad_ht : 0;
+        const int32_t strips = (out_ht + strip_rows - 1) / strip_rows;
+        const int32_t strip_size = conv_align16_s3(conv_padded_image_size_s3(input_dims,
+                                                   filter_dims, output_dims, conv_params));
+        int32_t ticket = -1;
+        for (int32_t s = 0; s <= batches * strips; s++) {
+            const int32_t staged = ticket;
+            if (s < batches * strips) {
+                const int32_t y0 = (s % strips) * strip_rows;
+                const int32_t rows = min(strip_rows, out_ht - y0);
+                ticket = conv_pad_rows_s3(input + (s / strips) * input_size, input_wd, input_ht,
+                                          channels, -input_offset, pad_left, pad_top,
+                                          new_input_wd, y0 * stride_ht,
+                                          (rows - 1) * stride_ht + filter_ht,
+                                          input_padded + (s & 1) * strip_size, mover);
+            }
+            if (s == 0) {
+                continue;
+            }
+            const int32_t y0 = ((s - 1) % strips) * strip_rows;
+            const int32_t rows = min(strip_rows, out_ht - y0);
+            esp_nn_tile_wait(mover, staged);
+            esp_nn_conv_s8_filter_aligned_input_padded_esp32s3(
+                input_padded + ((s - 1) & 1) * strip_size, new_input_wd,
+                (rows - 1) * stride_ht + filter_ht, channels, asm_offset,
+                stride_wd, stride_ht, filter_data_aligned, filter_wd, filter_ht, asm_bias,
+                out_data + ((s - 1) / strips) * output_size + y0 * out_wd * out_channels,
+                out_wd, rows, out_channels, out_offset, out_shift, out_mult,
+                activation_min, activation_max, scratch_data);
+        }
+        return;
+    }
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        const int8_t *image = input + batch * input_size;
+        int8_t *image_out = out_data + batch * output_size;
+
+        if (pad_all) {
+            conv_pad_rows_s3(image, input_wd, input_ht, channels, -input_offset, pad_wd, pad_ht,
+                             new_input_wd, 0, new_input_ht, input_padded, NULL);
+            image = input_padded;
+        } else if (input_padded) {
+            esp_nn_aligned_s8_pad_end_with_value(image, input_padded, input_wd, input_ht, channels,
+                                                 -input_offset, new_input_wd - input_wd,
+                                                 new_input_ht - input_ht);
+            image = input_padded;
+        }
+
+        esp_nn_conv_s8_filter_aligned_input_padded_esp32s3(
+            image, new_input_wd, new_input_ht, channels, asm_offset,
+            stride_wd, stride_ht, filter_data_aligned, filter_wd, filter_ht,
+            asm_bias, image_out, out_wd, out_ht, out_channels, out_offset,
+            out_shift, out_mult, activation_min, activation_max, scratch_data);
+    }
+}
+
+static void conv_run_grouped_s3(const data_dims_t *input_dims,
+                                const int8_t *input,
+                                const data_dims_t *filter_dims,
+                                const int8_t *filter_data,
+                                const int32_t *bias,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const conv_params_t *conv_params,
+                                const quant_plan_data_t *quant_data,
+                                void *scratch,
+                                const esp_nn_tile_mover_t *mover);
+
+static void conv_run_path_s3(const int32_t path,
+                             const data_dims_t *input_dims,
+                             const int8_t *input,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_plan_data_t *quant_data,
+                             void *scratch,
+                             const esp_nn_tile_mover_t *mover)
+{
+    int16_t *scratch_buffer = (int16_t *) scratch;
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t input_ht = input_dims->height;
+    const uint16_t channels = input_dims->channels;
+    const int32_t input_offset = conv_params->in_offset;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const uint16_t out_channels = output_dims->channels;
+    const int32_t *out_shift = quant_data->shift;
+    const int32_t *out_mult = quant_data->mult;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    /* Grouped conv (filter_ch < input_ch) the groups don't split evenly: ansi handles it */
+    if (path == CONV_PATH_ANSI) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_ANSI,
+                         esp_nn_conv_s8_plan_ansi(NULL, input_dims, input, filter_dims,
+                                                  filter_data, bias, output_dims, out_data,
+                                                  conv_params, quant_data));
+        return;
+    }
+    if (path == CONV_PATH_GROUPED) {
+        conv_run_grouped_s3(input_dims, input, filter_dims, filter_data, bias, output_dims,
+                            out_data, conv_params, quant_data, scratch, mover);
         return;
     }
 
     int filter_size = filter_wd * filter_ht * channels * out_channels;
+    const int32_t batches = esp_nn_batches(input_dims);
 
-    /* 1x1 stride-1 conv */
-    if (filter_wd == 1 && filter_ht == 1 && pad_wd == 0 && pad_ht == 0 &&
-            stride_wd == 1 && stride_ht == 1) {
-        if (channels % 8 == 0) {
-            /* Full asm path — requires mult8 channels + 8-byte aligned filter */
-            esp_nn_conv_s8_mult8_1x1_esp32s3(input, input_wd, input_ht, channels,
-                               input_offset, filter_data, bias, out_data,
-                               out_wd, out_ht, out_channels, out_offset,
-                               out_shift, out_mult, activation_min, activation_max,
-                               scratch_buffer);
-        } else {
-            /* Fallback: handles any alignment + any channel count */
-            esp_nn_conv_s8_1x1(input, input_wd, input_ht, channels, input_offset,
-                               filter_data, bias, out_data, out_channels, out_offset,
-                               out_shift, out_mult, activation_min, activation_max,
-                               scratch_buffer);
+    /* 1x1 stride-1 conv, the images of a batch are just more rows: as many images per
+     * call as keep the rows within the uint16_t height the kernels take */
+    if (path == CONV_PATH_1X1_MULT8 || path == CONV_PATH_1X1) {
+        const int32_t chunk = UINT16_MAX / max(input_ht, out_ht);
+        const int32_t input_size = input_wd * input_ht * channels;
+        const int32_t output_size = out_wd * out_ht * out_channels;
+        ESP_NN_PATH_TIMER_START(t0);
+        for (int32_t batch = 0; batch < batches; batch += chunk) {
+            const int32_t images = min(chunk, batches - batch);
+            const int8_t *in = input + batch * input_size;
+            int8_t *out = out_data + batch * output_size;
+            if (path == CONV_PATH_1X1_MULT8) {
+                /* Full asm path — requires mult8 channels + 8-byte aligned filter */
+                esp_nn_conv_s8_mult8_1x1_esp32s3(in, input_wd, input_ht * images,
+                                    channels, input_offset, filter_data, bias, out,
+                                    out_wd, out_ht * images, out_channels, out_offset,
+                                    out_shift, out_mult, activation_min, activation_max,
+                                    conv_scratch_align_s3(scratch_buffer));
+            } else {
+                /* Fallback: handles any alignment + any channel count */
+                esp_nn_conv_s8_1x1(in, input_wd, input_ht * images, channels,
+                                   input_offset, filter_data, bias, out, out_channels, out_offset,
+                                   out_shift, out_mult, activation_min, activation_max,
+                                   scratch_buffer);
+            }
         }
+        ESP_NN_PATH_TIMER_STOP(path == CONV_PATH_1X1_MULT8 ? ESP_NN_PATH_CONV_1X1_ASM :
+                               ESP_NN_PATH_CONV_1X1, t0);
         return;
     }
 
@@ -462,9 +908,10 @@ void esp_nn_conv_s8_esp32s3(const data_dims_t *input_dims,
          * Avoids the 128× input reload of the general aligned asm. */
 #if 0
         if (esp_nn_conv_s8_3x3_can_use(filter_wd, filter_ht, channels) &&
-                pad_wd == 0 && pad_ht == 0) {
+                conv_params->padding.width == 0 && conv_params->padding.height == 0) {
             esp_nn_conv_s8_3x3_opt(input, input_wd, input_ht, channels,
-                                    input_offset, stride_wd, stride_ht,
+                                    input_offset, conv_params->stride.width,
+                                    conv_params->stride.height,
                                     filter_data, bias, out_data,
                                     out_wd, out_ht, out_channels, out_offset,
                                     out_shift, out_mult, activation_min, activation_max,
@@ -473,102 +920,371 @@ void esp_nn_conv_s8_esp32s3(const data_dims_t *input_dims,
         }
 #endif
 
-        /* Im2col path: small in_ch where per-row SIMD is wasteful,
-         * but entire window is large enough for SIMD dot product.
-         * E.g., 3x3 conv with in_ch=3: row=9 (<16), window=27 (>=16). */
-        if (filter_row_size < 16 && window_len >= 16) {
-            esp_nn_conv_s8_im2col_s3(input_dims, input, filter_dims, filter_data,
-                                      bias, output_dims, out_data, conv_params,
-                                      quant_data, scratch_buffer);
+        if (path == CONV_PATH_IM2COL) {
+            /* Scratch layout (16-byte aligned):
+             * [corrections: out_ch * 4]
+             * [aligned_filter: out_ch * window_len_aligned]  -- zero-padded copy
+             * [im2col_buf: window_len_aligned]
+             */
+            const int32_t window_len_aligned = (window_len + 15) & ~15;
+            int32_t *corrections = (int32_t *) conv_scratch_align_s3(scratch_buffer);
+            int8_t *aligned_filter = (int8_t *) corrections + conv_align16_s3(out_channels * 4);
+            int8_t *im2col_buf = aligned_filter + out_channels * window_len_aligned;
+
+            ESP_NN_PATH_TIMER_START(t_im2col);
+            esp_nn_conv_s8_im2col_pack_s3(filter_data, bias, window_len, out_channels,
+                                          input_offset, corrections, aligned_filter);
+            esp_nn_conv_s8_im2col_batch_s3(input_dims, input, filter_dims, aligned_filter,
+                                           corrections, output_dims, out_data, conv_params,
+                                           quant_data, im2col_buf);
+            ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_CONV_IM2COL, t_im2col);
             return;
         }
 
         // align the `filter width * channels` to 16 bytes. Do zero padding for the same
-        int32_t filter_alignment_padding = 16 - (filter_row_size & 15);
+        ESP_NN_PATH_TIMER_START(t_general);
         int8_t *filter_data_aligned = (int8_t *) filter_data;
-        int8_t *input_padded = (int8_t *) input;
-        int8_t *scratch_data = (int8_t *) scratch_buffer;
-        int new_input_wd = input_wd, new_input_ht = input_ht;
-        if (filter_alignment_padding != 16) {
-            // pad filter_data
-            int32_t new_row_size = filter_wd * channels + filter_alignment_padding;
+        int8_t *scratch_data = conv_scratch_align_s3(scratch_buffer);
+        if (filter_row_size & 15) {
             filter_data_aligned = scratch_data;
-            int8_t *row_ptr = filter_data_aligned;
-            const int8_t *filter_data_ptr = filter_data;
-            for (int32_t ch_idx = 0; ch_idx < out_channels; ch_idx++) {
-                for (int32_t row_idx = 0; row_idx < filter_ht; row_idx++) {
-                    memcpy(row_ptr, filter_data_ptr, filter_row_size);
-                    memset(row_ptr + filter_row_size, 0, new_row_size - filter_row_size);
-                    filter_data_ptr += filter_row_size;
-                    row_ptr += new_row_size;
-                }
-            }
-            scratch_data += new_row_size * filter_ht * out_channels;
-            filter_row_size = new_row_size;
-        } else if ((int) filter_data & 15) {
+            esp_nn_conv_s8_align_rows_s3(filter_data, filter_data_aligned, filter_row_size,
+                                         filter_ht, out_channels);
+            scratch_data += ((filter_row_size + 15) & ~15) * filter_ht * out_channels;
+        } else if ((uintptr_t) filter_data & 15) {
             filter_data_aligned = scratch_data;
             memcpy(filter_data_aligned, filter_data, filter_size);
             scratch_data += filter_size;
         }
-        // Calculate if right/bottom padding is needed even when pad_wd=0, pad_ht=0
-        // This happens when the filter extends beyond input boundaries at the edges
-        // Formula matches depthwise convolution: (out_wd * stride_wd + filter_wd - 1) - input_wd
-        int32_t pad_right = max(0, (out_wd * stride_wd + filter_wd - 1) - input_wd);
-        int32_t pad_bottom = max(0, (out_ht * stride_ht + filter_ht - 1) - input_ht);
-
-        // Apply padding if explicitly requested (pad_wd/pad_ht) OR if needed for boundary handling
-        if (pad_wd != 0 || pad_ht != 0) {
-            // Full padding (top, bottom, left, right) when pad_wd/pad_ht are set
-            input_padded = (int8_t *) scratch_data;
-            esp_nn_aligned_s8_pad_with_value(input, input_padded, input_wd, input_ht, channels,
-                                            -input_offset, pad_wd, pad_ht);
-            new_input_wd = input_wd + 2 * pad_wd;
-            new_input_ht = input_ht + 2 * pad_ht;
-            scratch_data += new_input_wd * new_input_ht * channels;
-        } else if (pad_right > 0 || pad_bottom > 0) {
-            // Only right/bottom padding needed for boundary handling (like depthwise conv)
-            input_padded = (int8_t *) scratch_data;
-            esp_nn_aligned_s8_pad_end_with_value(input, input_padded, input_wd, input_ht, channels,
-                                                -input_offset, (uint16_t)pad_right, (uint16_t)pad_bottom);
-            new_input_wd = input_wd + pad_right;
-            new_input_ht = input_ht + pad_bottom;
-            scratch_data += new_input_wd * new_input_ht * channels;
-        }
+        esp_nn_conv_s8_general_s3(input_dims, input, filter_dims, filter_data,
+                                  filter_data_aligned, bias, NULL, output_dims, out_data,
+                                  conv_params, quant_data, scratch_data,
+                                  path == CONV_PATH_GENERAL_FOLDED, mover);
+        ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_CONV_GENERAL, t_general);
+    }
+}
+
+/**
+ * Grouped conv, group by group: the channels of a group are gathered into
+ * scratch, run as a plain conv on the path its shape selects, and the output
+ * channels are put back in place. Filters, bias and quantisation of a group
+ * are contiguous already.
+ */
+static void conv_run_grouped_s3(const data_dims_t *input_dims,
+                                const int8_t *input,
+                                const data_dims_t *filter_dims,
+                                const int8_t *filter_data,
+                                const int32_t *bias,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const conv_params_t *conv_params,
+                                const quant_plan_data_t *quant_data,
+                                void *scratch,
+                                const esp_nn_tile_mover_t *mover)
+{
+    if (scratch == NULL) {
+        printf("esp_nn_conv error! scratch_buffer not set!\n");
+        return;
+    }
+    data_dims_t group_in_dims, group_out_dims;
+    conv_group_dims_s3(input_dims, filter_dims, output_dims, &group_in_dims, &group_out_dims);
+    const conv_path_s3_t group_path = conv_select_path_s3(&group_in_dims, filter_dims,
+                                                          &group_out_dims, conv_params);
 
+    const int32_t in_channels = input_dims->channels;
+    const int32_t filter_ch = filter_dims->channels;
+    const int32_t out_channels = output_dims->channels;
+    const int32_t group_out_ch = group_out_dims.channels;
+    const int32_t groups = in_channels / filter_ch;
+    const int32_t in_pixels = input_dims->width * input_dims->height;
+    const int32_t out_pixels = output_dims->width * output_dims->height;
+    const int32_t group_filter_size = filter_dims->width * filter_dims->height * filter_ch * group_out_ch;
 
-        int filter_total = filter_wd * filter_ht * channels * out_channels;
-        if (input_offset != 0 && filter_total > 16384) {
-            int32_t *corrections = (int32_t *)scratch_data;
-            int32_t filter_ch_size = filter_wd * filter_ht * channels;
-            const int8_t *f_src = filter_data; // use ORIGINAL (not aligned) filter for sum
-            for (int ch = 0; ch < out_channels; ch++) {
-                int32_t filter_sum = 0;
-                for (int i = 0; i < filter_ch_size; i++) {
-                    filter_sum += f_src[i];
-                }
-                corrections[ch] = filter_sum * input_offset;
-                if (bias) {
-                    corrections[ch] += bias[ch];
-                }
-                f_src += filter_ch_size;
+    int8_t *group_in = conv_scratch_align_s3(scratch);
+    int8_t *group_out = group_in + conv_align16_s3(in_pixels * filter_ch);
+    void *group_scratch = group_out + conv_align16_s3(out_pixels * group_out_ch);
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    for (int32_t batch = 0; batch < batches; batch++) {
+        const int8_t *image = input + batch * in_pixels * in_channels;
+        int8_t *image_out = out_data + batch * out_pixels * out_channels;
+
+        for (int32_t g = 0; g < groups; g++) {
+            const int32_t out_ch_start = g * group_out_ch;
+            const quant_plan_data_t group_quant = {
+                .shift = quant_data->shift + out_ch_start,
+                .mult = quant_data->mult + out_ch_start,
+                .plan = quant_data->plan ? quant_data->plan + out_ch_start : NULL,
+            };
+            for (int32_t i = 0; i < in_pixels; i++) {
+                memcpy(group_in + i * filter_ch, image + i * in_channels + g * filter_ch, filter_ch);
+            }
+            conv_run_path_s3(group_path, &group_in_dims, group_in, filter_dims,
+                             filter_data + g * group_filter_size, bias ? bias + out_ch_start : NULL,
+                             &group_out_dims, group_out, conv_params, &group_quant, group_scratch,
+                             mover);
+            for (int32_t i = 0; i < out_pixels; i++) {
+                memcpy(image_out + i * out_channels + out_ch_start, group_out + i * group_out_ch,
+                       group_out_ch);
             }
-            // Pass input_offset=0 to assembly so it skips its pre-computation.
-            // Pass scratch_data as "bias" pointer — the assembly's bias-copy loop
-            // will read from scratch and write to scratch (identity, no-op).
-            esp_nn_conv_s8_filter_aligned_input_padded_esp32s3(
-                input_padded, new_input_wd, new_input_ht, channels, 0,
-                stride_wd, stride_ht, filter_data_aligned, filter_wd, filter_ht,
-                (const int32_t *)scratch_data, out_data, out_wd, out_ht, out_channels,
-                out_offset, out_shift, out_mult, activation_min, activation_max,
-                scratch_data);
-            CONV_HEAP_CHECK("general: after asm (precomp)");
-        } else {
-            esp_nn_conv_s8_filter_aligned_input_padded_esp32s3(
-                input_padded, new_input_wd, new_input_ht, channels, input_offset,
-                stride_wd, stride_ht, filter_data_aligned, filter_wd, filter_ht,
-                bias, out_data, out_wd, out_ht, out_channels, out_offset,
-                out_shift, out_mult, activation_min, activation_max, scratch_data);
-            CONV_HEAP_CHECK("general: after asm (normal)");
         }
     }
 }
+
+/*
+ * Paths able to run the layer, for autotuning. Grouped conv runs its groups on
+ * their own paths, dilated conv only on im2col
+ */
+static int conv_tune_candidates_s3(const data_dims_t *input_dims,
+                                   const data_dims_t *filter_dims,
+                                   const data_dims_t *output_dims,
+                                   const conv_params_t *conv_params,
+                                   int32_t *paths,
+                                   int32_t *scratch_sizes)
+{
+    const int32_t channels = input_dims->channels;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    int count = 0;
+
+    if (channels != filter_dims->channels ||
+            esp_nn_is_dilated(filter_dims, &conv_params->dilation)) {
+        return 0;
+    }
+    if (filter_wd == 1 && filter_ht == 1 &&
+            conv_params->padding.width == 0 && conv_params->padding.height == 0 &&
+            conv_params->stride.width == 1 && conv_params->stride.height == 1) {
+        if (channels % 8 == 0) {
+            paths[count++] = CONV_PATH_1X1_MULT8;
+        }
+        paths[count++] = CONV_PATH_1X1;
+    }
+    if (filter_wd * filter_ht * channels >= 16) {
+        paths[count++] = CONV_PATH_IM2COL;
+    }
+    paths[count++] = CONV_PATH_GENERAL;
+    if (conv_params->in_offset != 0) {
+        paths[count++] = CONV_PATH_GENERAL_FOLDED;
+    }
+    for (int i = 0; i < count; i++) {
+        scratch_sizes[i] = conv_scratch_size_s3((conv_path_s3_t) paths[i], input_dims,
+                                                filter_dims, output_dims, conv_params);
+    }
+    return count;
+}
+
+static void conv_tune_run_s3(const int32_t path,
+                             const data_dims_t *input_dims,
+                             const int8_t *input,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_plan_data_t *quant_data,
+                             void *scratch)
+{
+    conv_run_path_s3(path, input_dims, input, filter_dims, filter_data, bias, output_dims,
+                     out_data, conv_params, quant_data, scratch, NULL);
+}
+
+static const esp_nn_conv_tuner_t conv_tuner_s3 = {
+    .kernel = ESP_NN_AUTOTUNE_CONV_S8_ESP32S3,
+    .candidates = conv_tune_candidates_s3,
+    .run = conv_tune_run_s3,
+};
+
+static conv_path_s3_t conv_select_path_s3(const data_dims_t *input_dims,
+                                          const data_dims_t *filter_dims,
+                                          const data_dims_t *output_dims,
+                                          const conv_params_t *conv_params)
+{
+    return (conv_path_s3_t) esp_nn_autotune_conv_path(&conv_tuner_s3, input_dims, filter_dims,
+                                                      output_dims, conv_params,
+                                                      conv_default_path_s3(input_dims, filter_dims,
+                                                                           output_dims, conv_params));
+}
+
+void esp_nn_conv_s8_plan_esp32s3(const esp_nn_ctx_t *ctx,
+                                 const data_dims_t *input_dims,
+                                 const int8_t *input,
+                                 const data_dims_t *filter_dims,
+                                 const int8_t *filter_data,
+                                 const int32_t *bias,
+                                 const data_dims_t *output_dims,
+                                 int8_t *out_data,
+                                 const conv_params_t *conv_params,
+                                 const quant_plan_data_t *quant_data)
+{
+    const conv_path_s3_t path = conv_select_path_s3(input_dims, filter_dims, output_dims,
+                                                    conv_params);
+    ESP_NN_SCRATCH_GUARDED("conv_s8", ctx->scratch,
+                           conv_scratch_size_s3(path, input_dims, filter_dims, output_dims,
+                                                conv_params),
+                           conv_run_path_s3(path, input_dims, input, filter_dims, filter_data,
+                                            bias, output_dims, out_data, conv_params,
+                                            quant_data, ctx->scratch, ctx->mover));
+}
+
+void esp_nn_conv_s8_ctx_esp32s3(const esp_nn_ctx_t *ctx,
+                                const data_dims_t *input_dims,
+                                const int8_t *input,
+                                const data_dims_t *filter_dims,
+                                const int8_t *filter_data,
+                                const int32_t *bias,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const conv_params_t *conv_params,
+                                const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_plan_esp32s3(ctx, input_dims, input, filter_dims, filter_data, bias,
+                                output_dims, out_data, conv_params, &no_plan);
+}
+
+/* Bytes of the blob after the header: corrections, then the packed filter if any */
+static int32_t conv_prepared_corrections_size_s3(const int32_t out_channels)
+{
+    return (out_channels * (int32_t) sizeof(int32_t) + 15) & ~15;
+}
+
+int32_t esp_nn_get_conv_prepared_size_esp32s3(const data_dims_t *input_dims,
+                                              const data_dims_t *filter_dims,
+                                              const data_dims_t *output_dims,
+                                              const conv_params_t *conv_params)
+{
+    const int32_t channels = input_dims->channels;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    const int32_t out_channels = output_dims->channels;
+    int32_t size = ESP_NN_CONV_PREPARED_HDR_SIZE(out_channels);
+
+    switch (conv_select_path_s3(input_dims, filter_dims, output_dims, conv_params)) {
+    case CONV_PATH_IM2COL: {
+        const int32_t window_len_aligned = (filter_wd * filter_ht * channels + 15) & ~15;
+        size += conv_prepared_corrections_size_s3(out_channels) + out_channels * window_len_aligned;
+        break;
+    }
+    case CONV_PATH_GENERAL:
+    case CONV_PATH_GENERAL_FOLDED: {
+        /* worst case: the filter is copied even with aligned rows if its address is not */
+        const int32_t aligned_row_size = (filter_wd * channels + 15) & ~15;
+        size += conv_prepared_corrections_size_s3(out_channels) +
+                aligned_row_size * filter_ht * out_channels;
+        break;
+    }
+    default:
+        /* 1x1 kernels take the filter as is: nothing to pack */
+        break;
+    }
+    return size;
+}
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_esp32s3(void *blob,
+                                                      const data_dims_t *input_dims,
+                                                      const data_dims_t *filter_dims,
+                                                      const int8_t *filter_data,
+                                                      const int32_t *bias,
+                                                      const data_dims_t *output_dims,
+                                                      const conv_params_t *conv_params,
+                                                      const quant_data_t *quant_data)
+{
+    esp_nn_conv_prepared_t *prep = esp_nn_conv_prepared_init(blob, input_dims, filter_dims,
+                                                             filter_data, bias, output_dims,
+                                                             conv_params, quant_data);
+    if (prep == NULL) {
+        return NULL;
+    }
+    const int32_t channels = input_dims->channels;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    const int32_t out_channels = output_dims->channels;
+    const int32_t window_len = filter_wd * filter_ht * channels;
+    const int32_t filter_row_size = filter_wd * channels;
+
+    int32_t *corrections = (int32_t *) ((int8_t *) blob + ESP_NN_CONV_PREPARED_HDR_SIZE(out_channels));
+    int8_t *packed_filter = (int8_t *) corrections + conv_prepared_corrections_size_s3(out_channels);
+
+    prep->path = conv_select_path_s3(input_dims, filter_dims, output_dims, conv_params);
+    if (prep->path == CONV_PATH_IM2COL) {
+        esp_nn_conv_s8_im2col_pack_s3(filter_data, bias, window_len, out_channels,
+                                      conv_params->in_offset, corrections, packed_filter);
+        prep->filter = packed_filter;
+        prep->bias = corrections;
+    } else if (prep->path == CONV_PATH_GENERAL || prep->path == CONV_PATH_GENERAL_FOLDED) {
+        /* the offset is folded at prepare time for both */
+        esp_nn_conv_fold_offset(filter_data, window_len, out_channels,
+                                conv_params->in_offset, bias, corrections);
+        if (filter_row_size & 15) {
+            esp_nn_conv_s8_align_rows_s3(filter_data, packed_filter, filter_row_size,
+                                         filter_ht, out_channels);
+            prep->filter = packed_filter;
+        } else if ((uintptr_t) filter_data & 15) {
+            memcpy(packed_filter, filter_data, window_len * out_channels);
+            prep->filter = packed_filter;
+        }
+        prep->bias = corrections;
+    }
+    return prep;
+}
+
+static void conv_run_prepared_s3(const esp_nn_conv_prepared_t *prep,
+                                 const int8_t *input_data,
+                                 int8_t *out_data,
+                                 int8_t *scratch_data,
+                                 const esp_nn_tile_mover_t *mover)
+{
+    if (prep->path != CONV_PATH_IM2COL && prep->path != CONV_PATH_GENERAL &&
+            prep->path != CONV_PATH_GENERAL_FOLDED) {
+        /* nothing was packed, same as the unprepared call */
+        conv_run_path_s3(prep->path, &prep->input_dims, input_data, &prep->filter_dims,
+                         prep->filter, prep->bias, &prep->output_dims, out_data,
+                         &prep->conv_params, &prep->quant_data, scratch_data, mover);
+        return;
+    }
+    if (scratch_data == NULL) {
+        printf("esp_nn_conv error! scratch_buffer not set!\n");
+        return;
+    }
+    if (prep->path == CONV_PATH_IM2COL) {
+        int8_t *im2col_buf = conv_scratch_align_s3(scratch_data);
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_IM2COL,
+                         esp_nn_conv_s8_im2col_batch_s3(&prep->input_dims, input_data,
+                                    &prep->filter_dims, prep->filter, prep->bias,
+                                    &prep->output_dims, out_data, &prep->conv_params,
+                                    &prep->quant_data, im2col_buf));
+    } else {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_GENERAL,
+                         esp_nn_conv_s8_general_s3(&prep->input_dims, input_data, &prep->filter_dims,
+                                    prep->filter, prep->filter, NULL, prep->bias,
+                                    &prep->output_dims, out_data, &prep->conv_params,
+                                    &prep->quant_data, conv_scratch_align_s3(scratch_data),
+                                    false, mover));
+    }
+}
+
+void esp_nn_conv_s8_run_esp32s3(const esp_nn_ctx_t *ctx,
+                                const esp_nn_conv_prepared_t *prep,
+                                const int8_t *input_data,
+                                int8_t *out_data)
+{
+    ESP_NN_SCRATCH_GUARDED("conv_s8", ctx->scratch,
+                           conv_scratch_size_s3(prep->path, &prep->input_dims, &prep->filter_dims,
+                                                &prep->output_dims, &prep->conv_params),
+                           conv_run_prepared_s3(prep, input_data, out_data, ctx->scratch,
+                                                ctx->mover));
+}
+
+void esp_nn_conv_s8_esp32s3(const data_dims_t *input_dims,
+                            const int8_t *input,
+                            const data_dims_t *filter_dims,
+                            const int8_t *filter_data,
+                            const int32_t *bias,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            const conv_params_t *conv_params,
+                            const quant_data_t *quant_data)
+{
+    esp_nn_conv_s8_ctx_esp32s3(&legacy_ctx, input_dims, input, filter_dims, filter_data,
+                               bias, output_dims, out_data, conv_params, quant_data);
+}
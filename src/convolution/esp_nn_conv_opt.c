@@ -38,7 +38,7 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
                                const data_dims_t *output_dims,
                                int8_t *out_data,
                                const conv_params_t *conv_params,
-                               const quant_data_t *quant_data)
+                               const quant_plan_data_t *quant_data)
 {
     const uint16_t input_wd = input_dims->width;
     const uint16_t in_channels = input_dims->channels;
@@ -54,8 +54,6 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
 
     for (int32_t in_row = 0; in_row < out_ht * stride_ht; in_row += stride_ht) {
         for (int32_t in_col = 0; in_col < out_wd * stride_wd; in_col += stride_wd) {
-            const int32_t *out_mult = quant_data->mult;
-            const int32_t *out_shift = quant_data->shift;
             const int8_t *filter_ptr = filter_data;
             const int8_t *input_base_ptr = input_data + (in_row * input_wd + in_col) * in_channels;
             int32_t out_ch_idx = 0;
@@ -77,7 +75,7 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
                 if (bias) {
                     conv_out += bias[out_ch_idx];
                 }
-                conv_out = esp_nn_requantize(conv_out, *out_mult++, *out_shift++);
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, out_ch_idx);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -87,27 +85,37 @@ static void esp_nn_conv_s8_1x1(const data_dims_t *input_dims,
     }
 }
 
+/* Kernel paths of the dispatcher */
+typedef enum {
+    CONV_PATH_1X1 = 0,
+    CONV_PATH_GENERAL,
+    CONV_PATH_ANSI,         /* grouped conv */
+} conv_path_opt_t;
+
 /**
  * Assumption 1: i/p channels == o/p channels
  * Assumption 2: Pointers are valid
  * Assumption 3: dialation width = 1
  */
-void esp_nn_conv_s8_opt(const data_dims_t *input_dims,
-                        const int8_t *input_data,
-                        const data_dims_t *filter_dims,
-                        const int8_t *filter_data,
-                        const int32_t *bias,
-                        const data_dims_t *output_dims,
-                        int8_t *out_data,
-                        const conv_params_t *conv_params,
-                        const quant_data_t *quant_data)
+static void conv_run_path_opt(const int32_t path,
+                              const data_dims_t *input_dims,
+                              const int8_t *input_data,
+                              const data_dims_t *filter_dims,
+                              const int8_t *filter_data,
+                              const int32_t *bias,
+                              const data_dims_t *output_dims,
+                              int8_t *out_data,
+                              const conv_params_t *conv_params,
+                              const quant_plan_data_t *quant_data,
+                              void *scratch)
 {
     const uint16_t filter_wd = filter_dims->width;
     const uint16_t filter_ht = filter_dims->height;
 
-    if (filter_wd == 1 && filter_ht == 1) {
-        esp_nn_conv_s8_1x1(input_dims, input_data, filter_data, bias,
-                           output_dims, out_data, conv_params, quant_data);
+    if (path == CONV_PATH_1X1) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_1X1,
+                         esp_nn_conv_s8_1x1(input_dims, input_data, filter_data, bias,
+                                            output_dims, out_data, conv_params, quant_data));
         return;
     }
 
@@ -125,36 +133,39 @@ void esp_nn_conv_s8_opt(const data_dims_t *input_dims,
     const uint16_t out_channels = output_dims->channels;
     const int32_t activation_min = conv_params->activation.min;
     const int32_t activation_max = conv_params->activation.max;
+    const int32_t dilation_wd = esp_nn_dilation(conv_params->dilation.width);
+    const int32_t dilation_ht = esp_nn_dilation(conv_params->dilation.height);
 
     /* Grouped conv (filter_ch < input_ch): fall back to ansi which handles it */
-    if (in_channels != filter_dims->channels) {
-        esp_nn_conv_s8_ansi(input_dims, input_data, filter_dims, filter_data,
-                            bias, output_dims, out_data, conv_params, quant_data);
+    if (path == CONV_PATH_ANSI) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_CONV_ANSI,
+                         esp_nn_conv_s8_plan_ansi(NULL, input_dims, input_data, filter_dims,
+                                                  filter_data, bias, output_dims, out_data,
+                                                  conv_params, quant_data));
         return;
     }
 
     int32_t out_ch_idx, out_y, out_x, filter_y_idx, filter_x_idx;
+    ESP_NN_PATH_TIMER_START(t_general);
 
     for (out_y = 0; out_y < out_ht; out_y++) {
         for (out_x = 0; out_x < out_wd; out_x++) {
-            const int32_t *out_shift = quant_data->shift;
-            const int32_t *out_mult = quant_data->mult;
             for (out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
                 int32_t conv_out = 0;
 
                 const int32_t base_y = stride_ht * out_y - pad_ht;
                 const int32_t base_x = stride_wd * out_x - pad_wd;
 
-                const int32_t filter_y_start = max(0, -base_y);
-                const int32_t filter_x_start = max(0, -base_x);
-
-                const int32_t filter_y_end = min(filter_ht, input_ht - base_y);
-                const int32_t filter_x_end = min(filter_wd, input_wd - base_x);
+                int32_t filter_y_start, filter_y_end, filter_x_start, filter_x_end;
+                esp_nn_filter_taps(base_y, filter_ht, dilation_ht, input_ht,
+                                   &filter_y_start, &filter_y_end);
+                esp_nn_filter_taps(base_x, filter_wd, dilation_wd, input_wd,
+                                   &filter_x_start, &filter_x_end);
 
                 for (filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
                     for (filter_x_idx = filter_x_start; filter_x_idx < filter_x_end; filter_x_idx++) {
-                        const int32_t in_row = base_y + filter_y_idx;
-                        const int32_t in_col = base_x + filter_x_idx;
+                        const int32_t in_row = base_y + filter_y_idx * dilation_ht;
+                        const int32_t in_col = base_x + filter_x_idx * dilation_wd;
 
                         const int8_t *input_ptr = input_data +
                                         (in_row * input_wd + in_col) * in_channels;
@@ -176,7 +187,7 @@ void esp_nn_conv_s8_opt(const data_dims_t *input_dims,
                 if (bias) {
                     conv_out += bias[out_ch_idx];
                 }
-                conv_out = esp_nn_requantize(conv_out, *out_mult++, *out_shift++);
+                conv_out = esp_nn_requantize_ch(conv_out, quant_data, out_ch_idx);
                 conv_out += out_offset;
                 conv_out = max(conv_out, activation_min);
                 conv_out = min(conv_out, activation_max);
@@ -184,4 +195,302 @@ void esp_nn_conv_s8_opt(const data_dims_t *input_dims,
             }
         }
     }
+    ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_CONV_GENERAL, t_general);
+}
+
+static conv_path_opt_t conv_default_path_opt(const data_dims_t *input_dims,
+                                             const data_dims_t *filter_dims)
+{
+    /* grouped first: the 1x1 kernel reads in_channels weights per filter */
+    if (filter_dims->channels && input_dims->channels != filter_dims->channels) {
+        return CONV_PATH_ANSI;
+    }
+    if (filter_dims->width == 1 && filter_dims->height == 1) {
+        return CONV_PATH_1X1;
+    }
+    return CONV_PATH_GENERAL;
+}
+
+/* Paths able to run the layer, for autotuning: the 1x1 kernel ignores padding */
+static int conv_tune_candidates_opt(const data_dims_t *input_dims,
+                                    const data_dims_t *filter_dims,
+                                    const data_dims_t *output_dims,
+                                    const conv_params_t *conv_params,
+                                    int32_t *paths,
+                                    int32_t *scratch_sizes)
+{
+    if (filter_dims->width != 1 || filter_dims->height != 1 ||
+            conv_params->padding.width != 0 || conv_params->padding.height != 0 ||
+            input_dims->channels != filter_dims->channels) {
+        return 0;
+    }
+    paths[0] = CONV_PATH_1X1;
+    paths[1] = CONV_PATH_GENERAL;
+    scratch_sizes[0] = scratch_sizes[1] = 0;
+    return 2;
+}
+
+static const esp_nn_conv_tuner_t conv_tuner_opt = {
+    .kernel = ESP_NN_AUTOTUNE_CONV_S8_OPT,
+    .candidates = conv_tune_candidates_opt,
+    .run = conv_run_path_opt,
+};
+
+static int32_t conv_select_path_opt(const data_dims_t *input_dims,
+                                    const data_dims_t *filter_dims,
+                                    const data_dims_t *output_dims,
+                                    const conv_params_t *conv_params)
+{
+    return esp_nn_autotune_conv_path(&conv_tuner_opt, input_dims, filter_dims, output_dims,
+                                     conv_params, conv_default_path_opt(input_dims, filter_dims));
+}
+
+/* nothing is prepared per call here: the images of a batch just run in turn */
+static void conv_run_images_opt(const int32_t path,
+                                const data_dims_t *input_dims,
+                                const int8_t *input_data,
+                                const data_dims_t *filter_dims,
+                                const int8_t *filter_data,
+                                const int32_t *bias,
+                                const data_dims_t *output_dims,
+                                int8_t *out_data,
+                                const conv_params_t *conv_params,
+                                const quant_plan_data_t *quant_data)
+{
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_dims->width * input_dims->height * input_dims->channels;
+    const int32_t output_size = output_dims->width * output_dims->height * output_dims->channels;
+    data_dims_t image_dims = *input_dims;
+    image_dims.extra = 1;
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        conv_run_path_opt(path, &image_dims, input_data + batch * input_size, filter_dims,
+                          filter_data, bias, output_dims, out_data + batch * output_size,
+                          conv_params, quant_data, NULL);
+    }
+}
+
+/* No scratch needed, the context is ignored */
+void esp_nn_conv_s8_plan_opt(const esp_nn_ctx_t *ctx,
+                             const data_dims_t *input_dims,
+                             const int8_t *input_data,
+                             const data_dims_t *filter_dims,
+                             const int8_t *filter_data,
+                             const int32_t *bias,
+                             const data_dims_t *output_dims,
+                             int8_t *out_data,
+                             const conv_params_t *conv_params,
+                             const quant_plan_data_t *quant_data)
+{
+    (void) ctx;
+    conv_run_images_opt(conv_select_path_opt(input_dims, filter_dims, output_dims, conv_params),
+                        input_dims, input_data, filter_dims, filter_data, bias, output_dims,
+                        out_data, conv_params, quant_data);
+}
+
+void esp_nn_conv_s8_opt(const data_dims_t *input_dims,
+                        const int8_t *input_data,
+                        const data_dims_t *filter_dims,
+                        const int8_t *filter_data,
+                        const int32_t *bias,
+                        const data_dims_t *output_dims,
+                        int8_t *out_data,
+                        const conv_params_t *conv_params,
+                        const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_plan_opt(NULL, input_dims, input_data, filter_dims, filter_data, bias,
+                            output_dims, out_data, conv_params, &no_plan);
+}
+
+void esp_nn_conv_s8_ctx_opt(const esp_nn_ctx_t *ctx,
+                            const data_dims_t *input_dims,
+                            const int8_t *input_data,
+                            const data_dims_t *filter_dims,
+                            const int8_t *filter_data,
+                            const int32_t *bias,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            const conv_params_t *conv_params,
+                            const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_conv_s8_plan_opt(ctx, input_dims, input_data, filter_dims, filter_data, bias,
+                            output_dims, out_data, conv_params, &no_plan);
+}
+
+/* Only the requantisation and the path are prepared: the blob holds the header and the plan */
+int32_t esp_nn_get_conv_prepared_size_opt(const data_dims_t *input_dims,
+                                          const data_dims_t *filter_dims,
+                                          const data_dims_t *output_dims,
+                                          const conv_params_t *conv_params)
+{
+    return ESP_NN_CONV_PREPARED_HDR_SIZE(output_dims->channels);
+}
+
+esp_nn_conv_prepared_t *esp_nn_conv_s8_prepare_opt(void *blob,
+                                                   const data_dims_t *input_dims,
+                                                   const data_dims_t *filter_dims,
+                                                   const int8_t *filter_data,
+                                                   const int32_t *bias,
+                                                   const data_dims_t *output_dims,
+                                                   const conv_params_t *conv_params,
+                                                   const quant_data_t *quant_data)
+{
+    esp_nn_conv_prepared_t *prep = esp_nn_conv_prepared_init(blob, input_dims, filter_dims,
+                                                             filter_data, bias, output_dims,
+                                                             conv_params, quant_data);
+    if (prep) {
+        prep->path = conv_select_path_opt(input_dims, filter_dims, output_dims, conv_params);
+    }
+    return prep;
+}
+
+void esp_nn_conv_s8_run_opt(const esp_nn_ctx_t *ctx,
+                            const esp_nn_conv_prepared_t *prep,
+                            const int8_t *input_data,
+                            int8_t *out_data)
+{
+    (void) ctx;
+    conv_run_images_opt(prep->path, &prep->input_dims, input_data, &prep->filter_dims,
+                        prep->filter, prep->bias, &prep->output_dims, out_data,
+                        &prep->conv_params, &prep->quant_data);
+}
+
+/*
+ * 16x8 conv: the taps of a filter row are adjacent in the input as in the
+ * filter, so each row is one dot product of (x taps * channels) values.
+ */
+void esp_nn_conv_s16_opt(const data_dims_t *input_dims,
+                         const int16_t *input_data,
+                         const data_dims_t *filter_dims,
+                         const int8_t *filter_data,
+                         const int64_t *bias,
+                         const data_dims_t *output_dims,
+                         int16_t *out_data,
+                         const conv_params_t *conv_params,
+                         const quant_data_t *quant_data)
+{
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t input_ht = input_dims->height;
+    const uint16_t in_channels = input_dims->channels;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t pad_wd = conv_params->padding.width;
+    const uint16_t pad_ht = conv_params->padding.height;
+    const uint16_t stride_wd = conv_params->stride.width;
+    const uint16_t stride_ht = conv_params->stride.height;
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const uint16_t out_channels = output_dims->channels;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    if (filter_dims->channels && filter_dims->channels != in_channels) {
+        /* grouped: the reference handles the channel split */
+        esp_nn_conv_s16_ansi(input_dims, input_data, filter_dims, filter_data, bias,
+                             output_dims, out_data, conv_params, quant_data);
+        return;
+    }
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_channels;
+    const int32_t filter_size = filter_wd * filter_ht * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            const int32_t base_y = stride_ht * out_y - pad_ht;
+            const int32_t filter_y_start = max(0, -base_y);
+            const int32_t filter_y_end = min(filter_ht, input_ht - base_y);
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                const int32_t base_x = stride_wd * out_x - pad_wd;
+                const int32_t filter_x_start = max(0, -base_x);
+                const int32_t filter_x_end = min(filter_wd, input_wd - base_x);
+                const int32_t row_len = (filter_x_end - filter_x_start) * in_channels;
+
+                for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
+                    const int8_t *filter = filter_data + out_ch_idx * filter_size;
+                    int64_t conv_out = bias ? bias[out_ch_idx] : 0;
+
+                    for (int32_t filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
+                        const int32_t in_row = base_y + filter_y_idx;
+                        const int16_t *in_ptr = input_data +
+                                                (in_row * input_wd + base_x + filter_x_start) * in_channels;
+                        const int8_t *filter_ptr = filter +
+                                                   (filter_y_idx * filter_wd + filter_x_start) * in_channels;
+                        conv_out += esp_nn_dot_s16_s8(in_ptr, filter_ptr, row_len);
+                    }
+                    int32_t result = esp_nn_multiply_by_quantized_mult_s64(conv_out, quant_data->mult[out_ch_idx],
+                                                                            quant_data->shift[out_ch_idx]);
+                    result += out_offset;
+                    result = max(result, activation_min);
+                    result = min(result, activation_max);
+                    *out_data++ = (int16_t) result;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * int4 weights: the 1x1 path, where the filter of an output channel is one
+ * packed row matching the channels of an input pixel. Other filters run the
+ * reference.
+ */
+void esp_nn_conv_s4_opt(const data_dims_t *input_dims,
+                        const int8_t *input_data,
+                        const data_dims_t *filter_dims,
+                        const int8_t *filter_data,
+                        const int32_t *bias,
+                        const data_dims_t *output_dims,
+                        int8_t *out_data,
+                        const conv_params_t *conv_params,
+                        const quant_data_t *quant_data)
+{
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t in_channels = input_dims->channels;
+    const int32_t input_offset = conv_params->in_offset;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t stride_wd = conv_params->stride.width;
+    const uint16_t stride_ht = conv_params->stride.height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const uint16_t out_channels = output_dims->channels;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    if (filter_dims->width != 1 || filter_dims->height != 1 ||
+            conv_params->padding.width != 0 || conv_params->padding.height != 0 ||
+            (filter_dims->channels && filter_dims->channels != in_channels)) {
+        esp_nn_conv_s4_ansi(input_dims, input_data, filter_dims, filter_data, bias,
+                            output_dims, out_data, conv_params, quant_data);
+        return;
+    }
+
+    const int32_t row_size = esp_nn_get_s4_row_size(in_channels);
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_dims->height * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                const int8_t *in_ptr = input_data +
+                                       (out_y * stride_ht * input_wd + out_x * stride_wd) * in_channels;
+                const int8_t *row = filter_data;
+                for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++, row += row_size) {
+                    int32_t conv_out = esp_nn_dot_s8_s4(in_ptr, input_offset, row, in_channels);
+                    if (bias) {
+                        conv_out += bias[out_ch_idx];
+                    }
+                    conv_out = esp_nn_requantize(conv_out, quant_data->mult[out_ch_idx],
+                                                 quant_data->shift[out_ch_idx]);
+                    conv_out += out_offset;
+                    conv_out = max(conv_out, activation_min);
+                    conv_out = min(conv_out, activation_max);
+                    *out_data++ = (int8_t) conv_out;
+                }
+            }
+        }
+    }
 }
@@ -14,11 +14,15 @@
 #include <esp_nn_defs.h>
 #include <common_functions.h>
 
-int esp_nn_conv_s8_1x1_scratch_size(int out_channels)
+int esp_nn_conv_s8_1x1_scratch_size(int size, int in_channels)
 {
-    /* Transpose buffer: 8 channels × 8 positions × 2 bytes = 128 bytes per chunk.
-     * Multiple chunks processed sequentially, so 128 is enough. */
-    return 128 + 64; /* transpose + alignment */
+    /* Transpose buffer: 8 channels × 8 positions × 2 bytes = 128 bytes per channel
+     * group, all groups of 8 positions at once, aligned to 16 in place.
+     * Leftover positions (size < 8) don't use it. */
+    if (size < 8) {
+        return 0;
+    }
+    return (in_channels / 8) * 128 + 15;
 }
 
 /*
@@ -0,0 +1,187 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Output row y reads input rows [y * stride - pad, + extent), clipped to the
+ * image: it is ready once min(input_ht, that end) rows are in. Unclipped
+ * ends differ for every row, so a push makes at most one row ready, except
+ * the last of a frame which completes every row reading the bottom padding.
+ * Ready rows run as one conv call on their input rows, with the top padding
+ * only where they start above the image: the same split as
+ * esp_nn_conv_s8_workers. Those rows are never more than `extent`, and the
+ * ring stores each row twice so that they are always contiguous.
+ */
+
+#include <string.h>
+
+#include <esp_nn.h>
+#include <esp_nn_stream.h>
+#include <common_functions.h>
+
+static int32_t stream_extent(const data_dims_t *filter_dims, const conv_params_t *conv_params)
+{
+    return max(1, conv_params->dilation.height) * (filter_dims->height - 1) + 1;
+}
+
+static int32_t stream_ring_rows(const data_dims_t *input_dims, const data_dims_t *filter_dims,
+                                const conv_params_t *conv_params)
+{
+    return min(input_dims->height, stream_extent(filter_dims, conv_params));
+}
+
+/* input rows output row `y` needs in before it can run */
+static int32_t stream_rows_needed(const data_dims_t *input_dims, const int32_t extent,
+                                  const conv_params_t *conv_params, const int32_t y)
+{
+    return min(input_dims->height,
+               y * conv_params->stride.height - conv_params->padding.height + extent);
+}
+
+/* first output row not ready with `rows_in` input rows */
+static int32_t stream_rows_ready(const data_dims_t *input_dims, const data_dims_t *output_dims,
+                                 const int32_t extent, const conv_params_t *conv_params,
+                                 int32_t y, const int32_t rows_in)
+{
+    while (y < output_dims->height &&
+            stream_rows_needed(input_dims, extent, conv_params, y) <= rows_in) {
+        y++;
+    }
+    return y;
+}
+
+/* dims and params of the conv call computing output rows [y0, y1) */
+static int32_t stream_window(const data_dims_t *input_dims, const data_dims_t *output_dims,
+                             const conv_params_t *conv_params, const int32_t extent,
+                             const int32_t y0, const int32_t y1,
+                             data_dims_t *window_in, data_dims_t *window_out,
+                             conv_params_t *window_params)
+{
+    const int32_t in_first = y0 * conv_params->stride.height - conv_params->padding.height;
+    const int32_t in_row = max(0, in_first);
+
+    *window_in = *input_dims;
+    window_in->height = stream_rows_needed(input_dims, extent, conv_params, y1 - 1) - in_row;
+    window_in->extra = 1;
+    *window_out = *output_dims;
+    window_out->height = y1 - y0;
+    window_out->extra = 1;
+    *window_params = *conv_params;
+    window_params->padding.height = in_row - in_first;
+    return in_row;
+}
+
+int32_t esp_nn_get_conv_stream_size(const data_dims_t *input_dims,
+                                    const data_dims_t *filter_dims,
+                                    const conv_params_t *conv_params)
+{
+    const int32_t row_size = input_dims->width * input_dims->channels;
+    return ESP_NN_PREPARED_HDR_SIZE(esp_nn_conv_stream_t) +
+           2 * stream_ring_rows(input_dims, filter_dims, conv_params) * row_size;
+}
+
+int32_t esp_nn_get_conv_stream_scratch_size(const data_dims_t *input_dims,
+                                            const data_dims_t *filter_dims,
+                                            const data_dims_t *output_dims,
+                                            const conv_params_t *conv_params)
+{
+    const int32_t extent = stream_extent(filter_dims, conv_params);
+    int32_t size = 0;
+    int32_t y0 = 0;
+
+    /* the windows of a frame, in the order pushes run them */
+    for (int32_t rows_in = 1; rows_in <= input_dims->height; rows_in++) {
+        const int32_t y1 = stream_rows_ready(input_dims, output_dims, extent, conv_params,
+                                             y0, rows_in);
+        if (y1 > y0) {
+            data_dims_t window_in, window_out;
+            conv_params_t window_params;
+            stream_window(input_dims, output_dims, conv_params, extent, y0, y1,
+                          &window_in, &window_out, &window_params);
+            size = max(size, esp_nn_get_conv_scratch_size(&window_in, filter_dims,
+                                                          &window_out, &window_params));
+            y0 = y1;
+        }
+    }
+    return size;
+}
+
+esp_nn_conv_stream_t *esp_nn_conv_stream_init(void *blob,
+                                              const data_dims_t *input_dims,
+                                              const data_dims_t *filter_dims,
+                                              const int8_t *filter_data,
+                                              const int32_t *bias,
+                                              const data_dims_t *output_dims,
+                                              const conv_params_t *conv_params,
+                                              const quant_data_t *quant_data)
+{
+    esp_nn_conv_stream_t *stream = (esp_nn_conv_stream_t *) blob;
+    if (stream == NULL || ((uintptr_t) blob & 15)) {
+        return NULL;
+    }
+    stream->input_dims = *input_dims;
+    stream->input_dims.extra = 1;
+    stream->filter_dims = *filter_dims;
+    stream->output_dims = *output_dims;
+    stream->output_dims.extra = 1;
+    stream->conv_params = *conv_params;
+    stream->quant_data = *quant_data;
+    stream->filter = filter_data;
+    stream->bias = bias;
+    stream->ring = (int8_t *) blob + ESP_NN_PREPARED_HDR_SIZE(esp_nn_conv_stream_t);
+    stream->ring_rows = stream_ring_rows(input_dims, filter_dims, conv_params);
+    stream->row_size = input_dims->width * input_dims->channels;
+
+    const int32_t extent = stream_extent(filter_dims, conv_params);
+    int32_t y0 = 0;
+    stream->max_out_rows = 1;
+    for (int32_t rows_in = 1; rows_in <= input_dims->height; rows_in++) {
+        const int32_t y1 = stream_rows_ready(input_dims, output_dims, extent, conv_params,
+                                             y0, rows_in);
+        stream->max_out_rows = max(stream->max_out_rows, y1 - y0);
+        y0 = y1;
+    }
+    esp_nn_conv_stream_reset(stream);
+    return stream;
+}
+
+void esp_nn_conv_stream_reset(esp_nn_conv_stream_t *stream)
+{
+    stream->rows_in = 0;
+    stream->rows_out = 0;
+}
+
+int32_t esp_nn_conv_stream_push(const esp_nn_ctx_t *ctx,
+                                esp_nn_conv_stream_t *stream,
+                                const int8_t *row,
+                                int8_t *out_data)
+{
+    const int32_t slot = stream->rows_in % stream->ring_rows;
+    memcpy(stream->ring + slot * stream->row_size, row, stream->row_size);
+    memcpy(stream->ring + (slot + stream->ring_rows) * stream->row_size, row, stream->row_size);
+    stream->rows_in++;
+
+    const int32_t extent = stream_extent(&stream->filter_dims, &stream->conv_params);
+    const int32_t y0 = stream->rows_out;
+    const int32_t y1 = stream_rows_ready(&stream->input_dims, &stream->output_dims, extent,
+                                         &stream->conv_params, y0, stream->rows_in);
+    if (y1 > y0) {
+        data_dims_t window_in, window_out;
+        conv_params_t window_params;
+        const int32_t in_row = stream_window(&stream->input_dims, &stream->output_dims,
+                                             &stream->conv_params, extent, y0, y1,
+                                             &window_in, &window_out, &window_params);
+        esp_nn_conv_s8_ctx(ctx, &window_in,
+                           stream->ring + (in_row % stream->ring_rows) * stream->row_size,
+                           &stream->filter_dims, stream->filter, stream->bias,
+                           &window_out, out_data, &window_params, &stream->quant_data);
+        stream->rows_out = y1;
+    }
+    if (stream->rows_in == stream->input_dims.height) {
+        /* frame done, the next push starts a new one */
+        esp_nn_conv_stream_reset(stream);
+    }
+    return y1 - y0;
+}
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <esp_nn_defs.h>
+#include <esp_nn_ansi_headers.h>
+
 #include <common_functions.h>
 
 int esp_nn_get_depthwise_conv_scratch_size_opt(const data_dims_t *input_dims,
@@ -38,7 +40,7 @@ static void esp_nn_depthwise_conv_s8_ch_mult_1(const data_dims_t *input_dims,
                                                const data_dims_t *output_dims,
                                                int8_t *out_data,
                                                const dw_conv_params_t *conv_params,
-                                               const quant_data_t *quant_data)
+                                               const quant_plan_data_t *quant_data)
 {
     const uint16_t input_wd = input_dims->width;
     const uint16_t input_ht = input_dims->height;
@@ -62,9 +64,6 @@ static void esp_nn_depthwise_conv_s8_ch_mult_1(const data_dims_t *input_dims,
         for (int out_x = 0; out_x < out_wd; out_x++) { //width_loop
             const int16_t base_x = (out_x * stride_wd) - pad_wd;
 
-            const int32_t *out_shift = quant_data->shift;
-            const int32_t *out_mult = quant_data->mult;
-
             /* Select filter so as the point doesn't lie outside block */
             int filter_y_start = max(0, -base_y);
             int filter_x_start = max(0, -base_x);
@@ -104,10 +103,10 @@ static void esp_nn_depthwise_conv_s8_ch_mult_1(const data_dims_t *input_dims,
                     result2 += bias[ch_idx + 2];
                     result3 += bias[ch_idx + 3];
                 }
-                result0 = esp_nn_requantize(result0, *out_mult++, *out_shift++);
-                result1 = esp_nn_requantize(result1, *out_mult++, *out_shift++);
-                result2 = esp_nn_requantize(result2, *out_mult++, *out_shift++);
-                result3 = esp_nn_requantize(result3, *out_mult++, *out_shift++);
+                result0 = esp_nn_requantize_ch(result0, quant_data, ch_idx + 0);
+                result1 = esp_nn_requantize_ch(result1, quant_data, ch_idx + 1);
+                result2 = esp_nn_requantize_ch(result2, quant_data, ch_idx + 2);
+                result3 = esp_nn_requantize_ch(result3, quant_data, ch_idx + 3);
 
                 result0 += out_offset;
                 result1 += out_offset;
@@ -146,7 +145,7 @@ static void esp_nn_depthwise_conv_s8_ch_mult_1(const data_dims_t *input_dims,
                 if (bias) {
                     result += bias[ch_idx];
                 }
-                result = esp_nn_requantize(result, *out_mult++, *out_shift++);
+                result = esp_nn_requantize_ch(result, quant_data, ch_idx);
                 result += out_offset;
                 result = max(result, activation_min);
                 result = min(result, activation_max);
@@ -157,15 +156,15 @@ static void esp_nn_depthwise_conv_s8_ch_mult_1(const data_dims_t *input_dims,
     }
 }
 
-void esp_nn_depthwise_conv_s8_opt(const data_dims_t *input_dims,
-                                  const int8_t *input_data,
-                                  const data_dims_t *filter_dims,
-                                  const int8_t *filter_data,
-                                  const int32_t *bias,
-                                  const data_dims_t *output_dims,
-                                  int8_t *out_data,
-                                  const dw_conv_params_t *conv_params,
-                                  const quant_data_t *quant_data)
+static void esp_nn_depthwise_conv_s8_image_opt(const data_dims_t *input_dims,
+                                               const int8_t *input_data,
+                                               const data_dims_t *filter_dims,
+                                               const int8_t *filter_data,
+                                               const int32_t *bias,
+                                               const data_dims_t *output_dims,
+                                               int8_t *out_data,
+                                               const dw_conv_params_t *conv_params,
+                                               const quant_plan_data_t *quant_data)
 {
     const uint16_t ch_mult = conv_params->ch_mult;
     if (ch_mult == 1) {
@@ -195,9 +194,6 @@ void esp_nn_depthwise_conv_s8_opt(const data_dims_t *input_dims,
         for (int out_x = 0; out_x < out_wd; out_x++) { //width_loop
             const int16_t base_x = (out_x * stride_wd) - pad_wd;
 
-            const int32_t *out_shift = quant_data->shift;
-            const int32_t *out_mult = quant_data->mult;
-
             /* Select filter so as the point doesn't lie outside block */
             int filter_y_start = max(0, -base_y);
             int filter_x_start = max(0, -base_x);
@@ -236,10 +232,10 @@ void esp_nn_depthwise_conv_s8_opt(const data_dims_t *input_dims,
                         result2 += bias[out_ch_idx + 2];
                         result3 += bias[out_ch_idx + 3];
                     }
-                    result0 = esp_nn_requantize(result0, *out_mult++, *out_shift++);
-                    result1 = esp_nn_requantize(result1, *out_mult++, *out_shift++);
-                    result2 = esp_nn_requantize(result2, *out_mult++, *out_shift++);
-                    result3 = esp_nn_requantize(result3, *out_mult++, *out_shift++);
+                    result0 = esp_nn_requantize_ch(result0, quant_data, out_ch_idx + 0);
+                    result1 = esp_nn_requantize_ch(result1, quant_data, out_ch_idx + 1);
+                    result2 = esp_nn_requantize_ch(result2, quant_data, out_ch_idx + 2);
+                    result3 = esp_nn_requantize_ch(result3, quant_data, out_ch_idx + 3);
 
                     result0 += out_offset;
                     result1 += out_offset;
@@ -278,7 +274,7 @@ void esp_nn_depthwise_conv_s8_opt(const data_dims_t *input_dims,
                     if (bias) {
                         result += bias[out_ch_idx];
                     }
-                    result = esp_nn_requantize(result, *out_mult++, *out_shift++);
+                    result = esp_nn_requantize_ch(result, quant_data, out_ch_idx);
                     result += out_offset;
                     result = max(result, activation_min);
                     result = min(result, activation_max);
@@ -289,3 +285,240 @@ void esp_nn_depthwise_conv_s8_opt(const data_dims_t *input_dims,
         }
     }
 }
+
+#define ESP_NN_DW_DILATED_BLOCK     16
+
+void esp_nn_depthwise_conv_s8_dilated_opt(const data_dims_t *input_dims,
+                                          const int8_t *input_data,
+                                          const data_dims_t *filter_dims,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          const data_dims_t *output_dims,
+                                          int8_t *out_data,
+                                          const dw_conv_params_t *conv_params,
+                                          const quant_plan_data_t *quant_data)
+{
+    const int32_t input_wd = input_dims->width;
+    const int32_t input_ht = input_dims->height;
+    const int32_t channels = input_dims->channels;
+    const int32_t input_offset = conv_params->in_offset;
+    const int32_t out_offset = conv_params->out_offset;
+    const int32_t pad_wd = conv_params->padding.width;
+    const int32_t pad_ht = conv_params->padding.height;
+    const int32_t stride_wd = conv_params->stride.width;
+    const int32_t stride_ht = conv_params->stride.height;
+    const int32_t dilation_wd = esp_nn_dilation(conv_params->dilation.width);
+    const int32_t dilation_ht = esp_nn_dilation(conv_params->dilation.height);
+    const int32_t ch_mult = conv_params->ch_mult;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    const int32_t out_wd = output_dims->width;
+    const int32_t out_ht = output_dims->height;
+    const int32_t out_channels = channels * ch_mult;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            const int32_t base_y = out_y * stride_ht - pad_ht;
+            int32_t fy_start, fy_end;
+            esp_nn_filter_taps(base_y, filter_ht, dilation_ht, input_ht, &fy_start, &fy_end);
+
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                const int32_t base_x = out_x * stride_wd - pad_wd;
+                int32_t fx_start, fx_end;
+                esp_nn_filter_taps(base_x, filter_wd, dilation_wd, input_wd, &fx_start, &fx_end);
+
+                for (int32_t ch0 = 0; ch0 < out_channels; ch0 += ESP_NN_DW_DILATED_BLOCK) {
+                    const int32_t block = min(ESP_NN_DW_DILATED_BLOCK, out_channels - ch0);
+                    int32_t acc[ESP_NN_DW_DILATED_BLOCK] = {0};
+
+                    for (int32_t fy = fy_start; fy < fy_end; fy++) {
+                        const int32_t in_y = base_y + fy * dilation_ht;
+                        for (int32_t fx = fx_start; fx < fx_end; fx++) {
+                            const int32_t in_x = base_x + fx * dilation_wd;
+                            const int8_t *in_ptr = input_data + (in_y * input_wd + in_x) * channels;
+                            const int8_t *filter_ptr = filter_data +
+                                                       (fy * filter_wd + fx) * out_channels + ch0;
+                            if (ch_mult == 1) {
+                                in_ptr += ch0;
+                                for (int32_t k = 0; k < block; k++) {
+                                    acc[k] += (in_ptr[k] + input_offset) * filter_ptr[k];
+                                }
+                            } else {
+                                for (int32_t k = 0; k < block; k++) {
+                                    acc[k] += (in_ptr[(ch0 + k) / ch_mult] + input_offset) *
+                                              filter_ptr[k];
+                                }
+                            }
+                        }
+                    }
+                    for (int32_t k = 0; k < block; k++) {
+                        int32_t result = acc[k];
+                        if (bias) {
+                            result += bias[ch0 + k];
+                        }
+                        result = esp_nn_requantize_ch(result, quant_data, ch0 + k);
+                        result += out_offset;
+                        result = max(result, activation_min);
+                        result = min(result, activation_max);
+                        *out_data++ = (int8_t) result;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* No scratch needed, the context is ignored */
+void esp_nn_depthwise_conv_s8_plan_opt(const esp_nn_ctx_t *ctx,
+                                       const data_dims_t *input_dims,
+                                       const int8_t *input_data,
+                                       const data_dims_t *filter_dims,
+                                       const int8_t *filter_data,
+                                       const int32_t *bias,
+                                       const data_dims_t *output_dims,
+                                       int8_t *out_data,
+                                       const dw_conv_params_t *conv_params,
+                                       const quant_plan_data_t *quant_data)
+{
+    (void) ctx;
+    if (esp_nn_is_dilated(filter_dims, &conv_params->dilation)) {
+        esp_nn_depthwise_conv_s8_dilated_opt(input_dims, input_data, filter_dims, filter_data, bias,
+                                             output_dims, out_data, conv_params, quant_data);
+        return;
+    }
+    /* nothing is prepared per call here: the images of a batch just run in turn */
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_dims->width * input_dims->height * input_dims->channels;
+    const int32_t output_size = output_dims->width * output_dims->height * output_dims->channels;
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        esp_nn_depthwise_conv_s8_image_opt(input_dims, input_data + batch * input_size,
+                                           filter_dims, filter_data, bias, output_dims,
+                                           out_data + batch * output_size, conv_params,
+                                           quant_data);
+    }
+}
+
+void esp_nn_depthwise_conv_s8_opt(const data_dims_t *input_dims,
+                                  const int8_t *input_data,
+                                  const data_dims_t *filter_dims,
+                                  const int8_t *filter_data,
+                                  const int32_t *bias,
+                                  const data_dims_t *output_dims,
+                                  int8_t *out_data,
+                                  const dw_conv_params_t *conv_params,
+                                  const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_depthwise_conv_s8_plan_opt(NULL, input_dims, input_data, filter_dims, filter_data,
+                                      bias, output_dims, out_data, conv_params, &no_plan);
+}
+
+void esp_nn_depthwise_conv_s8_ctx_opt(const esp_nn_ctx_t *ctx,
+                                      const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const dw_conv_params_t *conv_params,
+                                      const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_depthwise_conv_s8_plan_opt(ctx, input_dims, input_data, filter_dims, filter_data,
+                                      bias, output_dims, out_data, conv_params, &no_plan);
+}
+
+/*
+ * 16x8 depthwise, channel multiplier 1: four channels at a time, summed in
+ * int32 as long as the filter area keeps the sums in range.
+ */
+void esp_nn_depthwise_conv_s16_opt(const data_dims_t *input_dims,
+                                   const int16_t *input_data,
+                                   const data_dims_t *filter_dims,
+                                   const int8_t *filter_data,
+                                   const int64_t *bias,
+                                   const data_dims_t *output_dims,
+                                   int16_t *out_data,
+                                   const dw_conv_params_t *conv_params,
+                                   const quant_data_t *quant_data)
+{
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t input_ht = input_dims->height;
+    const uint16_t channels = input_dims->channels;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t pad_wd = conv_params->padding.width;
+    const uint16_t pad_ht = conv_params->padding.height;
+    const uint16_t stride_wd = conv_params->stride.width;
+    const uint16_t stride_ht = conv_params->stride.height;
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    if (conv_params->ch_mult != 1 || filter_wd * filter_ht > ESP_NN_S16_DOT_CHUNK / 2) {
+        esp_nn_depthwise_conv_s16_ansi(input_dims, input_data, filter_dims, filter_data, bias,
+                                       output_dims, out_data, conv_params, quant_data);
+        return;
+    }
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int out_y = 0; out_y < out_ht; out_y++) {
+            const int32_t base_y = (out_y * stride_ht) - pad_ht;
+            const int filter_y_start = max(0, -base_y);
+            const int filter_y_end = min(filter_ht, input_ht - base_y);
+            for (int out_x = 0; out_x < out_wd; out_x++) {
+                const int32_t base_x = (out_x * stride_wd) - pad_wd;
+                const int filter_x_start = max(0, -base_x);
+                const int filter_x_end = min(filter_wd, input_wd - base_x);
+
+                for (int ch_idx = 0; ch_idx < channels; ch_idx += 4) {
+                    const int n = min(4, channels - ch_idx);
+                    int32_t sum[4] = {0};
+
+                    for (int filter_y_idx = filter_y_start; filter_y_idx < filter_y_end; filter_y_idx++) {
+                        const int32_t idx_y = base_y + filter_y_idx;
+                        for (int filter_x_idx = filter_x_start; filter_x_idx < filter_x_end; filter_x_idx++) {
+                            const int32_t idx_x = base_x + filter_x_idx;
+                            const int16_t *in_ptr = input_data + (idx_y * input_wd + idx_x) * channels + ch_idx;
+                            const int8_t *filter_ptr = filter_data +
+                                                       (filter_y_idx * filter_wd + filter_x_idx) * channels + ch_idx;
+                            if (n == 4) {
+                                sum[0] += in_ptr[0] * filter_ptr[0];
+                                sum[1] += in_ptr[1] * filter_ptr[1];
+                                sum[2] += in_ptr[2] * filter_ptr[2];
+                                sum[3] += in_ptr[3] * filter_ptr[3];
+                            } else {
+                                for (int i = 0; i < n; i++) {
+                                    sum[i] += in_ptr[i] * filter_ptr[i];
+                                }
+                            }
+                        }
+                    }
+                    for (int i = 0; i < n; i++) {
+                        int64_t acc = sum[i];
+                        if (bias) {
+                            acc += bias[ch_idx + i];
+                        }
+                        int32_t result = esp_nn_multiply_by_quantized_mult_s64(acc, quant_data->mult[ch_idx + i],
+                                                                                quant_data->shift[ch_idx + i]);
+                        result += out_offset;
+                        result = max(result, activation_min);
+                        result = min(result, activation_max);
+                        *out_data++ = (int16_t) result;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -9,7 +9,8 @@
 
 #include <common_functions.h>
 
-static int16_t *scratch_buffer = NULL;
+/* scratch of the legacy (non `_ctx`) API, set with esp_nn_set_depthwise_conv_scratch_buf */
+static esp_nn_ctx_t legacy_ctx;
 
 extern void esp_nn_depthwise_conv_s16_mult8_3x3_esp32s3(const int16_t *input_data,
                                                         const uint16_t input_wd,
@@ -366,6 +367,10 @@ int esp_nn_get_depthwise_conv_scratch_size_esp32s3(const data_dims_t *input_dims
     int filter_size = filter_wd * filter_ht * channels * ch_mult;
     int pad_width = 0, pad_height = 0;
 
+    if (esp_nn_is_dilated(filter_dims, &conv_params->dilation)) {
+        return 0;
+    }
+
     if ((ch_mult == 1) && (channels % 8 == 0)) {
         if(filter_wd == 3 && filter_ht == 3) {
             if (channels % 16 == 0) {
@@ -381,9 +386,9 @@ int esp_nn_get_depthwise_conv_scratch_size_esp32s3(const data_dims_t *input_dims
                     if (full_input <= 40 * 1024) {
                         return filter_size + full_input + 16;
                     } else {
-                        /* Tiled: only need filter + strip buffer (filter_ht rows) */
+                        /* Tiled: only need filter + two strip buffers (filter_ht rows) */
                         int strip = (input_wd + pad_width) * filter_ht * channels;
-                        return filter_size + strip + 16;
+                        return filter_size + 2 * strip + 16;
                     }
                 } else {
                     return filter_size + 16;
@@ -444,7 +449,7 @@ int esp_nn_get_depthwise_conv_scratch_size_esp32s3(const data_dims_t *input_dims
 
 void esp_nn_set_depthwise_conv_scratch_buf_esp32s3(void *buf)
 {
-    scratch_buffer = (int16_t *) buf;
+    legacy_ctx.scratch = buf;
 }
 
 /**
@@ -461,23 +466,32 @@ void esp_nn_set_depthwise_conv_scratch_buf_esp32s3(void *buf)
  * - ch_mult % 4 != 0: Pad ch_mult to next multiple of 4, use mult4 functions
  * - ch_mult == 1, channels % 8 != 0: Fallback to C implementation for correctness
  *
+ * Dilated layers run esp_nn_depthwise_conv_s8_dilated_opt, without scratch.
+ *
  * Assumption 1: i/p channels == o/p channels
  * Assumption 2: Pointers are valid
- * Assumption 3: dilation width = 1
  */
 
 #include "esp_nn_generic_opt.h"
 
-void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
-                                      const int8_t *input_data,
-                                      const data_dims_t *filter_dims,
-                                      const int8_t *filter_data,
-                                      const int32_t *bias,
-                                      const data_dims_t *output_dims,
-                                      int8_t *out_data,
-                                      const dw_conv_params_t *conv_params,
-                                      const quant_data_t *quant_data)
+/**
+ * One image. Every path keeps its converted filter at the start of scratch,
+ * ahead of the input: with `filter_ready`, that of the previous image of the
+ * batch is used as is.
+ */
+static void esp_nn_depthwise_conv_s8_image_s3(const esp_nn_ctx_t *ctx,
+                                              const data_dims_t *input_dims,
+                                              const int8_t *input_data,
+                                              const data_dims_t *filter_dims,
+                                              const int8_t *filter_data,
+                                              const int32_t *bias,
+                                              const data_dims_t *output_dims,
+                                              int8_t *out_data,
+                                              const dw_conv_params_t *conv_params,
+                                              const quant_plan_data_t *quant_data,
+                                              const bool filter_ready)
 {
+    int16_t *scratch_buffer = (int16_t *) ctx->scratch;
     const uint16_t input_wd = input_dims->width;
     const uint16_t input_ht = input_dims->height;
     const uint16_t channels = input_dims->channels;
@@ -513,7 +527,9 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                 /* process in 8 bits with s8 padded assembly */
                 int8_t *filter_aligned = (int8_t *) scratch_buffer;
                 int8_t *input_padded = (int8_t *) scratch_buffer + filter_size + align_len;
-                memcpy(filter_aligned, filter_data, filter_size);
+                if (!filter_ready) {
+                    memcpy(filter_aligned, filter_data, filter_size);
+                }
 
                 int padded_input_size = (input_wd + 2*pad_wd) * (input_ht + 2*pad_ht) * channels;
                 if (padded_input_size <= 40 * 1024) {
@@ -527,15 +543,19 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                                                                       out_mult, activation_min, activation_max);
                 } else {
                     /* Large input: row-tiled processing to reduce cache pressure.
-                     * Pad and process a strip of output rows at a time. */
+                     * Pad and process a strip of output rows at a time: the strip
+                     * of row out_y is staged through the mover while out_y - 1 runs. */
                     int padded_wd = input_wd + 2 * pad_wd;
                     int8_t pad_val = (int8_t)(-input_offset);
+                    const int strip_size = padded_wd * filter_ht * channels;
+                    int32_t ticket = -1;
 
-                    for (int out_y = 0; out_y < out_ht; out_y++) {
+                    for (int out_y = 0; out_y <= out_ht; out_y++) {
+                        const int32_t staged = ticket;
                         int in_y_start = out_y * stride_ht; /* in padded coords (pad_ht already accounted) */
                         /* Pad filter_ht rows of input into scratch */
-                        int8_t *tile = input_padded;
-                        for (int fy = 0; fy < filter_ht; fy++) {
+                        int8_t *tile = input_padded + (out_y & 1) * strip_size;
+                        for (int fy = 0; fy < filter_ht && out_y < out_ht; fy++) {
                             int src_y = in_y_start + fy - pad_ht; /* original input row */
                             if (src_y < 0 || src_y >= input_ht) {
                                 /* Padding row */
@@ -544,19 +564,23 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                                 /* Left pad */
                                 memset(tile, pad_val, pad_wd * channels);
                                 /* Copy input row */
-                                memcpy(tile + pad_wd * channels,
-                                       input_data + src_y * input_wd * channels,
-                                       input_wd * channels);
+                                ticket = esp_nn_tile_copy(ctx->mover, tile + pad_wd * channels,
+                                                          input_data + src_y * input_wd * channels,
+                                                          input_wd * channels);
                                 /* Right pad */
                                 memset(tile + (pad_wd + input_wd) * channels, pad_val, pad_wd * channels);
                             }
                             tile += padded_wd * channels;
                         }
+                        if (out_y == 0) {
+                            continue;
+                        }
                         /* Process one output row */
+                        esp_nn_tile_wait(ctx->mover, staged);
                         esp_nn_depthwise_conv_s8_mult1_3x3_padded_esp32s3(
-                            input_padded, padded_wd, filter_ht, channels, input_offset,
-                            stride_wd, 1, filter_aligned, bias,
-                            out_data + out_y * out_wd * channels,
+                            input_padded + ((out_y - 1) & 1) * strip_size, padded_wd, filter_ht,
+                            channels, input_offset, stride_wd, 1, filter_aligned, bias,
+                            out_data + (out_y - 1) * out_wd * channels,
                             out_wd, 1, out_offset, out_shift,
                             out_mult, activation_min, activation_max);
                     }
@@ -575,7 +599,9 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                 } else {
                     input_padded = (int8_t *) input_data;
                 }
-                memcpy(filter_aligned, filter_data, filter_size);
+                if (!filter_ready) {
+                    memcpy(filter_aligned, filter_data, filter_size);
+                }
                 esp_nn_depthwise_conv_s8_mult1_3x3_padded_esp32s3(input_padded, input_wd + pad_right,
                                                                   input_ht + pad_bottom, channels, input_offset,
                                                                   stride_wd, stride_ht, filter_aligned, bias,
@@ -590,9 +616,11 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                 /* Pad filter: 3x3 x new_ch */
                 int new_filter_size = 9 * new_ch;
                 int8_t *filter_padded = (int8_t *) scratch_buffer;
-                memset(filter_padded, 0, new_filter_size);
-                for (int f = 0; f < 9; f++) {
-                    memcpy(filter_padded + f * new_ch, filter_data + f * channels, channels);
+                if (!filter_ready) {
+                    memset(filter_padded, 0, new_filter_size);
+                    for (int f = 0; f < 9; f++) {
+                        memcpy(filter_padded + f * new_ch, filter_data + f * channels, channels);
+                    }
                 }
 
                 /* Pad input: (input_wd + 2*pad) x (input_ht + 2*pad) x new_ch */
@@ -645,7 +673,9 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                 }
             } else {
                 /* ch < 12 (e.g., ch=8), 3x3: use s16 mult1 3x3 path */
-                esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+                if (!filter_ready) {
+                    esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+                }
                 esp_nn_aligned_s8_to_s16_with_offset_esp32s3(input_data, input_data16, input_size, input_offset);
                 esp_nn_depthwise_conv_s16_mult1_3x3_esp32s3(input_data16, input_wd, input_ht, channels,
                                                             pad_wd, pad_ht, stride_wd, stride_ht, filter_data16,
@@ -655,7 +685,9 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
         } else { // all other ch_mult == 1, channels % 8 == 0
             /* Tiled s16 processing: convert filter once, process input in row strips
              * to keep working set within DCache (64KB) */
-            esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+            if (!filter_ready) {
+                esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+            }
 
             /* Check if full conversion fits comfortably in cache */
             int total_s16_size = 2 * (filter_size + input_size);
@@ -738,13 +770,15 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
         }
 
         // Convert filter data to padded layout (zero out extra channels)
-        memset(padded_filter_data16, 0, padded_filter_size * sizeof(int16_t));
-        for (int c = 0; c < channels; c++) {
-            for (int fy = 0; fy < filter_ht; fy++) {
-                for (int fx = 0; fx < filter_wd; fx++) {
-                    int orig_idx = (fy * filter_wd + fx) * channels + c;
-                    int padded_idx = (fy * filter_wd + fx) * padded_channels + c;
-                    padded_filter_data16[padded_idx] = (int16_t) filter_data[orig_idx];
+        if (!filter_ready) {
+            memset(padded_filter_data16, 0, padded_filter_size * sizeof(int16_t));
+            for (int c = 0; c < channels; c++) {
+                for (int fy = 0; fy < filter_ht; fy++) {
+                    for (int fx = 0; fx < filter_wd; fx++) {
+                        int orig_idx = (fy * filter_wd + fx) * channels + c;
+                        int padded_idx = (fy * filter_wd + fx) * padded_channels + c;
+                        padded_filter_data16[padded_idx] = (int16_t) filter_data[orig_idx];
+                    }
                 }
             }
         }
@@ -779,7 +813,9 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
         }
     } else if (ch_mult % 8 == 0) {
         // Channel multiplier is optimized multiple - use direct s16 functions
-        esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+        if (!filter_ready) {
+            esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+        }
         esp_nn_aligned_s8_to_s16_with_offset_esp32s3(input_data, input_data16, input_size, input_offset);
         if (filter_wd == 3 && filter_ht == 3) {
             esp_nn_depthwise_conv_s16_mult8_3x3_esp32s3(input_data16, input_wd, input_ht, channels,
@@ -795,7 +831,9 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                                                     out_mult, activation_min, activation_max);
         }
     } else if (ch_mult % 4 == 0) {
-        esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+        if (!filter_ready) {
+            esp_nn_s8_to_s16_esp32s3(filter_data, filter_data16, filter_size);
+        }
         esp_nn_aligned_s8_to_s16_with_offset_esp32s3(input_data, input_data16, input_size, input_offset);
         esp_nn_depthwise_conv_s16_mult4_esp32s3(input_data16, input_wd, input_ht, channels,
                                                 pad_wd, pad_ht, stride_wd, stride_ht, ch_mult,
@@ -803,7 +841,68 @@ void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
                                                 out_data, out_wd, out_ht, out_offset, out_shift,
                                                 out_mult, activation_min, activation_max);
     } else {
-        esp_nn_depthwise_conv_s8_opt(input_dims, input_data, filter_dims, filter_data, bias,
-                                     output_dims, out_data, conv_params, quant_data);
+        esp_nn_depthwise_conv_s8_plan_opt(ctx, input_dims, input_data, filter_dims, filter_data,
+                                          bias, output_dims, out_data, conv_params, quant_data);
     }
 }
+
+void esp_nn_depthwise_conv_s8_plan_esp32s3(const esp_nn_ctx_t *ctx,
+                                           const data_dims_t *input_dims,
+                                           const int8_t *input_data,
+                                           const data_dims_t *filter_dims,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           const data_dims_t *output_dims,
+                                           int8_t *out_data,
+                                           const dw_conv_params_t *conv_params,
+                                           const quant_plan_data_t *quant_data)
+{
+    if (esp_nn_is_dilated(filter_dims, &conv_params->dilation)) {
+        esp_nn_depthwise_conv_s8_dilated_opt(input_dims, input_data, filter_dims, filter_data, bias,
+                                             output_dims, out_data, conv_params, quant_data);
+        return;
+    }
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_dims->width * input_dims->height * input_dims->channels;
+    const int32_t output_size = output_dims->width * output_dims->height * output_dims->channels;
+    data_dims_t image_dims = *input_dims;
+    image_dims.extra = 1;
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        esp_nn_depthwise_conv_s8_image_s3(ctx, &image_dims, input_data + batch * input_size,
+                                          filter_dims, filter_data, bias, output_dims,
+                                          out_data + batch * output_size, conv_params,
+                                          quant_data, batch > 0);
+    }
+}
+
+void esp_nn_depthwise_conv_s8_ctx_esp32s3(const esp_nn_ctx_t *ctx,
+                                          const data_dims_t *input_dims,
+                                          const int8_t *input_data,
+                                          const data_dims_t *filter_dims,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          const data_dims_t *output_dims,
+                                          int8_t *out_data,
+                                          const dw_conv_params_t *conv_params,
+                                          const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    esp_nn_depthwise_conv_s8_plan_esp32s3(ctx, input_dims, input_data, filter_dims, filter_data,
+                                          bias, output_dims, out_data, conv_params, &no_plan);
+}
+
+void esp_nn_depthwise_conv_s8_esp32s3(const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const dw_conv_params_t *conv_params,
+                                      const quant_data_t *quant_data)
+{
+    esp_nn_depthwise_conv_s8_ctx_esp32s3(&legacy_ctx, input_dims, input_data, filter_dims,
+                                         filter_data, bias, output_dims, out_data,
+                                         conv_params, quant_data);
+}
@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * A tile covers depthwise output rows [y0, y1). Its depthwise call gets the
+ * input rows those read, with the top padding only where the tile starts
+ * above the input, as in esp_nn_conv_s8_workers. With an expansion, those
+ * input rows are expanded first: 1x1 convs map rows to rows.
+ *
+ * Scratch: the expanded rows of a tile, then the depthwise rows, then the
+ * scratch the stage kernels share, each 16 byte aligned.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <esp_nn.h>
+#include <esp_nn_fused.h>
+#include <common_functions.h>
+
+#define FUSED_ALIGN(size)   (((size) + 15) & ~15)
+
+typedef struct {
+    data_dims_t in_dims;            // input rows of the tile
+    data_dims_t dw_in_dims;         // rows the depthwise reads: expanded or the input ones
+    data_dims_t mid_dims;           // depthwise output rows
+    data_dims_t out_dims;
+    dw_conv_params_t dw_params;
+    int32_t in_row;                 // first input row of the tile
+} fused_tile_t;
+
+static bool fused_pw_valid(const esp_nn_fused_pw_t *pw, const data_dims_t *input_dims)
+{
+    return pw->filter_dims.width == 1 && pw->filter_dims.height == 1 &&
+           pw->params.stride.width == 1 && pw->params.stride.height == 1 &&
+           pw->params.padding.width == 0 && pw->params.padding.height == 0 &&
+           pw->output_dims.width == input_dims->width &&
+           pw->output_dims.height == input_dims->height;
+}
+
+static void fused_tile(const data_dims_t *input_dims, const esp_nn_fused_pw_t *expand,
+                       const esp_nn_fused_dw_t *dw, const esp_nn_fused_pw_t *project,
+                       const int32_t y0, const int32_t y1, fused_tile_t *t)
+{
+    const dw_conv_params_t *params = &dw->params;
+    const int32_t extent = max(1, params->dilation.height) * (dw->filter_dims.height - 1) + 1;
+    const int32_t in_first = y0 * params->stride.height - params->padding.height;
+    const int32_t in_end = (y1 - 1) * params->stride.height - params->padding.height + extent;
+
+    t->in_row = max(0, in_first);
+    t->in_dims = *input_dims;
+    t->in_dims.height = max(0, min(input_dims->height, in_end) - t->in_row);
+    t->in_dims.extra = 1;
+    t->dw_in_dims = expand ? expand->output_dims : *input_dims;
+    t->dw_in_dims.height = t->in_dims.height;
+    t->dw_in_dims.extra = 1;
+    t->mid_dims = dw->output_dims;
+    t->mid_dims.height = y1 - y0;
+    t->mid_dims.extra = 1;
+    t->out_dims = project->output_dims;
+    t->out_dims.height = y1 - y0;
+    t->out_dims.extra = 1;
+    t->dw_params = *params;
+    t->dw_params.padding.height = t->in_row - in_first;
+}
+
+/* bytes of the expanded and of the depthwise tile */
+static void fused_tile_sizes(const data_dims_t *input_dims, const esp_nn_fused_pw_t *expand,
+                             const esp_nn_fused_dw_t *dw, const int32_t tile_rows,
+                             int32_t *exp_size, int32_t *mid_size)
+{
+    const dw_conv_params_t *params = &dw->params;
+    const int32_t extent = max(1, params->dilation.height) * (dw->filter_dims.height - 1) + 1;
+    const int32_t in_rows = min(input_dims->height,
+                                (tile_rows - 1) * params->stride.height + extent);
+
+    *exp_size = expand ? FUSED_ALIGN(in_rows * expand->output_dims.width *
+                                     expand->output_dims.channels) : 0;
+    *mid_size = FUSED_ALIGN(tile_rows * dw->output_dims.width * dw->output_dims.channels);
+}
+
+int32_t esp_nn_get_dw_pw_conv_scratch_size(const data_dims_t *input_dims,
+                                           const esp_nn_fused_pw_t *expand,
+                                           const esp_nn_fused_dw_t *dw,
+                                           const esp_nn_fused_pw_t *project,
+                                           const int32_t tile_rows)
+{
+    const int32_t mid_ht = dw->output_dims.height;
+    int32_t exp_size, mid_size;
+    int32_t kernel_size = 0;
+
+    fused_tile_sizes(input_dims, expand, dw, tile_rows, &exp_size, &mid_size);
+    for (int32_t y0 = 0; y0 < mid_ht; y0 += tile_rows) {
+        fused_tile_t t;
+        fused_tile(input_dims, expand, dw, project, y0, min(y0 + tile_rows, mid_ht), &t);
+        if (expand) {
+            kernel_size = max(kernel_size,
+                              esp_nn_get_conv_scratch_size(&t.in_dims, &expand->filter_dims,
+                                                           &t.dw_in_dims, &expand->params));
+        }
+        kernel_size = max(kernel_size,
+                          esp_nn_get_depthwise_conv_scratch_size(&t.dw_in_dims, &dw->filter_dims,
+                                                                 &t.mid_dims, &t.dw_params));
+        kernel_size = max(kernel_size,
+                          esp_nn_get_conv_scratch_size(&t.mid_dims, &project->filter_dims,
+                                                       &t.out_dims, &project->params));
+    }
+    return exp_size + mid_size + kernel_size;
+}
+
+int esp_nn_dw_pw_conv_s8(const esp_nn_ctx_t *ctx,
+                         const data_dims_t *input_dims,
+                         const int8_t *input_data,
+                         const esp_nn_fused_pw_t *expand,
+                         const esp_nn_fused_dw_t *dw,
+                         const esp_nn_fused_pw_t *project,
+                         const int32_t tile_rows,
+                         int8_t *out_data)
+{
+    if ((expand && !fused_pw_valid(expand, input_dims)) ||
+            !fused_pw_valid(project, &dw->output_dims) || tile_rows < 1) {
+        printf("esp_nn_dw_pw_conv_s8: pointwise stages must be 1x1, stride 1, unpadded\n");
+        return -1;
+    }
+    int32_t exp_size, mid_size;
+    fused_tile_sizes(input_dims, expand, dw, tile_rows, &exp_size, &mid_size);
+    int8_t *exp_tile = (int8_t *) ctx->scratch;
+    int8_t *mid_tile = exp_tile + exp_size;
+    const esp_nn_ctx_t kernel_ctx = {.scratch = mid_tile + mid_size, .mover = ctx->mover};
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t in_row_size = input_dims->width * input_dims->channels;
+    const int32_t out_row_size = project->output_dims.width * project->output_dims.channels;
+    const int32_t out_size = out_row_size * project->output_dims.height;
+    const int32_t mid_ht = dw->output_dims.height;
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        const int8_t *image = input_data + batch * in_row_size * input_dims->height;
+        int8_t *image_out = out_data + batch * out_size;
+
+        for (int32_t y0 = 0; y0 < mid_ht; y0 += tile_rows) {
+            fused_tile_t t;
+            fused_tile(input_dims, expand, dw, project, y0, min(y0 + tile_rows, mid_ht), &t);
+
+            const int8_t *dw_in = image + t.in_row * in_row_size;
+            if (expand) {
+                esp_nn_conv_s8_ctx(&kernel_ctx, &t.in_dims, dw_in, &expand->filter_dims,
+                                   expand->filter, expand->bias, &t.dw_in_dims, exp_tile,
+                                   &expand->params, &expand->quant_data);
+                dw_in = exp_tile;
+            }
+            esp_nn_depthwise_conv_s8_ctx(&kernel_ctx, &t.dw_in_dims, dw_in, &dw->filter_dims,
+                                         dw->filter, dw->bias, &t.mid_dims, mid_tile,
+                                         &t.dw_params, &dw->quant_data);
+            esp_nn_conv_s8_ctx(&kernel_ctx, &t.mid_dims, mid_tile, &project->filter_dims,
+                               project->filter, project->bias, &t.out_dims,
+                               image_out + y0 * out_row_size, &project->params,
+                               &project->quant_data);
+        }
+    }
+    return 0;
+}
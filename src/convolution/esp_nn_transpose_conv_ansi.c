@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include "transpose_conv_common.h"
+
+int32_t esp_nn_get_transpose_conv_scratch_size_ansi(const data_dims_t *input_dims,
+                                                    const data_dims_t *filter_dims,
+                                                    const data_dims_t *output_dims,
+                                                    const conv_params_t *conv_params)
+{
+    return 0;
+}
+
+/* output (y, x) takes filter tap (fy, fx) of input (iy, ix) where y + pad = iy * stride + fy */
+void esp_nn_transpose_conv_s8_ansi(const esp_nn_ctx_t *ctx,
+                                   const data_dims_t *input_dims,
+                                   const int8_t *input_data,
+                                   const data_dims_t *filter_dims,
+                                   const int8_t *filter_data,
+                                   const int32_t *bias,
+                                   const data_dims_t *output_dims,
+                                   int8_t *out_data,
+                                   const conv_params_t *conv_params,
+                                   const quant_data_t *quant_data)
+{
+    const uint16_t input_wd = input_dims->width;
+    const uint16_t input_ht = input_dims->height;
+    const uint16_t in_channels = input_dims->channels;
+    const int32_t input_offset = conv_params->in_offset;
+    const int32_t out_offset = conv_params->out_offset;
+    const uint16_t pad_wd = conv_params->padding.width;
+    const uint16_t pad_ht = conv_params->padding.height;
+    const uint16_t stride_wd = conv_params->stride.width;
+    const uint16_t stride_ht = conv_params->stride.height;
+    const uint16_t filter_wd = filter_dims->width;
+    const uint16_t filter_ht = filter_dims->height;
+    const uint16_t out_wd = output_dims->width;
+    const uint16_t out_ht = output_dims->height;
+    const uint16_t out_channels = output_dims->channels;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                for (int32_t out_ch_idx = 0; out_ch_idx < out_channels; out_ch_idx++) {
+                    int32_t conv_out = 0;
+
+                    for (int32_t filter_y_idx = 0; filter_y_idx < filter_ht; filter_y_idx++) {
+                        const int32_t pos_y = out_y + pad_ht - filter_y_idx;
+                        if (pos_y < 0 || pos_y % stride_ht || pos_y / stride_ht >= input_ht) {
+                            continue;
+                        }
+                        for (int32_t filter_x_idx = 0; filter_x_idx < filter_wd; filter_x_idx++) {
+                            const int32_t pos_x = out_x + pad_wd - filter_x_idx;
+                            if (pos_x < 0 || pos_x % stride_wd || pos_x / stride_wd >= input_wd) {
+                                continue;
+                            }
+                            const int32_t in_row = pos_y / stride_ht;
+                            const int32_t in_col = pos_x / stride_wd;
+                            int32_t input_base_offset = (in_row * input_wd + in_col) * in_channels;
+                            int32_t filter_base_offset = ((out_ch_idx * filter_ht + filter_y_idx) * filter_wd +
+                                                          filter_x_idx) * in_channels;
+                            for (int32_t in_ch_idx = 0; in_ch_idx < in_channels; in_ch_idx++) {
+                                conv_out += (input_data[input_base_offset + in_ch_idx] + input_offset) *
+                                            filter_data[filter_base_offset + in_ch_idx];
+                            }
+                        }
+                    }
+                    if (bias) {
+                        conv_out += bias[out_ch_idx];
+                    }
+                    conv_out = esp_nn_multiply_by_quantized_mult(conv_out, quant_data->mult[out_ch_idx],
+                                                                 quant_data->shift[out_ch_idx]);
+                    conv_out += out_offset;
+                    conv_out = max(conv_out, activation_min);
+                    conv_out = min(conv_out, activation_max);
+                    *out_data++ = (int8_t) conv_out;
+                }
+            }
+        }
+    }
+}
+
+/* Nothing is folded for the reference: the blob holds the header and the plan */
+int32_t esp_nn_get_transpose_conv_prepared_size_ansi(const data_dims_t *input_dims,
+                                                     const data_dims_t *filter_dims,
+                                                     const data_dims_t *output_dims,
+                                                     const conv_params_t *conv_params)
+{
+    return ESP_NN_CONV_PREPARED_HDR_SIZE(output_dims->channels);
+}
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_s8_prepare_ansi(void *blob,
+                                                              const data_dims_t *input_dims,
+                                                              const data_dims_t *filter_dims,
+                                                              const int8_t *filter_data,
+                                                              const int32_t *bias,
+                                                              const data_dims_t *output_dims,
+                                                              const conv_params_t *conv_params,
+                                                              const quant_data_t *quant_data)
+{
+    return esp_nn_conv_prepared_init(blob, input_dims, filter_dims, filter_data, bias,
+                                     output_dims, conv_params, quant_data);
+}
+
+void esp_nn_transpose_conv_s8_run_ansi(const esp_nn_ctx_t *ctx,
+                                       const esp_nn_conv_prepared_t *prep,
+                                       const int8_t *input_data,
+                                       int8_t *out_data)
+{
+    const quant_data_t quant_data = {.shift = prep->quant_data.shift, .mult = prep->quant_data.mult};
+    esp_nn_transpose_conv_s8_ansi(ctx, &prep->input_dims, input_data, &prep->filter_dims, prep->filter,
+                                  prep->bias, &prep->output_dims, out_data, &prep->conv_params,
+                                  &quant_data);
+}
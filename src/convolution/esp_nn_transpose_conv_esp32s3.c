@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include "transpose_conv_common.h"
+
+int32_t esp_nn_get_transpose_conv_scratch_size_esp32s3(const data_dims_t *input_dims,
+                                                       const data_dims_t *filter_dims,
+                                                       const data_dims_t *output_dims,
+                                                       const conv_params_t *conv_params)
+{
+    return ESP_NN_TRANSPOSE_CONV_SCRATCH_SIZE(filter_dims, output_dims->channels);
+}
+
+/* Taps over 16 aligned channels run on the SIMD dot product */
+void esp_nn_transpose_conv_s8_esp32s3(const esp_nn_ctx_t *ctx,
+                                      const data_dims_t *input_dims,
+                                      const int8_t *input_data,
+                                      const data_dims_t *filter_dims,
+                                      const int8_t *filter_data,
+                                      const int32_t *bias,
+                                      const data_dims_t *output_dims,
+                                      int8_t *out_data,
+                                      const conv_params_t *conv_params,
+                                      const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    const int32_t *tap_offsets = esp_nn_transpose_conv_fold_taps(input_dims, filter_dims, filter_data,
+                                                                 output_dims, conv_params->in_offset,
+                                                                 (int32_t *) ctx->scratch);
+    esp_nn_transpose_conv_s8_gather(input_dims, input_data, filter_dims, filter_data, bias,
+                                    output_dims, out_data, conv_params, &no_plan,
+                                    tap_offsets, esp_nn_dot_s8_aligned_esp32s3);
+}
+
+/* The tap terms are folded into the blob, run needs no scratch */
+int32_t esp_nn_get_transpose_conv_prepared_size_esp32s3(const data_dims_t *input_dims,
+                                                        const data_dims_t *filter_dims,
+                                                        const data_dims_t *output_dims,
+                                                        const conv_params_t *conv_params)
+{
+    return ESP_NN_TRANSPOSE_CONV_PREPARED_SIZE(filter_dims, output_dims->channels);
+}
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_s8_prepare_esp32s3(void *blob,
+                                                                 const data_dims_t *input_dims,
+                                                                 const data_dims_t *filter_dims,
+                                                                 const int8_t *filter_data,
+                                                                 const int32_t *bias,
+                                                                 const data_dims_t *output_dims,
+                                                                 const conv_params_t *conv_params,
+                                                                 const quant_data_t *quant_data)
+{
+    return esp_nn_transpose_conv_prepared_init(blob, input_dims, filter_dims, filter_data, bias,
+                                               output_dims, conv_params, quant_data);
+}
+
+void esp_nn_transpose_conv_s8_run_esp32s3(const esp_nn_ctx_t *ctx,
+                                          const esp_nn_conv_prepared_t *prep,
+                                          const int8_t *input_data,
+                                          int8_t *out_data)
+{
+    (void) ctx;
+    esp_nn_transpose_conv_s8_gather(&prep->input_dims, input_data, &prep->filter_dims, prep->filter,
+                                    prep->bias, &prep->output_dims, out_data, &prep->conv_params,
+                                    &prep->quant_data, prep->offset_acc, esp_nn_dot_s8_aligned_esp32s3);
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include "transpose_conv_common.h"
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_prepared_init(void *blob,
+                                                            const data_dims_t *input_dims,
+                                                            const data_dims_t *filter_dims,
+                                                            const int8_t *filter_data,
+                                                            const int32_t *bias,
+                                                            const data_dims_t *output_dims,
+                                                            const conv_params_t *conv_params,
+                                                            const quant_data_t *quant_data)
+{
+    esp_nn_conv_prepared_t *prep = esp_nn_conv_prepared_init(blob, input_dims, filter_dims, filter_data,
+                                                             bias, output_dims, conv_params, quant_data);
+    if (prep == NULL) {
+        return NULL;
+    }
+    prep->offset_acc = esp_nn_transpose_conv_fold_taps(
+        input_dims, filter_dims, filter_data, output_dims, conv_params->in_offset,
+        (int32_t *) ((int8_t *) blob + ESP_NN_CONV_PREPARED_HDR_SIZE(output_dims->channels)));
+    return prep;
+}
+
+void esp_nn_transpose_conv_s8_gather(const data_dims_t *input_dims,
+                                     const int8_t *input_data,
+                                     const data_dims_t *filter_dims,
+                                     const int8_t *filter_data,
+                                     const int32_t *bias,
+                                     const data_dims_t *output_dims,
+                                     int8_t *out_data,
+                                     const conv_params_t *conv_params,
+                                     const quant_plan_data_t *quant_data,
+                                     const int32_t *tap_offsets,
+                                     esp_nn_dot_s8_fn_t dot)
+{
+    const int32_t input_wd = input_dims->width;
+    const int32_t input_ht = input_dims->height;
+    const int32_t in_channels = input_dims->channels;
+    const int32_t out_offset = conv_params->out_offset;
+    const int32_t pad_wd = conv_params->padding.width;
+    const int32_t pad_ht = conv_params->padding.height;
+    const int32_t stride_wd = conv_params->stride.width;
+    const int32_t stride_ht = conv_params->stride.height;
+    const int32_t filter_wd = filter_dims->width;
+    const int32_t filter_ht = filter_dims->height;
+    const int32_t out_wd = output_dims->width;
+    const int32_t out_ht = output_dims->height;
+    const int32_t out_channels = output_dims->channels;
+    const int32_t activation_min = conv_params->activation.min;
+    const int32_t activation_max = conv_params->activation.max;
+
+    if (tap_offsets == NULL) {
+        printf("esp_nn_transpose_conv error! scratch_buffer not set!\n");
+        return;
+    }
+    if (dot && ((in_channels & 15) || ((uintptr_t) input_data & 15) || ((uintptr_t) filter_data & 15))) {
+        dot = NULL;
+    }
+    const int32_t batches = esp_nn_batches(input_dims);
+    const int32_t input_size = input_wd * input_ht * in_channels;
+
+    for (int32_t batch = 0; batch < batches; batch++, input_data += input_size) {
+        for (int32_t out_y = 0; out_y < out_ht; out_y++) {
+            const int32_t pos_y = out_y + pad_ht;
+            /* first filter row with an input row at or above the last one */
+            int32_t fy_start = pos_y % stride_ht;
+            const int32_t rows_below = pos_y - fy_start - (input_ht - 1) * stride_ht;
+            if (rows_below > 0) {
+                fy_start += (rows_below + stride_ht - 1) / stride_ht * stride_ht;
+            }
+            const int32_t fy_end = min(filter_ht, pos_y + 1);
+
+            for (int32_t out_x = 0; out_x < out_wd; out_x++) {
+                const int32_t pos_x = out_x + pad_wd;
+                int32_t fx_start = pos_x % stride_wd;
+                const int32_t cols_right = pos_x - fx_start - (input_wd - 1) * stride_wd;
+                if (cols_right > 0) {
+                    fx_start += (cols_right + stride_wd - 1) / stride_wd * stride_wd;
+                }
+                const int32_t fx_end = min(filter_wd, pos_x + 1);
+
+                for (int32_t out_ch = 0; out_ch < out_channels; out_ch++) {
+                    int32_t acc = 0;
+                    for (int32_t fy = fy_start; fy < fy_end; fy += stride_ht) {
+                        const int32_t in_y = (pos_y - fy) / stride_ht;
+                        for (int32_t fx = fx_start; fx < fx_end; fx += stride_wd) {
+                            const int32_t in_x = (pos_x - fx) / stride_wd;
+                            const int32_t tap = (out_ch * filter_ht + fy) * filter_wd + fx;
+                            const int8_t *in_ptr = input_data + (in_y * input_wd + in_x) * in_channels;
+                            const int8_t *filter_ptr = filter_data + tap * in_channels;
+                            if (dot) {
+                                acc += dot(in_ptr, filter_ptr, in_channels);
+                            } else {
+                                for (int32_t i = 0; i < in_channels; i++) {
+                                    acc += in_ptr[i] * filter_ptr[i];
+                                }
+                            }
+                            acc += tap_offsets[tap];
+                        }
+                    }
+                    if (bias) {
+                        acc += bias[out_ch];
+                    }
+                    acc = esp_nn_requantize_ch(acc, quant_data, out_ch);
+                    acc += out_offset;
+                    acc = max(acc, activation_min);
+                    acc = min(acc, activation_max);
+                    *out_data++ = (int8_t) acc;
+                }
+            }
+        }
+    }
+}
+
+int32_t esp_nn_get_transpose_conv_scratch_size_opt(const data_dims_t *input_dims,
+                                                   const data_dims_t *filter_dims,
+                                                   const data_dims_t *output_dims,
+                                                   const conv_params_t *conv_params)
+{
+    return ESP_NN_TRANSPOSE_CONV_SCRATCH_SIZE(filter_dims, output_dims->channels);
+}
+
+void esp_nn_transpose_conv_s8_opt(const esp_nn_ctx_t *ctx,
+                                  const data_dims_t *input_dims,
+                                  const int8_t *input_data,
+                                  const data_dims_t *filter_dims,
+                                  const int8_t *filter_data,
+                                  const int32_t *bias,
+                                  const data_dims_t *output_dims,
+                                  int8_t *out_data,
+                                  const conv_params_t *conv_params,
+                                  const quant_data_t *quant_data)
+{
+    const quant_plan_data_t no_plan = esp_nn_quant_no_plan(quant_data);
+    const int32_t *tap_offsets = esp_nn_transpose_conv_fold_taps(input_dims, filter_dims, filter_data,
+                                                                 output_dims, conv_params->in_offset,
+                                                                 (int32_t *) ctx->scratch);
+    esp_nn_transpose_conv_s8_gather(input_dims, input_data, filter_dims, filter_data, bias,
+                                    output_dims, out_data, conv_params, &no_plan,
+                                    tap_offsets, NULL);
+}
+
+/* The tap terms are folded into the blob, run needs no scratch */
+int32_t esp_nn_get_transpose_conv_prepared_size_opt(const data_dims_t *input_dims,
+                                                    const data_dims_t *filter_dims,
+                                                    const data_dims_t *output_dims,
+                                                    const conv_params_t *conv_params)
+{
+    return ESP_NN_TRANSPOSE_CONV_PREPARED_SIZE(filter_dims, output_dims->channels);
+}
+
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_s8_prepare_opt(void *blob,
+                                                             const data_dims_t *input_dims,
+                                                             const data_dims_t *filter_dims,
+                                                             const int8_t *filter_data,
+                                                             const int32_t *bias,
+                                                             const data_dims_t *output_dims,
+                                                             const conv_params_t *conv_params,
+                                                             const quant_data_t *quant_data)
+{
+    return esp_nn_transpose_conv_prepared_init(blob, input_dims, filter_dims, filter_data, bias,
+                                               output_dims, conv_params, quant_data);
+}
+
+void esp_nn_transpose_conv_s8_run_opt(const esp_nn_ctx_t *ctx,
+                                      const esp_nn_conv_prepared_t *prep,
+                                      const int8_t *input_data,
+                                      int8_t *out_data)
+{
+    (void) ctx;
+    esp_nn_transpose_conv_s8_gather(&prep->input_dims, input_data, &prep->filter_dims, prep->filter,
+                                    prep->bias, &prep->output_dims, out_data, &prep->conv_params,
+                                    &prep->quant_data, prep->offset_acc, NULL);
+}
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <esp_nn_defs.h>
+#include <common_functions.h>
+
+/**
+ * @brief       prepared transpose conv: the conv header, with the tap terms of
+ *              esp_nn_transpose_conv_fold_taps built once after it as `offset_acc`
+ *
+ * @return      the header, NULL if `blob` is not 16 byte aligned
+ */
+esp_nn_conv_prepared_t *esp_nn_transpose_conv_prepared_init(void *blob,
+                                                            const data_dims_t *input_dims,
+                                                            const data_dims_t *filter_dims,
+                                                            const int8_t *filter_data,
+                                                            const int32_t *bias,
+                                                            const data_dims_t *output_dims,
+                                                            const conv_params_t *conv_params,
+                                                            const quant_data_t *quant_data);
+
+/**
+ * @brief       output stationary transpose conv, no scatter and no zero insertion
+ *
+ * @note        output row oy takes filter rows fy = (oy + pad) % stride, + stride, ..
+ *              with input row (oy + pad - fy) / stride, when it exists, and the same
+ *              along x. Each tap is a dot product over the input channels, contiguous
+ *              in the input pixel and in the filter. The input offset is added through
+ *              the terms of the taps taken, from esp_nn_transpose_conv_fold_taps.
+ *              `dot` (may be NULL) runs the taps when the channels are a multiple of 16
+ *              and the input and filter are 16 byte aligned, so every run is.
+ */
+void esp_nn_transpose_conv_s8_gather(const data_dims_t *input_dims,
+                                     const int8_t *input_data,
+                                     const data_dims_t *filter_dims,
+                                     const int8_t *filter_data,
+                                     const int32_t *bias,
+                                     const data_dims_t *output_dims,
+                                     int8_t *out_data,
+                                     const conv_params_t *conv_params,
+                                     const quant_plan_data_t *quant_data,
+                                     const int32_t *tap_offsets,
+                                     esp_nn_dot_s8_fn_t dot);
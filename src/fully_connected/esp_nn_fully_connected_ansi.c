@@ -30,6 +30,8 @@ void esp_nn_fully_connected_s8_ansi(const int8_t *input_data,
                                     const int32_t activation_min,
                                     const int32_t activation_max)
 {
+    const esp_nn_requant_t requant = esp_nn_requant_entry(out_mult, out_shift);
+
     for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
         int32_t result = 0;
         for (int32_t data_idx = 0; data_idx < row_len; data_idx++) {
@@ -41,7 +43,7 @@ void esp_nn_fully_connected_s8_ansi(const int8_t *input_data,
         if (bias) {
             result += bias[out_c];
         }
-        result = esp_nn_multiply_by_quantized_mult(result, out_mult, out_shift);
+        result = esp_nn_requant_apply(result, &requant);
         result += out_offset;
         result = max(result, activation_min);
         result = min(result, activation_max);
@@ -81,3 +83,469 @@ void esp_nn_fully_connected_per_ch_s8_ansi(const int8_t *input_data,
         out_data[out_c] = (int8_t) result;
     }
 }
+
+/* channels sharing the input loads in the interleaved layout */
+#define FC_INTERLEAVE   4
+
+static int32_t fc_packed_size(const uint16_t row_len, const uint16_t out_channels,
+                              const esp_nn_fc_layout_t layout)
+{
+    const int32_t row_stride = (row_len + 15) & ~15;
+    int32_t rows = out_channels;
+    if (layout == ESP_NN_FC_LAYOUT_INTERLEAVED) {
+        rows = (out_channels + FC_INTERLEAVE - 1) / FC_INTERLEAVE * FC_INTERLEAVE;
+    }
+    return rows * row_stride;
+}
+
+int32_t esp_nn_get_fully_connected_prepared_size_ansi(const uint16_t row_len,
+                                                      const uint16_t out_channels,
+                                                      const esp_nn_fc_layout_t layout)
+{
+    return ESP_NN_PREPARED_HDR_SIZE(esp_nn_fc_prepared_t) +
+           ((out_channels * (int32_t) sizeof(int32_t) + 15) & ~15) +
+           ((esp_nn_get_requant_plan_size(out_channels) + 15) & ~15) +
+           fc_packed_size(row_len, out_channels, layout);
+}
+
+static esp_nn_fc_prepared_t *fc_prepare(void *blob,
+                                        const esp_nn_fc_layout_t layout,
+                                        const int32_t input_offset,
+                                        const uint16_t row_len,
+                                        const int8_t *filter_data,
+                                        const int32_t filter_offset,
+                                        const int32_t *bias,
+                                        const uint16_t out_channels,
+                                        const int32_t out_offset,
+                                        const int32_t out_shift,
+                                        const int32_t out_mult,
+                                        const int32_t *out_shifts,
+                                        const int32_t *out_mults,
+                                        const int32_t activation_min,
+                                        const int32_t activation_max)
+{
+    esp_nn_fc_prepared_t *prep = (esp_nn_fc_prepared_t *) blob;
+    if (prep == NULL || ((uintptr_t) blob & 15)) {
+        return NULL;
+    }
+    const int32_t row_stride = (row_len + 15) & ~15;
+    int32_t *corrections = (int32_t *) ((int8_t *) blob + ESP_NN_PREPARED_HDR_SIZE(esp_nn_fc_prepared_t));
+    esp_nn_requant_t *requant = (esp_nn_requant_t *) ((int8_t *) corrections +
+                                                      ((out_channels * (int32_t) sizeof(int32_t) + 15) & ~15));
+    int8_t *packed = (int8_t *) requant + ((esp_nn_get_requant_plan_size(out_channels) + 15) & ~15);
+
+    *prep = (esp_nn_fc_prepared_t) {
+        .row_len = row_len, .out_channels = out_channels,
+        .input_offset = input_offset, .filter_offset = filter_offset, .out_offset = out_offset,
+        .out_shift = out_shift, .out_mult = out_mult,
+        .out_shifts = out_shifts, .out_mults = out_mults,
+        .activation = {activation_min, activation_max},
+        .filter = filter_data, .bias = bias,
+        .packed_filter = NULL, .corrections = NULL, .requant = requant,
+        .row_stride = row_stride, .layout = layout,
+    };
+
+    /* per tensor quantisation is replicated, the run loops index it by channel */
+    for (int32_t ch = 0; ch < out_channels; ch++) {
+        requant[ch] = out_mults ? esp_nn_requant_entry(out_mults[ch], out_shifts[ch])
+                                : esp_nn_requant_entry(out_mult, out_shift);
+    }
+
+    /* with a filter offset the input dependent term can't be folded: run unprepared */
+    if (filter_offset != 0) {
+        return prep;
+    }
+    esp_nn_conv_fold_offset(filter_data, row_len, out_channels, input_offset, bias, corrections);
+    prep->corrections = corrections;
+
+    if (layout == ESP_NN_FC_LAYOUT_INTERLEAVED) {
+        /* per group of 4 channels: block 0 of ch 0..3, block 1 of ch 0..3, .. */
+        memset(packed, 0, fc_packed_size(row_len, out_channels, layout));
+        for (int32_t ch = 0; ch < out_channels; ch++) {
+            const int8_t *src = filter_data + ch * row_len;
+            int8_t *dst = packed + (ch / FC_INTERLEAVE) * FC_INTERLEAVE * row_stride +
+                          (ch % FC_INTERLEAVE) * 16;
+            for (int32_t idx = 0; idx < row_len; idx += 16) {
+                memcpy(dst, src + idx, min(16, row_len - idx));
+                dst += FC_INTERLEAVE * 16;
+            }
+        }
+        prep->packed_filter = packed;
+    } else if (row_stride != row_len || ((uintptr_t) filter_data & 15)) {
+        for (int32_t ch = 0; ch < out_channels; ch++) {
+            memcpy(packed + ch * row_stride, filter_data + ch * row_len, row_len);
+            memset(packed + ch * row_stride + row_len, 0, row_stride - row_len);
+        }
+        prep->packed_filter = packed;
+    } else {
+        prep->packed_filter = filter_data;
+    }
+    return prep;
+}
+
+esp_nn_fc_prepared_t *esp_nn_fully_connected_s8_prepare_ansi(void *blob,
+                                                             const esp_nn_fc_layout_t layout,
+                                                             const int32_t input_offset,
+                                                             const uint16_t row_len,
+                                                             const int8_t *filter_data,
+                                                             const int32_t filter_offset,
+                                                             const int32_t *bias,
+                                                             const uint16_t out_channels,
+                                                             const int32_t out_offset,
+                                                             const int32_t out_shift,
+                                                             const int32_t out_mult,
+                                                             const int32_t activation_min,
+                                                             const int32_t activation_max)
+{
+    return fc_prepare(blob, layout, input_offset, row_len, filter_data, filter_offset, bias,
+                      out_channels, out_offset, out_shift, out_mult, NULL, NULL,
+                      activation_min, activation_max);
+}
+
+esp_nn_fc_prepared_t *esp_nn_fully_connected_per_ch_s8_prepare_ansi(void *blob,
+                                                                    const esp_nn_fc_layout_t layout,
+                                                                    const int32_t input_offset,
+                                                                    const uint16_t row_len,
+                                                                    const int8_t *filter_data,
+                                                                    const int32_t filter_offset,
+                                                                    const int32_t *bias,
+                                                                    const uint16_t out_channels,
+                                                                    const int32_t out_offset,
+                                                                    const int32_t *out_shift,
+                                                                    const int32_t *out_mult,
+                                                                    const int32_t activation_min,
+                                                                    const int32_t activation_max)
+{
+    return fc_prepare(blob, layout, input_offset, row_len, filter_data, filter_offset, bias,
+                      out_channels, out_offset, 0, 0, out_shift, out_mult,
+                      activation_min, activation_max);
+}
+
+static inline int8_t fc_prepared_out(const esp_nn_fc_prepared_t *prep, const int32_t ch, int32_t acc)
+{
+    acc += prep->corrections[ch];
+    acc = esp_nn_requant_apply(acc, &prep->requant[ch]);
+    acc += prep->out_offset;
+    acc = max(acc, prep->activation.min);
+    acc = min(acc, prep->activation.max);
+    return (int8_t) acc;
+}
+
+void esp_nn_fully_connected_s8_run_ansi(const esp_nn_fc_prepared_t *prep,
+                                        const int8_t *input_data,
+                                        int8_t *out_data)
+{
+    const int32_t row_len = prep->row_len;
+    const int32_t out_channels = prep->out_channels;
+
+    if (prep->corrections == NULL) {
+        if (prep->out_mults) {
+            esp_nn_fully_connected_per_ch_s8_ansi(input_data, prep->input_offset, row_len,
+                                                  prep->filter, prep->filter_offset, prep->bias,
+                                                  out_data, out_channels, prep->out_offset,
+                                                  prep->out_shifts, prep->out_mults,
+                                                  prep->activation.min, prep->activation.max);
+        } else {
+            esp_nn_fully_connected_s8_ansi(input_data, prep->input_offset, row_len,
+                                           prep->filter, prep->filter_offset, prep->bias,
+                                           out_data, out_channels, prep->out_offset,
+                                           prep->out_shift, prep->out_mult,
+                                           prep->activation.min, prep->activation.max);
+        }
+        return;
+    }
+
+    if (prep->layout == ESP_NN_FC_LAYOUT_INTERLEAVED) {
+        for (int32_t ch = 0; ch < out_channels; ch += FC_INTERLEAVE) {
+            const int8_t *block = prep->packed_filter + ch * prep->row_stride;
+            int32_t acc[FC_INTERLEAVE] = {0};
+            for (int32_t idx = 0; idx < row_len; idx += 16) {
+                const int32_t len = min(16, row_len - idx);
+                for (int32_t i = 0; i < len; i++) {
+                    const int32_t input_val = input_data[idx + i];
+                    acc[0] += input_val * block[i];
+                    acc[1] += input_val * block[16 + i];
+                    acc[2] += input_val * block[32 + i];
+                    acc[3] += input_val * block[48 + i];
+                }
+                block += FC_INTERLEAVE * 16;
+            }
+            for (int32_t k = 0; k < FC_INTERLEAVE && ch + k < out_channels; k++) {
+                out_data[ch + k] = fc_prepared_out(prep, ch + k, acc[k]);
+            }
+        }
+        return;
+    }
+
+    for (int32_t ch = 0; ch < out_channels; ch++) {
+        const int8_t *filter_row = prep->packed_filter + ch * prep->row_stride;
+        int32_t acc = 0;
+        for (int32_t idx = 0; idx < row_len; idx++) {
+            acc += input_data[idx] * filter_row[idx];
+        }
+        out_data[ch] = fc_prepared_out(prep, ch, acc);
+    }
+}
+
+void esp_nn_fully_connected_s8_run_batch_ansi(const esp_nn_fc_prepared_t *prep,
+                                              const int32_t batches,
+                                              const int8_t *input_data,
+                                              int8_t *out_data)
+{
+    const int32_t row_len = prep->row_len;
+    const int32_t out_channels = prep->out_channels;
+
+    if (prep->corrections == NULL || prep->layout != ESP_NN_FC_LAYOUT_ROWS) {
+        for (int32_t batch = 0; batch < batches; batch++) {
+            esp_nn_fully_connected_s8_run_ansi(prep, input_data + batch * row_len,
+                                               out_data + batch * out_channels);
+        }
+        return;
+    }
+
+    /* channel outer: each packed row is read once for the whole batch */
+    for (int32_t ch = 0; ch < out_channels; ch++) {
+        const int8_t *filter_row = prep->packed_filter + ch * prep->row_stride;
+        for (int32_t batch = 0; batch < batches; batch++) {
+            const int8_t *input = input_data + batch * row_len;
+            int32_t acc = 0;
+            for (int32_t idx = 0; idx < row_len; idx++) {
+                acc += input[idx] * filter_row[idx];
+            }
+            out_data[batch * out_channels + ch] = fc_prepared_out(prep, ch, acc);
+        }
+    }
+}
+
+/* 16x8: int16 activations, int8 weights, int64 accumulators and bias */
+void esp_nn_fully_connected_s16_ansi(const int16_t *input_data,
+                                     const uint16_t row_len,
+                                     const int8_t *filter_data,
+                                     const int64_t *bias,
+                                     int16_t *out_data,
+                                     const uint16_t out_channels,
+                                     const int32_t out_offset,
+                                     const int32_t out_shift,
+                                     const int32_t out_mult,
+                                     const int32_t activation_min,
+                                     const int32_t activation_max)
+{
+    for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
+        int64_t acc = 0;
+        for (int32_t data_idx = 0; data_idx < row_len; data_idx++) {
+            acc += (int64_t) input_data[data_idx] * filter_data[row_len * out_c + data_idx];
+        }
+        if (bias) {
+            acc += bias[out_c];
+        }
+        int32_t result = esp_nn_multiply_by_quantized_mult_s64(acc, out_mult, out_shift);
+        result += out_offset;
+        result = max(result, activation_min);
+        result = min(result, activation_max);
+        out_data[out_c] = (int16_t) result;
+    }
+}
+
+/* int4 weights, packed as in esp_nn_s4.h: one packed row per output channel */
+void esp_nn_fully_connected_per_ch_s4_ansi(const int8_t *input_data,
+                                           const int32_t input_offset,
+                                           const uint16_t row_len,
+                                           const int8_t *filter_data,
+                                           const int32_t *bias,
+                                           int8_t *out_data,
+                                           const uint16_t out_channels,
+                                           const int32_t out_offset,
+                                           const int32_t *out_shift,
+                                           const int32_t *out_mult,
+                                           const int32_t activation_min,
+                                           const int32_t activation_max)
+{
+    const int32_t row_size = esp_nn_get_s4_row_size(row_len);
+
+    for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
+        const int8_t *row = filter_data + out_c * row_size;
+        int32_t result = 0;
+        for (int32_t data_idx = 0; data_idx < row_len; data_idx++) {
+            result += (input_data[data_idx] + input_offset) * esp_nn_s4_weight(row, data_idx);
+        }
+        if (bias) {
+            result += bias[out_c];
+        }
+        result = esp_nn_multiply_by_quantized_mult(result, out_mult[out_c], out_shift[out_c]);
+        result += out_offset;
+        result = max(result, activation_min);
+        result = min(result, activation_max);
+        out_data[out_c] = (int8_t) result;
+    }
+}
+
+static int32_t fc_sparse_blocks(const int8_t *filter_data, const uint16_t row_len,
+                                const uint16_t out_channels, int32_t *row_blocks,
+                                uint16_t *block_cols, int8_t *values)
+{
+    int32_t blocks = 0;
+
+    for (int32_t ch = 0; ch < out_channels; ch++) {
+        const int8_t *row = filter_data + ch * row_len;
+        if (row_blocks) {
+            row_blocks[ch] = blocks;
+        }
+        for (int32_t idx = 0; idx < row_len; idx += ESP_NN_FC_SPARSE_BLOCK) {
+            const int32_t len = min(ESP_NN_FC_SPARSE_BLOCK, row_len - idx);
+            int32_t i = 0;
+            while (i < len && row[idx + i] == 0) {
+                i++;
+            }
+            if (i == len) {
+                continue;
+            }
+            if (values) {
+                block_cols[blocks] = idx / ESP_NN_FC_SPARSE_BLOCK;
+                memset(values + blocks * ESP_NN_FC_SPARSE_BLOCK, 0, ESP_NN_FC_SPARSE_BLOCK);
+                memcpy(values + blocks * ESP_NN_FC_SPARSE_BLOCK, row + idx, len);
+            }
+            blocks++;
+        }
+    }
+    if (row_blocks) {
+        row_blocks[out_channels] = blocks;
+    }
+    return blocks;
+}
+
+/* header, row_blocks, block_cols, values, corrections, requant: each 16 byte aligned */
+static void fc_sparse_layout(esp_nn_fc_sparse_t *sparse, const int32_t blocks)
+{
+    const int32_t out_channels = sparse->out_channels;
+    int32_t offset = ESP_NN_PREPARED_HDR_SIZE(esp_nn_fc_sparse_t);
+
+    sparse->blocks = blocks;
+    sparse->row_blocks_offset = offset;
+    offset += ((out_channels + 1) * (int32_t) sizeof(int32_t) + 15) & ~15;
+    sparse->block_cols_offset = offset;
+    offset += (blocks * (int32_t) sizeof(uint16_t) + 15) & ~15;
+    sparse->values_offset = offset;
+    offset += blocks * ESP_NN_FC_SPARSE_BLOCK;
+    sparse->corrections_offset = offset;
+    offset += (out_channels * (int32_t) sizeof(int32_t) + 15) & ~15;
+    sparse->requant_offset = offset;
+    offset += (esp_nn_get_requant_plan_size(out_channels) + 15) & ~15;
+    sparse->size = offset;
+}
+
+int32_t esp_nn_get_fully_connected_sparse_size_ansi(const int8_t *filter_data,
+                                                    const uint16_t row_len,
+                                                    const uint16_t out_channels)
+{
+    esp_nn_fc_sparse_t sparse = {.row_len = row_len, .out_channels = out_channels};
+    fc_sparse_layout(&sparse, fc_sparse_blocks(filter_data, row_len, out_channels,
+                                               NULL, NULL, NULL));
+    return sparse.size;
+}
+
+static esp_nn_fc_sparse_t *fc_sparse_pack(void *blob,
+                                          const int32_t input_offset,
+                                          const uint16_t row_len,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          const uint16_t out_channels,
+                                          const int32_t out_offset,
+                                          const int32_t out_shift,
+                                          const int32_t out_mult,
+                                          const int32_t *out_shifts,
+                                          const int32_t *out_mults,
+                                          const int32_t activation_min,
+                                          const int32_t activation_max)
+{
+    esp_nn_fc_sparse_t *sparse = (esp_nn_fc_sparse_t *) blob;
+    if (sparse == NULL || ((uintptr_t) blob & 15)) {
+        return NULL;
+    }
+    *sparse = (esp_nn_fc_sparse_t) {
+        .row_len = row_len, .out_channels = out_channels, .out_offset = out_offset,
+        .activation = {activation_min, activation_max},
+    };
+    fc_sparse_layout(sparse, fc_sparse_blocks(filter_data, row_len, out_channels,
+                                              NULL, NULL, NULL));
+
+    int8_t *base = (int8_t *) blob;
+    int32_t *corrections = (int32_t *) (base + sparse->corrections_offset);
+    esp_nn_requant_t *requant = (esp_nn_requant_t *) (base + sparse->requant_offset);
+
+    fc_sparse_blocks(filter_data, row_len, out_channels,
+                     (int32_t *) (base + sparse->row_blocks_offset),
+                     (uint16_t *) (base + sparse->block_cols_offset),
+                     base + sparse->values_offset);
+    /* dropped blocks are zero: the sum over the full rows is the sum over the kept ones */
+    esp_nn_conv_fold_offset(filter_data, row_len, out_channels, input_offset, bias, corrections);
+    for (int32_t ch = 0; ch < out_channels; ch++) {
+        requant[ch] = out_mults ? esp_nn_requant_entry(out_mults[ch], out_shifts[ch])
+                                : esp_nn_requant_entry(out_mult, out_shift);
+    }
+    return sparse;
+}
+
+esp_nn_fc_sparse_t *esp_nn_fully_connected_s8_sparse_pack_ansi(void *blob,
+                                                               const int32_t input_offset,
+                                                               const uint16_t row_len,
+                                                               const int8_t *filter_data,
+                                                               const int32_t *bias,
+                                                               const uint16_t out_channels,
+                                                               const int32_t out_offset,
+                                                               const int32_t out_shift,
+                                                               const int32_t out_mult,
+                                                               const int32_t activation_min,
+                                                               const int32_t activation_max)
+{
+    return fc_sparse_pack(blob, input_offset, row_len, filter_data, bias, out_channels,
+                          out_offset, out_shift, out_mult, NULL, NULL,
+                          activation_min, activation_max);
+}
+
+esp_nn_fc_sparse_t *esp_nn_fully_connected_per_ch_s8_sparse_pack_ansi(void *blob,
+                                                                      const int32_t input_offset,
+                                                                      const uint16_t row_len,
+                                                                      const int8_t *filter_data,
+                                                                      const int32_t *bias,
+                                                                      const uint16_t out_channels,
+                                                                      const int32_t out_offset,
+                                                                      const int32_t *out_shift,
+                                                                      const int32_t *out_mult,
+                                                                      const int32_t activation_min,
+                                                                      const int32_t activation_max)
+{
+    return fc_sparse_pack(blob, input_offset, row_len, filter_data, bias, out_channels,
+                          out_offset, 0, 0, out_shift, out_mult,
+                          activation_min, activation_max);
+}
+
+void esp_nn_fully_connected_s8_sparse_run_ansi(const esp_nn_fc_sparse_t *sparse,
+                                               const int8_t *input_data,
+                                               int8_t *out_data)
+{
+    const int8_t *base = (const int8_t *) sparse;
+    const int32_t *row_blocks = (const int32_t *) (base + sparse->row_blocks_offset);
+    const uint16_t *block_cols = (const uint16_t *) (base + sparse->block_cols_offset);
+    const int8_t *values = base + sparse->values_offset;
+    const int32_t *corrections = (const int32_t *) (base + sparse->corrections_offset);
+    const esp_nn_requant_t *requant = (const esp_nn_requant_t *) (base + sparse->requant_offset);
+    const int32_t row_len = sparse->row_len;
+
+    for (int32_t ch = 0; ch < sparse->out_channels; ch++) {
+        int32_t acc = 0;
+        for (int32_t blk = row_blocks[ch]; blk < row_blocks[ch + 1]; blk++) {
+            const int32_t idx = block_cols[blk] * ESP_NN_FC_SPARSE_BLOCK;
+            const int32_t len = min(ESP_NN_FC_SPARSE_BLOCK, row_len - idx);
+            const int8_t *weights = values + blk * ESP_NN_FC_SPARSE_BLOCK;
+            for (int32_t i = 0; i < len; i++) {
+                acc += input_data[idx + i] * weights[i];
+            }
+        }
+        acc += corrections[ch];
+        acc = esp_nn_requant_apply(acc, &requant[ch]);
+        acc += sparse->out_offset;
+        acc = max(acc, sparse->activation.min);
+        acc = min(acc, sparse->activation.max);
+        out_data[ch] = (int8_t) acc;
+    }
+}
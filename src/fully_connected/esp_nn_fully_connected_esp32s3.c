@@ -6,7 +6,7 @@
 
 /*
  * FC multi-path dispatcher for ESP32-S3.
- * - Pre-computes offset corrections per channel in C
+ * - Folds offset corrections per channel in C, or takes them from a prepared layer
  * - Dispatches to s8 MAC assembly (aligned, large row_len) or s16 assembly (fallback)
  */
 
@@ -49,6 +49,37 @@ extern int32_t esp_nn_dot_s8_unaligned_esp32s3(const int8_t *a,
                                                 const int8_t *b,
                                                 int32_t len_div16);
 
+/* Generic prepared run, for layouts the SIMD loop doesn't take */
+extern void esp_nn_fully_connected_s8_run_ansi(const esp_nn_fc_prepared_t *prep,
+                                               const int8_t *input_data,
+                                               int8_t *out_data);
+extern void esp_nn_fully_connected_s8_run_batch_ansi(const esp_nn_fc_prepared_t *prep,
+                                                     const int32_t batches,
+                                                     const int8_t *input_data,
+                                                     int8_t *out_data);
+
+/**
+ * filter_sum * input_offset + bias of one channel, folded per row so stack use
+ * doesn't grow with out_channels. Prepared layers have these precomputed.
+ */
+static inline int32_t fc_correction(const int8_t *f_ptr, const int32_t row_len,
+                                    const int32_t input_offset, const int32_t *bias,
+                                    const int ch)
+{
+    int32_t corr = 0;
+    if (input_offset != 0) {
+        int32_t filter_sum = 0;
+        for (int i = 0; i < row_len; i++) {
+            filter_sum += f_ptr[i];
+        }
+        corr = filter_sum * input_offset;
+    }
+    if (bias) {
+        corr += bias[ch];
+    }
+    return corr;
+}
+
 void esp_nn_fully_connected_s8_esp32s3(const int8_t *input_data,
                                        const int32_t input_offset,
                                        const uint16_t row_len,
@@ -67,33 +98,18 @@ void esp_nn_fully_connected_s8_esp32s3(const int8_t *input_data,
     if (__builtin_expect(filter_offset != 0 || row_len < 16
         || ((uintptr_t)input_data & 15), 0)) {
         /* Fallback to original s16 assembly — tail call, no extra overhead */
-        esp_nn_fc_s16_esp32s3(input_data, input_offset, row_len, filter_data,
-                              filter_offset, bias, out_data, out_channels,
-                              out_offset, out_shift, out_mult,
-                              activation_min, activation_max);
+        ESP_NN_PATH_CALL(ESP_NN_PATH_FC_S16,
+                         esp_nn_fc_s16_esp32s3(input_data, input_offset, row_len, filter_data,
+                                               filter_offset, bias, out_data, out_channels,
+                                               out_offset, out_shift, out_mult,
+                                               activation_min, activation_max));
         return;
     }
     {
+        ESP_NN_PATH_TIMER_START(t_s8);
+        const esp_nn_requant_t requant = esp_nn_requant_entry(out_mult, out_shift);
         int32_t row_len_div16 = row_len >> 4;
 
-        /* Pre-compute per-channel corrections once */
-        int32_t corrections[out_channels];
-        for (int ch = 0; ch < out_channels; ch++) {
-            const int8_t *f_ptr = filter_data + ch * row_len;
-            int32_t corr = 0;
-            if (input_offset != 0) {
-                int32_t filter_sum = 0;
-                for (int i = 0; i < row_len; i++) {
-                    filter_sum += f_ptr[i];
-                }
-                corr = filter_sum * input_offset;
-            }
-            if (bias) {
-                corr += bias[ch];
-            }
-            corrections[ch] = corr;
-        }
-
         int32_t row_len_rem = row_len & 15;
         int32_t simd_bytes = row_len_div16 << 4;
 
@@ -106,14 +122,15 @@ void esp_nn_fully_connected_s8_esp32s3(const int8_t *input_data,
                 acc += (int32_t)input_data[simd_bytes + i] * (int32_t)f_ptr[simd_bytes + i];
             }
 
-            acc += corrections[ch];
+            acc += fc_correction(f_ptr, row_len, input_offset, bias, ch);
 
-            acc = esp_nn_multiply_by_quantized_mult(acc, out_mult, out_shift);
+            acc = esp_nn_requant_apply(acc, &requant);
             acc += out_offset;
             acc = max(acc, activation_min);
             acc = min(acc, activation_max);
             out_data[ch] = (int8_t)acc;
         }
+        ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_FC_S8, t_s8);
     }
 }
 
@@ -133,33 +150,18 @@ void esp_nn_fully_connected_per_ch_s8_esp32s3(const int8_t *input_data,
 {
     if (__builtin_expect(filter_offset != 0 || row_len < 16
         || ((uintptr_t)input_data & 15), 0)) {
-        esp_nn_fc_per_ch_s16_esp32s3(input_data, input_offset, row_len, filter_data,
-                                     filter_offset, bias, out_data, out_channels,
-                                     out_offset, out_shift, out_mult,
-                                     activation_min, activation_max);
+        ESP_NN_PATH_CALL(ESP_NN_PATH_FC_S16,
+                         esp_nn_fc_per_ch_s16_esp32s3(input_data, input_offset, row_len,
+                                                      filter_data, filter_offset, bias,
+                                                      out_data, out_channels, out_offset,
+                                                      out_shift, out_mult,
+                                                      activation_min, activation_max));
         return;
     }
     {
+        ESP_NN_PATH_TIMER_START(t_s8);
         int32_t row_len_div16 = row_len >> 4;
 
-        /* Pre-compute per-channel corrections once */
-        int32_t corrections[out_channels];
-        for (int ch = 0; ch < out_channels; ch++) {
-            const int8_t *f_ptr = filter_data + ch * row_len;
-            int32_t corr = 0;
-            if (input_offset != 0) {
-                int32_t filter_sum = 0;
-                for (int i = 0; i < row_len; i++) {
-                    filter_sum += f_ptr[i];
-                }
-                corr = filter_sum * input_offset;
-            }
-            if (bias) {
-                corr += bias[ch];
-            }
-            corrections[ch] = corr;
-        }
-
         int32_t row_len_rem = row_len & 15;
         int32_t simd_bytes = row_len_div16 << 4;
 
@@ -171,7 +173,7 @@ void esp_nn_fully_connected_per_ch_s8_esp32s3(const int8_t *input_data,
                 acc += (int32_t)input_data[simd_bytes + i] * (int32_t)f_ptr[simd_bytes + i];
             }
 
-            acc += corrections[ch];
+            acc += fc_correction(f_ptr, row_len, input_offset, bias, ch);
 
             acc = esp_nn_multiply_by_quantized_mult(acc, out_mult[ch], out_shift[ch]);
             acc += out_offset;
@@ -179,5 +181,82 @@ void esp_nn_fully_connected_per_ch_s8_esp32s3(const int8_t *input_data,
             acc = min(acc, activation_max);
             out_data[ch] = (int8_t)acc;
         }
+        ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_FC_S8, t_s8);
+    }
+}
+
+static inline int8_t fc_prepared_out_s3(const esp_nn_fc_prepared_t *prep, const int32_t ch,
+                                        int32_t acc)
+{
+    acc += prep->corrections[ch];
+    acc = esp_nn_requant_apply(acc, &prep->requant[ch]);
+    acc += prep->out_offset;
+    acc = max(acc, prep->activation.min);
+    acc = min(acc, prep->activation.max);
+    return (int8_t)acc;
+}
+
+void esp_nn_fully_connected_s8_run_esp32s3(const esp_nn_fc_prepared_t *prep,
+                                           const int8_t *input_data,
+                                           int8_t *out_data)
+{
+    const int32_t row_len = prep->row_len;
+
+    /* aligned SIMD rows only: unfolded, interleaved, short rows or unaligned input take the C run */
+    if (__builtin_expect(prep->corrections == NULL || prep->layout != ESP_NN_FC_LAYOUT_ROWS
+        || row_len < 16 || ((uintptr_t)input_data & 15), 0)) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_FC_PREPARED_C,
+                         esp_nn_fully_connected_s8_run_ansi(prep, input_data, out_data));
+        return;
+    }
+    ESP_NN_PATH_TIMER_START(t_s8);
+    const int32_t simd_bytes = row_len & ~15;
+    const int32_t row_len_rem = row_len & 15;
+    const int8_t *f_ptr = prep->packed_filter;
+
+    for (int ch = 0; ch < prep->out_channels; ch++) {
+        /* packed rows are 16 byte aligned: no USAR realignment per load */
+        int32_t acc = esp_nn_dot_s8_aligned_esp32s3(input_data, f_ptr, simd_bytes);
+        for (int i = 0; i < row_len_rem; i++) {
+            acc += (int32_t)input_data[simd_bytes + i] * (int32_t)f_ptr[simd_bytes + i];
+        }
+        out_data[ch] = fc_prepared_out_s3(prep, ch, acc);
+        f_ptr += prep->row_stride;
+    }
+    ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_FC_PREPARED_S8, t_s8);
+}
+
+void esp_nn_fully_connected_s8_run_batch_esp32s3(const esp_nn_fc_prepared_t *prep,
+                                                 const int32_t batches,
+                                                 const int8_t *input_data,
+                                                 int8_t *out_data)
+{
+    const int32_t row_len = prep->row_len;
+
+    /* as for one image, and every image's input must stay aligned */
+    if (__builtin_expect(prep->corrections == NULL || prep->layout != ESP_NN_FC_LAYOUT_ROWS
+        || row_len < 16 || ((uintptr_t)input_data & 15) || (batches > 1 && (row_len & 15)), 0)) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_FC_PREPARED_C,
+                         esp_nn_fully_connected_s8_run_batch_ansi(prep, batches, input_data,
+                                                                  out_data));
+        return;
+    }
+    ESP_NN_PATH_TIMER_START(t_s8);
+    const int32_t simd_bytes = row_len & ~15;
+    const int32_t row_len_rem = row_len & 15;
+    const int8_t *f_ptr = prep->packed_filter;
+
+    /* channel outer: each packed row stays in cache for the whole batch */
+    for (int ch = 0; ch < prep->out_channels; ch++) {
+        for (int32_t batch = 0; batch < batches; batch++) {
+            const int8_t *input = input_data + batch * row_len;
+            int32_t acc = esp_nn_dot_s8_aligned_esp32s3(input, f_ptr, simd_bytes);
+            for (int i = 0; i < row_len_rem; i++) {
+                acc += (int32_t)input[simd_bytes + i] * (int32_t)f_ptr[simd_bytes + i];
+            }
+            out_data[batch * prep->out_channels + ch] = fc_prepared_out_s3(prep, ch, acc);
+        }
+        f_ptr += prep->row_stride;
     }
+    ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_FC_PREPARED_S8, t_s8);
 }
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <common_functions.h>
+
+/* 16x8: each output is one chunked dot product, int32 inside a chunk */
+void esp_nn_fully_connected_s16_opt(const int16_t *input_data,
+                                    const uint16_t row_len,
+                                    const int8_t *filter_data,
+                                    const int64_t *bias,
+                                    int16_t *out_data,
+                                    const uint16_t out_channels,
+                                    const int32_t out_offset,
+                                    const int32_t out_shift,
+                                    const int32_t out_mult,
+                                    const int32_t activation_min,
+                                    const int32_t activation_max)
+{
+    for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
+        int64_t acc = esp_nn_dot_s16_s8(input_data, filter_data + row_len * out_c, row_len);
+        if (bias) {
+            acc += bias[out_c];
+        }
+        int32_t result = esp_nn_multiply_by_quantized_mult_s64(acc, out_mult, out_shift);
+        result += out_offset;
+        result = max(result, activation_min);
+        result = min(result, activation_max);
+        out_data[out_c] = (int16_t) result;
+    }
+}
+
+/* int4 weights: each row is unpacked a block at a time inside the dot product */
+void esp_nn_fully_connected_per_ch_s4_opt(const int8_t *input_data,
+                                          const int32_t input_offset,
+                                          const uint16_t row_len,
+                                          const int8_t *filter_data,
+                                          const int32_t *bias,
+                                          int8_t *out_data,
+                                          const uint16_t out_channels,
+                                          const int32_t out_offset,
+                                          const int32_t *out_shift,
+                                          const int32_t *out_mult,
+                                          const int32_t activation_min,
+                                          const int32_t activation_max)
+{
+    const int32_t row_size = esp_nn_get_s4_row_size(row_len);
+
+    for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
+        int32_t result = esp_nn_dot_s8_s4(input_data, input_offset, filter_data + out_c * row_size, row_len);
+        if (bias) {
+            result += bias[out_c];
+        }
+        result = esp_nn_multiply_by_quantized_mult(result, out_mult[out_c], out_shift[out_c]);
+        result += out_offset;
+        result = max(result, activation_min);
+        result = min(result, activation_max);
+        out_data[out_c] = (int8_t) result;
+    }
+}
+
+/*
+ * Block sparse: the cost is the kept blocks only. Full blocks take the fixed
+ * 16 MAC loop, the last block of a row may stop at row_len.
+ */
+void esp_nn_fully_connected_s8_sparse_run_opt(const esp_nn_fc_sparse_t *sparse,
+                                              const int8_t *input_data,
+                                              int8_t *out_data)
+{
+    const int8_t *base = (const int8_t *) sparse;
+    const int32_t *row_blocks = (const int32_t *) (base + sparse->row_blocks_offset);
+    const uint16_t *block_cols = (const uint16_t *) (base + sparse->block_cols_offset);
+    const int8_t *weights = base + sparse->values_offset;
+    const int32_t *corrections = (const int32_t *) (base + sparse->corrections_offset);
+    const esp_nn_requant_t *requant = (const esp_nn_requant_t *) (base + sparse->requant_offset);
+    const int32_t row_len = sparse->row_len;
+    const int32_t full_cols = row_len / ESP_NN_FC_SPARSE_BLOCK;
+
+    for (int32_t ch = 0; ch < sparse->out_channels; ch++) {
+        int32_t acc0 = 0, acc1 = 0;
+        const int32_t blk_end = row_blocks[ch + 1];
+        for (int32_t blk = row_blocks[ch]; blk < blk_end; blk++, weights += ESP_NN_FC_SPARSE_BLOCK) {
+            const int32_t col = block_cols[blk];
+            const int8_t *in = input_data + col * ESP_NN_FC_SPARSE_BLOCK;
+            if (col < full_cols) {
+                for (int32_t i = 0; i < ESP_NN_FC_SPARSE_BLOCK; i += 2) {
+                    acc0 += in[i] * weights[i];
+                    acc1 += in[i + 1] * weights[i + 1];
+                }
+            } else {
+                for (int32_t i = 0; i < row_len - col * ESP_NN_FC_SPARSE_BLOCK; i++) {
+                    acc0 += in[i] * weights[i];
+                }
+            }
+        }
+        int32_t result = acc0 + acc1 + corrections[ch];
+        result = esp_nn_requant_apply(result, &requant[ch]);
+        result += sparse->out_offset;
+        result = max(result, sparse->activation.min);
+        result = min(result, sparse->activation.max);
+        out_data[ch] = (int8_t) result;
+    }
+}
@@ -111,6 +111,12 @@ int32_t fc_dot_s8_pie(const int8_t *input, const int8_t *filter, int32_t row_len
     return result;
 }
 
+/* fc_dot_s8_pie behind a call, for the kernels that take their dot product as esp_nn_dot_s8_fn_t */
+int32_t esp_nn_dot_s8_esp32p4(const int8_t *a, const int8_t *b, int32_t len)
+{
+    return fc_dot_s8_pie(a, b, len);
+}
+
 void esp_nn_fully_connected_s8_esp32p4(const int8_t *input_data,
                                         const int32_t input_offset,
                                         const uint16_t row_len,
@@ -133,6 +139,9 @@ void esp_nn_fully_connected_s8_esp32p4(const int8_t *input_data,
         ::: "x29"
     );
 
+    const esp_nn_requant_t requant = esp_nn_requant_entry(out_mult, out_shift);
+
+    ESP_NN_PATH_TIMER_START(t_fc);
     for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
         const int8_t *filter_row = filter_data + (int32_t)row_len * out_c;
 
@@ -152,12 +161,14 @@ void esp_nn_fully_connected_s8_esp32p4(const int8_t *input_data,
         if (bias) {
             result += bias[out_c];
         }
-        result = esp_nn_requantize(result, out_mult, out_shift);
+        result = esp_nn_requantize_plan(result, &requant);
         result += out_offset;
         result = max(result, activation_min);
         result = min(result, activation_max);
         out_data[out_c] = (int8_t) result;
     }
+    ESP_NN_PATH_TIMER_STOP(input_offset == 0 && filter_offset == 0 ?
+                           ESP_NN_PATH_FC_S8 : ESP_NN_PATH_FC_C, t_fc);
 }
 
 void esp_nn_fully_connected_per_ch_s8_esp32p4(const int8_t *input_data,
@@ -182,6 +193,7 @@ void esp_nn_fully_connected_per_ch_s8_esp32p4(const int8_t *input_data,
         ::: "x29"
     );
 
+    ESP_NN_PATH_TIMER_START(t_fc);
     for (int32_t out_c = 0; out_c < out_channels; ++out_c) {
         const int8_t *filter_row = filter_data + (int32_t)row_len * out_c;
 
@@ -205,4 +217,75 @@ void esp_nn_fully_connected_per_ch_s8_esp32p4(const int8_t *input_data,
         result = min(result, activation_max);
         out_data[out_c] = (int8_t) result;
     }
+    ESP_NN_PATH_TIMER_STOP(input_offset == 0 && filter_offset == 0 ?
+                           ESP_NN_PATH_FC_S8 : ESP_NN_PATH_FC_C, t_fc);
+}
+
+/* Generic prepared run, for layouts the PIE loop doesn't take */
+extern void esp_nn_fully_connected_s8_run_ansi(const esp_nn_fc_prepared_t *prep,
+                                               const int8_t *input_data,
+                                               int8_t *out_data);
+extern void esp_nn_fully_connected_s8_run_batch_ansi(const esp_nn_fc_prepared_t *prep,
+                                                     const int32_t batches,
+                                                     const int8_t *input_data,
+                                                     int8_t *out_data);
+
+static inline int8_t fc_prepared_out_p4(const esp_nn_fc_prepared_t *prep, const int32_t out_c,
+                                        int32_t result)
+{
+    result += prep->corrections[out_c];
+    result = esp_nn_requantize_plan(result, &prep->requant[out_c]);
+    result += prep->out_offset;
+    result = max(result, prep->activation.min);
+    result = min(result, prep->activation.max);
+    return (int8_t) result;
+}
+
+void esp_nn_fully_connected_s8_run_esp32p4(const esp_nn_fc_prepared_t *prep,
+                                           const int8_t *input_data,
+                                           int8_t *out_data)
+{
+    if (prep->corrections == NULL || prep->layout != ESP_NN_FC_LAYOUT_ROWS) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_FC_PREPARED_C,
+                         esp_nn_fully_connected_s8_run_ansi(prep, input_data, out_data));
+        return;
+    }
+    ESP_NN_PIE_ENABLE();
+    ESP_NN_PATH_TIMER_START(t_s8);
+
+    /* input_offset is folded into the corrections: PIE path for any offset */
+    const int8_t *filter_row = prep->packed_filter;
+    for (int32_t out_c = 0; out_c < prep->out_channels; ++out_c) {
+        int32_t result = fc_dot_s8_pie(input_data, filter_row, prep->row_len);
+        out_data[out_c] = fc_prepared_out_p4(prep, out_c, result);
+        filter_row += prep->row_stride;
+    }
+    ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_FC_PREPARED_S8, t_s8);
+}
+
+void esp_nn_fully_connected_s8_run_batch_esp32p4(const esp_nn_fc_prepared_t *prep,
+                                                 const int32_t batches,
+                                                 const int8_t *input_data,
+                                                 int8_t *out_data)
+{
+    if (prep->corrections == NULL || prep->layout != ESP_NN_FC_LAYOUT_ROWS) {
+        ESP_NN_PATH_CALL(ESP_NN_PATH_FC_PREPARED_C,
+                         esp_nn_fully_connected_s8_run_batch_ansi(prep, batches, input_data,
+                                                                  out_data));
+        return;
+    }
+    ESP_NN_PIE_ENABLE();
+    ESP_NN_PATH_TIMER_START(t_s8);
+
+    /* channel outer: each packed row stays in cache for the whole batch */
+    const int8_t *filter_row = prep->packed_filter;
+    for (int32_t out_c = 0; out_c < prep->out_channels; ++out_c) {
+        for (int32_t batch = 0; batch < batches; batch++) {
+            int32_t result = fc_dot_s8_pie(input_data + batch * prep->row_len, filter_row,
+                                           prep->row_len);
+            out_data[batch * prep->out_channels + out_c] = fc_prepared_out_p4(prep, out_c, result);
+        }
+        filter_row += prep->row_stride;
+    }
+    ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_FC_PREPARED_S8, t_s8);
 }
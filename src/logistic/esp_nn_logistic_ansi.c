@@ -7,6 +7,8 @@
 #include <stdint.h>
 #include <math.h>
 
+#include <common_functions.h>
+
 /*
  * LUT-based int8 logistic (sigmoid) for quantized inference.
  *
@@ -55,3 +57,65 @@ void esp_nn_logistic_s8_ansi(const int8_t *input, int8_t *output,
         output[i] = lut[(uint8_t)input[i]];
     }
 }
+
+/*
+ * int16 logistic and tanh, input Q3.12 (scale 2^-12), output Q0.15.
+ *
+ * The tables hold the function at 513 points over the whole input range,
+ * [-8, 8] 1/32 apart: the top 9 bits of an input pick the segment and the
+ * low 7 interpolate in it. These are the activations of the LSTM gates.
+ */
+
+#define LUT_S16_POINTS  513
+
+int32_t esp_nn_get_logistic_s16_scratch_size_ansi(void)
+{
+    return LUT_S16_POINTS * sizeof(int16_t);
+}
+
+int32_t esp_nn_get_tanh_s16_scratch_size_ansi(void)
+{
+    return LUT_S16_POINTS * sizeof(int16_t);
+}
+
+static void lut_s16_fill(int16_t *lut, float (*fn)(float))
+{
+    for (int i = 0; i < LUT_S16_POINTS; i++) {
+        float x = (i - (LUT_S16_POINTS - 1) / 2) / 32.0f;
+        int32_t q = (int32_t)roundf(fn(x) * 32768.0f);
+        if (q < -32768) q = -32768;
+        if (q > 32767) q = 32767;
+        lut[i] = (int16_t)q;
+    }
+}
+
+static float sigmoid_f(float x)
+{
+    return 1.0f / (1.0f + expf(-x));
+}
+
+void esp_nn_logistic_s16_prepare_ansi(int16_t *lut)
+{
+    lut_s16_fill(lut, sigmoid_f);
+}
+
+void esp_nn_tanh_s16_prepare_ansi(int16_t *lut)
+{
+    lut_s16_fill(lut, tanhf);
+}
+
+void esp_nn_logistic_s16_ansi(const int16_t *input, int16_t *output,
+                              int32_t size, const int16_t *lut)
+{
+    for (int i = 0; i < size; i++) {
+        output[i] = (int16_t)esp_nn_lut_s16(lut, input[i]);
+    }
+}
+
+void esp_nn_tanh_s16_ansi(const int16_t *input, int16_t *output,
+                          int32_t size, const int16_t *lut)
+{
+    for (int i = 0; i < size; i++) {
+        output[i] = (int16_t)esp_nn_lut_s16(lut, input[i]);
+    }
+}
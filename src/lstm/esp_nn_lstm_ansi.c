@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lstm_common.h"
+
+int32_t esp_nn_get_lstm_scratch_size_ansi(const data_dims_t *input_dims,
+                                          const data_dims_t *output_dims,
+                                          const lstm_params_t *params)
+{
+    return 0;
+}
+
+void esp_nn_lstm_s8_ansi(const esp_nn_ctx_t *ctx,
+                         const data_dims_t *input_dims,
+                         const int8_t *input_data,
+                         const data_dims_t *output_dims,
+                         int8_t *out_data,
+                         int8_t *hidden_state,
+                         int16_t *cell_state,
+                         const lstm_params_t *params)
+{
+    (void) ctx;
+    if (!esp_nn_lstm_check(input_dims, output_dims, params)) {
+        return;
+    }
+    const int32_t steps = input_dims->height;
+    const int32_t input_size = input_dims->width;
+    const int32_t units = output_dims->width;
+    const int32_t batches = esp_nn_batches(input_dims);
+    const esp_nn_requant_t hidden_rq = esp_nn_requant_entry(params->hidden_mult,
+                                                            params->hidden_shift);
+
+    for (int32_t batch = 0; batch < batches; batch++) {
+        const int8_t *x_seq = input_data + batch * steps * input_size;
+        int8_t *h_seq = out_data + batch * steps * units;
+        int8_t *h0 = hidden_state + batch * units;
+        int16_t *cell = cell_state + batch * units;
+
+        for (int32_t t = 0; t < steps; t++) {
+            const int8_t *x = x_seq + t * input_size;
+            /* the new hidden state goes to the output row, the previous one is read from the last */
+            const int8_t *h_prev = t > 0 ? h_seq + (t - 1) * units : h0;
+            int8_t *h = h_seq + t * units;
+
+            for (int32_t unit = 0; unit < units; unit++) {
+                int32_t gate[ESP_NN_LSTM_GATES];
+
+                for (int32_t g = 0; g < ESP_NN_LSTM_GATES; g++) {
+                    const lstm_gate_t *gp = &params->gates[g];
+                    const int8_t *wx = gp->input_weights + unit * input_size;
+                    const int8_t *wh = gp->recurrent_weights + unit * units;
+                    const esp_nn_requant_t input_rq = esp_nn_requant_entry(gp->input_mult,
+                                                                           gp->input_shift);
+                    const esp_nn_requant_t recurrent_rq = esp_nn_requant_entry(gp->recurrent_mult,
+                                                                               gp->recurrent_shift);
+                    int32_t acc_x = gp->bias ? gp->bias[unit] : 0;
+                    int32_t acc_h = 0;
+                    for (int32_t k = 0; k < input_size; k++) {
+                        acc_x += (x[k] + params->input_offset) * wx[k];
+                    }
+                    for (int32_t k = 0; k < units; k++) {
+                        acc_h += (h_prev[k] + params->hidden_offset) * wh[k];
+                    }
+                    acc_x = esp_nn_saturate16(esp_nn_requant_apply(acc_x, &input_rq));
+                    gate[g] = esp_nn_saturate16(acc_x + esp_nn_requant_apply(acc_h, &recurrent_rq));
+                }
+                int32_t result = esp_nn_lstm_cell(gate, &cell[unit], params);
+                result = esp_nn_requant_apply(result, &hidden_rq);
+                result -= params->hidden_offset;
+                result = max(result, params->activation.min);
+                result = min(result, params->activation.max);
+                h[unit] = (int8_t) result;
+            }
+        }
+        if (steps > 0) {
+            memcpy(h0, h_seq + (steps - 1) * units, units);
+        }
+    }
+}
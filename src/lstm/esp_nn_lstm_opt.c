@@ -0,0 +1,250 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lstm_common.h"
+
+int32_t esp_nn_lstm_scratch_size(const data_dims_t *input_dims,
+                                 const data_dims_t *output_dims,
+                                 const bool packed)
+{
+    const int32_t rows = ESP_NN_LSTM_GATES * output_dims->width;
+    const int32_t input_aligned = (input_dims->width + 15) & ~15;
+    const int32_t units_aligned = (output_dims->width + 15) & ~15;
+    int32_t size = 15 + rows * 2 * (int32_t) sizeof(int32_t) +
+                   ESP_NN_LSTM_STEPS * rows * (int32_t) sizeof(int16_t);
+
+    if (packed) {
+        size += rows * (input_aligned + units_aligned) +
+                ESP_NN_LSTM_STEPS * input_aligned + units_aligned;
+    }
+    return size;
+}
+
+void esp_nn_lstm_s8_fused(const data_dims_t *input_dims,
+                          const int8_t *input_data,
+                          const data_dims_t *output_dims,
+                          int8_t *out_data,
+                          int8_t *hidden_state,
+                          int16_t *cell_state,
+                          const lstm_params_t *params,
+                          void *scratch,
+                          esp_nn_dot_s8_fn_t dot)
+{
+    if (!esp_nn_lstm_check(input_dims, output_dims, params)) {
+        return;
+    }
+    if (scratch == NULL) {
+        printf("esp_nn_lstm error! scratch_buffer not set!\n");
+        return;
+    }
+    const int32_t steps = input_dims->height;
+    const int32_t input_size = input_dims->width;
+    const int32_t units = output_dims->width;
+    const int32_t rows = ESP_NN_LSTM_GATES * units;
+    const int32_t input_aligned = (input_size + 15) & ~15;
+    const int32_t units_aligned = (units + 15) & ~15;
+    const int32_t input_offset = params->input_offset;
+    const int32_t hidden_offset = params->hidden_offset;
+    const int32_t activation_min = params->activation.min;
+    const int32_t activation_max = params->activation.max;
+    const esp_nn_requant_t hidden_rq = esp_nn_requant_entry(params->hidden_mult,
+                                                            params->hidden_shift);
+    esp_nn_requant_t input_rq[ESP_NN_LSTM_GATES], recurrent_rq[ESP_NN_LSTM_GATES];
+
+    int8_t *buf = (int8_t *) (((uintptr_t) scratch + 15) & ~(uintptr_t) 15);
+    int8_t *input_weights = NULL, *recurrent_weights = NULL, *x_block = NULL, *h_buf = NULL;
+    if (dot) {
+        input_weights = buf;
+        recurrent_weights = input_weights + rows * input_aligned;
+        x_block = recurrent_weights + rows * units_aligned;
+        h_buf = x_block + ESP_NN_LSTM_STEPS * input_aligned;
+        buf = h_buf + units_aligned;
+        memset(h_buf, 0, units_aligned);
+    }
+    int32_t *input_terms = (int32_t *) buf;
+    int32_t *recurrent_terms = input_terms + rows;
+    int16_t *gates_x = (int16_t *) (recurrent_terms + rows);
+
+    for (int32_t g = 0; g < ESP_NN_LSTM_GATES; g++) {
+        const lstm_gate_t *gate = &params->gates[g];
+        input_rq[g] = esp_nn_requant_entry(gate->input_mult, gate->input_shift);
+        recurrent_rq[g] = esp_nn_requant_entry(gate->recurrent_mult, gate->recurrent_shift);
+    }
+    for (int32_t row = 0; row < rows; row++) {
+        const lstm_gate_t *gate = &params->gates[row % ESP_NN_LSTM_GATES];
+        const int32_t unit = row / ESP_NN_LSTM_GATES;
+        const int8_t *wx = gate->input_weights + unit * input_size;
+        const int8_t *wh = gate->recurrent_weights + unit * units;
+        int32_t sum_x = 0, sum_h = 0;
+        for (int32_t k = 0; k < input_size; k++) {
+            sum_x += wx[k];
+        }
+        for (int32_t k = 0; k < units; k++) {
+            sum_h += wh[k];
+        }
+        input_terms[row] = input_offset * sum_x + (gate->bias ? gate->bias[unit] : 0);
+        recurrent_terms[row] = hidden_offset * sum_h;
+        if (dot) {
+            int8_t *px = input_weights + row * input_aligned;
+            int8_t *ph = recurrent_weights + row * units_aligned;
+            memcpy(px, wx, input_size);
+            memset(px + input_size, 0, input_aligned - input_size);
+            memcpy(ph, wh, units);
+            memset(ph + units, 0, units_aligned - units);
+        }
+    }
+
+    const int32_t batches = esp_nn_batches(input_dims);
+    for (int32_t batch = 0; batch < batches; batch++) {
+        const int8_t *x_seq = input_data + batch * steps * input_size;
+        int8_t *h_seq = out_data + batch * steps * units;
+        int8_t *h0 = hidden_state + batch * units;
+        int16_t *cell = cell_state + batch * units;
+
+        for (int32_t t0 = 0; t0 < steps; t0 += ESP_NN_LSTM_STEPS) {
+            const int32_t n = min(ESP_NN_LSTM_STEPS, steps - t0);
+            const int8_t *x = x_seq + t0 * input_size;
+            int32_t x_stride = input_size;
+
+            if (dot) {
+                for (int32_t s = 0; s < n; s++) {
+                    memcpy(x_block + s * input_aligned, x + s * input_size, input_size);
+                    memset(x_block + s * input_aligned + input_size, 0,
+                           input_aligned - input_size);
+                }
+                x = x_block;
+                x_stride = input_aligned;
+            }
+
+            /* input products of the block */
+            for (int32_t row = 0; row < rows; row++) {
+                const int32_t unit = row / ESP_NN_LSTM_GATES;
+                const int32_t g = row % ESP_NN_LSTM_GATES;
+                const int8_t *w = dot ? input_weights + row * input_aligned :
+                                        params->gates[g].input_weights + unit * input_size;
+                int32_t acc[ESP_NN_LSTM_STEPS];
+                int32_t s = 0;
+
+                if (dot) {
+                    for (; s < n; s++) {
+                        acc[s] = dot(x + s * x_stride, w, input_aligned);
+                    }
+                }
+                for (; s + 3 < n; s += 4) {
+                    const int8_t *x0 = x + s * x_stride;
+                    const int8_t *x1 = x0 + x_stride;
+                    const int8_t *x2 = x1 + x_stride;
+                    const int8_t *x3 = x2 + x_stride;
+                    int32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+                    for (int32_t k = 0; k < input_size; k++) {
+                        const int32_t w_val = w[k];
+                        acc0 += x0[k] * w_val;
+                        acc1 += x1[k] * w_val;
+                        acc2 += x2[k] * w_val;
+                        acc3 += x3[k] * w_val;
+                    }
+                    acc[s] = acc0;
+                    acc[s + 1] = acc1;
+                    acc[s + 2] = acc2;
+                    acc[s + 3] = acc3;
+                }
+                for (; s < n; s++) {
+                    const int8_t *xs = x + s * x_stride;
+                    int32_t sum = 0;
+                    for (int32_t k = 0; k < input_size; k++) {
+                        sum += xs[k] * w[k];
+                    }
+                    acc[s] = sum;
+                }
+                for (s = 0; s < n; s++) {
+                    const int32_t result = esp_nn_requantize_plan(acc[s] + input_terms[row],
+                                                                  &input_rq[g]);
+                    gates_x[s * rows + row] = (int16_t) esp_nn_saturate16(result);
+                }
+            }
+
+            /* the recurrence */
+            for (int32_t s = 0; s < n; s++) {
+                const int32_t t = t0 + s;
+                const int8_t *h_prev = t > 0 ? h_seq + (t - 1) * units : h0;
+                const int16_t *gx = gates_x + s * rows;
+                int8_t *h = h_seq + t * units;
+
+                if (dot) {
+                    memcpy(h_buf, h_prev, units);
+                    h_prev = h_buf;
+                }
+                for (int32_t unit = 0; unit < units; unit++) {
+                    const int32_t row = unit * ESP_NN_LSTM_GATES;
+                    int32_t acc[ESP_NN_LSTM_GATES];
+                    int32_t gate[ESP_NN_LSTM_GATES];
+
+                    if (dot) {
+                        const int8_t *w = recurrent_weights + row * units_aligned;
+                        for (int32_t g = 0; g < ESP_NN_LSTM_GATES; g++) {
+                            acc[g] = dot(h_prev, w + g * units_aligned, units_aligned);
+                        }
+                    } else {
+                        const int32_t offset = unit * units;
+                        const int8_t *w0 = params->gates[0].recurrent_weights + offset;
+                        const int8_t *w1 = params->gates[1].recurrent_weights + offset;
+                        const int8_t *w2 = params->gates[2].recurrent_weights + offset;
+                        const int8_t *w3 = params->gates[3].recurrent_weights + offset;
+                        int32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+                        for (int32_t k = 0; k < units; k++) {
+                            const int32_t h_val = h_prev[k];
+                            acc0 += h_val * w0[k];
+                            acc1 += h_val * w1[k];
+                            acc2 += h_val * w2[k];
+                            acc3 += h_val * w3[k];
+                        }
+                        acc[0] = acc0;
+                        acc[1] = acc1;
+                        acc[2] = acc2;
+                        acc[3] = acc3;
+                    }
+                    for (int32_t g = 0; g < ESP_NN_LSTM_GATES; g++) {
+                        const int32_t result = esp_nn_requantize_plan(acc[g] + recurrent_terms[row + g],
+                                                                      &recurrent_rq[g]);
+                        gate[g] = esp_nn_saturate16(gx[row + g] + result);
+                    }
+                    int32_t result = esp_nn_lstm_cell(gate, &cell[unit], params);
+                    result = esp_nn_requantize_plan(result, &hidden_rq);
+                    result -= hidden_offset;
+                    result = max(result, activation_min);
+                    result = min(result, activation_max);
+                    h[unit] = (int8_t) result;
+                }
+            }
+        }
+        if (steps > 0) {
+            memcpy(h0, h_seq + (steps - 1) * units, units);
+        }
+    }
+}
+
+int32_t esp_nn_get_lstm_scratch_size_opt(const data_dims_t *input_dims,
+                                         const data_dims_t *output_dims,
+                                         const lstm_params_t *params)
+{
+    return esp_nn_lstm_scratch_size(input_dims, output_dims, false);
+}
+
+void esp_nn_lstm_s8_opt(const esp_nn_ctx_t *ctx,
+                        const data_dims_t *input_dims,
+                        const int8_t *input_data,
+                        const data_dims_t *output_dims,
+                        int8_t *out_data,
+                        int8_t *hidden_state,
+                        int16_t *cell_state,
+                        const lstm_params_t *params)
+{
+    esp_nn_lstm_s8_fused(input_dims, input_data, output_dims, out_data, hidden_state,
+                         cell_state, params, ctx->scratch, NULL);
+}
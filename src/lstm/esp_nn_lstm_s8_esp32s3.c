@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include "lstm_common.h"
+
+int32_t esp_nn_get_lstm_scratch_size_esp32s3(const data_dims_t *input_dims,
+                                             const data_dims_t *output_dims,
+                                             const lstm_params_t *params)
+{
+    return esp_nn_lstm_scratch_size(input_dims, output_dims, true);
+}
+
+/* gates fused, the packed weight rows on the aligned SIMD dot product */
+void esp_nn_lstm_s8_esp32s3(const esp_nn_ctx_t *ctx,
+                            const data_dims_t *input_dims,
+                            const int8_t *input_data,
+                            const data_dims_t *output_dims,
+                            int8_t *out_data,
+                            int8_t *hidden_state,
+                            int16_t *cell_state,
+                            const lstm_params_t *params)
+{
+    esp_nn_lstm_s8_fused(input_dims, input_data, output_dims, out_data, hidden_state,
+                         cell_state, params, ctx->scratch, esp_nn_dot_s8_aligned_esp32s3);
+}
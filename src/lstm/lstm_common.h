@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_nn_defs.h>
+#include <common_functions.h>
+
+/**
+ * @brief       whether the dims and params of an LSTM agree, printing why not
+ *
+ * @note        input: height time steps of width input_size, output: height time
+ *              steps of width units. `extra` is the batch count of both.
+ */
+static inline bool esp_nn_lstm_check(const data_dims_t *input_dims,
+                                     const data_dims_t *output_dims,
+                                     const lstm_params_t *params)
+{
+    if (output_dims->height != input_dims->height ||
+            esp_nn_batches(output_dims) != esp_nn_batches(input_dims)) {
+        printf("esp_nn_lstm error! dims don't match\n");
+        return false;
+    }
+    if (params->sigmoid_lut == NULL || params->tanh_lut == NULL ||
+            params->cell_shift < -30 || params->cell_shift > 0) {
+        printf("esp_nn_lstm error! activation tables or cell_shift not set\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief       cell state update of one unit from its four gate pre-activations
+ *
+ * @return      o * tanh(c) of the unit in Q0.30, for the caller to requantize
+ */
+static inline int32_t esp_nn_lstm_cell(const int32_t *gate, int16_t *cell,
+                                       const lstm_params_t *params)
+{
+    const int32_t in_gate = esp_nn_lut_s16(params->sigmoid_lut, gate[ESP_NN_LSTM_INPUT_GATE]);
+    const int32_t forget_gate = esp_nn_lut_s16(params->sigmoid_lut, gate[ESP_NN_LSTM_FORGET_GATE]);
+    const int32_t cell_gate = esp_nn_lut_s16(params->tanh_lut, gate[ESP_NN_LSTM_CELL_GATE]);
+    const int32_t out_gate = esp_nn_lut_s16(params->sigmoid_lut, gate[ESP_NN_LSTM_OUTPUT_GATE]);
+
+    int32_t c = esp_nn_div_by_power_of_two(forget_gate * *cell, 15) +
+                esp_nn_div_by_power_of_two(in_gate * cell_gate, 30 + params->cell_shift);
+    c = esp_nn_saturate16(c);
+    if (params->cell_clip > 0) {
+        c = max(-params->cell_clip, min(c, params->cell_clip));
+    }
+    *cell = (int16_t) c;
+
+    /* the cell state in Q3.12 for the tanh table */
+    const int32_t to_q12 = params->cell_shift + 12;
+    const int32_t c_q12 = to_q12 >= 0 ? esp_nn_saturate16(c * (1 << to_q12)) :
+                                        esp_nn_div_by_power_of_two(c, -to_q12);
+    return out_gate * esp_nn_lut_s16(params->tanh_lut, c_q12);
+}
+
+/* time steps whose input products are run in one go, each weight row against all of them */
+#define ESP_NN_LSTM_STEPS   16
+
+/**
+ * @brief       scratch of esp_nn_lstm_s8_fused: the folded offset terms, the input
+ *              products of ESP_NN_LSTM_STEPS steps and, with a `dot`, the weights
+ *              and the inputs packed to 16 bytes
+ */
+int32_t esp_nn_lstm_scratch_size(const data_dims_t *input_dims,
+                                 const data_dims_t *output_dims,
+                                 const bool packed);
+
+/**
+ * @brief       LSTM over whole sequences, the four gates of a unit fused
+ *
+ * @note        The weight rows are taken in unit major order, the four gates of
+ *              a unit next to each other, with their row sums folded into the
+ *              offset terms once per call. The input products don't depend on
+ *              the recurrence: they are run ESP_NN_LSTM_STEPS time steps at a time,
+ *              every weight row against all of them. The recurrence then only
+ *              runs the recurrent products, the four rows of a unit sharing each
+ *              hidden state value loaded.
+ *              `dot` (may be NULL) takes 16 byte aligned operands, the length
+ *              rounded up to 16: the weights and inputs are then packed into scratch.
+ */
+void esp_nn_lstm_s8_fused(const data_dims_t *input_dims,
+                          const int8_t *input_data,
+                          const data_dims_t *output_dims,
+                          int8_t *out_data,
+                          int8_t *hidden_state,
+                          int16_t *cell_state,
+                          const lstm_params_t *params,
+                          void *scratch,
+                          esp_nn_dot_s8_fn_t dot);
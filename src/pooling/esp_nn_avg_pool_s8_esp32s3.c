@@ -49,15 +49,17 @@ void esp_nn_avg_pool_s8_esp32s3(const int8_t *input,
 {
     /* Use existing assembly for channels % 4 == 0 */
     if (channels % 4 == 0) {
-        esp_nn_avg_pool_s8_esp32s3_asm(input, input_wd, input_ht, output,
+        ESP_NN_PATH_CALL(ESP_NN_PATH_AVG_POOL_ASM,
+                         esp_nn_avg_pool_s8_esp32s3_asm(input, input_wd, input_ht, output,
                                         output_wd, output_ht, stride_wd, stride_ht,
                                         filter_wd, filter_ht, pad_wd, pad_ht,
-                                        activation_min, activation_max, channels);
+                                        activation_min, activation_max, channels));
         return;
     }
 
     /* C path with int16 accumulation for non-aligned channels */
     int16_t acc_buf[channels];
+    ESP_NN_PATH_TIMER_START(t_c);
 
     int32_t base_y = -pad_ht;
     for (int32_t out_y = 0; out_y < output_ht; out_y++, base_y += stride_ht) {
@@ -92,4 +94,5 @@ void esp_nn_avg_pool_s8_esp32s3(const int8_t *input,
             }
         }
     }
+    ESP_NN_PATH_TIMER_STOP(ESP_NN_PATH_AVG_POOL_C, t_c);
 }
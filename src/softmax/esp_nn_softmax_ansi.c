@@ -86,3 +86,17 @@ void esp_nn_softmax_s8_ansi(const int8_t *input_data,
         out_ptr += width;
     }
 }
+
+/* No scratch needed, the context is ignored */
+void esp_nn_softmax_s8_ctx_ansi(const esp_nn_ctx_t *ctx,
+                                const int8_t *input_data,
+                                const int32_t height,
+                                const int32_t width,
+                                const int32_t mult,
+                                const int32_t shift,
+                                const int32_t diff_min,
+                                int8_t *output_data)
+{
+    (void) ctx;
+    esp_nn_softmax_s8_ansi(input_data, height, width, mult, shift, diff_min, output_data);
+}
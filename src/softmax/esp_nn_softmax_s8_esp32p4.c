@@ -8,7 +8,19 @@
 #include <stdio.h>
 #include <limits.h>
 
-static int32_t *p4_scratch_buf = NULL;
+/* scratch of the legacy (non `_ctx`) API, set with esp_nn_set_softmax_scratch_buf */
+static esp_nn_ctx_t legacy_ctx;
+
+/* PIE state is per core: enabled on every `_ctx` call as those may run on either core */
+static inline void softmax_pie_enable(void)
+{
+    asm volatile (
+        "csrsi  0x7f2, 0b01        \n\t"
+        "li     x29, 0b10          \n\t"
+        "esp.movx.w.cfg x29        \n\t"
+        ::: "x29"
+    );
+}
 
 int32_t esp_nn_get_softmax_scratch_size_esp32p4(const int32_t width, const int32_t height)
 {
@@ -18,14 +30,8 @@ int32_t esp_nn_get_softmax_scratch_size_esp32p4(const int32_t width, const int32
 
 void esp_nn_set_softmax_scratch_buf_esp32p4(void *buffer)
 {
-    /* Enable PIE */
-    asm volatile (
-        "csrsi  0x7f2, 0b01        \n\t"
-        "li     x29, 0b10          \n\t"
-        "esp.movx.w.cfg x29        \n\t"
-        ::: "x29"
-    );
-    p4_scratch_buf = (int32_t *) buffer;
+    softmax_pie_enable();
+    legacy_ctx.scratch = buffer;
 }
 
 /**
@@ -33,18 +39,21 @@ void esp_nn_set_softmax_scratch_buf_esp32p4(void *buffer)
  * Phase 1 (find-max) uses PIE esp.vmax.s8 for 16 elements at a time.
  * Phases 2-3 (exp + normalize) use cached exp values in scratch buffer.
  */
-void esp_nn_softmax_s8_esp32p4(const int8_t *input_data,
-                                const int32_t height,
-                                const int32_t width,
-                                const int32_t mult,
-                                const int32_t shift,
-                                const int32_t diff_min,
-                                int8_t *output_data)
+void esp_nn_softmax_s8_ctx_esp32p4(const esp_nn_ctx_t *ctx,
+                                   const int8_t *input_data,
+                                   const int32_t height,
+                                   const int32_t width,
+                                   const int32_t mult,
+                                   const int32_t shift,
+                                   const int32_t diff_min,
+                                   int8_t *output_data)
 {
+    int32_t *p4_scratch_buf = (int32_t *) ctx->scratch;
     if (p4_scratch_buf == NULL) {
         printf("%s error! scratch buffer not set\n", __FUNCTION__);
         return;
     }
+    softmax_pie_enable();
 
 #define ACCUM_BITS  12
 #define DIFF_BITS   5
@@ -126,3 +135,15 @@ void esp_nn_softmax_s8_esp32p4(const int8_t *input_data,
         out_ptr += width;
     }
 }
+
+void esp_nn_softmax_s8_esp32p4(const int8_t *input_data,
+                                const int32_t height,
+                                const int32_t width,
+                                const int32_t mult,
+                                const int32_t shift,
+                                const int32_t diff_min,
+                                int8_t *output_data)
+{
+    esp_nn_softmax_s8_ctx_esp32p4(&legacy_ctx, input_data, height, width, mult, shift, diff_min,
+                                  output_data);
+}
@@ -11,7 +11,8 @@
 #include <stdint.h>
 #include "softmax_common.h"
 
-static int32_t *scratch_buf_s3 = NULL;
+/* scratch of the legacy (non `_ctx`) API, set with esp_nn_set_softmax_scratch_buf */
+static esp_nn_ctx_t legacy_ctx;
 
 int32_t esp_nn_get_softmax_scratch_size_esp32s3(const int32_t width, const int32_t height)
 {
@@ -21,7 +22,7 @@ int32_t esp_nn_get_softmax_scratch_size_esp32s3(const int32_t width, const int32
 
 void esp_nn_set_softmax_scratch_buf_esp32s3(void *buffer)
 {
-    scratch_buf_s3 = (int32_t *) buffer;
+    legacy_ctx.scratch = buffer;
 }
 
 /* Find max of int8 array — SIMD for len >= 32, scalar for smaller */
@@ -71,14 +72,16 @@ static inline int8_t find_max_s8(const int8_t *data, int32_t len)
     return m;
 }
 
-void esp_nn_softmax_s8_esp32s3(const int8_t *input_data,
-                                const int32_t height,
-                                const int32_t width,
-                                const int32_t mult,
-                                const int32_t shift,
-                                const int32_t diff_min,
-                                int8_t *output_data)
+void esp_nn_softmax_s8_ctx_esp32s3(const esp_nn_ctx_t *ctx,
+                                   const int8_t *input_data,
+                                   const int32_t height,
+                                   const int32_t width,
+                                   const int32_t mult,
+                                   const int32_t shift,
+                                   const int32_t diff_min,
+                                   int8_t *output_data)
 {
+    int32_t *scratch_buf_s3 = (int32_t *) ctx->scratch;
     if (scratch_buf_s3 == NULL) {
         /* Fall through to opt version if scratch not set */
         return;
@@ -144,3 +147,15 @@ void esp_nn_softmax_s8_esp32s3(const int8_t *input_data,
     }
 #undef ACCUM_BITS
 }
+
+void esp_nn_softmax_s8_esp32s3(const int8_t *input_data,
+                                const int32_t height,
+                                const int32_t width,
+                                const int32_t mult,
+                                const int32_t shift,
+                                const int32_t diff_min,
+                                int8_t *output_data)
+{
+    esp_nn_softmax_s8_ctx_esp32s3(&legacy_ctx, input_data, height, width, mult, shift, diff_min,
+                                  output_data);
+}
@@ -74,6 +74,18 @@ void app_main()
     print_profile("depthwise_conv_s8");
     esp_nn_conv_s8_test();
     print_profile("conv_s8");
+    esp_nn_conv_s8_workers_test();
+    print_profile("conv_s8_workers");
+    esp_nn_conv_s8_stream_test();
+    print_profile("conv_s8_stream");
+    esp_nn_conv_s8_mover_test();
+    print_profile("conv_s8_mover");
+    esp_nn_conv_s8_scratch_test();
+    print_profile("conv_s8_scratch");
+    esp_nn_transpose_conv_s8_test();
+    print_profile("transpose_conv_s8");
+    esp_nn_dw_pw_conv_s8_test();
+    print_profile("dw_pw_conv_s8");
     esp_nn_relu6_s8_test();
     print_profile("relu6_s8");
     esp_nn_avg_pool_s8_test();
@@ -84,14 +96,41 @@ void app_main()
     print_profile("fc_s8");
     esp_nn_fully_connected_per_ch_s8_test();
     print_profile("fc_per_ch_s8");
+    esp_nn_fully_connected_prepared_s8_test();
+    print_profile("fc_prepared_s8");
+    esp_nn_fully_connected_s8_sparse_test();
+    print_profile("fc_sparse_s8");
+    esp_nn_batch_matmul_s8_test();
+    print_profile("batch_matmul_s8");
+    esp_nn_lstm_s8_test();
+    print_profile("lstm_s8");
     esp_nn_softmax_s8_test();
     print_profile("softmax_s8");
     esp_nn_hard_swish_s8_test();
     print_profile("hard_swish_s8");
+    esp_nn_logistic_tanh_s16_test();
+    print_profile("logistic_tanh_s16");
     esp_nn_mean_nhwc_s8_test();
     print_profile("mean_nhwc_s8");
+    esp_nn_plan_arena_test();
+    esp_nn_telemetry_test();
+    esp_nn_profile_test();
+    esp_nn_autotune_test();
+    esp_nn_conv_s16_test();
+    print_profile("conv_s16");
+    esp_nn_depthwise_conv_s16_test();
+    print_profile("depthwise_conv_s16");
+    esp_nn_fully_connected_s16_test();
+    print_profile("fc_s16");
+    esp_nn_conv_s4_test();
+    print_profile("conv_s4");
+    esp_nn_fully_connected_per_ch_s4_test();
+    print_profile("fc_per_ch_s4");
     ESP_LOGI(TAG, "s8 tests done!\n");
 
+    /* layer by layer replay of reference models, prints cycles per layer */
+    esp_nn_model_layers_test();
+
     /* u8 tests */
     //ESP_LOGI(TAG, "Running u8 tests...");
     //esp_nn_add_elementwise_u8_test();
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Layer tables of reference models and helpers to replay them layer by layer
+ * with both the ANSI C and the optimised kernels. Shared by the on-target
+ * test app and the host benchmark (bench/).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <esp_nn.h>
+
+typedef enum {
+    MODEL_OP_CONV = 0,
+    MODEL_OP_DEPTHWISE,
+    MODEL_OP_FC,
+    MODEL_OP_HARD_SWISH,
+    MODEL_OP_MEAN,
+    MODEL_OP_MUL_BROADCAST,
+    MODEL_OP_ADD,
+    MODEL_OP_AVG_POOL,
+    MODEL_OP_SOFTMAX,
+} model_op_t;
+
+/* fused activation of conv/depthwise/fc */
+typedef enum {
+    MODEL_ACT_NONE = 0,
+    MODEL_ACT_RELU,
+    MODEL_ACT_RELU6,
+} model_act_t;
+
+/* dispatcher whose path is reported by `model_layer_path` */
+typedef enum {
+    MODEL_TARGET_GENERIC = 0,
+    MODEL_TARGET_ESP32S3,
+    MODEL_TARGET_ESP32P4,
+} model_target_t;
+
+typedef struct {
+    const char *name;
+    model_op_t op;
+    uint16_t in_wd, in_ht, in_ch;
+    uint16_t out_wd, out_ht, out_ch;
+    uint8_t filter, stride, pad;    /* square window, `pad` is the leading padding */
+    model_act_t act;
+    int8_t in_zp, out_zp;
+    float in_scale, out_scale;
+    float w_scale;                  /* filter scale (per channel values spread around it),
+                                       second input scale for add/mul */
+} model_layer_t;
+
+typedef struct {
+    const char *name;
+    const model_layer_t *layers;
+    int num_layers;
+} model_desc_t;
+
+extern const model_desc_t model_mobilenet_v3_small;
+extern const model_desc_t model_person_detection;
+
+/* Buffers and derived kernel params of one layer, ready to run */
+typedef struct {
+    const model_layer_t *layer;
+    data_dims_t input_dims, filter_dims, output_dims;
+    conv_params_t conv_params;
+    dw_conv_params_t dw_params;
+    quant_data_t quant;
+    int8_t *input, *input2, *filter;
+    int32_t *bias;
+    int8_t *out_ansi, *out_opt;
+    int32_t out_size;
+    void *scratch;
+    void *prepared;                 /* conv and fc: blob of the layer's prepare */
+    /* scalar params: mean, softmax, add, mul, hard_swish */
+    int32_t mult, shift, in2_mult, in2_shift, out_mult, out_shift, left_shift, diff_min;
+    int16_t hs_out_mult_fxp, hs_reluish_mult_fxp;
+    int32_t hs_out_exp, hs_reluish_exp;
+} model_layer_inst_t;
+
+/**
+ * @brief   Allocate buffers with random data and derive kernel params from the layer's scales
+ *
+ * @return  0 on success, -1 on allocation failure
+ */
+int model_layer_init(model_layer_inst_t *inst, const model_layer_t *layer);
+void model_layer_deinit(model_layer_inst_t *inst);
+
+/* Run the layer with the ANSI C kernel into `out_ansi` / the dispatched kernel into `out_opt` */
+void model_layer_run_ansi(model_layer_inst_t *inst);
+void model_layer_run_opt(model_layer_inst_t *inst);
+
+const char *model_op_name(model_op_t op);
+int64_t model_layer_macs(const model_layer_t *layer);
+void model_layer_shape_str(const model_layer_t *layer, char *buf, int len);
+
+/**
+ * @brief   Kernel path the given target's dispatcher selects for this layer
+ *
+ * @note    Mirrors the conditions of esp_nn_*_esp32s3 / esp_nn_*_esp32p4 dispatchers,
+ *          keep in sync when those change.
+ */
+const char *model_layer_path(const model_layer_t *layer, model_target_t target);
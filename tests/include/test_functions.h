@@ -12,19 +12,44 @@ void esp_nn_mul_broadcast_channel_s8_test();
 
 void esp_nn_depthwise_conv_s8_test();
 void esp_nn_conv_s8_test();
+void esp_nn_conv_s8_workers_test();
+void esp_nn_conv_s8_stream_test();
+void esp_nn_conv_s8_mover_test();
+void esp_nn_conv_s8_scratch_test();
+void esp_nn_transpose_conv_s8_test();
+void esp_nn_dw_pw_conv_s8_test();
 
 void esp_nn_avg_pool_s8_test();
 void esp_nn_max_pool_s8_test();
 
 void esp_nn_fully_connected_s8_test();
 void esp_nn_fully_connected_per_ch_s8_test();
+void esp_nn_fully_connected_prepared_s8_test();
+void esp_nn_fully_connected_s8_sparse_test();
+void esp_nn_batch_matmul_s8_test();
+void esp_nn_lstm_s8_test();
 
 void esp_nn_relu6_s8_test();
 
 void esp_nn_softmax_s8_test();
 
 void esp_nn_hard_swish_s8_test();
+void esp_nn_logistic_tanh_s16_test();
 void esp_nn_mean_nhwc_s8_test();
+void esp_nn_plan_arena_test();
+void esp_nn_telemetry_test();
+void esp_nn_profile_test();
+void esp_nn_autotune_test();
+/* int16 activation ops tests */
+void esp_nn_conv_s16_test();
+void esp_nn_depthwise_conv_s16_test();
+void esp_nn_fully_connected_s16_test();
+/* int4 weight ops tests */
+void esp_nn_conv_s4_test();
+void esp_nn_fully_connected_per_ch_s4_test();
+
+/* model layer replay */
+void esp_nn_model_layers_test();
 
 /* uint8_t ops tests */
 void esp_nn_add_elementwise_u8_test();
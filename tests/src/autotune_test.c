@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <esp_nn.h>
+#include "test_utils.h"
+
+/*
+ * A path the 1x1 layer below can take but doesn't by default: its id in the
+ * conv dispatcher of the target, the path telemetry records for it, and the
+ * path telemetry records for the default one.
+ */
+#if ARCH_ESP32_S3
+#define AUTOTUNE_KERNEL         ESP_NN_AUTOTUNE_CONV_S8_ESP32S3
+#define AUTOTUNE_FORCED_PATH    4   /* CONV_PATH_GENERAL */
+#define AUTOTUNE_FORCED_TELEM   ESP_NN_PATH_CONV_GENERAL
+#define AUTOTUNE_DEFAULT_TELEM  ESP_NN_PATH_CONV_1X1_ASM
+#elif ARCH_ESP32_P4
+#define AUTOTUNE_KERNEL         ESP_NN_AUTOTUNE_CONV_S8_ESP32P4
+#define AUTOTUNE_FORCED_PATH    1   /* CONV_PATH_PADDED */
+#define AUTOTUNE_FORCED_TELEM   ESP_NN_PATH_CONV_PADDED
+#define AUTOTUNE_DEFAULT_TELEM  ESP_NN_PATH_CONV_1X1
+#else
+#define AUTOTUNE_KERNEL         ESP_NN_AUTOTUNE_CONV_S8_OPT
+#define AUTOTUNE_FORCED_PATH    1   /* CONV_PATH_GENERAL */
+#define AUTOTUNE_FORCED_TELEM   ESP_NN_PATH_CONV_GENERAL
+#define AUTOTUNE_DEFAULT_TELEM  ESP_NN_PATH_CONV_1X1
+#endif
+
+#define AUTOTUNE_IN_WD      8
+#define AUTOTUNE_IN_HT      8
+#define AUTOTUNE_CH         16
+
+/* runs `prep` and checks its output and, with telemetry, the path it took */
+static bool autotune_run_check(const char *name, const esp_nn_ctx_t *ctx,
+                               const esp_nn_conv_prepared_t *prep, const int8_t *input,
+                               const int8_t *expected, int8_t *output, int size,
+                               esp_nn_path_t path)
+{
+    esp_nn_path_stats_t stats;
+
+    memset(output, 0, size);
+    esp_nn_telemetry_reset();
+    esp_nn_conv_s8_run(ctx, prep, input, output);
+    for (int i = 0; i < size; i++) {
+        if (output[i] != expected[i]) {
+            printf(ANSI_COLOR_RED"%s failed: output %d is %d, expected %d\n"ANSI_COLOR_RESET,
+                   name, i, output[i], expected[i]);
+            return false;
+        }
+    }
+    if (ESP_NN_TELEMETRY_ENABLED) {
+        if (esp_nn_telemetry_get(path, &stats) != 0 || stats.calls == 0) {
+            printf(ANSI_COLOR_RED"%s failed: nothing recorded on %s\n"ANSI_COLOR_RESET,
+                   name, esp_nn_path_name(path));
+            return false;
+        }
+        printf(ANSI_COLOR_GREEN"%s passed [%s]\n"ANSI_COLOR_RESET, name, esp_nn_path_name(path));
+    } else {
+        printf(ANSI_COLOR_GREEN"%s passed\n"ANSI_COLOR_RESET, name);
+    }
+    return true;
+}
+
+void esp_nn_autotune_test()
+{
+    const data_dims_t input_dims = {.width = AUTOTUNE_IN_WD, .height = AUTOTUNE_IN_HT,
+                                    .channels = AUTOTUNE_CH, 1};
+    const data_dims_t filter_dims = {.width = 1, .height = 1, .channels = AUTOTUNE_CH, 1};
+    const data_dims_t output_dims = {.width = AUTOTUNE_IN_WD, .height = AUTOTUNE_IN_HT,
+                                     .channels = AUTOTUNE_CH, 1};
+    const conv_params_t conv_params = {.in_offset = 5, .out_offset = 3, .stride = {1, 1},
+                                       .padding = {0, 0}, .dilation = {1, 1},
+                                       .activation = {-128, 127}};
+    const esp_nn_autotune_entry_t forced = {
+        .key = {.kernel = AUTOTUNE_KERNEL,
+                .input_wd = AUTOTUNE_IN_WD, .input_ht = AUTOTUNE_IN_HT, .input_ch = AUTOTUNE_CH,
+                .filter_wd = 1, .filter_ht = 1, .filter_ch = AUTOTUNE_CH,
+                .out_wd = AUTOTUNE_IN_WD, .out_ht = AUTOTUNE_IN_HT, .out_ch = AUTOTUNE_CH,
+                .stride_wd = 1, .stride_ht = 1, .pad_wd = 0, .pad_ht = 0},
+        .path = AUTOTUNE_FORCED_PATH,
+    };
+    const int input_size = AUTOTUNE_IN_WD * AUTOTUNE_IN_HT * AUTOTUNE_CH;
+    const int out_size = input_size;
+    int8_t *input = NULL, *filter = NULL, *out_ansi = NULL, *output = NULL;
+    int32_t *bias = NULL, *shift = NULL, *mult = NULL;
+    void *scratch_buf = NULL, *blob_default = NULL, *blob_forced = NULL;
+    esp_nn_autotune_entry_t exported[2];
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    if (esp_nn_autotune_enable(false) == -1) {
+        printf(ANSI_COLOR_YELLOW"autotuning compiled out, enable NN_AUTOTUNE to test it\n"
+               ANSI_COLOR_RESET);
+        return;
+    }
+    esp_nn_autotune_reset();
+
+    /* sizes follow the path: query them for the default and the forced one */
+    const int32_t scratch_default = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
+                                                                 &output_dims, &conv_params);
+    const int32_t prep_default = esp_nn_get_conv_prepared_size(&input_dims, &filter_dims,
+                                                               &output_dims, &conv_params);
+    if (esp_nn_autotune_preload(&forced, 1) != 1) {
+        printf(ANSI_COLOR_RED"preloading the entry failed\n"ANSI_COLOR_RESET);
+        return;
+    }
+    const int32_t scratch_forced = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
+                                                                &output_dims, &conv_params);
+    const int32_t prep_forced = esp_nn_get_conv_prepared_size(&input_dims, &filter_dims,
+                                                              &output_dims, &conv_params);
+    esp_nn_autotune_reset();
+    const int32_t scratch_size = scratch_default > scratch_forced ? scratch_default :
+                                                                    scratch_forced;
+
+    input = ESP_NN_TEST_ALLOC(input_size);
+    filter = ESP_NN_TEST_ALLOC(AUTOTUNE_CH * AUTOTUNE_CH);
+    out_ansi = ESP_NN_TEST_ALLOC(out_size);
+    output = ESP_NN_TEST_ALLOC(out_size);
+    bias = ESP_NN_TEST_ALLOC(AUTOTUNE_CH * sizeof(int32_t));
+    shift = ESP_NN_TEST_ALLOC(AUTOTUNE_CH * sizeof(int32_t));
+    mult = ESP_NN_TEST_ALLOC(AUTOTUNE_CH * sizeof(int32_t));
+    scratch_buf = ESP_NN_TEST_ALLOC(scratch_size + 16);
+    blob_default = ESP_NN_TEST_ALLOC(prep_default + 16);
+    blob_forced = ESP_NN_TEST_ALLOC(prep_forced + 16);
+    if (input == NULL || filter == NULL || out_ansi == NULL || output == NULL ||
+            bias == NULL || shift == NULL || mult == NULL || scratch_buf == NULL ||
+            blob_default == NULL || blob_forced == NULL) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto autotune_cleanup;
+    }
+    esp_nn_ctx_t ctx = {.scratch = (void *) (((uintptr_t) scratch_buf + 15) & ~15),
+                        .mover = NULL};
+    quant_data_t quant_data = {.shift = shift, .mult = mult};
+
+    for (int i = 0; i < input_size; i++) {
+        input[i] = rand() % 256 - 128;
+    }
+    for (int i = 0; i < AUTOTUNE_CH * AUTOTUNE_CH; i++) {
+        filter[i] = rand() % 256 - 128;
+    }
+    for (int i = 0; i < AUTOTUNE_CH; i++) {
+        bias[i] = rand() % 2001 - 1000;
+        shift[i] = -8 + rand() % 4;
+        mult[i] = 0x7f67f4f8 - rand() % 0x1000000;
+    }
+    esp_nn_conv_s8_ansi(&input_dims, input, &filter_dims, filter, bias, &output_dims,
+                        out_ansi, &conv_params, &quant_data);
+
+    /* one layer prepared on the default path, one on the path of the table entry */
+    esp_nn_conv_prepared_t *prep_on_default =
+        esp_nn_conv_s8_prepare((void *) (((uintptr_t) blob_default + 15) & ~15), &input_dims,
+                               &filter_dims, filter, bias, &output_dims, &conv_params,
+                               &quant_data);
+    esp_nn_autotune_preload(&forced, 1);
+    esp_nn_conv_prepared_t *prep_on_forced =
+        esp_nn_conv_s8_prepare((void *) (((uintptr_t) blob_forced + 15) & ~15), &input_dims,
+                               &filter_dims, filter, bias, &output_dims, &conv_params,
+                               &quant_data);
+    if (prep_on_default == NULL || prep_on_forced == NULL) {
+        printf(ANSI_COLOR_RED"prepare failed\n"ANSI_COLOR_RESET);
+        goto autotune_reset;
+    }
+    if (esp_nn_autotune_export(exported, 2) != 1 ||
+            memcmp(&exported[0].key, &forced.key, sizeof(forced.key)) != 0 ||
+            exported[0].path != forced.path) {
+        printf(ANSI_COLOR_RED"exported table doesn't hold the preloaded entry\n"ANSI_COLOR_RESET);
+        goto autotune_reset;
+    }
+
+    /* run keeps the path of prepare, whatever the table holds by then */
+    if (!autotune_run_check("picked path, table kept", &ctx, prep_on_forced, input, out_ansi,
+                            output, out_size, AUTOTUNE_FORCED_TELEM)) {
+        goto autotune_reset;
+    }
+    if (!autotune_run_check("default path, entry added later", &ctx, prep_on_default, input,
+                            out_ansi, output, out_size, AUTOTUNE_DEFAULT_TELEM)) {
+        goto autotune_reset;
+    }
+    esp_nn_autotune_reset();
+    if (!autotune_run_check("picked path, table cleared", &ctx, prep_on_forced, input,
+                            out_ansi, output, out_size, AUTOTUNE_FORCED_TELEM)) {
+        goto autotune_reset;
+    }
+    autotune_run_check("default path, table cleared", &ctx, prep_on_default, input, out_ansi,
+                       output, out_size, AUTOTUNE_DEFAULT_TELEM);
+
+autotune_reset:
+    esp_nn_autotune_reset();
+    esp_nn_telemetry_reset();
+autotune_cleanup:
+    if (input) free(input);
+    if (filter) free(filter);
+    if (out_ansi) free(out_ansi);
+    if (output) free(output);
+    if (bias) free(bias);
+    if (shift) free(shift);
+    if (mult) free(mult);
+    if (scratch_buf) free(scratch_buf);
+    if (blob_default) free(blob_default);
+    if (blob_forced) free(blob_forced);
+}
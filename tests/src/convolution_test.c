@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <malloc.h>
 #include <inttypes.h>
 
@@ -29,11 +30,14 @@ void esp_nn_depthwise_conv_s8_test()
     /* independent variables */
     int input_wd, input_ht, channels;
     uint16_t filter_ht, filter_wd, ch_mult, out_wd, out_ht;
-    uint16_t pad_wd, pad_ht, stride_wd, stride_ht;
+    uint16_t pad_wd, pad_ht, stride_wd, stride_ht, dilation_wd, dilation_ht;
 
     printf("\n######## Running %s ##########\n", __FUNCTION__);
-    // run for 17 iterations
-    for (int itr = 0; itr < 17; itr++) {
+    // run for 19 iterations
+    for (int itr = 0; itr < 19; itr++) {
+        dilation_wd = 1;
+        dilation_ht = 1;
+
         /* prepare data */
         switch (itr) {
         case 0: // (ch_mult 1, (channels % 16) = 0), filter (3,3), pad (0,0)
@@ -180,6 +184,34 @@ void esp_nn_depthwise_conv_s8_test()
             stride_wd = 2;
             stride_ht = 2;
             break;
+        case 17: // 3x3 dilated by 2, pad keeps the size
+            input_wd = 12;
+            input_ht = 12;
+            filter_ht = 3;
+            filter_wd = 3;
+            ch_mult = 1;
+            channels = 16;
+            pad_wd = 2;
+            pad_ht = 2;
+            stride_wd = 1;
+            stride_ht = 1;
+            dilation_wd = 2;
+            dilation_ht = 2;
+            break;
+        case 18: // 3x3 dilated by (3, 2), ch_mult 2, stride 2, pad (0,0)
+            input_wd = 15;
+            input_ht = 11;
+            filter_ht = 3;
+            filter_wd = 3;
+            ch_mult = 2;
+            channels = 8;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 2;
+            stride_ht = 2;
+            dilation_wd = 3;
+            dilation_ht = 2;
+            break;
         default:
             input_wd = 6;
             input_ht = 6;
@@ -194,16 +226,16 @@ void esp_nn_depthwise_conv_s8_test()
             break;
         }
 
-        /* prepare data */
+        /* prepare data, a dilated filter spans dilation * (filter - 1) + 1 pixels */
         if (pad_wd) {
             out_wd = (input_wd + stride_wd - 1) / stride_wd;
         } else {
-            out_wd = (input_wd + stride_wd - filter_wd) / stride_wd;
+            out_wd = (input_wd + stride_wd - dilation_wd * (filter_wd - 1) - 1) / stride_wd;
         }
         if (pad_ht) {
             out_ht = (input_ht + stride_ht - 1) / stride_ht;
         } else {
-            out_ht = (input_ht + stride_ht - filter_ht) / stride_ht;
+            out_ht = (input_ht + stride_ht - dilation_ht * (filter_ht - 1) - 1) / stride_ht;
         }
 
         // if (itr == 9) {
@@ -256,7 +288,8 @@ void esp_nn_depthwise_conv_s8_test()
         data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, 0, 0};
         dw_conv_params_t conv_params = {.in_offset = input_offset, .out_offset = out_offset, .ch_mult = ch_mult,
                                         .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
-                                        .dilation = {0, 0}, .activation = {activation_min, activation_max}};
+                                        .dilation = {dilation_wd, dilation_ht},
+                                        .activation = {activation_min, activation_max}};
         quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
 
         int scratch_buf_size = esp_nn_get_depthwise_conv_scratch_size(&input_dims, &filter_dims,
@@ -292,9 +325,9 @@ void esp_nn_depthwise_conv_s8_test()
         bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
         if (ret == false) {
         printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
-               " out: (%3d,%3d), filter: (%d, %d,%3d), ch_mult %d]\n"ANSI_COLOR_RESET,
+               " out: (%3d,%3d), filter: (%d, %d,%3d), ch_mult %d, dilation: (%d, %d)]\n"ANSI_COLOR_RESET,
                itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
-               filter_wd, filter_ht, channels, ch_mult);
+               filter_wd, filter_ht, channels, ch_mult, dilation_wd, dilation_ht);
 #if 0
             printf("Output: \n");
             PRINT_ARRAY_HEX(out_data_opt, out_size / out_ht, out_ht);
@@ -310,9 +343,9 @@ void esp_nn_depthwise_conv_s8_test()
             goto dc_s8_cleanup;
         }
         printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
-               " out: (%3d,%3d), filter: (%d, %d,%3d), ch_mult %d]"ANSI_COLOR_RESET,
+               " out: (%3d,%3d), filter: (%d, %d,%3d), ch_mult %d, dilation: (%d, %d)]"ANSI_COLOR_RESET,
                itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd,
-               out_ht, filter_wd, filter_ht, channels, ch_mult);
+               out_ht, filter_wd, filter_ht, channels, ch_mult, dilation_wd, dilation_ht);
         printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
 
     dc_s8_cleanup:
@@ -355,17 +388,20 @@ void esp_nn_conv_s8_test()
     int32_t *out_mult = NULL;
 
     /* independent variable */
-    int in_wd, in_ht, in_channels, out_channels;
+    int in_wd, in_ht, in_channels, out_channels, filter_ch;
     uint16_t filter_ht, filter_wd, out_wd, out_ht;
-    uint16_t pad_wd, pad_ht, stride_wd, stride_ht;
+    uint16_t pad_wd, pad_ht, stride_wd, stride_ht, dilation_wd, dilation_ht;
 
     printf("\n######## Running %s ##########\n", __FUNCTION__);
-    for (int itr = 0; itr < 18; itr++) {
+    for (int itr = 0; itr < 26; itr++) {
         /* Reset quant params to defaults each iteration */
         input_offset = 5;
         out_offset = 3;
         activation_min = -125;
         activation_max = 122;
+        filter_ch = 0; /* in_channels unless the case groups */
+        dilation_wd = 1;
+        dilation_ht = 1;
 
         switch (itr) {
         case 0: // ch % 8 == 0 && filter (1,1), padding (0,0)
@@ -560,6 +596,109 @@ void esp_nn_conv_s8_test()
             activation_min = -128;
             activation_max = 127;
             break;
+        case 18: // padded input over the S3 tile budget: strips of 10 output rows, last one 1
+            in_wd = 45;
+            in_ht = 61;
+            in_channels = 16;
+            out_channels = 16;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 19: // same with a filter large enough to fold: strips of 5 rows, last one 4
+            in_wd = 40;
+            in_ht = 37;
+            in_channels = 32;
+            out_channels = 64;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 20: // grouped, groups of 16 ch through the 1x1 path: filter (1,1), padding (0,0)
+            in_wd = 8;
+            in_ht = 8;
+            in_channels = 32;
+            out_channels = 32;
+            filter_ch = 16;
+            filter_ht = 1;
+            filter_wd = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 21: // grouped, groups of 4 ch through im2col: row 12 (< 16), window 36
+            in_wd = 10;
+            in_ht = 10;
+            in_channels = 16;
+            out_channels = 16;
+            filter_ch = 4;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 22: // grouped, groups of 16 ch through the general path
+            in_wd = 9;
+            in_ht = 7;
+            in_channels = 32;
+            out_channels = 24;
+            filter_ch = 16;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 23: // 3x3 dilated by 2, pad keeps the size
+            in_wd = 12;
+            in_ht = 12;
+            in_channels = 8;
+            out_channels = 16;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 2;
+            pad_ht = 2;
+            stride_wd = 1;
+            stride_ht = 1;
+            dilation_wd = 2;
+            dilation_ht = 2;
+            break;
+        case 24: // 3x3 dilated by (2, 3), stride 2, pad (0,0)
+            in_wd = 14;
+            in_ht = 13;
+            in_channels = 16;
+            out_channels = 8;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 2;
+            stride_ht = 2;
+            dilation_wd = 2;
+            dilation_ht = 3;
+            break;
+        case 25: // filter alone over the S3 tile budget: strips of 7 rows, last one 3
+            in_wd = 24;
+            in_ht = 24;
+            in_channels = 64;
+            out_channels = 64;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
         default: // ch % 8 == 0
             in_wd = 8;
             in_ht = 8;
@@ -575,21 +714,24 @@ void esp_nn_conv_s8_test()
         }
 
         int8_t *filter_data_orig_save = NULL; /* for case 17 unaligned filter restore */
+        if (filter_ch == 0) {
+            filter_ch = in_channels;
+        }
 
-        /* prepare data */
+        /* prepare data, a dilated filter spans dilation * (filter - 1) + 1 pixels */
         if (pad_wd) {
             out_wd = (in_wd + stride_wd - 1) / stride_wd;
         } else {
-            out_wd = (in_wd + stride_wd - filter_wd) / stride_wd;
+            out_wd = (in_wd + stride_wd - dilation_wd * (filter_wd - 1) - 1) / stride_wd;
         }
         if (pad_ht) {
             out_ht = (in_ht + stride_ht - 1) / stride_ht;
         } else {
-            out_ht = (in_ht + stride_ht - filter_ht) / stride_ht;
+            out_ht = (in_ht + stride_ht - dilation_ht * (filter_ht - 1) - 1) / stride_ht;
         }
 
         int in_size = in_wd * in_ht * in_channels;
-        int filter_size = filter_wd * filter_ht * in_channels * out_channels + 2;
+        int filter_size = filter_wd * filter_ht * filter_ch * out_channels + 2;
         int out_size = out_wd * out_ht * out_channels;
 
         input_orig = ESP_NN_TEST_ALLOC(in_size + 16);
@@ -724,10 +866,11 @@ void esp_nn_conv_s8_test()
 
         data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, 1};
         data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, 1};
-        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = in_channels, 1};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = filter_ch, 1};
         conv_params_t conv_params = {.in_offset = input_offset, .out_offset = out_offset,
                                     .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
-                                    .dilation = {0, 0}, .activation = {activation_min, activation_max}};
+                                    .dilation = {dilation_wd, dilation_ht},
+                                    .activation = {activation_min, activation_max}};
         quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
 
         int scratch_buf_size = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
@@ -763,15 +906,15 @@ void esp_nn_conv_s8_test()
         bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
         if (ret == false) {
             printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
-                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]\n"ANSI_COLOR_RESET,
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), dilation: (%d, %d)]\n"ANSI_COLOR_RESET,
                    itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
-                   out_channels, filter_wd, filter_ht, in_channels);
+                   out_channels, filter_wd, filter_ht, filter_ch, dilation_wd, dilation_ht);
             goto conv_s8_cleanup;
         }
         printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
-               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]"ANSI_COLOR_RESET,
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), dilation: (%d, %d)]"ANSI_COLOR_RESET,
                itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
-               out_channels, filter_wd, filter_ht, in_channels);
+               out_channels, filter_wd, filter_ht, filter_ch, dilation_wd, dilation_ht);
         printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
 
     conv_s8_cleanup:
@@ -811,3 +954,1921 @@ void esp_nn_conv_s8_test()
         }
     }
 }
+
+/* padded 3x3 conv split by rows over workers vs the unsplit call: the last parts
+ * have no padding.height of their own but still reach past the input */
+void esp_nn_conv_s8_workers_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL, *filter_data = NULL;
+    int8_t *out_data_c = NULL, *out_data_opt = NULL;
+    int32_t *bias = NULL, *out_shift = NULL, *out_mult = NULL;
+    esp_nn_requant_t *plan = NULL;
+    void *scratch_buf = NULL;
+    void *worker_scratch[ESP_NN_MAX_WORKERS] = {0};
+    esp_nn_ctx_t ctx[ESP_NN_MAX_WORKERS] = {0};
+
+    /* independent variables */
+    int in_wd, in_ht, in_channels, out_channels, num_workers;
+    uint16_t stride_wd, stride_ht, out_wd, out_ht, pad_wd = 1, pad_ht = 1;
+    const uint16_t filter_wd = 3, filter_ht = 3;
+    bool with_plan = false;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 5; itr++) {
+        switch (itr) {
+        case 0: // ch % 16 == 0, 2 parts
+            in_wd = 10;
+            in_ht = 10;
+            in_channels = 16;
+            out_channels = 16;
+            stride_wd = 1;
+            stride_ht = 1;
+            num_workers = 2;
+            break;
+        case 1: // stride (2, 2), odd input, last part ends in the bottom padding
+            in_wd = 11;
+            in_ht = 9;
+            in_channels = 16;
+            out_channels = 8;
+            stride_wd = 2;
+            stride_ht = 2;
+            num_workers = 3;
+            break;
+        case 2: // ch == 3
+            in_wd = 12;
+            in_ht = 12;
+            in_channels = 3;
+            out_channels = 16;
+            stride_wd = 1;
+            stride_ht = 1;
+            num_workers = 4;
+            break;
+        case 3: // ch % 8 == 0, one output row per part at the bottom
+            in_wd = 9;
+            in_ht = 7;
+            in_channels = 8;
+            out_channels = 24;
+            stride_wd = 1;
+            stride_ht = 1;
+            num_workers = 4;
+            break;
+        default: // single output pixel, split by channels, with a requantisation plan
+            in_wd = 3;
+            in_ht = 3;
+            in_channels = 16;
+            out_channels = 40;
+            stride_wd = 1;
+            stride_ht = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            num_workers = 3;
+            with_plan = true;
+            break;
+        }
+
+        out_wd = (in_wd + 2 * pad_wd - filter_wd) / stride_wd + 1;
+        out_ht = (in_ht + 2 * pad_ht - filter_ht) / stride_ht + 1;
+
+        int in_size = in_wd * in_ht * in_channels;
+        int filter_size = filter_wd * filter_ht * in_channels * out_channels;
+        int out_size = out_wd * out_ht * out_channels;
+
+        int8_t *input_orig = ESP_NN_TEST_ALLOC(in_size + 16);
+        int8_t *out_c_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        int8_t *out_opt_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        filter_data = ESP_NN_TEST_ALLOC(filter_size + 16);
+        bias = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_shift = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_mult = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        plan = ESP_NN_TEST_ALLOC(esp_nn_get_requant_plan_size(out_channels));
+
+        if (input_orig == NULL || filter_data == NULL || out_c_orig == NULL || out_opt_orig == NULL ||
+                bias == NULL || out_shift == NULL || out_mult == NULL || plan == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto conv_workers_cleanup;
+        }
+
+        input = (int8_t *) (((uintptr_t) input_orig + 15) & ~15);
+        out_data_c = (int8_t *) (((uintptr_t) out_c_orig + 15) & ~15);
+        out_data_opt = (int8_t *) (((uintptr_t) out_opt_orig + 15) & ~15);
+
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 255 - 128;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = (int32_t)rand() % UINT16_MAX + UINT8_MAX;
+            out_shift[i] = with_plan ? -12 + rand() % 5 : -10 + rand() % 2;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, 1};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, 1};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = in_channels, 1};
+        conv_params_t conv_params = {.in_offset = 5, .out_offset = 3,
+                                    .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                    .dilation = {0, 0}, .activation = {-125, 122}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+        quant_plan_data_t plan_quant = {.shift = out_shift, .mult = out_mult,
+                                        .plan = esp_nn_requant_plan_init(plan, &quant_data,
+                                                                         out_channels)};
+
+        int scratch_buf_size = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
+                                                            &output_dims, &conv_params);
+        if (scratch_buf_size > 0) {
+            scratch_buf = ESP_NN_TEST_ALLOC(scratch_buf_size + 16);
+            if (scratch_buf == NULL) {
+                printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %d\n"ANSI_COLOR_RESET,
+                       itr, scratch_buf_size);
+                goto conv_workers_cleanup;
+            }
+            esp_nn_set_conv_scratch_buf((void *) (((uintptr_t) scratch_buf + 15) & ~15));
+        }
+
+        int worker_scratch_size = esp_nn_get_conv_workers_scratch_size(num_workers, &input_dims,
+                                                                       &filter_dims, &output_dims,
+                                                                       &conv_params);
+        for (int w = 0; w < num_workers; w++) {
+            worker_scratch[w] = ESP_NN_TEST_ALLOC(worker_scratch_size + 16);
+            if (worker_scratch[w] == NULL) {
+                printf(ANSI_COLOR_RED"[%3d] worker scratch alloc failed size %d\n"ANSI_COLOR_RESET,
+                       itr, worker_scratch_size);
+                goto conv_workers_cleanup;
+            }
+            ctx[w].scratch = (void *) (((uintptr_t) worker_scratch[w] + 15) & ~15);
+        }
+        /* no backend: the parts run one after the other on this task */
+        esp_nn_workers_t workers = {.num_workers = num_workers, .ctx = ctx, .backend = NULL};
+
+        /* unsplit call */
+        profile_c_start();
+        esp_nn_conv_s8(&input_dims, input, &filter_dims, filter_data,
+                       bias, &output_dims, out_data_c, &conv_params, &quant_data);
+        total_c = profile_c_end();
+
+        /* split call */
+        profile_opt_start();
+        if (with_plan) {
+            esp_nn_conv_s8_workers_plan(&workers, &input_dims, input, &filter_dims, filter_data,
+                                        bias, &output_dims, out_data_opt, &conv_params,
+                                        &plan_quant);
+        } else {
+            esp_nn_conv_s8_workers(&workers, &input_dims, input, &filter_dims, filter_data,
+                                   bias, &output_dims, out_data_opt, &conv_params, &quant_data);
+        }
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [workers: %d, stride: (%d, %d)"
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]\n"ANSI_COLOR_RESET,
+                   itr, num_workers, stride_wd, stride_ht, out_wd, out_ht,
+                   out_channels, filter_wd, filter_ht, in_channels);
+            goto conv_workers_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [workers: %d, stride: (%d, %d)"
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]"ANSI_COLOR_RESET,
+               itr, num_workers, stride_wd, stride_ht, out_wd, out_ht,
+               out_channels, filter_wd, filter_ht, in_channels);
+        printf("\tcycles: unsplit %8"PRIu32", split %8"PRIu32"\n", total_c, total_opt);
+
+    conv_workers_cleanup:
+        if (input_orig) {
+            free(input_orig);
+        }
+        if (filter_data) {
+            free(filter_data);
+        }
+        if (out_c_orig) {
+            free(out_c_orig);
+        }
+        if (out_opt_orig) {
+            free(out_opt_orig);
+        }
+        if (bias) {
+            free(bias);
+        }
+        if (out_shift) {
+            free(out_shift);
+        }
+        if (out_mult) {
+            free(out_mult);
+        }
+        if (plan) {
+            free(plan);
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+        for (int w = 0; w < ESP_NN_MAX_WORKERS; w++) {
+            if (worker_scratch[w]) {
+                free(worker_scratch[w]);
+                worker_scratch[w] = NULL;
+            }
+        }
+    }
+}
+
+/* frames pushed a row at a time through a conv stream vs one call on the whole frame */
+void esp_nn_conv_s8_stream_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL, *filter_data = NULL;
+    int8_t *out_data_c = NULL, *out_data_opt = NULL;
+    int32_t *bias = NULL, *out_shift = NULL, *out_mult = NULL;
+    void *scratch_buf = NULL, *stream_scratch = NULL, *stream_blob = NULL;
+
+    /* independent variables */
+    int in_wd, in_ht, in_channels, out_channels;
+    uint16_t filter_wd, filter_ht, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 4; itr++) {
+        switch (itr) {
+        case 0: // 3x3, pad (1, 1): the last rows are in the bottom padding
+            in_wd = 10;
+            in_ht = 10;
+            in_channels = 16;
+            out_channels = 16;
+            filter_wd = 3;
+            filter_ht = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 1: // 3x3, pad (1, 1), stride (2, 2), odd input
+            in_wd = 11;
+            in_ht = 9;
+            in_channels = 8;
+            out_channels = 8;
+            filter_wd = 3;
+            filter_ht = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 2: // ch == 3, 3x3, pad (0, 0)
+            in_wd = 12;
+            in_ht = 8;
+            in_channels = 3;
+            out_channels = 16;
+            filter_wd = 3;
+            filter_ht = 3;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        default: // 1x1: one output row per input row
+            in_wd = 8;
+            in_ht = 6;
+            in_channels = 16;
+            out_channels = 24;
+            filter_wd = 1;
+            filter_ht = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        }
+
+        if (pad_wd) {
+            out_wd = (in_wd + stride_wd - 1) / stride_wd;
+        } else {
+            out_wd = (in_wd + stride_wd - filter_wd) / stride_wd;
+        }
+        if (pad_ht) {
+            out_ht = (in_ht + stride_ht - 1) / stride_ht;
+        } else {
+            out_ht = (in_ht + stride_ht - filter_ht) / stride_ht;
+        }
+
+        int in_row_size = in_wd * in_channels;
+        int in_size = in_row_size * in_ht;
+        int filter_size = filter_wd * filter_ht * in_channels * out_channels;
+        int out_row_size = out_wd * out_channels;
+        int out_size = out_row_size * out_ht;
+
+        int8_t *input_orig = ESP_NN_TEST_ALLOC(in_size + 16);
+        int8_t *out_c_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        int8_t *out_opt_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        filter_data = ESP_NN_TEST_ALLOC(filter_size + 16);
+        bias = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_shift = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_mult = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+
+        if (input_orig == NULL || filter_data == NULL || out_c_orig == NULL ||
+                out_opt_orig == NULL || bias == NULL || out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto conv_stream_cleanup;
+        }
+
+        input = (int8_t *) (((uintptr_t) input_orig + 15) & ~15);
+        out_data_c = (int8_t *) (((uintptr_t) out_c_orig + 15) & ~15);
+        out_data_opt = (int8_t *) (((uintptr_t) out_opt_orig + 15) & ~15);
+
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = (int32_t)rand() % UINT16_MAX + UINT8_MAX;
+            out_shift[i] = -10 + rand() % 2;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, 1};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, 1};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = in_channels, 1};
+        conv_params_t conv_params = {.in_offset = 5, .out_offset = 3,
+                                    .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                    .dilation = {0, 0}, .activation = {-125, 122}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+
+        int scratch_buf_size = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
+                                                            &output_dims, &conv_params);
+        if (scratch_buf_size > 0) {
+            scratch_buf = ESP_NN_TEST_ALLOC(scratch_buf_size + 16);
+            if (scratch_buf == NULL) {
+                printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %d\n"ANSI_COLOR_RESET,
+                       itr, scratch_buf_size);
+                goto conv_stream_cleanup;
+            }
+            esp_nn_set_conv_scratch_buf((void *) (((uintptr_t) scratch_buf + 15) & ~15));
+        }
+
+        int stream_size = esp_nn_get_conv_stream_size(&input_dims, &filter_dims, &conv_params);
+        int stream_scratch_size = esp_nn_get_conv_stream_scratch_size(&input_dims, &filter_dims,
+                                                                      &output_dims, &conv_params);
+        stream_blob = ESP_NN_TEST_ALLOC(stream_size + 16);
+        stream_scratch = ESP_NN_TEST_ALLOC(stream_scratch_size + 16);
+        if (stream_blob == NULL || stream_scratch == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] stream alloc failed size %d + %d\n"ANSI_COLOR_RESET,
+                   itr, stream_size, stream_scratch_size);
+            goto conv_stream_cleanup;
+        }
+        esp_nn_ctx_t ctx = {.scratch = (void *) (((uintptr_t) stream_scratch + 15) & ~15)};
+        esp_nn_conv_stream_t *stream =
+            esp_nn_conv_stream_init((void *) (((uintptr_t) stream_blob + 15) & ~15),
+                                    &input_dims, &filter_dims, filter_data, bias,
+                                    &output_dims, &conv_params, &quant_data);
+
+        /* two frames through the same stream: the first one ending resets it for the next */
+        bool ret = true;
+        for (int frame = 0; frame < 2 && ret; frame++) {
+            for (int i = 0; i < in_size; ++i) {
+                input[i] = rand() % 255 - 128;
+            }
+
+            profile_c_start();
+            esp_nn_conv_s8(&input_dims, input, &filter_dims, filter_data,
+                           bias, &output_dims, out_data_c, &conv_params, &quant_data);
+            total_c = profile_c_end();
+
+            profile_opt_start();
+            int rows_out = 0;
+            for (int row = 0; row < in_ht; row++) {
+                rows_out += esp_nn_conv_stream_push(&ctx, stream, input + row * in_row_size,
+                                                    out_data_opt + rows_out * out_row_size);
+            }
+            total_opt = profile_opt_end();
+
+            ret = rows_out == out_ht && CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        }
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]\n"ANSI_COLOR_RESET,
+                   itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+                   out_channels, filter_wd, filter_ht, in_channels);
+            goto conv_stream_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]"ANSI_COLOR_RESET,
+               itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+               out_channels, filter_wd, filter_ht, in_channels);
+        printf("\tcycles: frame %8"PRIu32", rows %8"PRIu32"\n", total_c, total_opt);
+
+    conv_stream_cleanup:
+        if (input_orig) {
+            free(input_orig);
+        }
+        if (filter_data) {
+            free(filter_data);
+        }
+        if (out_c_orig) {
+            free(out_c_orig);
+        }
+        if (out_opt_orig) {
+            free(out_opt_orig);
+        }
+        if (bias) {
+            free(bias);
+        }
+        if (out_shift) {
+            free(out_shift);
+        }
+        if (out_mult) {
+            free(out_mult);
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+        if (stream_blob) {
+            free(stream_blob);
+            stream_blob = NULL;
+        }
+        if (stream_scratch) {
+            free(stream_scratch);
+            stream_scratch = NULL;
+        }
+    }
+}
+
+/* conv with the tiles staged through the memcpy mover vs ANSI: a tile read
+ * before it is waited for holds the previous tile's rows and fails the compare */
+void esp_nn_conv_s8_mover_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL, *filter_data = NULL;
+    int8_t *out_data_c = NULL, *out_data_opt = NULL;
+    int32_t *bias = NULL, *out_shift = NULL, *out_mult = NULL;
+    void *scratch_buf = NULL;
+    esp_nn_tile_mover_t mover;
+
+    /* independent variables */
+    int in_wd, in_ht, in_channels, out_channels;
+    uint16_t stride_wd, stride_ht, out_wd, out_ht;
+    const uint16_t filter_wd = 3, filter_ht = 3, pad_wd = 1, pad_ht = 1;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    if (esp_nn_tile_mover_memcpy_init(&mover) != 0) {
+        printf(ANSI_COLOR_RED"mover init failed\n"ANSI_COLOR_RESET);
+        return;
+    }
+    for (int itr = 0; itr < 4; itr++) {
+        switch (itr) {
+        case 0: // input fits the tile budget, a single tile
+            in_wd = 10;
+            in_ht = 10;
+            in_channels = 16;
+            out_channels = 16;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 1: // strips, stride (2, 2)
+            in_wd = 45;
+            in_ht = 61;
+            in_channels = 16;
+            out_channels = 16;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 2: // strips with a folded filter
+            in_wd = 40;
+            in_ht = 37;
+            in_channels = 32;
+            out_channels = 64;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        default: // strips, stride (1, 1)
+            in_wd = 64;
+            in_ht = 40;
+            in_channels = 16;
+            out_channels = 8;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        }
+
+        out_wd = (in_wd + stride_wd - 1) / stride_wd;
+        out_ht = (in_ht + stride_ht - 1) / stride_ht;
+
+        int in_size = in_wd * in_ht * in_channels;
+        int filter_size = filter_wd * filter_ht * in_channels * out_channels;
+        int out_size = out_wd * out_ht * out_channels;
+
+        int8_t *input_orig = ESP_NN_TEST_ALLOC(in_size + 16);
+        int8_t *out_c_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        int8_t *out_opt_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        filter_data = ESP_NN_TEST_ALLOC(filter_size + 16);
+        bias = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_shift = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_mult = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+
+        if (input_orig == NULL || filter_data == NULL || out_c_orig == NULL ||
+                out_opt_orig == NULL || bias == NULL || out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto conv_mover_cleanup;
+        }
+
+        input = (int8_t *) (((uintptr_t) input_orig + 15) & ~15);
+        out_data_c = (int8_t *) (((uintptr_t) out_c_orig + 15) & ~15);
+        out_data_opt = (int8_t *) (((uintptr_t) out_opt_orig + 15) & ~15);
+
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 255 - 128;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = (int32_t)rand() % UINT16_MAX + UINT8_MAX;
+            out_shift[i] = -10 + rand() % 2;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, 1};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, 1};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = in_channels, 1};
+        conv_params_t conv_params = {.in_offset = 5, .out_offset = 3,
+                                    .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                    .dilation = {0, 0}, .activation = {-125, 122}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+
+        int scratch_buf_size = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
+                                                            &output_dims, &conv_params);
+        scratch_buf = ESP_NN_TEST_ALLOC(scratch_buf_size + 16);
+        if (scratch_buf == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %d\n"ANSI_COLOR_RESET,
+                   itr, scratch_buf_size);
+            goto conv_mover_cleanup;
+        }
+        esp_nn_ctx_t ctx = {.scratch = (void *) (((uintptr_t) scratch_buf + 15) & ~15),
+                            .mover = &mover};
+
+        profile_c_start();
+        esp_nn_conv_s8_ansi(&input_dims, input, &filter_dims, filter_data,
+                            bias, &output_dims, out_data_c, &conv_params, &quant_data);
+        total_c = profile_c_end();
+
+        profile_opt_start();
+        esp_nn_conv_s8_ctx(&ctx, &input_dims, input, &filter_dims, filter_data,
+                           bias, &output_dims, out_data_opt, &conv_params, &quant_data);
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]\n"ANSI_COLOR_RESET,
+                   itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+                   out_channels, filter_wd, filter_ht, in_channels);
+            goto conv_mover_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d)]"ANSI_COLOR_RESET,
+               itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+               out_channels, filter_wd, filter_ht, in_channels);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    conv_mover_cleanup:
+        if (input_orig) {
+            free(input_orig);
+        }
+        if (filter_data) {
+            free(filter_data);
+        }
+        if (out_c_orig) {
+            free(out_c_orig);
+        }
+        if (out_opt_orig) {
+            free(out_opt_orig);
+        }
+        if (bias) {
+            free(bias);
+        }
+        if (out_shift) {
+            free(out_shift);
+        }
+        if (out_mult) {
+            free(out_mult);
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+    }
+    esp_nn_tile_mover_memcpy_deinit(&mover);
+}
+
+/*
+ * Scratch sizes: every conv path runs on exactly the reported scratch, put
+ * at a different misalignment each time where the target allows it, and the
+ * bytes past what it may touch must keep their canary. With the scratch guard on, the last
+ * ESP_NN_SCRATCH_GUARD_SIZE bytes reported are the guard and are checked too.
+ */
+#define SCRATCH_TEST_CANARY     0xa5    /* same fill as the library guard */
+#define SCRATCH_TEST_TAIL       32
+#if ARCH_ESP32_P4
+#define SCRATCH_TEST_MISALIGN(itr)  0   /* the P4 kernels take a 16 byte aligned scratch */
+#else
+#define SCRATCH_TEST_MISALIGN(itr)  (((itr) * 5) & 15)
+#endif
+
+void esp_nn_conv_s8_scratch_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL, *filter_data = NULL;
+    int8_t *out_data_c = NULL, *out_data_opt = NULL;
+    int32_t *bias = NULL, *out_shift = NULL, *out_mult = NULL;
+    uint8_t *scratch_buf = NULL;
+
+    const struct {
+        const char *path;   // ESP32-S3 path the shape takes
+        int in_wd, in_ht, in_ch, filter_ch, out_ch, batches;
+        uint16_t filter_wd, filter_ht, pad, stride, dilation;
+    } cases[] = {
+        {"1x1 mult8",           10, 10, 16, 16, 32, 1, 1, 1, 0, 1, 1},
+        {"1x1 mult8, 2 images",  6,  6, 16, 16, 16, 2, 1, 1, 0, 1, 1},
+        {"1x1 mult8, < 8 px",    2,  2,  8,  8,  8, 1, 1, 1, 0, 1, 1},
+        {"1x1",                  8,  8, 12, 12, 16, 1, 1, 1, 0, 1, 1},
+        {"im2col",              12, 12,  3,  3, 16, 1, 3, 3, 1, 1, 1},
+        {"im2col, dilated",     12, 12,  8,  8, 16, 1, 3, 3, 2, 1, 2},
+        {"general",             10, 10, 16, 16, 16, 1, 3, 3, 1, 1, 1},
+        {"general, folded",     10, 10, 32, 32, 64, 1, 3, 3, 1, 2, 1},
+        {"general, strips",     24, 24, 64, 64, 64, 1, 3, 3, 1, 1, 1},
+        {"grouped",             10, 10, 16,  8, 16, 1, 3, 3, 1, 1, 1},
+    };
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < (int) (sizeof(cases) / sizeof(cases[0])); itr++) {
+        const int in_wd = cases[itr].in_wd, in_ht = cases[itr].in_ht;
+        const int in_ch = cases[itr].in_ch, out_ch = cases[itr].out_ch;
+        const int filter_ch = cases[itr].filter_ch, batches = cases[itr].batches;
+        const uint16_t filter_wd = cases[itr].filter_wd, filter_ht = cases[itr].filter_ht;
+        const uint16_t pad = cases[itr].pad, stride = cases[itr].stride;
+        const uint16_t dilation = cases[itr].dilation;
+        const int out_wd = (in_wd + 2 * pad - dilation * (filter_wd - 1) - 1) / stride + 1;
+        const int out_ht = (in_ht + 2 * pad - dilation * (filter_ht - 1) - 1) / stride + 1;
+
+        const int in_size = in_wd * in_ht * in_ch * batches;
+        const int filter_size = filter_wd * filter_ht * filter_ch * out_ch;
+        const int out_size = out_wd * out_ht * out_ch * batches;
+
+        input = ESP_NN_TEST_ALLOC(in_size);
+        filter_data = ESP_NN_TEST_ALLOC(filter_size);
+        out_data_c = ESP_NN_TEST_ALLOC(out_size);
+        out_data_opt = ESP_NN_TEST_ALLOC(out_size);
+        bias = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_ch);
+        out_shift = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_ch);
+        out_mult = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_ch);
+
+        if (input == NULL || filter_data == NULL || out_data_c == NULL ||
+                out_data_opt == NULL || bias == NULL || out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto conv_scratch_cleanup;
+        }
+
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_ch; ++i) {
+            bias[i] = (int32_t)rand() % UINT16_MAX + UINT8_MAX;
+            out_shift[i] = -10 + rand() % 2;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_ch, batches};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_ch, batches};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = filter_ch, 1};
+        conv_params_t conv_params = {.in_offset = 5, .out_offset = 3,
+                                     .stride = {stride, stride}, .padding = {pad, pad},
+                                     .dilation = {dilation, dilation}, .activation = {-125, 122}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+
+        const int scratch_size = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims,
+                                                              &output_dims, &conv_params);
+        const int kernel_size = scratch_size - ESP_NN_SCRATCH_GUARD_SIZE;
+        const int misalign = SCRATCH_TEST_MISALIGN(itr);
+        scratch_buf = ESP_NN_TEST_ALLOC(15 + misalign + scratch_size + SCRATCH_TEST_TAIL);
+        if (scratch_buf == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %d\n"ANSI_COLOR_RESET,
+                   itr, scratch_size);
+            goto conv_scratch_cleanup;
+        }
+        uint8_t *scratch = (uint8_t *) (((uintptr_t) scratch_buf + 15) & ~15) + misalign;
+        memset(scratch, 0, kernel_size);
+        memset(scratch + kernel_size, SCRATCH_TEST_CANARY,
+               ESP_NN_SCRATCH_GUARD_SIZE + SCRATCH_TEST_TAIL);
+        esp_nn_ctx_t ctx = {.scratch = scratch, .mover = NULL};
+
+        profile_c_start();
+        esp_nn_conv_s8_ansi(&input_dims, input, &filter_dims, filter_data,
+                            bias, &output_dims, out_data_c, &conv_params, &quant_data);
+        total_c = profile_c_end();
+
+        profile_opt_start();
+        esp_nn_conv_s8_ctx(&ctx, &input_dims, input, &filter_dims, filter_data,
+                           bias, &output_dims, out_data_opt, &conv_params, &quant_data);
+        total_opt = profile_opt_end();
+
+        int overrun = -1;
+        for (int i = 0; i < ESP_NN_SCRATCH_GUARD_SIZE + SCRATCH_TEST_TAIL; i++) {
+            if (scratch[kernel_size + i] != SCRATCH_TEST_CANARY) {
+                overrun = i;
+                break;
+            }
+        }
+        if (overrun >= 0) {
+            printf(ANSI_COLOR_RED"[%3d] failed [%s]: scratch written %d bytes past the %d"
+                   " reported\n"ANSI_COLOR_RESET, itr, cases[itr].path, overrun, kernel_size);
+            goto conv_scratch_cleanup;
+        }
+        if (CHECK_EQUAL(out_data_c, out_data_opt, out_size) == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [%s]: output differs\n"ANSI_COLOR_RESET,
+                   itr, cases[itr].path);
+            goto conv_scratch_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [%s, scratch %5d, misaligned by %2d]"ANSI_COLOR_RESET,
+               itr, cases[itr].path, scratch_size, misalign);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    conv_scratch_cleanup:
+        if (input) {
+            free(input);
+            input = NULL;
+        }
+        if (filter_data) {
+            free(filter_data);
+            filter_data = NULL;
+        }
+        if (out_data_c) {
+            free(out_data_c);
+            out_data_c = NULL;
+        }
+        if (out_data_opt) {
+            free(out_data_opt);
+            out_data_opt = NULL;
+        }
+        if (bias) {
+            free(bias);
+            bias = NULL;
+        }
+        if (out_shift) {
+            free(out_shift);
+            out_shift = NULL;
+        }
+        if (out_mult) {
+            free(out_mult);
+            out_mult = NULL;
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+    }
+}
+
+/* transpose conv, plain and prepared, vs the reference: strides the filter
+ * is not a multiple of, channels off the SIMD width, no bias and two images */
+void esp_nn_transpose_conv_s8_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL, *filter_data = NULL;
+    int8_t *out_data_c = NULL, *out_data_opt = NULL;
+    int32_t *bias = NULL, *out_shift = NULL, *out_mult = NULL;
+    void *scratch_buf = NULL, *prepared_buf = NULL;
+
+    /* independent variables */
+    int in_wd, in_ht, in_channels, out_channels, batches, with_bias;
+    uint16_t filter_wd, filter_ht, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 5; itr++) {
+        batches = 1;
+        with_bias = 1;
+
+        switch (itr) {
+        case 0: // 16 channels: taps on the SIMD dot product
+            in_wd = 8;
+            in_ht = 8;
+            in_channels = 16;
+            out_channels = 16;
+            filter_wd = 3;
+            filter_ht = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 1: // 3 channels, filter (4, 4)
+            in_wd = 7;
+            in_ht = 5;
+            in_channels = 3;
+            out_channels = 8;
+            filter_wd = 4;
+            filter_ht = 4;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 2: // filter == stride, no padding and no bias
+            in_wd = 6;
+            in_ht = 6;
+            in_channels = 32;
+            out_channels = 8;
+            filter_wd = 2;
+            filter_ht = 2;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 2;
+            stride_ht = 2;
+            with_bias = 0;
+            break;
+        case 3: // two images, stride (1, 1)
+            in_wd = 5;
+            in_ht = 4;
+            in_channels = 16;
+            out_channels = 12;
+            filter_wd = 3;
+            filter_ht = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            batches = 2;
+            break;
+        default: // stride (3, 2), filter (5, 3)
+            in_wd = 4;
+            in_ht = 6;
+            in_channels = 8;
+            out_channels = 4;
+            filter_wd = 5;
+            filter_ht = 3;
+            pad_wd = 2;
+            pad_ht = 1;
+            stride_wd = 3;
+            stride_ht = 2;
+            break;
+        }
+
+        out_wd = (in_wd - 1) * stride_wd + filter_wd - 2 * pad_wd;
+        out_ht = (in_ht - 1) * stride_ht + filter_ht - 2 * pad_ht;
+
+        int in_size = in_wd * in_ht * in_channels * batches;
+        int filter_size = filter_wd * filter_ht * in_channels * out_channels;
+        int out_size = out_wd * out_ht * out_channels * batches;
+
+        int8_t *input_orig = ESP_NN_TEST_ALLOC(in_size + 16);
+        int8_t *out_c_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        int8_t *out_opt_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        int8_t *filter_orig = ESP_NN_TEST_ALLOC(filter_size + 16);
+        bias = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_shift = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+        out_mult = ESP_NN_TEST_ALLOC(sizeof (int32_t) * out_channels);
+
+        if (input_orig == NULL || filter_orig == NULL || out_c_orig == NULL ||
+                out_opt_orig == NULL || bias == NULL || out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto transpose_conv_cleanup;
+        }
+
+        input = (int8_t *) (((uintptr_t) input_orig + 15) & ~15);
+        filter_data = (int8_t *) (((uintptr_t) filter_orig + 15) & ~15);
+        out_data_c = (int8_t *) (((uintptr_t) out_c_orig + 15) & ~15);
+        out_data_opt = (int8_t *) (((uintptr_t) out_opt_orig + 15) & ~15);
+
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 255 - 128;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = (int32_t)rand() % UINT16_MAX + UINT8_MAX;
+            out_shift[i] = -10 + rand() % 2;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, batches};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, batches};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = in_channels, 1};
+        conv_params_t conv_params = {.in_offset = 5, .out_offset = 3,
+                                    .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                    .dilation = {0, 0}, .activation = {-125, 122}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+        const int32_t *layer_bias = with_bias ? bias : NULL;
+
+        int scratch_buf_size = esp_nn_get_transpose_conv_scratch_size(&input_dims, &filter_dims,
+                                                                      &output_dims, &conv_params);
+        int prepared_size = esp_nn_get_transpose_conv_prepared_size(&input_dims, &filter_dims,
+                                                                    &output_dims, &conv_params);
+        scratch_buf = ESP_NN_TEST_ALLOC(scratch_buf_size + 16);
+        prepared_buf = ESP_NN_TEST_ALLOC(prepared_size + 16);
+        if (scratch_buf == NULL || prepared_buf == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] scratch alloc failed size %d, prepared %d\n"ANSI_COLOR_RESET,
+                   itr, scratch_buf_size, prepared_size);
+            goto transpose_conv_cleanup;
+        }
+        esp_nn_ctx_t ctx = {.scratch = (void *) (((uintptr_t) scratch_buf + 15) & ~15)};
+
+        profile_c_start();
+        esp_nn_transpose_conv_s8_ansi(&ctx, &input_dims, input, &filter_dims, filter_data,
+                                      layer_bias, &output_dims, out_data_c, &conv_params, &quant_data);
+        total_c = profile_c_end();
+
+        profile_opt_start();
+        esp_nn_transpose_conv_s8(&ctx, &input_dims, input, &filter_dims, filter_data,
+                                 layer_bias, &output_dims, out_data_opt, &conv_params, &quant_data);
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        if (ret == true) {
+            /* prepared: the tap terms come from the blob, no scratch */
+            const esp_nn_ctx_t no_scratch_ctx = {0};
+            const esp_nn_conv_prepared_t *prep =
+                esp_nn_transpose_conv_s8_prepare((void *) (((uintptr_t) prepared_buf + 15) & ~15),
+                                                 &input_dims, &filter_dims, filter_data, layer_bias,
+                                                 &output_dims, &conv_params, &quant_data);
+            memset(out_data_opt, 0, out_size);
+            esp_nn_transpose_conv_s8_run(&no_scratch_ctx, prep, input, out_data_opt);
+            ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        }
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), batches %d]\n"ANSI_COLOR_RESET,
+                   itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+                   out_channels, filter_wd, filter_ht, in_channels, batches);
+            goto transpose_conv_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), batches %d]"ANSI_COLOR_RESET,
+               itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+               out_channels, filter_wd, filter_ht, in_channels, batches);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    transpose_conv_cleanup:
+        if (input_orig) {
+            free(input_orig);
+        }
+        if (filter_orig) {
+            free(filter_orig);
+        }
+        if (out_c_orig) {
+            free(out_c_orig);
+        }
+        if (out_opt_orig) {
+            free(out_opt_orig);
+        }
+        if (bias) {
+            free(bias);
+        }
+        if (out_shift) {
+            free(out_shift);
+        }
+        if (out_mult) {
+            free(out_mult);
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+        if (prepared_buf) {
+            free(prepared_buf);
+            prepared_buf = NULL;
+        }
+    }
+}
+
+void esp_nn_conv_s16_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int16_t *input = NULL;
+    int16_t *out_data_c = NULL;
+    int16_t *out_data_opt = NULL;
+    int8_t *filter_data = NULL;
+    int64_t *bias = NULL;
+    int32_t *out_shift = NULL;
+    int32_t *out_mult = NULL;
+
+    /* independent variable */
+    int in_wd, in_ht, in_channels, out_channels, filter_ch, batches, with_bias;
+    uint16_t filter_ht, filter_wd, out_wd, out_ht;
+    uint16_t pad_wd, pad_ht, stride_wd, stride_ht;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 6; itr++) {
+        filter_ch = 0; /* in_channels unless the case groups */
+        batches = 1;
+        with_bias = 1;
+
+        switch (itr) {
+        case 0: // 3x3, pad (1, 1)
+            in_wd = 8;
+            in_ht = 8;
+            in_channels = 16;
+            out_channels = 16;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 1: // 1x1, odd channels
+            in_wd = 6;
+            in_ht = 5;
+            in_channels = 7;
+            out_channels = 10;
+            filter_ht = 1;
+            filter_wd = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 2: // ch == 3, stride (2, 2), no bias
+            in_wd = 11;
+            in_ht = 9;
+            in_channels = 3;
+            out_channels = 8;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 2;
+            stride_ht = 2;
+            with_bias = 0;
+            break;
+        case 3: // filter rows longer than an int32 chunk of the dot product
+            in_wd = 6;
+            in_ht = 4;
+            in_channels = 128;
+            out_channels = 4;
+            filter_ht = 3;
+            filter_wd = 5;
+            pad_wd = 2;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 4: // grouped, groups of 4 channels
+            in_wd = 5;
+            in_ht = 5;
+            in_channels = 8;
+            filter_ch = 4;
+            out_channels = 6;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        default: // two images
+            in_wd = 7;
+            in_ht = 6;
+            in_channels = 8;
+            out_channels = 8;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 2;
+            stride_ht = 2;
+            batches = 2;
+            break;
+        }
+        if (filter_ch == 0) {
+            filter_ch = in_channels;
+        }
+        if (pad_wd) {
+            out_wd = (in_wd + stride_wd - 1) / stride_wd;
+        } else {
+            out_wd = (in_wd + stride_wd - filter_wd) / stride_wd;
+        }
+        if (pad_ht) {
+            out_ht = (in_ht + stride_ht - 1) / stride_ht;
+        } else {
+            out_ht = (in_ht + stride_ht - filter_ht) / stride_ht;
+        }
+
+        int in_size = in_wd * in_ht * in_channels * batches;
+        int filter_size = filter_wd * filter_ht * filter_ch * out_channels;
+        int out_size = out_wd * out_ht * out_channels * batches;
+
+        input = ESP_NN_TEST_ALLOC(in_size * sizeof(int16_t));
+        out_data_c = ESP_NN_TEST_ALLOC(out_size * sizeof(int16_t));
+        out_data_opt = ESP_NN_TEST_ALLOC(out_size * sizeof(int16_t));
+        filter_data = ESP_NN_TEST_ALLOC(filter_size);
+        bias = ESP_NN_TEST_ALLOC(out_channels * sizeof(int64_t));
+        out_shift = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+        out_mult = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+
+        if (input == NULL || out_data_c == NULL || out_data_opt == NULL || filter_data == NULL ||
+                bias == NULL || out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto conv_s16_cleanup;
+        }
+
+        /* int16 activations over their whole range */
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 65536 - 32768;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = (int64_t) (rand() % 2000001 - 1000000) * 10;
+            out_shift[i] = -12 + rand() % 3;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, batches};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, batches};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = filter_ch, 0};
+        conv_params_t conv_params = {.in_offset = 0, .out_offset = 0,
+                                     .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                     .dilation = {1, 1}, .activation = {-32768, 32767}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* C function */
+        esp_nn_conv_s16_ansi(&input_dims, input, &filter_dims, filter_data, with_bias ? bias : NULL,
+                             &output_dims, out_data_c, &conv_params, &quant_data);
+
+        total_c = profile_c_end();
+        profile_opt_start();
+
+        /* Optimized function */
+        esp_nn_conv_s16(&input_dims, input, &filter_dims, filter_data, with_bias ? bias : NULL,
+                        &output_dims, out_data_opt, &conv_params, &quant_data);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), batches %d]\n"ANSI_COLOR_RESET,
+                   itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+                   out_channels, filter_wd, filter_ht, filter_ch, batches);
+            goto conv_s16_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), batches %d]"ANSI_COLOR_RESET,
+               itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+               out_channels, filter_wd, filter_ht, filter_ch, batches);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    conv_s16_cleanup:
+        if (input) {
+            free(input);
+            input = NULL;
+        }
+        if (out_data_c) {
+            free(out_data_c);
+            out_data_c = NULL;
+        }
+        if (out_data_opt) {
+            free(out_data_opt);
+            out_data_opt = NULL;
+        }
+        if (filter_data) {
+            free(filter_data);
+            filter_data = NULL;
+        }
+        if (bias) {
+            free(bias);
+            bias = NULL;
+        }
+        if (out_shift) {
+            free(out_shift);
+            out_shift = NULL;
+        }
+        if (out_mult) {
+            free(out_mult);
+            out_mult = NULL;
+        }
+    }
+}
+
+void esp_nn_depthwise_conv_s16_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int16_t *input = NULL;
+    int16_t *out_data_c = NULL;
+    int16_t *out_data_opt = NULL;
+    int8_t *filter_data = NULL;
+    int64_t *bias = NULL;
+    int32_t *out_shift = NULL;
+    int32_t *out_mult = NULL;
+
+    /* independent variables */
+    int input_wd, input_ht, channels, ch_mult, batches, with_bias;
+    uint16_t filter_ht, filter_wd, out_wd, out_ht;
+    uint16_t pad_wd, pad_ht, stride_wd, stride_ht;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 5; itr++) {
+        batches = 1;
+        with_bias = 1;
+
+        switch (itr) {
+        case 0: // 3x3, ch_mult 1, pad (1, 1)
+            input_wd = 9;
+            input_ht = 8;
+            channels = 16;
+            ch_mult = 1;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 1: // odd channels, stride (2, 2), no bias
+            input_wd = 10;
+            input_ht = 7;
+            channels = 5;
+            ch_mult = 1;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 2;
+            stride_ht = 2;
+            with_bias = 0;
+            break;
+        case 2: // ch_mult 2
+            input_wd = 6;
+            input_ht = 6;
+            channels = 4;
+            ch_mult = 2;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 3: // 5x5, no padding
+            input_wd = 9;
+            input_ht = 9;
+            channels = 8;
+            ch_mult = 1;
+            filter_ht = 5;
+            filter_wd = 5;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        default: // two images
+            input_wd = 6;
+            input_ht = 5;
+            channels = 8;
+            ch_mult = 1;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            batches = 2;
+            break;
+        }
+        if (pad_wd) {
+            out_wd = (input_wd + stride_wd - 1) / stride_wd;
+        } else {
+            out_wd = (input_wd + stride_wd - filter_wd) / stride_wd;
+        }
+        if (pad_ht) {
+            out_ht = (input_ht + stride_ht - 1) / stride_ht;
+        } else {
+            out_ht = (input_ht + stride_ht - filter_ht) / stride_ht;
+        }
+
+        const int out_channels = channels * ch_mult;
+        int in_size = input_wd * input_ht * channels * batches;
+        int filter_size = filter_wd * filter_ht * out_channels;
+        int out_size = out_wd * out_ht * out_channels * batches;
+
+        input = ESP_NN_TEST_ALLOC(in_size * sizeof(int16_t));
+        out_data_c = ESP_NN_TEST_ALLOC(out_size * sizeof(int16_t));
+        out_data_opt = ESP_NN_TEST_ALLOC(out_size * sizeof(int16_t));
+        filter_data = ESP_NN_TEST_ALLOC(filter_size);
+        bias = ESP_NN_TEST_ALLOC(out_channels * sizeof(int64_t));
+        out_shift = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+        out_mult = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+
+        if (input == NULL || out_data_c == NULL || out_data_opt == NULL || filter_data == NULL ||
+                bias == NULL || out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto dc_s16_cleanup;
+        }
+
+        /* int16 activations over their whole range */
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 65536 - 32768;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = rand() % 2000001 - 1000000;
+            out_shift[i] = -10 + rand() % 3;
+            out_mult[i] = 0x7eb0e200 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = input_wd, .height = input_ht, .channels = channels, batches};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, batches};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, 0, 0};
+        dw_conv_params_t conv_params = {.in_offset = 0, .out_offset = 0, .ch_mult = ch_mult,
+                                        .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                        .dilation = {1, 1}, .activation = {-32768, 32767}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* C function */
+        esp_nn_depthwise_conv_s16_ansi(&input_dims, input, &filter_dims, filter_data,
+                                       with_bias ? bias : NULL, &output_dims, out_data_c,
+                                       &conv_params, &quant_data);
+
+        total_c = profile_c_end();
+        profile_opt_start();
+
+        /* Optimized function */
+        esp_nn_depthwise_conv_s16(&input_dims, input, &filter_dims, filter_data,
+                                  with_bias ? bias : NULL, &output_dims, out_data_opt,
+                                  &conv_params, &quant_data);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(out_data_c, out_data_opt, out_size);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
+                   " out: (%3d,%3d), filter: (%d, %d,%3d), ch_mult %d, batches %d]\n"ANSI_COLOR_RESET,
+                   itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+                   filter_wd, filter_ht, channels, ch_mult, batches);
+            goto dc_s16_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
+               " out: (%3d,%3d), filter: (%d, %d,%3d), ch_mult %d, batches %d]"ANSI_COLOR_RESET,
+               itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+               filter_wd, filter_ht, channels, ch_mult, batches);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    dc_s16_cleanup:
+        if (input) {
+            free(input);
+            input = NULL;
+        }
+        if (out_data_c) {
+            free(out_data_c);
+            out_data_c = NULL;
+        }
+        if (out_data_opt) {
+            free(out_data_opt);
+            out_data_opt = NULL;
+        }
+        if (filter_data) {
+            free(filter_data);
+            filter_data = NULL;
+        }
+        if (bias) {
+            free(bias);
+            bias = NULL;
+        }
+        if (out_shift) {
+            free(out_shift);
+            out_shift = NULL;
+        }
+        if (out_mult) {
+            free(out_mult);
+            out_mult = NULL;
+        }
+    }
+}
+
+/*
+ * int4 weights: the weights are drawn in [-8, 7], so the int8 reference on
+ * the unpacked filter gives the expected output of the packed one.
+ */
+void esp_nn_conv_s4_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL;
+    int8_t *out_data_s8 = NULL;
+    int8_t *out_data_c = NULL;
+    int8_t *out_data_opt = NULL;
+    int8_t *filter_data = NULL;
+    int8_t *filter_packed = NULL;
+    int32_t *bias = NULL;
+    int32_t *out_shift = NULL;
+    int32_t *out_mult = NULL;
+
+    /* independent variable */
+    int in_wd, in_ht, in_channels, out_channels, batches;
+    uint16_t filter_ht, filter_wd, out_wd, out_ht;
+    uint16_t pad_wd, pad_ht, stride_wd, stride_ht;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 5; itr++) {
+        batches = 1;
+
+        switch (itr) {
+        case 0: // 1x1, whole blocks
+            in_wd = 8;
+            in_ht = 6;
+            in_channels = 64;
+            out_channels = 16;
+            filter_ht = 1;
+            filter_wd = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 1: // 1x1, a partial last block
+            in_wd = 5;
+            in_ht = 5;
+            in_channels = 45;
+            out_channels = 7;
+            filter_ht = 1;
+            filter_wd = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        case 2: // 1x1, stride (2, 2), fewer channels than half a block
+            in_wd = 9;
+            in_ht = 7;
+            in_channels = 12;
+            out_channels = 8;
+            filter_ht = 1;
+            filter_wd = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 2;
+            stride_ht = 2;
+            break;
+        case 3: // 3x3, pad (1, 1): the reference
+            in_wd = 6;
+            in_ht = 6;
+            in_channels = 8;
+            out_channels = 8;
+            filter_ht = 3;
+            filter_wd = 3;
+            pad_wd = 1;
+            pad_ht = 1;
+            stride_wd = 1;
+            stride_ht = 1;
+            break;
+        default: // 1x1, two images
+            in_wd = 4;
+            in_ht = 4;
+            in_channels = 32;
+            out_channels = 16;
+            filter_ht = 1;
+            filter_wd = 1;
+            pad_wd = 0;
+            pad_ht = 0;
+            stride_wd = 1;
+            stride_ht = 1;
+            batches = 2;
+            break;
+        }
+        if (pad_wd) {
+            out_wd = (in_wd + stride_wd - 1) / stride_wd;
+        } else {
+            out_wd = (in_wd + stride_wd - filter_wd) / stride_wd;
+        }
+        if (pad_ht) {
+            out_ht = (in_ht + stride_ht - 1) / stride_ht;
+        } else {
+            out_ht = (in_ht + stride_ht - filter_ht) / stride_ht;
+        }
+
+        int in_size = in_wd * in_ht * in_channels * batches;
+        int row_len = filter_wd * filter_ht * in_channels;
+        int filter_size = row_len * out_channels;
+        int out_size = out_wd * out_ht * out_channels * batches;
+
+        input = ESP_NN_TEST_ALLOC(in_size);
+        out_data_s8 = ESP_NN_TEST_ALLOC(out_size);
+        out_data_c = ESP_NN_TEST_ALLOC(out_size);
+        out_data_opt = ESP_NN_TEST_ALLOC(out_size);
+        filter_data = ESP_NN_TEST_ALLOC(filter_size);
+        filter_packed = ESP_NN_TEST_ALLOC(esp_nn_get_s4_packed_size(out_channels, row_len));
+        bias = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+        out_shift = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+        out_mult = ESP_NN_TEST_ALLOC(out_channels * sizeof(int32_t));
+
+        if (input == NULL || out_data_s8 == NULL || out_data_c == NULL || out_data_opt == NULL ||
+                filter_data == NULL || filter_packed == NULL || bias == NULL ||
+                out_shift == NULL || out_mult == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto conv_s4_cleanup;
+        }
+
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < filter_size; ++i) {
+            filter_data[i] = rand() % 16 - 8;
+        }
+        esp_nn_s4_pack(filter_packed, filter_data, out_channels, row_len);
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = rand() % 2001 - 1000;
+            out_shift[i] = -7 + rand() % 2;
+            out_mult[i] = 0x7f67f4f8 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_channels, batches};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = out_channels, batches};
+        data_dims_t filter_dims = {.width = filter_wd, .height = filter_ht, .channels = in_channels, 0};
+        conv_params_t conv_params = {.in_offset = 7, .out_offset = -3,
+                                     .stride = {stride_wd, stride_ht}, .padding = {pad_wd, pad_ht},
+                                     .dilation = {1, 1}, .activation = {-125, 122}};
+        quant_data_t quant_data = {.shift = out_shift, .mult = out_mult};
+
+        esp_nn_conv_s8_ansi(&input_dims, input, &filter_dims, filter_data, bias,
+                            &output_dims, out_data_s8, &conv_params, &quant_data);
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* C function */
+        esp_nn_conv_s4_ansi(&input_dims, input, &filter_dims, filter_packed, bias,
+                            &output_dims, out_data_c, &conv_params, &quant_data);
+
+        total_c = profile_c_end();
+        profile_opt_start();
+
+        /* Optimized function */
+        esp_nn_conv_s4(&input_dims, input, &filter_dims, filter_packed, bias,
+                       &output_dims, out_data_opt, &conv_params, &quant_data);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(out_data_s8, out_data_c, out_size) &&
+                   CHECK_EQUAL(out_data_s8, out_data_opt, out_size);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [pad: (%d, %d), stride: (%d, %d)"
+                   " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), batches %d]\n"ANSI_COLOR_RESET,
+                   itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+                   out_channels, filter_wd, filter_ht, in_channels, batches);
+            goto conv_s4_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [pad: (%d, %d), stride: (%d, %d)"
+               " out: (%3d,%3d,%3d), filter: (%d, %d,%3d), batches %d]"ANSI_COLOR_RESET,
+               itr, pad_wd, pad_ht, stride_wd, stride_ht, out_wd, out_ht,
+               out_channels, filter_wd, filter_ht, in_channels, batches);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    conv_s4_cleanup:
+        if (input) {
+            free(input);
+            input = NULL;
+        }
+        if (out_data_s8) {
+            free(out_data_s8);
+            out_data_s8 = NULL;
+        }
+        if (out_data_c) {
+            free(out_data_c);
+            out_data_c = NULL;
+        }
+        if (out_data_opt) {
+            free(out_data_opt);
+            out_data_opt = NULL;
+        }
+        if (filter_data) {
+            free(filter_data);
+            filter_data = NULL;
+        }
+        if (filter_packed) {
+            free(filter_packed);
+            filter_packed = NULL;
+        }
+        if (bias) {
+            free(bias);
+            bias = NULL;
+        }
+        if (out_shift) {
+            free(out_shift);
+            out_shift = NULL;
+        }
+        if (out_mult) {
+            free(out_mult);
+            out_mult = NULL;
+        }
+    }
+}
+
+/* filter, bias and quant of a fused 1x1 stage, from `in_ch` to `out_ch` channels */
+static bool dw_pw_test_alloc_pw(esp_nn_fused_pw_t *pw, const int in_wd, const int in_ht,
+                                const int in_ch, const int out_ch)
+{
+    int8_t *filter = ESP_NN_TEST_ALLOC(in_ch * out_ch);
+    int32_t *bias = ESP_NN_TEST_ALLOC(out_ch * sizeof(int32_t));
+    pw->quant_data.shift = ESP_NN_TEST_ALLOC(out_ch * sizeof(int32_t));
+    pw->quant_data.mult = ESP_NN_TEST_ALLOC(out_ch * sizeof(int32_t));
+    pw->filter = filter;
+    pw->bias = bias;
+    if (filter == NULL || bias == NULL || pw->quant_data.shift == NULL || pw->quant_data.mult == NULL) {
+        return false;
+    }
+    for (int i = 0; i < in_ch * out_ch; ++i) {
+        filter[i] = rand() % 256 - 128;
+    }
+    for (int i = 0; i < out_ch; ++i) {
+        bias[i] = rand() % 20001 - 10000;
+        pw->quant_data.shift[i] = -9 + rand() % 2;
+        pw->quant_data.mult[i] = 0x7f67f4f8 + rand() % 50;
+    }
+    pw->filter_dims = (data_dims_t) {.width = 1, .height = 1, .channels = in_ch, 1};
+    pw->output_dims = (data_dims_t) {.width = in_wd, .height = in_ht, .channels = out_ch, 1};
+    pw->params = (conv_params_t) {.in_offset = 9, .out_offset = -5, .stride = {1, 1},
+                                  .padding = {0, 0}, .dilation = {1, 1}, .activation = {-120, 125}};
+    return true;
+}
+
+static void dw_pw_test_free_pw(esp_nn_fused_pw_t *pw)
+{
+    free((void *) pw->filter);
+    free((void *) pw->bias);
+    free(pw->quant_data.shift);
+    free(pw->quant_data.mult);
+    memset(pw, 0, sizeof(*pw));
+}
+
+/*
+ * Fused depthwise -> pointwise block against its layers run one by one with
+ * esp_nn_conv_s8 and esp_nn_depthwise_conv_s8, compared row by row.
+ */
+void esp_nn_dw_pw_conv_s8_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input = NULL;
+    int8_t *exp_out = NULL;
+    int8_t *mid_out = NULL;
+    int8_t *out_data_c = NULL;
+    int8_t *out_data_opt = NULL;
+    int8_t *dw_filter = NULL;
+    int32_t *dw_bias = NULL;
+    int32_t *dw_shift = NULL;
+    int32_t *dw_mult = NULL;
+    void *scratch_buf = NULL;
+    esp_nn_fused_pw_t expand = {0};
+    esp_nn_fused_pw_t project = {0};
+
+    /* independent variables */
+    int in_wd, in_ht, in_ch, exp_ch, ch_mult, out_ch, tile_rows;
+    int filter_size, pad, stride;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 6; itr++) {
+        ch_mult = 1;
+        filter_size = 3;
+        pad = 1;
+
+        switch (itr) {
+        case 0: // no expansion, tiles of 2 rows
+            in_wd = 12;
+            in_ht = 12;
+            in_ch = 8;
+            exp_ch = 0;
+            out_ch = 16;
+            stride = 1;
+            tile_rows = 2;
+            break;
+        case 1: // expansion, stride 2, tiles of 3 rows
+            in_wd = 12;
+            in_ht = 12;
+            in_ch = 8;
+            exp_ch = 24;
+            out_ch = 8;
+            stride = 2;
+            tile_rows = 3;
+            break;
+        case 2: // one row tiles, odd sizes, stride 2
+            in_wd = 9;
+            in_ht = 7;
+            in_ch = 16;
+            exp_ch = 0;
+            out_ch = 8;
+            stride = 2;
+            tile_rows = 1;
+            break;
+        case 3: // expansion, one tile for the whole output
+            in_wd = 10;
+            in_ht = 10;
+            in_ch = 8;
+            exp_ch = 16;
+            out_ch = 8;
+            stride = 1;
+            tile_rows = 64;
+            break;
+        case 4: // 5x5 depthwise, ch_mult 2, last tile shorter
+            in_wd = 8;
+            in_ht = 11;
+            in_ch = 8;
+            exp_ch = 0;
+            ch_mult = 2;
+            out_ch = 16;
+            filter_size = 5;
+            pad = 2;
+            stride = 1;
+            tile_rows = 4;
+            break;
+        default: // unpadded, expansion, tiles of 2 rows
+            in_wd = 9;
+            in_ht = 9;
+            in_ch = 3;
+            exp_ch = 16;
+            out_ch = 24;
+            pad = 0;
+            stride = 1;
+            tile_rows = 2;
+            break;
+        }
+
+        const int dw_ch = exp_ch ? exp_ch : in_ch;
+        const int mid_ch = dw_ch * ch_mult;
+        const int mid_wd = (in_wd + 2 * pad - filter_size) / stride + 1;
+        const int mid_ht = (in_ht + 2 * pad - filter_size) / stride + 1;
+        const int in_size = in_wd * in_ht * in_ch;
+        const int exp_size = in_wd * in_ht * dw_ch;
+        const int mid_size = mid_wd * mid_ht * mid_ch;
+        const int out_size = mid_wd * mid_ht * out_ch;
+        const int row_size = mid_wd * out_ch;
+
+        input = ESP_NN_TEST_ALLOC(in_size);
+        exp_out = ESP_NN_TEST_ALLOC(exp_size);
+        mid_out = ESP_NN_TEST_ALLOC(mid_size);
+        out_data_c = ESP_NN_TEST_ALLOC(out_size);
+        out_data_opt = ESP_NN_TEST_ALLOC(out_size);
+        dw_filter = ESP_NN_TEST_ALLOC(filter_size * filter_size * mid_ch);
+        dw_bias = ESP_NN_TEST_ALLOC(mid_ch * sizeof(int32_t));
+        dw_shift = ESP_NN_TEST_ALLOC(mid_ch * sizeof(int32_t));
+        dw_mult = ESP_NN_TEST_ALLOC(mid_ch * sizeof(int32_t));
+        if (input == NULL || exp_out == NULL || mid_out == NULL || out_data_c == NULL ||
+                out_data_opt == NULL || dw_filter == NULL || dw_bias == NULL ||
+                dw_shift == NULL || dw_mult == NULL ||
+                (exp_ch && !dw_pw_test_alloc_pw(&expand, in_wd, in_ht, in_ch, exp_ch)) ||
+                !dw_pw_test_alloc_pw(&project, mid_wd, mid_ht, mid_ch, out_ch)) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto dw_pw_cleanup;
+        }
+
+        for (int i = 0; i < in_size; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < filter_size * filter_size * mid_ch; ++i) {
+            dw_filter[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < mid_ch; ++i) {
+            dw_bias[i] = rand() % 20001 - 10000;
+            dw_shift[i] = -8 + rand() % 2;
+            dw_mult[i] = 0x7eb0e200 + rand() % 50;
+        }
+
+        data_dims_t input_dims = {.width = in_wd, .height = in_ht, .channels = in_ch, 1};
+        esp_nn_fused_dw_t dw = {
+            .filter_dims = {.width = filter_size, .height = filter_size, .channels = dw_ch, 1},
+            .filter = dw_filter,
+            .bias = dw_bias,
+            .output_dims = {.width = mid_wd, .height = mid_ht, .channels = mid_ch, 1},
+            .params = {.in_offset = 6, .out_offset = -2, .ch_mult = ch_mult,
+                       .stride = {stride, stride}, .padding = {pad, pad},
+                       .dilation = {1, 1}, .activation = {-128, 127}},
+            .quant_data = {.shift = dw_shift, .mult = dw_mult},
+        };
+        const data_dims_t *dw_in_dims = exp_ch ? &expand.output_dims : &input_dims;
+
+        /* one scratch, the largest of the layers and of the fused block */
+        int32_t sizes[4] = {
+            esp_nn_get_dw_pw_conv_scratch_size(&input_dims, exp_ch ? &expand : NULL,
+                                               &dw, &project, tile_rows),
+            esp_nn_get_depthwise_conv_scratch_size(dw_in_dims, &dw.filter_dims,
+                                                   &dw.output_dims, &dw.params),
+            esp_nn_get_conv_scratch_size(&dw.output_dims, &project.filter_dims,
+                                         &project.output_dims, &project.params),
+            exp_ch ? esp_nn_get_conv_scratch_size(&input_dims, &expand.filter_dims,
+                                                  &expand.output_dims, &expand.params) : 0,
+        };
+        int32_t scratch_size = 0;
+        for (int i = 0; i < 4; i++) {
+            scratch_size = sizes[i] > scratch_size ? sizes[i] : scratch_size;
+        }
+        scratch_buf = ESP_NN_TEST_ALLOC(scratch_size + 16);
+        if (scratch_buf == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %"PRIi32"\n"ANSI_COLOR_RESET,
+                   itr, scratch_size);
+            goto dw_pw_cleanup;
+        }
+        esp_nn_ctx_t ctx = {.scratch = (void *) (((uintptr_t) scratch_buf + 15) & ~15), .mover = NULL};
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* the layers one by one */
+        const int8_t *dw_in = input;
+        if (exp_ch) {
+            esp_nn_conv_s8_ctx(&ctx, &input_dims, input, &expand.filter_dims, expand.filter,
+                               expand.bias, &expand.output_dims, exp_out, &expand.params,
+                               &expand.quant_data);
+            dw_in = exp_out;
+        }
+        esp_nn_depthwise_conv_s8_ctx(&ctx, dw_in_dims, dw_in, &dw.filter_dims, dw.filter, dw.bias,
+                                     &dw.output_dims, mid_out, &dw.params, &dw.quant_data);
+        esp_nn_conv_s8_ctx(&ctx, &dw.output_dims, mid_out, &project.filter_dims, project.filter,
+                           project.bias, &project.output_dims, out_data_c, &project.params,
+                           &project.quant_data);
+
+        total_c = profile_c_end();
+        profile_opt_start();
+
+        /* the fused block */
+        int ret = esp_nn_dw_pw_conv_s8(&ctx, &input_dims, input, exp_ch ? &expand : NULL, &dw,
+                                       &project, tile_rows, out_data_opt);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        if (ret != 0) {
+            printf(ANSI_COLOR_RED"[%3d] failed, the block was rejected\n"ANSI_COLOR_RESET, itr);
+            goto dw_pw_cleanup;
+        }
+        for (int row = 0; row < mid_ht; row++) {
+            const int8_t *row_c = out_data_c + row * row_size;
+            const int8_t *row_opt = out_data_opt + row * row_size;
+            if (CHECK_EQUAL(row_c, row_opt, row_size) == false) {
+                printf(ANSI_COLOR_RED"[%3d] failed at output row %d [in: (%3d,%3d,%3d), expand %d,"
+                       " filter %d, stride %d, out: (%3d,%3d,%3d), tile_rows %d]\n"ANSI_COLOR_RESET,
+                       itr, row, in_wd, in_ht, in_ch, exp_ch, filter_size, stride,
+                       mid_wd, mid_ht, out_ch, tile_rows);
+                goto dw_pw_cleanup;
+            }
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [in: (%3d,%3d,%3d), expand %d, filter %d, stride %d,"
+               " out: (%3d,%3d,%3d), tile_rows %d]"ANSI_COLOR_RESET,
+               itr, in_wd, in_ht, in_ch, exp_ch, filter_size, stride,
+               mid_wd, mid_ht, out_ch, tile_rows);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    dw_pw_cleanup:
+        if (input) {
+            free(input);
+            input = NULL;
+        }
+        if (exp_out) {
+            free(exp_out);
+            exp_out = NULL;
+        }
+        if (mid_out) {
+            free(mid_out);
+            mid_out = NULL;
+        }
+        if (out_data_c) {
+            free(out_data_c);
+            out_data_c = NULL;
+        }
+        if (out_data_opt) {
+            free(out_data_opt);
+            out_data_opt = NULL;
+        }
+        if (dw_filter) {
+            free(dw_filter);
+            dw_filter = NULL;
+        }
+        if (dw_bias) {
+            free(dw_bias);
+            dw_bias = NULL;
+        }
+        if (dw_shift) {
+            free(dw_shift);
+            dw_shift = NULL;
+        }
+        if (dw_mult) {
+            free(dw_mult);
+            dw_mult = NULL;
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+        dw_pw_test_free_pw(&expand);
+        dw_pw_test_free_pw(&project);
+    }
+}
@@ -306,3 +306,943 @@ fc_per_ch_s8_buffers_cleanup:
         free(out_opt_orig);
     }
 }
+
+/* prepared layer run vs the unprepared call, both weight layouts */
+void esp_nn_fully_connected_prepared_s8_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    const int32_t max_out_ch = 16;
+    const int32_t max_row_len = 271;
+    const int32_t batches = 3;
+    uint16_t row_len, out_channels;
+    int32_t input_offset, filter_offset, per_ch;
+    esp_nn_fc_layout_t layout;
+    void *blob = NULL;
+
+    int8_t *input_orig = ESP_NN_TEST_ALLOC(max_row_len * batches + 16);
+    int8_t *filter_orig = ESP_NN_TEST_ALLOC(max_row_len * max_out_ch + 16);
+    int8_t *out_c_orig = ESP_NN_TEST_ALLOC(max_out_ch * batches + 16);
+    int8_t *out_opt_orig = ESP_NN_TEST_ALLOC(max_out_ch * batches + 16);
+    int32_t *bias = ESP_NN_TEST_ALLOC(max_out_ch * sizeof(int32_t));
+    int32_t *out_shift = ESP_NN_TEST_ALLOC(max_out_ch * sizeof(int32_t));
+    int32_t *out_mult = ESP_NN_TEST_ALLOC(max_out_ch * sizeof(int32_t));
+    if (!input_orig || !filter_orig || !out_c_orig || !out_opt_orig ||
+            !bias || !out_shift || !out_mult) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto fc_prepared_s8_cleanup;
+    }
+    int8_t *input = (int8_t *)(((uintptr_t)input_orig + 15) & ~15);
+    int8_t *filter_data = (int8_t *)(((uintptr_t)filter_orig + 15) & ~15);
+    int8_t *output_c = (int8_t *)(((uintptr_t)out_c_orig + 15) & ~15);
+    int8_t *output_opt = (int8_t *)(((uintptr_t)out_opt_orig + 15) & ~15);
+    int32_t activation_min = -128;
+    int32_t activation_max = 127;
+    int32_t out_offset = 5;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 8; itr++) {
+        input_offset = 128 - rand() % 256;
+        filter_offset = 0;
+        switch (itr) {
+        case 0: // odd len, unaligned + left-over
+            row_len = 271;
+            out_channels = 3;
+            per_ch = 0;
+            layout = ESP_NN_FC_LAYOUT_ROWS;
+            break;
+        case 1:
+            row_len = 271;
+            out_channels = 16;
+            per_ch = 1;
+            layout = ESP_NN_FC_LAYOUT_ROWS;
+            break;
+        case 2: // channels in groups of 4
+            row_len = 64;
+            out_channels = 16;
+            per_ch = 0;
+            layout = ESP_NN_FC_LAYOUT_INTERLEAVED;
+            break;
+        case 3: // a short last group of channels
+            row_len = 100;
+            out_channels = 15;
+            per_ch = 1;
+            layout = ESP_NN_FC_LAYOUT_INTERLEAVED;
+            break;
+        case 4:
+            row_len = 7;
+            out_channels = 8;
+            per_ch = 1;
+            layout = ESP_NN_FC_LAYOUT_ROWS;
+            break;
+        case 5:
+            row_len = 1;
+            out_channels = 5;
+            per_ch = 0;
+            layout = ESP_NN_FC_LAYOUT_INTERLEAVED;
+            break;
+        case 6: // filter offset can't be folded, the run does the unprepared call
+            row_len = 33;
+            out_channels = 8;
+            per_ch = 0;
+            filter_offset = 3;
+            layout = ESP_NN_FC_LAYOUT_ROWS;
+            break;
+        default: // no input offset, rows of whole 16 byte blocks
+            row_len = 128;
+            out_channels = 16;
+            per_ch = 1;
+            input_offset = 0;
+            layout = ESP_NN_FC_LAYOUT_ROWS;
+            break;
+        }
+
+        for (int i = 0; i < row_len * batches; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < row_len * out_channels; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; i++) {
+            bias[i] = rand() % UINT16_MAX - INT16_MAX;
+            out_mult[i] = (INT32_MAX - INT16_MAX) / row_len + rand() % INT16_MAX;
+            out_shift[i] = per_ch ? -10 + rand() % 5 : -8;
+        }
+
+        int32_t blob_size = esp_nn_get_fully_connected_prepared_size(row_len, out_channels, layout);
+        blob = ESP_NN_TEST_ALLOC(blob_size + 16);
+        if (blob == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] blob alloc failed size %"PRIi32"\n"ANSI_COLOR_RESET,
+                   itr, blob_size);
+            goto fc_prepared_s8_cleanup;
+        }
+        void *blob_aligned = (void *)(((uintptr_t)blob + 15) & ~15);
+        esp_nn_fc_prepared_t *prep;
+        if (per_ch) {
+            prep = esp_nn_fully_connected_per_ch_s8_prepare(blob_aligned, layout, input_offset,
+                                                            row_len, filter_data, filter_offset,
+                                                            bias, out_channels, out_offset,
+                                                            out_shift, out_mult,
+                                                            activation_min, activation_max);
+        } else {
+            prep = esp_nn_fully_connected_s8_prepare(blob_aligned, layout, input_offset,
+                                                     row_len, filter_data, filter_offset,
+                                                     bias, out_channels, out_offset,
+                                                     out_shift[0], out_mult[0],
+                                                     activation_min, activation_max);
+        }
+
+        /* unprepared calls, one per batch */
+        profile_c_start();
+        for (int b = 0; b < batches; b++) {
+            if (per_ch) {
+                esp_nn_fully_connected_per_ch_s8(input + b * row_len, input_offset, row_len,
+                                                 filter_data, filter_offset, bias,
+                                                 output_c + b * out_channels, out_channels,
+                                                 out_offset, out_shift, out_mult,
+                                                 activation_min, activation_max);
+            } else {
+                esp_nn_fully_connected_s8(input + b * row_len, input_offset, row_len,
+                                          filter_data, filter_offset, bias,
+                                          output_c + b * out_channels, out_channels,
+                                          out_offset, out_shift[0], out_mult[0],
+                                          activation_min, activation_max);
+            }
+        }
+        total_c = profile_c_end();
+
+        /* prepared run on the first input, then on the whole batch */
+        profile_opt_start();
+        esp_nn_fully_connected_s8_run(prep, input, output_opt);
+        total_opt = profile_opt_end();
+        bool ret = CHECK_EQUAL(output_c, output_opt, out_channels);
+        if (ret) {
+            esp_nn_fully_connected_s8_run_batch(prep, batches, input, output_opt);
+            ret = CHECK_EQUAL(output_c, output_opt, out_channels * batches);
+        }
+
+        free(blob);
+        blob = NULL;
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [row_len %"PRIu16", out_ch %"PRIu16
+                   ", layout %d, per_ch %"PRIi32"]\n"ANSI_COLOR_RESET,
+                   itr, row_len, out_channels, layout, per_ch);
+            goto fc_prepared_s8_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [row_len %"PRIu16", out_ch %"PRIu16
+               ", layout %d, per_ch %"PRIi32"]"ANSI_COLOR_RESET,
+               itr, row_len, out_channels, layout, per_ch);
+        printf("\tcycles: unprepared x%"PRIi32" %8"PRIu32", run %8"PRIu32"\n",
+               batches, total_c, total_opt);
+    }
+
+fc_prepared_s8_cleanup:
+    if (blob) {
+        free(blob);
+    }
+    if (input_orig) {
+        free(input_orig);
+    }
+    if (filter_orig) {
+        free(filter_orig);
+    }
+    if (out_c_orig) {
+        free(out_c_orig);
+    }
+    if (out_opt_orig) {
+        free(out_opt_orig);
+    }
+    if (bias) {
+        free(bias);
+    }
+    if (out_shift) {
+        free(out_shift);
+    }
+    if (out_mult) {
+        free(out_mult);
+    }
+}
+
+/* batch matmul vs the reference: odd rows, cols and depth, an rhs or lhs
+ * shared by all batches, and more rhs columns than one cache block */
+void esp_nn_batch_matmul_s8_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *lhs_orig = NULL, *rhs_orig = NULL, *out_c_orig = NULL, *out_opt_orig = NULL;
+    void *scratch_buf = NULL;
+
+    /* independent variables */
+    int32_t rows, depth, cols, batches, lhs_batches, rhs_batches, rhs_transposed, rhs_offset;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int itr = 0; itr < 5; itr++) {
+        rhs_offset = -3;
+
+        switch (itr) {
+        case 0: // odd sizes, both operands batched
+            rows = 5;
+            depth = 37;
+            cols = 7;
+            batches = 2;
+            lhs_batches = 2;
+            rhs_batches = 2;
+            rhs_transposed = 0;
+            break;
+        case 1: // rhs shared: the lhs batches run as rows of one matrix
+            rows = 3;
+            depth = 32;
+            cols = 9;
+            batches = 3;
+            lhs_batches = 3;
+            rhs_batches = 1;
+            rhs_transposed = 1;
+            break;
+        case 2: // lhs shared, no rhs offset
+            rows = 7;
+            depth = 19;
+            cols = 5;
+            batches = 3;
+            lhs_batches = 1;
+            rhs_batches = 3;
+            rhs_transposed = 0;
+            rhs_offset = 0;
+            break;
+        case 3: // 131 cols: two blocks of packed rhs, the last one short
+            rows = 3;
+            depth = 64;
+            cols = 131;
+            batches = 1;
+            lhs_batches = 1;
+            rhs_batches = 1;
+            rhs_transposed = 1;
+            break;
+        default: // 1x1 x 1x1
+            rows = 1;
+            depth = 1;
+            cols = 1;
+            batches = 2;
+            lhs_batches = 2;
+            rhs_batches = 2;
+            rhs_transposed = 0;
+            break;
+        }
+
+        int lhs_size = lhs_batches * rows * depth;
+        int rhs_size = rhs_batches * depth * cols;
+        int out_size = batches * rows * cols;
+
+        lhs_orig = ESP_NN_TEST_ALLOC(lhs_size + 16);
+        rhs_orig = ESP_NN_TEST_ALLOC(rhs_size + 16);
+        out_c_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        out_opt_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        if (lhs_orig == NULL || rhs_orig == NULL || out_c_orig == NULL || out_opt_orig == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto batch_matmul_s8_cleanup;
+        }
+        int8_t *lhs = (int8_t *)(((uintptr_t)lhs_orig + 15) & ~15);
+        int8_t *rhs = (int8_t *)(((uintptr_t)rhs_orig + 15) & ~15);
+        int8_t *output_c = (int8_t *)(((uintptr_t)out_c_orig + 15) & ~15);
+        int8_t *output_opt = (int8_t *)(((uintptr_t)out_opt_orig + 15) & ~15);
+
+        for (int i = 0; i < lhs_size; ++i) {
+            lhs[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < rhs_size; ++i) {
+            rhs[i] = rand() % 256 - 128;
+        }
+
+        data_dims_t lhs_dims = {.width = depth, .height = rows, .channels = 1, lhs_batches};
+        data_dims_t rhs_dims = rhs_transposed ?
+                               (data_dims_t) {.width = depth, .height = cols, .channels = 1, rhs_batches} :
+                               (data_dims_t) {.width = cols, .height = depth, .channels = 1, rhs_batches};
+        data_dims_t output_dims = {.width = cols, .height = rows, .channels = 1, batches};
+        matmul_params_t params = {.lhs_offset = 7, .rhs_offset = rhs_offset, .out_offset = -4,
+                                  .out_mult = 0x40000000 + rand() % INT16_MAX,
+                                  .out_shift = -9 + rand() % 3, .rhs_transposed = rhs_transposed,
+                                  .activation = {-120, 125}};
+
+        int scratch_buf_size = esp_nn_get_batch_matmul_scratch_size(&lhs_dims, &rhs_dims,
+                                                                    &output_dims, &params);
+        if (scratch_buf_size > 0) {
+            scratch_buf = ESP_NN_TEST_ALLOC(scratch_buf_size);
+            if (scratch_buf == NULL) {
+                printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %d\n"ANSI_COLOR_RESET,
+                       itr, scratch_buf_size);
+                goto batch_matmul_s8_cleanup;
+            }
+        }
+        esp_nn_ctx_t ctx = {.scratch = scratch_buf};
+
+        profile_c_start();
+        esp_nn_batch_matmul_s8_ansi(&ctx, &lhs_dims, lhs, &rhs_dims, rhs,
+                                    &output_dims, output_c, &params);
+        total_c = profile_c_end();
+
+        profile_opt_start();
+        esp_nn_batch_matmul_s8(&ctx, &lhs_dims, lhs, &rhs_dims, rhs,
+                               &output_dims, output_opt, &params);
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(output_c, output_opt, out_size);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [%"PRIi32" x (%"PRIi32"x%"PRIi32" x %"PRIi32"x%"PRIi32
+                   "), batches lhs %"PRIi32" rhs %"PRIi32", rhs^T %"PRIi32"]\n"ANSI_COLOR_RESET,
+                   itr, batches, rows, depth, depth, cols, lhs_batches, rhs_batches, rhs_transposed);
+            goto batch_matmul_s8_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [%"PRIi32" x (%"PRIi32"x%"PRIi32" x %"PRIi32"x%"PRIi32
+               "), batches lhs %"PRIi32" rhs %"PRIi32", rhs^T %"PRIi32"]"ANSI_COLOR_RESET,
+               itr, batches, rows, depth, depth, cols, lhs_batches, rhs_batches, rhs_transposed);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    batch_matmul_s8_cleanup:
+        if (lhs_orig) {
+            free(lhs_orig);
+            lhs_orig = NULL;
+        }
+        if (rhs_orig) {
+            free(rhs_orig);
+            rhs_orig = NULL;
+        }
+        if (out_c_orig) {
+            free(out_c_orig);
+            out_c_orig = NULL;
+        }
+        if (out_opt_orig) {
+            free(out_opt_orig);
+            out_opt_orig = NULL;
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+    }
+}
+
+void esp_nn_lstm_s8_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    int8_t *input_orig = NULL, *weights = NULL, *out_c_orig = NULL, *out_opt_orig = NULL;
+    int8_t *hidden_c = NULL, *hidden_opt = NULL;
+    int16_t *cell_c = NULL, *cell_opt = NULL, *sigmoid_lut = NULL, *tanh_lut = NULL;
+    int32_t *bias = NULL;
+    void *scratch_buf = NULL;
+
+    /* independent variables */
+    int32_t steps, input_size, units, batches, hidden_offset, cell_clip, zero_weights;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+
+    sigmoid_lut = ESP_NN_TEST_ALLOC(esp_nn_get_logistic_s16_scratch_size());
+    tanh_lut = ESP_NN_TEST_ALLOC(esp_nn_get_tanh_s16_scratch_size());
+    if (sigmoid_lut == NULL || tanh_lut == NULL) {
+        printf(ANSI_COLOR_RED"activation tables alloc failed\n"ANSI_COLOR_RESET);
+        goto lstm_s8_tables_cleanup;
+    }
+    esp_nn_logistic_s16_prepare(sigmoid_lut);
+    esp_nn_tanh_s16_prepare(tanh_lut);
+
+    for (int itr = 0; itr < 5; itr++) {
+        hidden_offset = 5;
+        cell_clip = 0;
+        zero_weights = 0;
+
+        switch (itr) {
+        case 0: // one batch, input and units multiples of 4
+            steps = 5;
+            input_size = 16;
+            units = 8;
+            batches = 1;
+            break;
+        case 1: // odd sizes, more steps than a block of input products
+            steps = 20;
+            input_size = 7;
+            units = 13;
+            batches = 2;
+            hidden_offset = -3;
+            break;
+        case 2: // clipped cell state
+            steps = 3;
+            input_size = 40;
+            units = 32;
+            batches = 1;
+            cell_clip = 1000;
+            break;
+        case 3: // one step, no hidden offset
+            steps = 1;
+            input_size = 3;
+            units = 5;
+            batches = 3;
+            hidden_offset = 0;
+            break;
+        default: // no weights and no cell state: h is the zero point, -hidden_offset
+            steps = 4;
+            input_size = 9;
+            units = 6;
+            batches = 2;
+            hidden_offset = 17;
+            zero_weights = 1;
+            break;
+        }
+
+        int input_len = batches * steps * input_size;
+        int out_size = batches * steps * units;
+        int gate_size = units * (input_size + units);
+
+        input_orig = ESP_NN_TEST_ALLOC(input_len + 16);
+        weights = ESP_NN_TEST_ALLOC(ESP_NN_LSTM_GATES * gate_size);
+        bias = ESP_NN_TEST_ALLOC(ESP_NN_LSTM_GATES * units * sizeof(int32_t));
+        out_c_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        out_opt_orig = ESP_NN_TEST_ALLOC(out_size + 16);
+        hidden_c = ESP_NN_TEST_ALLOC(batches * units);
+        hidden_opt = ESP_NN_TEST_ALLOC(batches * units);
+        cell_c = ESP_NN_TEST_ALLOC(batches * units * sizeof(int16_t));
+        cell_opt = ESP_NN_TEST_ALLOC(batches * units * sizeof(int16_t));
+        if (input_orig == NULL || weights == NULL || bias == NULL || out_c_orig == NULL ||
+                out_opt_orig == NULL || hidden_c == NULL || hidden_opt == NULL ||
+                cell_c == NULL || cell_opt == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] allocations failed\n"ANSI_COLOR_RESET, itr);
+            goto lstm_s8_cleanup;
+        }
+        int8_t *input = (int8_t *)(((uintptr_t)input_orig + 15) & ~15);
+        int8_t *output_c = (int8_t *)(((uintptr_t)out_c_orig + 15) & ~15);
+        int8_t *output_opt = (int8_t *)(((uintptr_t)out_opt_orig + 15) & ~15);
+
+        for (int i = 0; i < input_len; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < ESP_NN_LSTM_GATES * gate_size; ++i) {
+            weights[i] = zero_weights ? 0 : rand() % 256 - 128;
+        }
+        for (int i = 0; i < ESP_NN_LSTM_GATES * units; ++i) {
+            bias[i] = zero_weights ? 0 : rand() % 4096 - 2048;
+        }
+        for (int i = 0; i < batches * units; ++i) {
+            hidden_c[i] = hidden_opt[i] = rand() % 256 - 128;
+            cell_c[i] = cell_opt[i] = zero_weights ? 0 : rand() % 4096 - 2048;
+        }
+
+        data_dims_t input_dims = {.width = input_size, .height = steps, .channels = 1, batches};
+        data_dims_t output_dims = {.width = units, .height = steps, .channels = 1, batches};
+        lstm_params_t params = {.input_offset = 9, .hidden_offset = hidden_offset,
+                                .hidden_mult = 0x40000000 + rand() % INT16_MAX,
+                                .hidden_shift = -22, .cell_shift = -11, .cell_clip = cell_clip,
+                                .sigmoid_lut = sigmoid_lut, .tanh_lut = tanh_lut,
+                                .activation = {-128, 127}};
+        for (int g = 0; g < ESP_NN_LSTM_GATES; g++) {
+            lstm_gate_t *gate = &params.gates[g];
+            gate->input_weights = weights + g * gate_size;
+            gate->recurrent_weights = gate->input_weights + units * input_size;
+            gate->bias = bias + g * units;
+            gate->input_mult = 0x40000000 + rand() % INT16_MAX;
+            gate->input_shift = -6;
+            gate->recurrent_mult = 0x40000000 + rand() % INT16_MAX;
+            gate->recurrent_shift = -6;
+        }
+
+        int scratch_buf_size = esp_nn_get_lstm_scratch_size(&input_dims, &output_dims, &params);
+        if (scratch_buf_size > 0) {
+            scratch_buf = ESP_NN_TEST_ALLOC(scratch_buf_size);
+            if (scratch_buf == NULL) {
+                printf(ANSI_COLOR_RED"[%3d] scratch_buf alloc failed size %d\n"ANSI_COLOR_RESET,
+                       itr, scratch_buf_size);
+                goto lstm_s8_cleanup;
+            }
+        }
+        esp_nn_ctx_t ctx = {.scratch = scratch_buf};
+
+        profile_c_start();
+        esp_nn_lstm_s8_ansi(&ctx, &input_dims, input, &output_dims, output_c,
+                            hidden_c, cell_c, &params);
+        total_c = profile_c_end();
+
+        profile_opt_start();
+        esp_nn_lstm_s8(&ctx, &input_dims, input, &output_dims, output_opt,
+                       hidden_opt, cell_opt, &params);
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(output_c, output_opt, out_size) &&
+                   CHECK_EQUAL(hidden_c, hidden_opt, batches * units) &&
+                   CHECK_EQUAL(cell_c, cell_opt, batches * units);
+        for (int i = 0; zero_weights && i < out_size; ++i) {
+            ret = ret && output_c[i] == -hidden_offset;
+        }
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [%"PRIi32" x %"PRIi32" steps, input %"PRIi32
+                   ", units %"PRIi32", hidden_offset %"PRIi32"]\n"ANSI_COLOR_RESET,
+                   itr, batches, steps, input_size, units, hidden_offset);
+            goto lstm_s8_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [%"PRIi32" x %"PRIi32" steps, input %"PRIi32
+               ", units %"PRIi32", hidden_offset %"PRIi32"]"ANSI_COLOR_RESET,
+               itr, batches, steps, input_size, units, hidden_offset);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+    lstm_s8_cleanup:
+        if (input_orig) {
+            free(input_orig);
+            input_orig = NULL;
+        }
+        if (weights) {
+            free(weights);
+            weights = NULL;
+        }
+        if (bias) {
+            free(bias);
+            bias = NULL;
+        }
+        if (out_c_orig) {
+            free(out_c_orig);
+            out_c_orig = NULL;
+        }
+        if (out_opt_orig) {
+            free(out_opt_orig);
+            out_opt_orig = NULL;
+        }
+        if (hidden_c) {
+            free(hidden_c);
+            hidden_c = NULL;
+        }
+        if (hidden_opt) {
+            free(hidden_opt);
+            hidden_opt = NULL;
+        }
+        if (cell_c) {
+            free(cell_c);
+            cell_c = NULL;
+        }
+        if (cell_opt) {
+            free(cell_opt);
+            cell_opt = NULL;
+        }
+        if (scratch_buf) {
+            free(scratch_buf);
+            scratch_buf = NULL;
+        }
+    }
+
+lstm_s8_tables_cleanup:
+    if (sigmoid_lut) free(sigmoid_lut);
+    if (tanh_lut) free(tanh_lut);
+}
+
+void esp_nn_fully_connected_s16_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    const int32_t max_row_len = 1100;
+    const int32_t max_out_ch = 16;
+    uint16_t row_len, out_channels;
+    int32_t out_shift, out_mult;
+
+    int16_t *input = ESP_NN_TEST_ALLOC(max_row_len * sizeof(int16_t));
+    int8_t *filter_data = ESP_NN_TEST_ALLOC(max_row_len * max_out_ch);
+    int64_t *bias = ESP_NN_TEST_ALLOC(max_out_ch * sizeof(int64_t));
+    int16_t *output_c = ESP_NN_TEST_ALLOC(max_out_ch * sizeof(int16_t));
+    int16_t *output_opt = ESP_NN_TEST_ALLOC(max_out_ch * sizeof(int16_t));
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+
+    if (!input || !filter_data || !bias || !output_c || !output_opt) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto fc_s16_cleanup;
+    }
+
+    for (int itr = 0; itr < 6; itr++) {
+        const int32_t with_bias = itr != 2;
+        switch (itr) {
+        case 0:
+            row_len = 16;
+            out_channels = 8;
+            out_shift = -12;
+            break;
+        case 1: // odd len, left-over after the unrolled pairs
+            row_len = 271;
+            out_channels = 3;
+            out_shift = -14;
+            break;
+        case 2: // no bias
+            row_len = 1;
+            out_channels = 16;
+            out_shift = -8;
+            break;
+        case 3: // rows longer than an int32 chunk of the dot product
+            row_len = 1100;
+            out_channels = 5;
+            out_shift = -14;
+            break;
+        case 4: // a chunk and one value
+            row_len = 513;
+            out_channels = 16;
+            out_shift = -13;
+            break;
+        default:
+            row_len = rand() % 64 + 1;
+            out_channels = 7;
+            out_shift = -12 + rand() % 5;
+            break;
+        }
+        out_mult = 0x59e492c4 + rand() % INT16_MAX;
+
+        /* int16 activations over their whole range */
+        for (int i = 0; i < row_len; ++i) {
+            input[i] = rand() % 65536 - 32768;
+        }
+        for (int i = 0; i < row_len * out_channels; ++i) {
+            filter_data[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = rand() % 2000001 - 1000000;
+        }
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* C function */
+        esp_nn_fully_connected_s16_ansi(input, row_len, filter_data, with_bias ? bias : NULL,
+                                        output_c, out_channels, 0, out_shift, out_mult,
+                                        -32768, 32767);
+
+        total_c = profile_c_end();
+        profile_opt_start();
+
+        /* Optimized function */
+        esp_nn_fully_connected_s16(input, row_len, filter_data, with_bias ? bias : NULL,
+                                   output_opt, out_channels, 0, out_shift, out_mult,
+                                   -32768, 32767);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(output_c, output_opt, out_channels);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [row_len %"PRIu16", out_ch %"PRIu16"]\n"ANSI_COLOR_RESET,
+                   itr, row_len, out_channels);
+            goto fc_s16_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [row_len %"PRIu16", out_ch %"PRIu16"]"ANSI_COLOR_RESET,
+               itr, row_len, out_channels);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+    }
+
+fc_s16_cleanup:
+    if (input) {
+        free(input);
+    }
+    if (filter_data) {
+        free(filter_data);
+    }
+    if (bias) {
+        free(bias);
+    }
+    if (output_c) {
+        free(output_c);
+    }
+    if (output_opt) {
+        free(output_opt);
+    }
+}
+
+/*
+ * int4 weights: the weights are drawn in [-8, 7], so the int8 reference on
+ * the unpacked rows gives the expected output of the packed ones.
+ */
+void esp_nn_fully_connected_per_ch_s4_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    const int32_t max_row_len = 300;
+    const int32_t max_out_ch = 16;
+    uint16_t row_len, out_channels;
+    int32_t out_shift[16], out_mult[16], bias[16];
+
+    int8_t *input = ESP_NN_TEST_ALLOC(max_row_len);
+    int8_t *filter_data = ESP_NN_TEST_ALLOC(max_row_len * max_out_ch);
+    int8_t *filter_packed = ESP_NN_TEST_ALLOC(esp_nn_get_s4_packed_size(max_out_ch, max_row_len));
+    int8_t *output_s8 = ESP_NN_TEST_ALLOC(max_out_ch);
+    int8_t *output_c = ESP_NN_TEST_ALLOC(max_out_ch);
+    int8_t *output_opt = ESP_NN_TEST_ALLOC(max_out_ch);
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+
+    if (!input || !filter_data || !filter_packed || !output_s8 || !output_c || !output_opt) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto fc_s4_cleanup;
+    }
+
+    for (int itr = 0; itr < 6; itr++) {
+        switch (itr) {
+        case 0: // whole blocks
+            row_len = 64;
+            out_channels = 16;
+            break;
+        case 1: // a partial last block
+            row_len = 271;
+            out_channels = 3;
+            break;
+        case 2: // fewer weights than half a block
+            row_len = 7;
+            out_channels = 16;
+            break;
+        case 3: // one block and one weight
+            row_len = 33;
+            out_channels = 8;
+            break;
+        case 4: // half a block
+            row_len = 16;
+            out_channels = 1;
+            break;
+        default:
+            row_len = rand() % max_row_len + 1;
+            out_channels = 5;
+            break;
+        }
+
+        for (int i = 0; i < row_len; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        for (int i = 0; i < row_len * out_channels; ++i) {
+            filter_data[i] = rand() % 16 - 8;
+        }
+        esp_nn_s4_pack(filter_packed, filter_data, out_channels, row_len);
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = rand() % 2001 - 1000;
+            out_shift[i] = -8 + rand() % 3;
+            out_mult[i] = 0x59e492c4 + rand() % INT16_MAX;
+        }
+
+        esp_nn_fully_connected_per_ch_s8_ansi(input, 5, row_len, filter_data, 0, bias, output_s8,
+                                              out_channels, -2, out_shift, out_mult, -128, 127);
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* C function */
+        esp_nn_fully_connected_per_ch_s4_ansi(input, 5, row_len, filter_packed, bias, output_c,
+                                              out_channels, -2, out_shift, out_mult, -128, 127);
+
+        total_c = profile_c_end();
+        profile_opt_start();
+
+        /* Optimized function */
+        esp_nn_fully_connected_per_ch_s4(input, 5, row_len, filter_packed, bias, output_opt,
+                                         out_channels, -2, out_shift, out_mult, -128, 127);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(output_s8, output_c, out_channels) &&
+                   CHECK_EQUAL(output_s8, output_opt, out_channels);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [row_len %"PRIu16", out_ch %"PRIu16"]\n"ANSI_COLOR_RESET,
+                   itr, row_len, out_channels);
+            goto fc_s4_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [row_len %"PRIu16", out_ch %"PRIu16"]"ANSI_COLOR_RESET,
+               itr, row_len, out_channels);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+    }
+
+fc_s4_cleanup:
+    if (input) {
+        free(input);
+    }
+    if (filter_data) {
+        free(filter_data);
+    }
+    if (filter_packed) {
+        free(filter_packed);
+    }
+    if (output_s8) {
+        free(output_s8);
+    }
+    if (output_c) {
+        free(output_c);
+    }
+    if (output_opt) {
+        free(output_opt);
+    }
+}
+
+/*
+ * Block sparse: a dense filter with whole 1x16 blocks zeroed, checked against
+ * the dense reference. Row 0 is all zeros, so only its bias is left.
+ */
+void esp_nn_fully_connected_s8_sparse_test()
+{
+    uint32_t total_c = 0, total_opt = 0;
+    const int32_t max_row_len = 300;
+    const int32_t max_out_ch = 16;
+    uint16_t row_len, out_channels;
+    int32_t out_shift[16], out_mult[16], bias[16];
+    void *blob_orig = NULL;
+
+    int8_t *input = ESP_NN_TEST_ALLOC(max_row_len);
+    int8_t *filter_data = ESP_NN_TEST_ALLOC(max_row_len * max_out_ch);
+    int8_t *output_c = ESP_NN_TEST_ALLOC(max_out_ch);
+    int8_t *output_opt = ESP_NN_TEST_ALLOC(max_out_ch);
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+
+    if (!input || !filter_data || !output_c || !output_opt) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto fc_sparse_cleanup;
+    }
+
+    for (int itr = 0; itr < 6; itr++) {
+        const bool per_ch = itr % 2;
+        switch (itr) {
+        case 0: // whole blocks
+        case 1:
+            row_len = 64;
+            out_channels = 8;
+            break;
+        case 2: // a partial last block: 271 = 16 * 16 + 15
+        case 3:
+            row_len = 271;
+            out_channels = 5;
+            break;
+        case 4: // shorter than a block
+            row_len = 9;
+            out_channels = 16;
+            break;
+        default: // one block and one weight
+            row_len = 17;
+            out_channels = 3;
+            break;
+        }
+
+        for (int i = 0; i < row_len; ++i) {
+            input[i] = rand() % 256 - 128;
+        }
+        /* about half of the blocks kept, row 0 none */
+        int32_t blocks = 0;
+        for (int ch = 0; ch < out_channels; ch++) {
+            for (int col = 0; col < row_len; col += ESP_NN_FC_SPARSE_BLOCK) {
+                const bool keep = ch != 0 && rand() % 2;
+                blocks += keep;
+                for (int i = col; i < col + ESP_NN_FC_SPARSE_BLOCK && i < row_len; i++) {
+                    filter_data[ch * row_len + i] = keep ? rand() % 255 - 127 : 0;
+                }
+            }
+        }
+        for (int i = 0; i < out_channels; ++i) {
+            bias[i] = rand() % 4001 - 2000;
+            out_shift[i] = per_ch ? -8 + rand() % 3 : -8;
+            out_mult[i] = per_ch ? 0x59e492c4 + rand() % INT16_MAX : 0x59e492c4;
+        }
+
+        const int32_t size = esp_nn_get_fully_connected_sparse_size(filter_data, row_len, out_channels);
+        blob_orig = ESP_NN_TEST_ALLOC(size + 16);
+        if (blob_orig == NULL) {
+            printf(ANSI_COLOR_RED"[%3d] blob alloc failed size %"PRIi32"\n"ANSI_COLOR_RESET, itr, size);
+            goto fc_sparse_cleanup;
+        }
+        void *blob = (void *) (((uintptr_t) blob_orig + 15) & ~15);
+
+        /* enable profiler */
+        profile_c_start();
+
+        /* C function: the dense layer */
+        esp_nn_fc_sparse_t *sparse;
+        if (per_ch) {
+            esp_nn_fully_connected_per_ch_s8_ansi(input, 3, row_len, filter_data, 0, bias, output_c,
+                                                  out_channels, -4, out_shift, out_mult, -128, 127);
+        } else {
+            esp_nn_fully_connected_s8_ansi(input, 3, row_len, filter_data, 0, bias, output_c,
+                                           out_channels, -4, out_shift[0], out_mult[0], -128, 127);
+        }
+
+        total_c = profile_c_end();
+
+        if (per_ch) {
+            sparse = esp_nn_fully_connected_per_ch_s8_sparse_pack(blob, 3, row_len, filter_data, bias,
+                                                                  out_channels, -4, out_shift, out_mult,
+                                                                  -128, 127);
+        } else {
+            sparse = esp_nn_fully_connected_s8_sparse_pack(blob, 3, row_len, filter_data, bias,
+                                                           out_channels, -4, out_shift[0], out_mult[0],
+                                                           -128, 127);
+        }
+        if (sparse == NULL || sparse->blocks != blocks || sparse->size > size) {
+            printf(ANSI_COLOR_RED"[%3d] pack failed, %"PRIi32" blocks of %"PRIi32"\n"ANSI_COLOR_RESET,
+                   itr, sparse ? sparse->blocks : 0, blocks);
+            goto fc_sparse_cleanup;
+        }
+
+        profile_opt_start();
+
+        /* Optimized function */
+        esp_nn_fully_connected_s8_sparse_run(sparse, input, output_opt);
+
+        /* disable profiler */
+        total_opt = profile_opt_end();
+
+        bool ret = CHECK_EQUAL(output_c, output_opt, out_channels);
+        if (ret == false) {
+            printf(ANSI_COLOR_RED"[%3d] failed [row_len %"PRIu16", out_ch %"PRIu16", %s]\n"ANSI_COLOR_RESET,
+                   itr, row_len, out_channels, per_ch ? "per_ch" : "per_tensor");
+            goto fc_sparse_cleanup;
+        }
+        printf(ANSI_COLOR_GREEN"[%3d] passed [row_len %"PRIu16", out_ch %"PRIu16", %s, blocks %"PRIi32"]"
+               ANSI_COLOR_RESET, itr, row_len, out_channels, per_ch ? "per_ch" : "per_tensor", blocks);
+        printf("\tcycles: c %8"PRIu32", opt %8"PRIu32"\n", total_c, total_opt);
+
+        free(blob_orig);
+        blob_orig = NULL;
+    }
+
+fc_sparse_cleanup:
+    if (input) {
+        free(input);
+    }
+    if (filter_data) {
+        free(filter_data);
+    }
+    if (output_c) {
+        free(output_c);
+    }
+    if (output_opt) {
+        free(output_opt);
+    }
+    if (blob_orig) {
+        free(blob_orig);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include <esp_nn.h>
+#include "test_utils.h"
+
+/*
+ * The int16 tables interpolate, they are not bit exact with the TFLite fixed
+ * point logistic and tanh. Their error against the exact functions, in LSB of
+ * the Q0.15 output, over every Q3.12 input. The README documents these bounds.
+ */
+#define LOGISTIC_S16_MAX_ERROR  1
+#define TANH_S16_MAX_ERROR      4
+
+static double sigmoid_d(double x)
+{
+    return 1.0 / (1.0 + exp(-x));
+}
+
+/* largest distance of `output` from fn over every input, the worst input in *at */
+static int32_t lut_s16_max_error(const int16_t *input, const int16_t *output,
+                                 int32_t size, double (*fn)(double), int32_t *at)
+{
+    int32_t max_error = 0;
+    for (int i = 0; i < size; i++) {
+        double ref = round(fn(input[i] / 4096.0) * 32768.0);
+        ref = ref > 32767 ? 32767 : (ref < -32768 ? -32768 : ref);
+        int32_t error = abs(output[i] - (int32_t) ref);
+        if (error > max_error) {
+            max_error = error;
+            *at = input[i];
+        }
+    }
+    return max_error;
+}
+
+void esp_nn_logistic_tanh_s16_test()
+{
+    const int32_t size = 65536;
+    int16_t *input = malloc(size * sizeof(int16_t));
+    int16_t *output = malloc(size * sizeof(int16_t));
+    int16_t *sigmoid_lut = malloc(esp_nn_get_logistic_s16_scratch_size());
+    int16_t *tanh_lut = malloc(esp_nn_get_tanh_s16_scratch_size());
+    int32_t at = 0;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+
+    if (input == NULL || output == NULL || sigmoid_lut == NULL || tanh_lut == NULL) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto logistic_cleanup;
+    }
+
+    for (int i = 0; i < size; i++) {
+        input[i] = i - 32768;
+    }
+
+    esp_nn_logistic_s16_prepare(sigmoid_lut);
+    profile_opt_start();
+    esp_nn_logistic_s16(input, output, size, sigmoid_lut);
+    profile_opt_end();
+    int32_t error = lut_s16_max_error(input, output, size, sigmoid_d, &at);
+    if (error > LOGISTIC_S16_MAX_ERROR) {
+        printf(ANSI_COLOR_RED"logistic_s16 failed, error %"PRIi32" LSB at %"PRIi32
+               ", bound %d\n"ANSI_COLOR_RESET, error, at, LOGISTIC_S16_MAX_ERROR);
+        goto logistic_cleanup;
+    }
+    printf(ANSI_COLOR_GREEN"logistic_s16 passed, max error %"PRIi32" LSB\n"ANSI_COLOR_RESET, error);
+
+    esp_nn_tanh_s16_prepare(tanh_lut);
+    profile_opt_start();
+    esp_nn_tanh_s16(input, output, size, tanh_lut);
+    profile_opt_end();
+    error = lut_s16_max_error(input, output, size, tanh, &at);
+    if (error > TANH_S16_MAX_ERROR) {
+        printf(ANSI_COLOR_RED"tanh_s16 failed, error %"PRIi32" LSB at %"PRIi32
+               ", bound %d\n"ANSI_COLOR_RESET, error, at, TANH_S16_MAX_ERROR);
+        goto logistic_cleanup;
+    }
+    printf(ANSI_COLOR_GREEN"tanh_s16 passed, max error %"PRIi32" LSB\n"ANSI_COLOR_RESET, error);
+
+logistic_cleanup:
+    if (input) free(input);
+    if (output) free(output);
+    if (sigmoid_lut) free(sigmoid_lut);
+    if (tanh_lut) free(tanh_lut);
+}
@@ -0,0 +1,692 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <math.h>
+
+#include <common_functions.h>
+#include <esp_nn.h>
+#include "model_layers.h"
+
+/*
+ * Layer shapes follow the reference graphs:
+ *  - MobileNetV3-Small (224x224x3, 1000 classes), Keras `MobileNetV3Small` op order.
+ *    Hard-sigmoid of the SE blocks touches `channels` bytes and is folded into
+ *    the RELU6 clamp of `se_expand`; the head 1x1 convolutions on the 1x1 map
+ *    are replayed as fully connected layers.
+ *  - Person Detection (Visual Wake Words, MobileNetV1 0.25, 96x96x1) as shipped
+ *    with tflite-micro: every conv/depthwise has fused RELU6, SAME padding.
+ * Zero points and scales are representative of int8 post-training quantisation
+ * (RELU outputs at -128, hard_swish outputs at -128 + 0.375 / scale) and are not
+ * copied from a particular .tflite file. Per-channel filter scales are spread
+ * around `w_scale`, kernel params are derived from the scales as TFLite does.
+ */
+
+static const model_layer_t mobilenet_v3_small_layers[] = {
+    /* name, op, in wd/ht/ch, out wd/ht/ch, filter, stride, pad, act, in_zp, out_zp, in_scale, out_scale, w_scale */
+    {"stem_conv", MODEL_OP_CONV, 224, 224, 3, 112, 112, 16, 3, 2, 0, MODEL_ACT_NONE, -1, 0, 0.00784f, 0.14635f, 0.0179f},
+    {"stem_hs", MODEL_OP_HARD_SWISH, 112, 112, 16, 112, 112, 16, 1, 1, 0, MODEL_ACT_NONE, 0, -123, 0.14635f, 0.08191f, 0.0f},
+    {"b0_dw", MODEL_OP_DEPTHWISE, 112, 112, 16, 56, 56, 16, 3, 2, 0, MODEL_ACT_RELU, -123, -128, 0.08191f, 0.07106f, 0.02565f},
+    {"b0_se_mean", MODEL_OP_MEAN, 56, 56, 16, 1, 1, 16, 1, 1, 0, MODEL_ACT_NONE, -128, -128, 0.07106f, 0.05506f, 0.0f},
+    {"b0_se_reduce", MODEL_OP_CONV, 1, 1, 16, 1, 1, 8, 1, 1, 0, MODEL_ACT_RELU, -128, -128, 0.05506f, 0.05639f, 0.00822f},
+    {"b0_se_expand", MODEL_OP_CONV, 1, 1, 8, 1, 1, 16, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.05639f, 0.00392f, 0.00629f},
+    {"b0_se_mul", MODEL_OP_MUL_BROADCAST, 56, 56, 16, 56, 56, 16, 1, 1, 0, MODEL_ACT_NONE, -128, -128, 0.07106f, 0.04651f, 0.00392f},
+    {"b0_project", MODEL_OP_CONV, 56, 56, 16, 56, 56, 16, 1, 1, 0, MODEL_ACT_NONE, -128, -3, 0.04651f, 0.11814f, 0.0074f},
+    {"b1_expand", MODEL_OP_CONV, 56, 56, 16, 56, 56, 72, 1, 1, 0, MODEL_ACT_RELU, -3, -128, 0.11814f, 0.07134f, 0.00499f},
+    {"b1_dw", MODEL_OP_DEPTHWISE, 56, 56, 72, 28, 28, 72, 3, 2, 0, MODEL_ACT_RELU, -128, -128, 0.07134f, 0.04116f, 0.05765f},
+    {"b1_project", MODEL_OP_CONV, 28, 28, 72, 28, 28, 24, 1, 1, 0, MODEL_ACT_NONE, -128, -9, 0.04116f, 0.21542f, 0.00717f},
+    {"b2_expand", MODEL_OP_CONV, 28, 28, 24, 28, 28, 88, 1, 1, 0, MODEL_ACT_RELU, -9, -128, 0.21542f, 0.07881f, 0.00437f},
+    {"b2_dw", MODEL_OP_DEPTHWISE, 28, 28, 88, 28, 28, 88, 3, 1, 1, MODEL_ACT_RELU, -128, -128, 0.07881f, 0.07292f, 0.03738f},
+    {"b2_project", MODEL_OP_CONV, 28, 28, 88, 28, 28, 24, 1, 1, 0, MODEL_ACT_NONE, -128, -6, 0.07292f, 0.20814f, 0.00857f},
+    {"b2_add", MODEL_OP_ADD, 28, 28, 24, 28, 28, 24, 1, 1, 0, MODEL_ACT_NONE, -6, -5, 0.20814f, 0.25163f, 0.21542f},
+    {"b3_expand", MODEL_OP_CONV, 28, 28, 24, 28, 28, 96, 1, 1, 0, MODEL_ACT_NONE, -5, -14, 0.25163f, 0.14979f, 0.00911f},
+    {"b3_expand_hs", MODEL_OP_HARD_SWISH, 28, 28, 96, 28, 28, 96, 1, 1, 0, MODEL_ACT_NONE, -14, -124, 0.14979f, 0.09354f, 0.0f},
+    {"b3_dw", MODEL_OP_DEPTHWISE, 28, 28, 96, 14, 14, 96, 5, 2, 1, MODEL_ACT_NONE, -124, 15, 0.09354f, 0.16545f, 0.05386f},
+    {"b3_dw_hs", MODEL_OP_HARD_SWISH, 14, 14, 96, 14, 14, 96, 1, 1, 0, MODEL_ACT_NONE, 15, -125, 0.16545f, 0.11148f, 0.0f},
+    {"b3_se_mean", MODEL_OP_MEAN, 14, 14, 96, 1, 1, 96, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.11148f, 0.08349f, 0.0f},
+    {"b3_se_reduce", MODEL_OP_CONV, 1, 1, 96, 1, 1, 24, 1, 1, 0, MODEL_ACT_RELU, -125, -128, 0.08349f, 0.04127f, 0.01666f},
+    {"b3_se_expand", MODEL_OP_CONV, 1, 1, 24, 1, 1, 96, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.04127f, 0.00392f, 0.01198f},
+    {"b3_se_mul", MODEL_OP_MUL_BROADCAST, 14, 14, 96, 14, 14, 96, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.11148f, 0.08705f, 0.00392f},
+    {"b3_project", MODEL_OP_CONV, 14, 14, 96, 14, 14, 40, 1, 1, 0, MODEL_ACT_NONE, -125, 1, 0.08705f, 0.15995f, 0.01036f},
+    {"b4_expand", MODEL_OP_CONV, 14, 14, 40, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, 1, -5, 0.15995f, 0.08982f, 0.0064f},
+    {"b4_expand_hs", MODEL_OP_HARD_SWISH, 14, 14, 240, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, -5, -122, 0.08982f, 0.05829f, 0.0f},
+    {"b4_dw", MODEL_OP_DEPTHWISE, 14, 14, 240, 14, 14, 240, 5, 1, 2, MODEL_ACT_NONE, -122, 1, 0.05829f, 0.16753f, 0.03728f},
+    {"b4_dw_hs", MODEL_OP_HARD_SWISH, 14, 14, 240, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, 1, -125, 0.16753f, 0.12498f, 0.0f},
+    {"b4_se_mean", MODEL_OP_MEAN, 14, 14, 240, 1, 1, 240, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.12498f, 0.07941f, 0.0f},
+    {"b4_se_reduce", MODEL_OP_CONV, 1, 1, 240, 1, 1, 64, 1, 1, 0, MODEL_ACT_RELU, -125, -128, 0.07941f, 0.03672f, 0.01636f},
+    {"b4_se_expand", MODEL_OP_CONV, 1, 1, 64, 1, 1, 240, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.03672f, 0.00392f, 0.00728f},
+    {"b4_se_mul", MODEL_OP_MUL_BROADCAST, 14, 14, 240, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.12498f, 0.08402f, 0.00392f},
+    {"b4_project", MODEL_OP_CONV, 14, 14, 240, 14, 14, 40, 1, 1, 0, MODEL_ACT_NONE, -125, -9, 0.08402f, 0.2924f, 0.00462f},
+    {"b4_add", MODEL_OP_ADD, 14, 14, 40, 14, 14, 40, 1, 1, 0, MODEL_ACT_NONE, -9, 0, 0.2924f, 0.34135f, 0.15995f},
+    {"b5_expand", MODEL_OP_CONV, 14, 14, 40, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, 0, 1, 0.34135f, 0.16344f, 0.00875f},
+    {"b5_expand_hs", MODEL_OP_HARD_SWISH, 14, 14, 240, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, 1, -125, 0.16344f, 0.10885f, 0.0f},
+    {"b5_dw", MODEL_OP_DEPTHWISE, 14, 14, 240, 14, 14, 240, 5, 1, 2, MODEL_ACT_NONE, -125, 9, 0.10885f, 0.08825f, 0.02562f},
+    {"b5_dw_hs", MODEL_OP_HARD_SWISH, 14, 14, 240, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, 9, -121, 0.08825f, 0.0533f, 0.0f},
+    {"b5_se_mean", MODEL_OP_MEAN, 14, 14, 240, 1, 1, 240, 1, 1, 0, MODEL_ACT_NONE, -121, -121, 0.0533f, 0.04313f, 0.0f},
+    {"b5_se_reduce", MODEL_OP_CONV, 1, 1, 240, 1, 1, 64, 1, 1, 0, MODEL_ACT_RELU, -121, -128, 0.04313f, 0.0226f, 0.01597f},
+    {"b5_se_expand", MODEL_OP_CONV, 1, 1, 64, 1, 1, 240, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.0226f, 0.00392f, 0.00964f},
+    {"b5_se_mul", MODEL_OP_MUL_BROADCAST, 14, 14, 240, 14, 14, 240, 1, 1, 0, MODEL_ACT_NONE, -121, -121, 0.0533f, 0.03702f, 0.00392f},
+    {"b5_project", MODEL_OP_CONV, 14, 14, 240, 14, 14, 40, 1, 1, 0, MODEL_ACT_NONE, -121, 4, 0.03702f, 0.15692f, 0.00709f},
+    {"b5_add", MODEL_OP_ADD, 14, 14, 40, 14, 14, 40, 1, 1, 0, MODEL_ACT_NONE, 4, -10, 0.15692f, 0.40982f, 0.34135f},
+    {"b6_expand", MODEL_OP_CONV, 14, 14, 40, 14, 14, 120, 1, 1, 0, MODEL_ACT_NONE, -10, 9, 0.40982f, 0.12266f, 0.00889f},
+    {"b6_expand_hs", MODEL_OP_HARD_SWISH, 14, 14, 120, 14, 14, 120, 1, 1, 0, MODEL_ACT_NONE, 9, -123, 0.12266f, 0.07957f, 0.0f},
+    {"b6_dw", MODEL_OP_DEPTHWISE, 14, 14, 120, 14, 14, 120, 5, 1, 2, MODEL_ACT_NONE, -123, -7, 0.07957f, 0.17219f, 0.02776f},
+    {"b6_dw_hs", MODEL_OP_HARD_SWISH, 14, 14, 120, 14, 14, 120, 1, 1, 0, MODEL_ACT_NONE, -7, -124, 0.17219f, 0.10323f, 0.0f},
+    {"b6_se_mean", MODEL_OP_MEAN, 14, 14, 120, 1, 1, 120, 1, 1, 0, MODEL_ACT_NONE, -124, -124, 0.10323f, 0.07404f, 0.0f},
+    {"b6_se_reduce", MODEL_OP_CONV, 1, 1, 120, 1, 1, 32, 1, 1, 0, MODEL_ACT_RELU, -124, -128, 0.07404f, 0.05486f, 0.00621f},
+    {"b6_se_expand", MODEL_OP_CONV, 1, 1, 32, 1, 1, 120, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.05486f, 0.00392f, 0.01174f},
+    {"b6_se_mul", MODEL_OP_MUL_BROADCAST, 14, 14, 120, 14, 14, 120, 1, 1, 0, MODEL_ACT_NONE, -124, -124, 0.10323f, 0.07096f, 0.00392f},
+    {"b6_project", MODEL_OP_CONV, 14, 14, 120, 14, 14, 48, 1, 1, 0, MODEL_ACT_NONE, -124, -6, 0.07096f, 0.26386f, 0.01091f},
+    {"b7_expand", MODEL_OP_CONV, 14, 14, 48, 14, 14, 144, 1, 1, 0, MODEL_ACT_NONE, -6, -3, 0.26386f, 0.16477f, 0.01189f},
+    {"b7_expand_hs", MODEL_OP_HARD_SWISH, 14, 14, 144, 14, 14, 144, 1, 1, 0, MODEL_ACT_NONE, -3, -125, 0.16477f, 0.11312f, 0.0f},
+    {"b7_dw", MODEL_OP_DEPTHWISE, 14, 14, 144, 14, 14, 144, 5, 1, 2, MODEL_ACT_NONE, -125, 4, 0.11312f, 0.19493f, 0.02906f},
+    {"b7_dw_hs", MODEL_OP_HARD_SWISH, 14, 14, 144, 14, 14, 144, 1, 1, 0, MODEL_ACT_NONE, 4, -125, 0.19493f, 0.11408f, 0.0f},
+    {"b7_se_mean", MODEL_OP_MEAN, 14, 14, 144, 1, 1, 144, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.11408f, 0.07639f, 0.0f},
+    {"b7_se_reduce", MODEL_OP_CONV, 1, 1, 144, 1, 1, 40, 1, 1, 0, MODEL_ACT_RELU, -125, -128, 0.07639f, 0.02933f, 0.01227f},
+    {"b7_se_expand", MODEL_OP_CONV, 1, 1, 40, 1, 1, 144, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02933f, 0.00392f, 0.01384f},
+    {"b7_se_mul", MODEL_OP_MUL_BROADCAST, 14, 14, 144, 14, 14, 144, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.11408f, 0.07024f, 0.00392f},
+    {"b7_project", MODEL_OP_CONV, 14, 14, 144, 14, 14, 48, 1, 1, 0, MODEL_ACT_NONE, -125, -10, 0.07024f, 0.12914f, 0.00828f},
+    {"b7_add", MODEL_OP_ADD, 14, 14, 48, 14, 14, 48, 1, 1, 0, MODEL_ACT_NONE, -10, 0, 0.12914f, 0.31213f, 0.26386f},
+    {"b8_expand", MODEL_OP_CONV, 14, 14, 48, 14, 14, 288, 1, 1, 0, MODEL_ACT_NONE, 0, -12, 0.31213f, 0.16286f, 0.00812f},
+    {"b8_expand_hs", MODEL_OP_HARD_SWISH, 14, 14, 288, 14, 14, 288, 1, 1, 0, MODEL_ACT_NONE, -12, -125, 0.16286f, 0.10969f, 0.0f},
+    {"b8_dw", MODEL_OP_DEPTHWISE, 14, 14, 288, 7, 7, 288, 5, 2, 1, MODEL_ACT_NONE, -125, -17, 0.10969f, 0.1348f, 0.07226f},
+    {"b8_dw_hs", MODEL_OP_HARD_SWISH, 7, 7, 288, 7, 7, 288, 1, 1, 0, MODEL_ACT_NONE, -17, -124, 0.1348f, 0.0998f, 0.0f},
+    {"b8_se_mean", MODEL_OP_MEAN, 7, 7, 288, 1, 1, 288, 1, 1, 0, MODEL_ACT_NONE, -124, -124, 0.0998f, 0.08026f, 0.0f},
+    {"b8_se_reduce", MODEL_OP_CONV, 1, 1, 288, 1, 1, 72, 1, 1, 0, MODEL_ACT_RELU, -124, -128, 0.08026f, 0.04237f, 0.01097f},
+    {"b8_se_expand", MODEL_OP_CONV, 1, 1, 72, 1, 1, 288, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.04237f, 0.00392f, 0.01091f},
+    {"b8_se_mul", MODEL_OP_MUL_BROADCAST, 7, 7, 288, 7, 7, 288, 1, 1, 0, MODEL_ACT_NONE, -124, -124, 0.0998f, 0.0669f, 0.00392f},
+    {"b8_project", MODEL_OP_CONV, 7, 7, 288, 7, 7, 96, 1, 1, 0, MODEL_ACT_NONE, -124, 2, 0.0669f, 0.11245f, 0.00454f},
+    {"b9_expand", MODEL_OP_CONV, 7, 7, 96, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, 2, -7, 0.11245f, 0.13288f, 0.00488f},
+    {"b9_expand_hs", MODEL_OP_HARD_SWISH, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -7, -124, 0.13288f, 0.08905f, 0.0f},
+    {"b9_dw", MODEL_OP_DEPTHWISE, 7, 7, 576, 7, 7, 576, 5, 1, 2, MODEL_ACT_NONE, -124, -14, 0.08905f, 0.08003f, 0.02908f},
+    {"b9_dw_hs", MODEL_OP_HARD_SWISH, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -14, -120, 0.08003f, 0.04564f, 0.0f},
+    {"b9_se_mean", MODEL_OP_MEAN, 7, 7, 576, 1, 1, 576, 1, 1, 0, MODEL_ACT_NONE, -120, -120, 0.04564f, 0.03236f, 0.0f},
+    {"b9_se_reduce", MODEL_OP_CONV, 1, 1, 576, 1, 1, 144, 1, 1, 0, MODEL_ACT_RELU, -120, -128, 0.03236f, 0.02102f, 0.01811f},
+    {"b9_se_expand", MODEL_OP_CONV, 1, 1, 144, 1, 1, 576, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02102f, 0.00392f, 0.01421f},
+    {"b9_se_mul", MODEL_OP_MUL_BROADCAST, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -120, -120, 0.04564f, 0.0268f, 0.00392f},
+    {"b9_project", MODEL_OP_CONV, 7, 7, 576, 7, 7, 96, 1, 1, 0, MODEL_ACT_NONE, -120, -2, 0.0268f, 0.29109f, 0.00882f},
+    {"b9_add", MODEL_OP_ADD, 7, 7, 96, 7, 7, 96, 1, 1, 0, MODEL_ACT_NONE, -2, -7, 0.29109f, 0.3325f, 0.11245f},
+    {"b10_expand", MODEL_OP_CONV, 7, 7, 96, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -7, 11, 0.3325f, 0.19917f, 0.00773f},
+    {"b10_expand_hs", MODEL_OP_HARD_SWISH, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, 11, -125, 0.19917f, 0.12882f, 0.0f},
+    {"b10_dw", MODEL_OP_DEPTHWISE, 7, 7, 576, 7, 7, 576, 5, 1, 2, MODEL_ACT_NONE, -125, -15, 0.12882f, 0.09729f, 0.06498f},
+    {"b10_dw_hs", MODEL_OP_HARD_SWISH, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -15, -122, 0.09729f, 0.06792f, 0.0f},
+    {"b10_se_mean", MODEL_OP_MEAN, 7, 7, 576, 1, 1, 576, 1, 1, 0, MODEL_ACT_NONE, -122, -122, 0.06792f, 0.0505f, 0.0f},
+    {"b10_se_reduce", MODEL_OP_CONV, 1, 1, 576, 1, 1, 144, 1, 1, 0, MODEL_ACT_RELU, -122, -128, 0.0505f, 0.04768f, 0.01275f},
+    {"b10_se_expand", MODEL_OP_CONV, 1, 1, 144, 1, 1, 576, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.04768f, 0.00392f, 0.00808f},
+    {"b10_se_mul", MODEL_OP_MUL_BROADCAST, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -122, -122, 0.06792f, 0.05352f, 0.00392f},
+    {"b10_project", MODEL_OP_CONV, 7, 7, 576, 7, 7, 96, 1, 1, 0, MODEL_ACT_NONE, -122, 1, 0.05352f, 0.12932f, 0.00835f},
+    {"b10_add", MODEL_OP_ADD, 7, 7, 96, 7, 7, 96, 1, 1, 0, MODEL_ACT_NONE, 1, 6, 0.12932f, 0.3352f, 0.3325f},
+    {"head_conv", MODEL_OP_CONV, 7, 7, 96, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, 6, -1, 0.3352f, 0.19785f, 0.01091f},
+    {"head_hs", MODEL_OP_HARD_SWISH, 7, 7, 576, 7, 7, 576, 1, 1, 0, MODEL_ACT_NONE, -1, -125, 0.19785f, 0.13637f, 0.0f},
+    {"head_mean", MODEL_OP_MEAN, 7, 7, 576, 1, 1, 576, 1, 1, 0, MODEL_ACT_NONE, -125, -125, 0.13637f, 0.04803f, 0.0f},
+    {"head_fc1", MODEL_OP_FC, 1, 1, 576, 1, 1, 1024, 1, 1, 0, MODEL_ACT_NONE, -125, 3, 0.04803f, 0.09541f, 0.00478f},
+    {"head_fc1_hs", MODEL_OP_HARD_SWISH, 1, 1, 1024, 1, 1, 1024, 1, 1, 0, MODEL_ACT_NONE, 3, -121, 0.09541f, 0.05673f, 0.0f},
+    {"logits", MODEL_OP_FC, 1, 1, 1024, 1, 1, 1000, 1, 1, 0, MODEL_ACT_NONE, -121, -13, 0.05673f, 0.17791f, 0.00332f},
+    {"softmax", MODEL_OP_SOFTMAX, 1, 1, 1000, 1, 1, 1000, 1, 1, 0, MODEL_ACT_NONE, -13, -128, 0.17791f, 0.00390625f, 0.0f},
+};
+
+static const model_layer_t person_detection_layers[] = {
+    /* name, op, in wd/ht/ch, out wd/ht/ch, filter, stride, pad, act, in_zp, out_zp, in_scale, out_scale, w_scale */
+    {"conv_0", MODEL_OP_CONV, 96, 96, 1, 48, 48, 8, 3, 2, 0, MODEL_ACT_RELU6, -128, -128, 0.00392f, 0.02353f, 0.01446f},
+    {"dw_1", MODEL_OP_DEPTHWISE, 48, 48, 8, 48, 48, 8, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.08492f},
+    {"pw_1", MODEL_OP_CONV, 48, 48, 8, 48, 48, 16, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.01976f},
+    {"dw_2", MODEL_OP_DEPTHWISE, 48, 48, 16, 24, 24, 16, 3, 2, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.08821f},
+    {"pw_2", MODEL_OP_CONV, 24, 24, 16, 24, 24, 32, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.0169f},
+    {"dw_3", MODEL_OP_DEPTHWISE, 24, 24, 32, 24, 24, 32, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.08547f},
+    {"pw_3", MODEL_OP_CONV, 24, 24, 32, 24, 24, 32, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.01584f},
+    {"dw_4", MODEL_OP_DEPTHWISE, 24, 24, 32, 12, 12, 32, 3, 2, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.03814f},
+    {"pw_4", MODEL_OP_CONV, 12, 12, 32, 12, 12, 64, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.01228f},
+    {"dw_5", MODEL_OP_DEPTHWISE, 12, 12, 64, 12, 12, 64, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.04845f},
+    {"pw_5", MODEL_OP_CONV, 12, 12, 64, 12, 12, 64, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.00446f},
+    {"dw_6", MODEL_OP_DEPTHWISE, 12, 12, 64, 6, 6, 64, 3, 2, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.02223f},
+    {"pw_6", MODEL_OP_CONV, 6, 6, 64, 6, 6, 128, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.00847f},
+    {"dw_7", MODEL_OP_DEPTHWISE, 6, 6, 128, 6, 6, 128, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.04073f},
+    {"pw_7", MODEL_OP_CONV, 6, 6, 128, 6, 6, 128, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.01508f},
+    {"dw_8", MODEL_OP_DEPTHWISE, 6, 6, 128, 6, 6, 128, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.09652f},
+    {"pw_8", MODEL_OP_CONV, 6, 6, 128, 6, 6, 128, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.01116f},
+    {"dw_9", MODEL_OP_DEPTHWISE, 6, 6, 128, 6, 6, 128, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.09496f},
+    {"pw_9", MODEL_OP_CONV, 6, 6, 128, 6, 6, 128, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.01981f},
+    {"dw_10", MODEL_OP_DEPTHWISE, 6, 6, 128, 6, 6, 128, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.0964f},
+    {"pw_10", MODEL_OP_CONV, 6, 6, 128, 6, 6, 128, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.00983f},
+    {"dw_11", MODEL_OP_DEPTHWISE, 6, 6, 128, 6, 6, 128, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.03764f},
+    {"pw_11", MODEL_OP_CONV, 6, 6, 128, 6, 6, 128, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.00763f},
+    {"dw_12", MODEL_OP_DEPTHWISE, 6, 6, 128, 3, 3, 128, 3, 2, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.03574f},
+    {"pw_12", MODEL_OP_CONV, 3, 3, 128, 3, 3, 256, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.00727f},
+    {"dw_13", MODEL_OP_DEPTHWISE, 3, 3, 256, 3, 3, 256, 3, 1, 1, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.06993f},
+    {"pw_13", MODEL_OP_CONV, 3, 3, 256, 3, 3, 256, 1, 1, 0, MODEL_ACT_RELU6, -128, -128, 0.02353f, 0.02353f, 0.0184f},
+    {"avg_pool", MODEL_OP_AVG_POOL, 3, 3, 256, 1, 1, 256, 3, 1, 0, MODEL_ACT_NONE, -128, -128, 0.02353f, 0.02353f, 0.0f},
+    {"logits", MODEL_OP_CONV, 1, 1, 256, 1, 1, 2, 1, 1, 0, MODEL_ACT_NONE, -128, 5, 0.02353f, 0.09546f, 0.00904f},
+    {"softmax", MODEL_OP_SOFTMAX, 1, 1, 2, 1, 1, 2, 1, 1, 0, MODEL_ACT_NONE, 5, -128, 0.09546f, 0.00390625f, 0.0f},
+};
+
+const model_desc_t model_mobilenet_v3_small = {
+    .name = "mobilenet_v3_small",
+    .layers = mobilenet_v3_small_layers,
+    .num_layers = sizeof(mobilenet_v3_small_layers) / sizeof(mobilenet_v3_small_layers[0]),
+};
+
+const model_desc_t model_person_detection = {
+    .name = "person_detection",
+    .layers = person_detection_layers,
+    .num_layers = sizeof(person_detection_layers) / sizeof(person_detection_layers[0]),
+};
+
+/* TFLite QuantizeMultiplier: real = mult * 2^(shift - 31) */
+static void quantize_multiplier(double real, int32_t *mult, int32_t *shift)
+{
+    if (real == 0.0) {
+        *mult = 0;
+        *shift = 0;
+        return;
+    }
+    int exp;
+    const double q = frexp(real, &exp);
+    int64_t q_fixed = (int64_t) llround(q * (1ll << 31));
+    if (q_fixed == (1ll << 31)) {
+        q_fixed /= 2;
+        exp++;
+    }
+    if (exp < -31) {
+        exp = 0;
+        q_fixed = 0;
+    }
+    *mult = (int32_t) q_fixed;
+    *shift = exp;
+}
+
+static int16_t downscale_mult_to_s16(int32_t mult)
+{
+    if (mult >= INT32_MAX - (1 << 15)) {
+        return INT16_MAX;
+    }
+    return (int16_t) ((mult + (1 << 15)) >> 16);
+}
+
+static void *layer_alloc(int32_t size)
+{
+    void *buf = memalign(16, (size + 15) & ~15);
+    if (buf) {
+        memset(buf, 0, (size + 15) & ~15);
+    }
+    return buf;
+}
+
+static void fill_random(int8_t *buf, int32_t len)
+{
+    for (int32_t i = 0; i < len; i++) {
+        buf[i] = rand() % 256 - 128;
+    }
+}
+
+static void layer_act_range(const model_layer_t *layer, int32_t *act_min, int32_t *act_max)
+{
+    *act_min = -128;
+    *act_max = 127;
+    if (layer->act == MODEL_ACT_RELU || layer->act == MODEL_ACT_RELU6) {
+        *act_min = max(-128, layer->out_zp);
+    }
+    if (layer->act == MODEL_ACT_RELU6) {
+        *act_max = min(127, layer->out_zp + (int32_t) lroundf(6.0f / layer->out_scale));
+    }
+}
+
+const char *model_op_name(model_op_t op)
+{
+    switch (op) {
+    case MODEL_OP_CONV:          return "conv_s8";
+    case MODEL_OP_DEPTHWISE:     return "depthwise_conv_s8";
+    case MODEL_OP_FC:            return "fully_connected_s8";
+    case MODEL_OP_HARD_SWISH:    return "hard_swish_s8";
+    case MODEL_OP_MEAN:          return "mean_nhwc_s8";
+    case MODEL_OP_MUL_BROADCAST: return "mul_broadcast_channel_s8";
+    case MODEL_OP_ADD:           return "add_elementwise_s8";
+    case MODEL_OP_AVG_POOL:      return "avg_pool_s8";
+    case MODEL_OP_SOFTMAX:       return "softmax_s8";
+    }
+    return "unknown";
+}
+
+int64_t model_layer_macs(const model_layer_t *layer)
+{
+    const int64_t out_size = (int64_t) layer->out_wd * layer->out_ht * layer->out_ch;
+    switch (layer->op) {
+    case MODEL_OP_CONV:
+        return out_size * layer->filter * layer->filter * layer->in_ch;
+    case MODEL_OP_DEPTHWISE:
+    case MODEL_OP_AVG_POOL:
+        return out_size * layer->filter * layer->filter;
+    case MODEL_OP_FC:
+        return (int64_t) layer->in_ch * layer->out_ch;
+    case MODEL_OP_MEAN:
+        return (int64_t) layer->in_wd * layer->in_ht * layer->in_ch;
+    default:
+        return out_size;
+    }
+}
+
+void model_layer_shape_str(const model_layer_t *layer, char *buf, int len)
+{
+    switch (layer->op) {
+    case MODEL_OP_CONV:
+    case MODEL_OP_DEPTHWISE:
+    case MODEL_OP_AVG_POOL:
+        snprintf(buf, len, "in=%dx%dx%d f=%dx%d s=%d p=%d out=%dx%dx%d",
+                 layer->in_wd, layer->in_ht, layer->in_ch, layer->filter, layer->filter,
+                 layer->stride, layer->pad, layer->out_wd, layer->out_ht, layer->out_ch);
+        break;
+    case MODEL_OP_FC:
+        snprintf(buf, len, "row_len=%d out_ch=%d", layer->in_ch, layer->out_ch);
+        break;
+    default:
+        snprintf(buf, len, "in=%dx%dx%d", layer->in_wd, layer->in_ht, layer->in_ch);
+        break;
+    }
+}
+
+int model_layer_init(model_layer_inst_t *inst, const model_layer_t *layer)
+{
+    memset(inst, 0, sizeof(*inst));
+    inst->layer = layer;
+
+    const int32_t in_size = layer->in_wd * layer->in_ht * layer->in_ch;
+    const int32_t out_ch = layer->out_ch;
+    int32_t filter_size = 0;
+    int32_t act_min, act_max;
+    layer_act_range(layer, &act_min, &act_max);
+
+    inst->out_size = layer->out_wd * layer->out_ht * out_ch;
+    inst->input_dims = (data_dims_t) {layer->in_wd, layer->in_ht, layer->in_ch, 1};
+    inst->output_dims = (data_dims_t) {layer->out_wd, layer->out_ht, out_ch, 1};
+
+    if (layer->op == MODEL_OP_CONV) {
+        filter_size = layer->filter * layer->filter * layer->in_ch * out_ch;
+        inst->filter_dims = (data_dims_t) {layer->filter, layer->filter, layer->in_ch, 1};
+        inst->conv_params = (conv_params_t) {
+            .in_offset = -layer->in_zp, .out_offset = layer->out_zp,
+            .stride = {layer->stride, layer->stride}, .padding = {layer->pad, layer->pad},
+            .dilation = {1, 1}, .activation = {act_min, act_max},
+        };
+    } else if (layer->op == MODEL_OP_DEPTHWISE) {
+        filter_size = layer->filter * layer->filter * out_ch;
+        inst->filter_dims = (data_dims_t) {layer->filter, layer->filter, 0, 0};
+        inst->dw_params = (dw_conv_params_t) {
+            .in_offset = -layer->in_zp, .out_offset = layer->out_zp,
+            .ch_mult = out_ch / layer->in_ch,
+            .stride = {layer->stride, layer->stride}, .padding = {layer->pad, layer->pad},
+            .dilation = {1, 1}, .activation = {act_min, act_max},
+        };
+    } else if (layer->op == MODEL_OP_FC) {
+        filter_size = layer->in_ch * out_ch;
+        inst->conv_params.activation = (act_params_t) {act_min, act_max};
+    } else {
+        inst->conv_params.activation = (act_params_t) {act_min, act_max};
+    }
+
+    inst->input = layer_alloc(in_size);
+    inst->out_ansi = layer_alloc(inst->out_size);
+    inst->out_opt = layer_alloc(inst->out_size);
+    if (!inst->input || !inst->out_ansi || !inst->out_opt) {
+        goto alloc_failed;
+    }
+    fill_random(inst->input, in_size);
+
+    if (filter_size) {
+        inst->filter = layer_alloc(filter_size);
+        inst->bias = layer_alloc(out_ch * sizeof(int32_t));
+        inst->quant.mult = layer_alloc(out_ch * sizeof(int32_t));
+        inst->quant.shift = layer_alloc(out_ch * sizeof(int32_t));
+        if (!inst->filter || !inst->bias || !inst->quant.mult || !inst->quant.shift) {
+            goto alloc_failed;
+        }
+        fill_random(inst->filter, filter_size);
+        for (int ch = 0; ch < out_ch; ch++) {
+            /* per-channel filter scale in [0.5, 1.5) x w_scale, float bias in [-0.5, 0.5] */
+            const double w_scale = layer->w_scale * (0.5 + (rand() % 1024) / 1024.0);
+            const double acc_scale = layer->in_scale * w_scale;
+            quantize_multiplier(acc_scale / layer->out_scale, &inst->quant.mult[ch], &inst->quant.shift[ch]);
+            inst->bias[ch] = (int32_t) ((rand() % 1001 - 500) / 1000.0 / acc_scale);
+        }
+        inst->mult = inst->quant.mult[0];
+        inst->shift = inst->quant.shift[0];
+    }
+
+    switch (layer->op) {
+    case MODEL_OP_CONV: {
+        int scratch_size = esp_nn_get_conv_scratch_size(&inst->input_dims, &inst->filter_dims,
+                                                        &inst->output_dims, &inst->conv_params);
+        if (scratch_size > 0 && (inst->scratch = layer_alloc(scratch_size)) == NULL) {
+            goto alloc_failed;
+        }
+        /* conv and fc opt runs go through the prepared layer, as an interpreter would */
+        int32_t prepared_size = esp_nn_get_conv_prepared_size(&inst->input_dims, &inst->filter_dims,
+                                                              &inst->output_dims, &inst->conv_params);
+        if ((inst->prepared = layer_alloc(prepared_size)) == NULL) {
+            goto alloc_failed;
+        }
+        esp_nn_conv_s8_prepare(inst->prepared, &inst->input_dims, &inst->filter_dims, inst->filter,
+                               inst->bias, &inst->output_dims, &inst->conv_params, &inst->quant);
+        break;
+    }
+    case MODEL_OP_FC: {
+        int32_t prepared_size = esp_nn_get_fully_connected_prepared_size(layer->in_ch, out_ch,
+                                                                         ESP_NN_FC_LAYOUT_ROWS);
+        if ((inst->prepared = layer_alloc(prepared_size)) == NULL) {
+            goto alloc_failed;
+        }
+        esp_nn_fully_connected_s8_prepare(inst->prepared, ESP_NN_FC_LAYOUT_ROWS, -layer->in_zp,
+                                          layer->in_ch, inst->filter, 0, inst->bias, out_ch,
+                                          layer->out_zp, inst->shift, inst->mult, act_min, act_max);
+        break;
+    }
+    case MODEL_OP_DEPTHWISE: {
+        int scratch_size = esp_nn_get_depthwise_conv_scratch_size(&inst->input_dims, &inst->filter_dims,
+                                                                  &inst->output_dims, &inst->dw_params);
+        if (scratch_size > 0 && (inst->scratch = layer_alloc(scratch_size)) == NULL) {
+            goto alloc_failed;
+        }
+        break;
+    }
+    case MODEL_OP_HARD_SWISH: {
+        /* TFLite HardSwishPrepare */
+        const float hires_input_scale = layer->in_scale / 128.0f;
+        const float reluish_scale = 3.0f / 32768.0f;
+        int32_t mult;
+        quantize_multiplier(hires_input_scale / layer->out_scale, &mult, &inst->hs_out_exp);
+        inst->hs_out_mult_fxp = downscale_mult_to_s16(mult);
+        quantize_multiplier(hires_input_scale / reluish_scale, &mult, &inst->hs_reluish_exp);
+        inst->hs_reluish_mult_fxp = downscale_mult_to_s16(mult);
+        int32_t scratch_size = esp_nn_get_hard_swish_scratch_size();
+        if (scratch_size > 0 && (inst->scratch = layer_alloc(scratch_size)) == NULL) {
+            goto alloc_failed;
+        }
+        break;
+    }
+    case MODEL_OP_MEAN:
+        quantize_multiplier(layer->in_scale / (layer->out_scale * layer->in_wd * layer->in_ht),
+                            &inst->mult, &inst->shift);
+        break;
+    case MODEL_OP_MUL_BROADCAST:
+        /* second input is the per-channel SE gate, zero point -128 */
+        if ((inst->input2 = layer_alloc(layer->in_ch)) == NULL) {
+            goto alloc_failed;
+        }
+        fill_random(inst->input2, layer->in_ch);
+        quantize_multiplier(layer->in_scale * layer->w_scale / layer->out_scale,
+                            &inst->out_mult, &inst->out_shift);
+        break;
+    case MODEL_OP_ADD: {
+        /* TFLite int8 ADD: both inputs rescaled to 2 x max scale with 20 bits headroom */
+        if ((inst->input2 = layer_alloc(in_size)) == NULL) {
+            goto alloc_failed;
+        }
+        fill_random(inst->input2, in_size);
+        const double twice_max = 2.0 * fmax(layer->in_scale, layer->w_scale);
+        inst->left_shift = 20;
+        quantize_multiplier(layer->in_scale / twice_max, &inst->mult, &inst->shift);
+        quantize_multiplier(layer->w_scale / twice_max, &inst->in2_mult, &inst->in2_shift);
+        quantize_multiplier(twice_max / ((1 << inst->left_shift) * (double) layer->out_scale),
+                            &inst->out_mult, &inst->out_shift);
+        break;
+    }
+    case MODEL_OP_SOFTMAX: {
+        /* TFLite SoftmaxPrepare, beta = 1, 5 integer bits for the scaled diff */
+        const double real = fmin(layer->in_scale * (double) (1 << (31 - 5)), (double) INT32_MAX);
+        quantize_multiplier(real, &inst->mult, &inst->shift);
+        const double radius = 31.0 * (1ll << (31 - 5)) / (1ll << inst->shift);
+        inst->diff_min = -(int32_t) floor(radius);
+        int32_t scratch_size = esp_nn_get_softmax_scratch_size(layer->in_ch, layer->in_wd * layer->in_ht);
+        if (scratch_size > 0 && (inst->scratch = layer_alloc(scratch_size)) == NULL) {
+            goto alloc_failed;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return 0;
+
+alloc_failed:
+    printf("%s: allocations failed for layer %s\n", __FUNCTION__, layer->name);
+    model_layer_deinit(inst);
+    return -1;
+}
+
+void model_layer_deinit(model_layer_inst_t *inst)
+{
+    free(inst->input);
+    free(inst->input2);
+    free(inst->filter);
+    free(inst->bias);
+    free(inst->quant.mult);
+    free(inst->quant.shift);
+    free(inst->out_ansi);
+    free(inst->out_opt);
+    free(inst->scratch);
+    free(inst->prepared);
+    memset(inst, 0, sizeof(*inst));
+}
+
+#define HARD_SWISH_ARGS(inst, l)  (l)->in_zp, (inst)->hs_out_mult_fxp, (inst)->hs_reluish_mult_fxp, \
+                                  (inst)->hs_reluish_exp, (inst)->hs_out_exp, (l)->out_zp
+#define ADD_ARGS(inst, l)   -(l)->in_zp, 128, (inst)->mult, (inst)->in2_mult, (inst)->shift, \
+                            (inst)->in2_shift, (inst)->left_shift
+#define POOL_ARGS(l)        (l)->stride, (l)->stride, (l)->filter, (l)->filter, (l)->pad, (l)->pad
+
+void model_layer_run_ansi(model_layer_inst_t *inst)
+{
+    const model_layer_t *l = inst->layer;
+    const act_params_t *act = &inst->conv_params.activation;
+    const int32_t spatial = l->in_wd * l->in_ht;
+
+    switch (l->op) {
+    case MODEL_OP_CONV:
+        esp_nn_conv_s8_ansi(&inst->input_dims, inst->input, &inst->filter_dims, inst->filter,
+                            inst->bias, &inst->output_dims, inst->out_ansi,
+                            &inst->conv_params, &inst->quant);
+        break;
+    case MODEL_OP_DEPTHWISE:
+        esp_nn_depthwise_conv_s8_ansi(&inst->input_dims, inst->input, &inst->filter_dims, inst->filter,
+                                      inst->bias, &inst->output_dims, inst->out_ansi,
+                                      &inst->dw_params, &inst->quant);
+        break;
+    case MODEL_OP_FC:
+        esp_nn_fully_connected_s8_ansi(inst->input, -l->in_zp, l->in_ch, inst->filter, 0,
+                                       inst->bias, inst->out_ansi, l->out_ch, l->out_zp,
+                                       inst->shift, inst->mult, act->min, act->max);
+        break;
+    case MODEL_OP_HARD_SWISH:
+        esp_nn_hard_swish_s8_ansi(inst->input, inst->out_ansi, inst->out_size, HARD_SWISH_ARGS(inst, l));
+        break;
+    case MODEL_OP_MEAN:
+        esp_nn_mean_nhwc_s8_ansi(inst->input, inst->out_ansi, l->in_ht, l->in_wd, l->in_ch,
+                                 l->in_zp, l->out_zp, inst->mult, inst->shift);
+        break;
+    case MODEL_OP_MUL_BROADCAST:
+        esp_nn_mul_broadcast_channel_s8_ansi(inst->input, inst->input2, -l->in_zp, 128, inst->out_ansi,
+                                             l->out_zp, inst->out_mult, inst->out_shift,
+                                             act->min, act->max, spatial, l->in_ch);
+        break;
+    case MODEL_OP_ADD:
+        esp_nn_add_elementwise_s8_ansi(inst->input, inst->input2, ADD_ARGS(inst, l), inst->out_ansi,
+                                       l->out_zp, inst->out_mult, inst->out_shift,
+                                       act->min, act->max, inst->out_size);
+        break;
+    case MODEL_OP_AVG_POOL:
+        esp_nn_avg_pool_s8_ansi(inst->input, l->in_wd, l->in_ht, inst->out_ansi, l->out_wd, l->out_ht,
+                                POOL_ARGS(l), act->min, act->max, l->in_ch);
+        break;
+    case MODEL_OP_SOFTMAX:
+        esp_nn_softmax_s8_ansi(inst->input, spatial, l->in_ch, inst->mult, inst->shift,
+                               inst->diff_min, inst->out_ansi);
+        break;
+    }
+}
+
+void model_layer_run_opt(model_layer_inst_t *inst)
+{
+    const model_layer_t *l = inst->layer;
+    const act_params_t *act = &inst->conv_params.activation;
+    const int32_t spatial = l->in_wd * l->in_ht;
+    /* reentrant API: scratch goes with the call, no global scratch is set */
+    const esp_nn_ctx_t ctx = { .scratch = inst->scratch };
+
+    switch (l->op) {
+    case MODEL_OP_CONV:
+        esp_nn_conv_s8_run(&ctx, inst->prepared, inst->input, inst->out_opt);
+        break;
+    case MODEL_OP_DEPTHWISE:
+        esp_nn_depthwise_conv_s8_ctx(&ctx, &inst->input_dims, inst->input, &inst->filter_dims,
+                                     inst->filter, inst->bias, &inst->output_dims, inst->out_opt,
+                                     &inst->dw_params, &inst->quant);
+        break;
+    case MODEL_OP_FC:
+        esp_nn_fully_connected_s8_run(inst->prepared, inst->input, inst->out_opt);
+        break;
+    case MODEL_OP_HARD_SWISH:
+        esp_nn_hard_swish_s8_ctx(&ctx, inst->input, inst->out_opt, inst->out_size, HARD_SWISH_ARGS(inst, l));
+        break;
+    case MODEL_OP_MEAN:
+        esp_nn_mean_nhwc_s8(inst->input, inst->out_opt, l->in_ht, l->in_wd, l->in_ch,
+                            l->in_zp, l->out_zp, inst->mult, inst->shift);
+        break;
+    case MODEL_OP_MUL_BROADCAST:
+        esp_nn_mul_broadcast_channel_s8(inst->input, inst->input2, -l->in_zp, 128, inst->out_opt,
+                                        l->out_zp, inst->out_mult, inst->out_shift,
+                                        act->min, act->max, spatial, l->in_ch);
+        break;
+    case MODEL_OP_ADD:
+        esp_nn_add_elementwise_s8(inst->input, inst->input2, ADD_ARGS(inst, l), inst->out_opt,
+                                  l->out_zp, inst->out_mult, inst->out_shift,
+                                  act->min, act->max, inst->out_size);
+        break;
+    case MODEL_OP_AVG_POOL:
+        esp_nn_avg_pool_s8(inst->input, l->in_wd, l->in_ht, inst->out_opt, l->out_wd, l->out_ht,
+                           POOL_ARGS(l), act->min, act->max, l->in_ch);
+        break;
+    case MODEL_OP_SOFTMAX:
+        esp_nn_softmax_s8_ctx(&ctx, inst->input, spatial, l->in_ch, inst->mult, inst->shift,
+                              inst->diff_min, inst->out_opt);
+        break;
+    }
+}
+
+static const char *conv_path_esp32s3(const model_layer_t *l)
+{
+    const int32_t filter_row_size = l->filter * l->in_ch;
+    const int32_t window_len = l->filter * filter_row_size;
+
+    if (l->filter == 1 && l->pad == 0 && l->stride == 1) {
+        return (l->in_ch % 8 == 0) ? "1x1_mult8" : "1x1";
+    }
+    if (filter_row_size < 16 && window_len >= 16) {
+        return "im2col";
+    }
+    return "general";
+}
+
+static const char *conv_path_esp32p4(const model_layer_t *l)
+{
+    if (l->filter == 1 && l->pad == 0 && l->stride == 1) {
+        return "1x1";
+    }
+    if (l->pad == 0 && l->filter * l->in_ch >= 16) {
+        return "padded";
+    }
+    if (l->filter * l->filter * l->in_ch >= 16) {
+        return "im2col";
+    }
+    return l->pad ? "tiled" : "opt";
+}
+
+static const char *dw_path_esp32s3(const model_layer_t *l)
+{
+    const int32_t channels = l->in_ch;
+    const int32_t ch_mult = l->out_ch / l->in_ch;
+    const int32_t input_size = l->in_wd * l->in_ht * channels;
+    const int32_t filter_size = l->filter * l->filter * channels * ch_mult;
+
+    if (ch_mult == 1 && channels % 8 == 0) {
+        if (l->filter == 3) {
+            if (channels % 16 == 0 && l->pad == 1) {
+                const int32_t padded_size = (l->in_wd + 2) * (l->in_ht + 2) * channels;
+                return padded_size <= 40 * 1024 ? "s8_3x3_padded" : "s8_3x3_padded_row_tiled";
+            }
+            if (channels % 16 == 0 && l->pad == 0) {
+                return "s8_3x3_nopad";
+            }
+            return channels >= 12 ? "s8_3x3_ch_pad16" : "s16_3x3";
+        }
+        return 2 * (filter_size + input_size) <= 48 * 1024 ? "s16_mult1" : "s16_mult1_row_tiled";
+    }
+    if (ch_mult == 1 && channels > 3) {
+        return "s16_mult1_ch_pad8";
+    }
+    if (ch_mult % 8 == 0) {
+        return l->filter == 3 ? "s16_mult8_3x3" : "s16_mult8";
+    }
+    if (ch_mult % 4 == 0) {
+        return "s16_mult4";
+    }
+    return "opt";
+}
+
+const char *model_layer_path(const model_layer_t *layer, model_target_t target)
+{
+    switch (layer->op) {
+    case MODEL_OP_CONV:
+        if (target == MODEL_TARGET_ESP32S3) {
+            return conv_path_esp32s3(layer);
+        }
+        return target == MODEL_TARGET_ESP32P4 ? conv_path_esp32p4(layer) : "opt";
+    case MODEL_OP_DEPTHWISE:
+        if (target == MODEL_TARGET_ESP32S3) {
+            return dw_path_esp32s3(layer);
+        }
+        if (target == MODEL_TARGET_ESP32P4) {
+            return (layer->out_ch == layer->in_ch && layer->in_ch >= 8) ? "pie_ch1" : "opt";
+        }
+        return "opt";
+    case MODEL_OP_FC:
+        /* filter_offset is 0 for int8 models, input alignment is assumed */
+        if (target == MODEL_TARGET_ESP32S3) {
+            return layer->in_ch >= 16 ? "s8_dot" : "s16";
+        }
+        if (target == MODEL_TARGET_ESP32P4) {
+            return layer->in_zp == 0 ? "pie_dot" : "scalar";
+        }
+        return "ansi";
+    case MODEL_OP_MEAN:
+        if (target == MODEL_TARGET_ESP32S3) {
+            const int32_t num_elements = layer->in_wd * layer->in_ht;
+            if (layer->in_ch > 512) {
+                return "ansi";
+            }
+            return num_elements <= 256 ? "s16_acc" : "s32_acc";
+        }
+        return target == MODEL_TARGET_ESP32P4 ? "pie" : "ansi";
+    case MODEL_OP_AVG_POOL:
+        if (target == MODEL_TARGET_ESP32S3) {
+            return layer->in_ch % 4 == 0 ? "asm" : "c";
+        }
+        return target == MODEL_TARGET_ESP32P4 ? "pie" : "ansi";
+    case MODEL_OP_HARD_SWISH:
+        return target == MODEL_TARGET_ESP32S3 ? "lut" : (target == MODEL_TARGET_ESP32P4 ? "pie" : "ansi");
+    case MODEL_OP_MUL_BROADCAST:
+        return target == MODEL_TARGET_ESP32S3 ? "asm" : "ansi";
+    case MODEL_OP_ADD:
+        return target == MODEL_TARGET_ESP32S3 ? "asm" : (target == MODEL_TARGET_ESP32P4 ? "pie" : "ansi");
+    case MODEL_OP_SOFTMAX:
+        if (target == MODEL_TARGET_ESP32S3) {
+            return layer->in_ch >= 32 ? "simd_max" : "scalar";
+        }
+        return target == MODEL_TARGET_ESP32P4 ? "pie" : "opt";
+    }
+    return "unknown";
+}
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <esp_nn.h>
+#include "test_utils.h"
+#include "model_layers.h"
+
+#if defined(ARCH_ESP32_S3)
+#define MODEL_TARGET    MODEL_TARGET_ESP32S3
+#elif defined(ARCH_ESP32_P4)
+#define MODEL_TARGET    MODEL_TARGET_ESP32P4
+#else
+#define MODEL_TARGET    MODEL_TARGET_GENERIC
+#endif
+
+static void run_model_layers(const model_desc_t *model)
+{
+    uint64_t total_c = 0, total_opt = 0;
+    char shape[80];
+
+    printf("\n######## Replaying %s (%d layers) ##########\n", model->name, model->num_layers);
+    printf("%-4s %-18s %-26s %-40s %-24s %10s %10s %12s\n", "idx", "layer", "op", "shape",
+           "path", "c", "opt", "cumul opt");
+
+    for (int i = 0; i < model->num_layers; i++) {
+        const model_layer_t *layer = &model->layers[i];
+        model_layer_inst_t inst;
+        if (model_layer_init(&inst, layer) != 0) {
+            printf(ANSI_COLOR_RED"%s [%d] %s allocations failed\n"ANSI_COLOR_RESET,
+                   model->name, i, layer->name);
+            return;
+        }
+
+        profile_c_start();
+        model_layer_run_ansi(&inst);
+        uint32_t cycles_c = profile_c_end();
+
+        profile_opt_start();
+        model_layer_run_opt(&inst);
+        uint32_t cycles_opt = profile_opt_end();
+
+        total_c += cycles_c;
+        total_opt += cycles_opt;
+        model_layer_shape_str(layer, shape, sizeof(shape));
+
+        bool ret = CHECK_EQUAL(inst.out_ansi, inst.out_opt, inst.out_size);
+        printf("%s%-4d %-18s %-26s %-40s %-24s %10"PRIu32" %10"PRIu32" %12"PRIu64"%s\n"ANSI_COLOR_RESET,
+               ret ? ANSI_COLOR_GREEN : ANSI_COLOR_RED, i, layer->name, model_op_name(layer->op),
+               shape, model_layer_path(layer, MODEL_TARGET), cycles_c, cycles_opt, total_opt,
+               ret ? "" : " failed");
+        model_layer_deinit(&inst);
+    }
+    printf("%s total cycles: c %"PRIu64", opt %"PRIu64"\n", model->name, total_c, total_opt);
+}
+
+void esp_nn_model_layers_test()
+{
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    run_model_layers(&model_person_detection);
+    run_model_layers(&model_mobilenet_v3_small);
+}
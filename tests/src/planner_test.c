@@ -0,0 +1,246 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <esp_nn.h>
+#include "test_utils.h"
+
+#define PLAN_TEST_MAX_TENSORS   8
+#define PLAN_TEST_ALIGN(size)   (((size) + 15) & ~15)
+
+#define DIMS(w, h, c)   ((data_dims_t) {.width = (w), .height = (h), .channels = (c), 1})
+
+typedef struct {
+    const char *name;
+    esp_nn_plan_op_t ops[4];
+    int32_t num_ops;
+    int32_t num_tensors;
+} plan_test_case_t;
+
+/* bytes and live range of every tensor, from the rules of esp_nn_planner.h */
+static void plan_test_lifetimes(const plan_test_case_t *tc, int32_t *size,
+                                int32_t *first, int32_t *last)
+{
+    int32_t writer[PLAN_TEST_MAX_TENSORS];
+    for (int t = 0; t < tc->num_tensors; t++) {
+        size[t] = 0;
+        first[t] = -1;
+        last[t] = -1;
+        writer[t] = -1;
+    }
+    for (int i = 0; i < tc->num_ops; i++) {
+        const esp_nn_plan_op_t *op = &tc->ops[i];
+        for (int in = 0; in < ESP_NN_PLAN_MAX_INPUTS; in++) {
+            const int t = op->inputs[in];
+            if (t < 0) {
+                continue;
+            }
+            int32_t bytes = op->input_dims.width * op->input_dims.height * op->input_dims.channels;
+            if (in == 1 && op->op == ESP_NN_OP_MUL_BROADCAST) {
+                bytes = op->input_dims.channels;
+            }
+            size[t] = bytes > size[t] ? bytes : size[t];
+            first[t] = first[t] < 0 ? i : first[t];
+            last[t] = i;
+        }
+        const int t = op->output;
+        const int32_t bytes = op->output_dims.width * op->output_dims.height * op->output_dims.channels;
+        size[t] = bytes > size[t] ? bytes : size[t];
+        first[t] = first[t] < 0 ? i : first[t];
+        last[t] = i;
+        writer[t] = i;
+    }
+    for (int t = 0; t < tc->num_tensors; t++) {
+        if (first[t] < 0) {
+            continue;
+        }
+        if (writer[t] < 0) {
+            first[t] = 0;
+        } else if (last[t] == writer[t]) {
+            last[t] = tc->num_ops - 1;
+        }
+        size[t] = PLAN_TEST_ALIGN(size[t]);
+    }
+}
+
+static int32_t plan_test_scratch_size(const plan_test_case_t *tc)
+{
+    int32_t scratch_size = 0;
+    for (int i = 0; i < tc->num_ops; i++) {
+        const esp_nn_plan_op_t *op = &tc->ops[i];
+        int32_t size = 0;
+        if (op->op == ESP_NN_OP_CONV) {
+            size = esp_nn_get_conv_scratch_size(&op->input_dims, &op->filter_dims,
+                                                &op->output_dims, op->params);
+        } else if (op->op == ESP_NN_OP_DEPTHWISE_CONV) {
+            size = esp_nn_get_depthwise_conv_scratch_size(&op->input_dims, &op->filter_dims,
+                                                          &op->output_dims, op->params);
+        }
+        scratch_size = size > scratch_size ? size : scratch_size;
+    }
+    return scratch_size;
+}
+
+static bool plan_test_check(const plan_test_case_t *tc)
+{
+    int32_t offsets[PLAN_TEST_MAX_TENSORS];
+    int32_t size[PLAN_TEST_MAX_TENSORS], first[PLAN_TEST_MAX_TENSORS], last[PLAN_TEST_MAX_TENSORS];
+    esp_nn_plan_t plan;
+
+    if (esp_nn_plan_arena(tc->ops, tc->num_ops, tc->num_tensors, &plan, offsets) != 0) {
+        printf(ANSI_COLOR_RED"%s: planning failed\n"ANSI_COLOR_RESET, tc->name);
+        return false;
+    }
+    plan_test_lifetimes(tc, size, first, last);
+
+    const int32_t scratch_size = plan_test_scratch_size(tc);
+    if (plan.scratch_size != scratch_size || plan.scratch_offset != 0) {
+        printf(ANSI_COLOR_RED"%s: scratch %"PRIi32" at %"PRIi32", expected %"PRIi32" at 0\n"
+               ANSI_COLOR_RESET, tc->name, plan.scratch_size, plan.scratch_offset, scratch_size);
+        return false;
+    }
+    const int32_t tensors_start = PLAN_TEST_ALIGN(scratch_size);
+
+    for (int t = 0; t < tc->num_tensors; t++) {
+        if (first[t] < 0) {
+            if (offsets[t] != -1) {
+                printf(ANSI_COLOR_RED"%s: unused tensor %d placed at %"PRIi32"\n"ANSI_COLOR_RESET,
+                       tc->name, t, offsets[t]);
+                return false;
+            }
+            continue;
+        }
+        if (offsets[t] < tensors_start || offsets[t] + size[t] > plan.arena_size ||
+                (offsets[t] & 15) != 0) {
+            printf(ANSI_COLOR_RED"%s: tensor %d at [%"PRIi32", %"PRIi32"), arena %"PRIi32
+                   ", scratch ends at %"PRIi32"\n"ANSI_COLOR_RESET, tc->name, t, offsets[t],
+                   offsets[t] + size[t], plan.arena_size, tensors_start);
+            return false;
+        }
+        /* tensors live at the same time never share bytes */
+        for (int u = 0; u < t; u++) {
+            if (first[u] < 0 || last[u] < first[t] || first[u] > last[t]) {
+                continue;
+            }
+            if (offsets[t] < offsets[u] + size[u] && offsets[u] < offsets[t] + size[t]) {
+                printf(ANSI_COLOR_RED"%s: live tensors %d and %d overlap\n"ANSI_COLOR_RESET,
+                       tc->name, u, t);
+                return false;
+            }
+        }
+    }
+
+    /* the arena is the scratch and the most bytes live at any one op */
+    int32_t peak = 0;
+    for (int i = 0; i < tc->num_ops; i++) {
+        int32_t live = 0;
+        for (int t = 0; t < tc->num_tensors; t++) {
+            if (first[t] >= 0 && first[t] <= i && i <= last[t]) {
+                live += size[t];
+            }
+        }
+        peak = live > peak ? live : peak;
+    }
+    if (plan.arena_size != tensors_start + peak) {
+        printf(ANSI_COLOR_RED"%s: arena %"PRIi32", peak %"PRIi32" + scratch %"PRIi32"\n"
+               ANSI_COLOR_RESET, tc->name, plan.arena_size, peak, tensors_start);
+        return false;
+    }
+    printf(ANSI_COLOR_GREEN"%s passed, arena %"PRIi32" (%"PRIi32" scratch), %"PRIi32
+           " as separate tensors\n"ANSI_COLOR_RESET, tc->name, plan.arena_size, tensors_start,
+           plan.tensors_size);
+    return true;
+}
+
+void esp_nn_plan_arena_test()
+{
+    const conv_params_t conv_3x3 = {.in_offset = 5, .out_offset = -3, .stride = {1, 1},
+                                    .padding = {1, 1}, .dilation = {1, 1},
+                                    .activation = {-128, 127}};
+    const conv_params_t conv_1x1 = {.in_offset = 5, .out_offset = -3, .stride = {1, 1},
+                                    .padding = {0, 0}, .dilation = {1, 1},
+                                    .activation = {-128, 127}};
+    const dw_conv_params_t dw_3x3 = {.in_offset = 5, .out_offset = -3, .ch_mult = 1,
+                                     .stride = {1, 1}, .padding = {1, 1}, .dilation = {1, 1},
+                                     .activation = {-128, 127}};
+    const dw_conv_params_t dw_3x3_s2 = {.in_offset = 5, .out_offset = -3, .ch_mult = 1,
+                                        .stride = {2, 2}, .padding = {0, 0}, .dilation = {1, 1},
+                                        .activation = {-128, 127}};
+
+    const plan_test_case_t cases[] = {
+        {
+            .name = "chain",
+            .ops = {
+                {ESP_NN_OP_CONV, DIMS(16, 16, 8), DIMS(3, 3, 8), DIMS(16, 16, 16),
+                 &conv_3x3, {0, -1}, 1},
+                {ESP_NN_OP_DEPTHWISE_CONV, DIMS(16, 16, 16), DIMS(3, 3, 16), DIMS(7, 7, 16),
+                 &dw_3x3_s2, {1, -1}, 2},
+                {ESP_NN_OP_CONV, DIMS(7, 7, 16), DIMS(1, 1, 16), DIMS(7, 7, 32),
+                 &conv_1x1, {2, -1}, 3},
+            },
+            .num_ops = 3,
+            .num_tensors = 4,
+        },
+        {
+            /* the block input stays live to the add, over the wider tensors */
+            .name = "inverted residual",
+            .ops = {
+                {ESP_NN_OP_CONV, DIMS(8, 8, 16), DIMS(1, 1, 16), DIMS(8, 8, 64),
+                 &conv_1x1, {0, -1}, 1},
+                {ESP_NN_OP_DEPTHWISE_CONV, DIMS(8, 8, 64), DIMS(3, 3, 64), DIMS(8, 8, 64),
+                 &dw_3x3, {1, -1}, 2},
+                {ESP_NN_OP_CONV, DIMS(8, 8, 64), DIMS(1, 1, 64), DIMS(8, 8, 16),
+                 &conv_1x1, {2, -1}, 3},
+                {ESP_NN_OP_ADD, DIMS(8, 8, 16), DIMS(0, 0, 0), DIMS(8, 8, 16),
+                 NULL, {3, 0}, 4},
+            },
+            .num_ops = 4,
+            .num_tensors = 5,
+        },
+        {
+            /* tensor 2 is a model output never read, tensor 4 is never used */
+            .name = "outputs and broadcast",
+            .ops = {
+                {ESP_NN_OP_RELU6, DIMS(256, 1, 1), DIMS(0, 0, 0), DIMS(256, 1, 1),
+                 NULL, {0, -1}, 1},
+                {ESP_NN_OP_MUL_BROADCAST, DIMS(4, 4, 16), DIMS(0, 0, 0), DIMS(4, 4, 16),
+                 NULL, {1, 5}, 2},
+                {ESP_NN_OP_RELU6, DIMS(256, 1, 1), DIMS(0, 0, 0), DIMS(256, 1, 1),
+                 NULL, {1, -1}, 3},
+            },
+            .num_ops = 3,
+            .num_tensors = 6,
+        },
+    };
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    for (int i = 0; i < (int) (sizeof(cases) / sizeof(cases[0])); i++) {
+        plan_test_check(&cases[i]);
+    }
+
+    /* malformed sequences are refused */
+    int32_t offsets[PLAN_TEST_MAX_TENSORS];
+    esp_nn_plan_t plan;
+    esp_nn_plan_op_t bad[2] = {
+        {ESP_NN_OP_RELU6, DIMS(64, 1, 1), DIMS(0, 0, 0), DIMS(64, 1, 1), NULL, {0, -1}, 1},
+        {ESP_NN_OP_RELU6, DIMS(64, 1, 1), DIMS(0, 0, 0), DIMS(64, 1, 1), NULL, {1, -1}, 1},
+    };
+    if (esp_nn_plan_arena(bad, 2, 2, &plan, offsets) != -1) {
+        printf(ANSI_COLOR_RED"tensor written twice not refused\n"ANSI_COLOR_RESET);
+        return;
+    }
+    bad[1].output = 2;
+    if (esp_nn_plan_arena(bad, 2, 2, &plan, offsets) != -1) {
+        printf(ANSI_COLOR_RED"tensor out of range not refused\n"ANSI_COLOR_RESET);
+        return;
+    }
+    printf(ANSI_COLOR_GREEN"malformed sequences refused\n"ANSI_COLOR_RESET);
+}
@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <esp_nn.h>
+#include "test_utils.h"
+
+#define PROFILE_BUF_SIZE    4096
+#define PROFILE_MAX_EVENTS  4
+
+#define DIMS(w, h, c)   ((data_dims_t) {.width = (w), .height = (h), .channels = (c), 1})
+
+/* what the hooks saw since the last reset, through their user_data */
+typedef struct {
+    esp_nn_profile_event_t events[PROFILE_MAX_EVENTS];
+    bool is_begin[PROFILE_MAX_EVENTS];
+    int num_events;
+} profile_log_t;
+
+static void profile_log_event(const esp_nn_profile_event_t *event, profile_log_t *log,
+                              bool is_begin)
+{
+    if (log->num_events < PROFILE_MAX_EVENTS) {
+        log->events[log->num_events] = *event;
+        log->is_begin[log->num_events] = is_begin;
+    }
+    log->num_events++;
+}
+
+static void profile_begin_hook(const esp_nn_profile_event_t *event, void *user_data)
+{
+    profile_log_event(event, (profile_log_t *) user_data, true);
+}
+
+static void profile_end_hook(const esp_nn_profile_event_t *event, void *user_data)
+{
+    profile_log_event(event, (profile_log_t *) user_data, false);
+}
+
+static bool profile_dims_equal(const data_dims_t *a, const data_dims_t *b)
+{
+    return a->width == b->width && a->height == b->height && a->channels == b->channels;
+}
+
+/* exactly one begin then one end, both describing `expected` */
+static bool profile_check(const char *name, const profile_log_t *log,
+                          const esp_nn_profile_event_t *expected)
+{
+    if (log->num_events != 2 || !log->is_begin[0] || log->is_begin[1]) {
+        printf(ANSI_COLOR_RED"%s failed: %d events, expected a begin and an end\n"
+               ANSI_COLOR_RESET, name, log->num_events);
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        const esp_nn_profile_event_t *event = &log->events[i];
+        if (event->op != expected->op ||
+                !profile_dims_equal(&event->input_dims, &expected->input_dims) ||
+                !profile_dims_equal(&event->filter_dims, &expected->filter_dims) ||
+                !profile_dims_equal(&event->output_dims, &expected->output_dims)) {
+            printf(ANSI_COLOR_RED"%s failed: %s event reports %s, in %dx%dx%d, filter %dx%dx%d, "
+                   "out %dx%dx%d\n"ANSI_COLOR_RESET, name, i ? "end" : "begin",
+                   esp_nn_op_name(event->op), event->input_dims.width, event->input_dims.height,
+                   event->input_dims.channels, event->filter_dims.width,
+                   event->filter_dims.height, event->filter_dims.channels,
+                   event->output_dims.width, event->output_dims.height,
+                   event->output_dims.channels);
+            return false;
+        }
+        if (event->macs != expected->macs) {
+            printf(ANSI_COLOR_RED"%s failed: %"PRIi64" macs, expected %"PRIi64"\n"ANSI_COLOR_RESET,
+                   name, event->macs, expected->macs);
+            return false;
+        }
+    }
+    /* the timestamp wraps, the difference does not go backwards */
+    const uint32_t cycles = log->events[1].timestamp - log->events[0].timestamp;
+    if ((int32_t) cycles < 0) {
+        printf(ANSI_COLOR_RED"%s failed: end timestamp %"PRIu32" before begin %"PRIu32"\n"
+               ANSI_COLOR_RESET, name, log->events[1].timestamp, log->events[0].timestamp);
+        return false;
+    }
+    printf(ANSI_COLOR_GREEN"%s passed [%s, %"PRIi64" macs, %"PRIu32" ticks]\n"ANSI_COLOR_RESET,
+           name, esp_nn_op_name(expected->op), expected->macs, cycles);
+    return true;
+}
+
+void esp_nn_profile_test()
+{
+    profile_log_t log;
+    int8_t *input = NULL, *filter = NULL, *output = NULL;
+    int32_t *bias = NULL, *shift = NULL, *mult = NULL;
+    void *scratch_buf = NULL;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    if (!ESP_NN_PROFILING_ENABLED) {
+        if (esp_nn_profile_register(profile_begin_hook, profile_end_hook, &log) != -1) {
+            printf(ANSI_COLOR_RED"profiling compiled out but hooks registered\n"ANSI_COLOR_RESET);
+            return;
+        }
+        printf(ANSI_COLOR_YELLOW"profiling compiled out, enable NN_PROFILING to test it\n"
+               ANSI_COLOR_RESET);
+        return;
+    }
+
+    const data_dims_t conv_in = DIMS(10, 10, 8), conv_filter = DIMS(3, 3, 8);
+    const data_dims_t conv_out = DIMS(10, 10, 16);
+    const conv_params_t conv_params = {.in_offset = 5, .out_offset = 3, .stride = {1, 1},
+                                       .padding = {1, 1}, .dilation = {1, 1},
+                                       .activation = {-128, 127}};
+    const data_dims_t dw_in = DIMS(10, 10, 16), dw_filter = DIMS(3, 3, 16);
+    const data_dims_t dw_out = DIMS(4, 4, 16);
+    const dw_conv_params_t dw_params = {.in_offset = 5, .out_offset = 3, .ch_mult = 1,
+                                        .stride = {2, 2}, .padding = {0, 0},
+                                        .dilation = {1, 1}, .activation = {-128, 127}};
+
+    int32_t conv_scratch = esp_nn_get_conv_scratch_size(&conv_in, &conv_filter, &conv_out,
+                                                        &conv_params);
+    int32_t dw_scratch = esp_nn_get_depthwise_conv_scratch_size(&dw_in, &dw_filter, &dw_out,
+                                                                &dw_params);
+    const int32_t scratch_size = conv_scratch > dw_scratch ? conv_scratch : dw_scratch;
+
+    input = ESP_NN_TEST_ALLOC(PROFILE_BUF_SIZE);
+    filter = ESP_NN_TEST_ALLOC(PROFILE_BUF_SIZE);
+    output = ESP_NN_TEST_ALLOC(PROFILE_BUF_SIZE);
+    bias = ESP_NN_TEST_ALLOC(64 * sizeof(int32_t));
+    shift = ESP_NN_TEST_ALLOC(64 * sizeof(int32_t));
+    mult = ESP_NN_TEST_ALLOC(64 * sizeof(int32_t));
+    scratch_buf = ESP_NN_TEST_ALLOC(scratch_size + 16);
+    if (input == NULL || filter == NULL || output == NULL || bias == NULL ||
+            shift == NULL || mult == NULL || scratch_buf == NULL) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto profile_cleanup;
+    }
+    esp_nn_ctx_t ctx = {.scratch = (void *) (((uintptr_t) scratch_buf + 15) & ~15),
+                        .mover = NULL};
+    quant_data_t quant_data = {.shift = shift, .mult = mult};
+
+    for (int i = 0; i < PROFILE_BUF_SIZE; i++) {
+        input[i] = rand() % 256 - 128;
+        filter[i] = rand() % 256 - 128;
+    }
+    for (int i = 0; i < 64; i++) {
+        bias[i] = rand() % 2001 - 1000;
+        shift[i] = -8;
+        mult[i] = 0x40000000;
+    }
+
+    if (esp_nn_profile_register(profile_begin_hook, profile_end_hook, &log) != 0) {
+        printf(ANSI_COLOR_RED"registering the hooks failed\n"ANSI_COLOR_RESET);
+        goto profile_cleanup;
+    }
+
+    esp_nn_profile_event_t expected;
+
+    memset(&log, 0, sizeof(log));
+    esp_nn_conv_s8_ctx(&ctx, &conv_in, input, &conv_filter, filter, bias, &conv_out, output,
+                       &conv_params, &quant_data);
+    expected = (esp_nn_profile_event_t) {ESP_NN_OP_CONV, conv_in, conv_filter, conv_out,
+                                         10 * 10 * 16 * 3 * 3 * 8, 0};
+    if (!profile_check("conv 3x3", &log, &expected)) {
+        goto profile_unregister;
+    }
+
+    memset(&log, 0, sizeof(log));
+    esp_nn_depthwise_conv_s8_ctx(&ctx, &dw_in, input, &dw_filter, filter, bias, &dw_out,
+                                 output, &dw_params, &quant_data);
+    expected = (esp_nn_profile_event_t) {ESP_NN_OP_DEPTHWISE_CONV, dw_in, dw_filter, dw_out,
+                                         4 * 4 * 16 * 3 * 3, 0};
+    if (!profile_check("depthwise 3x3, stride 2", &log, &expected)) {
+        goto profile_unregister;
+    }
+
+    memset(&log, 0, sizeof(log));
+    esp_nn_fully_connected_s8(input, 5, 64, filter, 0, bias, output, 16, 3, shift[0], mult[0],
+                              -128, 127);
+    expected = (esp_nn_profile_event_t) {ESP_NN_OP_FULLY_CONNECTED, DIMS(64, 1, 1),
+                                         DIMS(64, 16, 1), DIMS(1, 1, 16), 64 * 16, 0};
+    if (!profile_check("fully connected", &log, &expected)) {
+        goto profile_unregister;
+    }
+
+    memset(&log, 0, sizeof(log));
+    esp_nn_avg_pool_s8(input, 8, 8, output, 4, 4, 2, 2, 2, 2, 0, 0, -128, 127, 16);
+    expected = (esp_nn_profile_event_t) {ESP_NN_OP_AVG_POOL, DIMS(8, 8, 16), DIMS(2, 2, 1),
+                                         DIMS(4, 4, 16), 4 * 4 * 2 * 2 * 16, 0};
+    if (!profile_check("avg pool 2x2", &log, &expected)) {
+        goto profile_unregister;
+    }
+
+    memset(&log, 0, sizeof(log));
+    esp_nn_relu6_s8(output, 256);
+    expected = (esp_nn_profile_event_t) {ESP_NN_OP_RELU6, DIMS(256, 1, 1), DIMS(0, 0, 0),
+                                         DIMS(256, 1, 1), 256, 0};
+    if (!profile_check("relu6", &log, &expected)) {
+        goto profile_unregister;
+    }
+
+    /* with the hooks cleared the wrappers only run the op */
+    esp_nn_profile_register(NULL, NULL, NULL);
+    memset(&log, 0, sizeof(log));
+    esp_nn_conv_s8_ctx(&ctx, &conv_in, input, &conv_filter, filter, bias, &conv_out, output,
+                       &conv_params, &quant_data);
+    esp_nn_relu6_s8(output, 256);
+    if (log.num_events != 0) {
+        printf(ANSI_COLOR_RED"%d events after the hooks were cleared\n"ANSI_COLOR_RESET,
+               log.num_events);
+        goto profile_cleanup;
+    }
+    printf(ANSI_COLOR_GREEN"cleared hooks not called\n"ANSI_COLOR_RESET);
+
+profile_unregister:
+    esp_nn_profile_register(NULL, NULL, NULL);
+profile_cleanup:
+    if (input) free(input);
+    if (filter) free(filter);
+    if (output) free(output);
+    if (bias) free(bias);
+    if (shift) free(shift);
+    if (mult) free(mult);
+    if (scratch_buf) free(scratch_buf);
+}
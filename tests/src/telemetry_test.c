@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <esp_nn.h>
+#include "test_utils.h"
+
+/* path a shape takes on the target built for, ESP_NN_PATH_MAX if it records none */
+#if ARCH_ESP32_S3
+#define TELEMETRY_PATH(s3, p4, generic)     (s3)
+#elif ARCH_ESP32_P4
+#define TELEMETRY_PATH(s3, p4, generic)     (p4)
+#else
+#define TELEMETRY_PATH(s3, p4, generic)     (generic)
+#endif
+
+#define TELEMETRY_BUF_SIZE  4096
+
+typedef enum {
+    TELEMETRY_OP_CONV,
+    TELEMETRY_OP_FC,
+    TELEMETRY_OP_AVG_POOL,
+} telemetry_op_t;
+
+typedef struct {
+    const char *name;
+    telemetry_op_t op;
+    int in_wd, in_ht, in_ch, filter_ch, out_ch;
+    uint16_t filter_size, pad;
+    int32_t in_offset, filter_offset;
+    esp_nn_path_t expected;
+} telemetry_case_t;
+
+static const telemetry_case_t telemetry_cases[] = {
+    {"conv 1x1, channels of 8", TELEMETRY_OP_CONV, 10, 10, 16, 16, 16, 1, 0, 5, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_CONV_1X1_ASM, ESP_NN_PATH_CONV_1X1, ESP_NN_PATH_CONV_1X1)},
+    {"conv 1x1", TELEMETRY_OP_CONV, 8, 8, 12, 12, 16, 1, 0, 5, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_CONV_1X1, ESP_NN_PATH_CONV_1X1, ESP_NN_PATH_CONV_1X1)},
+    {"conv 3x3, 3 channels", TELEMETRY_OP_CONV, 12, 12, 3, 3, 16, 3, 1, 5, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_CONV_IM2COL, ESP_NN_PATH_CONV_IM2COL, ESP_NN_PATH_CONV_GENERAL)},
+    {"conv 3x3, unpadded", TELEMETRY_OP_CONV, 10, 10, 16, 16, 16, 3, 0, 5, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_CONV_GENERAL, ESP_NN_PATH_CONV_PADDED, ESP_NN_PATH_CONV_GENERAL)},
+    {"conv 3x3, 1 channel", TELEMETRY_OP_CONV, 10, 10, 1, 1, 8, 3, 1, 5, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_CONV_GENERAL, ESP_NN_PATH_CONV_TILED, ESP_NN_PATH_CONV_GENERAL)},
+    /* the S3 runs each group on the path of its own shape */
+    {"conv 3x3, 2 groups", TELEMETRY_OP_CONV, 10, 10, 16, 8, 16, 3, 1, 5, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_CONV_GENERAL, ESP_NN_PATH_CONV_ANSI, ESP_NN_PATH_CONV_ANSI)},
+    {"fc, no offsets", TELEMETRY_OP_FC, 64, 1, 1, 1, 16, 0, 0, 0, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_FC_S8, ESP_NN_PATH_FC_S8, ESP_NN_PATH_MAX)},
+    {"fc, filter offset", TELEMETRY_OP_FC, 64, 1, 1, 1, 16, 0, 0, 5, 3,
+     TELEMETRY_PATH(ESP_NN_PATH_FC_S16, ESP_NN_PATH_FC_C, ESP_NN_PATH_MAX)},
+    {"avg pool, channels of 4", TELEMETRY_OP_AVG_POOL, 8, 8, 16, 16, 16, 3, 1, 0, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_AVG_POOL_ASM, ESP_NN_PATH_MAX, ESP_NN_PATH_MAX)},
+    {"avg pool, 3 channels", TELEMETRY_OP_AVG_POOL, 8, 8, 3, 3, 3, 3, 1, 0, 0,
+     TELEMETRY_PATH(ESP_NN_PATH_AVG_POOL_C, ESP_NN_PATH_MAX, ESP_NN_PATH_MAX)},
+};
+
+static void telemetry_run(const telemetry_case_t *tc, const int8_t *input, const int8_t *filter,
+                          const int32_t *bias, const int32_t *shift, const int32_t *mult,
+                          int8_t *output, void *scratch)
+{
+    const int out_wd = tc->in_wd + 2 * tc->pad - tc->filter_size + 1;
+    const int out_ht = tc->in_ht + 2 * tc->pad - tc->filter_size + 1;
+
+    switch (tc->op) {
+    case TELEMETRY_OP_CONV: {
+        data_dims_t input_dims = {.width = tc->in_wd, .height = tc->in_ht, .channels = tc->in_ch, 1};
+        data_dims_t filter_dims = {.width = tc->filter_size, .height = tc->filter_size,
+                                   .channels = tc->filter_ch, 1};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = tc->out_ch, 1};
+        conv_params_t conv_params = {.in_offset = tc->in_offset, .out_offset = 3,
+                                     .stride = {1, 1}, .padding = {tc->pad, tc->pad},
+                                     .dilation = {1, 1}, .activation = {-128, 127}};
+        quant_data_t quant_data = {.shift = (int32_t *) shift, .mult = (int32_t *) mult};
+        esp_nn_ctx_t ctx = {.scratch = scratch, .mover = NULL};
+        esp_nn_conv_s8_ctx(&ctx, &input_dims, input, &filter_dims, filter, bias,
+                           &output_dims, output, &conv_params, &quant_data);
+        break;
+    }
+    case TELEMETRY_OP_FC:
+        esp_nn_fully_connected_s8(input, tc->in_offset, tc->in_wd, filter, tc->filter_offset,
+                                  bias, output, tc->out_ch, 3, shift[0], mult[0], -128, 127);
+        break;
+    case TELEMETRY_OP_AVG_POOL:
+        esp_nn_avg_pool_s8(input, tc->in_wd, tc->in_ht, output, out_wd, out_ht, 1, 1,
+                           tc->filter_size, tc->filter_size, tc->pad, tc->pad, -128, 127,
+                           tc->in_ch);
+        break;
+    }
+}
+
+/* every call of the case counted on its path, no other path touched */
+static bool telemetry_check(const telemetry_case_t *tc)
+{
+    uint32_t expected_calls = 0;
+    for (int p = 0; p < ESP_NN_PATH_MAX; p++) {
+        esp_nn_path_stats_t stats;
+        if (esp_nn_telemetry_get((esp_nn_path_t) p, &stats) != 0) {
+            printf(ANSI_COLOR_RED"%s: no counters for path %d\n"ANSI_COLOR_RESET, tc->name, p);
+            return false;
+        }
+        if (p == tc->expected) {
+            expected_calls = stats.calls;
+        } else if (stats.calls) {
+            printf(ANSI_COLOR_RED"%s failed: %"PRIu32" calls on %s, expected %s\n"ANSI_COLOR_RESET,
+                   tc->name, stats.calls, esp_nn_path_name((esp_nn_path_t) p),
+                   tc->expected == ESP_NN_PATH_MAX ? "none" : esp_nn_path_name(tc->expected));
+            return false;
+        }
+    }
+    if (tc->expected != ESP_NN_PATH_MAX && expected_calls == 0) {
+        printf(ANSI_COLOR_RED"%s failed: nothing recorded on %s\n"ANSI_COLOR_RESET,
+               tc->name, esp_nn_path_name(tc->expected));
+        return false;
+    }
+    printf(ANSI_COLOR_GREEN"%s passed [%s]\n"ANSI_COLOR_RESET, tc->name,
+           tc->expected == ESP_NN_PATH_MAX ? "no path recorded" : esp_nn_path_name(tc->expected));
+    return true;
+}
+
+void esp_nn_telemetry_test()
+{
+    esp_nn_path_stats_t stats;
+    int8_t *input = NULL, *filter = NULL, *output = NULL;
+    int32_t *bias = NULL, *shift = NULL, *mult = NULL;
+    void *scratch_buf = NULL;
+
+    printf("\n######## Running %s ##########\n", __FUNCTION__);
+    if (!ESP_NN_TELEMETRY_ENABLED) {
+        if (esp_nn_telemetry_get(ESP_NN_PATH_CONV_GENERAL, &stats) != -1) {
+            printf(ANSI_COLOR_RED"telemetry compiled out but counters reported\n"ANSI_COLOR_RESET);
+            return;
+        }
+        printf(ANSI_COLOR_YELLOW"telemetry compiled out, enable NN_TELEMETRY to test it\n"
+               ANSI_COLOR_RESET);
+        return;
+    }
+
+    int32_t scratch_size = 0;
+    for (int i = 0; i < (int) (sizeof(telemetry_cases) / sizeof(telemetry_cases[0])); i++) {
+        const telemetry_case_t *tc = &telemetry_cases[i];
+        if (tc->op != TELEMETRY_OP_CONV) {
+            continue;
+        }
+        const int out_wd = tc->in_wd + 2 * tc->pad - tc->filter_size + 1;
+        const int out_ht = tc->in_ht + 2 * tc->pad - tc->filter_size + 1;
+        data_dims_t input_dims = {.width = tc->in_wd, .height = tc->in_ht, .channels = tc->in_ch, 1};
+        data_dims_t filter_dims = {.width = tc->filter_size, .height = tc->filter_size,
+                                   .channels = tc->filter_ch, 1};
+        data_dims_t output_dims = {.width = out_wd, .height = out_ht, .channels = tc->out_ch, 1};
+        conv_params_t conv_params = {.in_offset = tc->in_offset, .out_offset = 3,
+                                     .stride = {1, 1}, .padding = {tc->pad, tc->pad},
+                                     .dilation = {1, 1}, .activation = {-128, 127}};
+        int32_t size = esp_nn_get_conv_scratch_size(&input_dims, &filter_dims, &output_dims,
+                                                    &conv_params);
+        scratch_size = size > scratch_size ? size : scratch_size;
+    }
+
+    /* every case fits these */
+    input = ESP_NN_TEST_ALLOC(TELEMETRY_BUF_SIZE + 16);
+    filter = ESP_NN_TEST_ALLOC(TELEMETRY_BUF_SIZE);
+    output = ESP_NN_TEST_ALLOC(TELEMETRY_BUF_SIZE);
+    bias = ESP_NN_TEST_ALLOC(64 * sizeof(int32_t));
+    shift = ESP_NN_TEST_ALLOC(64 * sizeof(int32_t));
+    mult = ESP_NN_TEST_ALLOC(64 * sizeof(int32_t));
+    scratch_buf = ESP_NN_TEST_ALLOC(scratch_size + 16);
+    if (input == NULL || filter == NULL || output == NULL || bias == NULL ||
+            shift == NULL || mult == NULL || scratch_buf == NULL) {
+        printf(ANSI_COLOR_RED"%s allocations failed\n"ANSI_COLOR_RESET, __FUNCTION__);
+        goto telemetry_cleanup;
+    }
+    /* the S3 fc takes its fast path on 16 byte aligned input only */
+    int8_t *input_aligned = (int8_t *) (((uintptr_t) input + 15) & ~15);
+    void *scratch = (void *) (((uintptr_t) scratch_buf + 15) & ~15);
+
+    for (int i = 0; i < TELEMETRY_BUF_SIZE; i++) {
+        input_aligned[i] = rand() % 256 - 128;
+        filter[i] = rand() % 256 - 128;
+    }
+    for (int i = 0; i < 64; i++) {
+        bias[i] = rand() % 2001 - 1000;
+        shift[i] = -8;
+        mult[i] = 0x40000000;
+    }
+
+    for (int i = 0; i < (int) (sizeof(telemetry_cases) / sizeof(telemetry_cases[0])); i++) {
+        esp_nn_telemetry_reset();
+        telemetry_run(&telemetry_cases[i], input_aligned, filter, bias, shift, mult,
+                      output, scratch);
+        if (!telemetry_check(&telemetry_cases[i])) {
+            break;
+        }
+    }
+    esp_nn_telemetry_reset();
+
+telemetry_cleanup:
+    if (input) free(input);
+    if (filter) free(filter);
+    if (output) free(output);
+    if (bias) free(bias);
+    if (shift) free(shift);
+    if (mult) free(mult);
+    if (scratch_buf) free(scratch_buf);
+}